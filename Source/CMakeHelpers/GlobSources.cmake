@@ -82,6 +82,8 @@ set( CORE_SOURCE_HEADERS Core/Debugging/Headers/DebugInterface.h
                          Core/Math/BoundingVolumes/Headers/BoundingBox.inl
                          Core/Math/BoundingVolumes/Headers/BoundingSphere.h
                          Core/Math/BoundingVolumes/Headers/BoundingSphere.inl
+                         Core/Math/BoundingVolumes/Headers/DynamicAABBTree.h
+                         Core/Math/BoundingVolumes/Headers/DynamicAABBTree.inl
                          Core/Math/BoundingVolumes/Headers/OBB.h
                          Core/Math/Headers/Dimension.h
                          Core/Math/Headers/Line.h
@@ -96,6 +98,7 @@ set( CORE_SOURCE_HEADERS Core/Debugging/Headers/DebugInterface.h
                          Core/Math/Headers/Quaternion.h
                          Core/Math/Headers/Quaternion.inl
                          Core/Math/Headers/Ray.h
+                         Core/Math/Headers/SimdLanes.h
                          Core/Math/Headers/Transform.h
                          Core/Math/Headers/Transform.inl
                          Core/Math/Headers/TransformInterface.h
@@ -110,6 +113,7 @@ set( CORE_SOURCE_HEADERS Core/Debugging/Headers/DebugInterface.h
                          Core/TemplateLibraries/Headers/String.h
                          Core/TemplateLibraries/Headers/TemplateAllocator.h
                          Core/TemplateLibraries/Headers/Vector.h
+                         Core/TemplateLibraries/Headers/WorkStealingDeque.h
                          Core/Time/Headers/ApplicationTimer.h
                          Core/Time/Headers/ApplicationTimer.inl
                          Core/Time/Headers/FrameRateHandler.h
@@ -152,6 +156,8 @@ set( CORE_SOURCE Core/Application.cpp
 set ( DYNAMICS_SOURCE_HEADERS Dynamics/Entities/Particles/Headers/ParticleData.h
                               Dynamics/Entities/Particles/Headers/ParticleEmitter.h
                               Dynamics/Entities/Particles/Headers/ParticleGenerator.h
+                              Dynamics/Entities/Particles/Headers/ParticleDepthSorter.h
+                              Dynamics/Entities/Particles/Headers/ParticleKernels.h
                               Dynamics/Entities/Particles/Headers/ParticleSource.h
                               Dynamics/Entities/Particles/Headers/ParticleUpdater.h
                               Dynamics/Entities/Particles/ConcreteGenerators/Headers/ParticleBoxGenerator.h
@@ -178,6 +184,8 @@ set ( DYNAMICS_SOURCE_HEADERS Dynamics/Entities/Particles/Headers/ParticleData.h
 set( DYNAMICS_SOURCE Dynamics/Entities/Particles/ParticleData.cpp
                      Dynamics/Entities/Particles/ParticleEmitter.cpp
                      Dynamics/Entities/Particles/ParticleGenerator.cpp
+                     Dynamics/Entities/Particles/ParticleDepthSorter.cpp
+                     Dynamics/Entities/Particles/ParticleKernels.cpp
                      Dynamics/Entities/Particles/ParticleSource.cpp
                      Dynamics/Entities/Particles/ConcreteGenerators/ParticleBoxGenerator.cpp
                      Dynamics/Entities/Particles/ConcreteGenerators/ParticleColourGenerator.cpp
@@ -223,16 +231,21 @@ set( ECS_SOURCE_HEADERS ECS/Components/Headers/AnimationComponent.h
                         ECS/Systems/Headers/AnimationSystem.h
                         ECS/Systems/Headers/BoundsSystem.h
                         ECS/Systems/Headers/DirectionalLightSystem.h
+                        ECS/Systems/Headers/DirtyLevelQueue.h
+                        ECS/Systems/Headers/DirtyLevelQueue.inl
                         ECS/Systems/Headers/ECSManager.h
                         ECS/Systems/Headers/ECSSystem.h
                         ECS/Systems/Headers/ECSSystem.inl
+                        ECS/Systems/Headers/ECSSystemScheduler.h
                         ECS/Systems/Headers/EnvironmentProbeSystem.h
                         ECS/Systems/Headers/NavigationSystem.h
+                        ECS/Systems/Headers/NetworkingSystem.h
                         ECS/Systems/Headers/PointLightSystem.h
                         ECS/Systems/Headers/RenderingSystem.h
                         ECS/Systems/Headers/RigidBodySystem.h
                         ECS/Systems/Headers/SelectionSystem.h
                         ECS/Systems/Headers/SpotLightSystem.h
+                        ECS/Systems/Headers/TransformHierarchy.h
                         ECS/Systems/Headers/TransformSystem.h
 )
 
@@ -259,12 +272,15 @@ set( ECS_SOURCE ECS/Components/AnimationComponent.cpp
                 ECS/Systems/BoundsSystem.cpp
                 ECS/Systems/DirectionalLightSystem.cpp
                 ECS/Systems/ECSManager.cpp
+                ECS/Systems/ECSSystemScheduler.cpp
                 ECS/Systems/EnvironmentProbeSystem.cpp
+                ECS/Systems/NetworkingSystem.cpp
                 ECS/Systems/PointLightSystem.cpp
                 ECS/Systems/RenderingSystem.cpp
                 ECS/Systems/RigidBodySystem.cpp
                 ECS/Systems/SelectionSystem.cpp
                 ECS/Systems/SpotLightSystem.cpp
+                ECS/Systems/TransformHierarchy.cpp
                 ECS/Systems/TransformSystem.cpp
 )
 
@@ -337,10 +353,12 @@ set( ENVIRONMENT_SOURCE Environment/Sky/Sky.cpp
 
 )
 
-set( GEOMETRY_SOURCE_HEADERS Geometry/Animations/Headers/AnimationEvaluator.h
+set( GEOMETRY_SOURCE_HEADERS Geometry/Animations/Headers/AnimationBlendGraph.h
+                             Geometry/Animations/Headers/AnimationEvaluator.h
                              Geometry/Animations/Headers/AnimationEvaluator.inl
                              Geometry/Animations/Headers/AnimationUtils.h
                              Geometry/Animations/Headers/Bone.h
+                             Geometry/Animations/Headers/CompressedAnimation.h
                              Geometry/Animations/Headers/SceneAnimator.h
                              Geometry/Animations/Headers/SceneAnimator.inl
                              Geometry/Importer/Headers/DVDConverter.h
@@ -359,8 +377,10 @@ set( GEOMETRY_SOURCE_HEADERS Geometry/Animations/Headers/AnimationEvaluator.h
 )
 
 set( GEOMETRY_SOURCE Geometry/Animations/Bone.cpp
+                     Geometry/Animations/AnimationBlendGraph.cpp
                      Geometry/Animations/AnimationEvaluator.cpp
                      Geometry/Animations/AnimationUtils.cpp
+                     Geometry/Animations/CompressedAnimation.cpp
                      Geometry/Animations/SceneAnimator.cpp
                      Geometry/Importer/DVDConverter.cpp
                      Geometry/Importer/MeshImporter.cpp
@@ -378,20 +398,25 @@ set( GEOMETRY_SOURCE Geometry/Animations/Bone.cpp
 
 set( GRAPHS_SOURCE_HEADERS Graphs/Headers/IntersectionRecord.h
                            Graphs/Headers/SceneGraph.h
+                           Graphs/Headers/SceneGraphBroadPhase.h
+                           Graphs/Headers/SceneGraphCullingIndex.h
                            Graphs/Headers/SceneGraphNode.h
                            Graphs/Headers/SceneGraphNode.inl
+                           Graphs/Headers/SceneGraphNodeIndex.h
                            Graphs/Headers/SceneNode.h
                            Graphs/Headers/SceneNodeFwd.h
                            Graphs/Headers/SceneNodeRenderState.h
-                           Graphs/Headers/SGNRelationshipCache.h
+                           Graphs/Headers/SGNRelationshipIndex.h
 )
 
 set( GRAPHS_SOURCE Graphs/IntersectionRecord.cpp
                    Graphs/SceneGraph.cpp
+                   Graphs/SceneGraphBroadPhase.cpp
+                   Graphs/SceneGraphCullingIndex.cpp
                    Graphs/SceneGraphNode.cpp
                    Graphs/SceneNode.cpp
                    Graphs/SceneNodeRenderState.cpp
-                   Graphs/SGNRelationshipCache.cpp
+                   Graphs/SGNRelationshipIndex.cpp
 )
 
 set( GUI_SOURCE_HEADERS GUI/CEGUIAddons/Headers/CEGUIFormattedListBox.h
@@ -449,14 +474,28 @@ set( MANAGERS_SOURCE Managers/FrameListenerManager.cpp
 set( NETWORKING_SOURCE_HEADERS Networking/Headers/Client.h
                                Networking/Headers/Common.h
                                Networking/Headers/Connection.h
+                               Networking/Headers/DeltaCodec.h
+                               Networking/Headers/InterestManager.h
+                               Networking/Headers/LossyLoopback.h
                                Networking/Headers/NetworkPacket.h
+                               Networking/Headers/PacketPool.h
+                               Networking/Headers/ReliableEndpoint.h
                                Networking/Headers/Server.h
+                               Networking/Headers/SnapshotInterpolation.h
+                               Networking/Headers/UDPTransport.h
 )
 
 set( NETWORKING_SOURCE Networking/Client.cpp
                        Networking/Connection.cpp
+                       Networking/DeltaCodec.cpp
+                       Networking/InterestManager.cpp
+                       Networking/LossyLoopback.cpp
                        Networking/NetworkPacket.cpp
+                       Networking/PacketPool.cpp
+                       Networking/ReliableEndpoint.cpp
                        Networking/Server.cpp
+                       Networking/SnapshotInterpolation.cpp
+                       Networking/UDPTransport.cpp
 )
 
 set( PHYSICS_SOURCE_HEADERS Physics/Headers/PhysicsAPIWrapper.h
@@ -516,6 +555,7 @@ set( PLATFORM_SOURCE_HEADERS Platform/Audio/fmod/Headers/FmodWrapper.h
                              Platform/Audio/Headers/AudioAPIWrapper.h
                              Platform/Audio/Headers/AudioDescriptor.h
                              Platform/Audio/Headers/SFXDevice.h
+                             Platform/Audio/none/Headers/NoneWrapper.h
                              Platform/Audio/openAl/Headers/ALWrapper.h
                              Platform/Audio/sdl_mixer/Headers/SDLWrapper.h
                              Platform/File/Headers/FileManagement.h
@@ -544,6 +584,7 @@ set( PLATFORM_SOURCE_HEADERS Platform/Audio/fmod/Headers/FmodWrapper.h
                              Platform/Threading/Headers/Task.h
                              Platform/Threading/Headers/Task.inl
                              Platform/Threading/Headers/TaskGPUSync.h
+                             Platform/Threading/Headers/TaskGraph.h
                              Platform/Video/Buffers/Headers/BufferRange.h
                              Platform/Video/Buffers/Headers/BufferRange.inl
                              Platform/Video/Buffers/RenderTarget/Headers/RenderTarget.h
@@ -666,6 +707,7 @@ set( PLATFORM_SOURCE Platform/ConditionalWait.cpp
                      Platform/Input/InputAggregatorInterface.cpp
                      Platform/Input/InputHandler.cpp
                      Platform/Threading/Task.cpp
+                     Platform/Threading/TaskGraph.cpp
                      Platform/Video/AttributeDescriptor.cpp
                      Platform/Video/BlendingProperties.cpp
                      Platform/Video/CommandBuffer.cpp
@@ -758,6 +800,7 @@ set( RENDERING_SOURCE_HEADERS Rendering/Camera/Headers/Camera.h
                               Rendering/PostFX/Headers/PreRenderBatch.h
                               Rendering/PostFX/Headers/PreRenderBatch.inl
                               Rendering/PostFX/Headers/PreRenderOperator.h
+                              Rendering/RenderPass/Headers/MaterialSlotCache.h
                               Rendering/RenderPass/Headers/NodeBufferedData.h
                               Rendering/RenderPass/Headers/RenderBin.h
                               Rendering/RenderPass/Headers/RenderPass.h
@@ -784,6 +827,7 @@ set( RENDERING_SOURCE Rendering/Renderer.cpp
                       Rendering/PostFX/CustomOperators/PostAAPreRenderOperator.cpp
                       Rendering/PostFX/CustomOperators/SSAOPreRenderOperator.cpp
                       Rendering/PostFX/CustomOperators/SSRPreRenderOperator.cpp
+                      Rendering/RenderPass/MaterialSlotCache.cpp
                       Rendering/RenderPass/NodeBufferedData.cpp
                       Rendering/RenderPass/RenderBin.cpp
                       Rendering/RenderPass/RenderPass.cpp
@@ -854,10 +898,30 @@ set( UTILITY_SOURCE Utility/Colours.cpp
 
 set( TEST_ENGINE_SOURCE UnitTests/unitTestCommon.h
                         UnitTests/unitTestCommon.cpp
+                        UnitTests/Test-Engine/AnimationBlendGraphTests.cpp
+                        UnitTests/Test-Engine/AnimationLODTests.cpp
                         UnitTests/Test-Engine/ByteBufferTests.cpp
+                        UnitTests/Test-Engine/CompressedAnimationTests.cpp
+                        UnitTests/Test-Engine/DirtyLevelQueueTests.cpp
+                        UnitTests/Test-Engine/DynamicAABBTreeTests.cpp
+                        UnitTests/Test-Engine/ECSSchedulerTests.cpp
+                        UnitTests/Test-Engine/FrustumTests.cpp
+                        UnitTests/Test-Engine/LoopTimingTests.cpp
+                        UnitTests/Test-Engine/MaterialSlotCacheTests.cpp
                         UnitTests/Test-Engine/MathMatrixTests.cpp
                         UnitTests/Test-Engine/MathVectorTests.cpp
+                        UnitTests/Test-Engine/NetworkDeltaTests.cpp
+                        UnitTests/Test-Engine/NetworkPacketPoolTests.cpp
+                        UnitTests/Test-Engine/NetworkInterestTests.cpp
+                        UnitTests/Test-Engine/NetworkInterpolationTests.cpp
+                        UnitTests/Test-Engine/NetworkReliabilityTests.cpp
+                        UnitTests/Test-Engine/ParticleDepthSorterTests.cpp
+                        UnitTests/Test-Engine/ParticleKernelsTests.cpp
+                        UnitTests/Test-Engine/SceneGraphNodeIndexTests.cpp
+                        UnitTests/Test-Engine/SGNRelationshipIndexTests.cpp
+                        UnitTests/Test-Engine/SpatialCullingTests.cpp
                         UnitTests/Test-Engine/ScriptingTests.cpp
+                        UnitTests/Test-Engine/TransformHierarchyTests.cpp
 )
 
 set( TEST_PLATFORM_SOURCE UnitTests/unitTestCommon.h
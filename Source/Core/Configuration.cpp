@@ -37,6 +37,7 @@ bool Configuration::fromXML(const ResourcePath& xmlFilePath, const char* fileNam
         GET_PARAM(runtime.targetDisplay);
         GET_PARAM(runtime.targetRenderingAPI);
         GET_PARAM(runtime.maxWorkerThreads);
+        GET_PARAM(runtime.workStealingScheduler);
         GET_PARAM(runtime.windowedMode);
         GET_PARAM(runtime.windowResizable);
         GET_PARAM(runtime.maximizeOnStart);
@@ -69,6 +70,10 @@ bool Configuration::fromXML(const ResourcePath& xmlFilePath, const char* fileNam
         GET_PARAM(rendering.reflectionPlaneResolution);
         GET_PARAM(rendering.numLightsPerCluster);
         GET_PARAM(rendering.enableFog);
+        GET_PARAM(rendering.spatialIndexCulling);
+        GET_PARAM(rendering.sampledAnimations);
+        GET_PARAM(rendering.animationLOD);
+        GET_PARAM(rendering.animationLODBoneDepth);
         GET_PARAM(rendering.fogDensity);
         GET_PARAM(rendering.fogScatter);
         GET_PARAM_ATTRIB(rendering.fogColour, r);
@@ -78,6 +83,8 @@ bool Configuration::fromXML(const ResourcePath& xmlFilePath, const char* fileNam
         GET_PARAM_ATTRIB(rendering.lodThresholds, y);
         GET_PARAM_ATTRIB(rendering.lodThresholds, z);
         GET_PARAM_ATTRIB(rendering.lodThresholds, w);
+        GET_PARAM_ATTRIB(rendering.animationLODThresholds, x);
+        GET_PARAM_ATTRIB(rendering.animationLODThresholds, y);
         GET_PARAM(rendering.postFX.postAA.type);
         GET_PARAM(rendering.postFX.postAA.qualityLevel);
         GET_PARAM(rendering.postFX.toneMap.adaptive);
@@ -203,6 +210,7 @@ bool Configuration::toXML(const ResourcePath& xmlFilePath, const char* fileName
     PUT_PARAM(runtime.targetDisplay);
     PUT_PARAM(runtime.targetRenderingAPI);
     PUT_PARAM(runtime.maxWorkerThreads);
+    PUT_PARAM(runtime.workStealingScheduler);
     PUT_PARAM(runtime.windowedMode);
     PUT_PARAM(runtime.windowResizable);
     PUT_PARAM(runtime.maximizeOnStart);
@@ -234,6 +242,10 @@ bool Configuration::toXML(const ResourcePath& xmlFilePath, const char* fileName
     PUT_PARAM(rendering.reflectionPlaneResolution);
     PUT_PARAM(rendering.numLightsPerCluster);
     PUT_PARAM(rendering.enableFog);
+    PUT_PARAM(rendering.spatialIndexCulling);
+    PUT_PARAM(rendering.sampledAnimations);
+    PUT_PARAM(rendering.animationLOD);
+    PUT_PARAM(rendering.animationLODBoneDepth);
     PUT_PARAM(rendering.fogDensity);
     PUT_PARAM(rendering.fogScatter);
     PUT_PARAM_ATTRIB(rendering.fogColour, r);
@@ -243,6 +255,8 @@ bool Configuration::toXML(const ResourcePath& xmlFilePath, const char* fileName
     PUT_PARAM_ATTRIB(rendering.lodThresholds, y);
     PUT_PARAM_ATTRIB(rendering.lodThresholds, z);
     PUT_PARAM_ATTRIB(rendering.lodThresholds, w);
+    PUT_PARAM_ATTRIB(rendering.animationLODThresholds, x);
+    PUT_PARAM_ATTRIB(rendering.animationLODThresholds, y);
     PUT_PARAM(rendering.postFX.postAA.type);
     PUT_PARAM(rendering.postFX.postAA.qualityLevel);
     PUT_PARAM(rendering.postFX.toneMap.adaptive);
@@ -301,9 +301,10 @@ inline void ByteBuffer::readPackXYZ(F32& x, F32& y, F32& z)
 {
     U32 packed = 0;
     *this >> packed;
-    x = ((packed & 0x7FF) << 21 >> 21) * 0.25f;
-    y = ((packed >> 11 & 0x7FF) << 21 >> 21) * 0.25f;
-    z = (packed >> 22 << 22 >> 22) * 0.25f;
+    // Shift each field to the top and back down as a signed value to sign extend it
+    x = (to_I32(packed << 21) >> 21) * 0.25f;
+    y = (to_I32(packed << 10) >> 21) * 0.25f;
+    z = (to_I32(packed) >> 22) * 0.25f;
 }
 
 inline U64 ByteBuffer::readPackGUID()
@@ -81,6 +81,7 @@ struct Configuration final : XML::IXMLSerializable {
         U8 targetDisplay = 0;
         U8 targetRenderingAPI = 0;
         I16 maxWorkerThreads = -1;
+        bool workStealingScheduler = false;
         U8   windowedMode = 0;
         bool windowResizable = false;
         bool maximizeOnStart = true;
@@ -148,10 +149,15 @@ struct Configuration final : XML::IXMLSerializable {
         U16 reflectionPlaneResolution = 512;
         I32 numLightsPerCluster = -1;
         bool enableFog = true;
+        bool spatialIndexCulling = false;
+        bool sampledAnimations = false;
+        bool animationLOD = false;
+        U8 animationLODBoneDepth = U8_MAX;
         F32 fogDensity = 0.01f;
         F32 fogScatter = 0.01f;
         float3 fogColour = { 0.2f, 0.2f, 0.2f };
         vec4<U16> lodThresholds = { 25u, 45u, 85u, 165u };
+        vec2<U16> animationLODThresholds = { 30u, 80u };
         struct PostFX
         {
             struct PostAA
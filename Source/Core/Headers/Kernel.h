@@ -113,6 +113,8 @@ class Kernel final : public Input::InputAggregatorInterface,
 
         PROPERTY_RW(LoopTimingData, timingData);
         PROPERTY_RW(bool, keepAlive, true);
+        /// Started with --dedicatedServer: no window, input, audio, GUI or editor. Only the simulation and the network server run, at a fixed tick rate
+        PROPERTY_R(bool, dedicatedServer, false);
         PROPERTY_R(std::unique_ptr<ProjectManager>, projectManager);
         PROPERTY_R(std::unique_ptr<RenderPassManager>, renderPassManager);
 
@@ -200,6 +202,14 @@ class Kernel final : public Input::InputAggregatorInterface,
 
         Rect<I32> _prevViewport = { -1, -1, -1, -1 };
         U8 _prevPlayerCount = 0u;
+
+        // Dedicated server loop pacing
+        std::chrono::microseconds _serverTickInterval{ FIXED_UPDATE_RATE_US };
+        std::chrono::steady_clock::time_point _nextServerTick{};
+        // Simulation step. A dedicated server runs one step per tick, so this follows its tick rate
+        U64 _fixedStepUS{ FIXED_UPDATE_RATE_US };
+        // Network updates go out at NETWORK_SEND_FREQUENCY_HZ of wall clock time, whatever the frame or tick rate
+        U64 _nextNetworkUpdateUS{ 0u };
 };
 
 namespace Attorney
@@ -51,6 +51,8 @@ struct LoopTimingData
     PROPERTY_R( U64, gameTimeDeltaUS, 0ULL );
 
     PROPERTY_RW( U64, accumulator, 0ULL );
+    /// Duration of a simulation step, as passed to the last update call
+    PROPERTY_R( U64, fixedStepUS, FIXED_UPDATE_RATE_US );
 
     PROPERTY_RW( U8, updateLoops, 0u );
     PROPERTY_RW( bool, freezeGameTime, true );  //Pause scene processing
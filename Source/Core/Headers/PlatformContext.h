@@ -110,7 +110,8 @@ class PlatformContext final : private NonCopyable, private NonMovable
         [[nodiscard]] Networking::Server& server() noexcept { return *_server; }
         [[nodiscard]] const Networking::Server& server() const noexcept { return *_server; }
 
-        [[nodiscard]] ErrorCode init(const std::string_view serverIPAddress);
+        /// A dedicated server only starts the server. The client is still created (everything expects one) but never connects
+        [[nodiscard]] ErrorCode init(const std::string_view serverIPAddress, bool dedicatedServer);
 
         void close();
         void update();
@@ -40,6 +40,8 @@ namespace Divide {
 
         bool FindCommandLineArgument(int argc, char** argv, const char* target_arg, const char* arg_prefix = "--");
         bool ExtractStartupProject(int argc, char** argv, string& projectOut, const char* arg_prefix = "--");
+        /// Looks for an argument in the form [arg_prefix][target_arg]=[value] (e.g. --scene=WarScene). Returns false if it is missing or has no value
+        bool ExtractCommandLineValue(int argc, char** argv, const char* target_arg, string& valueOut, const char* arg_prefix = "--");
 
         template< typename T_str = string>  requires valid_replace_string<T_str>
         bool ReplaceStringInPlace(T_str& subject, std::span<const std::string_view> search, std::string_view replace, bool recursive = false);
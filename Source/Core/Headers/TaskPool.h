@@ -34,6 +34,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define DVD_TASK_POOL_H_
 
 #include "Platform/Threading/Headers/Task.h"
+#include "Core/TemplateLibraries/Headers/WorkStealingDeque.h"
 
 namespace Divide {
 
@@ -41,7 +42,9 @@ struct ParallelForDescriptor
 {
     /// For loop iteration count
     U32 _iterCount = 0u;
-    /// How many elements should we process per async task
+    /// How many elements should we process per async task.
+    /// 0 = adaptive: ranges are split in half lazily, only while other workers are idle, so uneven per-item costs balance out without tuning.
+    /// Without _waitForFinish, adaptive loops fall back to one fixed partition per thread
     U32 _partitionSize = 0u;
     /// Each async task will start with the same priority specified here
     TaskPriority _priority = TaskPriority::DONT_CARE;
@@ -55,10 +58,23 @@ struct ParallelForDescriptor
 
 using PoolTask = DELEGATE_STD<bool, bool/*threadWaitingCall*/>;
 
+enum class TaskPoolScheduler : U8
+{
+    SHARED_QUEUES = 0, ///< All workers pull from the two shared (normal and high priority) queues
+    WORK_STEALING,     ///< Each worker owns a LIFO deque and steals (FIFO) from the other workers when it runs out of work
+    COUNT
+};
+
 class TaskPool final : public GUIDWrapper {
   public:
      constexpr static bool IsBlocking = true;
      using QueueType = std::conditional_t<IsBlocking, moodycamel::BlockingConcurrentQueue<PoolTask>, moodycamel::ConcurrentQueue<PoolTask>>;
+     /// Maximum number of tasks a worker can hold locally before spilling over into the shared queue
+     constexpr static size_t WorkerDequeSize = 1u << 12;
+     using WorkerDeque = WorkStealingDeque<Task*, WorkerDequeSize>;
+     /// Maximum number of completion callbacks that can be pending (registered but not yet flushed) at any given time
+     constexpr static U32 MaxPendingCallbacks = 1u << 12;
+     static_assert(MaxPendingCallbacks <= (1u << 16), "Callback handles only have 16 bits available for the slot index!");
  
   public:
     explicit TaskPool(std::string_view workerName);
@@ -79,8 +95,9 @@ class TaskPool final : public GUIDWrapper {
     /// </summary>
     /// <param name="threadCount">The number of threads to create and initialize.</param>
     /// <param name="onThreadCreate">An optional delegate that is called when a thread is created. Receives the thread index and the thread's ID as arguments.</param>
+    /// <param name="scheduler">Selects how tasks are distributed between the worker threads.</param>
     /// <returns>True if initialization succeeds; otherwise, false.</returns>
-    bool init(size_t threadCount, DELEGATE<void, size_t, const std::thread::id&>&& onThreadCreate = {});
+    bool init(size_t threadCount, DELEGATE<void, size_t, const std::thread::id&>&& onThreadCreate = {}, TaskPoolScheduler scheduler = TaskPoolScheduler::SHARED_QUEUES);
 
     /// <summary>
     /// Shuts down the thread pool, waiting for all tasks to finish and cleaning up resources.
@@ -108,8 +125,12 @@ class TaskPool final : public GUIDWrapper {
     /// <param name="flushCallbacks">Optional parameter.  If flushCallbacks is true, this function MUST BE CALLED FROM THE MAIN THREAD as it will call flushCallbackQueue() internally</param>
     void waitForAllTasks(bool flushCallbacks = false);
 
+    /// Number of worker threads currently blocked waiting for new work. Used as a hint for splitting work on demand.
+    [[nodiscard]] U32 idleWorkerCount() const noexcept;
+
 
     PROPERTY_R( vector<std::thread>, threads );
+    PROPERTY_R( TaskPoolScheduler, scheduler, TaskPoolScheduler::SHARED_QUEUES );
 
   private:
     //ToDo: replace all friend class declarations with attorneys -Ionut;
@@ -119,7 +140,14 @@ class TaskPool final : public GUIDWrapper {
     friend void Parallel_For(TaskPool& pool, const ParallelForDescriptor& descriptor);
 
     void enqueue(Task& task, TaskPriority priority, DELEGATE<void>&& onCompletionFunction);
-    void runTask(Task& task, bool hasCompletionCallback);
+    /// Grabs a free slot in the callback table and stores a generation tagged handle to it in the task.
+    /// If every slot is still waiting to be flushed, the callback is parked on the task instead and goes through the overflow queue
+    void registerCallback(Task& task, DELEGATE<void>&& onCompletionFunction);
+    /// Resets every slot in the callback table, marks them all as free and drops any overflow callbacks
+    void resetCallbacks();
+    /// Returns false if the task can't be run at this time (e.g. it still has unfinished children and this is an idle call)
+    bool tryRunTask(Task& task, bool isIdleCall);
+    void runTask(Task& task);
 
     /// Join all of the threads and block until all running tasks have completed.
     void join();
@@ -131,25 +159,32 @@ class TaskPool final : public GUIDWrapper {
 
     QueueType& getQueue(TaskPriority priority) noexcept;
 
+    /// Work stealing scheduler path
+    void enqueueWorkStealing(Task& task, TaskPriority priority);
+    void pushSharedTask(Task& task, TaskPriority priority);
+    bool dequeWorkStealing(bool isIdleCall, Task*& taskOut);
+    bool executeOneTaskWorkStealing(bool isIdleCall);
+    /// Bumps the work epoch and wakes up whoever is blocked on it
+    void notifyWorkEpoch();
+
   private:
      const string _threadNamePrefix;
 
-     struct CallbackEntry
+     struct CallbackSlot
      {
-         CallbackEntry() = default;
-         CallbackEntry(DELEGATE<void>&& cbk, U32 taskID) noexcept
-             : _cbk(MOV(cbk)), _taskID(taskID)
-         {
-         }
-
          DELEGATE<void> _cbk;
-         U32 _taskID = U32_MAX;
+         /// Bumped every time the slot is released so that stale handles can be detected
+         U16 _generation = 0u;
      };
 
-     SharedMutex _taskCallbacksLock;
-     eastl::fixed_vector<CallbackEntry, 1 << 9, true> _taskCallbacks;
-
+     /// A slot is owned exclusively by whoever dequeued it from _freeCallbackSlots until it is handed back by flushCallbackQueue(),
+     /// so the table itself needs no locking. Handles are [generation:16 | slot:16]
+     std::array<CallbackSlot, MaxPendingCallbacks> _taskCallbacks;
+     moodycamel::ConcurrentQueue<U16> _freeCallbackSlots{ MaxPendingCallbacks };
+     /// Handles of completed tasks that have a registered callback
      moodycamel::ConcurrentQueue<U32> _threadedCallbackBuffer{};
+     /// Callbacks of completed tasks that were started while the table above was full
+     moodycamel::ConcurrentQueue<DELEGATE<void>> _overflowCallbacks{};
 
      QueueType _normalQueue;
      QueueType _highPriorityqueue;
@@ -157,8 +192,20 @@ class TaskPool final : public GUIDWrapper {
      Mutex _taskFinishedMutex;
      std::condition_variable _taskFinishedCV;
 
+     /// One deque per worker thread. Only used by the work stealing scheduler
+     std::unique_ptr<WorkerDeque[]> _workerDeques;
+     U32 _workerDequeCount{ 0u };
+     /// Tasks submitted from outside of the pool's worker threads (or that didn't fit in a worker's deque)
+     moodycamel::ConcurrentQueue<Task*> _sharedTasks;
+     moodycamel::ConcurrentQueue<Task*> _sharedHighPriorityTasks;
+     /// Bumped every time work becomes available. Idle workers block on it instead of on a mutex/CV pair
+     std::atomic_uint _workEpoch{ 0u };
+
      std::atomic_uint _runningTaskCount = 0u;
      std::atomic_size_t _activeThreads{ 0u };
+     std::atomic_uint _idleWorkerCount{ 0u };
+     /// Threads blocked in waitForTask. They share _workEpoch with idle workers and also need waking when any task finishes
+     std::atomic_uint _waitingThreadCount{ 0u };
 
      std::atomic_bool _isRunning;
 };
@@ -47,6 +47,11 @@ namespace Divide {
         return CreateTask(nullptr, MOV(threadedFunction) );
     }
 
+    FORCE_INLINE U32 TaskPool::idleWorkerCount() const noexcept
+    {
+        return _idleWorkerCount.load( std::memory_order_relaxed );
+    }
+
     FORCE_INLINE TaskPool::QueueType& TaskPool::getQueue(const TaskPriority priority) noexcept
     {
         return (priority == TaskPriority::HIGH) ? _highPriorityqueue : _normalQueue;
@@ -42,6 +42,14 @@ namespace
     constexpr U8 g_renderThreadCount = 1u;
 
     U32 g_printTimer = g_printTimerBase;
+
+    /// Dedicated servers don't play sounds, draw a GUI, run the editor or read input
+    constexpr U32 g_dedicatedServerComponentMask = to_base( PlatformContext::SystemComponentType::ALL ) &
+                                                   ~(to_base( PlatformContext::SystemComponentType::SFXDevice ) |
+                                                     to_base( PlatformContext::SystemComponentType::GUI ) |
+                                                     to_base( PlatformContext::SystemComponentType::Editor ) |
+                                                     to_base( PlatformContext::SystemComponentType::InputHandler ));
+    constexpr I32 g_maxServerTickRate = 1000;
 };
 
 size_t Kernel::TotalThreadCount( const TaskPoolType type ) noexcept
@@ -214,7 +222,7 @@ void Kernel::onLoop()
         keepAlive(true);
 
         // Update time at every render loop
-        _timingData.update( Time::App::ElapsedMicroseconds(), FIXED_UPDATE_RATE_US );
+        _timingData.update( Time::App::ElapsedMicroseconds(), _fixedStepUS );
 
         FrameEvent evt = {};
         evt._time._app._currentTimeUS = _timingData.appCurrentTimeUS();
@@ -224,7 +232,7 @@ void Kernel::onLoop()
         evt._time._game._deltaTimeUS = _timingData.gameTimeDeltaUS();
 
         {
-            _platformContext.componentMask( to_base( PlatformContext::SystemComponentType::ALL ) );
+            _platformContext.componentMask( dedicatedServer() ? g_dedicatedServerComponentMask : to_base( PlatformContext::SystemComponentType::ALL ) );
             {
                 Time::ScopedTimer timer3(_frameTimer);
 
@@ -289,7 +297,7 @@ void Kernel::onLoop()
             }
 
 #           if ENABLE_FUNCTION_PROFILING
-                if (GFXDevice::FrameCount() % (Config::TARGET_FRAME_RATE / 8) == 0u)
+                if (!dedicatedServer() && GFXDevice::FrameCount() % (Config::TARGET_FRAME_RATE / 8) == 0u)
                 {
                     _platformContext.gui().modifyText("ProfileData", platformContext().debug().output(), true);
                 }
@@ -298,7 +306,7 @@ void Kernel::onLoop()
 
         if constexpr(!Config::Build::IS_SHIPPING_BUILD)
         {
-            if (GFXDevice::FrameCount() % (Config::TARGET_FRAME_RATE / 8) == 0u)
+            if (!dedicatedServer() && GFXDevice::FrameCount() % (Config::TARGET_FRAME_RATE / 8) == 0u)
             {
                 DisplayWindow& window = _platformContext.mainWindow();
                 NO_DESTROY static string originalTitle = window.title();
@@ -329,6 +337,23 @@ void Kernel::onLoop()
         ResourceCache::OnFrameEnd();
     }
 
+    if (dedicatedServer())
+    {
+        // Sleep until the next tick instead of spinning. Ticks are scheduled on absolute time points so sleep granularity doesn't drift the rate.
+        // If we fell behind, tick again right away and schedule from now: the update loop's accumulator catches the simulation up, not back to back ticks
+        _nextServerTick += _serverTickInterval;
+        const auto now = std::chrono::steady_clock::now();
+        if (_nextServerTick > now)
+        {
+            std::this_thread::sleep_until(_nextServerTick);
+        }
+        else
+        {
+            _nextServerTick = now;
+        }
+        return;
+    }
+
     // Cap FPS
     const I16 frameLimit = _platformContext.config().runtime.frameRateLimit;
     if (frameLimit > 0)
@@ -359,7 +384,7 @@ bool Kernel::mainLoopScene(FrameEvent& evt)
         Camera::Update( evt._time._app._deltaTimeUS );
     }
 
-    if (_platformContext.mainWindow().minimized())
+    if (!dedicatedServer() && _platformContext.mainWindow().minimized())
     {
         idle(false, 0u, evt._time._app._deltaTimeUS );
         SDLEventManager::pollEvents();
@@ -377,12 +402,13 @@ bool Kernel::mainLoopScene(FrameEvent& evt)
 
             constexpr U8 MAX_FRAME_SKIP = 4u;
 
+            if (!dedicatedServer())
             {
                 PROFILE_SCOPE("GUI Update", Profiler::Category::IO );
                 _projectManager->activeProject()->getActiveScene()->processGUI( evt._time._game._deltaTimeUS, evt._time._app._deltaTimeUS );
             }
 
-            while (_timingData.accumulator() >= FIXED_UPDATE_RATE_US)
+            while (_timingData.accumulator() >= _fixedStepUS)
             {
                 PROFILE_SCOPE("Run Update Loop", Profiler::Category::IO);
                 // Everything inside here should use fixed timesteps, apart from GFX updates which should use both!
@@ -420,7 +446,7 @@ bool Kernel::mainLoopScene(FrameEvent& evt)
                 Attorney::GFXDeviceKernel::update(_platformContext.gfx(), evt._time._game._deltaTimeUS, evt._time._app._deltaTimeUS );
 
                 _timingData.updateLoops(_timingData.updateLoops() + 1u);
-                _timingData.accumulator(_timingData.accumulator() - FIXED_UPDATE_RATE_US);
+                _timingData.accumulator(_timingData.accumulator() - _fixedStepUS);
 
                 const U8 loopCount = _timingData.updateLoops();
                 if (loopCount == 1u)
@@ -429,15 +455,23 @@ bool Kernel::mainLoopScene(FrameEvent& evt)
                 }
                 else if (loopCount == MAX_FRAME_SKIP)
                 {
-                    _timingData.accumulator(FIXED_UPDATE_RATE_US);
+                    _timingData.accumulator(_fixedStepUS);
                     break;
                 }
             }
         }
     }
 
-    if (GFXDevice::FrameCount() % (Config::TARGET_FRAME_RATE / Config::Networking::NETWORK_SEND_FREQUENCY_HZ) == 0)
+    constexpr U64 networkUpdateIntervalUS = Time::SecondsToMicroseconds<U64>(1) / Config::Networking::NETWORK_SEND_FREQUENCY_HZ;
+    if (_timingData.appCurrentTimeUS() >= _nextNetworkUpdateUS)
     {
+        // Same catch up rule as the server tick: if we fell behind, schedule from now instead of sending back to back
+        _nextNetworkUpdateUS += networkUpdateIntervalUS;
+        if (_nextNetworkUpdateUS <= _timingData.appCurrentTimeUS())
+        {
+            _nextNetworkUpdateUS = _timingData.appCurrentTimeUS() + networkUpdateIntervalUS;
+        }
+
         U32 retryCount = 0;
         while (!Attorney::ProjectManagerKernel::networkUpdate(_projectManager.get(), GFXDevice::FrameCount()))
         {
@@ -453,6 +487,12 @@ bool Kernel::mainLoopScene(FrameEvent& evt)
     // Update windows and get input events
     SDLEventManager::pollEvents();
 
+    if (dedicatedServer())
+    {
+        // Nothing to draw. Events still get polled above so that SIGINT/SIGTERM (SDL_EVENT_QUIT) shut us down cleanly
+        return true;
+    }
+
     // Update the graphical user interface
     _platformContext.gui().update( evt._time._game._deltaTimeUS );
 
@@ -657,9 +697,16 @@ void Kernel::warmup()
     }
     _timingData.freezeGameTime(false);
 
-    _timingData.update(Time::App::ElapsedMicroseconds(), FIXED_UPDATE_RATE_US );
+    _timingData.update(Time::App::ElapsedMicroseconds(), _fixedStepUS );
 
-    stopSplashScreen();
+    if (dedicatedServer())
+    {
+        _nextServerTick = std::chrono::steady_clock::now();
+    }
+    else
+    {
+        stopSplashScreen();
+    }
 
     Attorney::ProjectManagerKernel::initPostLoadState(_projectManager.get());
 }
@@ -697,11 +744,38 @@ ErrorCode Kernel::initialize(const string& entryPoint)
         config.runtime.enableEditor = false;
     }
 
+    _dedicatedServer = Util::FindCommandLineArgument(_argc, _argv, "dedicatedServer");
+    if (dedicatedServer())
+    {
+        // The config isn't saved on shutdown in this mode, so this doesn't leak into regular runs
+        config.runtime.enableEditor = false;
+
+        I32 tickRate = to_I32(TICKS_PER_SECOND);
+        string tickRateArg;
+        if (Util::ExtractCommandLineValue(_argc, _argv, "tickRate", tickRateArg))
+        {
+            tickRate = CLAMPED(atoi(tickRateArg.c_str()), 1, g_maxServerTickRate);
+        }
+        _serverTickInterval = std::chrono::microseconds(Time::SecondsToMicroseconds<U64>(1) / to_U64(tickRate));
+        // One simulation step per tick. Stepping at the default rate instead would need (default rate / tick rate) steps per tick and hit MAX_FRAME_SKIP at low rates
+        _fixedStepUS = to_U64(_serverTickInterval.count());
+
+        Console::printfn(LOCALE_STR("START_DEDICATED_SERVER"), tickRate);
+    }
+
     if ( Util::ExtractStartupProject( _argc, _argv, config.startupProject ) )
     {
         Console::printfn( LOCALE_STR( "START_APPLICATION_PROJECT_ARGUMENT" ) , config.startupProject.c_str() );
     }
 
+    SceneEntry startupScene{};
+    string startupSceneArg;
+    if ( Util::ExtractCommandLineValue( _argc, _argv, "scene", startupSceneArg ) )
+    {
+        startupScene._name = startupSceneArg.c_str();
+        Console::printfn( LOCALE_STR( "START_APPLICATION_SCENE_ARGUMENT" ), startupSceneArg.c_str() );
+    }
+
     if (config.runtime.targetRenderingAPI >= to_U8(RenderAPI::COUNT))
     {
         config.runtime.targetRenderingAPI = to_U8(RenderAPI::OpenGL);
@@ -715,13 +789,13 @@ ErrorCode Kernel::initialize(const string& entryPoint)
         _platformContext.pfx().apiID(PXDevice::PhysicsAPI::Jolt);
 #   endif //WINDOWS_OS_BUILD
 
-    _platformContext.sfx().apiID(SFXDevice::AudioAPI::SDL);
+    _platformContext.sfx().apiID(dedicatedServer() ? SFXDevice::AudioAPI::None : SFXDevice::AudioAPI::SDL);
 
     Console::printfn( LOCALE_STR( "START_APPLICATION_WORKING_DIRECTORY" ) , systemInfo._workingDirectory.string() );
 
     Console::printfn( LOCALE_STR( "START_NETWORK_INTERFACE" ) ) ;
 
-    ErrorCode initError = _platformContext.networking().init(config.serverAddress);
+    ErrorCode initError = _platformContext.networking().init(config.serverAddress, dedicatedServer());
 
     if (initError != ErrorCode::NO_ERR)
     {
@@ -732,7 +806,7 @@ ErrorCode Kernel::initialize(const string& entryPoint)
 
     Console::printfn(LOCALE_STR("START_RENDER_INTERFACE"));
 
-    const RenderAPI renderingAPI = static_cast<RenderAPI>(config.runtime.targetRenderingAPI);
+    const RenderAPI renderingAPI = dedicatedServer() ? RenderAPI::None : static_cast<RenderAPI>(config.runtime.targetRenderingAPI);
 
     initError = Attorney::ApplicationKernel::SetRenderingAPI(_platformContext.app(), renderingAPI);
 
@@ -755,6 +829,7 @@ ErrorCode Kernel::initialize(const string& entryPoint)
 
     { // Start thread pools
         std::atomic_size_t threadCounter = TotalThreadCount(TaskPoolType::COUNT);
+        const TaskPoolScheduler scheduler = config.runtime.workStealingScheduler ? TaskPoolScheduler::WORK_STEALING : TaskPoolScheduler::SHARED_QUEUES;
 
         for ( U8 i = 0u; i < to_base(TaskPoolType::COUNT); ++i)
         {
@@ -765,7 +840,8 @@ ErrorCode Kernel::initialize(const string& entryPoint)
                 {
                     Attorney::PlatformContextKernel::onThreadCreated( ctx, poolType, threadIndex, threadID, false);
                     threadCounter.fetch_sub(1);
-                }))
+                },
+                scheduler))
             {
                 return ErrorCode::CPU_NOT_SUPPORTED;
             }
@@ -784,13 +860,16 @@ ErrorCode Kernel::initialize(const string& entryPoint)
     SceneEnvironmentProbePool::OnStartup(_platformContext.gfx());
 
     _inputConsumers.resize(0);
-    if constexpr(Config::Build::ENABLE_EDITOR)
+    if (!dedicatedServer())
     {
-        _inputConsumers.emplace_back(&_platformContext.editor(), InputConsumerType::Editor);
-    }
+        if constexpr(Config::Build::ENABLE_EDITOR)
+        {
+            _inputConsumers.emplace_back(&_platformContext.editor(), InputConsumerType::Editor);
+        }
 
-    _inputConsumers.emplace_back(&_platformContext.gui(), InputConsumerType::GUI);
-    _inputConsumers.emplace_back(_projectManager.get(), InputConsumerType::Scene);
+        _inputConsumers.emplace_back(&_platformContext.gui(), InputConsumerType::GUI);
+        _inputConsumers.emplace_back(_projectManager.get(), InputConsumerType::Scene);
+    }
 
     // Add our needed app-wide render passes. RenderPassManager is responsible for deleting these!
     _renderPassManager->setRenderPass(RenderStage::SHADOW,       {   });
@@ -801,37 +880,44 @@ ErrorCode Kernel::initialize(const string& entryPoint)
 
     Console::printfn(LOCALE_STR("SCENE_ADD_DEFAULT_CAMERA"));
 
-    WindowManager& winManager = _platformContext.app().windowManager();
-    winManager.mainWindow()->addEventListener(WindowEvent::LOST_FOCUS,
+    if (!dedicatedServer())
     {
-        ._cbk = [mgr = _projectManager.get()](const DisplayWindow::WindowEventArgs& )
+        WindowManager& winManager = _platformContext.app().windowManager();
+        winManager.mainWindow()->addEventListener(WindowEvent::LOST_FOCUS,
         {
-            mgr->onChangeFocus(false);
-            return true;
-        },
-        ._name = "Kernel::LOST_FOCUS"
-    });
+            ._cbk = [mgr = _projectManager.get()](const DisplayWindow::WindowEventArgs& )
+            {
+                mgr->onChangeFocus(false);
+                return true;
+            },
+            ._name = "Kernel::LOST_FOCUS"
+        });
 
-    winManager.mainWindow()->addEventListener(WindowEvent::GAINED_FOCUS,
-    {
-        ._cbk = [mgr = _projectManager.get()](const DisplayWindow::WindowEventArgs& )
+        winManager.mainWindow()->addEventListener(WindowEvent::GAINED_FOCUS,
         {
-            mgr->onChangeFocus(true);
-            return true;
-        },
-        ._name = "Kernel::GAINED_FOCUS"
-    });
+            ._cbk = [mgr = _projectManager.get()](const DisplayWindow::WindowEventArgs& )
+            {
+                mgr->onChangeFocus(true);
+                return true;
+            },
+            ._name = "Kernel::GAINED_FOCUS"
+        });
+    }
 
     Script::OnStartup();
     ProjectManager::OnStartup(_platformContext);
-    // Initialize GUI with our current resolution
-    initError = _platformContext.gui().init(_platformContext);
-    if ( initError != ErrorCode::NO_ERR )
+
+    if (!dedicatedServer())
     {
-        return initError;
-    }
+        // Initialize GUI with our current resolution
+        initError = _platformContext.gui().init(_platformContext);
+        if ( initError != ErrorCode::NO_ERR )
+        {
+            return initError;
+        }
 
-    startSplashScreen();
+        startSplashScreen();
+    }
 
     Console::printfn(LOCALE_STR("START_SOUND_INTERFACE"));
     initError = _platformContext.sfx().initAudioAPI();
@@ -888,7 +974,7 @@ ErrorCode Kernel::initialize(const string& entryPoint)
         return ErrorCode::MISSING_PROJECT_DATA;
     }
 
-    initError = _projectManager->loadProject( targetProject, false );
+    initError = _projectManager->loadProject( targetProject, false, startupScene );
 
     if ( initError != ErrorCode::NO_ERR )
     {
@@ -904,22 +990,25 @@ ErrorCode Kernel::initialize(const string& entryPoint)
     }
 
 #if ENABLE_FUNCTION_PROFILING
-    _platformContext.gui().addText("ProfileData",                // Unique ID
-                                    RelativePosition2D{
-                                         ._x = RelativeValue{
-                                             ._scale = 0.75f, 
-                                             ._offset = 0.0f
-                                         },
-                                         ._y = RelativeValue{
-                                             ._scale = 0.2f,
-                                             ._offset = 0.0f
-                                         }
-                                    },                           // Position
-                                    Font::DROID_SERIF_BOLD,      // Font
-                                    UColour4(255,  50, 0, 255),  // Colour
-                                    "",                          // Text
-                                    true,                        // Multiline
-                                    12);                         // Font size
+    if (!dedicatedServer())
+    {
+        _platformContext.gui().addText("ProfileData",                // Unique ID
+                                        RelativePosition2D{
+                                             ._x = RelativeValue{
+                                                 ._scale = 0.75f, 
+                                                 ._offset = 0.0f
+                                             },
+                                             ._y = RelativeValue{
+                                                 ._scale = 0.2f,
+                                                 ._offset = 0.0f
+                                             }
+                                        },                           // Position
+                                        Font::DROID_SERIF_BOLD,      // Font
+                                        UColour4(255,  50, 0, 255),  // Colour
+                                        "",                          // Text
+                                        true,                        // Multiline
+                                        12);                         // Font size
+    }
 #endif //ENABLE_FUNCTION_PROFILING
 
     ShadowMap::initShadowMaps(_platformContext.gfx());
@@ -928,20 +1017,22 @@ ErrorCode Kernel::initialize(const string& entryPoint)
 
     if constexpr (Config::Build::ENABLE_EDITOR) 
     {
-        if (!_platformContext.editor().init(config.runtime.resolution)) 
+        if (!dedicatedServer())
         {
-            return ErrorCode::EDITOR_INIT_ERROR;
-        }
-        _projectManager->addSelectionCallback([ctx = &_platformContext](const PlayerIndex idx, const vector<SceneGraphNode*>& nodes)
-        {
-            ctx->editor().selectionChangeCallback(idx, nodes);
-        });
+            if (!_platformContext.editor().init(config.runtime.resolution)) 
+            {
+                return ErrorCode::EDITOR_INIT_ERROR;
+            }
+            _projectManager->addSelectionCallback([ctx = &_platformContext](const PlayerIndex idx, const vector<SceneGraphNode*>& nodes)
+            {
+                ctx->editor().selectionChangeCallback(idx, nodes);
+            });
 
-        if (!config.runtime.enableEditor)
-        {
-            _platformContext.editor().toggle(false);
+            if (!config.runtime.enableEditor)
+            {
+                _platformContext.editor().toggle(false);
+            }
         }
-
     }
 
     Console::printfn(LOCALE_STR("INITIAL_DATA_LOADED"));
@@ -953,7 +1044,10 @@ void Kernel::shutdown()
 {
     Console::printfn(LOCALE_STR("STOP_KERNEL"));
 
-    _platformContext.config().save();
+    if (!dedicatedServer())
+    {
+        _platformContext.config().save();
+    }
 
     for (U8 i = 0u; i < to_U8(TaskPoolType::COUNT); ++i)
     {
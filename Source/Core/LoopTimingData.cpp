@@ -6,13 +6,14 @@ namespace Divide
 {
     F32 LoopTimingData::alpha() const noexcept
     {
-        const F32 diff = Time::MicrosecondsToMilliseconds<F32>( _accumulator ) / Time::MicrosecondsToMilliseconds<F32>( FIXED_UPDATE_RATE_US );
+        const F32 diff = Time::MicrosecondsToMilliseconds<F32>( _accumulator ) / Time::MicrosecondsToMilliseconds<F32>( _fixedStepUS );
         return _freezeGameTime ? 1.f : CLAMPED_01( diff );
     }
 
     void LoopTimingData::update( const U64 elapsedTimeUSApp, const U64 fixedGameTickDurationUS ) noexcept
     {
         _updateLoops = 0u;
+        _fixedStepUS = fixedGameTickDurationUS;
 
         _gameTimeDeltaUS = _freezeGameTime ? 0u : fixedGameTickDurationUS;
         _gameCurrentTimeUS += _gameTimeDeltaUS;
@@ -20,7 +21,8 @@ namespace Divide
         // In case we break in the debugger
         _appTimeDeltaUS = elapsedTimeUSApp - _appCurrentTimeUS;
         _appCurrentTimeUS += _appTimeDeltaUS;
-        _appTimeDeltaUS = std::min( _appTimeDeltaUS, MAX_FRAME_TIME_US);
+        // Never clamp below a single step, or slow fixed rates (e.g. a low tick rate dedicated server) would never accumulate enough time to update
+        _appTimeDeltaUS = std::min( _appTimeDeltaUS, std::max( MAX_FRAME_TIME_US, fixedGameTickDurationUS ) );
 
         _accumulator += _appTimeDeltaUS;
     }
@@ -0,0 +1,135 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_CORE_MATH_BOUNDINGVOLUMES_DYNAMIC_AABB_TREE_H_
+#define DVD_CORE_MATH_BOUNDINGVOLUMES_DYNAMIC_AABB_TREE_H_
+
+#include "BoundingBox.h"
+
+namespace Divide
+{
+
+/// A bounding volume hierarchy of axis aligned boxes that supports cheap incremental updates.
+/// Each proxy (leaf) stores an enlarged ("fat") copy of the bounds it was given, so small movements don't touch the tree at all.
+/// Insertion picks the sibling with the lowest surface area cost and every modified branch gets rebalanced with a tree rotation,
+/// so inserting, removing and moving a proxy is O(log n) and overlap queries only visit the branches that can contain a hit.
+/// Not thread safe.
+template<typename T>
+class DynamicAABBTree
+{
+  public:
+    using ProxyID = U32;
+    static constexpr ProxyID INVALID_PROXY = U32_MAX;
+
+    /// fatMargin: how much (in world units) a proxy's bounds get extended on every side when stored in the tree
+    explicit DynamicAABBTree( F32 fatMargin = 0.25f );
+
+    [[nodiscard]] ProxyID createProxy( const BoundingBox& aabb, const T& userData );
+    void destroyProxy( ProxyID proxy );
+    /// Returns true if the proxy had to be re-inserted because the new bounds are no longer contained by its fat bounds
+    bool moveProxy( ProxyID proxy, const BoundingBox& aabb );
+
+    [[nodiscard]] const T& userData( ProxyID proxy ) const;
+    [[nodiscard]] const BoundingBox& fatAABB( ProxyID proxy ) const;
+
+    /// Calls cbk(proxyID) for every proxy whose fat bounds overlap aabb. Stops early if cbk returns false.
+    template<typename Callback>
+    void query( const BoundingBox& aabb, Callback&& cbk ) const;
+
+    /// Top down traversal for hierarchical culling. classify(fatAABB) returns FRUSTUM_OUT to skip a branch, FRUSTUM_INTERSECT to keep testing
+    /// its children or FRUSTUM_IN to accept every proxy below it without further tests. Calls cbk(proxyID, fullyInside) for each accepted proxy.
+    template<typename Classifier, typename Callback>
+    void cull( Classifier&& classify, Callback&& cbk ) const;
+
+    /// Same as cull, but visits the tree one level at a time and classifies every node of a level with a single call, so batched (SIMD) tests can be used:
+    /// classify(const BoundingBox* const* fatAABBs, size_t count, FrustumCollision* resultsOut)
+    template<typename BatchClassifier, typename Callback>
+    void cullBatched( BatchClassifier&& classify, Callback&& cbk ) const;
+
+    void clear();
+
+    [[nodiscard]] size_t proxyCount() const noexcept { return _proxyCount; }
+    /// Height of the root node. Leaves have a height of 0. Returns -1 for an empty tree
+    [[nodiscard]] I32 height() const noexcept;
+    /// Checks every structural invariant of the tree (parent links, node count, heights and enclosing bounds). Slow.
+    [[nodiscard]] bool validate() const;
+
+  private:
+    static constexpr U32 NULL_NODE = U32_MAX;
+
+    struct Node
+    {
+        BoundingBox _aabb;
+        T _userData{};
+        U32 _parent{ NULL_NODE };
+        U32 _next{ NULL_NODE };
+        U32 _child1{ NULL_NODE };
+        U32 _child2{ NULL_NODE };
+        /// Leaves have a height of 0, free nodes -1
+        I32 _height{ -1 };
+
+        [[nodiscard]] bool isLeaf() const noexcept { return _child1 == NULL_NODE; }
+    };
+
+    /// Calls cbk(proxyID, true) for every leaf below node
+    template<typename Callback>
+    void acceptSubtree( U32 node, Callback&& cbk ) const;
+
+    [[nodiscard]] U32 allocateNode();
+    void freeNode( U32 node );
+
+    void insertLeaf( U32 leaf );
+    void removeLeaf( U32 leaf );
+    /// Performs a left or right rotation if the node's children differ in height by more than 1. Returns the new root of the subtree
+    [[nodiscard]] U32 balance( U32 node );
+    void refit( U32 node );
+
+    [[nodiscard]] bool validateNode( U32 node ) const;
+
+    [[nodiscard]] static BoundingBox Merge( const BoundingBox& lhs, const BoundingBox& rhs ) noexcept;
+    [[nodiscard]] static F32 SurfaceArea( const BoundingBox& aabb ) noexcept;
+    /// Per-axis inclusive test. BoundingBox::containsAABB rejects boxes that share a face with the container
+    [[nodiscard]] static bool Contains( const BoundingBox& outer, const BoundingBox& inner ) noexcept;
+
+  private:
+    vector<Node> _nodes;
+    U32 _root{ NULL_NODE };
+    U32 _freeList{ NULL_NODE };
+    size_t _proxyCount{ 0u };
+    F32 _fatMargin{ 0.25f };
+};
+
+} //namespace Divide
+
+#endif //DVD_CORE_MATH_BOUNDINGVOLUMES_DYNAMIC_AABB_TREE_H_
+
+#include "DynamicAABBTree.inl"
@@ -0,0 +1,628 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef DVD_CORE_MATH_BOUNDINGVOLUMES_DYNAMIC_AABB_TREE_INL_
+#define DVD_CORE_MATH_BOUNDINGVOLUMES_DYNAMIC_AABB_TREE_INL_
+
+namespace Divide
+{
+
+template<typename T>
+DynamicAABBTree<T>::DynamicAABBTree( const F32 fatMargin )
+    : _fatMargin( fatMargin )
+{
+}
+
+template<typename T>
+typename DynamicAABBTree<T>::ProxyID DynamicAABBTree<T>::createProxy( const BoundingBox& aabb, const T& userData )
+{
+    const U32 proxy = allocateNode();
+
+    Node& node = _nodes[proxy];
+    node._aabb.set( aabb._min - _fatMargin, aabb._max + _fatMargin );
+    node._userData = userData;
+    node._height = 0;
+
+    insertLeaf( proxy );
+    ++_proxyCount;
+
+    return proxy;
+}
+
+template<typename T>
+void DynamicAABBTree<T>::destroyProxy( const ProxyID proxy )
+{
+    DIVIDE_ASSERT( proxy < _nodes.size() && _nodes[proxy].isLeaf() && _nodes[proxy]._height == 0 );
+
+    removeLeaf( proxy );
+    freeNode( proxy );
+    --_proxyCount;
+}
+
+template<typename T>
+bool DynamicAABBTree<T>::moveProxy( const ProxyID proxy, const BoundingBox& aabb )
+{
+    DIVIDE_ASSERT( proxy < _nodes.size() && _nodes[proxy].isLeaf() && _nodes[proxy]._height == 0 );
+
+    if ( Contains( _nodes[proxy]._aabb, aabb ) )
+    {
+        return false;
+    }
+
+    removeLeaf( proxy );
+    _nodes[proxy]._aabb.set( aabb._min - _fatMargin, aabb._max + _fatMargin );
+    insertLeaf( proxy );
+
+    return true;
+}
+
+template<typename T>
+const T& DynamicAABBTree<T>::userData( const ProxyID proxy ) const
+{
+    DIVIDE_ASSERT( proxy < _nodes.size() );
+    return _nodes[proxy]._userData;
+}
+
+template<typename T>
+const BoundingBox& DynamicAABBTree<T>::fatAABB( const ProxyID proxy ) const
+{
+    DIVIDE_ASSERT( proxy < _nodes.size() );
+    return _nodes[proxy]._aabb;
+}
+
+template<typename T>
+template<typename Callback>
+void DynamicAABBTree<T>::query( const BoundingBox& aabb, Callback&& cbk ) const
+{
+    eastl::fixed_vector<U32, 256, true> stack;
+    stack.push_back( _root );
+
+    while ( !stack.empty() )
+    {
+        const U32 nodeID = stack.back();
+        stack.pop_back();
+
+        if ( nodeID == NULL_NODE )
+        {
+            continue;
+        }
+
+        const Node& node = _nodes[nodeID];
+        if ( !node._aabb.collision( aabb ) )
+        {
+            continue;
+        }
+
+        if ( node.isLeaf() )
+        {
+            if ( !cbk( nodeID ) )
+            {
+                return;
+            }
+        }
+        else
+        {
+            stack.push_back( node._child1 );
+            stack.push_back( node._child2 );
+        }
+    }
+}
+
+template<typename T>
+template<typename Classifier, typename Callback>
+void DynamicAABBTree<T>::cull( Classifier&& classify, Callback&& cbk ) const
+{
+    if ( _root == NULL_NODE )
+    {
+        return;
+    }
+
+    struct Entry
+    {
+        U32 _node{ NULL_NODE };
+        bool _fullyInside{ false };
+    };
+
+    eastl::fixed_vector<Entry, 256, true> stack;
+    stack.push_back( { _root, false } );
+
+    while ( !stack.empty() )
+    {
+        const Entry entry = stack.back();
+        stack.pop_back();
+
+        const Node& node = _nodes[entry._node];
+
+        bool fullyInside = entry._fullyInside;
+        if ( !fullyInside )
+        {
+            const FrustumCollision result = classify( node._aabb );
+            if ( result == FrustumCollision::FRUSTUM_OUT )
+            {
+                continue;
+            }
+            fullyInside = result == FrustumCollision::FRUSTUM_IN;
+        }
+
+        if ( node.isLeaf() )
+        {
+            cbk( entry._node, fullyInside );
+        }
+        else
+        {
+            stack.push_back( { node._child1, fullyInside } );
+            stack.push_back( { node._child2, fullyInside } );
+        }
+    }
+}
+
+template<typename T>
+template<typename BatchClassifier, typename Callback>
+void DynamicAABBTree<T>::cullBatched( BatchClassifier&& classify, Callback&& cbk ) const
+{
+    if ( _root == NULL_NODE )
+    {
+        return;
+    }
+
+    // Double buffered so that moving to the next level doesn't copy the in-place storage
+    eastl::fixed_vector<U32, 256, true> levels[2];
+    eastl::fixed_vector<const BoundingBox*, 256, true> aabbs;
+    eastl::fixed_vector<FrustumCollision, 256, true> results;
+
+    U8 crtLevel = 0u;
+    levels[crtLevel].push_back( _root );
+    while ( !levels[crtLevel].empty() )
+    {
+        const auto& level = levels[crtLevel];
+        auto& nextLevel = levels[crtLevel ^ 1u];
+
+        const size_t count = level.size();
+        aabbs.resize( count );
+        results.resize( count );
+        for ( size_t i = 0u; i < count; ++i )
+        {
+            aabbs[i] = &_nodes[level[i]]._aabb;
+        }
+
+        classify( aabbs.data(), count, results.data() );
+
+        nextLevel.resize( 0 );
+        for ( size_t i = 0u; i < count; ++i )
+        {
+            const U32 nodeID = level[i];
+            switch ( results[i] )
+            {
+                case FrustumCollision::FRUSTUM_OUT: break;
+                case FrustumCollision::FRUSTUM_IN: acceptSubtree( nodeID, cbk ); break;
+                default:
+                {
+                    const Node& node = _nodes[nodeID];
+                    if ( node.isLeaf() )
+                    {
+                        cbk( nodeID, false );
+                    }
+                    else
+                    {
+                        nextLevel.push_back( node._child1 );
+                        nextLevel.push_back( node._child2 );
+                    }
+                } break;
+            }
+        }
+
+        crtLevel ^= 1u;
+    }
+}
+
+template<typename T>
+template<typename Callback>
+void DynamicAABBTree<T>::acceptSubtree( const U32 node, Callback&& cbk ) const
+{
+    eastl::fixed_vector<U32, 256, true> stack;
+    stack.push_back( node );
+
+    while ( !stack.empty() )
+    {
+        const U32 nodeID = stack.back();
+        stack.pop_back();
+
+        const Node& crtNode = _nodes[nodeID];
+        if ( crtNode.isLeaf() )
+        {
+            cbk( nodeID, true );
+        }
+        else
+        {
+            stack.push_back( crtNode._child1 );
+            stack.push_back( crtNode._child2 );
+        }
+    }
+}
+
+template<typename T>
+void DynamicAABBTree<T>::clear()
+{
+    _nodes.clear();
+    _root = NULL_NODE;
+    _freeList = NULL_NODE;
+    _proxyCount = 0u;
+}
+
+template<typename T>
+I32 DynamicAABBTree<T>::height() const noexcept
+{
+    return _root == NULL_NODE ? -1 : _nodes[_root]._height;
+}
+
+template<typename T>
+bool DynamicAABBTree<T>::validate() const
+{
+    if ( _root == NULL_NODE )
+    {
+        return _proxyCount == 0u;
+    }
+
+    if ( _nodes[_root]._parent != NULL_NODE )
+    {
+        return false;
+    }
+
+    size_t freeCount = 0u;
+    for ( U32 freeNode = _freeList; freeNode != NULL_NODE; freeNode = _nodes[freeNode]._next )
+    {
+        ++freeCount;
+    }
+
+    // A binary tree with N leaves always has N - 1 internal nodes
+    return freeCount + 2u * _proxyCount - 1u == _nodes.size() && validateNode( _root );
+}
+
+template<typename T>
+bool DynamicAABBTree<T>::validateNode( const U32 nodeID ) const
+{
+    const Node& node = _nodes[nodeID];
+    if ( node.isLeaf() )
+    {
+        return node._child2 == NULL_NODE && node._height == 0;
+    }
+
+    const Node& child1 = _nodes[node._child1];
+    const Node& child2 = _nodes[node._child2];
+
+    return child1._parent == nodeID &&
+           child2._parent == nodeID &&
+           node._height == 1 + std::max( child1._height, child2._height ) &&
+           Contains( node._aabb, child1._aabb ) &&
+           Contains( node._aabb, child2._aabb ) &&
+           validateNode( node._child1 ) &&
+           validateNode( node._child2 );
+}
+
+template<typename T>
+U32 DynamicAABBTree<T>::allocateNode()
+{
+    U32 nodeID = _freeList;
+    if ( nodeID != NULL_NODE )
+    {
+        _freeList = _nodes[nodeID]._next;
+        _nodes[nodeID] = {};
+    }
+    else
+    {
+        nodeID = to_U32( _nodes.size() );
+        _nodes.emplace_back();
+    }
+
+    return nodeID;
+}
+
+template<typename T>
+void DynamicAABBTree<T>::freeNode( const U32 nodeID )
+{
+    Node& node = _nodes[nodeID];
+    node = {};
+    node._next = _freeList;
+    _freeList = nodeID;
+}
+
+template<typename T>
+void DynamicAABBTree<T>::insertLeaf( const U32 leaf )
+{
+    if ( _root == NULL_NODE )
+    {
+        _root = leaf;
+        _nodes[_root]._parent = NULL_NODE;
+        return;
+    }
+
+    // Find the best sibling for the new leaf: descend while making the new leaf a child of the current node costs more
+    // than pushing it further down (cost = surface area added to the tree)
+    const BoundingBox leafAABB = _nodes[leaf]._aabb;
+    U32 index = _root;
+    while ( !_nodes[index].isLeaf() )
+    {
+        const Node& node = _nodes[index];
+
+        const F32 area = SurfaceArea( node._aabb );
+        const F32 combinedArea = SurfaceArea( Merge( node._aabb, leafAABB ) );
+
+        // Cost of creating a new parent for this node and the new leaf
+        const F32 cost = 2.f * combinedArea;
+        // Minimum cost of pushing the leaf further down the tree
+        const F32 inheritanceCost = 2.f * (combinedArea - area);
+
+        const auto descendCost = [&]( const U32 childID )
+        {
+            const Node& child = _nodes[childID];
+            const F32 mergedArea = SurfaceArea( Merge( child._aabb, leafAABB ) );
+            return (child.isLeaf() ? mergedArea : mergedArea - SurfaceArea( child._aabb )) + inheritanceCost;
+        };
+
+        const F32 cost1 = descendCost( node._child1 );
+        const F32 cost2 = descendCost( node._child2 );
+
+        if ( cost < cost1 && cost < cost2 )
+        {
+            break;
+        }
+
+        index = cost1 < cost2 ? node._child1 : node._child2;
+    }
+
+    const U32 sibling = index;
+
+    // May reallocate _nodes, so don't hold on to any references across this call
+    const U32 newParent = allocateNode();
+
+    const U32 oldParent = _nodes[sibling]._parent;
+    {
+        Node& parentNode = _nodes[newParent];
+        parentNode._parent = oldParent;
+        parentNode._aabb = Merge( leafAABB, _nodes[sibling]._aabb );
+        parentNode._height = _nodes[sibling]._height + 1;
+        parentNode._child1 = sibling;
+        parentNode._child2 = leaf;
+    }
+
+    if ( oldParent != NULL_NODE )
+    {
+        if ( _nodes[oldParent]._child1 == sibling )
+        {
+            _nodes[oldParent]._child1 = newParent;
+        }
+        else
+        {
+            _nodes[oldParent]._child2 = newParent;
+        }
+    }
+    else
+    {
+        _root = newParent;
+    }
+
+    _nodes[sibling]._parent = newParent;
+    _nodes[leaf]._parent = newParent;
+
+    refit( _nodes[leaf]._parent );
+}
+
+template<typename T>
+void DynamicAABBTree<T>::removeLeaf( const U32 leaf )
+{
+    if ( leaf == _root )
+    {
+        _root = NULL_NODE;
+        return;
+    }
+
+    const U32 parent = _nodes[leaf]._parent;
+    const U32 grandParent = _nodes[parent]._parent;
+    const U32 sibling = _nodes[parent]._child1 == leaf ? _nodes[parent]._child2 : _nodes[parent]._child1;
+
+    freeNode( parent );
+    _nodes[leaf]._parent = NULL_NODE;
+
+    if ( grandParent != NULL_NODE )
+    {
+        // Replace the parent with the sibling
+        if ( _nodes[grandParent]._child1 == parent )
+        {
+            _nodes[grandParent]._child1 = sibling;
+        }
+        else
+        {
+            _nodes[grandParent]._child2 = sibling;
+        }
+        _nodes[sibling]._parent = grandParent;
+
+        refit( grandParent );
+    }
+    else
+    {
+        _root = sibling;
+        _nodes[sibling]._parent = NULL_NODE;
+    }
+}
+
+template<typename T>
+void DynamicAABBTree<T>::refit( U32 index )
+{
+    // Walk back up the tree fixing heights and bounds, rebalancing as we go
+    while ( index != NULL_NODE )
+    {
+        index = balance( index );
+
+        Node& node = _nodes[index];
+        const Node& child1 = _nodes[node._child1];
+        const Node& child2 = _nodes[node._child2];
+
+        node._height = 1 + std::max( child1._height, child2._height );
+        node._aabb = Merge( child1._aabb, child2._aabb );
+
+        index = node._parent;
+    }
+}
+
+template<typename T>
+U32 DynamicAABBTree<T>::balance( const U32 iA )
+{
+    Node& A = _nodes[iA];
+    if ( A.isLeaf() || A._height < 2 )
+    {
+        return iA;
+    }
+
+    const U32 iB = A._child1;
+    const U32 iC = A._child2;
+    Node& B = _nodes[iB];
+    Node& C = _nodes[iC];
+
+    const I32 heightDiff = C._height - B._height;
+
+    const auto replaceChild = [&]( const U32 parent, const U32 oldChild, const U32 newChild )
+    {
+        if ( parent == NULL_NODE )
+        {
+            _root = newChild;
+        }
+        else if ( _nodes[parent]._child1 == oldChild )
+        {
+            _nodes[parent]._child1 = newChild;
+        }
+        else
+        {
+            _nodes[parent]._child2 = newChild;
+        }
+    };
+
+    // Rotate C up
+    if ( heightDiff > 1 )
+    {
+        const U32 iF = C._child1;
+        const U32 iG = C._child2;
+        Node& F = _nodes[iF];
+        Node& G = _nodes[iG];
+
+        C._child1 = iA;
+        C._parent = A._parent;
+        A._parent = iC;
+        replaceChild( C._parent, iA, iC );
+
+        if ( F._height > G._height )
+        {
+            C._child2 = iF;
+            A._child2 = iG;
+            G._parent = iA;
+            A._aabb = Merge( B._aabb, G._aabb );
+            C._aabb = Merge( A._aabb, F._aabb );
+            A._height = 1 + std::max( B._height, G._height );
+            C._height = 1 + std::max( A._height, F._height );
+        }
+        else
+        {
+            C._child2 = iG;
+            A._child2 = iF;
+            F._parent = iA;
+            A._aabb = Merge( B._aabb, F._aabb );
+            C._aabb = Merge( A._aabb, G._aabb );
+            A._height = 1 + std::max( B._height, F._height );
+            C._height = 1 + std::max( A._height, G._height );
+        }
+
+        return iC;
+    }
+
+    // Rotate B up
+    if ( heightDiff < -1 )
+    {
+        const U32 iD = B._child1;
+        const U32 iE = B._child2;
+        Node& D = _nodes[iD];
+        Node& E = _nodes[iE];
+
+        B._child1 = iA;
+        B._parent = A._parent;
+        A._parent = iB;
+        replaceChild( B._parent, iA, iB );
+
+        if ( D._height > E._height )
+        {
+            B._child2 = iD;
+            A._child1 = iE;
+            E._parent = iA;
+            A._aabb = Merge( C._aabb, E._aabb );
+            B._aabb = Merge( A._aabb, D._aabb );
+            A._height = 1 + std::max( C._height, E._height );
+            B._height = 1 + std::max( A._height, D._height );
+        }
+        else
+        {
+            B._child2 = iE;
+            A._child1 = iD;
+            D._parent = iA;
+            A._aabb = Merge( C._aabb, D._aabb );
+            B._aabb = Merge( A._aabb, E._aabb );
+            A._height = 1 + std::max( C._height, D._height );
+            B._height = 1 + std::max( A._height, E._height );
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+template<typename T>
+BoundingBox DynamicAABBTree<T>::Merge( const BoundingBox& lhs, const BoundingBox& rhs ) noexcept
+{
+    BoundingBox ret = lhs;
+    ret.add( rhs );
+    return ret;
+}
+
+template<typename T>
+F32 DynamicAABBTree<T>::SurfaceArea( const BoundingBox& aabb ) noexcept
+{
+    const float3 extent = aabb._max - aabb._min;
+    return 2.f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+template<typename T>
+bool DynamicAABBTree<T>::Contains( const BoundingBox& outer, const BoundingBox& inner ) noexcept
+{
+    return inner._min.x >= outer._min.x && inner._min.y >= outer._min.y && inner._min.z >= outer._min.z &&
+           inner._max.x <= outer._max.x && inner._max.y <= outer._max.y && inner._max.z <= outer._max.z;
+}
+
+} //namespace Divide
+
+#endif //DVD_CORE_MATH_BOUNDINGVOLUMES_DYNAMIC_AABB_TREE_INL_
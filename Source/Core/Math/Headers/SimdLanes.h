@@ -0,0 +1,90 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_CORE_MATH_SIMD_LANES_H_
+#define DVD_CORE_MATH_SIMD_LANES_H_
+
+#include "Core/Math/Headers/MathVectors.h"
+
+namespace Divide
+{
+    /// Thin wrappers over 4 and 8 wide float registers, so that SoA kernels can be written once as templates and instantiated for each width.
+    /// Masks returned by Less() have all bits set in every lane that passed the test and are meant to be used with Select()
+    struct SSELanes
+    {
+        using Reg = SimdVector<F32>;
+        static constexpr size_t Width = 4u;
+
+        [[nodiscard]] static Reg Load(const F32* data) noexcept { return Reg(_mm_loadu_ps(data)); }
+        static void Store(F32* data, const Reg& reg) noexcept { _mm_storeu_ps(data, reg._reg); }
+        [[nodiscard]] static Reg Set(const F32 value) noexcept { return Reg(value); }
+        [[nodiscard]] static Reg Add(const Reg& a, const Reg& b) noexcept { return Reg(_mm_add_ps(a._reg, b._reg)); }
+        [[nodiscard]] static Reg Sub(const Reg& a, const Reg& b) noexcept { return Reg(_mm_sub_ps(a._reg, b._reg)); }
+        [[nodiscard]] static Reg Mul(const Reg& a, const Reg& b) noexcept { return Reg(_mm_mul_ps(a._reg, b._reg)); }
+        [[nodiscard]] static Reg Div(const Reg& a, const Reg& b) noexcept { return Reg(_mm_div_ps(a._reg, b._reg)); }
+        [[nodiscard]] static Reg Min(const Reg& a, const Reg& b) noexcept { return Reg(_mm_min_ps(a._reg, b._reg)); }
+        [[nodiscard]] static Reg Max(const Reg& a, const Reg& b) noexcept { return Reg(_mm_max_ps(a._reg, b._reg)); }
+        [[nodiscard]] static Reg Less(const Reg& a, const Reg& b) noexcept { return Reg(_mm_cmplt_ps(a._reg, b._reg)); }
+        /// Per lane: mask ? ifTrue : ifFalse
+        [[nodiscard]] static Reg Select(const Reg& mask, const Reg& ifTrue, const Reg& ifFalse) noexcept { return Reg(_mm_blendv_ps(ifFalse._reg, ifTrue._reg, mask._reg)); }
+        /// One bit per lane, set if a < b
+        [[nodiscard]] static U32 LessThan(const Reg& a, const Reg& b) noexcept { return to_U32(_mm_movemask_ps(_mm_cmplt_ps(a._reg, b._reg))); }
+    };
+
+#if defined(HAS_AVX)
+    struct AVXLanes
+    {
+        using Reg = __m256;
+        static constexpr size_t Width = 8u;
+
+        [[nodiscard]] static Reg Load(const F32* data) noexcept { return _mm256_loadu_ps(data); }
+        static void Store(F32* data, const Reg reg) noexcept { _mm256_storeu_ps(data, reg); }
+        [[nodiscard]] static Reg Set(const F32 value) noexcept { return _mm256_set1_ps(value); }
+        [[nodiscard]] static Reg Add(const Reg a, const Reg b) noexcept { return _mm256_add_ps(a, b); }
+        [[nodiscard]] static Reg Sub(const Reg a, const Reg b) noexcept { return _mm256_sub_ps(a, b); }
+        [[nodiscard]] static Reg Mul(const Reg a, const Reg b) noexcept { return _mm256_mul_ps(a, b); }
+        [[nodiscard]] static Reg Div(const Reg a, const Reg b) noexcept { return _mm256_div_ps(a, b); }
+        [[nodiscard]] static Reg Min(const Reg a, const Reg b) noexcept { return _mm256_min_ps(a, b); }
+        [[nodiscard]] static Reg Max(const Reg a, const Reg b) noexcept { return _mm256_max_ps(a, b); }
+        [[nodiscard]] static Reg Less(const Reg a, const Reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        [[nodiscard]] static Reg Select(const Reg mask, const Reg ifTrue, const Reg ifFalse) noexcept { return _mm256_blendv_ps(ifFalse, ifTrue, mask); }
+        [[nodiscard]] static U32 LessThan(const Reg a, const Reg b) noexcept { return to_U32(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ))); }
+    };
+
+    using WideLanes = AVXLanes;
+#else //HAS_AVX
+    using WideLanes = SSELanes;
+#endif //HAS_AVX
+
+} //namespace Divide
+
+#endif //DVD_CORE_MATH_SIMD_LANES_H_
@@ -162,10 +162,23 @@ void PlatformContext::onThreadCreated(const TaskPoolType poolType, const size_t
     }
 }
 
-ErrorCode PlatformContext::Network::init(const std::string_view serverIPAddress)
+ErrorCode PlatformContext::Network::init(const std::string_view serverIPAddress, const bool dedicatedServer)
 {
     _client = std::make_unique<Networking::Client>();
 
+    if (dedicatedServer)
+    {
+        _server = std::make_unique<Networking::Server>(Networking::NetworkingPort);
+        if (!_server->start())
+        {
+            _server.reset();
+            _client.reset();
+            return ErrorCode::NETWORK_SERVER_START_ERROR;
+        }
+
+        return ErrorCode::NO_ERR;
+    }
+
     if (Networking::IsLocalHostAddress(serverIPAddress) || !client().connect(serverIPAddress, Networking::NetworkingPort))
     {
         _server = std::make_unique<Networking::Server>(Networking::NetworkingPort);
@@ -202,6 +215,7 @@ void PlatformContext::Network::update()
     if ( _server != nullptr ) 
     {
         _server->update(SIZE_MAX, false);
+        _server->replicate();
     }
 }
 
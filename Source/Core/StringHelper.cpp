@@ -41,6 +41,26 @@ bool ExtractStartupProject( int argc, char** argv, string& projectOut, const cha
     return false;
 }
 
+bool ExtractCommandLineValue(const int argc, char** argv, const char* target_arg, string& valueOut, const char* arg_prefix)
+{
+    string tempArg(arg_prefix);
+    tempArg += target_arg;
+    tempArg += "=";
+    const char* target = tempArg.c_str();
+    const size_t targetLength = tempArg.length();
+
+    for (int i = 0; i < argc; ++i)
+    {
+        if (strncasecmp(argv[i], target, targetLength) == 0 && argv[i][targetLength] != '\0')
+        {
+            valueOut = argv[i] + targetLength;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 bool IsNumber(const char* s) {
     F32 number = 0.0f;
     if (istringstream(s) >> number) {
@@ -12,14 +12,127 @@ namespace Divide
     {
         std::atomic_uint g_taskIDCounter = 0u;
 
+        FORCE_INLINE U32 MakeCallbackHandle(const U16 slot, const U16 generation) noexcept
+        {
+            return (to_U32(generation) << 16u) | slot;
+        }
+
+        FORCE_INLINE U16 CallbackHandleSlot(const U32 handle) noexcept
+        {
+            return to_U16(handle & 0xFFFFu);
+        }
+
+        FORCE_INLINE U16 CallbackHandleGeneration(const U32 handle) noexcept
+        {
+            return to_U16(handle >> 16u);
+        }
+
+        /// Adaptive Parallel_For aims for roughly this many leaf chunks per thread in the worst case
+        constexpr U32 g_adaptiveChunksPerThread = 16u;
+
+        struct AdaptiveForState
+        {
+            TaskPool& _pool;
+            const DELEGATE<void, const Task*, U32/*start*/, U32/*end*/>& _cbk;
+            const TaskPriority _priority;
+            const U32 _grainSize;
+            std::atomic_uint _jobCount{ 0u };
+            /// Split tasks that were started but haven't been picked up yet. Keeps us from splitting more than there are idle workers
+            std::atomic_uint _pendingSplits{ 0u };
+        };
+
+        void SpawnAdaptiveRange( AdaptiveForState& state, U32 start, U32 end );
+
+        void ProcessAdaptiveRange( AdaptiveForState& state, const Task* parentTask, U32 start, U32 end )
+        {
+            while ( start < end )
+            {
+                const U32 count = end - start;
+                if ( count > state._grainSize && state._pool.idleWorkerCount() > state._pendingSplits.load( std::memory_order_relaxed ) )
+                {
+                    // Someone is idle: hand them the upper half and keep going with the lower one
+                    const U32 mid = start + count / 2u;
+                    SpawnAdaptiveRange( state, mid, end );
+                    end = mid;
+                    continue;
+                }
+
+                // Everybody is busy: process a grain's worth and check again
+                const U32 chunkEnd = start + std::min( count, state._grainSize );
+                state._cbk( parentTask, start, chunkEnd );
+                start = chunkEnd;
+            }
+        }
+
+        void SpawnAdaptiveRange( AdaptiveForState& state, const U32 start, const U32 end )
+        {
+            state._jobCount.fetch_add( 1u );
+            state._pendingSplits.fetch_add( 1u );
+
+            Task* parallelJob = TaskPool::AllocateTask
+            (
+                nullptr,
+                [&state, start, end]( Task& parentTask )
+                {
+                    state._pendingSplits.fetch_sub( 1u );
+                    ProcessAdaptiveRange( state, &parentTask, start, end );
+                    state._jobCount.fetch_sub( 1u );
+                }
+            );
+
+            Start( *parallelJob, state._pool, state._priority );
+        }
+
+        void Parallel_For_Adaptive( TaskPool& pool, const ParallelForDescriptor& descriptor, const DELEGATE<void, const Task*, U32/*start*/, U32/*end*/>& cbk )
+        {
+            PROFILE_SCOPE_AUTO( Profiler::Category::Threading );
+
+            const U32 threadCount = to_U32( pool.threads().size() ) + 1u;
+            const U32 grainSize = std::max( descriptor._iterCount / (threadCount * g_adaptiveChunksPerThread), 1u );
+
+            AdaptiveForState state
+            {
+                ._pool = pool,
+                ._cbk = cbk,
+                ._priority = descriptor._priority,
+                ._grainSize = grainSize
+            };
+
+            if ( descriptor._useCurrentThread )
+            {
+                ProcessAdaptiveRange( state, nullptr, 0u, descriptor._iterCount );
+            }
+            else
+            {
+                SpawnAdaptiveRange( state, 0u, descriptor._iterCount );
+            }
+
+            if ( descriptor._allowPoolIdle )
+            {
+                while ( state._jobCount.load() > 0u )
+                {
+                    pool.threadWaiting();
+                }
+            }
+            else
+            {
+                WAIT_FOR_CONDITION( state._jobCount.load() == 0u );
+            }
+        }
+
         NO_DESTROY thread_local Task g_taskAllocator[Config::MAX_POOLED_TASKS];
         thread_local U32 g_allocatedTasks = 0u;
+
+        /// Set for worker threads only so that tasks spawned from within a running task can be pushed to the worker's own deque
+        thread_local TaskPool* g_workerPool = nullptr;
+        thread_local U32 g_workerIndex = U32_MAX;
     }
 
     TaskPool::TaskPool( const std::string_view workerName )
         : _threadNamePrefix( workerName )
     {
         _isRunning.store(false);
+        resetCallbacks();
     }
 
     TaskPool::~TaskPool()
@@ -27,7 +140,7 @@ namespace Divide
         DIVIDE_ASSERT( _activeThreads.load() == 0u, "Task pool is still active! Threads should be joined before destroying the pool. Call TaskPool::shutdown() first");
     }
 
-    bool TaskPool::init( const size_t threadCount, DELEGATE<void, size_t, const std::thread::id&>&& onThreadCreateCbk )
+    bool TaskPool::init( const size_t threadCount, DELEGATE<void, size_t, const std::thread::id&>&& onThreadCreateCbk, const TaskPoolScheduler scheduler )
     {
         shutdown();
         if (threadCount == 0u)
@@ -35,6 +148,13 @@ namespace Divide
             return false;
         }
 
+        _scheduler = scheduler;
+        if (_scheduler == TaskPoolScheduler::WORK_STEALING )
+        {
+            _workerDeques = std::make_unique<WorkerDeque[]>( threadCount );
+            _workerDequeCount = to_U32( threadCount );
+        }
+
         _isRunning.store(true);
         _threads.reserve( threadCount );
 
@@ -50,6 +170,9 @@ namespace Divide
 
                     SetThreadName( threadName );
 
+                    g_workerPool = this;
+                    g_workerIndex = to_U32( idx );
+
                     if (onThreadCreateCbk)
                     {
                         onThreadCreateCbk( idx, std::this_thread::get_id() );
@@ -64,6 +187,9 @@ namespace Divide
                         }
                     }
 
+                    g_workerPool = nullptr;
+                    g_workerIndex = U32_MAX;
+
                     Profiler::OnThreadStop();
                     _activeThreads.fetch_sub( 1u );
                 }
@@ -79,7 +205,61 @@ namespace Divide
     {
         join();
         efficient_clear( _threads );
-        _taskCallbacks.resize(0);
+        _workerDeques.reset();
+        _workerDequeCount = 0u;
+        resetCallbacks();
+    }
+
+    void TaskPool::resetCallbacks()
+    {
+        U16 slot = 0u;
+        while ( _freeCallbackSlots.try_dequeue( slot ) )
+        {
+            NOP();
+        }
+
+        DELEGATE<void> overflowCbk;
+        while ( _overflowCallbacks.try_dequeue( overflowCbk ) )
+        {
+            NOP();
+        }
+
+        std::array<U16, MaxPendingCallbacks> slots;
+        for ( U32 i = 0u; i < MaxPendingCallbacks; ++i )
+        {
+            CallbackSlot& entry = _taskCallbacks[i];
+            entry._cbk = {};
+            ++entry._generation;
+            slots[i] = to_U16( i );
+        }
+
+        DIVIDE_EXPECTED_CALL( _freeCallbackSlots.enqueue_bulk( slots.data(), slots.size() ) );
+    }
+
+    void TaskPool::registerCallback( Task& task, DELEGATE<void>&& onCompletionFunction )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Threading );
+
+        U16 slot = 0u;
+        bool hasSlot = _freeCallbackSlots.try_dequeue( slot );
+        if ( !hasSlot && Runtime::isMainThread() ) [[unlikely]]
+        {
+            // Every slot is waiting to be flushed and we are the only ones that can release them
+            flushCallbackQueue();
+            hasSlot = _freeCallbackSlots.try_dequeue( slot );
+        }
+
+        if ( !hasSlot ) [[unlikely]]
+        {
+            // Waiting here for the main thread to flush could deadlock if the main thread is itself waiting on us
+            task._callbackHandle = Task::INVALID_CALLBACK_HANDLE;
+            task._overflowCallback = MOV( onCompletionFunction );
+            return;
+        }
+
+        CallbackSlot& entry = _taskCallbacks[slot];
+        entry._cbk = MOV( onCompletionFunction );
+        task._callbackHandle = MakeCallbackHandle( slot, entry._generation );
     }
 
     void TaskPool::waitForAllTasks(const bool flushCallbacks)
@@ -91,7 +271,16 @@ namespace Divide
             return;
         }
 
-        if (_runningTaskCount.load() > 0u)
+        if (_scheduler == TaskPoolScheduler::WORK_STEALING)
+        {
+            U32 runningTasks = _runningTaskCount.load();
+            while (runningTasks > 0u)
+            {
+                _runningTaskCount.wait(runningTasks);
+                runningTasks = _runningTaskCount.load();
+            }
+        }
+        else if (_runningTaskCount.load() > 0u)
         {
             UniqueLock<Mutex> lock(_taskFinishedMutex);
             _taskFinishedCV.wait(lock, [this]() noexcept
@@ -113,6 +302,10 @@ namespace Divide
 
         _isRunning.store(false);
 
+        // Wake up any worker sleeping on the work epoch so it can notice the shutdown request
+        _workEpoch.fetch_add(1u);
+        _workEpoch.notify_all();
+
         WAIT_FOR_CONDITION(_activeThreads.load() == 0u, false);
 
         for (std::thread& thread : _threads)
@@ -143,7 +336,8 @@ namespace Divide
                 }
             }
 
-            runTask(task, false);
+            task._callbackHandle = Task::INVALID_CALLBACK_HANDLE;
+            runTask(task);
 
             if (onCompletionFunction)
             {
@@ -153,61 +347,100 @@ namespace Divide
             return;
         }
 
-        bool hasOnCompletionFunction = false;
+        task._priority = priority;
+        task._callbackHandle = Task::INVALID_CALLBACK_HANDLE;
         if ( onCompletionFunction )
         {
-            hasOnCompletionFunction = true;
-            LockGuard<SharedMutex> w_lock( _taskCallbacksLock );
-            bool found = false;
-            for ( CallbackEntry& entry : _taskCallbacks )
-            {
-                if ( entry._taskID == U32_MAX)
-                {
-                    entry._taskID = task._globalId;
-                    entry._cbk = MOV(onCompletionFunction);
-                    found = true;
-                    break;
-                }
-            }
+            registerCallback( task, MOV( onCompletionFunction ) );
+        }
 
-            if ( !found )
-            {
-                _taskCallbacks.emplace_back( MOV(onCompletionFunction), task._globalId );
-            }
+        if ( _scheduler == TaskPoolScheduler::WORK_STEALING )
+        {
+            enqueueWorkStealing( task, priority );
+            return;
         }
+
         // Returning false from a PoolTask lambda will just reschedule it for later execution again. 
         // This may leave the task in an infinite loop, always re-queuing!
-        auto poolTask = [this, &task, priority, hasOnCompletionFunction](const bool isIdleCall)
+        auto poolTask = [this, &task](const bool isIdleCall)
         {
-            while (task._unfinishedJobs.load() > 1u)
-            {
-                if (isIdleCall)
-                {
-                    // Can't be run at this time as we'll just recurse to infinity
-                    return false;
-                }
+            return tryRunTask(task, isIdleCall);
+        };
 
-                // Else, we wait until our child tasks finish running. We also try and do some other work while waiting
-                if ( !threadWaiting() )
-                {
-                    std::this_thread::yield();
-                }
-            }
+        DIVIDE_EXPECTED_CALL( getQueue(priority).enqueue(MOV(poolTask)) );
+    }
+
+    void TaskPool::enqueueWorkStealing( Task& task, const TaskPriority priority )
+    {
+        // Tasks spawned from one of our own workers go to the front of that worker's deque (LIFO) so that
+        // fan-out/fan-in patterns keep their working set hot. Idle workers will steal from the other end.
+        if ( priority != TaskPriority::HIGH && g_workerPool == this && _workerDeques[g_workerIndex].push( &task ) )
+        {
+            notifyWorkEpoch();
+            return;
+        }
+
+        pushSharedTask( task, priority );
+    }
+
+    void TaskPool::pushSharedTask( Task& task, const TaskPriority priority )
+    {
+        if ( priority == TaskPriority::HIGH )
+        {
+            DIVIDE_EXPECTED_CALL( _sharedHighPriorityTasks.enqueue( &task ) );
+        }
+        else
+        {
+            DIVIDE_EXPECTED_CALL( _sharedTasks.enqueue( &task ) );
+        }
+
+        notifyWorkEpoch();
+    }
+
+    void TaskPool::notifyWorkEpoch()
+    {
+        _workEpoch.fetch_add( 1u );
+
+        // A thread in waitForTask may wake up, find its own task done and leave without picking up the new work,
+        // so if any are parked wake everyone to make sure a worker sees it too
+        if ( _waitingThreadCount.load() > 0u )
+        {
+            _workEpoch.notify_all();
+        }
+        else
+        {
+            _workEpoch.notify_one();
+        }
+    }
 
-            if (priority == TaskPriority::DONT_CARE_NO_IDLE && isIdleCall)
+    bool TaskPool::tryRunTask( Task& task, const bool isIdleCall )
+    {
+        while (task._unfinishedJobs.load() > 1u)
+        {
+            if (isIdleCall)
             {
+                // Can't be run at this time as we'll just recurse to infinity
                 return false;
             }
 
-            runTask(task, hasOnCompletionFunction);
+            // Else, we wait until our child tasks finish running. We also try and do some other work while waiting
+            if ( !threadWaiting() )
+            {
+                std::this_thread::yield();
+            }
+        }
 
-            return true;
-        };
+        if (task._priority == TaskPriority::DONT_CARE_NO_IDLE && isIdleCall)
+        {
+            return false;
+        }
 
-        DIVIDE_EXPECTED_CALL( getQueue(priority).enqueue(MOV(poolTask)) );
+        runTask(task);
+
+        return true;
     }
 
-    void TaskPool::runTask( Task& task, const bool hasCompletionCallback)
+    void TaskPool::runTask( Task& task )
     {
         PROFILE_SCOPE_AUTO( Profiler::Category::Threading );
 
@@ -219,17 +452,49 @@ namespace Divide
             task._callback = {}; //< Needed to cleanup any stale resources (e.g. captured by lambdas)
         }
 
-        if (task._parent != nullptr)
+        Task* parent = task._parent;
+        if (parent != nullptr)
         {
-            task._parent->_unfinishedJobs.fetch_sub(1);
+            parent->_unfinishedJobs.fetch_sub(1);
         }
 
-        if (hasCompletionCallback)
+        if (task._callbackHandle != Task::INVALID_CALLBACK_HANDLE)
         {
-            _threadedCallbackBuffer.enqueue(task._globalId);
+            _threadedCallbackBuffer.enqueue(task._callbackHandle);
+        }
+        else if (task._overflowCallback) [[unlikely]]
+        {
+            _overflowCallbacks.enqueue(MOV(task._overflowCallback));
+            task._overflowCallback = {};
         }
 
         task._unfinishedJobs.fetch_sub(1);
+
+        // Some waiters (e.g. TaskGraph::run) block on the parent's counter directly, regardless of scheduler
+        if ( parent != nullptr )
+        {
+            parent->_unfinishedJobs.notify_all();
+        }
+
+        if ( _scheduler == TaskPoolScheduler::WORK_STEALING )
+        {
+            // No lock needed: waiters block on the atomics directly
+            task._unfinishedJobs.notify_all();
+
+            // Threads in waitForTask sleep on the work epoch, not on the task they wait for
+            if ( _waitingThreadCount.load() > 0u )
+            {
+                _workEpoch.fetch_add( 1u );
+                _workEpoch.notify_all();
+            }
+
+            if ( _runningTaskCount.fetch_sub( 1 ) == 1u )
+            {
+                _runningTaskCount.notify_all();
+            }
+            return;
+        }
+
         _runningTaskCount.fetch_sub(1);
 
         LockGuard<Mutex> lock(_taskFinishedMutex);
@@ -240,6 +505,30 @@ namespace Divide
     {
         PROFILE_SCOPE_AUTO( Profiler::Category::Threading );
 
+        if ( _scheduler == TaskPoolScheduler::WORK_STEALING )
+        {
+            while ( !Finished( task ) )
+            {
+                // Read the epoch before looking for work: new work and finished tasks both bump it, so we can't miss either
+                const U32 epoch = _workEpoch.load( std::memory_order_acquire );
+                if ( threadWaiting() )
+                {
+                    continue;
+                }
+
+                // Nothing left to help with, so sleep until something is pushed or finishes. Waiting on the task itself
+                // would leave us asleep while work queued later (e.g. the task's own children) piles up behind us
+                _waitingThreadCount.fetch_add( 1u );
+                if ( !Finished( task ) )
+                {
+                    _workEpoch.wait( epoch, std::memory_order_acquire );
+                }
+                _waitingThreadCount.fetch_sub( 1u );
+            }
+
+            return;
+        }
+
         using namespace std::chrono_literals;
         while ( !Finished( task ) )
         {
@@ -259,39 +548,59 @@ namespace Divide
 
         DIVIDE_ASSERT( Runtime::isMainThread() );
 
-        constexpr I32 maxDequeueItems = 1 << 3;
-        U32 completedTaskIndices[maxDequeueItems];
+        constexpr I32 maxDequeueItems = 1 << 6;
+        U32 completedHandles[maxDequeueItems];
+        U16 releasedSlots[maxDequeueItems];
 
         size_t ret = 0u;
         while ( true )
         {
-            const size_t count = _threadedCallbackBuffer.try_dequeue_bulk( completedTaskIndices, maxDequeueItems );
+            const size_t count = _threadedCallbackBuffer.try_dequeue_bulk( completedHandles, maxDequeueItems );
             if ( count == 0u )
             {
                 break;
             }
 
-            LockGuard<SharedMutex> w_lock( _taskCallbacksLock );
+            size_t releasedCount = 0u;
             for ( size_t i = 0u; i < count; ++i )
             {
-                const U32 idx = completedTaskIndices[i];
-                for (CallbackEntry& entry : _taskCallbacks)
+                const U32 handle = completedHandles[i];
+                const U16 slot = CallbackHandleSlot( handle );
+                CallbackSlot& entry = _taskCallbacks[slot];
+
+                if ( entry._generation != CallbackHandleGeneration( handle ) ) [[unlikely]]
                 {
-                    if ( entry._taskID == idx)
-                    {
-                        if ( entry._cbk )
-                        {
-                            entry._cbk();
-                        }
-                        entry = {};
-                        break;
-                    }
+                    // Stale handle (e.g. the table was reset in the meantime)
+                    continue;
+                }
+
+                // Move the callback out first so that it can safely start new tasks (and register new callbacks) when invoked
+                DELEGATE<void> cbk = MOV( entry._cbk );
+                entry._cbk = {};
+                ++entry._generation;
+                releasedSlots[releasedCount++] = slot;
+
+                if ( cbk )
+                {
+                    cbk();
                 }
             }
 
+            if ( releasedCount > 0u )
+            {
+                DIVIDE_EXPECTED_CALL( _freeCallbackSlots.enqueue_bulk( releasedSlots, releasedCount ) );
+            }
+
             ret += count;
         }
 
+        DELEGATE<void> overflowCbk;
+        while ( _overflowCallbacks.try_dequeue( overflowCbk ) )
+        {
+            overflowCbk();
+            ++ret;
+        }
+
         return ret;
     }
 
@@ -338,6 +647,11 @@ namespace Divide
     {
         PROFILE_SCOPE_AUTO(Profiler::Category::Threading);
 
+        if ( _scheduler == TaskPoolScheduler::WORK_STEALING )
+        {
+            return executeOneTaskWorkStealing( isIdleCall );
+        }
+
         PoolTask task = {};
         TaskPriority priorityOut = TaskPriority::DONT_CARE;
 
@@ -388,7 +702,10 @@ namespace Divide
 
         if constexpr (IsBlocking)
         {
-            return getQueue(priorityIn).wait_dequeue_timed(taskOut, Time::MillisecondsToMicroseconds(2));
+            _idleWorkerCount.fetch_add(1u, std::memory_order_relaxed);
+            const bool ret = getQueue(priorityIn).wait_dequeue_timed(taskOut, Time::MillisecondsToMicroseconds(2));
+            _idleWorkerCount.fetch_sub(1u, std::memory_order_relaxed);
+            return ret;
         }
         else
         {
@@ -396,6 +713,77 @@ namespace Divide
         }
     }
 
+    bool TaskPool::executeOneTaskWorkStealing( const bool isIdleCall )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Threading );
+
+        // Read the epoch before looking for work so that anything pushed after this point wakes us up
+        const U32 epoch = _workEpoch.load( std::memory_order_acquire );
+        if ( !_isRunning.load() )
+        {
+            return false;
+        }
+
+        Task* task = nullptr;
+        if ( !dequeWorkStealing( isIdleCall, task ) )
+        {
+            if ( !isIdleCall )
+            {
+                _idleWorkerCount.fetch_add( 1u, std::memory_order_relaxed );
+                _workEpoch.wait( epoch, std::memory_order_acquire );
+                _idleWorkerCount.fetch_sub( 1u, std::memory_order_relaxed );
+            }
+            return false;
+        }
+
+        if ( !tryRunTask( *task, isIdleCall ) )
+        {
+            pushSharedTask( *task, task->_priority );
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TaskPool::dequeWorkStealing( const bool isIdleCall, Task*& taskOut )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Threading );
+
+        if ( _sharedHighPriorityTasks.try_dequeue( taskOut ) )
+        {
+            return true;
+        }
+
+        const bool isOwnWorker = g_workerPool == this;
+        if ( isOwnWorker && _workerDeques[g_workerIndex].pop( taskOut ) )
+        {
+            return true;
+        }
+
+        if ( _sharedTasks.try_dequeue( taskOut ) )
+        {
+            return true;
+        }
+
+        // Steal the oldest task from another worker. Start with our neighbour to spread thieves across victims
+        const U32 firstVictim = isOwnWorker ? g_workerIndex + 1u : 0u;
+        for ( U32 i = 0u; i < _workerDequeCount; ++i )
+        {
+            const U32 victim = (firstVictim + i) % _workerDequeCount;
+            if ( isOwnWorker && victim == g_workerIndex )
+            {
+                continue;
+            }
+
+            if ( _workerDeques[victim].steal( taskOut ) )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     void Parallel_For( TaskPool& pool, const ParallelForDescriptor& descriptor, const DELEGATE<void, const Task*, U32/*start*/, U32/*end*/>& cbk )
     {
         PROFILE_SCOPE_AUTO( Profiler::Category::Threading );
@@ -405,6 +793,22 @@ namespace Divide
             return;
         }
 
+        if ( descriptor._partitionSize == 0u )
+        {
+            if ( descriptor._waitForFinish )
+            {
+                Parallel_For_Adaptive( pool, descriptor, cbk );
+                return;
+            }
+
+            // The adaptive state lives on our stack, so it can't outlive this call. Split the loop up front instead, one partition per thread
+            const U32 threadCount = to_U32( pool.threads().size() ) + 1u;
+            ParallelForDescriptor fixedDescriptor = descriptor;
+            fixedDescriptor._partitionSize = (descriptor._iterCount + threadCount - 1u) / threadCount;
+            Parallel_For( pool, fixedDescriptor, cbk );
+            return;
+        }
+
         // Shortcut for small loops
         if (descriptor._useCurrentThread && descriptor._iterCount < descriptor._partitionSize)
         {
@@ -418,36 +822,42 @@ namespace Divide
         const U32 adjustedCount = descriptor._useCurrentThread ? partitionCount - 1u : partitionCount;
 
         std::atomic_uint jobCount = adjustedCount + (remainder > 0u ? 1u : 0u);
-        for ( U32 i = 0u; i < adjustedCount; ++i )
+
+        // If we don't wait, the jobs may run after we returned, so they can't reference anything on our stack (the caller's callback included)
+        const auto detachedCbk = descriptor._waitForFinish ? nullptr : std::make_shared<DELEGATE<void, const Task*, U32, U32>>( cbk );
+
+        const auto spawnJob = [&]( const U32 start, const U32 end )
         {
-            const U32 start = i * crtPartitionSize;
-            const U32 end = start + crtPartitionSize;
-            Task* parallelJob = TaskPool::AllocateTask
-            (
-                nullptr,
-                [&cbk, &jobCount, start, end]( Task& parentTask )
-                {
-                    cbk( &parentTask, start, end );
-                    jobCount.fetch_sub( 1 );
-                }
-            );
+            Task* parallelJob = detachedCbk != nullptr
+                              ? TaskPool::AllocateTask
+                                (
+                                    nullptr,
+                                    [detachedCbk, start, end]( Task& parentTask )
+                                    {
+                                        (*detachedCbk)( &parentTask, start, end );
+                                    }
+                                )
+                              : TaskPool::AllocateTask
+                                (
+                                    nullptr,
+                                    [&cbk, &jobCount, start, end]( Task& parentTask )
+                                    {
+                                        cbk( &parentTask, start, end );
+                                        jobCount.fetch_sub( 1 );
+                                    }
+                                );
 
             Start( *parallelJob, pool, descriptor._priority );
+        };
+
+        for ( U32 i = 0u; i < adjustedCount; ++i )
+        {
+            const U32 start = i * crtPartitionSize;
+            spawnJob( start, start + crtPartitionSize );
         }
         if ( remainder > 0u )
         {
-            const U32 count = descriptor._iterCount;
-            Task* parallelJob = TaskPool::AllocateTask
-            (
-                nullptr,
-                [&cbk, &jobCount, count, remainder]( Task& parentTask )
-                {
-                    cbk( &parentTask, count - remainder, count );
-                    jobCount.fetch_sub( 1 );
-                }
-            );
-
-            Start( *parallelJob, pool, descriptor._priority );
+            spawnJob( descriptor._iterCount - remainder, descriptor._iterCount );
         }
 
         if ( descriptor._useCurrentThread )
@@ -0,0 +1,131 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+
+#pragma once
+#ifndef DVD_WORK_STEALING_DEQUE_H_
+#define DVD_WORK_STEALING_DEQUE_H_
+
+//ref: Le, Pop, Cohen, Zappa Nardelli - "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013)
+namespace Divide {
+
+/// Fixed capacity Chase-Lev deque. The owning thread pushes and pops from the bottom (LIFO) while any other thread may steal from the top (FIFO).
+/// T must be trivially copyable (usually a pointer) as slots are read speculatively by thieves.
+template <typename T, size_t N>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque only supports trivially copyable types!");
+    static_assert(N > 1u && (N & (N - 1u)) == 0u, "WorkStealingDeque capacity must be a power of two!");
+
+    static constexpr I64 Mask = static_cast<I64>(N - 1u);
+
+public:
+    /// Owner thread only. Returns false if the deque is full.
+    bool push(const T item) noexcept
+    {
+        const I64 bottom = _bottom.load(std::memory_order_relaxed);
+        const I64 top = _top.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<I64>(N))
+        {
+            return false;
+        }
+
+        _buffer[bottom & Mask].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Owner thread only. Returns the most recently pushed item, if any.
+    bool pop(T& itemOut) noexcept
+    {
+        const I64 bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        I64 top = _top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            // Empty
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        itemOut = _buffer[bottom & Mask].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // Last item. Race against thieves for it
+            const bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+
+    /// Any thread. Returns the oldest item, if any. May spuriously fail if it loses a race with another thief or the owner.
+    bool steal(T& itemOut) noexcept
+    {
+        I64 top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const I64 bottom = _bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return false;
+        }
+
+        itemOut = _buffer[top & Mask].load(std::memory_order_relaxed);
+        return _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t sizeApprox() const noexcept
+    {
+        const I64 bottom = _bottom.load(std::memory_order_relaxed);
+        const I64 top = _top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0u;
+    }
+
+    [[nodiscard]] inline static size_t capacity() noexcept
+    {
+        return N;
+    }
+
+private:
+    // Keep the thief and owner ends on separate cache lines
+    alignas(64) std::atomic<I64> _top{ 0 };
+    alignas(64) std::atomic<I64> _bottom{ 0 };
+    alignas(64) std::array<std::atomic<T>, N> _buffer{};
+};
+
+}; //namespace Divide
+
+#endif //DVD_WORK_STEALING_DEQUE_H_
@@ -5,6 +5,7 @@
 #include "Core/Headers/Application.h"
 #include "Core/Headers/Configuration.h"
 #include "Core/Headers/DisplayManager.h"
+#include "Core/Headers/Kernel.h"
 #include "Core/Headers/PlatformContext.h"
 #include "Platform/Video/Headers/GFXDevice.h"
 #include "Platform/Video/Headers/CommandBufferPool.h"
@@ -95,6 +96,12 @@ ErrorCode WindowManager::init(PlatformContext& context,
         return ErrorCode::WINDOW_INIT_ERROR;
     }
 
+    if (context.kernel().dedicatedServer())
+    {
+        // No display server needed (e.g. plain containers). The offscreen driver still gives us the (hidden) main window everything else expects
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    }
+
     if (!SDL_InitSubSystem(SDL_INIT_VIDEO))
     {
         return ErrorCode::WINDOW_INIT_ERROR;
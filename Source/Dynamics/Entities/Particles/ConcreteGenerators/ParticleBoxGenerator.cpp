@@ -13,23 +13,20 @@ void ParticleBoxGenerator::generate(Task& packagedTasksParent,
     float3 min(_posMin + _sourcePosition);
     float3 max(_posMax + _sourcePosition);
     
-    using iter_t = decltype(std::begin(p._position));
-    for_each_interval<iter_t>(std::begin(p._position) + startIndex,
-                              std::begin(p._position) + endIndex,
-                              ParticleData::g_threadPartitionSize,
-                              [&](iter_t from, iter_t to)
+    for (U32 from = startIndex; from < endIndex; from += ParticleData::g_threadPartitionSize)
     {
+        const U32 to = std::min(from + ParticleData::g_threadPartitionSize, endIndex);
         Start(*CreateTask(
             &packagedTasksParent,
-            [from, to, min, max](const Task&) mutable
+            [&p, from, to, min, max](const Task&) mutable
             {
-                std::for_each(from, to, [min, max](float4& position)
+                for (U32 i = from; i < to; ++i)
                 {
-                    position.xyz = Random(min, max);
-                });
+                    p._position.setXYZ(i, Random(min, max));
+                }
             }),
             parentPool);
-    });
+    }
 }
 
 } //namespace Divide
@@ -13,38 +13,28 @@ void ParticleColourGenerator::generate(Task& packagedTasksParent,
                                        const U32 startIndex,
                                        const U32 endIndex) {
 
-    using iter_t_start = decltype(std::begin(p._startColour));
-    for_each_interval<iter_t_start>(std::begin(p._startColour) + startIndex,
-                                    std::begin(p._startColour) + endIndex,
-                                    ParticleData::g_threadPartitionSize,
-                                    [&](iter_t_start from, iter_t_start to)
+    for (U32 from = startIndex; from < endIndex; from += ParticleData::g_threadPartitionSize)
     {
+        const U32 to = std::min(from + ParticleData::g_threadPartitionSize, endIndex);
         Start(*CreateTask(
                    &packagedTasksParent,
-                   [this, from, to](const Task&) {
-                       std::for_each(from, to, [&](FColour4& colour)
+                   [this, &p, from, to](const Task&) {
+                       for (U32 i = from; i < to; ++i)
                        {
-                           colour.set(Random(_minStartCol, _maxStartCol));
-                       });
+                           p._startColour.set(i, Random(_minStartCol, _maxStartCol));
+                       }
                    }),
             parentPool);
-    });
 
-    using iter_t_end = decltype(std::begin(p._endColour));
-    for_each_interval<iter_t_end>(std::begin(p._endColour) + startIndex,
-                                  std::begin(p._endColour) + endIndex,
-                                  ParticleData::g_threadPartitionSize,
-                                  [&](iter_t_end from, iter_t_end to)
-    {
         Start(*CreateTask(
                    &packagedTasksParent,
-                   [this, from, to](const Task&) {
-                       std::for_each(from, to, [&](FColour4& colour)
+                   [this, &p, from, to](const Task&) {
+                       for (U32 i = from; i < to; ++i)
                        {
-                           colour.set(Random(_minEndCol, _maxEndCol));
-                       });
+                           p._endColour.set(i, Random(_minEndCol, _maxEndCol));
+                       }
                    }),
             parentPool);
-    });
+    }
 }
 }
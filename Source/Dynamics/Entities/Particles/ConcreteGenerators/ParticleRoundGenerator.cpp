@@ -16,9 +16,9 @@ void ParticleRoundGenerator::generate([[maybe_unused]] Task& packagedTasksParent
     for (U32 i = startIndex; i < endIndex; i++)
     {
         const F32 ang = Random(0.0f, M_PI_MUL_2_f);
-        p._position[i].xyz = center + float3(_radX * std::sin(ang),
-                                                _radY * std::cos(ang), 
-                                                0.0f);
+        p._position.setXYZ(i, center + float3(_radX * std::sin(ang),
+                                              _radY * std::cos(ang),
+                                              0.0f));
     }
 }
 
@@ -12,10 +12,9 @@ void ParticleTimeGenerator::generate([[maybe_unused]] Task& packagedTasksParent,
                                      const U32 endIndex) {
     for (U32 i = startIndex; i < endIndex; ++i) {
         const F32 time = Random(_minTime, _maxTime);
-        float4& misc = p._misc[i];
-        misc.x = time;
-        misc.y = 0.0f;
-        misc.z = time > EPSILON_F32 ? 1.f / misc.x : 0.f;
+        p._misc._x[i] = time;
+        p._misc._y[i] = 0.0f;
+        p._misc._z[i] = time > EPSILON_F32 ? 1.f / time : 0.f;
     }
 }
 
@@ -11,7 +11,7 @@ void ParticleVelocityFromPositionGenerator::generate([[maybe_unused]] Task& pack
                                                      const U32 startIndex,
                                                      const U32 endIndex) {
     for (U32 i = startIndex; i < endIndex; ++i) {
-        p._velocity[i].xyz = Random(_minScale, _maxScale) * (p._position[i].xyz - _offset);
+        p._velocity.setXYZ(i, Random(_minScale, _maxScale) * (p._position.xyz(i) - _offset));
     }
 }
 
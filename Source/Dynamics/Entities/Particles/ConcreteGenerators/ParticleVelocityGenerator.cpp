@@ -14,23 +14,20 @@ void ParticleVelocityGenerator::generate(Task& packagedTasksParent,
     float3 max = _sourceOrientation * _maxStartVel;
     
     //ToDo: Use parallel-for for this
-    using iter_t = decltype(std::begin(p._velocity));
-    for_each_interval<iter_t>(std::begin(p._velocity) + startIndex,
-                              std::begin(p._velocity) + endIndex,
-                              ParticleData::g_threadPartitionSize,
-                              [&](iter_t from, iter_t to)
+    for (U32 from = startIndex; from < endIndex; from += ParticleData::g_threadPartitionSize)
     {
+        const U32 to = std::min(from + ParticleData::g_threadPartitionSize, endIndex);
         Start(*CreateTask(
             &packagedTasksParent,
-            [from, to, min, max](const Task&) mutable
+            [&p, from, to, min, max](const Task&) mutable
             {
-                std::for_each(from, to, [&](float4& velocity)
+                for (U32 i = from; i < to; ++i)
                 {
-                    velocity.set(Random(min, max));
-                });
+                    p._velocity.setXYZ(i, Random(min, max));
+                }
             }),
             parentPool);
-        });
+    }
 }
 
 } //namespace Divide
@@ -1,27 +1,29 @@
 
 
 #include "Headers/ParticleAttractorUpdater.h"
+#include "Dynamics/Entities/Particles/Headers/ParticleKernels.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Core/Headers/PlatformContext.h"
 
 namespace Divide {
 
+namespace {
+    constexpr U32 g_partitionSize = 256;
+}
+
 void ParticleAttractorUpdater::update( [[maybe_unused]] const U64 deltaTimeUS, ParticleData& p) {
-    const U32 endID = p.aliveCount();
-    const size_t countAttractors = _attractors.size();
-
-    float4 offset;
-    F32 dist = 0.0f;
-    size_t a = 0;
-    for (U32 i = 0; i < endID; ++i) {
-        for (a = 0; a < countAttractors; ++a) {
-            offset.set(_attractors[a].xyz - p._position[i].xyz, 0.0f);
-            dist = offset.dot(offset);
-
-            // if (!IS_ZERO(DIST)) {
-            dist = _attractors[a].w / dist;
-            p._acceleration[i] += offset * dist;
-            //}
-        }
+    if (_attractors.empty()) {
+        return;
     }
+
+    ParallelForDescriptor descriptor = {};
+    descriptor._iterCount = p.aliveCount();
+    descriptor._partitionSize = g_partitionSize;
+    Parallel_For( context().taskPool( TaskPoolType::HIGH_PRIORITY ), descriptor, [&p, this](const Task*, const U32 start, const U32 end)
+    {
+        ParticleKernels::Attract(p._position, p._acceleration, _attractors, start, end);
+    });
 }
 
 } //namespace Divide
@@ -1,6 +1,7 @@
 
 
 #include "Headers/ParticleBasicColourUpdater.h"
+#include "Dynamics/Entities/Particles/Headers/ParticleKernels.h"
 
 #include "Core/Headers/TaskPool.h"
 #include "Core/Headers/PlatformContext.h"
@@ -18,10 +19,7 @@ void ParticleBasicColourUpdater::update( [[maybe_unused]] const U64 deltaTimeUS,
     descriptor._partitionSize = g_partitionSize;
     Parallel_For( context().taskPool( TaskPoolType::HIGH_PRIORITY ), descriptor, [&p](const Task*, const U32 start, const U32 end)
     {
-        for (U32 i = start; i < end; ++i)
-        {
-            p._colour[i].set(Lerp(p._startColour[i], p._endColour[i], p._misc[i].y));
-        }
+        ParticleKernels::LerpColour(p._startColour, p._endColour, p._misc._y, p._colour, start, end);
     });
 }
 
@@ -1,31 +1,35 @@
 
 
 #include "Headers/ParticleBasicTimeUpdater.h"
+#include "Dynamics/Entities/Particles/Headers/ParticleKernels.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Core/Headers/PlatformContext.h"
 
 namespace Divide {
 
+namespace {
+    constexpr U32 g_partitionSize = 256;
+}
+
 void ParticleBasicTimeUpdater::update(const U64 deltaTimeUS, ParticleData& p) {
-    U32 endID = p.aliveCount();
+    const U32 endID = p.aliveCount();
     const F32 localDT = Time::MicrosecondsToSeconds<F32>(deltaTimeUS);
 
     if (endID == 0) {
         return;
     }
 
-    for (U32 i = 0; i < endID; ++i) {
-        float4& misc = p._misc[i];
+    ParallelForDescriptor descriptor = {};
+    descriptor._iterCount = endID;
+    descriptor._partitionSize = g_partitionSize;
+    Parallel_For( context().taskPool( TaskPoolType::HIGH_PRIORITY ), descriptor, [&p, localDT](const Task*, const U32 start, const U32 end)
+    {
+        ParticleKernels::Age(p._misc, localDT, start, end);
+    });
 
-        misc.x -= localDT;
-        // interpolation: from 0 (start of life) till 1 (end of life)
-        misc.y =
-            1.0f - misc.x * misc.z;  // .z is 1.0/max life time
-
-        if (misc.x <= 0.0f) {
-            p.kill(i);
-            endID = p.aliveCount() < p.totalCount() ? p.aliveCount()
-                                                    : p.totalCount();
-        }
-    }
+    // Dead particles are squeezed out of every stream in one go instead of being swapped with the last alive particle one at a time
+    p.compact();
 }
 
 } //namespace Divide
@@ -12,17 +12,17 @@ void ParticlePositionColourUpdater::update( [[maybe_unused]] const U64 deltaTime
 
     
     for (U32 i = 0; i < endID; ++i) {
-        p._colour[i].set(
-            (p._position[i].x - _minPos.x) /
+        p._colour.set(i, {
+            (p._position._x[i] - _minPos.x) /
                 diffr,  // lerp(p._startColour[i].r, p._endColour[i].r, scaler),
-            (p._position[i].y - _minPos.y) /
+            (p._position._y[i] - _minPos.y) /
                 diffg,  // lerp(p._startColour[i].g, p._endColour[i].g, scaleg),
-            (p._position[i].z - _minPos.z) /
+            (p._position._z[i] - _minPos.z) /
                 diffb,  // lerp(p._startColour[i].b, p._endColour[i].b,
                          // scaleb),
-             Lerp(to_F32(p._startColour[i].a) / 255.0f,
-                  to_F32(p._endColour[i].a) / 255.0f,
-                  p._misc[i].y) * 255.0f);
+             Lerp(to_F32(p._startColour._w[i]) / 255.0f,
+                  to_F32(p._endColour._w[i]) / 255.0f,
+                  p._misc._y[i]) * 255.0f });
     }
 }
 
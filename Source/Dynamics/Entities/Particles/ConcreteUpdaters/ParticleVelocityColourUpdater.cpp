@@ -11,15 +11,15 @@ void ParticleVelocityColourUpdater::update( [[maybe_unused]] const U64 deltaTime
     const F32 diffb = _maxVel.z - _minVel.z;
 
     for (U32 i = 0; i < endID; ++i) {
-        p._colour[i].set(
-            (p._velocity[i].x - _minVel.x) /
+        p._colour.set(i, {
+            (p._velocity._x[i] - _minVel.x) /
                 diffr,  // lerp(p._startColour[i].r, p._endColour[i].r, scaler),
-            (p._velocity[i].y - _minVel.y) /
+            (p._velocity._y[i] - _minVel.y) /
                 diffg,  // lerp(p._startColour[i].g, p._endColour[i].g, scaleg),
-            (p._velocity[i].z - _minVel.z) /
+            (p._velocity._z[i] - _minVel.z) /
                 diffb,  // lerp(p._startColour[i].b, p._endColour[i].b,
                          // scaleb),
-            Lerp(p._startColour[i].a, p._endColour[i].a, p._misc[i].y) * 255.0f);
+            Lerp(p._startColour._w[i], p._endColour._w[i], p._misc._y[i]) * 255.0f });
     }
 }
 
@@ -34,6 +34,7 @@
 #define DVD_PARTICLE_DATA_H_
 
 #include "Graphs/Headers/SceneNode.h"
+#include "ParticleDepthSorter.h"
 
 namespace Divide {
 
@@ -55,29 +56,85 @@ namespace Names {
     };
 }
 
+/// One F32 per particle. Storage starts on a 32 byte boundary so that 8 wide loads of particles [8 * k, 8 * k + 8) never split a cache line
+class ParticleStream {
+   public:
+    static constexpr size_t Alignment = 32u;
+
+    void resize(U32 count, F32 value);
+    void clear() noexcept;
+
+    [[nodiscard]] F32* data() noexcept { return reinterpret_cast<F32*>(_blocks.data()); }
+    [[nodiscard]] const F32* data() const noexcept { return reinterpret_cast<const F32*>(_blocks.data()); }
+    [[nodiscard]] U32 size() const noexcept { return _size; }
+
+    [[nodiscard]] F32& operator[](const U32 index) noexcept { return data()[index]; }
+    [[nodiscard]] F32 operator[](const U32 index) const noexcept { return data()[index]; }
+
+   private:
+    struct alignas(Alignment) Block {
+        F32 _values[Alignment / sizeof(F32)];
+    };
+
+    /// EASTL's default aligned allocation ignores the alignment unless ENABLE_MIMALLOC is set, so go through the aligned global new/delete ourselves
+    struct BlockAllocator {
+        explicit BlockAllocator([[maybe_unused]] const char* name = nullptr) noexcept {}
+
+        [[nodiscard]] void* allocate(const size_t n, [[maybe_unused]] const int flags = 0) { return ::operator new(n, std::align_val_t{ Alignment }); }
+        [[nodiscard]] void* allocate(const size_t n, [[maybe_unused]] const size_t alignment, [[maybe_unused]] const size_t offset, [[maybe_unused]] const int flags = 0) { return allocate(n); }
+        void deallocate(void* p, [[maybe_unused]] const size_t n) noexcept { ::operator delete(p, std::align_val_t{ Alignment }); }
+
+        [[nodiscard]] const char* get_name() const noexcept { return "ParticleStream"; }
+        void set_name([[maybe_unused]] const char* name) noexcept {}
+
+        [[nodiscard]] friend bool operator==(const BlockAllocator&, const BlockAllocator&) noexcept { return true; }
+        [[nodiscard]] friend bool operator!=(const BlockAllocator&, const BlockAllocator&) noexcept { return false; }
+    };
+
+    eastl::vector<Block, BlockAllocator> _blocks;
+    U32 _size = 0u;
+};
+
+/// A four component particle property split into one stream per component
+struct ParticleAttribute {
+    ParticleStream _x, _y, _z, _w;
+
+    void resize(U32 count, F32 value);
+    void clear() noexcept;
+    /// Copies every component of particle "src" over particle "dst"
+    void copy(U32 dst, U32 src) noexcept;
+
+    [[nodiscard]] float4 get(const U32 index) const noexcept { return { _x[index], _y[index], _z[index], _w[index] }; }
+    [[nodiscard]] float3 xyz(const U32 index) const noexcept { return { _x[index], _y[index], _z[index] }; }
+
+    void set(U32 index, const float4& value) noexcept;
+    void setXYZ(U32 index, const float3& value) noexcept;
+
+    [[nodiscard]] bool empty() const noexcept { return _x.size() == 0u; }
+};
+
 /// Container to store data for a given set of particles
 class ParticleData {
    public:
     static constexpr U32 g_threadPartitionSize = 256;
 
-    /// helper array used for sorting
-    vector<std::pair<U32, F32>> _indices;
+    /// Alive particles, back to front. Filled by sort()
     vector<float4> _renderingPositions;
     vector<UColour4>  _renderingColours;
     /// x,y,z = position; w = size
-    vector<float4> _position;
+    ParticleAttribute _position;
     /// x,y,z = _velocity; w = angle;
-    vector<float4> _velocity;
+    ParticleAttribute _velocity;
     /// x,y,z = _acceleration; w = weight;
-    vector<float4> _acceleration;
+    ParticleAttribute _acceleration;
     /// x = time; y = interpolation; z = 1 / time;  w = distance to camera sq;
-    vector<float4> _misc;
+    ParticleAttribute _misc;
     /// r,g,b,a = colour and transparency
-    vector<FColour4> _colour;
+    ParticleAttribute _colour;
     /// r,g,b,a = colour and transparency
-    vector<FColour4> _startColour;
+    ParticleAttribute _startColour;
     /// r,g,b,a = colour and transparency
-    vector<FColour4> _endColour;
+    ParticleAttribute _endColour;
     /// Location of the texture file. Leave blank for colour only
     string _textureFileName;
 
@@ -105,6 +162,8 @@ class ParticleData {
     }
 
     PROPERTY_RW(U32, optionsMask, 0u);
+    /// If the eye moved less than this since the last sort, the previous particle order is fixed up instead of sorting from scratch. 0 = always do a full sort
+    PROPERTY_RW(F32, sortReuseMaxEyeMovement, 0.5f);
    public:
     explicit ParticleData(GFXDevice& context, U32 particleCount, U32 optionsMask);
     ~ParticleData();
@@ -113,12 +172,15 @@ class ParticleData {
     void kill(U32 index);
     void wake(U32 index);
     void swapData(U32 indexA, U32 indexB);
+    /// Removes every alive particle that ran out of time (_misc.x <= 0) in a single branchless pass over all of the streams.
+    /// Surviving particles keep their relative order
+    void compact();
 
     [[nodiscard]] U32 aliveCount() const noexcept { return _aliveCount; }
     [[nodiscard]] U32 totalCount() const noexcept { return _totalCount; }
     
-    /// Sort ALIVE particles only
-    void sort();
+    /// Sort ALIVE particles only, back to front as seen from eyePos (_misc.w must already hold the distances)
+    void sort(const float3& eyePos);
 
    protected:
     U32 _totalCount = 0u;
@@ -129,6 +191,9 @@ class ParticleData {
     vector<U32> _particleGeometryIndices;
     PrimitiveTopology _particleGeometryType = PrimitiveTopology::COUNT;
 
+    ParticleDepthSorter _depthSorter;
+    float3 _lastSortEyePos;
+
     GFXDevice& _context;
 };
 
@@ -0,0 +1,97 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_PARTICLE_DEPTH_SORTER_H_
+#define DVD_PARTICLE_DEPTH_SORTER_H_
+
+namespace Divide {
+
+class TaskPool;
+class ParticleStream;
+struct ParticleAttribute;
+
+/// Orders particles back to front (largest distance first) and gathers their render data in the same pass.
+/// A full sort quantizes the distances to 16 bit keys and runs two stable 8 bit LSD radix passes. Each pass splits the particles
+/// into blocks that are histogrammed and scattered in parallel, and the final scatter writes the render data directly.
+/// If requested, the order of the previous sort is reused instead: it is kept valid across ParticleData::compact() calls,
+/// an insertion sort fixes up whatever moved since and newly spawned particles are merged in. If the fix-up needs too many moves
+/// (the camera or the particles moved too much), we fall back to a full sort.
+class ParticleDepthSorter {
+   public:
+    static constexpr U32 INVALID_INDEX = U32_MAX;
+    /// Particles per radix block. Smaller sorts run on the calling thread
+    static constexpr U32 BlockSize = 4096u;
+    /// The insertion sort fix-up gives up after this many moves per particle
+    static constexpr U32 MaxFixupMovesPerParticle = 8u;
+
+    /// Where to write the sorted render data. Any pair of pointers may be null to skip that attribute
+    struct GatherDescriptor {
+        const ParticleAttribute* _position = nullptr;
+        float4* _positionsOut = nullptr;
+        const ParticleAttribute* _colour = nullptr;
+        UColour4* _coloursOut = nullptr;
+    };
+
+    /// Sorts particles [0, count) by distanceSq. Returns true if the previous order was reused
+    bool sort(TaskPool* pool, const ParticleStream& distanceSq, U32 count, bool reusePreviousOrder, const GatherDescriptor& gather);
+
+    /// Must be called right before particles with life <= 0 are compacted out of the streams, so that the previous order stays valid
+    void onCompact(const ParticleStream& life);
+    /// Forget the previous order (e.g. particles were moved around)
+    void invalidate() noexcept;
+
+    /// Particle indices, back to front, as of the last sort (minus the particles that died since)
+    [[nodiscard]] const vector<U32>& order() const noexcept { return _order; }
+
+   private:
+    [[nodiscard]] bool fixupPreviousOrder(const F32* distanceSq, U32 count);
+    void radixSort(TaskPool* pool, const F32* distanceSq, U32 count, const GatherDescriptor& gather);
+    void writeRenderData(TaskPool* pool, U32 count, const GatherDescriptor& gather);
+
+   private:
+    vector<U32> _order;
+    vector<U32> _orderTemp;
+    /// Distances of the particles in _order, while fixing up the previous order
+    vector<F32> _orderDistances;
+    vector<U16> _keys;
+    vector<U16> _keysTemp;
+    /// One radix histogram (later turned into scatter offsets) per block
+    vector<U32> _blockOffsets;
+    vector<F32> _blockMin;
+    vector<F32> _blockMax;
+    /// Old index -> new index in onCompact(), particle -> sorted slot in writeRenderData()
+    vector<U32> _remap;
+};
+
+} //namespace Divide
+
+#endif //DVD_PARTICLE_DEPTH_SORTER_H_
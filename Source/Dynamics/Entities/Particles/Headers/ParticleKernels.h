@@ -0,0 +1,70 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_PARTICLE_KERNELS_H_
+#define DVD_PARTICLE_KERNELS_H_
+
+#include "ParticleData.h"
+
+namespace Divide {
+
+/// SIMD update kernels over ParticleData's streams. Every kernel processes particles [start, end), 8 at a time with AVX (4 with SSE)
+/// and finishes any leftovers with scalar code that uses the same operation order. Ranges of different calls may be processed in parallel
+/// as long as they don't overlap.
+namespace ParticleKernels {
+    /// acc.xyz += accelerationDelta; vel.xyz += dt * acc.xyz; pos.xyz += dt * vel.xyz
+    void Euler(ParticleAttribute& acceleration, ParticleAttribute& velocity, ParticleAttribute& position, const float3& accelerationDelta, F32 dt, U32 start, U32 end) noexcept;
+
+    /// Particles below the floor (pos.y - pos.w / 2 < floorY) lose any downward acceleration and have their vertical speed reflected and scaled by bounceFactor
+    void Floor(const ParticleAttribute& position, ParticleAttribute& velocity, ParticleAttribute& acceleration, F32 floorY, F32 bounceFactor, U32 start, U32 end) noexcept;
+
+    /// acc.xyz += offset * (attractor.w / |offset|^2) for every attractor, where offset = attractor.xyz - pos.xyz
+    void Attract(const ParticleAttribute& position, ParticleAttribute& acceleration, const vector<float4>& attractors, U32 start, U32 end) noexcept;
+
+    /// colour = Lerp(startColour, endColour, t)
+    void LerpColour(const ParticleAttribute& startColour, const ParticleAttribute& endColour, const ParticleStream& t, ParticleAttribute& colour, U32 start, U32 end) noexcept;
+
+    /// misc.x -= dt; misc.y = 1 - misc.x * misc.z
+    void Age(ParticleAttribute& misc, F32 dt, U32 start, U32 end) noexcept;
+
+    /// distanceSqOut = |pos.xyz - eyePos|^2
+    void DistanceSq(const ParticleAttribute& position, const float3& eyePos, ParticleStream& distanceSqOut, U32 start, U32 end) noexcept;
+
+    /// Moves the first "count" entries of every stream so that only the ones with life > 0 remain, in their original order. "life" may be one of the streams.
+    /// Every entry is written unconditionally and only the write cursor depends on the life test, so there is no branch to mispredict.
+    /// Returns the number of entries kept
+    [[nodiscard]] U32 Compact(const ParticleStream& life, U32 count, ParticleStream* const* streams, size_t streamCount) noexcept;
+} //namespace ParticleKernels
+
+} //namespace Divide
+
+#endif //DVD_PARTICLE_KERNELS_H_
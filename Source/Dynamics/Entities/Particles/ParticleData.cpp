@@ -1,6 +1,7 @@
 
 
 #include "Headers/ParticleData.h"
+#include "Headers/ParticleKernels.h"
 
 #include "Core/Headers/Kernel.h"
 #include "Core/Headers/PlatformContext.h"
@@ -8,6 +9,53 @@
 
 namespace Divide {
 
+void ParticleStream::resize(const U32 count, const F32 value) {
+    constexpr U32 valuesPerBlock = to_U32(Alignment / sizeof(F32));
+
+    _blocks.resize((count + valuesPerBlock - 1u) / valuesPerBlock);
+    _size = count;
+    std::fill_n(data(), _blocks.size() * valuesPerBlock, value);
+}
+
+void ParticleStream::clear() noexcept {
+    _blocks.clear();
+    _size = 0u;
+}
+
+void ParticleAttribute::resize(const U32 count, const F32 value) {
+    _x.resize(count, value);
+    _y.resize(count, value);
+    _z.resize(count, value);
+    _w.resize(count, value);
+}
+
+void ParticleAttribute::clear() noexcept {
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _w.clear();
+}
+
+void ParticleAttribute::copy(const U32 dst, const U32 src) noexcept {
+    _x[dst] = _x[src];
+    _y[dst] = _y[src];
+    _z[dst] = _z[src];
+    _w[dst] = _w[src];
+}
+
+void ParticleAttribute::set(const U32 index, const float4& value) noexcept {
+    _x[index] = value.x;
+    _y[index] = value.y;
+    _z[index] = value.z;
+    _w[index] = value.w;
+}
+
+void ParticleAttribute::setXYZ(const U32 index, const float3& value) noexcept {
+    _x[index] = value.x;
+    _y[index] = value.y;
+    _z[index] = value.z;
+}
+
 ParticleData::ParticleData(GFXDevice& context, const U32 particleCount, const U32 optionsMask)
     : _context(context)
 {
@@ -32,7 +80,7 @@ void ParticleData::generateParticles(const U32 particleCount, const U32 optionsM
     _aliveCount = 0;
     _optionsMask = optionsMask;
 
-    _indices.clear();
+    _depthSorter.invalidate();
     _position.clear();
     _velocity.clear();
     _acceleration.clear();
@@ -44,30 +92,31 @@ void ParticleData::generateParticles(const U32 particleCount, const U32 optionsM
     if (_totalCount > 0) {
         if (_optionsMask & to_U32(ParticleDataProperties::PROPERTIES_POS))
         {
-            _position.resize(_totalCount, float4(0.0f));
+            _position.resize(_totalCount, 0.0f);
         }
         if (_optionsMask & to_U32(ParticleDataProperties::PROPERTIES_VEL))
         {
-            _velocity.resize(_totalCount, float4(0.0f));
+            _velocity.resize(_totalCount, 0.0f);
         }
         if (_optionsMask & to_U32(ParticleDataProperties::PROPERTIES_ACC))
         {
-            _acceleration.resize(_totalCount, float4(0.0f));
+            _acceleration.resize(_totalCount, 0.0f);
         }
         if (_optionsMask & to_U32(ParticleDataProperties::PROPERTIES_COLOR))
         {
-            _colour.resize(_totalCount, FColour4(0.0f));
+            _colour.resize(_totalCount, 0.0f);
         }
         if (_optionsMask & to_U32(ParticleDataProperties::PROPERTIES_COLOR_TRANS))
         {
-            _startColour.resize(_totalCount, FColour4(0.0f));
-            _endColour.resize(_totalCount, FColour4(0.0f));
+            _startColour.resize(_totalCount, 0.0f);
+            _endColour.resize(_totalCount, 0.0f);
         }
-        _misc.resize(_totalCount, float4(0.0f));
+        _misc.resize(_totalCount, 0.0f);
     }
 }
 
 void ParticleData::kill(const U32 index) {
+    _depthSorter.invalidate();
     swapData(index, _aliveCount - 1);
     _aliveCount--;
 }
@@ -77,70 +126,81 @@ void ParticleData::wake(U32 /*index*/) {
     _aliveCount++;
 }
 
-void ParticleData::sort() {
+void ParticleData::sort(const float3& eyePos) {
     const U32 count = aliveCount();
 
     if (count == 0) {
         return;
     }
 
-    _indices.resize(count);
     _renderingPositions.resize(count);
     _renderingColours.resize(count);
 
-    for (U32 i = 0; i < count; ++i) {
-        _indices[i] = { i, _misc[i].w };
-    }
-
-    eastl::sort(eastl::begin(_indices),
-                eastl::end(_indices),
-                [](const std::pair<U32, F32>& indexA, const std::pair<U32, F32>& indexB) {
-                    return indexA.second > indexB.second;
-                });
+    const bool reuseOrder = _sortReuseMaxEyeMovement > 0.f &&
+                            _lastSortEyePos.distanceSquared(eyePos) <= SQUARED(_sortReuseMaxEyeMovement);
+    _lastSortEyePos = eyePos;
 
-   auto parsePositions = [count, this](const Task&) -> void {
-        for (U32 i = 0; i < count; ++i) {
-            _renderingPositions[i].set(_position[_indices[i].first]);
-        }
-    };
+    ParticleDepthSorter::GatherDescriptor gather{};
+    if (!_position.empty()) {
+        gather._position = &_position;
+        gather._positionsOut = _renderingPositions.data();
+    }
+    if (!_colour.empty()) {
+        gather._colour = &_colour;
+        gather._coloursOut = _renderingColours.data();
+    }
 
-    auto parseColours = [count, this](const Task&) -> void {
-        for (U32 i = 0; i < count; ++i) {
-            Util::ToByteColour(_colour[_indices[i].first], _renderingColours[i]);
-        }
-    };
-    
-    TaskPool& pool = _context.context().taskPool(TaskPoolType::HIGH_PRIORITY);
-    Task* updateTask = CreateTask(TASK_NOP);
-    Start(*CreateTask(updateTask, parsePositions), pool);
-    Start(*CreateTask(updateTask, parseColours), pool);
-    Start(*updateTask, pool);
-    Wait(*updateTask, pool);
+    _depthSorter.sort(&_context.context().taskPool(TaskPoolType::HIGH_PRIORITY), _misc._w, count, reuseOrder, gather);
 }
 
 void ParticleData::swapData(const U32 indexA, const U32 indexB) {
+    _depthSorter.invalidate();
     if (_optionsMask & to_U32(ParticleDataProperties::PROPERTIES_POS))
     {
-        _position[indexA].set(_position[indexB]);
+        _position.copy(indexA, indexB);
     }
     if (_optionsMask & to_U32(ParticleDataProperties::PROPERTIES_VEL))
     {
-        _velocity[indexA].set(_velocity[indexB]);
+        _velocity.copy(indexA, indexB);
     }
     if (_optionsMask & to_U32(ParticleDataProperties::PROPERTIES_ACC))
     {
-        _acceleration[indexA].set(_acceleration[indexB]);
+        _acceleration.copy(indexA, indexB);
     }
     if (_optionsMask & to_U32(ParticleDataProperties::PROPERTIES_COLOR))
     {
-        _colour[indexA].set(_colour[indexB]);
+        _colour.copy(indexA, indexB);
     }
     if (_optionsMask & to_U32(ParticleDataProperties::PROPERTIES_COLOR_TRANS))
     {
-        _startColour[indexA].set(_startColour[indexB]);
-        _endColour[indexA].set(_endColour[indexB]);
+        _startColour.copy(indexA, indexB);
+        _endColour.copy(indexA, indexB);
     }
-    _misc[indexA].set(_misc[indexB]);
+    _misc.copy(indexA, indexB);
+}
+
+void ParticleData::compact() {
+    eastl::fixed_vector<ParticleStream*, 28, false> streams;
+
+    const auto addAttribute = [&streams](ParticleAttribute& attribute) {
+        if (!attribute.empty()) {
+            streams.push_back(&attribute._x);
+            streams.push_back(&attribute._y);
+            streams.push_back(&attribute._z);
+            streams.push_back(&attribute._w);
+        }
+    };
+
+    addAttribute(_position);
+    addAttribute(_velocity);
+    addAttribute(_acceleration);
+    addAttribute(_colour);
+    addAttribute(_startColour);
+    addAttribute(_endColour);
+    addAttribute(_misc);
+
+    _depthSorter.onCompact(_misc._x);
+    _aliveCount = ParticleKernels::Compact(_misc._x, _aliveCount, streams.data(), streams.size());
 }
 
 void ParticleData::setParticleGeometry(const vector<float3>& particleGeometryVertices,
@@ -0,0 +1,271 @@
+
+
+#include "Headers/ParticleDepthSorter.h"
+#include "Headers/ParticleData.h"
+
+#include "Core/Headers/TaskPool.h"
+
+namespace Divide {
+
+namespace {
+    constexpr U32 g_radixBits = 8u;
+    constexpr U32 g_radixBuckets = 1u << g_radixBits;
+    constexpr U32 g_radixMask = g_radixBuckets - 1u;
+
+    /// Runs func(block) for every block, in parallel if we have a pool and more than one block
+    template<typename Func>
+    void ForEachBlock(TaskPool* pool, const U32 blockCount, Func&& func) {
+        if (pool == nullptr || blockCount <= 1u) {
+            for (U32 block = 0u; block < blockCount; ++block) {
+                func(block);
+            }
+            return;
+        }
+
+        Parallel_For(*pool,
+                     ParallelForDescriptor
+                     {
+                         ._iterCount = blockCount,
+                         ._partitionSize = 1u
+                     },
+                     [&func](const Task*, const U32 start, const U32 end) {
+                         for (U32 block = start; block < end; ++block) {
+                             func(block);
+                         }
+                     });
+    }
+
+    FORCE_INLINE void GatherParticle(const ParticleDepthSorter::GatherDescriptor& gather, const U32 src, const U32 dst) noexcept {
+        if (gather._positionsOut != nullptr) {
+            gather._positionsOut[dst].set(gather._position->get(src));
+        }
+        if (gather._coloursOut != nullptr) {
+            Util::ToByteColour(gather._colour->get(src), gather._coloursOut[dst]);
+        }
+    }
+} //namespace
+
+bool ParticleDepthSorter::sort(TaskPool* pool, const ParticleStream& distanceSq, const U32 count, const bool reusePreviousOrder, const GatherDescriptor& gather) {
+    if (count == 0u) {
+        _order.resize(0);
+        return false;
+    }
+
+    if (reusePreviousOrder && fixupPreviousOrder(distanceSq.data(), count)) {
+        writeRenderData(pool, count, gather);
+        return true;
+    }
+
+    radixSort(pool, distanceSq.data(), count, gather);
+    return false;
+}
+
+void ParticleDepthSorter::onCompact(const ParticleStream& life) {
+    const U32 sortedCount = to_U32(_order.size());
+    if (sortedCount == 0u) {
+        return;
+    }
+
+    // Same test as ParticleKernels::Compact. Particles keep their relative order, so every survivor just moves down by the number of dead particles before it
+    _remap.resize(sortedCount);
+    U32 write = 0u;
+    for (U32 i = 0u; i < sortedCount; ++i) {
+        const U32 keep = life[i] > 0.f ? 1u : 0u;
+        _remap[i] = keep != 0u ? write : INVALID_INDEX;
+        write += keep;
+    }
+
+    U32 out = 0u;
+    for (const U32 index : _order) {
+        const U32 remapped = _remap[index];
+        _order[out] = remapped;
+        out += remapped != INVALID_INDEX ? 1u : 0u;
+    }
+    _order.resize(out);
+}
+
+void ParticleDepthSorter::invalidate() noexcept {
+    _order.resize(0);
+}
+
+bool ParticleDepthSorter::fixupPreviousOrder(const F32* distanceSq, const U32 count) {
+    const U32 sortedCount = to_U32(_order.size());
+    // Particles spawned since the last sort were appended after all of the ones we already know about
+    if (sortedCount == 0u || sortedCount > count || count - sortedCount > count / 4u) {
+        return false;
+    }
+
+    _order.resize(count);
+    _orderDistances.resize(count);
+    U32* order = _order.data();
+    F32* distances = _orderDistances.data();
+
+    // One gather up front, so that the insertion sort only touches contiguous memory
+    for (U32 i = 0u; i < sortedCount; ++i) {
+        distances[i] = distanceSq[order[i]];
+    }
+
+    const U64 moveBudget = to_U64(sortedCount) * MaxFixupMovesPerParticle;
+    U64 moves = 0u;
+    for (U32 i = 1u; i < sortedCount; ++i) {
+        const U32 index = order[i];
+        const F32 distance = distances[i];
+
+        U32 j = i;
+        for (; j > 0u && distances[j - 1u] < distance; --j) {
+            order[j] = order[j - 1u];
+            distances[j] = distances[j - 1u];
+        }
+        order[j] = index;
+        distances[j] = distance;
+
+        moves += i - j;
+        if (moves > moveBudget) {
+            // Too far from sorted. The radix sort overwrites the whole order anyway
+            return false;
+        }
+    }
+
+    if (sortedCount < count) {
+        _orderTemp.resize(count - sortedCount);
+        for (U32 i = sortedCount; i < count; ++i) {
+            _orderTemp[i - sortedCount] = i;
+        }
+        eastl::sort(begin(_orderTemp), end(_orderTemp), [distanceSq](const U32 lhs, const U32 rhs) noexcept {
+            return distanceSq[lhs] > distanceSq[rhs];
+        });
+
+        // Merge the newcomers in from the back (closest particles first), so nothing gets overwritten before it is moved
+        I64 previous = to_I64(sortedCount) - 1;
+        for (I64 spawned = to_I64(_orderTemp.size()) - 1, out = to_I64(count) - 1; spawned >= 0; --out) {
+            const U32 spawnedIndex = _orderTemp[spawned];
+            if (previous >= 0 && distances[previous] < distanceSq[spawnedIndex]) {
+                order[out] = order[previous];
+                distances[out] = distances[previous];
+                --previous;
+            } else {
+                order[out] = spawnedIndex;
+                distances[out] = distanceSq[spawnedIndex];
+                --spawned;
+            }
+        }
+    }
+
+    return true;
+}
+
+void ParticleDepthSorter::radixSort(TaskPool* pool, const F32* distanceSq, const U32 count, const GatherDescriptor& gather) {
+    const U32 blockCount = (count + BlockSize - 1u) / BlockSize;
+
+    const auto blockRange = [count](const U32 block) noexcept {
+        return std::make_pair(block * BlockSize, std::min((block + 1u) * BlockSize, count));
+    };
+
+    // Distance range, for quantization
+    _blockMin.resize(blockCount);
+    _blockMax.resize(blockCount);
+    ForEachBlock(pool, blockCount, [&](const U32 block) {
+        const auto [start, end] = blockRange(block);
+        F32 min = distanceSq[start], max = distanceSq[start];
+        for (U32 i = start + 1u; i < end; ++i) {
+            min = std::min(min, distanceSq[i]);
+            max = std::max(max, distanceSq[i]);
+        }
+        _blockMin[block] = min;
+        _blockMax[block] = max;
+    });
+
+    const F32 minDistance = *eastl::min_element(begin(_blockMin), end(_blockMin));
+    const F32 maxDistance = *eastl::max_element(begin(_blockMax), end(_blockMax));
+    const F32 scale = maxDistance > minDistance ? to_F32(U16_MAX) / (maxDistance - minDistance) : 0.f;
+
+    _keys.resize(count);
+    _keysTemp.resize(count);
+    _order.resize(count);
+    _orderTemp.resize(count);
+    _blockOffsets.resize(to_size(blockCount) * g_radixBuckets);
+
+    // Turns per block histograms into scatter offsets: every block writes its share of a bucket right after the previous block's share
+    const auto computeOffsets = [&]() {
+        U32 running = 0u;
+        for (U32 digit = 0u; digit < g_radixBuckets; ++digit) {
+            for (U32 block = 0u; block < blockCount; ++block) {
+                U32& offset = _blockOffsets[block * g_radixBuckets + digit];
+                const U32 bucketSize = offset;
+                offset = running;
+                running += bucketSize;
+            }
+        }
+    };
+
+    // Pass 1: quantize (farthest particle gets the smallest key) and histogram the low byte
+    ForEachBlock(pool, blockCount, [&](const U32 block) {
+        const auto [start, end] = blockRange(block);
+        U32* histogram = &_blockOffsets[block * g_radixBuckets];
+        std::fill_n(histogram, g_radixBuckets, 0u);
+        for (U32 i = start; i < end; ++i) {
+            const F32 quantized = std::min((distanceSq[i] - minDistance) * scale, to_F32(U16_MAX));
+            const U16 key = U16_MAX - static_cast<U16>(quantized);
+            _keys[i] = key;
+            ++histogram[key & g_radixMask];
+        }
+    });
+    computeOffsets();
+
+    // Pass 2: scatter by the low byte
+    ForEachBlock(pool, blockCount, [&](const U32 block) {
+        const auto [start, end] = blockRange(block);
+        U32* offsets = &_blockOffsets[block * g_radixBuckets];
+        for (U32 i = start; i < end; ++i) {
+            const U16 key = _keys[i];
+            const U32 dst = offsets[key & g_radixMask]++;
+            _keysTemp[dst] = key;
+            _orderTemp[dst] = i;
+        }
+    });
+
+    // Pass 3: histogram the high byte of the partially sorted keys
+    ForEachBlock(pool, blockCount, [&](const U32 block) {
+        const auto [start, end] = blockRange(block);
+        U32* histogram = &_blockOffsets[block * g_radixBuckets];
+        std::fill_n(histogram, g_radixBuckets, 0u);
+        for (U32 i = start; i < end; ++i) {
+            ++histogram[_keysTemp[i] >> g_radixBits];
+        }
+    });
+    computeOffsets();
+
+    // Pass 4: scatter by the high byte. Every particle's final slot is known here, so gather its render data at the same time
+    ForEachBlock(pool, blockCount, [&](const U32 block) {
+        const auto [start, end] = blockRange(block);
+        U32* offsets = &_blockOffsets[block * g_radixBuckets];
+        for (U32 i = start; i < end; ++i) {
+            const U32 index = _orderTemp[i];
+            const U32 dst = offsets[_keysTemp[i] >> g_radixBits]++;
+            _order[dst] = index;
+            GatherParticle(gather, index, dst);
+        }
+    });
+}
+
+void ParticleDepthSorter::writeRenderData(TaskPool* pool, const U32 count, const GatherDescriptor& gather) {
+    const U32 blockCount = (count + BlockSize - 1u) / BlockSize;
+
+    // Walking the particles in sorted order would read every attribute stream at random. Reading them in order and writing each particle to its slot is a lot cheaper
+    _remap.resize(count);
+    ForEachBlock(pool, blockCount, [&](const U32 block) {
+        const U32 end = std::min((block + 1u) * BlockSize, count);
+        for (U32 slot = block * BlockSize; slot < end; ++slot) {
+            _remap[_order[slot]] = slot;
+        }
+    });
+
+    ForEachBlock(pool, blockCount, [&](const U32 block) {
+        const U32 end = std::min((block + 1u) * BlockSize, count);
+        for (U32 i = block * BlockSize; i < end; ++i) {
+            GatherParticle(gather, i, _remap[i]);
+        }
+    });
+}
+
+} //namespace Divide
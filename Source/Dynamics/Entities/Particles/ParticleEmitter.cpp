@@ -1,6 +1,7 @@
 
 
 #include "Headers/ParticleEmitter.h"
+#include "Headers/ParticleKernels.h"
 
 
 #include "Core/Headers/Configuration.h"
@@ -138,7 +139,7 @@ bool ParticleEmitter::initData(const std::shared_ptr<ParticleData>& particleData
     for ( U32 i = 0; i < particleCount; ++i )
     {
         // Distance to camera (squared)
-        _particles->_misc[i].w = -1.0f;
+        _particles->_misc._w[i] = -1.0f;
     }
 
     const PrimitiveTopology topology = _particles->particleGeometryType();
@@ -305,26 +306,21 @@ void ParticleEmitter::prepareRender(SceneGraphNode* sgn,
             const float3& eyePos = cameraSnapshot._eye;
             const U32 aliveCount = getAliveParticleCount();
 
-            vector<float4>& misc = _particles->_misc;
-            vector<float4>& pos = _particles->_position;
-
+            ParticleData& data = *_particles;
 
             ParallelForDescriptor descriptor = {};
             descriptor._iterCount = aliveCount;
-            descriptor._partitionSize = 1000u;
-            Parallel_For( sgn->context().taskPool( TaskPoolType::HIGH_PRIORITY ), descriptor, [&eyePos, &misc, &pos](const Task*, const U32 start, const U32 end)
+            descriptor._partitionSize = 1024u;
+            Parallel_For( sgn->context().taskPool( TaskPoolType::HIGH_PRIORITY ), descriptor, [&eyePos, &data](const Task*, const U32 start, const U32 end)
             {
-                for (U32 i = start; i < end; ++i)
-                {
-                    misc[i].w = pos[i].xyz.distanceSquared(eyePos);
-                }
+                ParticleKernels::DistanceSq(data._position, eyePos, data._misc._w, start, end);
             });
 
             _bufferUpdate = CreateTask(
-                [this, &renderStagePass](const Task&)
+                [this, &renderStagePass, eyePos = cameraSnapshot._eye](const Task&)
                 {
                     // invalidateCache means that the existing particle data is no longer partially sorted
-                    _particles->sort();
+                    _particles->sort(eyePos);
                     _buffersDirty[to_U32(renderStagePass._stage)] = true;
                 });
 
@@ -370,10 +366,11 @@ void ParticleEmitter::sceneUpdate(const U64 deltaTimeUS,
         descriptor._partitionSize = s_particlesPerThread;
         Parallel_For( sgn->context().taskPool( TaskPoolType::HIGH_PRIORITY ), descriptor, [this](const Task*, const U32 start, const U32 end)
         {
-            for (U32 i = start; i < end; ++i)
+            ParticleData& data = *_particles;
+            std::copy(data._misc._z.data() + start, data._misc._z.data() + end, data._position._w.data() + start);
+            for (ParticleStream* stream : { &data._acceleration._x, &data._acceleration._y, &data._acceleration._z, &data._acceleration._w })
             {
-                _particles->_position[i].w = _particles->_misc[i].z;
-                _particles->_acceleration[i].set(0.0f);
+                std::fill(stream->data() + start, stream->data() + end, 0.0f);
             }
         });
 
@@ -390,7 +387,7 @@ void ParticleEmitter::sceneUpdate(const U64 deltaTimeUS,
             BoundingBox aabb{};
             for (U32 i = 0; i < aliveCount; i += to_U32(averageEmitRate) / 4)
             {
-                aabb.add(_particles->_position[i]);
+                aabb.add(_particles->_position.xyz(i));
             }
             setBounds(aabb);
         });
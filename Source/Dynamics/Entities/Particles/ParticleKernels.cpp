@@ -0,0 +1,192 @@
+
+
+#include "Headers/ParticleKernels.h"
+
+#include "Core/Math/Headers/SimdLanes.h"
+
+namespace Divide::ParticleKernels {
+
+namespace {
+    /// Runs batch.operator()<Lanes>(i) for every full group of lanes in [start, end), widest registers first, then scalar(i) for whatever is left
+    template<typename Batch, typename Scalar>
+    FORCE_INLINE void ForEachLane(U32 start, const U32 end, Batch&& batch, Scalar&& scalar) noexcept {
+        for (; start + WideLanes::Width <= end; start += WideLanes::Width) {
+            batch.template operator()<WideLanes>(start);
+        }
+        if constexpr (WideLanes::Width > SSELanes::Width) {
+            for (; start + SSELanes::Width <= end; start += SSELanes::Width) {
+                batch.template operator()<SSELanes>(start);
+            }
+        }
+        for (; start < end; ++start) {
+            scalar(start);
+        }
+    }
+} //namespace
+
+void Euler(ParticleAttribute& acceleration, ParticleAttribute& velocity, ParticleAttribute& position, const float3& accelerationDelta, const F32 dt, const U32 start, const U32 end) noexcept {
+    F32* accX = acceleration._x.data(); F32* accY = acceleration._y.data(); F32* accZ = acceleration._z.data();
+    F32* velX = velocity._x.data();     F32* velY = velocity._y.data();     F32* velZ = velocity._z.data();
+    F32* posX = position._x.data();     F32* posY = position._y.data();     F32* posZ = position._z.data();
+
+    ForEachLane(start, end,
+        [&]<typename Lanes>(const U32 i) {
+            const auto delta = Lanes::Set(dt);
+
+            const auto aX = Lanes::Add(Lanes::Load(accX + i), Lanes::Set(accelerationDelta.x));
+            const auto aY = Lanes::Add(Lanes::Load(accY + i), Lanes::Set(accelerationDelta.y));
+            const auto aZ = Lanes::Add(Lanes::Load(accZ + i), Lanes::Set(accelerationDelta.z));
+            Lanes::Store(accX + i, aX); Lanes::Store(accY + i, aY); Lanes::Store(accZ + i, aZ);
+
+            const auto vX = Lanes::Add(Lanes::Load(velX + i), Lanes::Mul(delta, aX));
+            const auto vY = Lanes::Add(Lanes::Load(velY + i), Lanes::Mul(delta, aY));
+            const auto vZ = Lanes::Add(Lanes::Load(velZ + i), Lanes::Mul(delta, aZ));
+            Lanes::Store(velX + i, vX); Lanes::Store(velY + i, vY); Lanes::Store(velZ + i, vZ);
+
+            Lanes::Store(posX + i, Lanes::Add(Lanes::Load(posX + i), Lanes::Mul(delta, vX)));
+            Lanes::Store(posY + i, Lanes::Add(Lanes::Load(posY + i), Lanes::Mul(delta, vY)));
+            Lanes::Store(posZ + i, Lanes::Add(Lanes::Load(posZ + i), Lanes::Mul(delta, vZ)));
+        },
+        [&](const U32 i) {
+            accX[i] = accX[i] + accelerationDelta.x; accY[i] = accY[i] + accelerationDelta.y; accZ[i] = accZ[i] + accelerationDelta.z;
+            velX[i] = velX[i] + dt * accX[i];        velY[i] = velY[i] + dt * accY[i];        velZ[i] = velZ[i] + dt * accZ[i];
+            posX[i] = posX[i] + dt * velX[i];        posY[i] = posY[i] + dt * velY[i];        posZ[i] = posZ[i] + dt * velZ[i];
+        });
+}
+
+void Floor(const ParticleAttribute& position, ParticleAttribute& velocity, ParticleAttribute& acceleration, const F32 floorY, const F32 bounceFactor, const U32 start, const U32 end) noexcept {
+    const F32* posY = position._y.data();
+    const F32* size = position._w.data();
+    F32* velY = velocity._y.data();
+    F32* accY = acceleration._y.data();
+
+    const F32 bounce = 1.0f + bounceFactor;
+
+    ForEachLane(start, end,
+        [&]<typename Lanes>(const U32 i) {
+            const auto zero = Lanes::Set(0.f);
+            const auto below = Lanes::Less(Lanes::Sub(Lanes::Load(posY + i), Lanes::Mul(Lanes::Load(size + i), Lanes::Set(0.5f))), Lanes::Set(floorY));
+
+            // Only the vertical components change: drop any downward acceleration and reflect the vertical speed
+            const auto aY = Lanes::Load(accY + i);
+            const auto vY = Lanes::Load(velY + i);
+            Lanes::Store(accY + i, Lanes::Select(below, Lanes::Select(Lanes::Less(aY, zero), zero, aY), aY));
+            Lanes::Store(velY + i, Lanes::Select(below, Lanes::Sub(vY, Lanes::Mul(Lanes::Set(bounce), vY)), vY));
+        },
+        [&](const U32 i) {
+            if (posY[i] - size[i] * 0.5f < floorY) {
+                accY[i] = accY[i] < 0.f ? 0.f : accY[i];
+                velY[i] = velY[i] - bounce * velY[i];
+            }
+        });
+}
+
+void Attract(const ParticleAttribute& position, ParticleAttribute& acceleration, const vector<float4>& attractors, const U32 start, const U32 end) noexcept {
+    const F32* posX = position._x.data(); const F32* posY = position._y.data(); const F32* posZ = position._z.data();
+    F32* accX = acceleration._x.data();   F32* accY = acceleration._y.data();   F32* accZ = acceleration._z.data();
+
+    ForEachLane(start, end,
+        [&]<typename Lanes>(const U32 i) {
+            const auto pX = Lanes::Load(posX + i), pY = Lanes::Load(posY + i), pZ = Lanes::Load(posZ + i);
+            auto aX = Lanes::Load(accX + i), aY = Lanes::Load(accY + i), aZ = Lanes::Load(accZ + i);
+
+            for (const float4& attractor : attractors) {
+                const auto oX = Lanes::Sub(Lanes::Set(attractor.x), pX);
+                const auto oY = Lanes::Sub(Lanes::Set(attractor.y), pY);
+                const auto oZ = Lanes::Sub(Lanes::Set(attractor.z), pZ);
+                const auto force = Lanes::Div(Lanes::Set(attractor.w), Lanes::Add(Lanes::Add(Lanes::Mul(oX, oX), Lanes::Mul(oY, oY)), Lanes::Mul(oZ, oZ)));
+                aX = Lanes::Add(aX, Lanes::Mul(oX, force));
+                aY = Lanes::Add(aY, Lanes::Mul(oY, force));
+                aZ = Lanes::Add(aZ, Lanes::Mul(oZ, force));
+            }
+
+            Lanes::Store(accX + i, aX); Lanes::Store(accY + i, aY); Lanes::Store(accZ + i, aZ);
+        },
+        [&](const U32 i) {
+            for (const float4& attractor : attractors) {
+                const F32 oX = attractor.x - posX[i], oY = attractor.y - posY[i], oZ = attractor.z - posZ[i];
+                const F32 force = attractor.w / ((oX * oX + oY * oY) + oZ * oZ);
+                accX[i] = accX[i] + oX * force;
+                accY[i] = accY[i] + oY * force;
+                accZ[i] = accZ[i] + oZ * force;
+            }
+        });
+}
+
+void LerpColour(const ParticleAttribute& startColour, const ParticleAttribute& endColour, const ParticleStream& t, ParticleAttribute& colour, const U32 start, const U32 end) noexcept {
+    const F32* factor = t.data();
+
+    const auto lerpChannel = [&](const ParticleStream& from, const ParticleStream& to, ParticleStream& out) {
+        const F32* a = from.data();
+        const F32* b = to.data();
+        F32* ret = out.data();
+
+        ForEachLane(start, end,
+            [&]<typename Lanes>(const U32 i) {
+                const auto f = Lanes::Load(factor + i);
+                Lanes::Store(ret + i, Lanes::Add(Lanes::Mul(Lanes::Load(a + i), Lanes::Sub(Lanes::Set(1.f), f)), Lanes::Mul(Lanes::Load(b + i), f)));
+            },
+            [&](const U32 i) {
+                ret[i] = a[i] * (1.f - factor[i]) + b[i] * factor[i];
+            });
+    };
+
+    lerpChannel(startColour._x, endColour._x, colour._x);
+    lerpChannel(startColour._y, endColour._y, colour._y);
+    lerpChannel(startColour._z, endColour._z, colour._z);
+    lerpChannel(startColour._w, endColour._w, colour._w);
+}
+
+void Age(ParticleAttribute& misc, const F32 dt, const U32 start, const U32 end) noexcept {
+    F32* time = misc._x.data();
+    F32* interpolation = misc._y.data();
+    const F32* invLifeTime = misc._z.data();
+
+    ForEachLane(start, end,
+        [&]<typename Lanes>(const U32 i) {
+            const auto remaining = Lanes::Sub(Lanes::Load(time + i), Lanes::Set(dt));
+            Lanes::Store(time + i, remaining);
+            // interpolation: from 0 (start of life) till 1 (end of life)
+            Lanes::Store(interpolation + i, Lanes::Sub(Lanes::Set(1.f), Lanes::Mul(remaining, Lanes::Load(invLifeTime + i))));
+        },
+        [&](const U32 i) {
+            time[i] = time[i] - dt;
+            interpolation[i] = 1.f - time[i] * invLifeTime[i];
+        });
+}
+
+void DistanceSq(const ParticleAttribute& position, const float3& eyePos, ParticleStream& distanceSqOut, const U32 start, const U32 end) noexcept {
+    const F32* posX = position._x.data(); const F32* posY = position._y.data(); const F32* posZ = position._z.data();
+    F32* ret = distanceSqOut.data();
+
+    ForEachLane(start, end,
+        [&]<typename Lanes>(const U32 i) {
+            const auto dX = Lanes::Sub(Lanes::Load(posX + i), Lanes::Set(eyePos.x));
+            const auto dY = Lanes::Sub(Lanes::Load(posY + i), Lanes::Set(eyePos.y));
+            const auto dZ = Lanes::Sub(Lanes::Load(posZ + i), Lanes::Set(eyePos.z));
+            Lanes::Store(ret + i, Lanes::Add(Lanes::Add(Lanes::Mul(dX, dX), Lanes::Mul(dY, dY)), Lanes::Mul(dZ, dZ)));
+        },
+        [&](const U32 i) {
+            const F32 dX = posX[i] - eyePos.x, dY = posY[i] - eyePos.y, dZ = posZ[i] - eyePos.z;
+            ret[i] = (dX * dX + dY * dY) + dZ * dZ;
+        });
+}
+
+U32 Compact(const ParticleStream& life, const U32 count, ParticleStream* const* streams, const size_t streamCount) noexcept {
+    const F32* remaining = life.data();
+
+    U32 write = 0u;
+    for (U32 i = 0u; i < count; ++i) {
+        // Read before any of the writes below: "life" may be one of the streams, but the write cursor never gets ahead of i
+        const U32 keep = remaining[i] > 0.f ? 1u : 0u;
+        for (size_t s = 0u; s < streamCount; ++s) {
+            F32* data = streams[s]->data();
+            data[write] = data[i];
+        }
+        write += keep;
+    }
+
+    return write;
+}
+
+} //namespace Divide::ParticleKernels
@@ -5,6 +5,7 @@
 #include "Managers/Headers/ProjectManager.h"
 #include "Geometry/Shapes/Headers/Object3D.h"
 #include "Geometry/Animations/Headers/SceneAnimator.h"
+#include "Platform/Video/Headers/GFXDevice.h"
 
 #include "ECS/Components/Headers/RenderingComponent.h"
 #include "ECS/Components/Headers/TransformComponent.h"
@@ -140,6 +141,32 @@ void AnimationComponent::setAnimator(SceneAnimator* animator)
             _editorComponent.registerField(MOV(playAnimationsField));
         }
 
+        _poseBuffer.reset();
+        if (samplesPose() && !_animator->animations().empty())
+        {
+            // Start from the first frame so the buffer never holds garbage
+            samplePose(0.0);
+            _poseDirty.store(false);
+
+            const bool dualQuaternions = _animator->useDualQuaternion();
+
+            ShaderBufferDescriptor bufferDescriptor{};
+            bufferDescriptor._ringBufferLength = Config::MAX_FRAMES_IN_FLIGHT + 1u;
+            Util::StringFormatTo(bufferDescriptor._name, "BONE_BUFFER_{}", _parentSGN->name().c_str());
+            bufferDescriptor._bufferParams._usageType = BufferUsageType::UNBOUND_BUFFER;
+            bufferDescriptor._bufferParams._updateFrequency = BufferUpdateFrequency::OFTEN;
+            bufferDescriptor._bufferParams._elementSize = dualQuaternions ? sizeof(DualQuaternion) : sizeof(mat4<F32>);
+            bufferDescriptor._bufferParams._elementCount = to_U32(_pose._skinning.size());
+            if (dualQuaternions)
+            {
+                bufferDescriptor._initialData = { (Byte*)_poseQuaternions.data(), _poseQuaternions.size() * sizeof(DualQuaternion) };
+            }
+            else
+            {
+                bufferDescriptor._initialData = { (Byte*)_pose._skinning.data(), _pose._skinning.size() * sizeof(mat4<F32>) };
+            }
+            _poseBuffer = _context.gfx().newSB(bufferDescriptor);
+        }
     }
 
     enabled(_animator != nullptr);
@@ -182,6 +209,8 @@ bool AnimationComponent::playAnimation(U32 pAnimIndex)
         return false;
     }
 
+    cancelCrossFade();
+
     _animationIndex = pAnimIndex;  // only set this after the checks for good data and the object was actually inserted
     resetTimers(0.0);
     _animationStateChanged = true;
@@ -210,6 +239,73 @@ bool AnimationComponent::playPreviousAnimation() noexcept
     return playAnimation(--oldIndex);
 }
 
+bool AnimationComponent::crossFade(U32 animationIndex, const D64 durationS)
+{
+    if (!samplesPose() || _animator->animations().empty())
+    {
+        return false;
+    }
+
+    animationIndex = std::min(animationIndex, to_U32(_animator->animations().size()) - 1u);
+    if (_animationIndex == U32_MAX || durationS <= 0.0)
+    {
+        return playAnimation(animationIndex);
+    }
+
+    if (animationIndex == _animationIndex || animationIndex == _crossFadeTarget)
+    {
+        return false;
+    }
+
+    cancelCrossFade();
+
+    // The current animation keeps playing on the component's timeline, the new one starts from its first frame
+    const D64 nowS = Time::MillisecondsToSeconds<D64>(_parentTimeStamp);
+    _blendGraph.clear();
+    const U16 from = _blendGraph.addClip(_animationIndex);
+    const U16 to = _blendGraph.addClip(animationIndex, 1.f, nowS);
+    _crossFadeNode = _blendGraph.addBlend(from, to, 0.f);
+    _crossFadeTarget = animationIndex;
+    _crossFadeStartS = nowS;
+    _crossFadeDurationS = durationS;
+
+    return true;
+}
+
+D64 AnimationComponent::updateCrossFade(const D64 timeStampSec)
+{
+    if (_crossFadeTarget == U32_MAX)
+    {
+        return timeStampSec;
+    }
+
+    const D64 elapsedS = timeStampSec - _crossFadeStartS;
+    if (elapsedS < _crossFadeDurationS)
+    {
+        _blendGraph.node(_crossFadeNode)._weight = to_F32(std::max(elapsedS, 0.0) / _crossFadeDurationS);
+        return timeStampSec;
+    }
+
+    // Done: switch to the target animation without restarting it
+    _animationIndex = _crossFadeTarget;
+    cancelCrossFade();
+
+    _parentTimeStamp = _currentTimeStamp = Time::SecondsToMilliseconds<D64>(elapsedS);
+    _animationStateChanged = true;
+
+    return elapsedS;
+}
+
+void AnimationComponent::cancelCrossFade()
+{
+    if (_crossFadeTarget != U32_MAX)
+    {
+        _blendGraph.clear();
+        _crossFadeTarget = U32_MAX;
+        _crossFadeNode = AnimationBlendNode::INVALID_INPUT;
+    }
+}
+
 const vector<Line>& AnimationComponent::skeletonLines() const
 {
     assert(_animator != nullptr);
@@ -221,10 +317,65 @@ const vector<Line>& AnimationComponent::skeletonLines() const
 
 ShaderBuffer* AnimationComponent::getBoneBuffer() const
 {
+    if (samplesPose())
+    {
+        return _poseBuffer.get();
+    }
+
     const AnimEvaluator& anim = getAnimationByIndex( std::min( _previousAnimationIndex, to_U32(_animator->animations().size()) ) );
     return anim.boneBuffer();
 }
 
+bool AnimationComponent::samplesPose() const noexcept
+{
+    return _animator != nullptr && _animator->storageMode() == AnimationStorageMode::SAMPLED;
+}
+
+void AnimationComponent::samplePose(const D64 timeStampSec)
+{
+    const D64 sampleTimeSec = updateCrossFade(timeStampSec);
+
+    if (_blendGraph.empty())
+    {
+        _animator->samplePose(_animationIndex == U32_MAX ? 0u : _animationIndex, sampleTimeSec, !_playInReverse, _pose, _maxBoneDepth);
+    }
+    else
+    {
+        _animator->evaluateBlendGraph(_blendGraph, sampleTimeSec, !_playInReverse, _blendScratchPoses, _pose);
+    }
+
+    if (_animator->useDualQuaternion())
+    {
+        _poseQuaternions.resize(_pose._skinning.size());
+        for (size_t i = 0u; i < _pose._skinning.size(); ++i)
+        {
+            DualQuaternion& dualQuat = _poseQuaternions[i];
+            Util::ToDualQuaternion(_pose._skinning[i], dualQuat.a, dualQuat.b);
+        }
+    }
+
+    _poseDirty.store(true);
+}
+
+void AnimationComponent::uploadPose(GFX::MemoryBarrierCommand& memCmdInOut)
+{
+    // Multiple passes may prepare this node at the same time. Only the first one uploads
+    if (_poseBuffer == nullptr || !_poseDirty.exchange(false))
+    {
+        return;
+    }
+
+    _poseBuffer->incQueue();
+    if (_animator->useDualQuaternion())
+    {
+        memCmdInOut._bufferLocks.push_back(_poseBuffer->writeData(_poseQuaternions.data()));
+    }
+    else
+    {
+        memCmdInOut._bufferLocks.push_back(_poseBuffer->writeData(_pose._skinning.data()));
+    }
+}
+
 I32 AnimationComponent::frameCount(const U32 animationID) const
 {
     assert(_animator != nullptr);
@@ -128,77 +128,71 @@ void BoundsComponent::OnData(const ECS::CustomEvent& data)
     }
 }
 
-void BoundsComponent::setRefBoundingBox(const BoundingBox& nodeBounds) noexcept
-{
-    // All the parents should already be dirty thanks to the bounds system
-    _refBoundingBox.set(nodeBounds);
-    _transformUpdatedMask.store(to_base(TransformType::ALL));
-}
-
-void BoundsComponent::updateBoundingBoxTransform()
+void BoundsComponent::updateBounds()
 {
     PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
 
-    if (_transformUpdatedMask > 0u)
-    {
-        _boundingBox.transform(_refBoundingBox, _lastTransform);
-    }
-}
-
-void BoundsComponent::appendChildRefBBs()
-{
-    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+    _transformUpdatedMask.store(0u);
 
     const SceneGraphNode::ChildContainer& children = _parentSGN->getChildren();
     SharedLock<SharedMutex> r_lock(children._lock);
     const U32 childCount = children._count;
 
-    for (U32 i = 0u; i < childCount; ++i)
+    if (_refDirty)
     {
-        if (children._data[i]->HasComponents(ComponentType::BOUNDS))
+        _refDirty = false;
+        _refBoundingBox.set(_parentSGN->getNode().getBounds());
+        for (U32 i = 0u; i < childCount; ++i)
         {
-            BoundsComponent* const bComp = children._data[i]->get<BoundsComponent>();
-            bComp->appendChildRefBBs();
-            _refBoundingBox.add(bComp->_refBoundingBox);
+            if (children._data[i]->HasComponents(ComponentType::BOUNDS))
+            {
+                _refBoundingBox.add(children._data[i]->get<BoundsComponent>()->_refBoundingBox);
+            }
         }
     }
-}
 
-void BoundsComponent::appendChildBBs()
-{
-    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
-
-    if (_transformUpdatedMask.exchange(0u) == 0u)
+    _boundingBox.transform(_refBoundingBox, _lastTransform);
+    for (U32 i = 0u; i < childCount; ++i)
     {
-        return;
+        if (children._data[i]->HasComponents(ComponentType::BOUNDS))
+        {
+            _boundingBox.add(children._data[i]->get<BoundsComponent>()->_boundingBox);
+        }
     }
 
-    const SceneGraphNode::ChildContainer& children = _parentSGN->getChildren();
+    _sphereDirty.store(true);
+    _obbDirty.store(true);
+}
 
-    SharedLock<SharedMutex> r_lock(children._lock);
-    const U32 childCount = children._count;
-    for (U32 i = 0u; i < childCount; ++i)
+const BoundingSphere& BoundsComponent::getBoundingSphere() const
+{
+    if (_sphereDirty.load())
     {
-        if (children._data[i]->HasComponents(ComponentType::BOUNDS))
+        LockGuard<Mutex> w_lock(_lazyBoundsLock);
+        if (_sphereDirty.load())
         {
-            BoundsComponent* const bComp = children._data[i]->get<BoundsComponent>();
-            // This will also clear our transform flag so subsequent calls will be fast
-            bComp->appendChildBBs();
-            _boundingBox.add(bComp->_boundingBox);
+            _boundingSphere.fromBoundingBox(_boundingBox);
+            _sphereDirty.store(false);
         }
     }
-    _boundingSphere.fromBoundingBox(_boundingBox);
-    _obbDirty.store(true);
+
+    return _boundingSphere;
 }
 
 const OBB& BoundsComponent::getOBB()
 {
-    if (_obbDirty.exchange(false))
+    if (_obbDirty.load())
     {
-        const TransformComponent* transform = _parentSGN->get<TransformComponent>();
-        _obb.fromBoundingBox(_refBoundingBox, transform->getWorldMatrix());
-        //_obb.fromBoundingBox(_refBoundingBox, transform->getWorldPosition(), transform->getWorldOrientation(), transform->getWorldScale());
-        _boundingSphere = _obb.toEnclosingSphere();
+        LockGuard<Mutex> w_lock(_lazyBoundsLock);
+        if (_obbDirty.load())
+        {
+            const TransformComponent* transform = _parentSGN->get<TransformComponent>();
+            _obb.fromBoundingBox(_refBoundingBox, transform->getWorldMatrix());
+            //_obb.fromBoundingBox(_refBoundingBox, transform->getWorldPosition(), transform->getWorldOrientation(), transform->getWorldScale());
+            _boundingSphere = _obb.toEnclosingSphere();
+            _sphereDirty.store(false);
+            _obbDirty.store(false);
+        }
     }
 
     return _obb;
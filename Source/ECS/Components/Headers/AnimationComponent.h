@@ -36,6 +36,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "SGNComponent.h"
 #include "Core/Math/Headers/Line.h"
 #include "Geometry/Animations/Headers/AnimationEvaluator.h"
+#include "Geometry/Animations/Headers/AnimationBlendGraph.h"
 
 namespace Divide {
 
@@ -43,7 +44,28 @@ class ShaderBuffer;
 class AnimEvaluator;
 class SceneGraphNode;
 
+namespace GFX
+{
+    struct MemoryBarrierCommand;
+} //namespace GFX
+
 FWD_DECLARE_MANAGED_CLASS(SceneAnimator);
+
+/// How often the AnimationSystem updates an instance. Picked every update from the last DISPLAY pass' visibility and distance to the camera
+enum class AnimationLODTier : U8
+{
+    /// Every update
+    FULL = 0,
+    /// Every other update
+    HALF_RATE,
+    /// Every 4th update, with a reduced bone set (SAMPLED storage mode only)
+    QUARTER_RATE,
+    /// Missing from the last DISPLAY pass: every 4th update, with every bone. The instance may still show up in shadow or reflection passes,
+    /// so it keeps animating. The time stamp keeps advancing, so it jumps straight to the right pose as soon as it is visible again
+    INVISIBLE,
+    COUNT
+};
+
 BEGIN_COMPONENT(Animation, ComponentType::ANIMATION)
    public:
     explicit AnimationComponent(SceneGraphNode* parentSGN, PlatformContext& context);
@@ -58,6 +80,8 @@ BEGIN_COMPONENT(Animation, ComponentType::ANIMATION)
     bool playNextAnimation() noexcept;
     /// Select previous available animation
     bool playPreviousAnimation() noexcept;
+    /// Blends from the current animation to the given one over the specified duration. SAMPLED storage mode only (replaces the blend graph)
+    bool crossFade(U32 animationIndex, D64 durationS);
 
     [[nodiscard]] I32 frameCount(U32 animationID) const;
 
@@ -66,6 +90,13 @@ BEGIN_COMPONENT(Animation, ComponentType::ANIMATION)
 
     [[nodiscard]] const vector<Line>& skeletonLines() const;
     [[nodiscard]] ShaderBuffer* getBoneBuffer() const;
+    /// True if the animator samples animations at runtime. The bone buffer then only holds this instance's current pose
+    [[nodiscard]] bool samplesPose() const noexcept;
+    /// Uploads the pose sampled during the last update, if it changed since the previous upload
+    void uploadPose(GFX::MemoryBarrierCommand& memCmdInOut);
+    /// While not empty, drives this instance's pose instead of the current animation. SAMPLED storage mode only.
+    /// Graph time is this component's animation time stamp (in seconds)
+    [[nodiscard]] AnimationBlendGraph& blendGraph() noexcept { return _blendGraph; }
     
     [[nodiscard]] AnimEvaluator& getAnimationByIndex(U32 animationID) const;
 
@@ -88,6 +119,8 @@ BEGIN_COMPONENT(Animation, ComponentType::ANIMATION)
     PROPERTY_RW(U32, previousAnimationIndex, U32_MAX);
 
     PROPERTY_RW(bool, applyAnimationChangeToAllMeshes, true);
+    /// Tier picked during the last AnimationSystem update
+    PROPERTY_R(AnimationLODTier, lodTier, AnimationLODTier::FULL);
 
                   void playAnimations(const bool state)       noexcept { _playAnimations = state;}
     [[nodiscard]] bool playAnimations()                 const noexcept { return _playAnimations && s_globalAnimationState; }
@@ -96,6 +129,12 @@ BEGIN_COMPONENT(Animation, ComponentType::ANIMATION)
     static void GlobalAnimationState(const bool state) noexcept { s_globalAnimationState = state; }
     [[nodiscard]] static bool GlobalAnimationState() noexcept { return s_globalAnimationState; }
 
+   protected:
+    void samplePose(D64 timeStampSec);
+    /// Returns the time stamp to sample at: the cross-fade's target animation restarts the component's timeline once the fade completes
+    [[nodiscard]] D64 updateCrossFade(D64 timeStampSec);
+    void cancelCrossFade();
+
    protected:
     AnimEvaluator::FrameIndex _frameIndex = {};
     /// Current animation timestamp for the current SGN
@@ -106,6 +145,23 @@ BEGIN_COMPONENT(Animation, ComponentType::ANIMATION)
     PROPERTY_R(D64, parentTimeStamp, 0.);
 
     bool _playAnimations = true;
+    /// Set by the AnimationSystem if this instance was updated during the current frame
+    bool _updatedThisFrame = false;
+    /// Bones deeper than this keep their last sampled pose when sampling (set by the AnimationSystem based on lodTier)
+    U8 _maxBoneDepth = U8_MAX;
+
+    /// SAMPLED storage mode only
+    AnimationPose _pose;
+    BoneQuaternions _poseQuaternions;
+    ShaderBuffer_uptr _poseBuffer = nullptr;
+    std::atomic_bool _poseDirty{ false };
+    AnimationBlendGraph _blendGraph;
+    vector<AnimationPose> _blendScratchPoses;
+
+    U32 _crossFadeTarget = U32_MAX;
+    U16 _crossFadeNode = AnimationBlendNode::INVALID_INPUT;
+    D64 _crossFadeStartS = 0.0;
+    D64 _crossFadeDurationS = 0.0;
 
     bool _animationStateChanged = false;
     bool _resyncAllSiblings = false;
@@ -44,13 +44,12 @@ BEGIN_COMPONENT_EXT1(Bounds, ComponentType::BOUNDS, GUIDWrapper)
         BoundsComponent(SceneGraphNode* sgn, PlatformContext& context);
 
         [[nodiscard]] const BoundingBox& getBoundingBox() const noexcept { return _boundingBox; }
-        [[nodiscard]] const BoundingSphere& getBoundingSphere() const noexcept { return _boundingSphere; }
+        /// Computed from the bounding box on first use after a bounds update
+        [[nodiscard]] const BoundingSphere& getBoundingSphere() const;
 
+        /// Computed on first use after a bounds update
         [[nodiscard]] const OBB& getOBB();
 
-        void updateBoundingBoxTransform();
-        void appendChildBBs();
-        void appendChildRefBBs();
         [[nodiscard]] FORCE_INLINE bool isClean() const noexcept { return _transformUpdatedMask.load() == 0u; }
 
         PROPERTY_RW(bool, collisionsEnabled, true);
@@ -66,7 +65,9 @@ BEGIN_COMPONENT_EXT1(Bounds, ComponentType::BOUNDS, GUIDWrapper)
 
         void OnData(const ECS::CustomEvent& data) override;
 
-        void setRefBoundingBox(const BoundingBox& nodeBounds) noexcept;
+        /// Recomputes the world bounding box (and the reference one if the scene node's bounds changed) from our own bounds and those of our children.
+        /// Children must already be up to date. Called by BoundsSystem, bottom-up
+        void updateBounds();
 
         // Flag the current BB as dirty and also flag all of the parents' bbs as dirty as well
         void flagBoundingBoxDirty(U32 transformMask, bool recursive);
@@ -75,10 +76,16 @@ BEGIN_COMPONENT_EXT1(Bounds, ComponentType::BOUNDS, GUIDWrapper)
         std::atomic_uint _transformUpdatedMask;
         BoundingBox _boundingBox{};
         BoundingBox _refBoundingBox{};
-        BoundingSphere _boundingSphere{};
+        mutable BoundingSphere _boundingSphere{};
         OBB _obb{};
         mat4<F32> _lastTransform{MAT4_IDENTITY};
+        mutable Mutex _lazyBoundsLock;
+        mutable std::atomic_bool _sphereDirty = false;
         std::atomic_bool _obbDirty = false;
+        /// Scene node bounds changed, so the reference box needs rebuilding. Only touched by BoundsSystem
+        bool _refDirty = false;
+        /// Depth in BoundsSystem's dirty set for the current update. U32_MAX if not queued
+        U32 _dirtyDepth = U32_MAX;
 
 
 END_COMPONENT(Bounds)
@@ -37,6 +37,8 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "SGNComponent.h"
 
 #include "Networking/Headers/NetworkPacket.h"
+#include "Networking/Headers/DeltaCodec.h"
+#include "Networking/Headers/SnapshotInterpolation.h"
 
 namespace Divide {
 
@@ -52,23 +54,48 @@ public:
     ~NetworkingComponent() override;
 
     void onNetworkSend(U32 frameCountIn);
+    /// Reads an entity update relayed by the server. The read position of dataIn must be right after the header fields (source ID, GUID, frame count and server time).
+    /// The transform isn't applied here: it gets buffered and shows up in updateTransform(). Returns false if the update was stale or encoded against a baseline we don't have.
+    /// On success, sequenceOut is what we acknowledge to the server
+    [[nodiscard]] bool onNetworkReceive(Networking::NetworkPacket& dataIn, U64 serverTimeUS, U32& sequenceOut);
+    /// The server received the state with this sequence number, so we can use it as a baseline. Only the entity's owner gets these
+    void onNetworkAck(U32 sequence) noexcept;
+    /// The server started (or stopped) sending us updates for this entity. A new stream starts with a full state
+    void onNetworkRelevancy(bool relevant) noexcept;
+    /// Once per frame: remote entities get their transform sampled at renderTimeUS (server time), locally owned ones blend in any pending correction
+    void updateTransform(U64 renderTimeUS, U64 elapsedUS, const Networking::InterpolationSettings& settings);
 
     void flagDirty(U32 srcClientID, U32 frameCount) noexcept;
 
     static NetworkingComponent* GetReceiver(I64 guid);
 
 private:
-    void onNetworkReceive(Networking::NetworkPacket& dataIn);
+    /// Full (uncompressed) replicated state: transform followed by whatever the scene node wants to send
+    void writeState(ByteBuffer& stateOut) const;
+    /// Returns true if the state had a transform
+    [[nodiscard]] bool readState(ByteBuffer& stateIn, TransformValues& transformOut) const;
 
-private:
-    [[nodiscard]] Networking::NetworkPacket deltaCompress(const Networking::NetworkPacket& crt, const Networking::NetworkPacket& previous) const;
-    [[nodiscard]] Networking::NetworkPacket deltaDecompress(const Networking::NetworkPacket& crt, const Networking::NetworkPacket& previous) const;
+    void deltaCompress(const ByteBuffer& crt, Networking::NetworkPacket& dataOut);
+    [[nodiscard]] bool deltaDecompress(const Networking::NetworkPacket& dataIn, ByteBuffer& stateOut, U32& sequenceOut);
 
 private:
     Networking::Client& _parentClient;
 
-    Networking::NetworkPacket _previousSent{Networking::OPCodes::MSG_NOP};
-    Networking::NetworkPacket _previousReceived{Networking::OPCodes::MSG_NOP};
+    /// Baselines for the states we sent and received
+    Networking::DeltaEncoder _previousSent;
+    Networking::DeltaDecoder _previousReceived;
+
+    /// Received transforms of remote entities, waiting to be rendered
+    Networking::SnapshotBuffer _snapshots;
+    /// Received transforms of entities we simulate are corrections to our prediction
+    Networking::CorrectionBlender _correction;
+    /// Last transform we wrote for a remote entity, so we don't dirty the transform of entities that stand still
+    TransformValues _lastSampled;
+    /// The server accepted our updates for this entity
+    bool _locallyOwned{ false };
+
+    ByteBuffer _stateScratch;
+    ByteBuffer _deltaScratch;
 
     static hashMap<I64, NetworkingComponent*> s_NetComponents;
 END_COMPONENT(Networking);
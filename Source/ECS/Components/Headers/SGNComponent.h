@@ -45,7 +45,6 @@ namespace ECS
             AnimationUpdated,
             AnimationChanged,
             AnimationReSync,
-            RelationshipCacheInvalidated,
             BoundsUpdated,
             EntityPostLoad,
             EntityFlagChanged,
@@ -210,7 +210,11 @@ BEGIN_COMPONENT_EXT1(Transform, ComponentType::TRANSFORM, ITransform)
     NodeUsageContext _parentUsageContext;
 
     U32 _broadcastMask = 0u;
+    /// Position in TransformSystem's depth sorted hierarchy. U32_MAX until the system picks the component up
+    U32 _hierarchySlot = U32_MAX;
     bool _uniformScaled = true;
+    /// Set on parent changes so that TransformSystem knows to rebuild its hierarchy
+    std::atomic_bool _parentChanged{ false };
 
     mutable SharedMutex _lock{};
 
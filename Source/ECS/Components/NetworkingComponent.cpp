@@ -4,6 +4,7 @@
 
 #include "Graphs/Headers/SceneNode.h"
 #include "Graphs/Headers/SceneGraphNode.h"
+#include "ECS/Components/Headers/TransformComponent.h"
 
 #include "Networking/Headers/Client.h"
 
@@ -33,34 +34,124 @@ void NetworkingComponent::flagDirty([[maybe_unused]] const U32 srcClientID, [[ma
 
 }
 
-Networking::NetworkPacket NetworkingComponent::deltaCompress(const Networking::NetworkPacket& crt, [[maybe_unused]] const Networking::NetworkPacket& previous) const {
-    return crt;
+void NetworkingComponent::writeState(ByteBuffer& stateOut) const
+{
+    const TransformComponent* transform = _parentSGN->get<TransformComponent>();
+    stateOut << (transform != nullptr);
+    if (transform != nullptr)
+    {
+        Networking::WriteTransform(stateOut, transform->getLocalValues());
+    }
+
+    Attorney::SceneNodeNetworkComponent::onNetworkSend(_parentSGN, _parentSGN->getNode(), stateOut);
+}
+
+bool NetworkingComponent::readState(ByteBuffer& stateIn, TransformValues& transformOut) const
+{
+    bool hasTransform = false;
+    stateIn >> hasTransform;
+    if (hasTransform)
+    {
+        Networking::ReadTransform(stateIn, transformOut);
+    }
+
+    Attorney::SceneNodeNetworkComponent::onNetworkReceive(_parentSGN, _parentSGN->getNode(), stateIn);
+    return hasTransform;
 }
 
-Networking::NetworkPacket NetworkingComponent::deltaDecompress(const Networking::NetworkPacket& crt, [[maybe_unused]] const Networking::NetworkPacket& previous) const {
-    return crt;
+void NetworkingComponent::deltaCompress(const ByteBuffer& crt, Networking::NetworkPacket& dataOut)
+{
+    _deltaScratch.clear();
+    _previousSent.encode(crt, _deltaScratch);
+    dataOut.append(_deltaScratch.contents(), _deltaScratch.bufferSize());
+}
+
+bool NetworkingComponent::deltaDecompress(const Networking::NetworkPacket& dataIn, ByteBuffer& stateOut, U32& sequenceOut)
+{
+    const ByteBuffer& body = dataIn.body();
+    return _previousReceived.decode(body.contents() + body.rpos(), body.bufferSize(), stateOut, sequenceOut);
 }
 
 void NetworkingComponent::onNetworkSend(const U32 frameCountIn)
 {
+    _stateScratch.clear();
+    writeState(_stateScratch);
+
     Networking::NetworkPacket dataOut(Networking::OPCodes::CMSG_ENTITY_UPDATE);
     dataOut << _parentSGN->getGUID();
     dataOut << frameCountIn;
+    deltaCompress(_stateScratch, dataOut);
+
+    _parentClient.send(dataOut);
+}
 
-    Attorney::SceneNodeNetworkComponent::onNetworkSend(_parentSGN, _parentSGN->getNode(), dataOut);
+bool NetworkingComponent::onNetworkReceive(Networking::NetworkPacket& dataIn, const U64 serverTimeUS, U32& sequenceOut)
+{
+    if (!deltaDecompress(dataIn, _stateScratch, sequenceOut))
+    {
+        return false;
+    }
 
-    const Networking::NetworkPacket p = deltaCompress(dataOut, _previousSent);
-    _previousSent = p;
+    TransformValues values{};
+    if (readState(_stateScratch, values))
+    {
+        if (_locallyOwned)
+        {
+            const TransformComponent* transform = _parentSGN->get<TransformComponent>();
+            if (transform != nullptr)
+            {
+                _correction.setCorrection(transform->getLocalValues(), values);
+            }
+        }
+        else
+        {
+            [[maybe_unused]] const bool buffered = _snapshots.push(serverTimeUS, values);
+        }
+    }
 
-    _parentClient.send(dataOut);
+    return true;
+}
+
+void NetworkingComponent::onNetworkAck(const U32 sequence) noexcept
+{
+    _previousSent.onAck(sequence);
+    _locallyOwned = true;
 }
 
-void NetworkingComponent::onNetworkReceive(Networking::NetworkPacket& dataIn)
+void NetworkingComponent::onNetworkRelevancy([[maybe_unused]] const bool relevant) noexcept
 {
-    const Networking::NetworkPacket p = deltaDecompress(dataIn, _previousReceived);
-    _previousReceived = p;
+    _previousReceived.reset();
+    _snapshots.clear();
+    // The server never replicates an entity back to its owner, so somebody else has it now
+    _locallyOwned = false;
+    _correction.reset();
+}
+
+void NetworkingComponent::updateTransform(const U64 renderTimeUS, const U64 elapsedUS, const Networking::InterpolationSettings& settings)
+{
+    TransformComponent* transform = _parentSGN->get<TransformComponent>();
+    if (transform == nullptr)
+    {
+        return;
+    }
 
-    Attorney::SceneNodeNetworkComponent::onNetworkReceive(_parentSGN, _parentSGN->getNode(), dataIn);
+    TransformValues values{};
+    if (_locallyOwned)
+    {
+        if (_correction.active())
+        {
+            values = transform->getLocalValues();
+            if (_correction.apply(elapsedUS, settings, values))
+            {
+                transform->setTransform(values);
+            }
+        }
+    }
+    else if (_snapshots.sample(renderTimeUS, settings, values) != Networking::SnapshotBuffer::SampleResult::EMPTY && values != _lastSampled)
+    {
+        transform->setTransform(values);
+        _lastSampled = values;
+    }
 }
 
 NetworkingComponent* NetworkingComponent::GetReceiver(const I64 guid)
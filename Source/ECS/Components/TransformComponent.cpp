@@ -494,6 +494,8 @@ namespace Divide
 
     void TransformComponent::onParentChanged(const SceneGraphNode* oldParent, const SceneGraphNode* newParent)
     {
+        _parentChanged.store(true);
+
         // This tries to keep the object's global transform intact when switching from one parent to another
 
         // Step 1: Embed parent transform into ourselves
@@ -4,14 +4,131 @@
 
 #include "Graphs/Headers/SceneGraphNode.h"
 #include "Geometry/Animations/Headers/SceneAnimator.h"
+#include "Managers/Headers/ProjectManager.h"
+#include "Core/Headers/Kernel.h"
+#include "Core/Headers/PlatformContext.h"
 
 namespace Divide {
+    namespace
+    {
+        /// Sampling and skinning a single instance is fairly expensive, so keep the partitions small
+        constexpr U32 g_parallelPartitionSize = 16u;
+
+        /// Sub-meshes of the same mesh share an LoD tier and update phase. Otherwise parts of the same character could end up in different poses
+        [[nodiscard]] const SceneGraphNode* LoDGroupNode(const SceneGraphNode* node) noexcept
+        {
+            const SceneGraphNode* ret = node;
+            while (ret->parent() != nullptr && ret->getNode().type() != SceneNodeType::TYPE_MESH)
+            {
+                ret = ret->parent();
+            }
+
+            return ret->getNode().type() == SceneNodeType::TYPE_MESH ? ret : node;
+        }
+    }
+
+    AnimationLODPolicy::AnimationLODPolicy(const Configuration::Rendering& config) noexcept
+        : _distanceThresholds(config.animationLODThresholds)
+        , _reducedBoneDepth(config.animationLODBoneDepth)
+        , _enabled(config.animationLOD)
+    {
+    }
+
+    AnimationLODTier AnimationLODPolicy::tier(const bool visible, const F32 distanceToCameraSq) const noexcept
+    {
+        if (!_enabled)
+        {
+            return AnimationLODTier::FULL;
+        }
+
+        if (!visible)
+        {
+            return AnimationLODTier::INVISIBLE;
+        }
+
+        if (distanceToCameraSq <= to_F32(SQUARED(_distanceThresholds.x)))
+        {
+            return AnimationLODTier::FULL;
+        }
+
+        return distanceToCameraSq <= to_F32(SQUARED(_distanceThresholds.y)) ? AnimationLODTier::HALF_RATE : AnimationLODTier::QUARTER_RATE;
+    }
+
+    U8 AnimationLODPolicy::maxBoneDepth(const AnimationLODTier tier) const noexcept
+    {
+        return tier == AnimationLODTier::QUARTER_RATE ? _reducedBoneDepth : U8_MAX;
+    }
+
+    U32 AnimationLODPolicy::UpdateInterval(const AnimationLODTier tier) noexcept
+    {
+        switch (tier)
+        {
+            case AnimationLODTier::FULL:         return 1u;
+            case AnimationLODTier::HALF_RATE:    return 2u;
+            case AnimationLODTier::QUARTER_RATE: return 4u;
+            case AnimationLODTier::INVISIBLE:    return 4u;
+
+            default:
+            case AnimationLODTier::COUNT: DIVIDE_UNEXPECTED_CALL(); break;
+        }
+
+        return 1u;
+    }
+
+    bool AnimationLODPolicy::ShouldUpdate(const AnimationLODTier tier, const U64 updateIndex, const U64 phase) noexcept
+    {
+        return (updateIndex + phase) % UpdateInterval(tier) == 0u;
+    }
+
+    AnimationLODUpdate AnimationLODPolicy::update(const AnimationLODTier previousTier, const bool visible, const F32 distanceToCameraSq, const bool forceUpdate, const U64 updateIndex, const U64 phase) const noexcept
+    {
+        AnimationLODUpdate ret{};
+        ret._tier = tier(visible, distanceToCameraSq);
+
+        // The pose of an instance that was missing from the previous DISPLAY pass may be a few updates old, so catch up as soon as it is on screen.
+        // Deeper bones keep whatever the previous sample left in the pose, which is only fine if that was the same animation at a recent time
+        if (forceUpdate || (previousTier == AnimationLODTier::INVISIBLE && ret._tier != AnimationLODTier::INVISIBLE))
+        {
+            return ret;
+        }
+
+        ret._update = ShouldUpdate(ret._tier, updateIndex, phase);
+        ret._maxBoneDepth = maxBoneDepth(ret._tier);
+        return ret;
+    }
+
     AnimationSystem::AnimationSystem(ECS::ECSEngine& parentEngine, PlatformContext& context)
         : PlatformContextComponent(context)
         , ECSSystem(parentEngine)
+        , _lodPolicy(context.config().rendering)
     {
     }
 
+    void AnimationSystem::gatherVisibleMeshes()
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+        _visibleMeshes.clear();
+
+        // Rendering happens after the scene update, so this is the previous frame's DISPLAY pass. Instances that are only in shadow or reflection
+        // passes are missing from it, which is why INVISIBLE instances still update (at a reduced rate, with every bone)
+        const VisibleNodeList<>& visibleNodes = _context.kernel().projectManager()->getRenderedNodeList();
+        for (size_t i = 0u; i < visibleNodes.size(); ++i)
+        {
+            const VisibleNode& node = visibleNodes.node(i);
+            if (!node._node->HasComponents(ComponentType::ANIMATION))
+            {
+                continue;
+            }
+
+            const auto [it, inserted] = _visibleMeshes.emplace(LoDGroupNode(node._node)->getGUID(), node._distanceToCameraSq);
+            if (!inserted)
+            {
+                it->second = std::min(it->second, node._distanceToCameraSq);
+            }
+        }
+    }
+
     void AnimationSystem::PreUpdate(const F32 dt)
     {
         PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
@@ -35,15 +152,47 @@ namespace Divide {
 
         Parent::Update(dt);
 
+        _sampledComponents.resize(0);
+        _lodStats = {};
+        ++_updateIndex;
+
+        gatherVisibleMeshes();
+
         for (AnimationComponent* comp : _componentCache)
         {
+            comp->_updatedThisFrame = false;
+
             const SceneAnimator* animator = comp->animator();
 
             if (!animator || COMPARE(comp->_parentTimeStamp, comp->_currentTimeStamp))
             {
-                return;
+                continue;
             }
 
+            const SceneGraphNode* groupNode = LoDGroupNode(comp->parentSGN());
+            const auto visibleIt = _visibleMeshes.find(groupNode->getGUID());
+            const bool visible = visibleIt != _visibleMeshes.cend();
+
+            // Skipped instances keep advancing their time stamp in PreUpdate, so whenever they do update they jump straight to the right pose
+            const bool forceUpdate = comp->_currentTimeStamp < 0.0 || comp->animationIndex() != comp->previousAnimationIndex();
+            const AnimationLODUpdate lod = _lodPolicy.update(comp->lodTier(),
+                                                             visible,
+                                                             visible ? visibleIt->second : F32_MAX,
+                                                             forceUpdate,
+                                                             _updateIndex,
+                                                             to_U64(groupNode->getGUID()));
+            comp->_lodTier = lod._tier;
+
+            if (!lod._update)
+            {
+                ++_lodStats._skipped[to_base(comp->lodTier())];
+                continue;
+            }
+
+            ++_lodStats._updated[to_base(comp->lodTier())];
+            comp->_updatedThisFrame = true;
+            comp->_maxBoneDepth = lod._maxBoneDepth;
+
             comp->_currentTimeStamp = comp->_parentTimeStamp;
             const D64 timeStampSec = Time::MillisecondsToSeconds<D64>(comp->_currentTimeStamp);
 
@@ -51,6 +200,10 @@ namespace Divide {
             {
                 // Update Animations
                 comp->_frameIndex = animator->frameIndexForTimeStamp(comp->animationIndex(), timeStampSec, !comp->playInReverse());
+                if (animator->storageMode() == AnimationStorageMode::SAMPLED)
+                {
+                    _sampledComponents.push_back(comp);
+                }
 
                 if (comp->animationIndex() != comp->previousAnimationIndex() && comp->animationIndex() != U32_MAX)
                 {
@@ -71,6 +224,30 @@ namespace Divide {
                 /// And read back ragdoll results to update transforms accordingly
             //}
         }
+
+        // Group instances that share an animator (and thus a skeleton and its compressed animations) so that every partition
+        // keeps working on the same data. Every instance only writes to its own pose, so they can all be evaluated in parallel
+        eastl::sort(_sampledComponents.begin(),
+                    _sampledComponents.end(),
+                    [](const AnimationComponent* lhs, const AnimationComponent* rhs) noexcept
+                    {
+                        return lhs->animator() < rhs->animator();
+                    });
+
+        Parallel_For( _context.taskPool( TaskPoolType::HIGH_PRIORITY ),
+                      ParallelForDescriptor
+                      {
+                          ._iterCount = to_U32(_sampledComponents.size()),
+                          ._partitionSize = g_parallelPartitionSize
+                      },
+                      [this](const Task*, const U32 start, const U32 end)
+                      {
+                          for (U32 i = start; i < end; ++i)
+                          {
+                              AnimationComponent* comp = _sampledComponents[i];
+                              comp->samplePose(Time::MillisecondsToSeconds<D64>(comp->_currentTimeStamp));
+                          }
+                      });
     }
 
     void AnimationSystem::PostUpdate(const F32 dt)
@@ -78,7 +255,7 @@ namespace Divide {
         Parent::PostUpdate(dt);
         for (AnimationComponent* const comp : _componentCache)
         {
-            if (comp->frameTicked())
+            if (comp->_updatedThisFrame && comp->frameTicked())
             {
                 comp->parentSGN()->SendEvent(
                     ECS::CustomEvent
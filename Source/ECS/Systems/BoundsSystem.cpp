@@ -15,6 +15,11 @@
 
 namespace Divide
 {
+    namespace
+    {
+        constexpr U32 g_parallelPartitionSize = 128u;
+    }
+
     BoundsSystem::BoundsSystem(ECS::ECSEngine& parentEngine, PlatformContext& context)
         : PlatformContextComponent(context),
           ECSSystem(parentEngine)
@@ -43,42 +48,25 @@ namespace Divide
 
         for (BoundsComponent* bComp : _componentCache)
         {
-            if (Attorney::SceneNodeBoundsSystem::boundsChanged(bComp->parentSGN()->getNode()))
+            SceneNode& sceneNode = bComp->parentSGN()->getNode();
+            if (Attorney::SceneNodeBoundsSystem::boundsChanged(sceneNode))
             {
                 bComp->flagBoundingBoxDirty(to_U32(TransformType::ALL), false);
+                _changedSceneNodes.push_back(&sceneNode);
 
-                SceneGraphNode* parent = bComp->parentSGN()->parent();
-                while (parent != nullptr)
+                // Parent reference boxes include ours. Stop at the first one that is already flagged: everything above it is as well
+                for (BoundsComponent* it = bComp; it != nullptr && !it->_refDirty; it = BoundedParent(it))
                 {
-                    Attorney::SceneNodeBoundsSystem::setBoundsChanged(parent->getNode());
-                    parent = parent->parent();
+                    it->_refDirty = true;
                 }
             }
         }
     }
 
-    void BoundsSystem::Update(const F32 dt)
+    BoundsComponent* BoundsSystem::BoundedParent(const BoundsComponent* bComp)
     {
-        PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
-
-        Parent::Update(dt);
-        // This is fast and does not need to run in parallel
-        for (BoundsComponent* bComp : _componentCache)
-        {
-            const SceneNode& sceneNode = bComp->parentSGN()->getNode();
-            if (Attorney::SceneNodeBoundsSystem::boundsChanged(sceneNode))
-            {
-                bComp->setRefBoundingBox(sceneNode.getBounds());
-            }
-        }
-
-        for (BoundsComponent* bComp : _componentCache)
-        {
-            if (Attorney::SceneNodeBoundsSystem::boundsChanged(bComp->parentSGN()->getNode()))
-            {
-                bComp->appendChildRefBBs();
-            }
-        }
+        const SceneGraphNode* parent = bComp->parentSGN()->parent();
+        return parent != nullptr && parent->HasComponents(ComponentType::BOUNDS) ? parent->get<BoundsComponent>() : nullptr;
     }
 
     void BoundsSystem::PostUpdate(const F32 dt)
@@ -87,25 +75,61 @@ namespace Divide
 
         Parent::PostUpdate(dt);
 
+        const auto depthOf = [](BoundsComponent* bComp) noexcept -> U32&
+        {
+            return bComp->_dirtyDepth;
+        };
+
         for (BoundsComponent* bComp : _componentCache)
         {
-            bComp->updateBoundingBoxTransform();
+            if (!bComp->isClean() || bComp->_refDirty)
+            {
+                _dirtyQueue.push(bComp, &BoundedParent, depthOf);
+            }
         }
 
-        for (BoundsComponent* bComp : _componentCache)
+        // Bottom-up: every level only reads from the (already updated) level below it
+        _dirtyQueue.forEachLevelBottomUp([this](vector<BoundsComponent*>& components)
         {
-            bComp->appendChildBBs();
+            if (components.size() <= g_parallelPartitionSize)
+            {
+                for (BoundsComponent* bComp : components)
+                {
+                    bComp->updateBounds();
+                }
+                return;
+            }
+
+            Parallel_For( _context.taskPool( TaskPoolType::HIGH_PRIORITY ),
+                          ParallelForDescriptor
+                          {
+                              ._iterCount = to_U32(components.size()),
+                              ._partitionSize = g_parallelPartitionSize
+                          },
+                          [&components](const Task*, const U32 start, const U32 end)
+                          {
+                              for (U32 i = start; i < end; ++i)
+                              {
+                                  components[i]->updateBounds();
+                              }
+                          });
+        });
+
+        for (SceneNode* sceneNode : _changedSceneNodes)
+        {
+            Attorney::SceneNodeBoundsSystem::clearBoundsChanged(*sceneNode);
         }
+        _changedSceneNodes.resize(0);
 
-        for (BoundsComponent* bComp : _componentCache)
+        // Anything dirtied by the event handlers gets picked up next frame
+        _dirtyQueue.flush(depthOf, [](BoundsComponent* bComp)
         {
-            Attorney::SceneNodeBoundsSystem::clearBoundsChanged(bComp->parentSGN()->getNode());
             bComp->parentSGN()->SendEvent(
             {
                 ._type = ECS::CustomEvent::Type::BoundsUpdated,
                 ._sourceCmp = bComp,
             });
-        }
+        });
 
         for (BoundsComponent* bComp : _componentCache)
         {
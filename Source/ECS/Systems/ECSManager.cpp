@@ -3,6 +3,7 @@
 #include "Headers/ECSManager.h"
 #include "Headers/EnvironmentProbeSystem.h"
 #include "Headers/NavigationSystem.h"
+#include "Headers/NetworkingSystem.h"
 #include "Headers/RigidBodySystem.h"
 
 #include "ECS/Systems/Headers/AnimationSystem.h"
@@ -15,12 +16,12 @@
 #include "ECS/Systems/Headers/SpotLightSystem.h"
 
 #include "ECS/Components/Headers/IKComponent.h"
-#include "ECS/Components/Headers/NetworkingComponent.h"
 #include "ECS/Components/Headers/RagdollComponent.h"
 #include "ECS/Components/Headers/ScriptComponent.h"
 #include "ECS/Components/Headers/SelectionComponent.h"
 #include "ECS/Components/Headers/UnitComponent.h"
 
+#include "Core/Headers/PlatformContext.h"
 #include "Utility/Headers/Localization.h"
 
 #include <ECS/SystemManager.h>
@@ -35,14 +36,14 @@ namespace Divide {
     }
 
 STUB_SYSTEM(IK);
-STUB_SYSTEM(Networking);
 STUB_SYSTEM(Ragdoll);
 STUB_SYSTEM(Script);
 STUB_SYSTEM(Unit);
 
 ECSManager::ECSManager(PlatformContext& context, ECS::ECSEngine& engine)
     : PlatformContextComponent(context),
-      _ecsEngine(engine)
+      _ecsEngine(engine),
+      _systemScheduler(*engine.GetSystemManager(), context.taskPool(TaskPoolType::HIGH_PRIORITY))
 {
     auto* TSys = _ecsEngine.GetSystemManager()->AddSystem<TransformSystem>(_ecsEngine, _context);
     auto* ASys = _ecsEngine.GetSystemManager()->AddSystem<AnimationSystem>(_ecsEngine, _context);
@@ -53,7 +54,7 @@ ECSManager::ECSManager(PlatformContext& context, ECS::ECSEngine& engine)
     auto* DlSys = _ecsEngine.GetSystemManager()->AddSystem<DirectionalLightSystem>(_ecsEngine, _context);
     auto* IKSys = _ecsEngine.GetSystemManager()->AddSystem<IKSystem>(_ecsEngine);
     auto* NavSys = _ecsEngine.GetSystemManager()->AddSystem<NavigationSystem>(_ecsEngine, _context);
-    auto* NetSys = _ecsEngine.GetSystemManager()->AddSystem<NetworkingSystem>(_ecsEngine);
+    auto* NetSys = _ecsEngine.GetSystemManager()->AddSystem<NetworkingSystem>(_ecsEngine, _context);
     auto* RagSys = _ecsEngine.GetSystemManager()->AddSystem<RagdollSystem>(_ecsEngine);
     auto* RBSys = _ecsEngine.GetSystemManager()->AddSystem<RigidBodySystem>(_ecsEngine, _context);
     auto* ScpSys = _ecsEngine.GetSystemManager()->AddSystem<ScriptSystem>(_ecsEngine);
@@ -78,7 +79,28 @@ ECSManager::ECSManager(PlatformContext& context, ECS::ECSEngine& engine)
     SelSys->AddDependencies(UnitSys);
     ProbeSys->AddDependencies(UnitSys);
 
+    // Every system writes its own component type. These are the extra types they read while updating,
+    // used by the scheduler to decide which systems can update concurrently. Systems missing from this list update exclusively
+    ASys->ReadsComponents<TransformComponent>();
+    BSys->ReadsComponents<TransformComponent, AnimationComponent>();
+    RSys->ReadsComponents<TransformComponent, BoundsComponent, AnimationComponent>();
+    PlSys->ReadsComponents<TransformComponent, BoundsComponent>();
+    SlSys->ReadsComponents<TransformComponent, BoundsComponent>();
+    DlSys->ReadsComponents<TransformComponent, BoundsComponent>();
+    ProbeSys->ReadsComponents<TransformComponent>();
+    NavSys->ReadsComponents<TransformComponent>();
+    UnitSys->ReadsComponents<TransformComponent>();
+    IKSys->ReadsComponents<AnimationComponent>();
+    RagSys->ReadsComponents<AnimationComponent>();
+    RBSys->ReadsComponents<TransformComponent>();
+
     _ecsEngine.GetSystemManager()->UpdateSystemWorkOrder();
+    _ecsEngine.GetSystemManager()->SetSystemScheduler(&_systemScheduler);
+}
+
+ECSManager::~ECSManager()
+{
+    _ecsEngine.GetSystemManager()->SetSystemScheduler(nullptr);
 }
 
 bool ECSManager::saveCache(const SceneGraphNode* sgn, ByteBuffer& outputBuffer) const
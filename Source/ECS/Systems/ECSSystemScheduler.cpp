@@ -0,0 +1,124 @@
+
+
+#include "Headers/ECSSystemScheduler.h"
+
+#include "Core/Time/Headers/ApplicationTimer.h"
+
+namespace Divide {
+
+    ECSSystemScheduler::ECSSystemScheduler( ECS::SystemManager& systemManager, TaskPool& pool )
+        : _systemManager( systemManager )
+        , _pool( pool )
+    {
+    }
+
+    void ECSSystemScheduler::OnSystemWorkOrderChanged()
+    {
+        const ECS::SystemManager::SystemWorkOrder& workOrder = _systemManager.GetSystemWorkOrder();
+        DIVIDE_ASSERT( workOrder.size() < TaskGraph::INVALID_NODE, "ECSSystemScheduler error: too many systems registered!" );
+
+        _systems.assign( workOrder.begin(), workOrder.end() );
+
+        _systemTimings.resize( _systems.size() );
+        for ( size_t i = 0u; i < _systems.size(); ++i )
+        {
+            _systemTimings[i]._name = _systems[i]->GetSystemTypeName();
+        }
+        resetTimings();
+
+        _updateGraph.clear();
+
+        const size_t systemCount = _systems.size();
+        for ( size_t i = 0u; i < systemCount; ++i )
+        {
+            _updateGraph.addNode( [this, i]()
+            {
+                updateSystem( i );
+            });
+        }
+
+        // The work order is already a valid topological order, so always pointing edges from the earlier system to the later one
+        // keeps the graph acyclic and conflicting systems update in the same order they did when running serially
+        for ( size_t i = 0u; i < systemCount; ++i )
+        {
+            const ECS::ISystem* earlier = _systems[i];
+            for ( size_t j = i + 1u; j < systemCount; ++j )
+            {
+                const ECS::ISystem* later = _systems[j];
+
+                if ( _systemManager.HasSystemDependency( later, earlier ) ||
+                     _systemManager.HasSystemDependency( earlier, later ) ||
+                     !earlier->HasDeclaredComponentAccess() ||
+                     !later->HasDeclaredComponentAccess() ||
+                     earlier->ConflictsWith( *later ) )
+                {
+                    _updateGraph.addDependency( to_U16( i ), to_U16( j ) );
+                }
+            }
+        }
+    }
+
+    void ECSSystemScheduler::RunStage( const ECS::SystemStage stage, const F32 dt_ms )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::GameLogic );
+
+        _activeStage = stage;
+        _activeDeltaMS = dt_ms;
+
+        const U64 startTimeUS = to_U64( Time::App::ElapsedMicroseconds() );
+        if ( _parallelUpdate )
+        {
+            _updateGraph.run( _pool );
+        }
+        else
+        {
+            for ( size_t i = 0u; i < _systems.size(); ++i )
+            {
+                updateSystem( i );
+            }
+        }
+        const U64 wallTimeUS = to_U64( Time::App::ElapsedMicroseconds() ) - startTimeUS;
+
+        const size_t stageIndex = to_base( stage );
+
+        U64 systemTimeUS = 0u;
+        for ( const SystemTimings& timings : _systemTimings )
+        {
+            systemTimeUS += timings._lastUS[stageIndex];
+        }
+
+        StageTimings& stageTimings = _stageTimings[stageIndex];
+        stageTimings._lastWallUS = wallTimeUS;
+        stageTimings._lastSystemUS = systemTimeUS;
+        stageTimings._totalWallUS += wallTimeUS;
+        stageTimings._totalSystemUS += systemTimeUS;
+        ++stageTimings._runCount;
+
+        _activeStage = ECS::SystemStage::COUNT;
+    }
+
+    void ECSSystemScheduler::updateSystem( const size_t systemIndex )
+    {
+        const size_t stageIndex = to_base( _activeStage );
+
+        const U64 startTimeUS = to_U64( Time::App::ElapsedMicroseconds() );
+        _systemManager.UpdateSystem( _systems[systemIndex], _activeStage, _activeDeltaMS );
+        const U64 durationUS = to_U64( Time::App::ElapsedMicroseconds() ) - startTimeUS;
+
+        // Each system only ever runs on one thread at a time and the graph finishing synchronises with the caller, so no atomics needed here
+        SystemTimings& timings = _systemTimings[systemIndex];
+        timings._lastUS[stageIndex] = durationUS;
+        timings._totalUS[stageIndex] += durationUS;
+    }
+
+    void ECSSystemScheduler::resetTimings() noexcept
+    {
+        for ( SystemTimings& timings : _systemTimings )
+        {
+            timings._lastUS.fill( 0u );
+            timings._totalUS.fill( 0u );
+        }
+        _stageTimings.fill( {} );
+    }
+
+} //namespace Divide
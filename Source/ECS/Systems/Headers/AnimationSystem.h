@@ -34,10 +34,55 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define DVD_ANIMATION_SYSTEM_H_
 
 #include "ECSSystem.h"
+#include "Core/Headers/Configuration.h"
 #include "Core/Headers/PlatformContextComponent.h"
 #include "ECS/Components/Headers/AnimationComponent.h"
 
 namespace Divide {
+    /// What the AnimationSystem does with an instance during a single update
+    struct AnimationLODUpdate
+    {
+        AnimationLODTier _tier = AnimationLODTier::FULL;
+        /// Bones deeper than this keep their last sampled pose
+        U8 _maxBoneDepth = U8_MAX;
+        /// False if the instance skips this update
+        bool _update = true;
+    };
+
+    /// Picks an instance's AnimationLODTier from its visibility and distance to the camera
+    struct AnimationLODPolicy
+    {
+        AnimationLODPolicy() = default;
+        explicit AnimationLODPolicy(const Configuration::Rendering& config) noexcept;
+
+        /// Distances to the camera (not squared) past which instances drop to HALF_RATE and QUARTER_RATE respectively
+        vec2<U16> _distanceThresholds = { 30u, 80u };
+        /// Bones deeper than this in the hierarchy keep their last sampled pose at QUARTER_RATE
+        U8 _reducedBoneDepth = U8_MAX;
+        /// If false, every instance updates at FULL rate
+        bool _enabled = false;
+
+        [[nodiscard]] AnimationLODTier tier(bool visible, F32 distanceToCameraSq) const noexcept;
+        [[nodiscard]] U8 maxBoneDepth(AnimationLODTier tier) const noexcept;
+
+        /// Everything the AnimationSystem decides for an instance with a new time stamp. forceUpdate is set for the first update and animation changes.
+        /// Forced updates and instances that just showed up in the DISPLAY pass don't wait for their turn and sample every bone
+        [[nodiscard]] AnimationLODUpdate update(AnimationLODTier previousTier, bool visible, F32 distanceToCameraSq, bool forceUpdate, U64 updateIndex, U64 phase) const noexcept;
+
+        /// Number of system updates between two updates of an instance in the given tier
+        [[nodiscard]] static U32 UpdateInterval(AnimationLODTier tier) noexcept;
+        /// Instances in the same tier are spread over the tier's interval by their phase, so they don't all update during the same frame
+        [[nodiscard]] static bool ShouldUpdate(AnimationLODTier tier, U64 updateIndex, U64 phase) noexcept;
+    };
+
+    struct AnimationLODStats
+    {
+        /// Instances updated during the last system update, per AnimationLODTier
+        std::array<U32, to_base(AnimationLODTier::COUNT)> _updated{};
+        /// Instances that had a new time stamp during the last system update but were skipped because of their tier
+        std::array<U32, to_base(AnimationLODTier::COUNT)> _skipped{};
+    };
+
     class AnimationSystem final : public PlatformContextComponent,
                                   public ECSSystem<AnimationSystem, AnimationComponent> {
         using Parent = ECSSystem<AnimationSystem, AnimationComponent>;
@@ -53,6 +98,23 @@ namespace Divide {
 
         void toggleAnimationState(bool state) noexcept;
         [[nodiscard]] bool getAnimationState() const noexcept;
+
+        [[nodiscard]] const AnimationLODStats& lodStats() const noexcept { return _lodStats; }
+        [[nodiscard]] AnimationLODPolicy& lodPolicy() noexcept { return _lodPolicy; }
+
+      private:
+        /// Gathers the closest distance to the camera of every animated mesh the last DISPLAY pass rendered
+        void gatherVisibleMeshes();
+
+      private:
+        AnimationLODPolicy _lodPolicy;
+        AnimationLODStats _lodStats;
+        /// Root mesh node GUID -> closest squared distance to the camera of any of its visible animated sub-meshes
+        hashMap<I64, F32> _visibleMeshes;
+        U64 _updateIndex = 0u;
+
+        /// Components that sample their pose at runtime this frame, sorted by animator
+        vector<AnimationComponent*> _sampledComponents;
     };
 }
 
@@ -34,6 +34,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define DVD_BOUNDS_SYSTEM_H_
 
 #include "ECSSystem.h"
+#include "DirtyLevelQueue.h"
 
 #include "Core/Headers/PlatformContextComponent.h"
 #include "ECS/Components/Headers/BoundsComponent.h"
@@ -48,10 +49,17 @@ public:
     virtual ~BoundsSystem() override;
 
     void PreUpdate(F32 dt) override;
-    void Update(F32 dt) override;
     void PostUpdate(F32 dt) override;
 
 private:
+    /// The bounds component of the parent node, if it has one
+    [[nodiscard]] static BoundsComponent* BoundedParent(const BoundsComponent* bComp);
+
+private:
+    /// Dirty components and their ancestors, grouped by depth. Processed deepest level first
+    DirtyLevelQueue<BoundsComponent> _dirtyQueue;
+    /// Scene nodes whose bounds changed this frame. Flags are cleared once every node using them got updated
+    vector<SceneNode*> _changedSceneNodes;
     bool _renderAABB{false};
     bool _renderOBB{false};
     bool _renderBS{false};
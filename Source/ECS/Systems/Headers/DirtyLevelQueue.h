@@ -0,0 +1,76 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_DIRTY_LEVEL_QUEUE_H_
+#define DVD_DIRTY_LEVEL_QUEUE_H_
+
+namespace Divide
+{
+
+/// Collects the dirty nodes of a hierarchy together with every ancestor they affect and groups them by depth, so that data aggregated
+/// from children (e.g. bounds that enclose a whole subtree) can be rebuilt bottom-up, one level at a time. Nodes on the same level never
+/// depend on each other, so a level may be processed in parallel. A node is only queued once per pass, no matter how many of its descendants are dirty.
+/// The queue keeps no per node state of its own: depthOf(node) must return a reference to a U32 stored with each node that reads INVALID_DEPTH while it isn't queued.
+template<typename T>
+class DirtyLevelQueue
+{
+  public:
+    static constexpr U32 INVALID_DEPTH = U32_MAX;
+
+    /// Queues node and each of its ancestors that isn't already queued. parentOf(node) returns the node's parent, or nullptr if there is none
+    template<typename ParentFunc, typename DepthFunc>
+    void push( T* node, ParentFunc&& parentOf, DepthFunc&& depthOf );
+
+    /// Calls cbk(vector<T*>& level) for every level, deepest first
+    template<typename Callback>
+    void forEachLevelBottomUp( Callback&& cbk );
+
+    /// Marks every queued node as no longer queued, calls cbk(node) for it and empties the queue.
+    /// cbk must not push: nodes dirtied from within it should be queued for the next pass
+    template<typename DepthFunc, typename Callback>
+    void flush( DepthFunc&& depthOf, Callback&& cbk );
+
+    [[nodiscard]] size_t size() const noexcept { return _count; }
+    [[nodiscard]] size_t levelCount() const noexcept { return _levels.size(); }
+
+  private:
+    vector<vector<T*>> _levels;
+    /// Scratch space for push
+    vector<T*> _chain;
+    size_t _count{ 0u };
+};
+
+} //namespace Divide
+
+#endif //DVD_DIRTY_LEVEL_QUEUE_H_
+
+#include "DirtyLevelQueue.inl"
@@ -0,0 +1,116 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef DVD_DIRTY_LEVEL_QUEUE_INL_
+#define DVD_DIRTY_LEVEL_QUEUE_INL_
+
+namespace Divide
+{
+
+template<typename T>
+template<typename ParentFunc, typename DepthFunc>
+void DirtyLevelQueue<T>::push( T* node, ParentFunc&& parentOf, DepthFunc&& depthOf )
+{
+    if ( depthOf( node ) != INVALID_DEPTH )
+    {
+        return;
+    }
+
+    // Walk up until we either run out of parents or hit one that is already queued (and thus has a known depth)
+    U32 depth = 0u;
+    for ( T* it = node; it != nullptr; )
+    {
+        _chain.push_back( it );
+
+        T* parent = parentOf( it );
+        it = nullptr;
+        if ( parent != nullptr )
+        {
+            if ( depthOf( parent ) != INVALID_DEPTH )
+            {
+                depth = depthOf( parent ) + 1u;
+            }
+            else
+            {
+                it = parent;
+            }
+        }
+    }
+
+    // Top-most first
+    for ( auto it = _chain.rbegin(); it != _chain.rend(); ++it )
+    {
+        depthOf( *it ) = depth;
+        if ( _levels.size() <= depth )
+        {
+            _levels.resize( depth + 1u );
+        }
+        _levels[depth].push_back( *it );
+        ++depth;
+    }
+
+    _count += _chain.size();
+    _chain.resize( 0 );
+}
+
+template<typename T>
+template<typename Callback>
+void DirtyLevelQueue<T>::forEachLevelBottomUp( Callback&& cbk )
+{
+    for ( auto level = _levels.rbegin(); level != _levels.rend(); ++level )
+    {
+        if ( !level->empty() )
+        {
+            cbk( *level );
+        }
+    }
+}
+
+template<typename T>
+template<typename DepthFunc, typename Callback>
+void DirtyLevelQueue<T>::flush( DepthFunc&& depthOf, Callback&& cbk )
+{
+    for ( vector<T*>& level : _levels )
+    {
+        for ( T* node : level )
+        {
+            depthOf( node ) = INVALID_DEPTH;
+            cbk( node );
+        }
+        level.resize( 0 );
+    }
+
+    _count = 0u;
+}
+
+} //namespace Divide
+
+#endif //DVD_DIRTY_LEVEL_QUEUE_INL_
@@ -33,6 +33,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define DVD_ECS_MANAGER_H_
 
 #include "ECS/Engine.h"
+#include "ECS/Systems/Headers/ECSSystemScheduler.h"
 #include "Core/Headers/PlatformContextComponent.h"
 
 namespace Divide {
@@ -41,11 +42,18 @@ namespace Divide {
     class ECSManager final : public PlatformContextComponent {
         public:
             ECSManager(PlatformContext& context, ECS::ECSEngine& engine);
+            ~ECSManager();
 
             [[nodiscard]] bool saveCache(const SceneGraphNode* sgn, ByteBuffer& outputBuffer) const;
             [[nodiscard]] bool loadCache(SceneGraphNode* sgn, ByteBuffer& inputBuffer) const;
 
+            [[nodiscard]] ECSSystemScheduler& systemScheduler() noexcept { return _systemScheduler; }
+            [[nodiscard]] const ECSSystemScheduler& systemScheduler() const noexcept { return _systemScheduler; }
+
             REFERENCE_R(ECS::ECSEngine, ecsEngine);
+
+        private:
+            ECSSystemScheduler _systemScheduler;
     };
 
     FWD_DECLARE_MANAGED_CLASS(ECSManager);
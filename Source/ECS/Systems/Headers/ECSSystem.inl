@@ -44,6 +44,7 @@ namespace Divide {
     {
         _serializer._parent = this;
         _componentCache.reserve(Config::MAX_VISIBLE_NODES);
+        this->template WritesComponents<U>();
     }
 
     template<class T, class U>
@@ -0,0 +1,103 @@
+/* Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+#ifndef DVD_ECS_SYSTEM_SCHEDULER_H_
+#define DVD_ECS_SYSTEM_SCHEDULER_H_
+
+#include "Platform/Threading/Headers/TaskGraph.h"
+
+#include <ECS/SystemManager.h>
+
+namespace Divide {
+
+    /// Updates ECS systems in parallel. Each stage (PreUpdate, Update, PostUpdate) runs as a TaskGraph with one node per system.
+    /// Two systems get an edge between them (in work order) if one depends on the other in the system manager's dependency matrix
+    /// or if their declared component accesses conflict (see ECS::ISystem::ConflictsWith). Everything else updates concurrently.
+    /// Systems that never declared their component reads get an edge to every other system, as they may touch anything.
+    class ECSSystemScheduler final : public ECS::ISystemScheduler, private NonCopyable
+    {
+      public:
+        static constexpr size_t STAGE_COUNT = to_base( ECS::SystemStage::COUNT );
+
+        struct SystemTimings
+        {
+            const char* _name{ nullptr };
+            /// Duration of the latest run of each stage, in microseconds
+            std::array<U64, STAGE_COUNT> _lastUS{};
+            /// Accumulated duration of each stage since the last call to resetTimings(), in microseconds
+            std::array<U64, STAGE_COUNT> _totalUS{};
+        };
+
+        struct StageTimings
+        {
+            /// Wall clock duration of the latest run
+            U64 _lastWallUS{ 0u };
+            /// Sum of every system's duration during the latest run. Divide this by _lastWallUS to get the speedup over a serial update
+            U64 _lastSystemUS{ 0u };
+            U64 _totalWallUS{ 0u };
+            U64 _totalSystemUS{ 0u };
+            U32 _runCount{ 0u };
+        };
+
+      public:
+        ECSSystemScheduler( ECS::SystemManager& systemManager, TaskPool& pool );
+
+        void RunStage( ECS::SystemStage stage, F32 dt_ms ) override;
+        void OnSystemWorkOrderChanged() override;
+
+        void resetTimings() noexcept;
+
+        /// Same order as the system manager's work order
+        [[nodiscard]] const vector<SystemTimings>& systemTimings() const noexcept { return _systemTimings; }
+        [[nodiscard]] const StageTimings& stageTimings( const ECS::SystemStage stage ) const noexcept { return _stageTimings[to_base( stage )]; }
+
+        /// If false, every stage updates all of the systems serially, in work order, on the calling thread. Timings are still gathered.
+        /// Off by default: access declarations don't capture side effects outside of components (scene graph, physics, networking, etc)
+        PROPERTY_RW( bool, parallelUpdate, false );
+
+      private:
+        void updateSystem( size_t systemIndex );
+
+      private:
+        ECS::SystemManager& _systemManager;
+        TaskPool& _pool;
+        TaskGraph _updateGraph;
+        vector<ECS::ISystem*> _systems;
+        vector<SystemTimings> _systemTimings;
+        std::array<StageTimings, STAGE_COUNT> _stageTimings{};
+        /// Only written while no graph is running
+        ECS::SystemStage _activeStage{ ECS::SystemStage::COUNT };
+        F32 _activeDeltaMS{ 0.f };
+    };
+
+} //namespace Divide
+
+#endif //DVD_ECS_SYSTEM_SCHEDULER_H_
@@ -0,0 +1,108 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_TRANSFORM_HIERARCHY_H_
+#define DVD_TRANSFORM_HIERARCHY_H_
+
+#include "Core/Math/Headers/TransformInterface.h"
+
+namespace Divide
+{
+
+class TaskPool;
+
+/// Local and world transforms for an entire node hierarchy, stored as structure-of-arrays and sorted by depth (breadth first).
+/// Every node's parent lives in an earlier level, so world transforms are computed one level at a time: each level is split across
+/// the task pool and processed 4 nodes at a time with SSE. Only nodes that changed (or have a changed ancestor) get their world matrix rebuilt.
+/// Nodes are referred to by "slot" (their position in the sorted arrays). build() maps the caller's indices to slots.
+class TransformHierarchy
+{
+  public:
+    static constexpr U32 INVALID_INDEX = U32_MAX;
+
+    /// parentIndices[i] is the index of node i's parent (in the same array) or INVALID_INDEX for roots. Marks every node as dirty
+    void build( const vector<U32>& parentIndices );
+    void clear();
+
+    /// Sets the node's local transform and flags its subtree for update.
+    /// If localRotations is true, the parent's rotation and scale don't affect the node's position (TransformComponent::RotationMode::LOCAL)
+    void setLocal( U32 slot, const TransformValues& values, bool localRotations ) noexcept;
+    /// Computes world transforms for every dirty subtree. Levels smaller than partitionSize are processed on the calling thread
+    void update( TaskPool* pool, U32 partitionSize );
+
+    [[nodiscard]] TransformValues localValues( U32 slot ) const noexcept;
+    [[nodiscard]] TransformValues worldValues( U32 slot ) const noexcept;
+    [[nodiscard]] const mat4<F32>& worldMatrix( U32 slot ) const noexcept { return _worldMatrices[slot]; }
+    /// True if the last update() recomputed this node's world transform
+    [[nodiscard]] bool worldChanged( U32 slot ) const noexcept { return (_flags[slot] & FLAG_CHANGED) != 0u; }
+
+    [[nodiscard]] U32 slot( const U32 index ) const noexcept { return _indexToSlot[index]; }
+    [[nodiscard]] U32 parentSlot( const U32 slot ) const noexcept { return _parents[slot]; }
+    [[nodiscard]] size_t size() const noexcept { return _parents.size(); }
+    [[nodiscard]] size_t levelCount() const noexcept { return _levelOffsets.empty() ? 0u : _levelOffsets.size() - 1u; }
+
+  private:
+    struct TRSArrays
+    {
+        vector<F32> _posX, _posY, _posZ;
+        vector<F32> _scaleX, _scaleY, _scaleZ;
+        vector<F32> _rotX, _rotY, _rotZ, _rotW;
+
+        void resize( size_t count );
+        void set( U32 slot, const TransformValues& values ) noexcept;
+        [[nodiscard]] TransformValues get( U32 slot ) const noexcept;
+    };
+
+    enum Flags : U8
+    {
+        FLAG_DIRTY = toBit( 1 ),
+        FLAG_CHANGED = toBit( 2 ),
+        FLAG_LOCAL_ROTATIONS = toBit( 3 )
+    };
+
+    /// Computes world transforms for slots [start, end). All of them must be on the same level
+    void updateRange( U32 start, U32 end ) noexcept;
+
+  private:
+    TRSArrays _local;
+    TRSArrays _world;
+    vector<mat4<F32>> _worldMatrices;
+    vector<U32> _parents;
+    vector<U8> _flags;
+    vector<U32> _indexToSlot;
+    /// Level N covers slots [_levelOffsets[N], _levelOffsets[N + 1])
+    vector<U32> _levelOffsets;
+};
+
+} //namespace Divide
+
+#endif //DVD_TRANSFORM_HIERARCHY_H_
@@ -34,6 +34,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define DVD_TRANSFORM_SYSTEM_H_
 
 #include "ECSSystem.h"
+#include "TransformHierarchy.h"
 #include "Core/Headers/PlatformContextComponent.h"
 #include "ECS/Components/Headers/TransformComponent.h"
 
@@ -54,7 +55,13 @@ namespace Divide {
 
 
        protected:
-         void computeWorldMatrix(TransformComponent* comp) const;
+         /// Re-sorts every component by hierarchy depth. Called when components get added/removed or change parents
+         void rebuildHierarchy();
+
+       protected:
+         TransformHierarchy _hierarchy;
+         /// Component for every hierarchy slot
+         vector<TransformComponent*> _componentsBySlot;
     };
 }
 
@@ -0,0 +1,35 @@
+
+
+#include "Headers/NetworkingSystem.h"
+
+#include "Core/Headers/PlatformContext.h"
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Networking/Headers/Client.h"
+
+namespace Divide {
+    NetworkingSystem::NetworkingSystem(ECS::ECSEngine& parentEngine, PlatformContext& context)
+        : PlatformContextComponent(context),
+          ECSSystem(parentEngine)
+    {
+    }
+
+    void NetworkingSystem::OnFrameStart()
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+        Parent::OnFrameStart();
+
+        const U64 nowUS = to_U64(Time::App::ElapsedMicroseconds());
+        const U64 elapsedUS = _lastFrameUS > 0u ? nowUS - _lastFrameUS : 0u;
+        _lastFrameUS = nowUS;
+
+        Networking::Client& client = context().networking().client();
+        const U64 renderTimeUS = client.updateRenderTime(nowUS);
+        const Networking::InterpolationSettings& settings = client.interpolationSettings();
+
+        for (NetworkingComponent* comp : _componentCache) {
+            comp->updateTransform(renderTimeUS, elapsedUS, settings);
+        }
+    }
+
+} //namespace Divide
@@ -0,0 +1,327 @@
+
+
+#include "Headers/TransformHierarchy.h"
+
+#include "Core/Headers/TaskPool.h"
+
+namespace Divide
+{
+
+namespace
+{
+    constexpr U32 g_laneCount = 4u;
+
+    /// Loads up to 4 consecutive values. Missing lanes are zero and their results get discarded
+    [[nodiscard]] FORCE_INLINE __m128 LoadLanes( const F32* data, const U32 count ) noexcept
+    {
+        if ( count == g_laneCount )
+        {
+            return _mm_loadu_ps( data );
+        }
+
+        alignas(16) F32 values[g_laneCount] = { 0.f, 0.f, 0.f, 0.f };
+        for ( U32 lane = 0u; lane < count; ++lane )
+        {
+            values[lane] = data[lane];
+        }
+        return _mm_load_ps( values );
+    }
+
+    /// (a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x) for 4 vectors at once
+    FORCE_INLINE void Cross( const __m128 ax, const __m128 ay, const __m128 az,
+                             const __m128 bx, const __m128 by, const __m128 bz,
+                             __m128& xOut, __m128& yOut, __m128& zOut ) noexcept
+    {
+        xOut = _mm_sub_ps( _mm_mul_ps( ay, bz ), _mm_mul_ps( az, by ) );
+        yOut = _mm_sub_ps( _mm_mul_ps( az, bx ), _mm_mul_ps( ax, bz ) );
+        zOut = _mm_sub_ps( _mm_mul_ps( ax, by ), _mm_mul_ps( ay, bx ) );
+    }
+}
+
+void TransformHierarchy::TRSArrays::resize( const size_t count )
+{
+    _posX.resize( count, 0.f );   _posY.resize( count, 0.f );   _posZ.resize( count, 0.f );
+    _scaleX.resize( count, 1.f ); _scaleY.resize( count, 1.f ); _scaleZ.resize( count, 1.f );
+    _rotX.resize( count, 0.f );   _rotY.resize( count, 0.f );   _rotZ.resize( count, 0.f );   _rotW.resize( count, 1.f );
+}
+
+void TransformHierarchy::TRSArrays::set( const U32 slot, const TransformValues& values ) noexcept
+{
+    _posX[slot] = values._translation.x;
+    _posY[slot] = values._translation.y;
+    _posZ[slot] = values._translation.z;
+    _scaleX[slot] = values._scale.x;
+    _scaleY[slot] = values._scale.y;
+    _scaleZ[slot] = values._scale.z;
+    _rotX[slot] = values._orientation.X();
+    _rotY[slot] = values._orientation.Y();
+    _rotZ[slot] = values._orientation.Z();
+    _rotW[slot] = values._orientation.W();
+}
+
+TransformValues TransformHierarchy::TRSArrays::get( const U32 slot ) const noexcept
+{
+    return TransformValues
+    {
+        ._orientation = quatf{ _rotX[slot], _rotY[slot], _rotZ[slot], _rotW[slot] },
+        ._translation = { _posX[slot], _posY[slot], _posZ[slot] },
+        ._scale = { _scaleX[slot], _scaleY[slot], _scaleZ[slot] }
+    };
+}
+
+void TransformHierarchy::build( const vector<U32>& parentIndices )
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    clear();
+
+    const U32 count = to_U32( parentIndices.size() );
+
+    // Children lists, packed: children of node i are in [childOffsets[i], childOffsets[i + 1])
+    vector<U32> childOffsets( count + 1u, 0u );
+    for ( const U32 parent : parentIndices )
+    {
+        if ( parent != INVALID_INDEX )
+        {
+            DIVIDE_ASSERT( parent < count );
+            ++childOffsets[parent + 1u];
+        }
+    }
+    for ( U32 i = 0u; i < count; ++i )
+    {
+        childOffsets[i + 1u] += childOffsets[i];
+    }
+
+    vector<U32> children( childOffsets[count] );
+    {
+        vector<U32> cursor( childOffsets.begin(), childOffsets.end() - 1 );
+        for ( U32 i = 0u; i < count; ++i )
+        {
+            if ( parentIndices[i] != INVALID_INDEX )
+            {
+                children[cursor[parentIndices[i]]++] = i;
+            }
+        }
+    }
+
+    // Breadth first: roots first, then every level in the order its parents appear. Siblings end up next to each other
+    vector<U32> order;
+    order.reserve( count );
+    for ( U32 i = 0u; i < count; ++i )
+    {
+        if ( parentIndices[i] == INVALID_INDEX )
+        {
+            order.push_back( i );
+        }
+    }
+
+    _levelOffsets.push_back( 0u );
+    for ( U32 levelStart = 0u; levelStart < to_U32( order.size() ); )
+    {
+        const U32 levelEnd = to_U32( order.size() );
+        _levelOffsets.push_back( levelEnd );
+
+        for ( U32 i = levelStart; i < levelEnd; ++i )
+        {
+            const U32 node = order[i];
+            order.insert( order.end(), children.begin() + childOffsets[node], children.begin() + childOffsets[node + 1u] );
+        }
+        levelStart = levelEnd;
+    }
+    // Anything left over is part of a cycle
+    DIVIDE_ASSERT( order.size() == count );
+
+    _indexToSlot.resize( count, INVALID_INDEX );
+    for ( U32 slot = 0u; slot < count; ++slot )
+    {
+        _indexToSlot[order[slot]] = slot;
+    }
+
+    _parents.resize( count );
+    for ( U32 slot = 0u; slot < count; ++slot )
+    {
+        const U32 parent = parentIndices[order[slot]];
+        _parents[slot] = parent == INVALID_INDEX ? INVALID_INDEX : _indexToSlot[parent];
+    }
+
+    _local.resize( count );
+    _world.resize( count );
+    _worldMatrices.resize( count, MAT4_IDENTITY );
+    _flags.resize( count, FLAG_DIRTY );
+}
+
+void TransformHierarchy::clear()
+{
+    _local = {};
+    _world = {};
+    _worldMatrices.clear();
+    _parents.clear();
+    _flags.clear();
+    _indexToSlot.clear();
+    _levelOffsets.clear();
+}
+
+void TransformHierarchy::setLocal( const U32 slot, const TransformValues& values, const bool localRotations ) noexcept
+{
+    _local.set( slot, values );
+    _flags[slot] = FLAG_DIRTY | (localRotations ? FLAG_LOCAL_ROTATIONS : 0u);
+}
+
+TransformValues TransformHierarchy::localValues( const U32 slot ) const noexcept
+{
+    return _local.get( slot );
+}
+
+TransformValues TransformHierarchy::worldValues( const U32 slot ) const noexcept
+{
+    return _world.get( slot );
+}
+
+void TransformHierarchy::update( TaskPool* pool, const U32 partitionSize )
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    for ( size_t level = 0u; level < levelCount(); ++level )
+    {
+        const U32 levelStart = _levelOffsets[level];
+        const U32 levelSize = _levelOffsets[level + 1u] - levelStart;
+
+        if ( pool == nullptr || levelSize <= partitionSize )
+        {
+            updateRange( levelStart, levelStart + levelSize );
+            continue;
+        }
+
+        Parallel_For( *pool,
+                      ParallelForDescriptor
+                      {
+                          ._iterCount = levelSize,
+                          ._partitionSize = partitionSize
+                      },
+                      [this, levelStart]( const Task*, const U32 start, const U32 end )
+                      {
+                          updateRange( levelStart + start, levelStart + end );
+                      });
+    }
+}
+
+void TransformHierarchy::updateRange( const U32 start, const U32 end ) noexcept
+{
+    const __m128 two = _mm_set1_ps( 2.f );
+
+    alignas(16) F32 parentPosX[g_laneCount], parentPosY[g_laneCount], parentPosZ[g_laneCount];
+    alignas(16) F32 parentScaleX[g_laneCount], parentScaleY[g_laneCount], parentScaleZ[g_laneCount];
+    alignas(16) F32 parentRotX[g_laneCount], parentRotY[g_laneCount], parentRotZ[g_laneCount], parentRotW[g_laneCount];
+    alignas(16) U32 localRotationMask[g_laneCount];
+    alignas(16) F32 result[10][g_laneCount];
+
+    for ( U32 i = start; i < end; i += g_laneCount )
+    {
+        const U32 count = std::min( g_laneCount, end - i );
+
+        // A node needs updating if it changed or if its parent's world transform changed. Parents were processed in the previous level
+        U32 changedMask = 0u;
+        for ( U32 lane = 0u; lane < count; ++lane )
+        {
+            const U32 slot = i + lane;
+            const U32 parent = _parents[slot];
+            const bool changed = (_flags[slot] & FLAG_DIRTY) != 0u || (parent != INVALID_INDEX && (_flags[parent] & FLAG_CHANGED) != 0u);
+            _flags[slot] = (_flags[slot] & FLAG_LOCAL_ROTATIONS) | (changed ? FLAG_CHANGED : 0u);
+            changedMask |= changed ? 1u << lane : 0u;
+        }
+
+        if ( changedMask == 0u )
+        {
+            continue;
+        }
+
+        // Gather parent world transforms. Roots use an identity parent, which leaves their local transform as is
+        for ( U32 lane = 0u; lane < g_laneCount; ++lane )
+        {
+            const U32 parent = lane < count ? _parents[i + lane] : INVALID_INDEX;
+            const bool hasParent = parent != INVALID_INDEX;
+            parentPosX[lane]   = hasParent ? _world._posX[parent]   : 0.f;
+            parentPosY[lane]   = hasParent ? _world._posY[parent]   : 0.f;
+            parentPosZ[lane]   = hasParent ? _world._posZ[parent]   : 0.f;
+            parentScaleX[lane] = hasParent ? _world._scaleX[parent] : 1.f;
+            parentScaleY[lane] = hasParent ? _world._scaleY[parent] : 1.f;
+            parentScaleZ[lane] = hasParent ? _world._scaleZ[parent] : 1.f;
+            parentRotX[lane]   = hasParent ? _world._rotX[parent]   : 0.f;
+            parentRotY[lane]   = hasParent ? _world._rotY[parent]   : 0.f;
+            parentRotZ[lane]   = hasParent ? _world._rotZ[parent]   : 0.f;
+            parentRotW[lane]   = hasParent ? _world._rotW[parent]   : 1.f;
+            localRotationMask[lane] = lane < count && (_flags[i + lane] & FLAG_LOCAL_ROTATIONS) != 0u ? U32_MAX : 0u;
+        }
+
+        const __m128 pqx = _mm_load_ps( parentRotX ), pqy = _mm_load_ps( parentRotY ), pqz = _mm_load_ps( parentRotZ ), pqw = _mm_load_ps( parentRotW );
+        const __m128 psx = _mm_load_ps( parentScaleX ), psy = _mm_load_ps( parentScaleY ), psz = _mm_load_ps( parentScaleZ );
+        const __m128 ptx = _mm_load_ps( parentPosX ), pty = _mm_load_ps( parentPosY ), ptz = _mm_load_ps( parentPosZ );
+
+        const __m128 lqx = LoadLanes( &_local._rotX[i], count ), lqy = LoadLanes( &_local._rotY[i], count );
+        const __m128 lqz = LoadLanes( &_local._rotZ[i], count ), lqw = LoadLanes( &_local._rotW[i], count );
+        const __m128 lsx = LoadLanes( &_local._scaleX[i], count ), lsy = LoadLanes( &_local._scaleY[i], count ), lsz = LoadLanes( &_local._scaleZ[i], count );
+        const __m128 ltx = LoadLanes( &_local._posX[i], count ), lty = LoadLanes( &_local._posY[i], count ), ltz = LoadLanes( &_local._posZ[i], count );
+
+        // World orientation = parent orientation * local orientation (same as Quaternion::operator*)
+        const __m128 wqx = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( pqw, lqx ), _mm_mul_ps( pqx, lqw ) ), _mm_mul_ps( pqy, lqz ) ), _mm_mul_ps( pqz, lqy ) );
+        const __m128 wqy = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( pqw, lqy ), _mm_mul_ps( pqy, lqw ) ), _mm_mul_ps( pqz, lqx ) ), _mm_mul_ps( pqx, lqz ) );
+        const __m128 wqz = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( pqw, lqz ), _mm_mul_ps( pqz, lqw ) ), _mm_mul_ps( pqx, lqy ) ), _mm_mul_ps( pqy, lqx ) );
+        const __m128 wqw = _mm_sub_ps( _mm_sub_ps( _mm_sub_ps( _mm_mul_ps( pqw, lqw ), _mm_mul_ps( pqx, lqx ) ), _mm_mul_ps( pqy, lqy ) ), _mm_mul_ps( pqz, lqz ) );
+
+        // World position = parent position + parent orientation * (parent scale * local position), unless the node uses local rotations
+        const __m128 vx = _mm_mul_ps( psx, ltx ), vy = _mm_mul_ps( psy, lty ), vz = _mm_mul_ps( psz, ltz );
+        __m128 uvx, uvy, uvz, uuvx, uuvy, uuvz;
+        Cross( pqx, pqy, pqz, vx, vy, vz, uvx, uvy, uvz );
+        Cross( pqx, pqy, pqz, uvx, uvy, uvz, uuvx, uuvy, uuvz );
+        const __m128 w2 = _mm_mul_ps( pqw, two );
+        const __m128 rx = _mm_add_ps( _mm_add_ps( vx, _mm_mul_ps( uvx, w2 ) ), _mm_mul_ps( uuvx, two ) );
+        const __m128 ry = _mm_add_ps( _mm_add_ps( vy, _mm_mul_ps( uvy, w2 ) ), _mm_mul_ps( uuvy, two ) );
+        const __m128 rz = _mm_add_ps( _mm_add_ps( vz, _mm_mul_ps( uvz, w2 ) ), _mm_mul_ps( uuvz, two ) );
+
+        const __m128 localRotations = _mm_load_ps( reinterpret_cast<const F32*>( localRotationMask ) );
+        const __m128 ox = _mm_or_ps( _mm_and_ps( localRotations, ltx ), _mm_andnot_ps( localRotations, rx ) );
+        const __m128 oy = _mm_or_ps( _mm_and_ps( localRotations, lty ), _mm_andnot_ps( localRotations, ry ) );
+        const __m128 oz = _mm_or_ps( _mm_and_ps( localRotations, ltz ), _mm_andnot_ps( localRotations, rz ) );
+
+        _mm_store_ps( result[0], _mm_add_ps( ptx, ox ) );
+        _mm_store_ps( result[1], _mm_add_ps( pty, oy ) );
+        _mm_store_ps( result[2], _mm_add_ps( ptz, oz ) );
+        _mm_store_ps( result[3], _mm_mul_ps( psx, lsx ) );
+        _mm_store_ps( result[4], _mm_mul_ps( psy, lsy ) );
+        _mm_store_ps( result[5], _mm_mul_ps( psz, lsz ) );
+        _mm_store_ps( result[6], wqx );
+        _mm_store_ps( result[7], wqy );
+        _mm_store_ps( result[8], wqz );
+        _mm_store_ps( result[9], wqw );
+
+        // Only write back nodes that actually changed so that untouched world values stay bit-identical
+        for ( U32 lane = 0u; lane < count; ++lane )
+        {
+            if ( (changedMask & (1u << lane)) == 0u )
+            {
+                continue;
+            }
+
+            const U32 slot = i + lane;
+            _world._posX[slot] = result[0][lane];
+            _world._posY[slot] = result[1][lane];
+            _world._posZ[slot] = result[2][lane];
+            _world._scaleX[slot] = result[3][lane];
+            _world._scaleY[slot] = result[4][lane];
+            _world._scaleZ[slot] = result[5][lane];
+            _world._rotX[slot] = result[6][lane];
+            _world._rotY[slot] = result[7][lane];
+            _world._rotZ[slot] = result[8][lane];
+            _world._rotW[slot] = result[9][lane];
+
+            _worldMatrices[slot] = mat4<F32>
+            {
+                float3{ result[0][lane], result[1][lane], result[2][lane] },
+                float3{ result[3][lane], result[4][lane], result[5][lane] },
+                quatf{ result[6][lane], result[7][lane], result[8][lane], result[9][lane] }.getConjugate()
+            };
+        }
+    }
+}
+
+} //namespace Divide
@@ -24,6 +24,8 @@ namespace Divide {
 
         Parent::PreUpdate(dt);
 
+        bool hierarchyChanged = _componentCache.size() != _hierarchy.size();
+
         for ( TransformComponent* comp : _componentCache )
         {
             // If we have dirty transforms, inform everybody
@@ -33,6 +35,56 @@ namespace Divide {
                 Attorney::SceneGraphNodeSystem::setTransformDirty(comp->parentSGN(), updateMask);
                 comp->_local._computed = comp->_world._computed = false;
             }
+
+            // New components don't have a slot yet
+            if ( comp->_parentChanged.exchange(false) || comp->_hierarchySlot == TransformHierarchy::INVALID_INDEX )
+            {
+                hierarchyChanged = true;
+            }
+        }
+
+        if ( hierarchyChanged )
+        {
+            rebuildHierarchy();
+        }
+    }
+
+    void TransformSystem::rebuildHierarchy()
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+        const U32 componentCount = to_U32(_componentCache.size());
+
+        // Temporarily store the cache index in the slot so we can find parents without a lookup table
+        for (U32 i = 0u; i < componentCount; ++i)
+        {
+            _componentCache[i]->_hierarchySlot = i;
+        }
+
+        vector<U32> parentIndices(componentCount, TransformHierarchy::INVALID_INDEX);
+        for (U32 i = 0u; i < componentCount; ++i)
+        {
+            const SceneGraphNode* parent = _componentCache[i]->parentSGN()->parent();
+            if ( parent != nullptr )
+            {
+                const TransformComponent* tComp = parent->get<TransformComponent>();
+                // Parents created after the cache got refreshed are treated as roots until the next rebuild
+                if ( tComp != nullptr && tComp->_hierarchySlot < componentCount && _componentCache[tComp->_hierarchySlot] == tComp )
+                {
+                    parentIndices[i] = tComp->_hierarchySlot;
+                }
+            }
+        }
+
+        _hierarchy.build(parentIndices);
+
+        _componentsBySlot.resize(componentCount);
+        for (U32 i = 0u; i < componentCount; ++i)
+        {
+            TransformComponent* comp = _componentCache[i];
+            comp->_hierarchySlot = _hierarchy.slot(i);
+            _componentsBySlot[comp->_hierarchySlot] = comp;
+            _hierarchy.setLocal(comp->_hierarchySlot, comp->_local._values, comp->rotationMode() == TransformComponent::RotationMode::LOCAL);
         }
     }
 
@@ -63,7 +115,7 @@ namespace Divide {
                           ._iterCount = to_U32(dirtyComponents.size()),
                           ._partitionSize = g_parallelPartitionSize
                       },
-                      [](const Task*, const U32 start, const U32 end)
+                      [this](const Task*, const U32 start, const U32 end)
                       {
                           for (U32 i = start; i < end; ++i)
                           {
@@ -83,6 +135,8 @@ namespace Divide {
                               };
 
                               comp->_local._computed = true;
+
+                              _hierarchy.setLocal(comp->_hierarchySlot, comp->_local._values, comp->rotationMode() == TransformComponent::RotationMode::LOCAL);
                           }
                       });
 
@@ -95,10 +149,31 @@ namespace Divide {
 
         Parent::PostUpdate(dt);
 
-        for (TransformComponent* comp : _componentCache)
-        {
-            computeWorldMatrix(comp);
-        }
+        // Level by level, only touching dirty subtrees
+        _hierarchy.update( &_context.taskPool( TaskPoolType::HIGH_PRIORITY ), g_parallelPartitionSize );
+
+        Parallel_For( _context.taskPool( TaskPoolType::HIGH_PRIORITY ),
+                      ParallelForDescriptor
+                      {
+                          ._iterCount = to_U32(_componentsBySlot.size()),
+                          ._partitionSize = g_parallelPartitionSize
+                      },
+                      [this](const Task*, const U32 start, const U32 end)
+                      {
+                          for (U32 slot = start; slot < end; ++slot)
+                          {
+                              if ( !_hierarchy.worldChanged(slot) )
+                              {
+                                  continue;
+                              }
+
+                              TransformComponent* comp = _componentsBySlot[slot];
+                              comp->_world._previousValues = comp->_world._values;
+                              comp->_world._values = _hierarchy.worldValues(slot);
+                              comp->_world._matrix = _hierarchy.worldMatrix(slot);
+                              comp->_world._computed = true;
+                          }
+                      });
 
         for (TransformComponent* comp : _componentCache)
         {
@@ -119,47 +194,6 @@ namespace Divide {
         }
     }
 
-    void TransformSystem::computeWorldMatrix(TransformComponent* comp) const
-    {
-        if ( comp->_world._computed )
-        {
-            return;
-        }
-
-        const bool useLocalRotations = comp->rotationMode() == TransformComponent::RotationMode::LOCAL;
-
-        comp->_world._matrix         = comp->_local._matrix;
-        comp->_world._previousValues = comp->_world._values;
-        comp->_world._values         = comp->_local._values;
-
-        SceneGraphNode* grandParent = comp->_parentSGN->parent();
-        if ( grandParent != nullptr ) 
-        {
-            TransformComponent* tComp = grandParent->get<TransformComponent>();
-            if ( tComp != nullptr )
-            {
-                computeWorldMatrix(tComp);
-
-                comp->_world._values._orientation = tComp->_world._values._orientation * comp->_world._values._orientation;
-                comp->_world._values._scale       = tComp->_world._values._scale       * comp->_world._values._scale;
-
-                const float3 worldPosition = useLocalRotations ? comp->_world._values._translation
-                                                               : tComp->_world._values._orientation * (tComp->_world._values._scale * comp->_world._values._translation);
-
-                comp->_world._values._translation = tComp->_world._values._translation + worldPosition;
-            }
-        }
-
-        comp->_world._matrix = mat4<F32>
-        {
-            comp->_world._values._translation,
-            comp->_world._values._scale,
-            comp->_world._values._orientation.getConjugate()
-        };
-
-        comp->_world._computed = true;
-    }
-
     bool TransformSystem::saveCache(const SceneGraphNode* sgn, ByteBuffer& outputBuffer)
     {
         if (Parent::saveCache(sgn, outputBuffer))
@@ -0,0 +1,226 @@
+
+
+#include "Headers/AnimationBlendGraph.h"
+
+namespace Divide
+{
+
+namespace
+{
+    void BlendPoses( const AnimationPose& from, const AnimationPose& to, const F32 weight, const F32* boneWeights, AnimationPose& poseOut ) noexcept
+    {
+        const size_t count = poseOut._posX.size();
+        for ( size_t i = 0u; i < count; ++i )
+        {
+            const F32 w = boneWeights != nullptr ? weight * boneWeights[i] : weight;
+
+            poseOut._posX[i] = from._posX[i] + (to._posX[i] - from._posX[i]) * w;
+            poseOut._posY[i] = from._posY[i] + (to._posY[i] - from._posY[i]) * w;
+            poseOut._posZ[i] = from._posZ[i] + (to._posZ[i] - from._posZ[i]) * w;
+            poseOut._scaleX[i] = from._scaleX[i] + (to._scaleX[i] - from._scaleX[i]) * w;
+            poseOut._scaleY[i] = from._scaleY[i] + (to._scaleY[i] - from._scaleY[i]) * w;
+            poseOut._scaleZ[i] = from._scaleZ[i] + (to._scaleZ[i] - from._scaleZ[i]) * w;
+
+            // nlerp along the shortest path
+            const F32 dot = from._rotX[i] * to._rotX[i] + from._rotY[i] * to._rotY[i] + from._rotZ[i] * to._rotZ[i] + from._rotW[i] * to._rotW[i];
+            const F32 sign = dot < 0.f ? -1.f : 1.f;
+            const F32 x = from._rotX[i] + (to._rotX[i] * sign - from._rotX[i]) * w;
+            const F32 y = from._rotY[i] + (to._rotY[i] * sign - from._rotY[i]) * w;
+            const F32 z = from._rotZ[i] + (to._rotZ[i] * sign - from._rotZ[i]) * w;
+            const F32 s = from._rotW[i] + (to._rotW[i] * sign - from._rotW[i]) * w;
+            const F32 invLength = 1.f / std::sqrt( x * x + y * y + z * z + s * s );
+            poseOut._rotX[i] = x * invLength;
+            poseOut._rotY[i] = y * invLength;
+            poseOut._rotZ[i] = z * invLength;
+            poseOut._rotW[i] = s * invLength;
+
+            poseOut._animated[i] = from._animated[i] | to._animated[i];
+        }
+    }
+
+    void AddPose( const AnimationPose& base, const AnimationPose& layer, const AnimationPose& reference, const F32 weight, AnimationPose& poseOut ) noexcept
+    {
+        const size_t count = poseOut._posX.size();
+        for ( size_t i = 0u; i < count; ++i )
+        {
+            poseOut._posX[i] = base._posX[i] + (layer._posX[i] - reference._posX[i]) * weight;
+            poseOut._posY[i] = base._posY[i] + (layer._posY[i] - reference._posY[i]) * weight;
+            poseOut._posZ[i] = base._posZ[i] + (layer._posZ[i] - reference._posZ[i]) * weight;
+            poseOut._scaleX[i] = base._scaleX[i] * (1.f + (layer._scaleX[i] / reference._scaleX[i] - 1.f) * weight);
+            poseOut._scaleY[i] = base._scaleY[i] * (1.f + (layer._scaleY[i] / reference._scaleY[i] - 1.f) * weight);
+            poseOut._scaleZ[i] = base._scaleZ[i] * (1.f + (layer._scaleZ[i] / reference._scaleZ[i] - 1.f) * weight);
+
+            // delta = conjugate(reference) * layer, scaled down by nlerp-ing it from identity
+            const F32 rx = -reference._rotX[i], ry = -reference._rotY[i], rz = -reference._rotZ[i], rw = reference._rotW[i];
+            const F32 lx = layer._rotX[i], ly = layer._rotY[i], lz = layer._rotZ[i], lw = layer._rotW[i];
+            F32 dx = rw * lx + rx * lw + ry * lz - rz * ly;
+            F32 dy = rw * ly - rx * lz + ry * lw + rz * lx;
+            F32 dz = rw * lz + rx * ly - ry * lx + rz * lw;
+            F32 dw = rw * lw - rx * lx - ry * ly - rz * lz;
+            if ( dw < 0.f )
+            {
+                dx = -dx; dy = -dy; dz = -dz; dw = -dw;
+            }
+            dx *= weight; dy *= weight; dz *= weight; dw = 1.f + (dw - 1.f) * weight;
+
+            // base * delta
+            const F32 bx = base._rotX[i], by = base._rotY[i], bz = base._rotZ[i], bw = base._rotW[i];
+            const F32 x = bw * dx + bx * dw + by * dz - bz * dy;
+            const F32 y = bw * dy - bx * dz + by * dw + bz * dx;
+            const F32 z = bw * dz + bx * dy - by * dx + bz * dw;
+            const F32 w = bw * dw - bx * dx - by * dy - bz * dz;
+            const F32 invLength = 1.f / std::sqrt( x * x + y * y + z * z + w * w );
+            poseOut._rotX[i] = x * invLength;
+            poseOut._rotY[i] = y * invLength;
+            poseOut._rotZ[i] = z * invLength;
+            poseOut._rotW[i] = w * invLength;
+
+            poseOut._animated[i] = base._animated[i] | layer._animated[i];
+        }
+    }
+}
+
+void AnimationBoneMask::set( const AnimationSkeleton& skeleton, const U64 boneNameHash, const F32 weight )
+{
+    const size_t boneCount = skeleton.boneCount();
+    _weights.resize( boneCount, 0.f );
+
+    const U16 bone = skeleton.boneIndex( boneNameHash );
+    if ( bone == AnimationSkeleton::INVALID_INDEX )
+    {
+        return;
+    }
+
+    _weights[bone] = weight;
+    // Bones are stored depth first, so a bone's descendants directly follow it and all of their parents are in the [bone, descendant) range
+    for ( size_t i = bone + 1u; i < boneCount; ++i )
+    {
+        const U16 parent = skeleton.parentIndex( to_U16( i ) );
+        if ( parent == AnimationSkeleton::INVALID_INDEX || parent < bone )
+        {
+            break;
+        }
+        _weights[i] = weight;
+    }
+}
+
+U16 AnimationBlendGraph::addNode( const AnimationBlendNode& node )
+{
+    DIVIDE_ASSERT( _nodes.size() < AnimationBlendNode::INVALID_INPUT );
+
+    for ( const U16 input : node._inputs )
+    {
+        DIVIDE_ASSERT( input == AnimationBlendNode::INVALID_INPUT || input < _nodes.size(), "AnimationBlendGraph error: inputs must be added before the nodes that use them!" );
+    }
+
+    _nodes.push_back( node );
+    return to_U16( _nodes.size() - 1u );
+}
+
+U16 AnimationBlendGraph::addClip( const U32 animationIndex, const F32 speed, const D64 startTimeS )
+{
+    return addNode( AnimationBlendNode
+    {
+        ._type = AnimationBlendNodeType::CLIP,
+        ._animationIndex = animationIndex,
+        ._startTimeS = startTimeS,
+        ._speed = speed
+    });
+}
+
+U16 AnimationBlendGraph::addBlend( const U16 from, const U16 to, const F32 weight )
+{
+    return addNode( AnimationBlendNode
+    {
+        ._type = AnimationBlendNodeType::BLEND,
+        ._weight = weight,
+        ._inputs = { from, to, AnimationBlendNode::INVALID_INPUT }
+    });
+}
+
+U16 AnimationBlendGraph::addAdditive( const U16 base, const U16 layer, const U16 reference, const F32 weight )
+{
+    return addNode( AnimationBlendNode
+    {
+        ._type = AnimationBlendNodeType::ADDITIVE,
+        ._weight = weight,
+        ._inputs = { base, layer, reference }
+    });
+}
+
+U16 AnimationBlendGraph::addMask( const U16 from, const U16 to, const U16 mask, const F32 weight )
+{
+    DIVIDE_ASSERT( mask < _masks.size() );
+
+    return addNode( AnimationBlendNode
+    {
+        ._type = AnimationBlendNodeType::MASK,
+        ._weight = weight,
+        ._inputs = { from, to, AnimationBlendNode::INVALID_INPUT },
+        ._mask = mask
+    });
+}
+
+U16 AnimationBlendGraph::addBoneMask( AnimationBoneMask&& mask )
+{
+    _masks.push_back( MOV( mask ) );
+    return to_U16( _masks.size() - 1u );
+}
+
+void AnimationBlendGraph::clear()
+{
+    _nodes.clear();
+    _masks.clear();
+}
+
+void AnimationBlendGraph::evaluate( const AnimationSkeleton& skeleton, const D64 timeS, const ClipSampler& sampler, vector<AnimationPose>& scratchPoses, AnimationPose& poseOut ) const
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    DIVIDE_ASSERT( !empty() );
+
+    const size_t boneCount = skeleton.boneCount();
+    const size_t nodeCount = _nodes.size();
+    if ( scratchPoses.size() < nodeCount - 1u )
+    {
+        scratchPoses.resize( nodeCount - 1u );
+    }
+
+    for ( size_t i = 0u; i < nodeCount; ++i )
+    {
+        const AnimationBlendNode& node = _nodes[i];
+
+        AnimationPose& pose = i + 1u == nodeCount ? poseOut : scratchPoses[i];
+        if ( pose._posX.size() != boneCount )
+        {
+            pose.resizeLocal( boneCount );
+        }
+
+        switch ( node._type )
+        {
+            case AnimationBlendNodeType::CLIP:
+            {
+                sampler( node._animationIndex, std::max( (timeS - node._startTimeS) * node._speed, 0.0 ), pose );
+            } break;
+            case AnimationBlendNodeType::BLEND:
+            {
+                BlendPoses( scratchPoses[node._inputs[0]], scratchPoses[node._inputs[1]], node._weight, nullptr, pose );
+            } break;
+            case AnimationBlendNodeType::MASK:
+            {
+                const vector<F32>& weights = _masks[node._mask]._weights;
+                DIVIDE_ASSERT( weights.size() == boneCount );
+
+                BlendPoses( scratchPoses[node._inputs[0]], scratchPoses[node._inputs[1]], node._weight, weights.data(), pose );
+            } break;
+            case AnimationBlendNodeType::ADDITIVE:
+            {
+                AddPose( scratchPoses[node._inputs[0]], scratchPoses[node._inputs[1]], scratchPoses[node._inputs[2]], node._weight, pose );
+            } break;
+
+            default: DIVIDE_UNEXPECTED_CALL(); break;
+        }
+    }
+}
+
+} //namespace Divide
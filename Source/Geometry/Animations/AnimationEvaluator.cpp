@@ -162,7 +162,8 @@ AnimEvaluator::FrameIndex AnimEvaluator::frameIndexAt(const D64 elapsedTimeS, co
 
 // ------------------------------------------------------------------------------------------------
 // Evaluates the animation tracks for a given time stamp.
-void AnimEvaluator::evaluate(const D64 dt, Bone& skeleton)
+template<typename BoneResolver>
+void AnimEvaluator::evaluateChannels(const D64 dt, BoneResolver&& resolveBone)
 {
     const D64 pTime = dt * ticksPerSecond();
 
@@ -182,9 +183,9 @@ void AnimEvaluator::evaluate(const D64 dt, Bone& skeleton)
     for (size_t a = 0u; a < channelCount; ++a)
     {
         const AnimationChannel* channel = &_channels[a];
-        Bone* boneNode = skeleton.find(channel->_nameKey);
+        mat4<F32>* localTransform = resolveBone(*channel);
 
-        if (boneNode == nullptr)
+        if (localTransform == nullptr)
         {
             Console::d_errorfn(LOCALE_STR("ERROR_BONE_FIND"), channel->_name.c_str());
             continue;
@@ -308,12 +309,34 @@ void AnimEvaluator::evaluate(const D64 dt, Bone& skeleton)
             mat.c3 *= presentScaling.z;
         }
 
-        AnimUtils::TransformMatrix(mat, boneNode->_localTransform);
+        AnimUtils::TransformMatrix(mat, *localTransform);
     }
 
     _lastTime = time;
 }
 
+void AnimEvaluator::evaluate(const D64 dt, Bone& skeleton)
+{
+    evaluateChannels(dt,
+                     [&skeleton](const AnimationChannel& channel) -> mat4<F32>*
+                     {
+                         Bone* boneNode = skeleton.find(channel._nameKey);
+                         return boneNode != nullptr ? &boneNode->_localTransform : nullptr;
+                     });
+}
+
+void AnimEvaluator::evaluate(const D64 dt, const AnimationSkeleton& skeleton, vector<mat4<F32>>& localTransformsInOut)
+{
+    DIVIDE_ASSERT(localTransformsInOut.size() == skeleton.boneCount());
+
+    evaluateChannels(dt,
+                     [&skeleton, &localTransformsInOut](const AnimationChannel& channel) -> mat4<F32>*
+                     {
+                         const U16 bone = skeleton.boneIndex(channel._nameKey);
+                         return bone != AnimationSkeleton::INVALID_INDEX ? &localTransformsInOut[bone] : nullptr;
+                     });
+}
+
 void AnimEvaluator::save(const AnimEvaluator& evaluator, ByteBuffer& dataOut)
 {
     dataOut << BYTE_BUFFER_VERSION_EVALUATOR;
@@ -377,13 +400,16 @@ void AnimEvaluator::save(const AnimEvaluator& evaluator, ByteBuffer& dataOut)
     }
 }
 
-void AnimEvaluator::load(AnimEvaluator& evaluator, ByteBuffer& dataIn)
+bool AnimEvaluator::load(AnimEvaluator& evaluator, ByteBuffer& dataIn)
 {
     Console::d_printfn(LOCALE_STR("CREATE_ANIMATION_BEGIN"), evaluator._name.c_str());
 
     auto tempVer = decltype(BYTE_BUFFER_VERSION_EVALUATOR){0};
     dataIn >> tempVer;
-    DIVIDE_EXPECTED_CALL(tempVer == BYTE_BUFFER_VERSION_EVALUATOR);
+    if (tempVer != BYTE_BUFFER_VERSION_EVALUATOR)
+    {
+        return false;
+    }
 
     // the animation name
     dataIn >> evaluator._name;
@@ -456,6 +482,7 @@ void AnimEvaluator::load(AnimEvaluator& evaluator, ByteBuffer& dataIn)
     }
 
     evaluator._lastPositions.resize(evaluator._channels.size(), uint3());
+    return true;
 }
 
 } //namespace Divide
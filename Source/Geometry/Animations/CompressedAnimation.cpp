@@ -0,0 +1,791 @@
+
+
+#include "Headers/CompressedAnimation.h"
+#include "Headers/AnimationEvaluator.h"
+#include "Core/Headers/ByteBuffer.h"
+
+namespace Divide
+{
+
+constexpr U16 BYTE_BUFFER_VERSION_SKELETON = 3u;
+
+namespace
+{
+    constexpr U32 g_laneCount = 4u;
+    constexpr F32 g_timeRange = 65535.f;
+    constexpr F32 g_vectorRange = 65535.f;
+    constexpr F32 g_rotationRange = 32767.f;
+    constexpr U16 g_rotationValueMask = 0x7FFFu;
+    /// None of the 3 smallest components of a unit quaternion can be larger than 1 / sqrt(2)
+    constexpr F32 g_smallestThreeMax = 0.70710678f;
+
+    /// Loads up to 4 consecutive values. Missing lanes are zero and their results get discarded
+    [[nodiscard]] FORCE_INLINE __m128 LoadLanes( const F32* data, const U32 count ) noexcept
+    {
+        if ( count == g_laneCount )
+        {
+            return _mm_loadu_ps( data );
+        }
+
+        alignas(16) F32 values[g_laneCount] = { 0.f, 0.f, 0.f, 0.f };
+        for ( U32 lane = 0u; lane < count; ++lane )
+        {
+            values[lane] = data[lane];
+        }
+        return _mm_load_ps( values );
+    }
+
+    [[nodiscard]] F32 MaxDifference( const float3& a, const float3& b ) noexcept
+    {
+        return std::max( std::abs( a.x - b.x ), std::max( std::abs( a.y - b.y ), std::abs( a.z - b.z ) ) );
+    }
+
+    [[nodiscard]] float3 Interpolate( const float3& a, const float3& b, const F32 factor ) noexcept
+    {
+        return float3{ a.x + (b.x - a.x) * factor, a.y + (b.y - a.y) * factor, a.z + (b.z - a.z) * factor };
+    }
+
+    [[nodiscard]] F32 Dot( const float4& a, const float4& b ) noexcept
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
+
+    [[nodiscard]] float4 Normalized( const float4& q ) noexcept
+    {
+        const F32 length = std::sqrt( Dot( q, q ) );
+        return length > EPSILON_F32 ? float4{ q.x / length, q.y / length, q.z / length, q.w / length } : float4{ 0.f, 0.f, 0.f, 1.f };
+    }
+
+    /// Normalised lerp along the shortest path. Cheaper than a slerp and close enough for neighbouring keys
+    [[nodiscard]] float4 Interpolate( const float4& a, const float4& b, const F32 factor ) noexcept
+    {
+        const F32 sign = Dot( a, b ) < 0.f ? -1.f : 1.f;
+        return Normalized( float4{ a.x + (b.x * sign - a.x) * factor,
+                                   a.y + (b.y * sign - a.y) * factor,
+                                   a.z + (b.z * sign - a.z) * factor,
+                                   a.w + (b.w * sign - a.w) * factor } );
+    }
+
+    /// Angle between two unit quaternions, in radians
+    [[nodiscard]] F32 AngleBetween( const float4& a, const float4& b ) noexcept
+    {
+        return 2.f * std::acos( std::min( 1.f, std::abs( Dot( a, b ) ) ) );
+    }
+
+    [[nodiscard]] F32 SegmentFactor( const F32 time, const F32 startTime, const F32 endTime ) noexcept
+    {
+        return endTime > startTime ? (time - startTime) / (endTime - startTime) : 0.f;
+    }
+
+    /// Smallest three: drop the largest component (it can be rebuilt from the unit length) and store its index in the top bits
+    void EncodeRotation( const float4& q, U16* valuesOut ) noexcept
+    {
+        const F32 components[4] = { q.x, q.y, q.z, q.w };
+
+        U8 largest = 0u;
+        for ( U8 i = 1u; i < 4u; ++i )
+        {
+            if ( std::abs( components[i] ) > std::abs( components[largest] ) )
+            {
+                largest = i;
+            }
+        }
+
+        // q and -q are the same rotation. Flip it so that the dropped component is positive
+        const F32 sign = components[largest] < 0.f ? -1.f : 1.f;
+        for ( U8 i = 0u, j = 0u; i < 4u; ++i )
+        {
+            if ( i != largest )
+            {
+                const F32 normalised = std::clamp( components[i] * sign / g_smallestThreeMax, -1.f, 1.f );
+                valuesOut[j++] = to_U16( std::lround( (normalised * 0.5f + 0.5f) * g_rotationRange ) );
+            }
+        }
+
+        valuesOut[0] |= to_U16( (largest & 1u) << 15u );
+        valuesOut[1] |= to_U16( (largest >> 1u) << 15u );
+    }
+
+    [[nodiscard]] float4 DecodeRotation( const U16* values ) noexcept
+    {
+        const U8 largest = to_U8( (values[0] >> 15u) | ((values[1] >> 15u) << 1u) );
+
+        F32 components[4] = {};
+        F32 lengthSq = 0.f;
+        for ( U8 i = 0u, j = 0u; i < 4u; ++i )
+        {
+            if ( i != largest )
+            {
+                const F32 value = ((values[j++] & g_rotationValueMask) / g_rotationRange * 2.f - 1.f) * g_smallestThreeMax;
+                components[i] = value;
+                lengthSq += value * value;
+            }
+        }
+        components[largest] = std::sqrt( std::max( 0.f, 1.f - lengthSq ) );
+
+        return float4{ components[0], components[1], components[2], components[3] };
+    }
+
+    struct BindTransform
+    {
+        float3 _position;
+        float4 _rotation;
+        float3 _scale;
+    };
+
+    /// Inverse of the local matrix layout computeSkinning builds: rotation rows scaled per axis, translation in the last row
+    [[nodiscard]] BindTransform DecomposeBindTransform( const mat4<F32>& local ) noexcept
+    {
+        BindTransform ret;
+        ret._position = float3{ local.m[3][0], local.m[3][1], local.m[3][2] };
+
+        F32 r[3][3];
+        for ( U8 row = 0u; row < 3u; ++row )
+        {
+            const F32 scale = std::sqrt( local.m[row][0] * local.m[row][0] + local.m[row][1] * local.m[row][1] + local.m[row][2] * local.m[row][2] );
+            ret._scale[row] = scale;
+            for ( U8 c = 0u; c < 3u; ++c )
+            {
+                r[row][c] = scale > EPSILON_F32 ? local.m[row][c] / scale : (row == c ? 1.f : 0.f);
+            }
+        }
+
+        // Pick the largest component first to keep the division stable
+        const F32 trace = r[0][0] + r[1][1] + r[2][2];
+        if ( trace > 0.f )
+        {
+            const F32 w = std::sqrt( trace + 1.f ) * 0.5f;
+            ret._rotation = float4{ (r[1][2] - r[2][1]) / (4.f * w), (r[2][0] - r[0][2]) / (4.f * w), (r[0][1] - r[1][0]) / (4.f * w), w };
+        }
+        else if ( r[0][0] > r[1][1] && r[0][0] > r[2][2] )
+        {
+            const F32 x = std::sqrt( 1.f + r[0][0] - r[1][1] - r[2][2] ) * 0.5f;
+            ret._rotation = float4{ x, (r[0][1] + r[1][0]) / (4.f * x), (r[2][0] + r[0][2]) / (4.f * x), (r[1][2] - r[2][1]) / (4.f * x) };
+        }
+        else if ( r[1][1] > r[2][2] )
+        {
+            const F32 y = std::sqrt( 1.f + r[1][1] - r[0][0] - r[2][2] ) * 0.5f;
+            ret._rotation = float4{ (r[0][1] + r[1][0]) / (4.f * y), y, (r[1][2] + r[2][1]) / (4.f * y), (r[2][0] - r[0][2]) / (4.f * y) };
+        }
+        else
+        {
+            const F32 z = std::sqrt( 1.f + r[2][2] - r[0][0] - r[1][1] ) * 0.5f;
+            ret._rotation = float4{ (r[2][0] + r[0][2]) / (4.f * z), (r[1][2] + r[2][1]) / (4.f * z), z, (r[0][1] - r[1][0]) / (4.f * z) };
+        }
+        ret._rotation = Normalized( ret._rotation );
+
+        return ret;
+    }
+
+    template<typename T>
+    void WriteBlock( ByteBuffer& dataOut, const vector<T>& data )
+    {
+        if ( !data.empty() )
+        {
+            dataOut.append( data.data(), data.size() );
+        }
+    }
+
+    template<typename T>
+    void ReadBlock( ByteBuffer& dataIn, const size_t count, vector<T>& dataOut )
+    {
+        dataOut.resize( count );
+        if ( count > 0u )
+        {
+            dataIn.read( reinterpret_cast<Byte*>(dataOut.data()), count * sizeof( T ) );
+        }
+    }
+
+    /// Greedy curve reduction: starting from the last kept key, extend the segment for as long as every key it skips can be
+    /// reconstructed from the segment's end points. The first and last keys are always kept as they define the loop
+    template<typename Predicate>
+    void ReduceKeys( const U32 keyCount, vector<U32>& keptOut, Predicate&& canSkip )
+    {
+        keptOut.resize( 0 );
+        if ( keyCount == 0u )
+        {
+            return;
+        }
+
+        keptOut.push_back( 0u );
+
+        U32 anchor = 0u;
+        for ( U32 end = 2u; end < keyCount; ++end )
+        {
+            for ( U32 key = anchor + 1u; key < end; ++key )
+            {
+                if ( !canSkip( anchor, end, key ) )
+                {
+                    anchor = end - 1u;
+                    keptOut.push_back( anchor );
+                    break;
+                }
+            }
+        }
+
+        if ( keyCount > 1u )
+        {
+            keptOut.push_back( keyCount - 1u );
+        }
+    }
+}
+
+void AnimationPose::resize( const size_t boneCount, const size_t skinnedBoneCount )
+{
+    resizeLocal( boneCount );
+    _local.resize( boneCount, MAT4_IDENTITY );
+    _model.resize( boneCount, MAT4_IDENTITY );
+    _skinning.resize( skinnedBoneCount, MAT4_IDENTITY );
+}
+
+void AnimationPose::resizeLocal( const size_t boneCount )
+{
+    _posX.resize( boneCount, 0.f );   _posY.resize( boneCount, 0.f );   _posZ.resize( boneCount, 0.f );
+    _rotX.resize( boneCount, 0.f );   _rotY.resize( boneCount, 0.f );   _rotZ.resize( boneCount, 0.f );   _rotW.resize( boneCount, 1.f );
+    _scaleX.resize( boneCount, 1.f ); _scaleY.resize( boneCount, 1.f ); _scaleZ.resize( boneCount, 1.f );
+    _animated.resize( boneCount, 0u );
+}
+
+void AnimationSkeleton::build( const Bone& root )
+{
+    clear();
+
+    _skinnedBoneCount = root.hierarchyDepth();
+
+    // Depth first, so every bone is preceded by its parent and bones are found in the same order as Bone::find
+    vector<std::pair<const Bone*, U16>> stack;
+    stack.emplace_back( &root, INVALID_INDEX );
+    while ( !stack.empty() )
+    {
+        const auto [bone, parent] = stack.back();
+        stack.pop_back();
+
+        DIVIDE_ASSERT( _parents.size() < INVALID_INDEX );
+        DIVIDE_ASSERT( bone->_boneID == Bone::INVALID_BONE_IDX || bone->_boneID < _skinnedBoneCount );
+
+        const U16 index = to_U16( _parents.size() );
+        _parents.push_back( parent );
+        _boneIDs.push_back( bone->_boneID );
+        _nameHashes.push_back( bone->nameHash() );
+        _bindLocal.push_back( bone->_localTransform );
+        _offsets.push_back( bone->_offsetMatrix );
+
+        const vector<Bone_uptr>& children = bone->children();
+        for ( auto it = children.rbegin(); it != children.rend(); ++it )
+        {
+            stack.emplace_back( it->get(), index );
+        }
+    }
+
+    buildLookups();
+}
+
+void AnimationSkeleton::buildLookups()
+{
+    const size_t count = boneCount();
+
+    _depths.resize( count );
+    _boneIndexByNameHash.clear();
+    _boneIndexByNameHash.reserve( count );
+    _bindPose = {};
+    _bindPose.resizeLocal( count );
+
+    for ( U16 bone = 0u; bone < count; ++bone )
+    {
+        const U16 parent = _parents[bone];
+        DIVIDE_ASSERT( parent == INVALID_INDEX || parent < bone );
+
+        _depths[bone] = parent == INVALID_INDEX ? U8_ZERO : to_U8( std::min( _depths[parent] + 1, to_I32( U8_MAX ) ) );
+        // Keep the first match, same as Bone::find
+        _boneIndexByNameHash.emplace( _nameHashes[bone], bone );
+
+        const BindTransform bind = DecomposeBindTransform( _bindLocal[bone] );
+        _bindPose._posX[bone] = bind._position.x;
+        _bindPose._posY[bone] = bind._position.y;
+        _bindPose._posZ[bone] = bind._position.z;
+        _bindPose._rotX[bone] = bind._rotation.x;
+        _bindPose._rotY[bone] = bind._rotation.y;
+        _bindPose._rotZ[bone] = bind._rotation.z;
+        _bindPose._rotW[bone] = bind._rotation.w;
+        _bindPose._scaleX[bone] = bind._scale.x;
+        _bindPose._scaleY[bone] = bind._scale.y;
+        _bindPose._scaleZ[bone] = bind._scale.z;
+    }
+}
+
+void AnimationSkeleton::clear()
+{
+    _parents.clear();
+    _depths.clear();
+    _boneIDs.clear();
+    _nameHashes.clear();
+    _boneIndexByNameHash.clear();
+    _bindLocal.clear();
+    _offsets.clear();
+    _bindPose = {};
+    _skinnedBoneCount = 0u;
+}
+
+void AnimationSkeleton::save( ByteBuffer& dataOut ) const
+{
+    dataOut << BYTE_BUFFER_VERSION_SKELETON;
+    dataOut << to_U32( boneCount() );
+    dataOut << to_U32( _skinnedBoneCount );
+
+    WriteBlock( dataOut, _parents );
+    WriteBlock( dataOut, _boneIDs );
+    WriteBlock( dataOut, _nameHashes );
+    WriteBlock( dataOut, _bindLocal );
+    WriteBlock( dataOut, _offsets );
+}
+
+bool AnimationSkeleton::load( ByteBuffer& dataIn )
+{
+    clear();
+
+    auto tempVer = decltype(BYTE_BUFFER_VERSION_SKELETON){0};
+    dataIn >> tempVer;
+    if ( tempVer != BYTE_BUFFER_VERSION_SKELETON )
+    {
+        return false;
+    }
+
+    U32 count = 0u, skinnedCount = 0u;
+    dataIn >> count;
+    dataIn >> skinnedCount;
+    if ( count >= INVALID_INDEX || skinnedCount >= Bone::INVALID_BONE_IDX )
+    {
+        return false;
+    }
+
+    _skinnedBoneCount = skinnedCount;
+    ReadBlock( dataIn, count, _parents );
+    ReadBlock( dataIn, count, _boneIDs );
+    ReadBlock( dataIn, count, _nameHashes );
+    ReadBlock( dataIn, count, _bindLocal );
+    ReadBlock( dataIn, count, _offsets );
+
+    buildLookups();
+    return true;
+}
+
+void AnimationSkeleton::resetPose( AnimationPose& poseInOut ) const
+{
+    DIVIDE_ASSERT( poseInOut._posX.size() == boneCount() );
+
+    poseInOut._posX = _bindPose._posX;     poseInOut._posY = _bindPose._posY;     poseInOut._posZ = _bindPose._posZ;
+    poseInOut._rotX = _bindPose._rotX;     poseInOut._rotY = _bindPose._rotY;     poseInOut._rotZ = _bindPose._rotZ;     poseInOut._rotW = _bindPose._rotW;
+    poseInOut._scaleX = _bindPose._scaleX; poseInOut._scaleY = _bindPose._scaleY; poseInOut._scaleZ = _bindPose._scaleZ;
+    poseInOut._animated = _bindPose._animated;
+}
+
+U16 AnimationSkeleton::boneIndex( const U64 nameHash ) const noexcept
+{
+    const auto it = _boneIndexByNameHash.find( nameHash );
+    return it != _boneIndexByNameHash.cend() ? it->second : INVALID_INDEX;
+}
+
+void AnimationSkeleton::computeSkinning( AnimationPose& poseInOut ) const
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    const U32 count = to_U32( boneCount() );
+    DIVIDE_ASSERT( poseInOut._local.size() == count && poseInOut._skinning.size() == _skinnedBoneCount );
+
+    const __m128 one = _mm_set1_ps( 1.f );
+    const __m128 two = _mm_set1_ps( 2.f );
+
+    // Local matrices, 4 bones at a time. Same layout as AnimEvaluator::evaluate produces: rotation rows scaled per axis, translation in the last row
+    for ( U32 i = 0u; i < count; i += g_laneCount )
+    {
+        const U32 lanes = std::min( g_laneCount, count - i );
+
+        const __m128 qx = LoadLanes( &poseInOut._rotX[i], lanes ), qy = LoadLanes( &poseInOut._rotY[i], lanes );
+        const __m128 qz = LoadLanes( &poseInOut._rotZ[i], lanes ), qw = LoadLanes( &poseInOut._rotW[i], lanes );
+        const __m128 sx = LoadLanes( &poseInOut._scaleX[i], lanes ), sy = LoadLanes( &poseInOut._scaleY[i], lanes ), sz = LoadLanes( &poseInOut._scaleZ[i], lanes );
+
+        const __m128 xx = _mm_mul_ps( qx, qx ), yy = _mm_mul_ps( qy, qy ), zz = _mm_mul_ps( qz, qz );
+        const __m128 xy = _mm_mul_ps( qx, qy ), xz = _mm_mul_ps( qx, qz ), yz = _mm_mul_ps( qy, qz );
+        const __m128 xw = _mm_mul_ps( qx, qw ), yw = _mm_mul_ps( qy, qw ), zw = _mm_mul_ps( qz, qw );
+
+        __m128 row0[4] =
+        {
+            _mm_mul_ps( sx, _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( yy, zz ) ) ) ),
+            _mm_mul_ps( sx, _mm_mul_ps( two, _mm_add_ps( xy, zw ) ) ),
+            _mm_mul_ps( sx, _mm_mul_ps( two, _mm_sub_ps( xz, yw ) ) ),
+            _mm_setzero_ps()
+        };
+        __m128 row1[4] =
+        {
+            _mm_mul_ps( sy, _mm_mul_ps( two, _mm_sub_ps( xy, zw ) ) ),
+            _mm_mul_ps( sy, _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( xx, zz ) ) ) ),
+            _mm_mul_ps( sy, _mm_mul_ps( two, _mm_add_ps( yz, xw ) ) ),
+            _mm_setzero_ps()
+        };
+        __m128 row2[4] =
+        {
+            _mm_mul_ps( sz, _mm_mul_ps( two, _mm_add_ps( xz, yw ) ) ),
+            _mm_mul_ps( sz, _mm_mul_ps( two, _mm_sub_ps( yz, xw ) ) ),
+            _mm_mul_ps( sz, _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( xx, yy ) ) ) ),
+            _mm_setzero_ps()
+        };
+        __m128 row3[4] =
+        {
+            LoadLanes( &poseInOut._posX[i], lanes ),
+            LoadLanes( &poseInOut._posY[i], lanes ),
+            LoadLanes( &poseInOut._posZ[i], lanes ),
+            one
+        };
+
+        // Component-per-register to row-per-register: after this, element N of every row array is bone i + N
+        _MM_TRANSPOSE4_PS( row0[0], row0[1], row0[2], row0[3] );
+        _MM_TRANSPOSE4_PS( row1[0], row1[1], row1[2], row1[3] );
+        _MM_TRANSPOSE4_PS( row2[0], row2[1], row2[2], row2[3] );
+        _MM_TRANSPOSE4_PS( row3[0], row3[1], row3[2], row3[3] );
+
+        for ( U32 lane = 0u; lane < lanes; ++lane )
+        {
+            const U32 bone = i + lane;
+            mat4<F32>& local = poseInOut._local[bone];
+            if ( poseInOut._animated[bone] == 0u )
+            {
+                local = _bindLocal[bone];
+                continue;
+            }
+
+            _mm_storeu_ps( local.m[0], row0[lane] );
+            _mm_storeu_ps( local.m[1], row1[lane] );
+            _mm_storeu_ps( local.m[2], row2[lane] );
+            _mm_storeu_ps( local.m[3], row3[lane] );
+        }
+    }
+
+    computeSkinning( poseInOut._local, poseInOut._model, poseInOut._skinning );
+}
+
+void AnimationSkeleton::computeSkinning( const vector<mat4<F32>>& local, vector<mat4<F32>>& modelOut, vector<mat4<F32>>& skinningOut ) const
+{
+    const U32 count = to_U32( boneCount() );
+    DIVIDE_ASSERT( local.size() == count && modelOut.size() == count && skinningOut.size() == _skinnedBoneCount );
+
+    // Parents come first, so a single pass concatenates the whole hierarchy
+    for ( U32 bone = 0u; bone < count; ++bone )
+    {
+        const U16 parent = _parents[bone];
+        if ( parent == INVALID_INDEX )
+        {
+            modelOut[bone] = local[bone];
+        }
+        else
+        {
+            // local * parent
+            mat4<F32>::Multiply( modelOut[parent], local[bone], modelOut[bone] );
+        }
+
+        const U8 boneID = _boneIDs[bone];
+        if ( boneID != Bone::INVALID_BONE_IDX )
+        {
+            // offset * model
+            mat4<F32>::Multiply( modelOut[bone], _offsets[bone], skinningOut[boneID] );
+        }
+    }
+}
+
+void CompressedAnimation::build( const vector<AnimationChannel>& channels, const D64 duration, const AnimationSkeleton& skeleton, const AnimationCompressionSettings& settings )
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    clear();
+    _duration = duration;
+
+    vector<SourceKey> keys;
+    for ( const AnimationChannel& channel : channels )
+    {
+        const U16 bone = skeleton.boneIndex( channel._nameKey );
+        if ( bone == AnimationSkeleton::INVALID_INDEX )
+        {
+            // AnimEvaluator::evaluate skips these as well
+            continue;
+        }
+
+        BoneTracks& tracks = _bones.emplace_back();
+        tracks._bone = bone;
+        tracks._depth = skeleton.depth( bone );
+
+        keys.resize( 0 );
+        for ( const aiVectorKey& key : channel._positionKeys )
+        {
+            keys.push_back( { key.mTime, { key.mValue.x, key.mValue.y, key.mValue.z, 0.f } } );
+        }
+        addVectorTrack( keys, settings._positionTolerance, true, tracks._position );
+
+        keys.resize( 0 );
+        for ( const aiQuatKey& key : channel._rotationKeys )
+        {
+            keys.push_back( { key.mTime, { key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w } } );
+        }
+        addRotationTrack( keys, settings._rotationTolerance, tracks._rotation );
+
+        keys.resize( 0 );
+        for ( const aiVectorKey& key : channel._scalingKeys )
+        {
+            keys.push_back( { key.mTime, { key.mValue.x, key.mValue.y, key.mValue.z, 0.f } } );
+        }
+        addVectorTrack( keys, settings._scaleTolerance, false, tracks._scaling );
+    }
+}
+
+void CompressedAnimation::clear()
+{
+    _bones.clear();
+    _keyTimes.clear();
+    _keyValues.clear();
+    _sourceKeyCount = 0u;
+    _duration = 0.0;
+}
+
+U16 CompressedAnimation::quantizeTime( const D64 time ) const noexcept
+{
+    return duration() > 0.0 ? to_U16( std::lround( std::clamp( time / duration(), 0.0, 1.0 ) * g_timeRange ) ) : 0u;
+}
+
+void CompressedAnimation::addVectorTrack( const vector<SourceKey>& keys, const F32 tolerance, const bool interpolated, Track& trackOut )
+{
+    const U32 keyCount = to_U32( keys.size() );
+
+    trackOut._firstKey = to_U32( _keyTimes.size() );
+    trackOut._keyCount = 0u;
+    _sourceKeyCount += keyCount;
+
+    if ( keyCount == 0u )
+    {
+        return;
+    }
+
+    float3 min{ keys[0]._value[0], keys[0]._value[1], keys[0]._value[2] };
+    float3 max = min;
+    for ( const SourceKey& key : keys )
+    {
+        for ( U8 c = 0u; c < 3u; ++c )
+        {
+            min[c] = std::min( min[c], key._value[c] );
+            max[c] = std::max( max[c], key._value[c] );
+        }
+    }
+
+    trackOut._min = min;
+    for ( U8 c = 0u; c < 3u; ++c )
+    {
+        trackOut._step[c] = (max[c] - min[c]) / g_vectorRange;
+    }
+
+    // Reduce using the quantized values so the tolerance holds for what actually gets sampled
+    vector<U16> times( keyCount ), quantized( keyCount * 3u );
+    vector<float3> values( keyCount );
+    for ( U32 k = 0u; k < keyCount; ++k )
+    {
+        times[k] = quantizeTime( keys[k]._time );
+        for ( U8 c = 0u; c < 3u; ++c )
+        {
+            const F32 step = trackOut._step[c];
+            const U16 value = step > 0.f ? to_U16( std::lround( (keys[k]._value[c] - min[c]) / step ) ) : 0u;
+            quantized[k * 3u + c] = value;
+            values[k][c] = min[c] + value * step;
+        }
+    }
+
+    vector<U32> kept;
+    if ( interpolated )
+    {
+        ReduceKeys( keyCount, kept, [&]( const U32 start, const U32 end, const U32 key )
+        {
+            const float3 expected = Interpolate( values[start], values[end], SegmentFactor( times[key], times[start], times[end] ) );
+            return MaxDifference( expected, values[key] ) <= tolerance;
+        });
+    }
+    else
+    {
+        // Stepped: a key is only needed if it changes the value
+        kept.push_back( 0u );
+        for ( U32 k = 1u; k < keyCount; ++k )
+        {
+            if ( MaxDifference( values[k], values[kept.back()] ) > tolerance )
+            {
+                kept.push_back( k );
+            }
+        }
+    }
+
+    // Constant tracks only need a single key
+    const bool constant = eastl::all_of( values.cbegin(), values.cend(), [&]( const float3& value ) { return MaxDifference( value, values.front() ) <= tolerance; } );
+    if ( constant )
+    {
+        kept.resize( 1u );
+    }
+
+    for ( const U32 k : kept )
+    {
+        _keyTimes.push_back( times[k] );
+        _keyValues.insert( _keyValues.end(), quantized.begin() + k * 3u, quantized.begin() + k * 3u + 3u );
+    }
+    trackOut._keyCount = to_U32( kept.size() );
+}
+
+void CompressedAnimation::addRotationTrack( const vector<SourceKey>& keys, const F32 tolerance, Track& trackOut )
+{
+    const U32 keyCount = to_U32( keys.size() );
+
+    trackOut._firstKey = to_U32( _keyTimes.size() );
+    trackOut._keyCount = 0u;
+    _sourceKeyCount += keyCount;
+
+    if ( keyCount == 0u )
+    {
+        return;
+    }
+
+    vector<U16> times( keyCount ), quantized( keyCount * 3u );
+    vector<float4> values( keyCount );
+    for ( U32 k = 0u; k < keyCount; ++k )
+    {
+        times[k] = quantizeTime( keys[k]._time );
+        EncodeRotation( Normalized( float4{ keys[k]._value[0], keys[k]._value[1], keys[k]._value[2], keys[k]._value[3] } ), &quantized[k * 3u] );
+        values[k] = DecodeRotation( &quantized[k * 3u] );
+    }
+
+    vector<U32> kept;
+    ReduceKeys( keyCount, kept, [&]( const U32 start, const U32 end, const U32 key )
+    {
+        const float4 expected = Interpolate( values[start], values[end], SegmentFactor( times[key], times[start], times[end] ) );
+        return AngleBetween( expected, values[key] ) <= tolerance;
+    });
+
+    const bool constant = eastl::all_of( values.cbegin(), values.cend(), [&]( const float4& value ) { return AngleBetween( value, values.front() ) <= tolerance; } );
+    if ( constant )
+    {
+        kept.resize( 1u );
+    }
+
+    for ( const U32 k : kept )
+    {
+        _keyTimes.push_back( times[k] );
+        _keyValues.insert( _keyValues.end(), quantized.begin() + k * 3u, quantized.begin() + k * 3u + 3u );
+    }
+    trackOut._keyCount = to_U32( kept.size() );
+}
+
+U32 CompressedAnimation::findKey( const Track& track, const F32 time ) const noexcept
+{
+    const U16* first = _keyTimes.data() + track._firstKey;
+    const U16* last = first + track._keyCount;
+    const U16* it = std::upper_bound( first, last, time, []( const F32 lhs, const U16 rhs ) noexcept { return lhs < rhs; } );
+
+    return track._firstKey + (it == first ? 0u : to_U32( it - first ) - 1u);
+}
+
+F32 CompressedAnimation::segmentFactor( const Track& track, const U32 key, const F32 time, U32& nextKeyOut ) const noexcept
+{
+    nextKeyOut = track._firstKey + (key - track._firstKey + 1u) % track._keyCount;
+
+    const F32 keyTime = _keyTimes[key];
+    F32 segmentLength = _keyTimes[nextKeyOut] - keyTime;
+    if ( segmentLength < 0.f )
+    {
+        segmentLength += g_timeRange;
+    }
+
+    return segmentLength > 0.f ? std::clamp( (time - keyTime) / segmentLength, 0.f, 1.f ) : 0.f;
+}
+
+float3 CompressedAnimation::decodeVector( const Track& track, const U32 key ) const noexcept
+{
+    const U16* values = &_keyValues[key * 3u];
+    return float3
+    {
+        track._min.x + values[0] * track._step.x,
+        track._min.y + values[1] * track._step.y,
+        track._min.z + values[2] * track._step.z
+    };
+}
+
+float4 CompressedAnimation::decodeRotation( const U32 key ) const noexcept
+{
+    return DecodeRotation( &_keyValues[key * 3u] );
+}
+
+void CompressedAnimation::sample( const D64 timeTicks, AnimationPose& poseInOut, const U8 maxBoneDepth ) const
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    const F32 time = duration() > 0.0 ? to_F32( std::clamp( timeTicks / duration(), 0.0, 1.0 ) * g_timeRange ) : 0.f;
+
+    // Bones skipped because of maxBoneDepth keep whatever the previous sample left in the pose. Every other bone is either sampled below or reset to its bind pose
+    constexpr U8 keepBone = 2u;
+    if ( maxBoneDepth != U8_MAX )
+    {
+        for ( const BoneTracks& tracks : _bones )
+        {
+            if ( tracks._depth > maxBoneDepth && poseInOut._animated[tracks._bone] != 0u )
+            {
+                poseInOut._animated[tracks._bone] = keepBone;
+            }
+        }
+    }
+    for ( U8& animated : poseInOut._animated )
+    {
+        animated = animated == keepBone ? 1u : 0u;
+    }
+
+    for ( const BoneTracks& tracks : _bones )
+    {
+        if ( tracks._depth > maxBoneDepth )
+        {
+            continue;
+        }
+
+        const U16 bone = tracks._bone;
+        poseInOut._animated[bone] = 1u;
+
+        float3 position = VECTOR3_ZERO;
+        if ( tracks._position._keyCount > 0u )
+        {
+            U32 next = 0u;
+            const U32 key = findKey( tracks._position, time );
+            const F32 factor = segmentFactor( tracks._position, key, time, next );
+            position = Interpolate( decodeVector( tracks._position, key ), decodeVector( tracks._position, next ), factor );
+        }
+
+        float4 rotation{ 0.f, 0.f, 0.f, 1.f };
+        if ( tracks._rotation._keyCount > 0u )
+        {
+            U32 next = 0u;
+            const U32 key = findKey( tracks._rotation, time );
+            const F32 factor = segmentFactor( tracks._rotation, key, time, next );
+            rotation = Interpolate( decodeRotation( key ), decodeRotation( next ), factor );
+        }
+
+        float3 scale = VECTOR3_UNIT;
+        if ( tracks._scaling._keyCount > 0u )
+        {
+            scale = decodeVector( tracks._scaling, findKey( tracks._scaling, time ) );
+        }
+
+        poseInOut._posX[bone] = position.x;
+        poseInOut._posY[bone] = position.y;
+        poseInOut._posZ[bone] = position.z;
+        poseInOut._rotX[bone] = rotation.x;
+        poseInOut._rotY[bone] = rotation.y;
+        poseInOut._rotZ[bone] = rotation.z;
+        poseInOut._rotW[bone] = rotation.w;
+        poseInOut._scaleX[bone] = scale.x;
+        poseInOut._scaleY[bone] = scale.y;
+        poseInOut._scaleZ[bone] = scale.z;
+    }
+}
+
+size_t CompressedAnimation::memoryUsage() const noexcept
+{
+    return _bones.size() * sizeof( BoneTracks ) + (_keyTimes.size() + _keyValues.size()) * sizeof( U16 );
+}
+
+} //namespace Divide
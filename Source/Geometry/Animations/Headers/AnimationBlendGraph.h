@@ -0,0 +1,116 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_ANIMATION_BLEND_GRAPH_H_
+#define DVD_ANIMATION_BLEND_GRAPH_H_
+
+#include "CompressedAnimation.h"
+
+namespace Divide
+{
+
+enum class AnimationBlendNodeType : U8
+{
+    /// Samples a single animation
+    CLIP = 0,
+    /// Interpolates between two poses: positions and scales are lerped, rotations nlerped along the shortest path
+    BLEND,
+    /// Adds the difference between a layer and its reference pose (e.g. the layer's first frame) on top of a base pose
+    ADDITIVE,
+    /// Same as BLEND, but every bone's weight is scaled by a per-bone mask (e.g. upper body only)
+    MASK,
+    COUNT
+};
+
+/// Per-bone weights, in AnimationSkeleton order
+struct AnimationBoneMask
+{
+    vector<F32> _weights;
+
+    /// Sets the weight of the given bone and of every bone below it
+    void set( const AnimationSkeleton& skeleton, U64 boneNameHash, F32 weight );
+};
+
+struct AnimationBlendNode
+{
+    static constexpr U16 INVALID_INPUT = U16_MAX;
+
+    AnimationBlendNodeType _type{ AnimationBlendNodeType::CLIP };
+    /// CLIP: the animation's time is (graph time - _startTimeS) * _speed
+    U32 _animationIndex{ 0u };
+    D64 _startTimeS{ 0.0 };
+    F32 _speed{ 1.f };
+    /// BLEND and MASK: how much of the second input replaces the first one. ADDITIVE: how much of the layer gets added
+    F32 _weight{ 1.f };
+    /// BLEND and MASK: { from, to }. ADDITIVE: { base, layer, reference }
+    std::array<U16, 3> _inputs{ INVALID_INPUT, INVALID_INPUT, INVALID_INPUT };
+    /// MASK only: index of the mask in the graph
+    U16 _mask{ INVALID_INPUT };
+};
+
+/// A small pose blend tree stored as a flat array. Nodes can only use nodes added before them as inputs, so a single
+/// forward pass evaluates the whole graph. The last node added is the output. Nodes are cheap to tweak between
+/// evaluations (e.g. a cross-fade only updates a BLEND node's weight every frame).
+class AnimationBlendGraph
+{
+  public:
+    /// Resets the pose to the bind pose and samples an animation's local transforms into it, at the given time (in seconds)
+    using ClipSampler = DELEGATE<void, U32 /*animationIndex*/, D64 /*timeS*/, AnimationPose& /*poseInOut*/>;
+
+    U16 addClip( U32 animationIndex, F32 speed = 1.f, D64 startTimeS = 0.0 );
+    U16 addBlend( U16 from, U16 to, F32 weight );
+    U16 addAdditive( U16 base, U16 layer, U16 reference, F32 weight = 1.f );
+    U16 addMask( U16 from, U16 to, U16 mask, F32 weight = 1.f );
+    U16 addBoneMask( AnimationBoneMask&& mask );
+
+    void clear();
+
+    /// Evaluates every node in order. Intermediate results go into scratchPoses (resized as needed, reuse it between calls to avoid allocations),
+    /// the output node writes straight into poseOut. Only the sampled values are written: call AnimationSkeleton::computeSkinning afterwards
+    void evaluate( const AnimationSkeleton& skeleton, D64 timeS, const ClipSampler& sampler, vector<AnimationPose>& scratchPoses, AnimationPose& poseOut ) const;
+
+    [[nodiscard]] AnimationBlendNode& node( const U16 index ) noexcept { return _nodes[index]; }
+    [[nodiscard]] const AnimationBlendNode& node( const U16 index ) const noexcept { return _nodes[index]; }
+    [[nodiscard]] size_t nodeCount() const noexcept { return _nodes.size(); }
+    [[nodiscard]] bool empty() const noexcept { return _nodes.empty(); }
+
+  private:
+    U16 addNode( const AnimationBlendNode& node );
+
+  private:
+    vector<AnimationBlendNode> _nodes;
+    vector<AnimationBoneMask> _masks;
+};
+
+} //namespace Divide
+
+#endif //DVD_ANIMATION_BLEND_GRAPH_H_
@@ -38,6 +38,7 @@
 #define ANIMATION_EVALUATOR_H_
 
 #include "Bone.h"
+#include "CompressedAnimation.h"
 #include <assimp/anim.h>
 #include "Platform/Video/Buffers/ShaderBuffer/Headers/ShaderBuffer.h"
 
@@ -92,6 +93,9 @@ class AnimEvaluator
     explicit AnimEvaluator(const aiAnimation* pAnim, U32 idx) noexcept;
 
     void evaluate(D64 dt, Bone& skeleton);
+    /// Same as above, for a flattened skeleton: writes every animated bone's local transform into localTransformsInOut (one entry per skeleton bone).
+    /// Bones without a channel are left untouched, so start from AnimationSkeleton::bindLocal()
+    void evaluate(D64 dt, const AnimationSkeleton& skeleton, vector<mat4<F32>>& localTransformsInOut);
 
     [[nodiscard]] FrameIndex frameIndexAt(D64 elapsedTimeS, bool forward) const noexcept;
 
@@ -112,7 +116,7 @@ class AnimEvaluator
     [[nodiscard]] bool initBuffers(GFXDevice& context, bool useDualQuaternions);
 
     static void save(const AnimEvaluator& evaluator, ByteBuffer& dataOut);
-    static void load(AnimEvaluator& evaluator, ByteBuffer& dataIn);
+    [[nodiscard]] static bool load(AnimEvaluator& evaluator, ByteBuffer& dataIn);
 
     PROPERTY_RW(D64, ticksPerSecond, 0.0);
     PROPERTY_R_IW(D64, duration, 0.0);
@@ -121,6 +125,14 @@ class AnimEvaluator
     PROPERTY_R(U32, frameCount, 0u);
 
     [[nodiscard]] inline ShaderBuffer* boneBuffer() const { return _boneBuffer.get(); }
+    [[nodiscard]] inline const vector<AnimationChannel>& channels() const noexcept { return _channels; }
+    /// Only built if the owning SceneAnimator samples animations at runtime instead of baking them
+    [[nodiscard]] inline const CompressedAnimation& compressedAnimation() const noexcept { return _compressedAnimation; }
+
+   protected:
+    /// resolveBone(channel) returns the matrix the channel's local transform goes into (or nullptr to skip the channel)
+    template<typename BoneResolver>
+    void evaluateChannels(D64 dt, BoneResolver&& resolveBone);
 
    protected:
     /// Array to return transformations results inside.
@@ -130,6 +142,8 @@ class AnimEvaluator
     vector<uint3> _lastPositions;
     /// vector that holds all bone channels
     vector<AnimationChannel> _channels;
+    /// Quantized and reduced copy of _channels
+    CompressedAnimation _compressedAnimation;
     /// GPU buffer to hold bone transforms
     ShaderBuffer_uptr _boneBuffer = nullptr;
     D64 _lastTime = 0.0;
@@ -141,11 +155,16 @@ namespace Attorney
     {
         static void frameCount(AnimEvaluator& animation, const U32 frameCount)
         {
-            DIVIDE_ASSERT(frameCount == animation._transformMatrices.size());
+            DIVIDE_ASSERT(animation._transformMatrices.empty() || frameCount == animation._transformMatrices.size());
 
             animation._frameCount = frameCount;
         }
 
+        static void compress(AnimEvaluator& animation, const AnimationSkeleton& skeleton)
+        {
+            animation._compressedAnimation.build(animation._channels, animation.duration(), skeleton, {});
+        }
+
         friend class Divide::SceneAnimator;
     };
 }
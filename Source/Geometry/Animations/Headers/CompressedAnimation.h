@@ -0,0 +1,195 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_COMPRESSED_ANIMATION_H_
+#define DVD_COMPRESSED_ANIMATION_H_
+
+#include "Bone.h"
+
+namespace Divide
+{
+
+class ByteBuffer;
+struct AnimationChannel;
+
+/// Per-instance animation state: sampled local transforms (structure-of-arrays, one entry per skeleton bone) and the resulting matrices
+struct AnimationPose
+{
+    vector<F32> _posX, _posY, _posZ;
+    vector<F32> _rotX, _rotY, _rotZ, _rotW;
+    vector<F32> _scaleX, _scaleY, _scaleZ;
+    /// 1 if the sampled animation drives the bone, 0 if the bone stays in its bind pose
+    vector<U8> _animated;
+    vector<mat4<F32>> _local;
+    /// Bone space to model space
+    vector<mat4<F32>> _model;
+    /// offset * model, indexed by Bone::_boneID. Same layout as a baked animation frame
+    vector<mat4<F32>> _skinning;
+
+    void resize( size_t boneCount, size_t skinnedBoneCount );
+    /// Sampled values only. Enough for poses that get blended but never skinned
+    void resizeLocal( size_t boneCount );
+};
+
+/// The bone tree flattened into arrays. Parents are always stored before their children, so model space transforms are computed in a single forward pass.
+/// Once built, this is the only skeleton representation the SceneAnimator keeps around
+class AnimationSkeleton
+{
+  public:
+    static constexpr U16 INVALID_INDEX = U16_MAX;
+
+    void build( const Bone& root );
+    void clear();
+
+    /// Every array is written (and read back) as a single block. Lookups and the bind pose are rebuilt on load
+    void save( ByteBuffer& dataOut ) const;
+    /// Returns false (and leaves the skeleton empty) if the data was written by a different version of the format
+    [[nodiscard]] bool load( ByteBuffer& dataIn );
+
+    /// Sets every bone's sampled values to its bind pose transform and flags all of them as not animated
+    void resetPose( AnimationPose& poseInOut ) const;
+
+    /// Builds local matrices from the pose's sampled values (4 bones at a time), then concatenates them down the hierarchy and applies the bone offsets
+    void computeSkinning( AnimationPose& poseInOut ) const;
+    /// Concatenates the given local matrices (one per bone) down the hierarchy in a single forward pass and applies the bone offsets
+    void computeSkinning( const vector<mat4<F32>>& local, vector<mat4<F32>>& modelOut, vector<mat4<F32>>& skinningOut ) const;
+
+    [[nodiscard]] U16 boneIndex( U64 nameHash ) const noexcept;
+    [[nodiscard]] U8 boneID( const U16 bone ) const noexcept { return _boneIDs[bone]; }
+    [[nodiscard]] const mat4<F32>& offset( const U16 bone ) const noexcept { return _offsets[bone]; }
+    /// Local transform of every bone in its bind pose
+    [[nodiscard]] const vector<mat4<F32>>& bindLocal() const noexcept { return _bindLocal; }
+    [[nodiscard]] U16 parentIndex( const U16 bone ) const noexcept { return _parents[bone]; }
+    /// Number of ancestors of the given bone (0 for the root)
+    [[nodiscard]] U8 depth( const U16 bone ) const noexcept { return _depths[bone]; }
+    [[nodiscard]] size_t boneCount() const noexcept { return _parents.size(); }
+    [[nodiscard]] size_t skinnedBoneCount() const noexcept { return _skinnedBoneCount; }
+    [[nodiscard]] bool empty() const noexcept { return _parents.empty(); }
+
+  private:
+    /// Everything that isn't serialized: depths, the name lookup and the decomposed bind pose
+    void buildLookups();
+
+  private:
+    vector<U16> _parents;
+    vector<U8> _depths;
+    vector<U8> _boneIDs;
+    vector<U64> _nameHashes;
+    hashMap<U64, U16> _boneIndexByNameHash;
+    vector<mat4<F32>> _bindLocal;
+    /// _bindLocal split into position, rotation and scale, so that bones driven by only some of the blended animations have something to blend with
+    AnimationPose _bindPose;
+    vector<mat4<F32>> _offsets;
+    size_t _skinnedBoneCount{ 0u };
+};
+
+struct AnimationCompressionSettings
+{
+    /// Maximum error introduced by dropping a key, in model units
+    F32 _positionTolerance{ 1e-3f };
+    /// Maximum error introduced by dropping a key, in radians
+    F32 _rotationTolerance{ 1e-3f };
+    F32 _scaleTolerance{ 1e-3f };
+};
+
+/// Keyframes of an AnimEvaluator's channels, quantized and curve-reduced. Replaces per-frame baked matrices:
+/// instances sample it at any time stamp, so playback isn't limited to ANIMATION_TICKS_PER_SECOND steps.
+/// Every key is 8 bytes: time normalised to 16 bits + 3x16 bit values. Positions and scales are quantized over the track's range,
+/// rotations are stored as their smallest three components (15 bits each, the index of the dropped component goes in the top bits).
+/// Keys that can be interpolated from their neighbours within the tolerances in AnimationCompressionSettings are dropped.
+class CompressedAnimation
+{
+  public:
+    void build( const vector<AnimationChannel>& channels, D64 duration, const AnimationSkeleton& skeleton, const AnimationCompressionSettings& settings );
+    void clear();
+
+    /// Writes the local transform of every bone driven by this animation into the pose. Time is in ticks, in the [0, duration] range.
+    /// Follows AnimEvaluator::evaluate: positions and rotations are interpolated (wrapping around to the first key), scaling is stepped.
+    /// Bones deeper than maxBoneDepth in the hierarchy are skipped and keep the values the previous sample wrote (or their bind pose if it didn't drive them)
+    void sample( D64 timeTicks, AnimationPose& poseInOut, U8 maxBoneDepth = U8_MAX ) const;
+
+    [[nodiscard]] size_t memoryUsage() const noexcept;
+    [[nodiscard]] size_t keyCount() const noexcept { return _keyTimes.size(); }
+    [[nodiscard]] size_t sourceKeyCount() const noexcept { return _sourceKeyCount; }
+    [[nodiscard]] bool empty() const noexcept { return _bones.empty(); }
+
+    PROPERTY_R( D64, duration, 0.0 );
+
+  private:
+    struct Track
+    {
+        /// Dequantized value = _min + quantized value * _step (unused for rotations)
+        float3 _min;
+        float3 _step;
+        U32 _firstKey{ 0u };
+        U32 _keyCount{ 0u };
+    };
+
+    struct BoneTracks
+    {
+        Track _position;
+        Track _rotation;
+        Track _scaling;
+        U16 _bone{ AnimationSkeleton::INVALID_INDEX };
+        U8 _depth{ 0u };
+    };
+
+  private:
+    struct SourceKey
+    {
+        D64 _time{ 0.0 };
+        F32 _value[4]{ 0.f, 0.f, 0.f, 1.f };
+    };
+
+    /// Quantizes and reduces the keys and appends the remaining ones to the key arrays
+    void addVectorTrack( const vector<SourceKey>& keys, F32 tolerance, bool interpolated, Track& trackOut );
+    void addRotationTrack( const vector<SourceKey>& keys, F32 tolerance, Track& trackOut );
+
+    [[nodiscard]] U16 quantizeTime( D64 time ) const noexcept;
+    /// Last key at or before the given time (or the first key if there is none)
+    [[nodiscard]] U32 findKey( const Track& track, F32 time ) const noexcept;
+    /// Interpolation factor between the given key and the next one (wrapping around to the first key)
+    [[nodiscard]] F32 segmentFactor( const Track& track, U32 key, F32 time, U32& nextKeyOut ) const noexcept;
+    [[nodiscard]] float3 decodeVector( const Track& track, U32 key ) const noexcept;
+    [[nodiscard]] float4 decodeRotation( U32 key ) const noexcept;
+
+  private:
+    vector<BoneTracks> _bones;
+    vector<U16> _keyTimes;
+    /// 3 values per key
+    vector<U16> _keyValues;
+    size_t _sourceKeyCount{ 0u };
+};
+
+} //namespace Divide
+
+#endif //DVD_COMPRESSED_ANIMATION_H_
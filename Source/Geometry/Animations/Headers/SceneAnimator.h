@@ -38,6 +38,7 @@
 #define SCENE_ANIMATOR_H_
 
 #include "AnimationEvaluator.h"
+#include "AnimationBlendGraph.h"
 #include "Core/Math/Headers/Line.h"
 
 struct aiMesh;
@@ -59,6 +60,15 @@ class PlatformContext;
 
 FWD_DECLARE_MANAGED_CLASS( AnimEvaluator );
 
+enum class AnimationStorageMode : U8
+{
+    /// Every frame of every animation is computed at load time and uploaded to the GPU once. Memory: frames x bones x transform size
+    BAKED = 0,
+    /// Animations are kept as compressed keyframes. Every instance samples its own pose (at any time stamp) and uploads it
+    SAMPLED,
+    COUNT
+};
+
 class SceneAnimator
 {
     friend class Attorney::SceneAnimatorMeshImporter;
@@ -71,7 +81,7 @@ class SceneAnimator
     using LineCollection = vector<LineMap>;
 
    public:
-    explicit SceneAnimator(bool useDualQuat);
+    explicit SceneAnimator(bool useDualQuat, AnimationStorageMode storageMode = AnimationStorageMode::BAKED);
 
     ~SceneAnimator();
 
@@ -81,7 +91,8 @@ class SceneAnimator
     /// Frees all memory and initializes everything to a default state
     void release(bool releaseAnimations);
     void save(PlatformContext& context, ByteBuffer& dataOut) const;
-    void load(PlatformContext& context, ByteBuffer& dataIn);
+    /// Returns false if the data was written by a different version of the skeleton, animator or animation format. The animator is left empty in that case
+    [[nodiscard]] bool load(PlatformContext& context, ByteBuffer& dataIn);
 
     /// Lets the caller know if there is a skeleton present
     [[nodiscard]] bool hasSkeleton() const noexcept;
@@ -102,6 +113,18 @@ class SceneAnimator
 
     [[nodiscard]] const BoneMatrices& transformMatrices(const U32 animationIndex, const U32 index) const;
 
+    /// Samples the animation at the given time and computes the pose's skinning matrices. Only available in SAMPLED mode.
+    /// Bones deeper than maxBoneDepth in the hierarchy keep their previously sampled pose (cheaper poses for distant instances)
+    void samplePose(U32 animationIndex, D64 elapsedTimeS, bool forward, AnimationPose& poseInOut, U8 maxBoneDepth = U8_MAX) const;
+    /// Same as samplePose, but only resets the pose to the bind pose and samples the local transforms (no skinning matrices)
+    void sampleLocalPose(U32 animationIndex, D64 elapsedTimeS, bool forward, AnimationPose& poseInOut) const;
+    /// Evaluates a blend graph built from this animator's animations and computes the pose's skinning matrices. Only available in SAMPLED mode.
+    /// Every source pose starts from the bind pose, so blended poses always sample the whole skeleton
+    void evaluateBlendGraph(const AnimationBlendGraph& graph, D64 elapsedTimeS, bool forward, vector<AnimationPose>& scratchPoses, AnimationPose& poseInOut) const;
+
+    /// Skinning matrices of a single frame, in either storage mode. SAMPLED animations compute them into scratchPose
+    [[nodiscard]] const BoneMatrices& frameTransforms(U32 animationIndex, U32 frameIndex, AnimationPose& scratchPose) const;
+
     [[nodiscard]] const AnimEvaluator& animationByIndex(const U32 animationIndex) const;
 
     [[nodiscard]] AnimEvaluator& animationByIndex(const U32 animationIndex);
@@ -125,7 +148,6 @@ class SceneAnimator
     /// Get the bone's global transform
     [[nodiscard]] const mat4<F32>& boneOffsetTransform(const U64 boneNameHash);
 
-    [[nodiscard]] Bone* boneByNameHash(U64 nameHash) const;
     /// GetBoneIndex will return the index of the bone given its name.
     /// The index can be used to index directly into the vector returned from GetTransform
     [[nodiscard]] U8 boneIndexByNameHash(U64 nameHash) const;
@@ -136,24 +158,25 @@ class SceneAnimator
 
     [[nodiscard]] U8 boneCount() const noexcept;
 
+    [[nodiscard]] const AnimationSkeleton& skeletonLayout() const noexcept;
+
     PROPERTY_R(bool, useDualQuaternion, true);
+    PROPERTY_R(AnimationStorageMode, storageMode, AnimationStorageMode::BAKED);
 
    private:
     bool init(PlatformContext& context);
     void buildBuffers(GFXDevice& gfxDevice);
 
-    /// I/O operations
-    void  saveSkeleton(ByteBuffer& dataOut, const Bone& parentIn) const;
-    [[nodiscard]] Bone* loadSkeleton(ByteBuffer& dataIn,  Bone* parentIn);
-
     void calculate(U32 animationIndex, D64 pTime);
 
    private:
     /// Frame count of the longest registered animation
     U32 _maximumAnimationFrames = 0u;
-    /// Root node of the internal scene structure
-    Bone_uptr _skeleton = nullptr;
     U8        _skeletonDepthCache = 0u;
+    /// The skeleton, flattened into parent index ordered arrays. Replaces the Bone tree the importer builds
+    AnimationSkeleton _skeletonLayout;
+    /// Used by calculate() and by boneTransform() in SAMPLED mode
+    AnimationPose _scratchPose;
     /// A vector that holds each animation
     vector<AnimEvaluator_uptr> _animations;
     /// find animations quickly
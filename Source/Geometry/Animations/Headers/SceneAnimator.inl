@@ -38,7 +38,7 @@ namespace Divide
 
 inline bool SceneAnimator::hasSkeleton() const noexcept
 {
-    return _skeleton != nullptr;
+    return !_skeletonLayout.empty();
 }
 
 inline void SceneAnimator::adjustAnimationSpeedBy(const U32 animationIndex, const D64 percent)
@@ -135,6 +135,12 @@ inline const mat4<F32>& SceneAnimator::boneTransform(const U32 animationIndex, c
     if (bIndex != Bone::INVALID_BONE_IDX)
     {
         assert(animationIndex < _animations.size());
+        if (storageMode() == AnimationStorageMode::SAMPLED)
+        {
+            samplePose(animationIndex, dt, forward, _scratchPose);
+            return _scratchPose._skinning[bIndex];
+        }
+
         return _animations[animationIndex]->transformMatrices(dt, forward)[bIndex];
     }
 
@@ -144,10 +150,10 @@ inline const mat4<F32>& SceneAnimator::boneTransform(const U32 animationIndex, c
 
 inline const mat4<F32>& SceneAnimator::boneOffsetTransform(const U64 boneNameHash)
 {
-    const Bone* bone = boneByNameHash(boneNameHash);
-    if (bone != nullptr)
+    const U16 bone = _skeletonLayout.boneIndex(boneNameHash);
+    if (bone != AnimationSkeleton::INVALID_INDEX)
     {
-        _boneTransformCache = bone->_offsetMatrix;
+        _boneTransformCache = _skeletonLayout.offset(bone);
     }
 
     return _boneTransformCache;
@@ -163,6 +169,11 @@ inline U8 SceneAnimator::boneCount() const noexcept
     return to_U8(_skeletonDepthCache);
 }
 
+inline const AnimationSkeleton& SceneAnimator::skeletonLayout() const noexcept
+{
+    return _skeletonLayout;
+}
+
 } //namespace Divide
 
 #endif //SCENE_ANIMATOR_INL_
\ No newline at end of file
@@ -11,55 +11,26 @@
 namespace Divide
 {
     constexpr U16 BYTE_BUFFER_VERSION_ANIMATOR = 1u;
-    constexpr U16 BYTE_BUFFER_VERSION_SKELETON = 2u;
 
 namespace
 {
-    mat4<F32> GetBoneGlobalTransform(Bone& bone)
+    /// Elapsed time to animation ticks, wrapped around the animation's duration
+    D64 SampleTime(const AnimEvaluator& animation, const D64 elapsedTimeS, const bool forward) noexcept
     {
-        if (bone.parent() != nullptr)
+        const D64 duration = animation.compressedAnimation().duration();
+        if (duration <= 0.0)
         {
-            return bone._localTransform * GetBoneGlobalTransform(*bone.parent());
+            return 0.0;
         }
 
-        return bone._localTransform;
-    }
-
-    I32 CreateSkeleton(const Bone_uptr& piNode,
-                       const mat4<F32>& parent,
-                       vector<Line>& lines)
-    {
-        static Line s_line
-        {
-            ._positionStart = VECTOR3_ZERO,
-            ._positionEnd = VECTOR3_UNIT,
-            ._colourStart = DefaultColours::RED_U8,
-            ._colourEnd = DefaultColours::RED_U8,
-            ._widthStart = 2.0f,
-            ._widthEnd = 2.0f
-        };
-
-        const mat4<F32>& me = GetBoneGlobalTransform(*piNode);
-
-        if (piNode->parent())
-        {
-            Line& line = lines.emplace_back(s_line);
-            line._positionStart = parent.getRow(3).xyz;
-            line._positionEnd = me.getRow(3).xyz;
-        }
-
-        // render all child nodes
-        for (const Bone_uptr& bone : piNode->children())
-        {
-            CreateSkeleton(bone, me, lines);
-        }
-
-        return 1;
+        const D64 time = std::fmod(elapsedTimeS * animation.ticksPerSecond(), duration);
+        return forward ? time : duration - time;
     }
 }
 
-SceneAnimator::SceneAnimator(const bool useDualQuaternion)
+SceneAnimator::SceneAnimator(const bool useDualQuaternion, const AnimationStorageMode storageMode)
     : _useDualQuaternion(useDualQuaternion)
+    , _storageMode(storageMode)
 {
 }
 
@@ -70,7 +41,7 @@ SceneAnimator::~SceneAnimator()
 
 void SceneAnimator::release(const bool releaseAnimations)
 {
-    _skeleton.reset();
+    _skeletonLayout.clear();
 
     // this should clean everything up
     _skeletonLines.clear();
@@ -85,28 +56,16 @@ void SceneAnimator::release(const bool releaseAnimations)
     }
 }
 
-void UpdateTransformContainer(const Bone_uptr& node, BoneMatrices& containerOut)
-{
-    if ( node != nullptr)
-    {
-        if ( node->_boneID != Bone::INVALID_BONE_IDX)
-        {
-            containerOut[node->_boneID] = node->_offsetMatrix * GetBoneGlobalTransform(*node);
-        }
-
-        for (const Bone_uptr& child :  node->children())
-        {
-            UpdateTransformContainer(child, containerOut);
-        }
-    }
-}
-
 bool SceneAnimator::init([[maybe_unused]] PlatformContext& context)
 {
     Console::d_printfn(LOCALE_STR("LOAD_ANIMATIONS_BEGIN"));
 
     constexpr D64 timeStep = 1. / ANIMATION_TICKS_PER_SECOND;
 
+    _scratchPose.resize(_skeletonLayout.boneCount(), _skeletonLayout.skinnedBoneCount());
+
+    const bool bakeFrames = storageMode() == AnimationStorageMode::BAKED;
+
     const U32 animationCount = to_U32(_animations.size());
     _skeletonLines.resize(animationCount);
 
@@ -121,12 +80,20 @@ bool SceneAnimator::init([[maybe_unused]] PlatformContext& context)
         for (D64 ticks = 0; ticks < duration; ticks += tickStep)
         {
             dt += timeStep;
+            ++frameCount;
+
+            if (!bakeFrames)
+            {
+                continue;
+            }
+
             calculate(i, dt);
+            crtAnimation->transformMatrices().push_back(_scratchPose._skinning);
+        }
 
-            BoneMatrices& transformMatrices = crtAnimation->transformMatrices().emplace_back();
-            transformMatrices.resize(_skeletonDepthCache, MAT4_IDENTITY);
-            UpdateTransformContainer(_skeleton, transformMatrices);
-            ++frameCount;
+        if (!bakeFrames)
+        {
+            Attorney::AnimEvaluatorSceneAnimator::compress(*crtAnimation, _skeletonLayout);
         }
 
         _maximumAnimationFrames = std::max(crtAnimation->frameCount(), _maximumAnimationFrames);
@@ -160,6 +127,12 @@ bool SceneAnimator::init([[maybe_unused]] PlatformContext& context)
 
 void SceneAnimator::buildBuffers(GFXDevice& gfxDevice)
 {
+    if (storageMode() != AnimationStorageMode::BAKED)
+    {
+        // Sampled animations are uploaded per instance (see AnimationComponent)
+        return;
+    }
+
     // pay the cost upfront
     for (AnimEvaluator_uptr& crtAnimation : _animations)
     {
@@ -172,11 +145,11 @@ bool SceneAnimator::init( PlatformContext& context, Bone_uptr&& skeleton)
 {
     release(false);
 
+    // The bone tree is only needed to build the flattened skeleton. Everything else (baking, sampling, serialization) uses the latter
+    _skeletonLayout.build(*skeleton);
+    DIVIDE_ASSERT(_skeletonLayout.skinnedBoneCount() < U8_MAX, "SceneAnimator::init error: Too many bones for current node!");
 
-    _skeleton = MOV(skeleton);
-    _skeletonDepthCache = _skeleton->hierarchyDepth();
-
-    DIVIDE_ASSERT(_skeletonDepthCache < U8_MAX, "SceneAnimator::init error: Too many bones for current node!");
+    _skeletonDepthCache = to_U8(_skeletonLayout.skinnedBoneCount());
 
     return init(context);
 }
@@ -185,28 +158,87 @@ bool SceneAnimator::init( PlatformContext& context, Bone_uptr&& skeleton)
 // Calculates the node transformations for the scene.
 void SceneAnimator::calculate(const U32 animationIndex, const D64 pTime)
 {
-    DIVIDE_ASSERT(_skeleton != nullptr);
+    DIVIDE_ASSERT(hasSkeleton());
 
     if (animationIndex >= _animations.size())
     {
         return;  // invalid animation
     }
 
-    _animations[animationIndex]->evaluate(pTime, *_skeleton);
+    // Bones the animation doesn't drive stay in their bind pose
+    _scratchPose._local = _skeletonLayout.bindLocal();
+    _animations[animationIndex]->evaluate(pTime, _skeletonLayout, _scratchPose._local);
+    _skeletonLayout.computeSkinning(_scratchPose._local, _scratchPose._model, _scratchPose._skinning);
+}
+
+void SceneAnimator::samplePose(const U32 animationIndex, const D64 elapsedTimeS, const bool forward, AnimationPose& poseInOut, const U8 maxBoneDepth) const
+{
+    DIVIDE_ASSERT(storageMode() == AnimationStorageMode::SAMPLED && animationIndex < _animations.size());
+
+    if (poseInOut._local.size() != _skeletonLayout.boneCount())
+    {
+        poseInOut.resize(_skeletonLayout.boneCount(), _skeletonLayout.skinnedBoneCount());
+    }
+
+    const AnimEvaluator& animation = *_animations[animationIndex];
+    animation.compressedAnimation().sample(SampleTime(animation, elapsedTimeS, forward), poseInOut, maxBoneDepth);
+    _skeletonLayout.computeSkinning(poseInOut);
+}
+
+void SceneAnimator::sampleLocalPose(const U32 animationIndex, const D64 elapsedTimeS, const bool forward, AnimationPose& poseInOut) const
+{
+    DIVIDE_ASSERT(storageMode() == AnimationStorageMode::SAMPLED && animationIndex < _animations.size());
+
+    if (poseInOut._posX.size() != _skeletonLayout.boneCount())
+    {
+        poseInOut.resizeLocal(_skeletonLayout.boneCount());
+    }
+
+    // Blended poses may mix bones this animation drives with bones it doesn't, so the latter need their bind values
+    _skeletonLayout.resetPose(poseInOut);
+
+    const AnimEvaluator& animation = *_animations[animationIndex];
+    animation.compressedAnimation().sample(SampleTime(animation, elapsedTimeS, forward), poseInOut);
 }
 
-Bone* SceneAnimator::boneByNameHash(const U64 nameHash) const
+void SceneAnimator::evaluateBlendGraph(const AnimationBlendGraph& graph, const D64 elapsedTimeS, const bool forward, vector<AnimationPose>& scratchPoses, AnimationPose& poseInOut) const
 {
-    DIVIDE_ASSERT(_skeleton != nullptr);
+    DIVIDE_ASSERT(storageMode() == AnimationStorageMode::SAMPLED);
+
+    if (poseInOut._local.size() != _skeletonLayout.boneCount())
+    {
+        poseInOut.resize(_skeletonLayout.boneCount(), _skeletonLayout.skinnedBoneCount());
+    }
+
+    graph.evaluate(_skeletonLayout,
+                   elapsedTimeS,
+                   [this, forward](const U32 animationIndex, const D64 timeS, AnimationPose& pose)
+                   {
+                       sampleLocalPose(animationIndex, timeS, forward, pose);
+                   },
+                   scratchPoses,
+                   poseInOut);
 
-    return _skeleton->find(nameHash);
+    _skeletonLayout.computeSkinning(poseInOut);
+}
+
+const BoneMatrices& SceneAnimator::frameTransforms(const U32 animationIndex, const U32 frameIndex, AnimationPose& scratchPose) const
+{
+    if (storageMode() == AnimationStorageMode::BAKED)
+    {
+        return transformMatrices(animationIndex, frameIndex);
+    }
+
+    // Same time stamps init() bakes frames at
+    samplePose(animationIndex, (frameIndex + 1u) / to_D64(ANIMATION_TICKS_PER_SECOND), true, scratchPose);
+    return scratchPose._skinning;
 }
 
 U8 SceneAnimator::boneIndexByNameHash(const U64 nameHash) const
 {
-    const Bone* bone = boneByNameHash(nameHash);
+    const U16 bone = _skeletonLayout.boneIndex(nameHash);
 
-    return bone != nullptr ? bone->_boneID : Bone::INVALID_BONE_IDX;
+    return bone != AnimationSkeleton::INVALID_INDEX ? _skeletonLayout.boneID(bone) : Bone::INVALID_BONE_IDX;
 }
 
 /// Renders the current skeleton pose at time index dt
@@ -226,13 +258,33 @@ const vector<Line>& SceneAnimator::skeletonLines(const U32 animationIndex, const
 
     // create all the needed points
     vector<Line>& lines = _skeletonLinesContainer[vecIndex];
-    if (lines.empty() && _skeleton != nullptr)
+    if (lines.empty() && hasSkeleton())
     {
+        static Line s_line
+        {
+            ._positionStart = VECTOR3_ZERO,
+            ._positionEnd = VECTOR3_UNIT,
+            ._colourStart = DefaultColours::RED_U8,
+            ._colourEnd = DefaultColours::RED_U8,
+            ._widthStart = 2.0f,
+            ._widthEnd = 2.0f
+        };
+
         lines.reserve(boneCount());
         // Construct skeleton
         calculate(animationIndex, dt);
-        // Start with identity transform
-        CreateSkeleton(_skeleton, MAT4_IDENTITY, lines);
+
+        // One line from every bone's parent to the bone itself
+        for (U16 bone = 0u; bone < _skeletonLayout.boneCount(); ++bone)
+        {
+            const U16 parent = _skeletonLayout.parentIndex(bone);
+            if (parent != AnimationSkeleton::INVALID_INDEX)
+            {
+                Line& line = lines.emplace_back(s_line);
+                line._positionStart = _scratchPose._model[parent].getRow(3).xyz;
+                line._positionEnd = _scratchPose._model[bone].getRow(3).xyz;
+            }
+        }
     }
 
     return lines;
@@ -240,11 +292,8 @@ const vector<Line>& SceneAnimator::skeletonLines(const U32 animationIndex, const
 
 void SceneAnimator::save([[maybe_unused]] PlatformContext& context, ByteBuffer& dataOut) const
 {
-    // first recursively save the skeleton
-    if (_skeleton != nullptr)
-    {
-        saveSkeleton(dataOut, *_skeleton);
-    }
+    // first save the skeleton
+    _skeletonLayout.save(dataOut);
 
     dataOut << BYTE_BUFFER_VERSION_ANIMATOR;
 
@@ -258,18 +307,25 @@ void SceneAnimator::save([[maybe_unused]] PlatformContext& context, ByteBuffer&
     }
 }
 
-void SceneAnimator::load(PlatformContext& context, ByteBuffer& dataIn)
+bool SceneAnimator::load(PlatformContext& context, ByteBuffer& dataIn)
 {
     // make sure to clear this before writing new data
     release(true);
     assert(_animations.empty());
 
-    _skeleton.reset(loadSkeleton(dataIn, nullptr));
-    _skeletonDepthCache = to_U8(std::min(_skeleton->hierarchyDepth(), to_size(U8_MAX)));
+    if (!_skeletonLayout.load(dataIn))
+    {
+        return false;
+    }
+    _skeletonDepthCache = to_U8(std::min(_skeletonLayout.skinnedBoneCount(), to_size(U8_MAX)));
 
     auto tempVer = decltype(BYTE_BUFFER_VERSION_ANIMATOR){0};
     dataIn >> tempVer;
-    DIVIDE_EXPECTED_CALL(tempVer == BYTE_BUFFER_VERSION_ANIMATOR);
+    if (tempVer != BYTE_BUFFER_VERSION_ANIMATOR)
+    {
+        release(true);
+        return false;
+    }
 
     // the number of animations
     U32 nsize = 0u;
@@ -279,71 +335,16 @@ void SceneAnimator::load(PlatformContext& context, ByteBuffer& dataIn)
     for (U32 idx = 0u; idx < nsize; ++idx)
     {
         _animations[idx] = std::make_unique<AnimEvaluator>();
-        AnimEvaluator::load(*_animations[idx], dataIn);
+        if (!AnimEvaluator::load(*_animations[idx], dataIn))
+        {
+            release(true);
+            return false;
+        }
         // get all the animation names so I can reference them by name and get the correct id
         insert(_animationNameToID, _ID(_animations[idx]->name().c_str()), idx);
     }
 
-    init(context);
-}
-
-void SceneAnimator::saveSkeleton(ByteBuffer& dataOut, const Bone& parent) const
-{
-    dataOut << BYTE_BUFFER_VERSION_SKELETON;
-
-    // the name of the bone
-    dataOut << parent.name();
-    // the bone offsets
-    dataOut << parent._offsetMatrix;
-    // original bind pose
-    dataOut << parent._localTransform;
-    // bone ID
-    dataOut << parent._boneID;
-
-    // number of children
-    const U32 nsize = to_U32(parent.children().size());
-    dataOut << nsize;
-    // continue for all children
-    for (const Bone_uptr& child : parent.children())
-    {
-        saveSkeleton(dataOut, *child);
-    }
-}
-
-Bone* SceneAnimator::loadSkeleton(ByteBuffer& dataIn, Bone* parentIn)
-{
-    auto tempVer = decltype(BYTE_BUFFER_VERSION_SKELETON){0};
-    dataIn >> tempVer;
-    DIVIDE_EXPECTED_CALL(tempVer == BYTE_BUFFER_VERSION_SKELETON);
-
-    string tempString;
-    // the name of the bone
-    dataIn >> tempString;
-    // create a node and set the parent, in the case this is the root node, it will be null
-    Bone* internalNode = new Bone(tempString, parentIn);
-
-    // the bone offsets
-    dataIn >> internalNode->_offsetMatrix;
-
-    // original bind pose
-    dataIn >> internalNode->_localTransform;
-
-    // bone ID
-    dataIn >> internalNode->_boneID;
-
-    // the number of children
-    U32 nsize = 0u;
-    dataIn >> nsize;
-
-    // recursively call this function on all children
-    // continue for all child nodes and assign the created internal nodes as our children
-    for (U32 a = 0u; a < nsize; a++)
-    {
-        Bone* crtNode = loadSkeleton(dataIn, internalNode);
-        DIVIDE_UNUSED(crtNode);
-    }
-
-    return internalNode;
+    return init(context);
 }
 
 } //namespace Divide
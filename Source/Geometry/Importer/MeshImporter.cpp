@@ -353,7 +353,9 @@ namespace Import
 
         mesh->renderState().drawState(true);
         mesh->geometryBuffer( tempMeshData._vertexBuffer );
-        mesh->setAnimationCount(tempMeshData._animationCount, tempMeshData._useDualQuatAnimation);
+        mesh->setAnimationCount(tempMeshData._animationCount,
+                                tempMeshData._useDualQuatAnimation,
+                                context.config().rendering.sampledAnimations ? AnimationStorageMode::SAMPLED : AnimationStorageMode::BAKED);
 
         std::atomic_uint taskCounter(0u);
 
@@ -410,19 +412,36 @@ namespace Import
             SceneAnimator* animator = mesh->getAnimator();
             DIVIDE_ASSERT(animator != nullptr);
 
-            // Animation versioning is handled internally.
+            // Animation versioning is handled internally. Outdated caches get rebuilt from the source asset
             ByteBuffer tempBuffer;
 
             const string saveFileName = Util::StringFormat( "{}.{}", tempMeshData.modelName(), g_parsedAssetAnimationExt );
+            bool animationsLoaded = false;
             if (context.config().debug.cache.enabled  &&
                 context.config().debug.cache.geometry &&
                 tempBuffer.loadFromFile(Paths::g_geometryCacheLocation, saveFileName ))
             {
-                animator->load(context, tempBuffer);
+                animationsLoaded = animator->load(context, tempBuffer);
+                if (!animationsLoaded)
+                {
+                    Console::warnfn(LOCALE_STR("ANIMATION_CACHE_OUTDATED"), tempMeshData.modelName());
+                }
+            }
+
+            if (!animationsLoaded && tempMeshData.loadedFromFile())
+            {
+                // The geometry cache doesn't store the skeleton or the animations, so those have to come from the source asset
+                Import::ImportData sourceData( tempMeshData.modelPath(), tempMeshData.modelName().c_str() );
+                if (DVDConverter::Load(context, sourceData))
+                {
+                    tempMeshData._skeleton = MOV(sourceData._skeleton);
+                    tempMeshData._animations = MOV(sourceData._animations);
+                }
             }
-            else
+
+            if (!animationsLoaded)
             {
-                if (!tempMeshData.loadedFromFile())
+                if (tempMeshData._skeleton != nullptr)
                 {
                     // We lose ownership of animations here ...
                     Attorney::SceneAnimatorMeshImporter::registerAnimations(*animator, tempMeshData._animations);
@@ -430,6 +449,7 @@ namespace Import
 
                     DIVIDE_EXPECTED_CALL( animator->init(context, MOV(tempMeshData._skeleton)) );
 
+                    tempBuffer.clear();
                     animator->save(context, tempBuffer);
                     if (!tempBuffer.dumpToFile(Paths::g_geometryCacheLocation, saveFileName ))
                     {
@@ -94,7 +94,7 @@ DEFINE_3D_OBJECT_TYPE(Mesh, SceneNodeType::TYPE_MESH)
     bool unload() override;
     void setMaterialTpl(Handle<Material> material) override;
 
-    void setAnimationCount(size_t count, bool useDualQuaternions);
+    void setAnimationCount(size_t count, bool useDualQuaternions, AnimationStorageMode storageMode);
 
     [[nodiscard]] SceneAnimator* getAnimator() const noexcept;
 
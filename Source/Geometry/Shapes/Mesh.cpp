@@ -40,7 +40,7 @@ void Mesh::setMaterialTpl( const Handle<Material> material)
     }
 }
 
-void Mesh::setAnimationCount( const size_t animationCount, const bool useDualQuaternions)
+void Mesh::setAnimationCount( const size_t animationCount, const bool useDualQuaternions, const AnimationStorageMode storageMode)
 {
     _animationCount = animationCount;
     if ( _animationCount == 0 && _animator != nullptr)
@@ -49,7 +49,7 @@ void Mesh::setAnimationCount( const size_t animationCount, const bool useDualQua
     }
     else if ( _animationCount > 0u && _animator == nullptr)
     {
-        _animator = std::make_unique<SceneAnimator>(useDualQuaternions);
+        _animator = std::make_unique<SceneAnimator>(useDualQuaternions, storageMode);
     }
 }
 
@@ -130,7 +130,9 @@ void SubMesh::buildBoundingBoxesForAnim([[maybe_unused]] const Task& parentTask,
         return;
     }
 
-    const vector<BoneMatrices>& currentAnimation = animComp->getAnimationByIndex(animationIndex).transformMatrices();
+    const SceneAnimator* animator = animComp->animator();
+    const U32 frameCount = animator->frameCount(animationIndex);
+    AnimationPose scratchPose;
 
     auto& parentVB = _parentMesh->geometryBuffer();
     const size_t partitionOffset = parentVB->getPartitionOffset(_geometryPartitionIDs[0]);
@@ -140,8 +142,10 @@ void SubMesh::buildBoundingBoxesForAnim([[maybe_unused]] const Task& parentTask,
     BoundingBox& currentBB = _boundingBoxes.at(animationIndex);
     currentBB.reset();
 
-    for (const BoneMatrices& matrices : currentAnimation)
+    for (U32 frame = 0u; frame < frameCount; ++frame)
     {
+        const BoneMatrices& matrices = animator->frameTransforms(animationIndex, frame, scratchPose);
+
         // loop through all vertex weights of all bones
         for (U32 j = 0u; j < partitionCount; ++j)
         {
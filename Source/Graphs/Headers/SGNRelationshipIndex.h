@@ -0,0 +1,117 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_SCENE_GRAPH_NODE_RELATIONSHIP_INDEX_H_
+#define DVD_SCENE_GRAPH_NODE_RELATIONSHIP_INDEX_H_
+
+namespace Divide
+{
+
+/// Scene wide ancestor/descendant index. Every node gets an [enter, exit] label pair from a depth first (Euler) tour of the hierarchy,
+/// so "A is an ancestor of B" becomes "A's interval encloses B's interval". Parent and sibling tests only compare parent IDs.
+/// Labels are spread out across the 64 bit range so that new nodes and moved subtrees can be slotted in between existing ones.
+/// Only if a gap runs out does the whole tour get relabeled.
+/// Tree roots (i.e. the scene graph's root node) never count as parents or grandparents, matching the old relationship cache.
+class SGNRelationshipIndex
+{
+  public:
+    using NodeID = U32;
+    static constexpr NodeID INVALID_NODE = U32_MAX;
+
+    enum class RelationshipType : U8
+    {
+        GRANDPARENT = 0, ///<applies for all levels above 0
+        PARENT,
+        CHILD,
+        GRANDCHILD,
+        SIBLING,
+        COUNT
+    };
+
+    SGNRelationshipIndex();
+
+    /// Registers a new node as the last child of the specified parent (or as a tree root if parent is INVALID_NODE)
+    [[nodiscard]] NodeID add( NodeID parent );
+    /// Unregisters the node. Any children it still has become tree roots
+    void remove( NodeID node );
+    /// Moves the node and its entire subtree to the end of newParent's child list (or makes it a tree root if newParent is INVALID_NODE)
+    void changeParent( NodeID node, NodeID newParent );
+    void clear();
+
+    /// Returns how target relates to node (e.g. CHILD if target is one of node's children) or COUNT if they are not related
+    [[nodiscard]] RelationshipType classify( NodeID node, NodeID target ) const;
+    [[nodiscard]] bool isRelated( NodeID node, NodeID target, RelationshipType type ) const;
+
+    [[nodiscard]] size_t size() const;
+    /// Checks that every label nests properly. Only meant for testing as it walks the entire hierarchy
+    [[nodiscard]] bool validate() const;
+
+  private:
+    struct Entry
+    {
+        U64 _enter{ 0u };
+        U64 _exit{ 0u };
+        NodeID _parent{ INVALID_NODE };
+        NodeID _firstChild{ INVALID_NODE };
+        NodeID _lastChild{ INVALID_NODE };
+        NodeID _prevSibling{ INVALID_NODE };
+        NodeID _nextSibling{ INVALID_NODE };
+    };
+
+    /// Parent of all tree roots. Spans the entire label range
+    static constexpr NodeID VIRTUAL_ROOT = 0u;
+
+    [[nodiscard]] bool isValidNode( NodeID node ) const noexcept;
+    /// Strict: a node is not its own ancestor
+    [[nodiscard]] bool isAncestor( NodeID ancestor, NodeID node ) const noexcept;
+    [[nodiscard]] RelationshipType classifyLocked( NodeID node, NodeID target ) const noexcept;
+
+    void link( NodeID node, NodeID parent );
+    void unlink( NodeID node );
+    [[nodiscard]] size_t subtreeSize( NodeID node ) const noexcept;
+    /// Assigns labels label + step, label + 2 * step, ... in depth first order to the subtree starting at node. Returns the last label used
+    U64 labelRange( NodeID node, U64 label, U64 step ) noexcept;
+    /// Labels the subtree starting at node using the free space after its previous sibling. Relabels everything if there isn't enough room
+    void labelSubtree( NodeID node );
+    /// Labels every node in a single pass with evenly spaced values
+    void relabel();
+
+  private:
+    mutable SharedMutex _lock;
+    vector<Entry> _entries;
+    vector<NodeID> _freeIDs;
+    size_t _nodeCount{ 0u };
+};
+
+} //namespace Divide
+
+#endif //DVD_SCENE_GRAPH_NODE_RELATIONSHIP_INDEX_H_
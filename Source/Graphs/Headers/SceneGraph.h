@@ -35,6 +35,10 @@
 
 #include "SceneNode.h"
 #include "IntersectionRecord.h"
+#include "SceneGraphNodeIndex.h"
+#include "SceneGraphBroadPhase.h"
+#include "SceneGraphCullingIndex.h"
+#include "SGNRelationshipIndex.h"
 #include "Scenes/Headers/SceneComponent.h"
 #include "Core/Headers/FrameListener.h"
 
@@ -75,6 +79,11 @@ class SceneGraph final : NonCopyable,
     const SceneGraphNode* getRoot() const noexcept { return _root; }
     SceneGraphNode* getRoot() noexcept { return _root; }
 
+    /// Hierarchy independent spatial index used by RenderPassCuller. Pending node changes get applied on use, hence mutable
+    [[nodiscard]] SceneGraphCullingIndex& cullingIndex() const noexcept { return _cullingIndex; }
+    /// Parent/child/sibling queries for SceneGraphNode::isRelated and isChild
+    [[nodiscard]] const SGNRelationshipIndex& relationshipIndex() const noexcept { return _relationshipIndex; }
+
     SceneGraphNode* findNode(const Str<128>& name, bool sceneNodeName = false) const;
     SceneGraphNode* findNode(U64 nameHash, bool sceneNodeName = false) const;
     SceneGraphNode* findNode(I64 guid) const;
@@ -142,8 +151,10 @@ class SceneGraph final : NonCopyable,
     void onNodeMoved(const SceneGraphNode& node);
     void onNodeDestroy(SceneGraphNode* oldNode);
     void onNodeAdd(SceneGraphNode* newNode);
+    /// Adds the node to the relationship index or moves it under its current parent if it's already there. Returns the node's relationship ID
+    SGNRelationshipIndex::NodeID registerRelationship(SceneGraphNode* node);
     void onNodeUpdated(const SceneGraphNode& node);
-    void onNodeSpatialChange(const SceneGraphNode& node);
+    void onNodeSpatialChange(SceneGraphNode& node);
 
     bool frameStarted(const FrameEvent& evt) override;
     bool frameEnded(const FrameEvent& evt) override;
@@ -161,7 +172,15 @@ class SceneGraph final : NonCopyable,
     vector<SceneGraphNode*> _nodeList;
     Mutex _intersectionsLock;
     IntersectionContainer _intersectionsCache;
+    /// Collision candidates for nodes that moved. Kept in sync by onNodeAdd/onNodeSpatialChange/onNodeDestroy
+    SceneGraphBroadPhase _broadPhase;
+    /// Kept in sync by onNodeAdd/onNodeSpatialChange/onNodeDestroy and visibility related flag changes
+    mutable SceneGraphCullingIndex _cullingIndex;
     std::array<vector<SceneGraphNode*>, to_base(SceneNodeType::COUNT)> _nodesByType;
+    /// GUID and name lookups for findNode. Kept in sync by onNodeAdd/onNodeDestroy
+    SceneGraphNodeIndex<SceneGraphNode> _nodeIndex;
+    /// Hierarchy labels for relationship queries. Kept in sync by onNodeAdd/onNodeDestroy
+    SGNRelationshipIndex _relationshipIndex;
 
     mutable Mutex _nodeCreateMutex;
     mutable SharedMutex _nodesByTypeLock;
@@ -202,11 +221,16 @@ class SceneGraphSGN
         sceneGraph->onNodeUpdated(node);
     }
 
-    static void onNodeSpatialChange(Divide::SceneGraph* sceneGraph, const SceneGraphNode& node)
+    static void onNodeSpatialChange(Divide::SceneGraph* sceneGraph, SceneGraphNode& node)
     {
         sceneGraph->onNodeSpatialChange(node);
     }
 
+    static void onNodeVisibilityFlagChange(Divide::SceneGraph* sceneGraph, SceneGraphNode* node)
+    {
+        sceneGraph->_cullingIndex.onNodeChanged(node);
+    }
+
     static void onNodeEvent(Divide::SceneGraph* sceneGraph, SceneGraphNode* node)
     {
         LockGuard<Mutex> w_lock(sceneGraph->_nodeEventLock);
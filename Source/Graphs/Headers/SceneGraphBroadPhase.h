@@ -0,0 +1,91 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_SCENE_GRAPH_BROAD_PHASE_H_
+#define DVD_SCENE_GRAPH_BROAD_PHASE_H_
+
+#include "IntersectionRecord.h"
+#include "Core/Math/BoundingVolumes/Headers/DynamicAABBTree.h"
+
+namespace Divide
+{
+
+class SceneGraphNode;
+class BoundsComponent;
+
+/// Collision broad phase for the scene graph. Nodes with collisions enabled are kept in one of two dynamic AABB trees
+/// (static and dynamic usage context) so a moving node only has to be tested against the nodes its bounds overlap instead of
+/// against the entire graph. Static nodes never get tested against each other as they only query the dynamic tree.
+/// Movement notifications may arrive from any thread. They are batched and only processed by findIntersections.
+class SceneGraphBroadPhase final : NonCopyable
+{
+  public:
+    /// Queue the node for a proxy update and an overlap query during the next findIntersections call
+    void onNodeMoved( const SceneGraphNode* node );
+    /// Must be called before the node's memory is released
+    void onNodeDestroyed( const SceneGraphNode* node );
+
+    /// Updates the proxies of every node that moved since the last call and appends a record for each overlapping pair
+    /// that involves at least one of them. Each pair is reported only once per call.
+    void findIntersections( IntersectionContainer& intersectionsOut );
+
+    void clear();
+
+    [[nodiscard]] size_t proxyCount() const;
+
+  private:
+    using Tree = DynamicAABBTree<BoundsComponent*>;
+
+    struct Proxy
+    {
+        Tree::ProxyID _id{ Tree::INVALID_PROXY };
+        bool _static{ false };
+    };
+
+    /// Creates, moves, re-parents (static <-> dynamic) or removes the node's proxy. Returns false if the node no longer collides
+    [[nodiscard]] bool updateProxy( const SceneGraphNode* node );
+    void destroyProxy( I64 guid );
+
+  private:
+    mutable Mutex _movedNodesLock;
+    vector<const SceneGraphNode*> _movedNodes;
+    vector<const SceneGraphNode*> _movedNodesTemp;
+
+    mutable Mutex _treeLock;
+    hashMap<I64, Proxy> _proxies;
+    Tree _staticTree;
+    Tree _dynamicTree;
+};
+
+} //namespace Divide
+
+#endif //DVD_SCENE_GRAPH_BROAD_PHASE_H_
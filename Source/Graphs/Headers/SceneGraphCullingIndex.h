@@ -0,0 +1,91 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_SCENE_GRAPH_CULLING_INDEX_H_
+#define DVD_SCENE_GRAPH_CULLING_INDEX_H_
+
+#include "Core/Math/BoundingVolumes/Headers/DynamicAABBTree.h"
+
+namespace Divide
+{
+
+class Frustum;
+class SceneGraphNode;
+
+/// Flat spatial index over the world space bounds of every renderable node, independent of the scene graph hierarchy.
+/// Nodes that must not be culled by bounds (no BoundsComponent, sky, VISIBILITY_LOCKED) are kept in a separate list and always returned.
+/// Container nodes are never returned, just like in the hierarchy walk.
+/// Changes may be reported from any thread. They are batched and applied on the next gatherCandidates call.
+class SceneGraphCullingIndex final : NonCopyable
+{
+  public:
+    /// Node was added, moved, resized or changed one of the flags the index cares about
+    void onNodeChanged( SceneGraphNode* node );
+    /// Must be called before the node's memory is released
+    void onNodeDestroyed( const SceneGraphNode* node );
+
+    void clear();
+
+    /// Appends every node whose (fat) bounds are not fully outside of the frustum. If frustum is null, returns every indexed node.
+    /// Candidates still need the regular per node cull test as the index only stores enlarged bounds
+    void gatherCandidates( const Frustum* frustum, vector<SceneGraphNode*>& candidatesOut );
+
+    [[nodiscard]] size_t nodeCount() const;
+
+  private:
+    using Tree = DynamicAABBTree<SceneGraphNode*>;
+
+    struct Entry
+    {
+        Tree::ProxyID _proxy{ Tree::INVALID_PROXY };
+        bool _alwaysVisible{ false };
+    };
+
+    void applyPendingChanges();
+    void updateEntry( SceneGraphNode* node );
+    void removeEntry( I64 guid, const SceneGraphNode* node );
+
+  private:
+    mutable Mutex _pendingLock;
+    vector<SceneGraphNode*> _pendingNodes;
+    vector<SceneGraphNode*> _pendingNodesTemp;
+    std::atomic_bool _hasPendingChanges{ false };
+
+    mutable SharedMutex _indexLock;
+    hashMap<I64, Entry> _entries;
+    vector<SceneGraphNode*> _alwaysVisible;
+    Tree _tree;
+};
+
+} //namespace Divide
+
+#endif //DVD_SCENE_GRAPH_CULLING_INDEX_H_
@@ -34,7 +34,7 @@
 #define DVD_SCENE_GRAPH_NODE_H_
 
 #include "SceneNodeFwd.h"
-#include "SGNRelationshipCache.h"
+#include "SGNRelationshipIndex.h"
 #include "IntersectionRecord.h"
 
 #include "ECS/Components/Headers/EditorComponent.h"
@@ -100,7 +100,6 @@ namespace Divide
         class SceneGraphNodeSceneGraph;
         class SceneGraphNodeRenderPassCuller;
         class SceneGraphNodeRenderPassManager;
-        class SceneGraphNodeRelationshipCache;
     };
 
     class SceneGraphNode final : public ECS::Entity<SceneGraphNode>,
@@ -113,7 +112,6 @@ namespace Divide
         friend class Attorney::SceneGraphNodeSceneGraph;
         friend class Attorney::SceneGraphNodeRenderPassCuller;
         friend class Attorney::SceneGraphNodeRenderPassManager;
-        friend class Attorney::SceneGraphNodeRelationshipCache;
 
         public:
 
@@ -176,7 +174,7 @@ namespace Divide
         /// Returns true if the current node is related somehow to the specified target node (see RelationshipType enum for more details)
         bool isRelated( const SceneGraphNode* target ) const;
         /// Returns true if the current node is related to the specified target node in the specified way (see RelationshipType enum for more details)
-        bool isRelated( const SceneGraphNode* target, SGNRelationshipCache::RelationshipType relationship ) const;
+        bool isRelated( const SceneGraphNode* target, SGNRelationshipIndex::RelationshipType relationship ) const;
 
         /// Returns true if the specified target node is a parent or grandparent(if recursive == true) of the current node
         bool isChild( const SceneGraphNode* target, bool recursive ) const;
@@ -267,9 +265,6 @@ namespace Divide
         /// Serialization: load from XML file (expressed as a boost property_tree)
         void loadFromXML( const boost::property_tree::ptree& pt );
 
-    protected:
-        void updateCollisions( const SceneGraphNode& parentNode, IntersectionContainer& intersections, Mutex& intersectionsLock ) const;
-
       private:
         /// Process any events that might of queued up during the ECS Update stages
         void processEvents();
@@ -302,8 +297,6 @@ namespace Divide
         static void PostLoad( SceneNode* sceneNode, SceneGraphNode* sgn );
         /// This indirect is used to avoid including ECS headers in this file, but we still need the ECS engine for templated methods
         ECS::ECSEngine& GetECSEngine() const noexcept;
-        /// Only called from withing "setParent()" (which is also called from "addChildNode()"). Used to mark the existing relationship cache as invalid.
-        void invalidateRelationshipCache( SceneGraphNode* source = nullptr );
         /// Changes this node's parent
         void setParentInternal();
 
@@ -319,7 +312,8 @@ namespace Divide
         SceneGraphNode* findChildByGraphNodeGUID(I64 GUID, bool recursive = false) const;
 
      private:
-        SGNRelationshipCache _relationshipCache;
+        /// Our entry in the scene graph's relationship index. Managed by the SceneGraph
+        SGNRelationshipIndex::NodeID _relationshipID{ SGNRelationshipIndex::INVALID_NODE };
         ChildContainer _children;
 
         // ToDo: Remove this HORRIBLE hack -Ionut
@@ -409,9 +403,10 @@ namespace Divide
             {
                 return node->loadCache( inputBuffer );
             }
-            static void updateCollisions( const SceneGraphNode& node, const SceneGraphNode& parentNode, IntersectionContainer& intersections, Mutex& intersectionsLock )
+
+            static SGNRelationshipIndex::NodeID& relationshipID( SceneGraphNode* node ) noexcept
             {
-                node.updateCollisions( parentNode, intersections, intersectionsLock );
+                return node->_relationshipID;
             }
             friend class Divide::SceneGraph;
         };
@@ -474,17 +469,6 @@ namespace Divide
             friend class Divide::RenderPassManager;
         };
 
-
-        class SceneGraphNodeRelationshipCache
-        {
-            static const SGNRelationshipCache& relationshipCache( const SceneGraphNode* node ) noexcept
-            {
-                return node->_relationshipCache;
-            }
-
-            friend class Divide::SGNRelationshipCache;
-        };
-
     };  // namespace Attorney
 
 
@@ -0,0 +1,166 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_SCENE_GRAPH_NODE_INDEX_H_
+#define DVD_SCENE_GRAPH_NODE_INDEX_H_
+
+namespace Divide
+{
+
+/// Thread safe lookup tables from a node's GUID, name hash and scene node (resource) name hash to the node itself.
+/// Names don't have to be unique, so a name lookup returns the earliest registered node that still carries that name.
+/// Templated on the node type only so that the lookup cost can be measured without building a full scene graph.
+template<typename Node>
+class SceneGraphNodeIndex
+{
+  public:
+    /// Registering the same GUID twice is a no-op (nodes get re-added when they change parents)
+    void add( I64 guid, U64 nameHash, U64 sceneNodeNameHash, Node* node );
+    void remove( I64 guid, U64 nameHash, U64 sceneNodeNameHash );
+    void clear();
+
+    [[nodiscard]] Node* find( I64 guid ) const;
+    [[nodiscard]] Node* findByName( U64 nameHash ) const;
+    [[nodiscard]] Node* findBySceneNodeName( U64 sceneNodeNameHash ) const;
+
+    [[nodiscard]] size_t size() const;
+
+  private:
+    using NodesByName = hashMap<U64, eastl::fixed_vector<Node*, 1, true>>;
+
+    static void AddByName( NodesByName& index, U64 nameHash, Node* node );
+    static void RemoveByName( NodesByName& index, U64 nameHash, Node* node );
+    [[nodiscard]] static Node* FindByName( const NodesByName& index, U64 nameHash );
+
+  private:
+    mutable SharedMutex _lock;
+    hashMap<I64, Node*> _nodesByGUID;
+    NodesByName _nodesByName;
+    NodesByName _nodesBySceneNodeName;
+};
+
+template<typename Node>
+void SceneGraphNodeIndex<Node>::add( const I64 guid, const U64 nameHash, const U64 sceneNodeNameHash, Node* node )
+{
+    LockGuard<SharedMutex> w_lock( _lock );
+    if ( _nodesByGUID.emplace( guid, node ).second )
+    {
+        AddByName( _nodesByName, nameHash, node );
+        AddByName( _nodesBySceneNodeName, sceneNodeNameHash, node );
+    }
+}
+
+template<typename Node>
+void SceneGraphNodeIndex<Node>::remove( const I64 guid, const U64 nameHash, const U64 sceneNodeNameHash )
+{
+    LockGuard<SharedMutex> w_lock( _lock );
+    const auto it = _nodesByGUID.find( guid );
+    if ( it != _nodesByGUID.end() )
+    {
+        RemoveByName( _nodesByName, nameHash, it->second );
+        RemoveByName( _nodesBySceneNodeName, sceneNodeNameHash, it->second );
+        _nodesByGUID.erase( it );
+    }
+}
+
+template<typename Node>
+void SceneGraphNodeIndex<Node>::clear()
+{
+    LockGuard<SharedMutex> w_lock( _lock );
+    _nodesByGUID.clear();
+    _nodesByName.clear();
+    _nodesBySceneNodeName.clear();
+}
+
+template<typename Node>
+Node* SceneGraphNodeIndex<Node>::find( const I64 guid ) const
+{
+    SharedLock<SharedMutex> r_lock( _lock );
+    const auto it = _nodesByGUID.find( guid );
+    return it != _nodesByGUID.cend() ? it->second : nullptr;
+}
+
+template<typename Node>
+Node* SceneGraphNodeIndex<Node>::findByName( const U64 nameHash ) const
+{
+    SharedLock<SharedMutex> r_lock( _lock );
+    return FindByName( _nodesByName, nameHash );
+}
+
+template<typename Node>
+Node* SceneGraphNodeIndex<Node>::findBySceneNodeName( const U64 sceneNodeNameHash ) const
+{
+    SharedLock<SharedMutex> r_lock( _lock );
+    return FindByName( _nodesBySceneNodeName, sceneNodeNameHash );
+}
+
+template<typename Node>
+size_t SceneGraphNodeIndex<Node>::size() const
+{
+    SharedLock<SharedMutex> r_lock( _lock );
+    return _nodesByGUID.size();
+}
+
+template<typename Node>
+void SceneGraphNodeIndex<Node>::AddByName( NodesByName& index, const U64 nameHash, Node* node )
+{
+    if ( nameHash != 0u )
+    {
+        index[nameHash].push_back( node );
+    }
+}
+
+template<typename Node>
+void SceneGraphNodeIndex<Node>::RemoveByName( NodesByName& index, const U64 nameHash, Node* node )
+{
+    const auto it = index.find( nameHash );
+    if ( it != index.end() )
+    {
+        auto& nodes = it->second;
+        nodes.erase( eastl::remove( nodes.begin(), nodes.end(), node ), nodes.end() );
+        if ( nodes.empty() )
+        {
+            index.erase( it );
+        }
+    }
+}
+
+template<typename Node>
+Node* SceneGraphNodeIndex<Node>::FindByName( const NodesByName& index, const U64 nameHash )
+{
+    const auto it = index.find( nameHash );
+    return it != index.cend() ? it->second.front() : nullptr;
+}
+
+} //namespace Divide
+
+#endif //DVD_SCENE_GRAPH_NODE_INDEX_H_
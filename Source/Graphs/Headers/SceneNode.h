@@ -64,11 +64,6 @@ struct RenderPackage;
 struct RenderStagePass;
 struct CameraSnapshot;
 
-namespace Networking
-{
-    struct NetworkPacket;
-};
-
 namespace GFX
 {
     struct DrawCommand;
@@ -148,8 +143,9 @@ class SceneNode : public CachedResource
     PROPERTY_RW(bool, rebuildDrawCommands, false);
 
    protected:
-     virtual void onNetworkSend(SceneGraphNode* sgn, Networking::NetworkPacket& dataOut) const;
-     virtual void onNetworkReceive(SceneGraphNode* sgn, Networking::NetworkPacket& dataIn) const;
+     /// Node specific replicated state. Sent as part of the (delta compressed) NetworkingComponent state
+     virtual void onNetworkSend(SceneGraphNode* sgn, ByteBuffer& dataOut) const;
+     virtual void onNetworkReceive(SceneGraphNode* sgn, ByteBuffer& dataIn) const;
 
    protected:
     std::unique_ptr<EditorComponent> _editorComponent;
@@ -193,12 +189,12 @@ class SceneNodeSceneGraph {
 
 class SceneNodeNetworkComponent
 {
-    static void onNetworkSend(SceneGraphNode* sgn, const SceneNode& node, Networking::NetworkPacket& dataOut)
+    static void onNetworkSend(SceneGraphNode* sgn, const SceneNode& node, ByteBuffer& dataOut)
     {
         node.onNetworkSend(sgn, dataOut);
     }
 
-    static void onNetworkReceive(SceneGraphNode* sgn, const SceneNode& node, Networking::NetworkPacket& dataIn)
+    static void onNetworkReceive(SceneGraphNode* sgn, const SceneNode& node, ByteBuffer& dataIn)
     {
         node.onNetworkReceive(sgn, dataIn);
     }
@@ -218,11 +214,6 @@ class SceneNodeBoundsSystem
         return node._boundsChanged;
     }
 
-    static void setBoundsChanged(SceneNode& node) noexcept
-    {
-        node._boundsChanged = true;
-    }
-
     static bool clearBoundsChanged(SceneNode& node) noexcept
     {
         if (!node._boundsChanged)
@@ -0,0 +1,357 @@
+
+
+#include "Headers/SGNRelationshipIndex.h"
+
+namespace Divide
+{
+
+SGNRelationshipIndex::SGNRelationshipIndex()
+{
+    clear();
+}
+
+SGNRelationshipIndex::NodeID SGNRelationshipIndex::add( const NodeID parent )
+{
+    LockGuard<SharedMutex> w_lock( _lock );
+
+    const NodeID parentID = parent == INVALID_NODE ? VIRTUAL_ROOT : parent;
+    DIVIDE_ASSERT( parentID == VIRTUAL_ROOT || isValidNode( parentID ) );
+
+    NodeID node = INVALID_NODE;
+    if ( !_freeIDs.empty() )
+    {
+        node = _freeIDs.back();
+        _freeIDs.pop_back();
+        _entries[node] = {};
+    }
+    else
+    {
+        node = to_U32( _entries.size() );
+        _entries.emplace_back();
+    }
+
+    ++_nodeCount;
+    link( node, parentID );
+    labelSubtree( node );
+
+    return node;
+}
+
+void SGNRelationshipIndex::remove( const NodeID node )
+{
+    LockGuard<SharedMutex> w_lock( _lock );
+
+    if ( !isValidNode( node ) )
+    {
+        return;
+    }
+
+    // Children are usually destroyed right after their parent, but until then they need valid labels
+    while ( _entries[node]._firstChild != INVALID_NODE )
+    {
+        const NodeID child = _entries[node]._firstChild;
+        unlink( child );
+        link( child, VIRTUAL_ROOT );
+        labelSubtree( child );
+    }
+
+    unlink( node );
+    _entries[node] = {};
+    _freeIDs.push_back( node );
+    --_nodeCount;
+}
+
+void SGNRelationshipIndex::changeParent( const NodeID node, const NodeID newParent )
+{
+    LockGuard<SharedMutex> w_lock( _lock );
+
+    const NodeID parentID = newParent == INVALID_NODE ? VIRTUAL_ROOT : newParent;
+    if ( !isValidNode( node ) || _entries[node]._parent == parentID )
+    {
+        return;
+    }
+
+    DIVIDE_ASSERT( parentID == VIRTUAL_ROOT || isValidNode( parentID ) );
+    if ( parentID == node || isAncestor( node, parentID ) )
+    {
+        // A node can't become its own descendant
+        DIVIDE_UNEXPECTED_CALL();
+        return;
+    }
+
+    unlink( node );
+    link( node, parentID );
+    labelSubtree( node );
+}
+
+void SGNRelationshipIndex::clear()
+{
+    LockGuard<SharedMutex> w_lock( _lock );
+
+    _entries.resize( 1u );
+    _entries[VIRTUAL_ROOT] = Entry
+    {
+        ._enter = 0u,
+        ._exit = U64_MAX,
+        ._parent = VIRTUAL_ROOT
+    };
+    _freeIDs.clear();
+    _nodeCount = 0u;
+}
+
+SGNRelationshipIndex::RelationshipType SGNRelationshipIndex::classify( const NodeID node, const NodeID target ) const
+{
+    SharedLock<SharedMutex> r_lock( _lock );
+    return classifyLocked( node, target );
+}
+
+bool SGNRelationshipIndex::isRelated( const NodeID node, const NodeID target, const RelationshipType type ) const
+{
+    SharedLock<SharedMutex> r_lock( _lock );
+    return type != RelationshipType::COUNT && classifyLocked( node, target ) == type;
+}
+
+size_t SGNRelationshipIndex::size() const
+{
+    SharedLock<SharedMutex> r_lock( _lock );
+    return _nodeCount;
+}
+
+bool SGNRelationshipIndex::validate() const
+{
+    SharedLock<SharedMutex> r_lock( _lock );
+
+    size_t nodeCount = 0u;
+    for ( NodeID node = 1u; node < to_U32( _entries.size() ); ++node )
+    {
+        if ( !isValidNode( node ) )
+        {
+            continue;
+        }
+
+        ++nodeCount;
+        const Entry& entry = _entries[node];
+        const Entry& parent = _entries[entry._parent];
+        if ( entry._enter >= entry._exit || entry._enter <= parent._enter || entry._exit >= parent._exit )
+        {
+            return false;
+        }
+
+        if ( entry._prevSibling != INVALID_NODE )
+        {
+            const Entry& prev = _entries[entry._prevSibling];
+            if ( prev._nextSibling != node || prev._parent != entry._parent || prev._exit >= entry._enter )
+            {
+                return false;
+            }
+        }
+        else if ( parent._firstChild != node )
+        {
+            return false;
+        }
+
+        if ( entry._nextSibling == INVALID_NODE && parent._lastChild != node )
+        {
+            return false;
+        }
+    }
+
+    return nodeCount == _nodeCount;
+}
+
+bool SGNRelationshipIndex::isValidNode( const NodeID node ) const noexcept
+{
+    return node != VIRTUAL_ROOT && node < _entries.size() && _entries[node]._parent != INVALID_NODE;
+}
+
+bool SGNRelationshipIndex::isAncestor( const NodeID ancestor, const NodeID node ) const noexcept
+{
+    const Entry& a = _entries[ancestor];
+    const Entry& n = _entries[node];
+    return a._enter < n._enter && n._exit < a._exit;
+}
+
+SGNRelationshipIndex::RelationshipType SGNRelationshipIndex::classifyLocked( const NodeID node, const NodeID target ) const noexcept
+{
+    if ( node == target || !isValidNode( node ) || !isValidNode( target ) )
+    {
+        return RelationshipType::COUNT;
+    }
+
+    const Entry& n = _entries[node];
+    const Entry& t = _entries[target];
+
+    if ( t._parent == node )
+    {
+        return RelationshipType::CHILD;
+    }
+    if ( isAncestor( node, target ) )
+    {
+        return RelationshipType::GRANDCHILD;
+    }
+    // We ignore the root node when considering parent/grandparent status
+    if ( t._parent != VIRTUAL_ROOT )
+    {
+        if ( n._parent == target )
+        {
+            return RelationshipType::PARENT;
+        }
+        if ( isAncestor( target, node ) )
+        {
+            return RelationshipType::GRANDPARENT;
+        }
+    }
+    if ( n._parent == t._parent && n._parent != VIRTUAL_ROOT )
+    {
+        return RelationshipType::SIBLING;
+    }
+
+    return RelationshipType::COUNT;
+}
+
+void SGNRelationshipIndex::link( const NodeID node, const NodeID parent )
+{
+    Entry& entry = _entries[node];
+    Entry& parentEntry = _entries[parent];
+
+    entry._parent = parent;
+    entry._prevSibling = parentEntry._lastChild;
+    entry._nextSibling = INVALID_NODE;
+
+    if ( parentEntry._lastChild != INVALID_NODE )
+    {
+        _entries[parentEntry._lastChild]._nextSibling = node;
+    }
+    else
+    {
+        parentEntry._firstChild = node;
+    }
+    parentEntry._lastChild = node;
+}
+
+void SGNRelationshipIndex::unlink( const NodeID node )
+{
+    Entry& entry = _entries[node];
+    Entry& parentEntry = _entries[entry._parent];
+
+    if ( entry._prevSibling != INVALID_NODE )
+    {
+        _entries[entry._prevSibling]._nextSibling = entry._nextSibling;
+    }
+    else
+    {
+        parentEntry._firstChild = entry._nextSibling;
+    }
+
+    if ( entry._nextSibling != INVALID_NODE )
+    {
+        _entries[entry._nextSibling]._prevSibling = entry._prevSibling;
+    }
+    else
+    {
+        parentEntry._lastChild = entry._prevSibling;
+    }
+
+    entry._parent = entry._prevSibling = entry._nextSibling = INVALID_NODE;
+}
+
+size_t SGNRelationshipIndex::subtreeSize( const NodeID node ) const noexcept
+{
+    size_t ret = 0u;
+
+    NodeID it = node;
+    while ( it != INVALID_NODE )
+    {
+        ++ret;
+        const Entry& entry = _entries[it];
+        if ( entry._firstChild != INVALID_NODE )
+        {
+            it = entry._firstChild;
+            continue;
+        }
+
+        // Climb up until we find an unvisited sibling, but never leave the subtree
+        while ( it != node && _entries[it]._nextSibling == INVALID_NODE )
+        {
+            it = _entries[it]._parent;
+        }
+        it = it == node ? INVALID_NODE : _entries[it]._nextSibling;
+    }
+
+    return ret;
+}
+
+U64 SGNRelationshipIndex::labelRange( const NodeID node, U64 label, const U64 step ) noexcept
+{
+    NodeID it = node;
+    while ( it != INVALID_NODE )
+    {
+        label += step;
+        _entries[it]._enter = label;
+        if ( _entries[it]._firstChild != INVALID_NODE )
+        {
+            it = _entries[it]._firstChild;
+            continue;
+        }
+
+        // Leaf: close it and every ancestor (up to node) that has no more children to visit
+        while ( true )
+        {
+            label += step;
+            _entries[it]._exit = label;
+
+            if ( it == node )
+            {
+                it = INVALID_NODE;
+                break;
+            }
+            if ( _entries[it]._nextSibling != INVALID_NODE )
+            {
+                it = _entries[it]._nextSibling;
+                break;
+            }
+            it = _entries[it]._parent;
+        }
+    }
+
+    return label;
+}
+
+void SGNRelationshipIndex::labelSubtree( const NodeID node )
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    const Entry& entry = _entries[node];
+    const Entry& parentEntry = _entries[entry._parent];
+
+    // Nodes are always appended, so everything between our previous sibling and the end of our parent's range is free
+    const U64 low = entry._prevSibling != INVALID_NODE ? _entries[entry._prevSibling]._exit : parentEntry._enter;
+    const U64 high = parentEntry._exit;
+
+    // Only use the first half of it. The rest is kept for future siblings
+    const U64 step = ((high - low) / 2u) / (2u * subtreeSize( node ) + 1u);
+    if ( step == 0u )
+    {
+        relabel();
+    }
+    else
+    {
+        labelRange( node, low, step );
+    }
+}
+
+void SGNRelationshipIndex::relabel()
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    // Even spacing leaves every node the same amount of room for new children
+    const U64 step = U64_MAX / (2u * _nodeCount + 2u);
+
+    U64 label = 0u;
+    for ( NodeID root = _entries[VIRTUAL_ROOT]._firstChild; root != INVALID_NODE; root = _entries[root]._nextSibling )
+    {
+        label = labelRange( root, label, step );
+    }
+}
+
+} //namespace Divide
@@ -96,7 +96,10 @@ namespace Divide
 
         destroySceneGraphNode( _root );
         DIVIDE_ASSERT( _root == nullptr );
-
+        _nodeIndex.clear();
+        _relationshipIndex.clear();
+        _broadPhase.clear();
+        _cullingIndex.clear();
     }
 
     void SceneGraph::addToDeleteQueue( SceneGraphNode* node, const size_t childIdx )
@@ -125,8 +128,13 @@ namespace Divide
         }
     }
 
-    void SceneGraph::onNodeSpatialChange( const SceneGraphNode& node )
+    void SceneGraph::onNodeSpatialChange( SceneGraphNode& node )
     {
+        if ( &node != _root )
+        {
+            _cullingIndex.onNodeChanged( &node );
+        }
+
         BoundsComponent* bComp = node.get<BoundsComponent>();
         if ( bComp != nullptr )
         {
@@ -135,9 +143,10 @@ namespace Divide
             LightPool* pool = Attorney::SceneGraph::getLightPool( &parentScene() );
             pool->onVolumeMoved( bComp->getBoundingSphere(), node.usageContext() == NodeUsageContext::NODE_STATIC );
 
-            if ( bComp->collisionsEnabled() )
+            // The root's bounds enclose every other node so it would just generate a (filtered out) hit for everything
+            if ( bComp->collisionsEnabled() && &node != _root )
             {
-                Attorney::SceneGraphNodeSceneGraph::updateCollisions( node, *getRoot(), _intersectionsCache, _intersectionsLock );
+                _broadPhase.onNodeMoved( &node );
             }
         }
 
@@ -159,6 +168,16 @@ namespace Divide
             return;
         }
 
+        _nodeIndex.remove( guid, oldNode->nameHash(), _ID( oldNode->getNode().resourceName().c_str() ) );
+        SGNRelationshipIndex::NodeID& relationshipID = Attorney::SceneGraphNodeSceneGraph::relationshipID( oldNode );
+        if ( relationshipID != SGNRelationshipIndex::INVALID_NODE )
+        {
+            _relationshipIndex.remove( relationshipID );
+            relationshipID = SGNRelationshipIndex::INVALID_NODE;
+        }
+        _broadPhase.onNodeDestroyed( oldNode );
+        _cullingIndex.onNodeDestroyed( oldNode );
+
         {
             LockGuard<SharedMutex> w_lock( _nodesByTypeLock );
             erase_if( _nodesByType[to_base( oldNode->getNode().type() )],
@@ -195,9 +214,46 @@ namespace Divide
             LockGuard<SharedMutex> w_lock( _nodesByTypeLock );
             _nodesByType[to_base( newNode->getNode().type() )].push_back( newNode );
         }
+
+        _nodeIndex.add( newNode->getGUID(), newNode->nameHash(), _ID( newNode->getNode().resourceName().c_str() ), newNode );
+        registerRelationship( newNode );
+        if ( newNode != _root )
+        {
+            // Nodes that never move still need a proxy. Bounds are read when the broad phase runs, not now
+            _broadPhase.onNodeMoved( newNode );
+            _cullingIndex.onNodeChanged( newNode );
+        }
+
         _nodeListChanged = true;
     }
 
+    SGNRelationshipIndex::NodeID SceneGraph::registerRelationship( SceneGraphNode* node )
+    {
+        SGNRelationshipIndex::NodeID parentID = SGNRelationshipIndex::INVALID_NODE;
+        if ( node->parent() != nullptr )
+        {
+            parentID = Attorney::SceneGraphNodeSceneGraph::relationshipID( node->parent() );
+            if ( parentID == SGNRelationshipIndex::INVALID_NODE )
+            {
+                // Parent got attached before it was registered. Register the whole chain above us first
+                parentID = registerRelationship( node->parent() );
+            }
+        }
+
+        SGNRelationshipIndex::NodeID& relationshipID = Attorney::SceneGraphNodeSceneGraph::relationshipID( node );
+        if ( relationshipID == SGNRelationshipIndex::INVALID_NODE )
+        {
+            relationshipID = _relationshipIndex.add( parentID );
+        }
+        else
+        {
+            // Parent change: the entire subtree moves along with the node
+            _relationshipIndex.changeParent( relationshipID, parentID );
+        }
+
+        return relationshipID;
+    }
+
     bool SceneGraph::removeNodesByType( const SceneNodeType nodeType )
     {
         return _root != nullptr && getRoot()->removeNodesByType( nodeType );
@@ -289,6 +345,8 @@ namespace Divide
 
         TaskPool& threadPool = parentScene().context().taskPool(TaskPoolType::HIGH_PRIORITY);
 
+        // Every stage touches the same nodes and components as the next one without any locking between them, so they run back to back on this thread.
+        // Only the work inside each stage is spread across the pool
         {
             PROFILE_SCOPE( "ECS::PreUpdate", Profiler::Category::Scene );
             GetECSEngine().PreUpdate( msTime );
@@ -319,9 +377,9 @@ namespace Divide
                     }
                 }
             );
-        
         }
         {
+            // Node updates may raise events that should be handled this frame
             PROFILE_SCOPE( "Process event queue", Profiler::Category::Scene );
             LockGuard<Mutex> w_lock( _nodeEventLock );
             Parallel_For
@@ -343,10 +401,10 @@ namespace Divide
 
             efficient_clear( _nodeEventQueue );
         }
-
         {
             PROFILE_SCOPE( "Process intersections", Profiler::Category::Scene );
             LockGuard<Mutex> w_lock( _intersectionsLock );
+            _broadPhase.findIntersections( _intersectionsCache );
             for ( const IntersectionRecord& ir : _intersectionsCache )
             {
                 HandleIntersection( ir );
@@ -502,24 +560,13 @@ namespace Divide
 
     SceneGraphNode* SceneGraph::findNode( const U64 nameHash, const bool sceneNodeName ) const
     {
-        const U64 cmpHash = sceneNodeName ? _ID( _root->getNode().resourceName().c_str() ) : _ID( _root->name().c_str() );
-
-        if ( cmpHash == nameHash )
-        {
-            return _root;
-        }
-
-        return _root->findChild( nameHash, sceneNodeName, true );
+        return sceneNodeName ? _nodeIndex.findBySceneNodeName( nameHash )
+                             : _nodeIndex.findByName( nameHash );
     }
 
     SceneGraphNode* SceneGraph::findNode( const I64 guid ) const
     {
-        if ( _root->getGUID() == guid )
-        {
-            return _root;
-        }
-
-        return _root->findChild( guid, false, true );
+        return _nodeIndex.find( guid );
     }
 
     bool SceneGraph::saveCache( ByteBuffer& outputBuffer ) const
@@ -0,0 +1,162 @@
+
+
+#include "Headers/SceneGraphBroadPhase.h"
+#include "Headers/SceneGraphNode.h"
+
+#include "ECS/Components/Headers/BoundsComponent.h"
+
+namespace Divide
+{
+
+void SceneGraphBroadPhase::onNodeMoved( const SceneGraphNode* node )
+{
+    LockGuard<Mutex> w_lock( _movedNodesLock );
+    _movedNodes.push_back( node );
+}
+
+void SceneGraphBroadPhase::onNodeDestroyed( const SceneGraphNode* node )
+{
+    LockGuard<Mutex> t_lock( _treeLock );
+    {
+        LockGuard<Mutex> w_lock( _movedNodesLock );
+        _movedNodes.erase( eastl::remove( _movedNodes.begin(), _movedNodes.end(), node ), _movedNodes.end() );
+    }
+
+    destroyProxy( node->getGUID() );
+}
+
+void SceneGraphBroadPhase::findIntersections( IntersectionContainer& intersectionsOut )
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    LockGuard<Mutex> t_lock( _treeLock );
+    {
+        LockGuard<Mutex> w_lock( _movedNodesLock );
+        std::swap( _movedNodes, _movedNodesTemp );
+    }
+
+    if ( _movedNodesTemp.empty() )
+    {
+        return;
+    }
+
+    // A node may move several times per frame. Sorted so we can quickly check if the other half of a pair also moved
+    eastl::sort( _movedNodesTemp.begin(), _movedNodesTemp.end() );
+    _movedNodesTemp.erase( eastl::unique( _movedNodesTemp.begin(), _movedNodesTemp.end() ), _movedNodesTemp.end() );
+
+    // Refresh every proxy first so that all of the queries below see this frame's bounds
+    erase_if( _movedNodesTemp,
+              [this]( const SceneGraphNode* node ) -> bool
+              {
+                  return !updateProxy( node );
+              } );
+
+    for ( const SceneGraphNode* node : _movedNodesTemp )
+    {
+        BoundsComponent* bounds = node->get<BoundsComponent>();
+
+        const auto queryTree = [&]( const Tree& tree )
+        {
+            tree.query( bounds->getBoundingBox(),
+                        [&]( const Tree::ProxyID proxy ) -> bool
+                        {
+                            BoundsComponent* otherBounds = tree.userData( proxy );
+                            if ( otherBounds == bounds || !otherBounds->collisionsEnabled() )
+                            {
+                                return true;
+                            }
+
+                            // If both nodes moved, only the one with the lower address reports the pair
+                            const SceneGraphNode* otherNode = otherBounds->parentSGN();
+                            if ( otherNode < node && eastl::binary_search( _movedNodesTemp.begin(), _movedNodesTemp.end(), otherNode ) )
+                            {
+                                return true;
+                            }
+
+                            if ( Collision( *bounds, *otherBounds ) )
+                            {
+                                IntersectionRecord& ir = intersectionsOut.emplace_back();
+                                ir._intersectedObject1 = bounds;
+                                ir._intersectedObject2 = otherBounds;
+                                ir._hasHit = true;
+                            }
+
+                            return true;
+                        } );
+        };
+
+        queryTree( _dynamicTree );
+        if ( node->usageContext() != NodeUsageContext::NODE_STATIC )
+        {
+            queryTree( _staticTree );
+        }
+    }
+
+    _movedNodesTemp.clear();
+}
+
+void SceneGraphBroadPhase::clear()
+{
+    LockGuard<Mutex> t_lock( _treeLock );
+    {
+        LockGuard<Mutex> w_lock( _movedNodesLock );
+        _movedNodes.clear();
+    }
+
+    _proxies.clear();
+    _staticTree.clear();
+    _dynamicTree.clear();
+}
+
+size_t SceneGraphBroadPhase::proxyCount() const
+{
+    LockGuard<Mutex> t_lock( _treeLock );
+    return _proxies.size();
+}
+
+bool SceneGraphBroadPhase::updateProxy( const SceneGraphNode* node )
+{
+    const I64 guid = node->getGUID();
+
+    BoundsComponent* bounds = node->get<BoundsComponent>();
+    if ( bounds == nullptr || !bounds->collisionsEnabled() )
+    {
+        destroyProxy( guid );
+        return false;
+    }
+
+    const bool isStatic = node->usageContext() == NodeUsageContext::NODE_STATIC;
+    const BoundingBox& aabb = bounds->getBoundingBox();
+
+    auto it = _proxies.find( guid );
+    if ( it != _proxies.end() && it->second._static != isStatic )
+    {
+        // Usage context changed. Move the proxy over to the other tree
+        destroyProxy( guid );
+        it = _proxies.end();
+    }
+
+    Tree& tree = isStatic ? _staticTree : _dynamicTree;
+    if ( it == _proxies.end() )
+    {
+        _proxies[guid] = Proxy{ tree.createProxy( aabb, bounds ), isStatic };
+    }
+    else
+    {
+        tree.moveProxy( it->second._id, aabb );
+    }
+
+    return true;
+}
+
+void SceneGraphBroadPhase::destroyProxy( const I64 guid )
+{
+    const auto it = _proxies.find( guid );
+    if ( it != _proxies.end() )
+    {
+        (it->second._static ? _staticTree : _dynamicTree).destroyProxy( it->second._id );
+        _proxies.erase( it );
+    }
+}
+
+} //namespace Divide
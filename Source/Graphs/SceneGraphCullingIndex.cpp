@@ -0,0 +1,200 @@
+
+
+#include "Headers/SceneGraphCullingIndex.h"
+#include "Headers/SceneGraphNode.h"
+#include "Headers/SceneNode.h"
+
+#include "ECS/Components/Headers/BoundsComponent.h"
+#include "Rendering/Camera/Headers/Frustum.h"
+
+namespace Divide
+{
+
+namespace
+{
+    /// Copies a level of the tree into structure of arrays form and runs the batched frustum test on it
+    void ClassifyBoundingBoxes( const Frustum& frustum, const BoundingBox* const* aabbs, const size_t count, FrustumCollision* resultsOut, vector<F32>& scratch )
+    {
+        scratch.resize( count * 6u );
+        F32* minX = scratch.data();
+        F32* minY = minX + count;
+        F32* minZ = minY + count;
+        F32* maxX = minZ + count;
+        F32* maxY = maxX + count;
+        F32* maxZ = maxY + count;
+
+        for ( size_t i = 0u; i < count; ++i )
+        {
+            const float3& min = aabbs[i]->_min;
+            const float3& max = aabbs[i]->_max;
+            minX[i] = min.x; minY[i] = min.y; minZ[i] = min.z;
+            maxX[i] = max.x; maxY[i] = max.y; maxZ[i] = max.z;
+        }
+
+        frustum.ContainsBoundingBoxes( BoundingBoxesSoA
+        {
+            ._minX = minX,
+            ._minY = minY,
+            ._minZ = minZ,
+            ._maxX = maxX,
+            ._maxY = maxY,
+            ._maxZ = maxZ,
+            ._count = count
+        }, VECTOR3_ZERO, resultsOut );
+    }
+} //namespace
+
+void SceneGraphCullingIndex::onNodeChanged( SceneGraphNode* node )
+{
+    LockGuard<Mutex> w_lock( _pendingLock );
+    _pendingNodes.push_back( node );
+    _hasPendingChanges.store( true );
+}
+
+void SceneGraphCullingIndex::onNodeDestroyed( const SceneGraphNode* node )
+{
+    LockGuard<SharedMutex> w_lock( _indexLock );
+    {
+        LockGuard<Mutex> p_lock( _pendingLock );
+        _pendingNodes.erase( eastl::remove( _pendingNodes.begin(), _pendingNodes.end(), node ), _pendingNodes.end() );
+    }
+
+    removeEntry( node->getGUID(), node );
+}
+
+void SceneGraphCullingIndex::clear()
+{
+    LockGuard<SharedMutex> w_lock( _indexLock );
+    {
+        LockGuard<Mutex> p_lock( _pendingLock );
+        _pendingNodes.clear();
+        _hasPendingChanges.store( false );
+    }
+
+    _entries.clear();
+    _alwaysVisible.clear();
+    _tree.clear();
+}
+
+void SceneGraphCullingIndex::gatherCandidates( const Frustum* frustum, vector<SceneGraphNode*>& candidatesOut )
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    if ( _hasPendingChanges.load() )
+    {
+        applyPendingChanges();
+    }
+
+    SharedLock<SharedMutex> r_lock( _indexLock );
+    candidatesOut.insert( candidatesOut.end(), _alwaysVisible.begin(), _alwaysVisible.end() );
+
+    const auto addCandidate = [&]( const Tree::ProxyID proxy, [[maybe_unused]] const bool fullyInside )
+    {
+        candidatesOut.push_back( _tree.userData( proxy ) );
+    };
+
+    if ( frustum == nullptr )
+    {
+        _tree.cull( []( [[maybe_unused]] const BoundingBox& aabb ) noexcept { return FrustumCollision::FRUSTUM_INTERSECT; }, addCandidate );
+    }
+    else
+    {
+        NO_DESTROY thread_local vector<F32> scratch;
+        _tree.cullBatched( [frustum]( const BoundingBox* const* aabbs, const size_t count, FrustumCollision* resultsOut )
+        {
+            ClassifyBoundingBoxes( *frustum, aabbs, count, resultsOut, scratch );
+        }, addCandidate );
+    }
+}
+
+size_t SceneGraphCullingIndex::nodeCount() const
+{
+    SharedLock<SharedMutex> r_lock( _indexLock );
+    return _entries.size();
+}
+
+void SceneGraphCullingIndex::applyPendingChanges()
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    LockGuard<SharedMutex> w_lock( _indexLock );
+    {
+        LockGuard<Mutex> p_lock( _pendingLock );
+        std::swap( _pendingNodes, _pendingNodesTemp );
+        _hasPendingChanges.store( false );
+    }
+
+    eastl::sort( _pendingNodesTemp.begin(), _pendingNodesTemp.end() );
+    _pendingNodesTemp.erase( eastl::unique( _pendingNodesTemp.begin(), _pendingNodesTemp.end() ), _pendingNodesTemp.end() );
+
+    for ( SceneGraphNode* node : _pendingNodesTemp )
+    {
+        updateEntry( node );
+    }
+
+    _pendingNodesTemp.clear();
+}
+
+void SceneGraphCullingIndex::updateEntry( SceneGraphNode* node )
+{
+    const I64 guid = node->getGUID();
+
+    if ( node->hasFlag( SceneGraphNode::Flags::IS_CONTAINER ) )
+    {
+        removeEntry( guid, node );
+        return;
+    }
+
+    const BoundsComponent* bComp = node->get<BoundsComponent>();
+    // Same rules as SceneGraphNode::frustumCullNode: these always pass the frustum test
+    const bool alwaysVisible = bComp == nullptr ||
+                               node->hasFlag( SceneGraphNode::Flags::VISIBILITY_LOCKED ) ||
+                               node->getNode().type() == SceneNodeType::TYPE_SKY;
+
+    auto it = _entries.find( guid );
+    if ( it != _entries.end() && it->second._alwaysVisible != alwaysVisible )
+    {
+        removeEntry( guid, node );
+        it = _entries.end();
+    }
+
+    if ( it == _entries.end() )
+    {
+        Entry entry{ ._alwaysVisible = alwaysVisible };
+        if ( alwaysVisible )
+        {
+            _alwaysVisible.push_back( node );
+        }
+        else
+        {
+            entry._proxy = _tree.createProxy( bComp->getBoundingBox(), node );
+        }
+        _entries[guid] = entry;
+    }
+    else if ( !alwaysVisible )
+    {
+        _tree.moveProxy( it->second._proxy, bComp->getBoundingBox() );
+    }
+}
+
+void SceneGraphCullingIndex::removeEntry( const I64 guid, const SceneGraphNode* node )
+{
+    const auto it = _entries.find( guid );
+    if ( it == _entries.end() )
+    {
+        return;
+    }
+
+    if ( it->second._alwaysVisible )
+    {
+        _alwaysVisible.erase( eastl::remove( _alwaysVisible.begin(), _alwaysVisible.end(), node ), _alwaysVisible.end() );
+    }
+    else
+    {
+        _tree.destroyProxy( it->second._proxy );
+    }
+
+    _entries.erase( it );
+}
+
+} //namespace Divide
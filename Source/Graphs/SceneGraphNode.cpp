@@ -154,7 +154,6 @@ void SceneGraphNode::setTransformDirty(const U32 transformMask)
 
 SceneGraphNode::SceneGraphNode( PlatformContext& context, SceneGraph* sceneGraph, const SceneGraphNodeDescriptor& descriptor )
     : PlatformContextComponent( context )
-    , _relationshipCache( this )
     , _sceneGraph( sceneGraph )
     , _name( descriptor._name )
     , _instanceCount( to_U32( descriptor._instanceCount ) )
@@ -307,7 +306,6 @@ void SceneGraphNode::setParentInternal()
         }
         Attorney::SceneGraphSGN::onNodeAdd(_sceneGraph, this);
         // That's it. Parent Transforms will be updated in the next render pass;
-        _parent->invalidateRelationshipCache();
     }
     {// Carry over new parent's flags and settings
         constexpr Flags flags[] = { Flags::SELECTED, Flags::HOVERED, Flags::ACTIVE, Flags::VISIBILITY_LOCKED };
@@ -357,11 +355,6 @@ SceneGraphNode* SceneGraphNode::addChildNode( SceneGraphNode* sgn)
 void SceneGraphNode::PostLoad(SceneNode* sceneNode, SceneGraphNode* sgn)
 {
     Attorney::SceneNodeSceneGraph::postLoad(sceneNode, sgn);
-
-    if (!sgn->_relationshipCache.isValid())
-    {
-        sgn->_relationshipCache.rebuild();
-    }
 }
 
 bool SceneGraphNode::removeNodesByType(SceneNodeType nodeType)
@@ -461,39 +454,26 @@ bool SceneGraphNode::isChildOfType(const U16 typeMask) const
 
 bool SceneGraphNode::isRelated(const SceneGraphNode* target) const
 {
-    // We also ignore grandparents as this will usually be the root;
-    if (_relationshipCache.isValid())
-    {
-        return _relationshipCache.classifyNode( target->getGUID() ) != SGNRelationshipCache::RelationshipType::COUNT;
-    }
-
-    return false;
+    // The root node is ignored when considering parent/grandparent status
+    return _sceneGraph->relationshipIndex().classify( _relationshipID, target->_relationshipID ) != SGNRelationshipIndex::RelationshipType::COUNT;
 }
 
-bool SceneGraphNode::isRelated( const SceneGraphNode* target, const SGNRelationshipCache::RelationshipType relationship ) const
+bool SceneGraphNode::isRelated( const SceneGraphNode* target, const SGNRelationshipIndex::RelationshipType relationship ) const
 {
-    // We also ignore grandparents as this will usually be the root;
-    if ( _relationshipCache.isValid() )
-    {
-        return _relationshipCache.validateRelationship( target->getGUID(), relationship );
-    }
-
-    return false;
+    return _sceneGraph->relationshipIndex().isRelated( _relationshipID, target->_relationshipID, relationship );
 }
 
 bool SceneGraphNode::isChild(const SceneGraphNode* target, const bool recursive) const
 {
     PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
 
-    const I64 targetGUID = target->getGUID();
-
-    const SGNRelationshipCache::RelationshipType type = _relationshipCache.classifyNode(targetGUID);
-    if (type == SGNRelationshipCache::RelationshipType::GRANDCHILD && recursive)
+    const SGNRelationshipIndex::RelationshipType type = _sceneGraph->relationshipIndex().classify( _relationshipID, target->_relationshipID );
+    if (type == SGNRelationshipIndex::RelationshipType::GRANDCHILD && recursive)
     {
         return true;
     }
 
-    return type == SGNRelationshipCache::RelationshipType::CHILD;
+    return type == SGNRelationshipIndex::RelationshipType::CHILD;
 }
 
 SceneGraphNode* SceneGraphNode::findChild(const U64 nameHash, const bool sceneNodeName, const bool recursive) const
@@ -721,17 +701,14 @@ void SceneGraphNode::processEvents()
         const ECS::CustomEvent& evt = Events._events[idx];
         switch (evt._type)
         {
-            case ECS::CustomEvent::Type::RelationshipCacheInvalidated:
-            {
-                PROFILE_SCOPE("RelationshipCacheInvalidated", Profiler::Category::Scene );
-                if (!_relationshipCache.isValid()) {
-                    _relationshipCache.rebuild();
-                }
-            } break;
             case ECS::CustomEvent::Type::EntityFlagChanged:
             {
                 PROFILE_SCOPE("EntityFlagChanged", Profiler::Category::Scene );
-                if (static_cast<Flags>(evt._flag) == Flags::SELECTED)
+                if (static_cast<Flags>(evt._flag) == Flags::VISIBILITY_LOCKED || static_cast<Flags>(evt._flag) == Flags::IS_CONTAINER)
+                {
+                    Attorney::SceneGraphSGN::onNodeVisibilityFlagChange(sceneGraph(), this);
+                }
+                else if (static_cast<Flags>(evt._flag) == Flags::SELECTED)
                 {
                     RenderingComponent* rComp = get<RenderingComponent>();
                     if (rComp != nullptr)
@@ -804,7 +781,10 @@ void SceneGraphNode::prepareRender( RenderingComponent& rComp,
 
     if (HasComponents(ComponentType::ANIMATION))
     {
-        ShaderBuffer* boneBuffer = get<AnimationComponent>()->getBoneBuffer();
+        AnimationComponent* animComp = get<AnimationComponent>();
+        animComp->uploadPose(postDrawMemCmd);
+
+        ShaderBuffer* boneBuffer = animComp->getBoneBuffer();
         // We always bind a bone buffer if we have animation data available as the shaders will expect the data to be there
         if(boneBuffer != nullptr)
         {
@@ -1152,36 +1132,6 @@ FrustumCollision SceneGraphNode::frustumCullNode(const NodeCullParams& params,
     return collisionType;
 }
 
-void SceneGraphNode::invalidateRelationshipCache(SceneGraphNode* source)
-{
-    if (source == this || !_relationshipCache.isValid())
-    {
-        return;
-    }
-
-    SendEvent(
-    {
-        ._type = ECS::CustomEvent::Type::RelationshipCacheInvalidated
-    });
-
-    _relationshipCache.invalidate();
-
-    if (_parent && _parent->parent())
-    {
-        _parent->invalidateRelationshipCache(this);
-
-        SharedLock<SharedMutex> r_lock(_children._lock);
-        const U32 childCount = _children._count;
-        for (U32 i = 0u; i < childCount; ++i)
-        {
-            if (!source || _children._data[i]->getGUID() != source->getGUID())
-            {
-                _children._data[i]->invalidateRelationshipCache(this);
-            }
-        }
-    }
-}
-
 bool SceneGraphNode::saveCache(ByteBuffer& outputBuffer) const
 {
     outputBuffer << BYTE_BUFFER_VERSION;
@@ -1362,40 +1312,4 @@ void SceneGraphNode::SendEvent(ECS::CustomEvent&& event)
     }
 }
 
-void SceneGraphNode::updateCollisions( const SceneGraphNode& parentNode, IntersectionContainer& intersections, Mutex& intersectionsLock ) const
-{
-    if ( parentNode.getGUID() == getGUID() )
-    {
-        return;
-    }
-    if ( usageContext() == parentNode.usageContext() && usageContext() == NodeUsageContext::NODE_STATIC )
-    {
-        return;
-    }
-
-    BoundsComponent* boundsA = get<BoundsComponent>();
-    BoundsComponent* boundsB = parentNode.get<BoundsComponent>();
-
-    if ( boundsB == nullptr || !boundsB->collisionsEnabled() )
-    {
-        return;
-    }
-
-    if ( Collision( *boundsA, *boundsB) )
-    {
-        LockGuard<Mutex> w_lock(intersectionsLock);
-        IntersectionRecord& ir = intersections.emplace_back();
-        ir._intersectedObject1 = boundsA;
-        ir._intersectedObject2 = boundsB;
-        ir._hasHit = true;
-    }
-
-    SharedLock<SharedMutex> r_lock( parentNode._children._lock );
-    const U32 childCount = parentNode._children._count;
-    for ( U32 i = 0u; i < childCount; ++i )
-    {
-        updateCollisions(*parentNode._children._data[i], intersections, intersectionsLock );
-    }
-}
-
 } //namespace Divide
@@ -127,6 +127,8 @@ namespace Divide
     struct SwitchProjectTarget
     {
         ProjectID _targetProject = {};
+        /// Scene to load once the project is loaded. If empty (or missing from the project), the first scene of the project is used
+        SceneEntry _startupScene = {};
     };
 
     [[nodiscard]] inline bool IsSet( const SwitchSceneTarget& target ) noexcept
@@ -212,7 +214,7 @@ namespace Divide
 
         void destroy();
 
-        [[nodiscard]] ErrorCode loadProject( const ProjectID& targetProject, bool deferToStartOfFrame );
+        [[nodiscard]] ErrorCode loadProject( const ProjectID& targetProject, bool deferToStartOfFrame, const SceneEntry& startupScene = {} );
 
         // returns selection callback id
         size_t addSelectionCallback( const DELEGATE<void, U8, const vector<SceneGraphNode*>&>& selectionCallback )
@@ -403,9 +403,10 @@ namespace Divide
         }
     }
 
-    ErrorCode ProjectManager::loadProject( const ProjectID& targetProject, const bool deferToStartOfFrame )
+    ErrorCode ProjectManager::loadProject( const ProjectID& targetProject, const bool deferToStartOfFrame, const SceneEntry& startupScene )
     {
         _projectSwitchTarget._targetProject = targetProject;
+        _projectSwitchTarget._startupScene = startupScene;
 
         if (!deferToStartOfFrame)
         {
@@ -434,18 +435,32 @@ namespace Divide
             return ErrorCode::MISSING_PROJECT_DATA;
         }
 
+        const SceneEntries& sceneEntries = _activeProject->getSceneEntries();
+
         SwitchSceneTarget sceneTarget
         {
-            ._targetScene = _activeProject->getSceneEntries().front(),
+            ._targetScene = sceneEntries.front(),
             ._unloadPreviousScene = true,
             ._loadInSeparateThread = false,
             ._deferToStartOfFrame = false,
             ._createIfNotExist = false
         };
 
+        if ( !target._startupScene._name.empty() )
+        {
+            if ( eastl::find( sceneEntries.cbegin(), sceneEntries.cend(), target._startupScene ) != sceneEntries.cend() )
+            {
+                sceneTarget._targetScene = target._startupScene;
+            }
+            else
+            {
+                Console::warnfn( LOCALE_STR( "WARN_SCENE_NOT_FOUND" ), target._startupScene._name.c_str(), target._targetProject._name.c_str(), sceneTarget._targetScene._name.c_str() );
+            }
+        }
+
         if ( !_activeProject->switchScene( sceneTarget ) )
         {
-            Console::errorfn( LOCALE_STR( "ERROR_SCENE_LOAD" ), _activeProject->getSceneEntries().front()._name.c_str() );
+            Console::errorfn( LOCALE_STR( "ERROR_SCENE_LOAD" ), sceneTarget._targetScene._name.c_str() );
             return ErrorCode::MISSING_SCENE_DATA;
         }
 
@@ -469,6 +484,11 @@ namespace Divide
         if constexpr( Config::Build::IS_EDITOR_BUILD )
         {
             static_assert(Config::Build::ENABLE_EDITOR);
+            if ( parent().dedicatedServer() )
+            {
+                return;
+            }
+
             DisplayWindow& window = platformContext().mainWindow();
             if ( window.type() == WindowType::WINDOW )
             {
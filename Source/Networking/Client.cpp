@@ -12,6 +12,15 @@ namespace Divide::Networking
 {
     Client::Client()
         : _heartbeatTimer(_context)
+        , _udpTransport(_context,
+                        [this](const boost::asio::ip::udp::endpoint& remote, const Byte* data, const size_t size)
+                        {
+                            if (_connection != nullptr)
+                            {
+                                _connection->onDatagram(remote, data, size);
+                            }
+                        })
+        , _udpTimer(_context)
     {
     }
 
@@ -29,8 +38,15 @@ namespace Divide::Networking
             boost::asio::ip::tcp::resolver resolver(_context);
             boost::asio::ip::tcp::resolver::results_type endpoints = resolver.resolve(host, std::to_string(port));
 
+            // Remembered for the UDP side, which we only open once the server tells us who we are
+            _host = host;
+            _port = port;
+
+            // A new server means a new clock
+            _clockSync.reset();
+
             // Create connection
-            _connection = std::make_unique<Connection>(Connection::Owner::CLIENT, _context, boost::asio::ip::tcp::socket(_context), _messagesIn);
+            _connection = std::make_unique<Connection>(Connection::Owner::CLIENT, _context, boost::asio::ip::tcp::socket(_context), _messagesIn, _packetPool);
 
             // Tell the connection object to connect to server
             _connection->connectToServer(endpoints);
@@ -57,6 +73,7 @@ namespace Divide::Networking
     void Client::disconnect()
     {
         _heartbeatTimer.cancel();
+        _udpTimer.cancel();
 
         // If connection exists, and it's connected then...
         if (isConnected())
@@ -75,7 +92,8 @@ namespace Divide::Networking
         }
 
         // Destroy the connection object
-        _connection.release();
+        _udpTransport.close();
+        _connection.reset();
     }
 
 
@@ -94,10 +112,33 @@ namespace Divide::Networking
     {
         if (isConnected())
         {
-            _heartbeatTimer.expires_at(boost::posix_time::neg_infin);
             sendMessage(p);
-            heartbeatWait();
+            // Any message keeps the connection alive, so push the next heartbeat back
+            boost::asio::post(_context, [this]() { heartbeatWait(); });
+        }
+    }
+
+    void Client::updateInterest(const float3& position, const F32 radius)
+    {
+        if (!isConnected())
+        {
+            return;
+        }
+
+        if (radius == _interestRadius && position.distanceSquared(_interestPosition) < SQUARED(radius * InterestResendDistanceFactor))
+        {
+            return;
         }
+
+        _interestPosition = position;
+        _interestRadius = radius;
+
+        NetworkPacket msg{ OPCodes::CMSG_INTEREST };
+        msg << position.x;
+        msg << position.y;
+        msg << position.z;
+        msg << radius;
+        send(msg);
     }
 
     void Client::update()
@@ -107,10 +148,10 @@ namespace Divide::Networking
             return;
         }
 
-        while (!_messagesIn.empty())
+        OwnedNetworkPacket msg{};
+        while (_messagesIn.try_dequeue(msg))
         {
-            NetworkPacket msg = _messagesIn.pop_front()._msg;
-            receiveMessage(msg);
+            receiveMessage(*msg._msg);
         }
 
         static bool init = false;
@@ -121,14 +162,26 @@ namespace Divide::Networking
         }
     }
 
+    U64 Client::updateRenderTime(const U64 localTimeUS) noexcept
+    {
+        _clockSync.update(localTimeUS);
+
+        const U64 serverTimeUS = _clockSync.remoteTimeUS();
+        return serverTimeUS > _interpolationSettings._delayUS ? serverTimeUS - _interpolationSettings._delayUS : 0u;
+    }
+
     void Client::heartbeatWait()
     {
         _heartbeatTimer.expires_from_now(boost::posix_time::seconds(2));
         _heartbeatTimer.async_wait
         (
-            [&]([[maybe_unused]] const boost::system::error_code ec)
+            [&](const boost::system::error_code ec)
             {
-                heartbeatSend();
+                // Rescheduled (or cancelled) before it expired. Only the newest wait sends anything
+                if (!ec)
+                {
+                    heartbeatSend();
+                }
             }
         );
     }
@@ -150,6 +203,51 @@ namespace Divide::Networking
         heartbeatWait();
     }
 
+    void Client::startUDP(const U32 connectionID, const U32 token)
+    {
+        if (_connection == nullptr || _udpTransport.isOpen())
+        {
+            return;
+        }
+
+        boost::system::error_code ec;
+        boost::asio::ip::udp::resolver resolver(_context);
+        const boost::asio::ip::udp::resolver::results_type endpoints = resolver.resolve(boost::asio::ip::udp::v4(), _host, std::to_string(_port), ec);
+        if (ec || endpoints.empty())
+        {
+            Console::errorfn(LOCALE_STR("CLIENT_EXCEPTION"), ec.message());
+            return;
+        }
+
+        // Any local port will do. The server answers whatever address our datagrams come from
+        if (_udpTransport.open(0u))
+        {
+            _connection->enableUDP(_udpTransport, endpoints.begin()->endpoint(), connectionID, token);
+            Console::printfn(LOCALE_STR("CLIENT_UDP_STARTED"), connectionID);
+            updateUDP();
+        }
+    }
+
+    void Client::updateUDP()
+    {
+        if (_connection != nullptr)
+        {
+            _connection->updateUDP();
+        }
+
+        _udpTimer.expires_from_now(boost::posix_time::milliseconds(UDPUpdateIntervalMS));
+        _udpTimer.async_wait
+        (
+            [this](const boost::system::error_code ec)
+            {
+                if (!ec)
+                {
+                    updateUDP();
+                }
+            }
+        );
+    }
+
     void Client::receiveMessage(NetworkPacket& msg)
     {
         Console::printfn(LOCALE_STR("CLIENT_MSG_RECEIVE"), to_base(msg.header()._opCode));
@@ -160,6 +258,14 @@ namespace Divide::Networking
             case OPCodes::SMSG_ACCEPT:
             case OPCodes::SMSG_DENY:   break;
 
+            case OPCodes::SMSG_CONNECTION_ID:
+            {
+                U32 connectionID{ 0u };
+                U32 token{ 0u };
+                msg >> connectionID;
+                msg >> token;
+                boost::asio::post(_context, [this, connectionID, token]() { startUDP(connectionID, token); });
+            } break;
             case OPCodes::SMSG_PONG: 
             {
                 D64 timeClient = 0., timeServer = 0.;
@@ -178,17 +284,61 @@ namespace Divide::Networking
                 U32 srcID{ 0u };
                 I64 targetGUID{-1};
                 U32 frameCount{0u};
+                U64 serverTimeUS{0u};
                 msg >> srcID;
                 msg >> targetGUID;
                 msg >> frameCount;
+                msg >> serverTimeUS;
                 Console::printfn(LOCALE_STR("CLIENT_ON_RECEIVE_ENTITY_UPDATE"), targetGUID, srcID, frameCount);
+
+                _clockSync.addSample(serverTimeUS, to_U64(Time::App::ElapsedMicroseconds()));
+
                 NetworkingComponent* comp = NetworkingComponent::GetReceiver(targetGUID);
                 if ( comp != nullptr )
                 {
                     comp->flagDirty(srcID, frameCount);
+
+                    U32 sequence = DeltaEncoder::INVALID_SEQUENCE;
+                    if ( comp->onNetworkReceive(msg, serverTimeUS, sequence) )
+                    {
+                        // The server encodes our next updates against this state
+                        NetworkPacket ackOut{ OPCodes::CMSG_ENTITY_UPDATE_ACK };
+                        ackOut << targetGUID;
+                        ackOut << sequence;
+                        send(ackOut);
+                    }
+                    else
+                    {
+                        Console::printfn(LOCALE_STR("CLIENT_ENTITY_UPDATE_NO_BASELINE"), targetGUID);
+                    }
                 }
 
             } break;
+            case OPCodes::SMSG_ENTITY_ENTER:
+            case OPCodes::SMSG_ENTITY_LEAVE:
+            {
+                I64 targetGUID{ -1 };
+                msg >> targetGUID;
+
+                NetworkingComponent* comp = NetworkingComponent::GetReceiver(targetGUID);
+                if ( comp != nullptr )
+                {
+                    comp->onNetworkRelevancy(msg.header()._opCode == OPCodes::SMSG_ENTITY_ENTER);
+                }
+            } break;
+            case OPCodes::SMSG_ENTITY_ACK:
+            {
+                I64 targetGUID{ -1 };
+                U32 sequence{ 0u };
+                msg >> targetGUID;
+                msg >> sequence;
+
+                NetworkingComponent* comp = NetworkingComponent::GetReceiver(targetGUID);
+                if ( comp != nullptr )
+                {
+                    comp->onNetworkAck(sequence);
+                }
+            } break;
             case OPCodes::SMSG_SEND_FILE:
             {
                 ResourcePath filePath;
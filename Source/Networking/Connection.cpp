@@ -1,6 +1,7 @@
 #include "Headers/Connection.h"
 
 #include "Utility/Headers/Localization.h"
+#include "Core/Time/Headers/ApplicationTimer.h"
 
 #include <boost/asio/connect.hpp>
 #include <boost/asio/write.hpp>
@@ -8,11 +9,19 @@
 
 namespace Divide::Networking
 {
-    Connection::Connection(Owner parent, boost::asio::io_context& asioContext, boost::asio::ip::tcp::socket socket, OwnedPacketQueue& qIn)
+    namespace
+    {
+        [[nodiscard]] FORCE_INLINE U64 TimeUS() noexcept
+        {
+            return to_U64(Time::App::ElapsedMicroseconds());
+        }
+    } //namespace
+
+    Connection::Connection(Owner parent, boost::asio::io_context& asioContext, boost::asio::ip::tcp::socket socket, OwnedPacketQueue& qIn, PacketPool& packetPool)
         : _socket(MOV(socket))
         , _asioContext(asioContext)
         , _messagesIn(qIn)
-        , _msgTemporaryIn(OPCodes::MSG_NOP)
+        , _packetPool(packetPool)
         , _ownerType( parent )
     {
     }
@@ -63,12 +72,19 @@ namespace Divide::Networking
                 _asioContext,
                 [this]()
                 {
-                    _socket.close();
+                    closeSocket();
                 }
             );
         }
     }
 
+    void Connection::closeSocket()
+    {
+        // Both sides may be closing at once, so the socket can already be gone. Throwing from an asio handler would take the whole context down
+        boost::system::error_code ec;
+        _socket.close(ec);
+    }
+
     bool Connection::isConnected() const
     {
         return _socket.is_open();
@@ -81,104 +97,190 @@ namespace Divide::Networking
     }
 
     void Connection::send(const NetworkPacket& p)
+    {
+        send(_packetPool.acquire(p));
+    }
+
+    void Connection::send(PacketRef p)
     {
         boost::asio::post
         (
             _asioContext,
-            [this, p]()
+            [this, packet = MOV(p)]() mutable
             {
-                // If the queue has a message in it, then we must 
-                // assume that it is in the process of asynchronously being written.
-                // Either way add the message to the queue to be output. If no messages
-                // were available to be written, then start the process of writing the
-                // message at the front of the queue.
-                const bool writingMessage = !_messagesOut.empty();
-                _messagesOut.push_back(p);
-
-                if (!writingMessage)
+                if (!sendUDP(packet))
                 {
-                    writeHeader();
+                    sendTCP(MOV(packet));
                 }
             }
         );
     }
 
-    void Connection::writeHeader()
+    void Connection::sendTCP(PacketRef packet)
     {
+        // If the queue has a message in it, then we must 
+        // assume that it is in the process of asynchronously being written.
+        // Either way add the message to the queue to be output. If no messages
+        // were available to be written, then start the process of writing the
+        // message at the front of the queue.
+        const bool writingMessage = !_messagesOut.empty();
+        _messagesOut.push_back(MOV(packet));
 
-        // If this function is called, we know the outgoing message queue must have 
-        // at least one message to send. So allocate a transmission buffer to hold
-        // the message, and issue the work - asio, send these bytes
-        boost::asio::async_write
-        (
-            _socket,
-            boost::asio::buffer(&_messagesOut.front().header(), NetworkPacket::HEADER_SIZE),
-            [this](std::error_code ec, [[maybe_unused]] std::size_t length)
+        if (!writingMessage)
+        {
+            writeMessages();
+        }
+    }
+
+    bool Connection::sendUDP(PacketRef& packet)
+    {
+        const DeliveryMode mode = GetDeliveryMode(packet->header()._opCode);
+        if (mode == DeliveryMode::TCP || _udpEndpoint == nullptr || !_udpEndpoint->connected())
+        {
+            return false;
+        }
+
+        // Too large for the remote endpoint to reassemble. TCP has no such limit, but ordered messages can only go that way until they switched to UDP
+        if (packet->body().bufferSize() > ReliableEndpoint::MaxMessageSize &&
+            (mode != DeliveryMode::UDP_RELIABLE_ORDERED || _orderedTransport == OrderedTransport::TCP))
+        {
+            return false;
+        }
+
+        // Unordered and sequenced messages don't care what went before them
+        if (mode != DeliveryMode::UDP_RELIABLE_ORDERED || _orderedTransport == OrderedTransport::UDP)
+        {
+            _udpEndpoint->send(*packet, mode, TimeUS());
+            return true;
+        }
+
+        if (_orderedTransport == OrderedTransport::TCP)
+        {
+            // Goes out behind every ordered message we sent over TCP so far
+            sendTCP(_packetPool.acquire(OPCodes::MSG_TRANSPORT_FENCE));
+            _orderedTransport = OrderedTransport::FENCING;
+        }
+
+        _fencedMessages.push_back(MOV(packet));
+        return true;
+    }
+
+    bool Connection::handleTransportMessage(const NetworkPacket& msg)
+    {
+        switch (msg.header()._opCode)
+        {
+            case OPCodes::MSG_TRANSPORT_FENCE:
             {
-                // asio has now sent the bytes - if there was a problem an error would be available...
-                if (!ec)
+                // TCP is ordered, so everything the remote side sent before the fence is already in our queue. Anything after it can come in over UDP
+                sendTCP(_packetPool.acquire(OPCodes::MSG_TRANSPORT_FENCE_ACK));
+            } return true;
+            case OPCodes::MSG_TRANSPORT_FENCE_ACK:
+            {
+                if (_orderedTransport == OrderedTransport::FENCING)
                 {
-                    // ... no error, so check if the message header just sent also has a message body...
-                    if (_messagesOut.front().header()._byteLength > 0u)
-                    {
-                        // ...it does, so issue the task to write the body bytes
-                        writeBody();
-                    }
-                    else
+                    _orderedTransport = OrderedTransport::UDP;
+
+                    const U64 timeUS = TimeUS();
+                    for (const PacketRef& packet : _fencedMessages)
                     {
-                        // ...it didnt, so we are done with this message. Remove it from the outgoing message queue
-                        _messagesOut.pop_front();
-
-                        // If the queue is not empty, there are more messages to send, so make this happen by issuing the task to send the next header.
-                        if (!_messagesOut.empty())
-                        {
-                            writeHeader();
-                        }
+                        _udpEndpoint->send(*packet, DeliveryMode::UDP_RELIABLE_ORDERED, timeUS);
                     }
+                    _fencedMessages.clear();
                 }
-                else
-                {
-                    // ...asio failed to write the message, we could analyse why but 
-                    // for now simply assume the connection has died by closing the
-                    // socket. When a future attempt to write to this client fails due
-                    // to the closed socket, it will be tidied up.
-                    Console::errorfn(LOCALE_STR("NETWORK_ERROR_CODE_ERROR"), ec.message());
-                    _socket.close();
-                }
+            } return true;
+            default: break;
+        }
+
+        return false;
+    }
+
+    void Connection::enableUDP(UDPTransport& transport, const boost::asio::ip::udp::endpoint& remote, const U32 connectionID, const U32 token)
+    {
+        _udpTransport = &transport;
+        _udpRemote = remote;
+        _udpEndpoint = std::make_unique<ReliableEndpoint>
+        (
+            connectionID,
+            token,
+            _packetPool,
+            [this](const Byte* data, const size_t size)
+            {
+                _bytesSent.fetch_add(size, std::memory_order_relaxed);
+                _udpTransport->sendTo(_udpRemote, data, size);
+            },
+            [this](PacketRef msg)
+            {
+                pushIncomingMessage(MOV(msg));
             }
         );
     }
 
-    // ASYNC - Prime context to write a message body
-    void Connection::writeBody()
+    void Connection::onDatagram(const boost::asio::ip::udp::endpoint& remote, const Byte* data, const size_t size)
+    {
+        // Forged or stale datagrams must not redirect our replies
+        if (_udpEndpoint != nullptr && _udpEndpoint->accepts(data, size))
+        {
+            _bytesReceived.fetch_add(size, std::memory_order_relaxed);
+            _udpRemote = remote;
+            _udpEndpoint->onDatagram(data, size, TimeUS());
+        }
+    }
+
+    void Connection::updateUDP()
     {
-        // If this function is called, a header has just been sent, and that header
-        // indicated a body existed for this message. Fill a transmission buffer
-        // with the body data, and send it!
+        if (_udpEndpoint != nullptr)
+        {
+            _udpEndpoint->update(TimeUS());
+        }
+    }
+
+    void Connection::writeMessages()
+    {
+        // If this function is called, we know the outgoing message queue must have 
+        // at least one message to send. Gather the headers and bodies of as many of them as we can
+        // and hand them all to asio in one go: no copying them into a contiguous buffer and a single write for the lot
+        _messagesInFlight = std::min(_messagesOut.size(), MaxMessagesPerWrite);
+
+        _writeBuffers.clear();
+        for (size_t i = 0u; i < _messagesInFlight; ++i)
+        {
+            const NetworkPacket& msg = *_messagesOut[i];
+            _writeBuffers.emplace_back(&msg.header(), NetworkPacket::HEADER_SIZE);
+            if (msg.header()._byteLength > 0u)
+            {
+                _writeBuffers.emplace_back(msg.body().contents() + msg.body().rpos(), msg.body().bufferSize());
+            }
+        }
+
         boost::asio::async_write
         (
             _socket,
-            boost::asio::buffer(_messagesOut.front().body().contents(), _messagesOut.front().body().bufferSize()),
-            [this](std::error_code ec, [[maybe_unused]] std::size_t length)
+            _writeBuffers,
+            [this](std::error_code ec, const std::size_t length)
             {
+                // asio has now sent the bytes - if there was a problem an error would be available...
                 if (!ec)
                 {
-                    // Sending was successful, so we are done with the message
-                    // and remove it from the queue
-                    _messagesOut.pop_front();
+                    _bytesSent.fetch_add(length, std::memory_order_relaxed);
+
+                    // ... no error, so we are done with these messages. Remove them from the outgoing message queue (and release them back to the pool)
+                    _messagesOut.erase(_messagesOut.begin(), _messagesOut.begin() + _messagesInFlight);
+                    _messagesInFlight = 0u;
 
-                    // If the queue still has messages in it, then issue the task to 
-                    // send the next messages' header.
+                    // If the queue is not empty, there are more messages to send, so make this happen by issuing the task to send them.
                     if (!_messagesOut.empty())
                     {
-                        writeHeader();
+                        writeMessages();
                     }
                 }
                 else
                 {
-                    // Sending failed, see WriteHeader() equivalent for description :P
+                    // ...asio failed to write the message, we could analyse why but 
+                    // for now simply assume the connection has died by closing the
+                    // socket. When a future attempt to write to this client fails due
+                    // to the closed socket, it will be tidied up.
                     Console::errorfn(LOCALE_STR("NETWORK_ERROR_CODE_ERROR"), ec.message());
-                    _socket.close();
+                    closeSocket();
                 }
             }
         );
@@ -190,22 +292,26 @@ namespace Divide::Networking
         // If this function is called, we are expecting asio to wait until it receives
         // enough bytes to form a header of a message. We know the headers are a fixed
         // size, so allocate a transmission buffer large enough to store it. In fact, 
-        // we will construct the message in a "temporary" message object as it's 
+        // we will construct the message in a "temporary" (pooled) message object as it's 
         // convenient to work with.
+        _msgTemporaryIn = _packetPool.acquire(OPCodes::MSG_NOP);
+
         boost::asio::async_read
         (
             _socket,
-            boost::asio::buffer(&_msgTemporaryIn._header, NetworkPacket::HEADER_SIZE),
-            [this](std::error_code ec, [[maybe_unused]] std::size_t length)
+            boost::asio::buffer(&_msgTemporaryIn->_header, NetworkPacket::HEADER_SIZE),
+            [this](std::error_code ec, const std::size_t length)
             {
                 if (!ec)
                 {
+                    _bytesReceived.fetch_add(length, std::memory_order_relaxed);
+
                     // A complete message header has been read, check if this message has a body to follow...
-                    if (_msgTemporaryIn._header._byteLength > 0u)
+                    if (_msgTemporaryIn->_header._byteLength > 0u)
                     {
-                        // ...it does, so allocate enough space in the messages' body
-                        // vector, and issue asio with the task to read the body.
-                        _msgTemporaryIn._body.resize(_msgTemporaryIn._header._byteLength);
+                        // ...it does, so make enough space in the messages' body
+                        // vector (pooled packets usually have it already), and issue asio with the task to read the body.
+                        _msgTemporaryIn->_body.resize(_msgTemporaryIn->_header._byteLength);
                         readBody();
                     }
                     else
@@ -219,7 +325,7 @@ namespace Divide::Networking
                     // Reading form the client went wrong, most likely a disconnect
                     // has occurred. Close the socket and let the system tidy it up later.
                     Console::errorfn(LOCALE_STR("NETWORK_ERROR_CODE_ERROR"), ec.message());
-                    _socket.close();
+                    closeSocket();
                 }
             }
         );
@@ -232,16 +338,18 @@ namespace Divide::Networking
         // request we read a body, The space for that body has already been allocated
         // in the temporary message object, so just wait for the bytes to arrive...
 
-        vector<Byte>& storage = Attorney::ByteBufferStorageAccessor::bufferStorage(_msgTemporaryIn._body);
+        vector<Byte>& storage = Attorney::ByteBufferStorageAccessor::bufferStorage(_msgTemporaryIn->_body);
 
         boost::asio::async_read
         (
             _socket,
             boost::asio::buffer(storage.data(), storage.size()),
-            [this](std::error_code ec, [[maybe_unused]] std::size_t length)
+            [this](std::error_code ec, const std::size_t length)
             {
                 if (!ec)
                 {
+                    _bytesReceived.fetch_add(length, std::memory_order_relaxed);
+
                     // ...and they have! The message is now complete, so add the whole message to incoming queue
                     addToIncomingMessageQueue();
                 }
@@ -249,7 +357,7 @@ namespace Divide::Networking
                 {
                     // As above!
                     Console::errorfn(LOCALE_STR("NETWORK_ERROR_CODE_ERROR"), ec.message());
-                    _socket.close();
+                    closeSocket();
                 }
             }
         );
@@ -258,20 +366,30 @@ namespace Divide::Networking
     // Once a full message is received, add it to the incoming queue
     void Connection::addToIncomingMessageQueue()
     {
+        pushIncomingMessage(MOV(_msgTemporaryIn));
+
+        // We must now prime the asio context to receive the next message. It 
+        // wil just sit and wait for bytes to arrive, and the message construction
+        // process repeats itself. Clever huh?
+       readHeader();
+    }
+
+    void Connection::pushIncomingMessage(PacketRef msg)
+    {
+        if (handleTransportMessage(*msg))
+        {
+            return;
+        }
+
         // Shove it in queue, converting it to an "owned message", by initialising
-        // with the a shared pointer from this connection object
+        // with the a shared pointer from this connection object. The packet itself is moved, not copied
         if (_ownerType == Owner::SERVER)
         {
-            _messagesIn.push_back({ shared_from_this(), _msgTemporaryIn });
+            _messagesIn.enqueue({ shared_from_this(), MOV(msg) });
         }
         else
         {
-            _messagesIn.push_back({ nullptr, _msgTemporaryIn });
+            _messagesIn.enqueue({ nullptr, MOV(msg) });
         }
-
-        // We must now prime the asio context to receive the next message. It 
-        // wil just sit and wait for bytes to arrive, and the message construction
-        // process repeats itself. Clever huh?
-       readHeader();
     }
 } //namespace Divide::Networking
@@ -0,0 +1,316 @@
+
+
+#include "Headers/DeltaCodec.h"
+
+#include "Core/Math/Headers/TransformInterface.h"
+
+namespace Divide::Networking
+{
+    namespace
+    {
+        constexpr F32 PositionScale = 1024.f;
+        // appendPackXYZ stores multiples of 0.25 in 11 (x, y) and 10 (z) bit signed fields.
+        // The three smallest components of a unit quaternion are all in [-1/sqrt(2), 1/sqrt(2)], so these scales use (almost) the whole range
+        constexpr F32 OrientationScaleXY = 1446.f;
+        constexpr F32 OrientationScaleZ = 722.f;
+
+        constexpr U8 MaxRunLength = 0x80u;
+        constexpr U8 LiteralFlag = 0x80u;
+
+        [[nodiscard]] FORCE_INLINE Byte BaselineByte(const ByteBuffer& baseline, const size_t offset) noexcept
+        {
+            return offset < baseline.bufferSize() ? baseline.contents()[baseline.rpos() + offset] : Byte{ 0u };
+        }
+
+        [[nodiscard]] FORCE_INLINE F32 Quantize(const F32 value, const F32 scale) noexcept
+        {
+            // Already a multiple of 0.25, so appendPackXYZ doesn't round it again
+            return std::round(value * scale) * 0.25f;
+        }
+    } //namespace
+
+    void WriteTransform(ByteBuffer& dataOut, const TransformValues& values)
+    {
+        for (U8 i = 0u; i < 3u; ++i)
+        {
+            dataOut << to_I32(std::round(values._translation[i] * PositionScale));
+        }
+
+        // Smallest three: drop the largest component (by magnitude) and rebuild it from the other three.
+        // q and -q are the same rotation, so flip the sign to make the dropped component positive
+        const F32 q[4] = { values._orientation.X(), values._orientation.Y(), values._orientation.Z(), values._orientation.W() };
+        U8 largest = 0u;
+        for (U8 i = 1u; i < 4u; ++i)
+        {
+            if (std::abs(q[i]) > std::abs(q[largest]))
+            {
+                largest = i;
+            }
+        }
+
+        const F32 sign = q[largest] < 0.f ? -1.f : 1.f;
+        F32 smallest[3] = {};
+        for (U8 i = 0u, j = 0u; i < 4u; ++i)
+        {
+            if (i != largest)
+            {
+                smallest[j++] = q[i] * sign;
+            }
+        }
+
+        dataOut << largest;
+        dataOut.appendPackXYZ(Quantize(smallest[0], OrientationScaleXY),
+                              Quantize(smallest[1], OrientationScaleXY),
+                              Quantize(smallest[2], OrientationScaleZ));
+
+        dataOut << values._scale;
+    }
+
+    void ReadTransform(ByteBuffer& dataIn, TransformValues& valuesOut)
+    {
+        for (U8 i = 0u; i < 3u; ++i)
+        {
+            I32 position = 0;
+            dataIn >> position;
+            valuesOut._translation[i] = to_F32(position) / PositionScale;
+        }
+
+        U8 largest = 0u;
+        F32 smallest[3] = {};
+        dataIn >> largest;
+        largest = std::min(largest, to_U8(3u));
+        dataIn.readPackXYZ(smallest[0], smallest[1], smallest[2]);
+        smallest[0] *= 4.f / OrientationScaleXY;
+        smallest[1] *= 4.f / OrientationScaleXY;
+        smallest[2] *= 4.f / OrientationScaleZ;
+
+        F32 q[4] = {};
+        F32 lengthSq = 0.f;
+        for (U8 i = 0u, j = 0u; i < 4u; ++i)
+        {
+            if (i != largest)
+            {
+                q[i] = smallest[j++];
+                lengthSq += SQUARED(q[i]);
+            }
+        }
+        q[largest] = Sqrt<F32>(std::max(1.f - lengthSq, 0.f));
+
+        valuesOut._orientation.set(q[0], q[1], q[2], q[3]);
+        valuesOut._orientation.normalize();
+
+        dataIn >> valuesOut._scale;
+    }
+
+    namespace DeltaCodec
+    {
+        void Encode(const ByteBuffer& state, const ByteBuffer& baseline, ByteBuffer& dataOut)
+        {
+            const size_t stateSize = state.bufferSize();
+            DIVIDE_ASSERT(stateSize <= MaxStateSize, "DeltaCodec::Encode: state too large!");
+
+            const Byte* data = state.contents() + state.rpos();
+            dataOut << to_U16(stateSize);
+
+            // Trailing unchanged bytes are implicit
+            size_t end = stateSize;
+            while (end > 0u && data[end - 1u] == BaselineByte(baseline, end - 1u))
+            {
+                --end;
+            }
+
+            std::array<Byte, MaxRunLength> literals;
+            for (size_t i = 0u; i < end;)
+            {
+                // A single unchanged byte costs as much as a literal, but ends the current literal run
+                size_t unchanged = 0u;
+                while (i + unchanged < end && unchanged < MaxRunLength && data[i + unchanged] == BaselineByte(baseline, i + unchanged))
+                {
+                    ++unchanged;
+                }
+
+                if (unchanged > 1u)
+                {
+                    dataOut << to_U8(unchanged - 1u);
+                    i += unchanged;
+                    continue;
+                }
+
+                size_t count = 0u;
+                while (i + count < end && count < MaxRunLength)
+                {
+                    const Byte delta = data[i + count] ^ BaselineByte(baseline, i + count);
+                    if (delta == Byte{ 0u } && i + count + 1u < end && data[i + count + 1u] == BaselineByte(baseline, i + count + 1u))
+                    {
+                        break;
+                    }
+                    literals[count++] = delta;
+                }
+
+                dataOut << to_U8(LiteralFlag + count - 1u);
+                dataOut.append(literals.data(), count);
+                i += count;
+            }
+        }
+
+        bool Decode(const Byte* data, const size_t size, const ByteBuffer& baseline, ByteBuffer& stateOut)
+        {
+            if (size < sizeof(U16))
+            {
+                return false;
+            }
+
+            U16 stateSize = 0u;
+            memcpy(&stateSize, data, sizeof(U16));
+
+            stateOut.clear();
+            stateOut.resize(stateSize);
+
+            // Start from the baseline (zeros past its end) and apply the changes on top
+            const size_t baselineBytes = std::min(baseline.bufferSize(), to_size(stateSize));
+            if (baselineBytes > 0u)
+            {
+                stateOut.put(0u, baseline.contents() + baseline.rpos(), baselineBytes);
+            }
+
+            std::array<Byte, MaxRunLength> literals;
+            size_t offset = 0u;
+            for (size_t read = sizeof(U16); read < size;)
+            {
+                const U8 control = to_U8(data[read++]);
+                if (control < LiteralFlag)
+                {
+                    offset += control + 1u;
+                    continue;
+                }
+
+                const size_t count = control - LiteralFlag + 1u;
+                if (read + count > size || offset + count > stateSize)
+                {
+                    return false;
+                }
+
+                for (size_t i = 0u; i < count; ++i)
+                {
+                    literals[i] = data[read + i] ^ BaselineByte(baseline, offset + i);
+                }
+                stateOut.put(offset, literals.data(), count);
+
+                read += count;
+                offset += count;
+            }
+
+            return offset <= stateSize;
+        }
+    } //namespace DeltaCodec
+
+    U32 DeltaEncoder::encode(const ByteBuffer& state, ByteBuffer& dataOut)
+    {
+        const U32 sequence = _nextSequence++;
+
+        const bool keyframe = _sendsSinceKeyframe++ >= KeyframeInterval;
+        if (keyframe)
+        {
+            _keyframeSequence = sequence;
+            _sendsSinceKeyframe = 1u;
+        }
+
+        const Entry* baseline = nullptr;
+        // Until the receiver acknowledges the latest keyframe we keep sending full states
+        if (!keyframe &&
+            _ackedSequence != INVALID_SEQUENCE &&
+            _ackedSequence >= _keyframeSequence &&
+            sequence - _ackedSequence < HistorySize)
+        {
+            const Entry& entry = _history[_ackedSequence % HistorySize];
+            if (entry._sequence == _ackedSequence)
+            {
+                baseline = &entry;
+            }
+        }
+
+        dataOut << sequence;
+        dataOut << to_U8(baseline != nullptr ? sequence - baseline->_sequence : 0u);
+        DeltaCodec::Encode(state, baseline != nullptr ? baseline->_state : ByteBuffer{}, dataOut);
+
+        Entry& entry = _history[sequence % HistorySize];
+        entry._sequence = sequence;
+        entry._state.clear();
+        entry._state.append(state.contents() + state.rpos(), state.bufferSize());
+
+        return sequence;
+    }
+
+    void DeltaEncoder::onAck(const U32 sequence) noexcept
+    {
+        // Acks can arrive out of order. We only care about the newest one
+        if (sequence > _ackedSequence && sequence < _nextSequence)
+        {
+            _ackedSequence = sequence;
+        }
+    }
+
+    void DeltaEncoder::reset() noexcept
+    {
+        for (Entry& entry : _history)
+        {
+            entry._sequence = INVALID_SEQUENCE;
+        }
+        _ackedSequence = INVALID_SEQUENCE;
+        _keyframeSequence = INVALID_SEQUENCE;
+        _sendsSinceKeyframe = 0u;
+    }
+
+    bool DeltaDecoder::decode(const Byte* data, const size_t size, ByteBuffer& stateOut, U32& sequenceOut)
+    {
+        constexpr size_t headerSize = sizeof(U32) + sizeof(U8);
+        if (size < headerSize)
+        {
+            return false;
+        }
+
+        U32 sequence = DeltaEncoder::INVALID_SEQUENCE;
+        memcpy(&sequence, data, sizeof(U32));
+        const U8 baselineOffset = to_U8(data[sizeof(U32)]);
+
+        if (sequence == DeltaEncoder::INVALID_SEQUENCE || sequence <= _lastSequence)
+        {
+            return false;
+        }
+
+        const ByteBuffer* baseline = nullptr;
+        if (baselineOffset > 0u)
+        {
+            const U32 baselineSequence = sequence - baselineOffset;
+            const Entry& entry = _history[baselineSequence % DeltaEncoder::HistorySize];
+            if (baselineOffset >= DeltaEncoder::HistorySize || entry._sequence != baselineSequence)
+            {
+                return false;
+            }
+            baseline = &entry._state;
+        }
+
+        if (!DeltaCodec::Decode(data + headerSize, size - headerSize, baseline != nullptr ? *baseline : ByteBuffer{}, stateOut))
+        {
+            return false;
+        }
+
+        Entry& entry = _history[sequence % DeltaEncoder::HistorySize];
+        entry._sequence = sequence;
+        entry._state = stateOut;
+
+        _lastSequence = sequence;
+        sequenceOut = sequence;
+        return true;
+    }
+
+    void DeltaDecoder::reset() noexcept
+    {
+        for (Entry& entry : _history)
+        {
+            entry._sequence = DeltaEncoder::INVALID_SEQUENCE;
+        }
+        _lastSequence = DeltaEncoder::INVALID_SEQUENCE;
+    }
+
+} //namespace Divide::Networking
@@ -35,6 +35,8 @@
 #define DVD_NETWORKING_CLIENT_H_	
 
 #include "Common.h"
+#include "UDPTransport.h"
+#include "SnapshotInterpolation.h"
 
 namespace Divide
 {
@@ -44,7 +46,7 @@ namespace Networking
     {
     public:
         Client();
-        ~Client();
+        virtual ~Client();
 
     public:
         [[nodiscard]] bool connect(std::string_view host, const U16 port);
@@ -54,29 +56,62 @@ namespace Networking
         /// Send a packet to the server
         void send(const NetworkPacket& p);
 
+        /// Only entities within 'radius' of 'position' get replicated to us. A negative radius means everything.
+        /// Cheap to call every frame: the server only hears about it when the area changed noticeably
+        void updateInterest(const float3& position, F32 radius);
+
         // Should poll the message queue and process any received packets
         void update();
 
-        // This is the thread safe queue of incoming messages from server
+        /// Advances our estimate of the server clock and returns the server time remote entities should be rendered at. Call once per frame
+        [[nodiscard]] U64 updateRenderTime(U64 localTimeUS) noexcept;
+
+        /// How remote entities are interpolated and how corrections to our own are blended in
+        PROPERTY_RW(InterpolationSettings, interpolationSettings);
+
+    protected:
+        // Every packet we send or receive comes from here. Declared first so that it outlives everything holding on to its packets
+        PacketPool _packetPool;
+
+    public:
+        // This is the lock free queue of incoming messages from server
         PROPERTY_R(OwnedPacketQueue, messagesIn);
 
         void requestFile(const ResourcePath& path, const string& name);
 
     protected:
-        void receiveMessage(NetworkPacket& msg);
+        // Called for every message the server sends us, from update()
+        virtual void receiveMessage(NetworkPacket& msg);
         void sendMessage(const NetworkPacket& msg);
 
         void heartbeatWait();
         void heartbeatSend();
 
+        // Asio thread only. The server told us our ID (and the token that goes with it), so we can open our side of the UDP channels
+        void startUDP(U32 connectionID, U32 token);
+        void updateUDP();
+
     protected:
         static constexpr U8 HeartbeastPerPingRequest = 4u;
+        /// Resend our area of interest once we moved this much (as a fraction of its radius)
+        static constexpr F32 InterestResendDistanceFactor = 0.05f;
 
         boost::asio::io_context _context;
         std::thread _contextThread;
         U8 _heartbeatCounter = 0u;
         boost::asio::deadline_timer _heartbeatTimer;
 
+        UDPTransport _udpTransport;
+        boost::asio::deadline_timer _udpTimer;
+        std::string _host;
+        U16 _port{ 0u };
+
+        float3 _interestPosition{};
+        F32 _interestRadius{ -1.f };
+
+        /// Fed by the server timestamps in entity updates
+        ClockSync _clockSync;
+
         // The client has a single instance of a "connection" object, which handles data transfer
         Connection_uptr _connection;
     };
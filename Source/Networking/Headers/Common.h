@@ -90,116 +90,33 @@
 #ifndef DVD_NETWORKING_COMMON_H_
 #define DVD_NETWORKING_COMMON_H_	
 
-#include "NetworkPacket.h"
+#include "PacketPool.h"
 
 namespace Divide
 {
 namespace Networking
 {
-    template<typename T>
-    class tsqueue
+    struct OwnedNetworkPacket
     {
-    public:
-        tsqueue() = default;
-        tsqueue(const tsqueue<T>&) = delete;
-        virtual ~tsqueue() { clear(); }
-
-    public:
-        // Returns and maintains item at front of Queue
-        const T& front()
-        {
-            ScopedLock<Mutex> lock(muxQueue);
-            return deqQueue.front();
-        }
-
-        // Returns and maintains item at back of Queue
-        const T& back()
-        {
-            ScopedLock<Mutex> lock(muxQueue);
-            return deqQueue.back();
-        }
-
-        // Removes and returns item from front of Queue
-        T pop_front()
-        {
-            ScopedLock<Mutex> lock(muxQueue);
-            auto t = MOV(deqQueue.front());
-            deqQueue.pop_front();
-            return t;
-        }
+        Connection_ptr _remote{ nullptr };
+        PacketRef      _msg;
 
-        // Removes and returns item from back of Queue
-        T pop_back()
+        friend std::ostream& operator<<(std::ostream& os, const OwnedNetworkPacket& msg)
         {
-            ScopedLock<Mutex> lock(muxQueue);
-            auto t = MOV(deqQueue.back());
-            deqQueue.pop_back();
-            return t;
+            os << *msg._msg;
+            return os;
         }
-
-        // Adds an item to back of Queue
-        void push_back(const T& item)
-        {
-            ScopedLock<Mutex> lock(muxQueue);
-            deqQueue.emplace_back(MOV(item));
-
-            UniqueLock<Mutex> ul(muxBlocking);
-            cvBlocking.notify_one();
-        }
-
-        // Adds an item to front of Queue
-        void push_front(const T& item)
-        {
-            ScopedLock<Mutex> lock(muxQueue);
-            deqQueue.emplace_front(MOV(item));
-
-            UniqueLock<Mutex> ul(muxBlocking);
-            cvBlocking.notify_one();
-        }
-
-        // Returns true if Queue has no items
-        bool empty()
-        {
-            ScopedLock<Mutex> lock(muxQueue);
-            return deqQueue.empty();
-        }
-
-        // Returns number of items in Queue
-        size_t count()
-        {
-            ScopedLock<Mutex> lock(muxQueue);
-            return deqQueue.size();
-        }
-
-        // Clears Queue
-        void clear()
-        {
-            ScopedLock<Mutex> lock(muxQueue);
-            deqQueue.clear();
-        }
-
-        void wait()
-        {
-            while (empty())
-            {
-                UniqueLock<Mutex> ul(muxBlocking);
-                cvBlocking.wait(ul);
-            }
-        }
-
-    protected:
-        Mutex muxQueue;
-        std::deque<T> deqQueue;
-        std::condition_variable cvBlocking;
-        Mutex muxBlocking;
     };
 
-    using PacketQueue = tsqueue<NetworkPacket>;
-    using OwnedPacketQueue = tsqueue<OwnedNetworkPacket>;
+    // Lock free queue of incoming messages. Every connection of a client/server is serviced by the same asio thread,
+    // so messages come out in the order they were received (the queue is FIFO per producing thread)
+    using OwnedPacketQueue = moodycamel::BlockingConcurrentQueue<OwnedNetworkPacket>;
 
 
     static constexpr char LocalHostAddress[] = "127.0.0.1";
     static constexpr U16 NetworkingPort = 3443u;
+    // How often UDP channels resend lost datagrams and send acks
+    static constexpr U32 UDPUpdateIntervalMS = 10u;
 
     [[nodiscard]] inline bool IsLocalHostAddress(const std::string_view address) noexcept
     {
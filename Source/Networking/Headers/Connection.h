@@ -35,6 +35,7 @@
 #define DVD_NETWORKING_CONNECTION_H_	
 
 #include "Common.h"
+#include "UDPTransport.h"
 
 namespace Divide
 {
@@ -52,8 +53,12 @@ namespace Networking
             };
 
         public:
-            // Constructor: Specify Owner, connect to context, transfer the socket. Provide reference to incoming message queue
-            Connection(Owner parent, boost::asio::io_context& asioContext, boost::asio::ip::tcp::socket socket, OwnedPacketQueue& qIn);
+            // Pending writes are batched into a single (scatter-gather) async_write of up to this many messages
+            static constexpr size_t MaxMessagesPerWrite = 64u;
+
+        public:
+            // Constructor: Specify Owner, connect to context, transfer the socket. Provide reference to incoming message queue and to the pool packets are allocated from
+            Connection(Owner parent, boost::asio::io_context& asioContext, boost::asio::ip::tcp::socket socket, OwnedPacketQueue& qIn, PacketPool& packetPool);
 
             virtual ~Connection();
 
@@ -75,13 +80,26 @@ namespace Networking
 
             // ASYNC - Send a message, connections are one-to-one so no need to specifiy the target, for a client, the target is the server and vice versa
             void send(const NetworkPacket& p);
+            // ASYNC - Same as above, but queues the (shared, read only) packet as is. Use this to send the same packet on multiple connections
+            void send(PacketRef p);
+
+            // UDP side of the connection. Everything below must be called from the asio thread.
+            // Start exchanging datagrams with 'remote' through 'transport'. Messages only switch over to UDP once datagrams arrive from the other side as well.
+            // Datagrams have to carry both the connection ID and the token the server generated for it
+            void enableUDP(UDPTransport& transport, const boost::asio::ip::udp::endpoint& remote, U32 connectionID, U32 token);
+            [[nodiscard]] bool udpEnabled() const noexcept { return _udpEndpoint != nullptr; }
+            // A datagram for this connection arrived. We always answer the latest address a valid one came from, in case a NAT changed it
+            void onDatagram(const boost::asio::ip::udp::endpoint& remote, const Byte* data, size_t size);
+            // Resend lost datagrams and send acks. Called every UDPUpdateIntervalMS by the owner
+            void updateUDP();
+
+            // Bytes written to and read from the TCP socket and the UDP channels (message headers and datagram headers included). Safe to call from any thread
+            [[nodiscard]] U64 bytesSent() const noexcept { return _bytesSent.load(std::memory_order_relaxed); }
+            [[nodiscard]] U64 bytesReceived() const noexcept { return _bytesReceived.load(std::memory_order_relaxed); }
 
         private:
-            // ASYNC - Prime context to write a message header
-            void writeHeader();
-
-            // ASYNC - Prime context to write a message body
-            void writeBody();
+            // ASYNC - Prime context to write the headers and bodies of (up to MaxMessagesPerWrite) queued messages
+            void writeMessages();
 
             // ASYNC - Prime context ready to read a message header
             void readHeader();
@@ -89,8 +107,29 @@ namespace Networking
             // ASYNC - Prime context ready to read a message body
             void readBody();
 
+            // Asio thread only. Never throws
+            void closeSocket();
+            // Asio thread only. Queue the packet on the TCP stream, starting a write if none is in progress
+            void sendTCP(PacketRef packet);
+            // Asio thread only. Sends 'packet' over UDP if its channel switched over already. Returns false if it has to go through TCP
+            [[nodiscard]] bool sendUDP(PacketRef& packet);
+            // Asio thread only. Returns true for connection internal messages, which never reach the owner
+            [[nodiscard]] bool handleTransportMessage(const NetworkPacket& msg);
+
             // Once a full message is received, add it to the incoming queue
             void addToIncomingMessageQueue();
+            void pushIncomingMessage(PacketRef msg);
+
+    protected:
+        // Reliable ordered messages only move to UDP once the remote side confirmed it got everything we sent over TCP before,
+        // otherwise the first UDP messages could overtake the last TCP ones (e.g. an update overtaking the SMSG_ENTITY_ENTER that resets its baseline)
+        enum class OrderedTransport : U8
+        {
+            TCP,
+            // Fence sent, waiting for the ack. Messages are held back in _fencedMessages
+            FENCING,
+            UDP
+        };
 
     protected:
         // Each connection has a unique socket to a remote 
@@ -99,19 +138,38 @@ namespace Networking
         // This context is shared with the whole asio instance
         boost::asio::io_context& _asioContext;
 
-        // This queue holds all messages to be sent to the remote side of this connection
-        PacketQueue _messagesOut;
+        // This queue holds all messages to be sent to the remote side of this connection. Only touched by the asio thread
+        std::deque<PacketRef> _messagesOut;
+        // How many messages from the front of _messagesOut the current async_write is sending
+        size_t _messagesInFlight{ 0u };
+        // Header and body buffers of the messages in flight
+        std::vector<boost::asio::const_buffer> _writeBuffers;
 
         // This references the incoming queue of the parent object
         OwnedPacketQueue& _messagesIn;
 
+        // Every message we send or receive comes from (and goes back to) this pool
+        PacketPool& _packetPool;
+
         // Incoming messages are constructed asynchronously, so we will
         // store the part assembled message here, until it is ready
-        NetworkPacket _msgTemporaryIn;
+        PacketRef _msgTemporaryIn;
+
+        // UDP channels to the remote side, if enabled. Only touched by the asio thread
+        std::unique_ptr<ReliableEndpoint> _udpEndpoint;
+        UDPTransport* _udpTransport{ nullptr };
+        boost::asio::ip::udp::endpoint _udpRemote;
+        OrderedTransport _orderedTransport{ OrderedTransport::TCP };
+        // Reliable ordered messages sent while we wait for the fence ack, in order
+        std::deque<PacketRef> _fencedMessages;
 
         // The "owner" decides how some of the connection behaves
         Owner _ownerType{ Owner::SERVER };
 
+        // Only written by the asio thread
+        std::atomic<U64> _bytesSent{ 0u };
+        std::atomic<U64> _bytesReceived{ 0u };
+
     };
 
     FWD_DECLARE_MANAGED_CLASS(Connection);
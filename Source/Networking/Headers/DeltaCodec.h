@@ -0,0 +1,122 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_NETWORKING_DELTA_CODEC_H_
+#define DVD_NETWORKING_DELTA_CODEC_H_
+
+#include "Core/Headers/ByteBuffer.h"
+
+namespace Divide
+{
+    struct TransformValues;
+
+namespace Networking
+{
+    /// Writes position, orientation and scale in their replicated (quantized) form.
+    /// Position is fixed point (1/1024 units), orientation uses "smallest three" packed with ByteBuffer::appendPackXYZ and scale is sent as is.
+    /// The same input always produces the same bytes, so unchanged fields delta compress to nothing
+    void WriteTransform(ByteBuffer& dataOut, const TransformValues& values);
+    /// Reads a transform written by WriteTransform
+    void ReadTransform(ByteBuffer& dataIn, TransformValues& valuesOut);
+
+    /// Byte level delta: XOR against a baseline, with runs of unchanged bytes run length encoded.
+    /// Format: [U16 state size] followed by control bytes. 0x00 - 0x7F: (c + 1) unchanged bytes. 0x80 - 0xFF: (c - 0x7F) XOR-ed bytes follow.
+    /// Anything past the last control byte is unchanged as well
+    namespace DeltaCodec
+    {
+        static constexpr size_t MaxStateSize = U16_MAX;
+
+        /// Appends the delta between state and baseline (both read from their rpos) to dataOut. An empty baseline sends the full state
+        void Encode(const ByteBuffer& state, const ByteBuffer& baseline, ByteBuffer& dataOut);
+        /// Rebuilds a state from an encoded delta and the baseline it was encoded against. Returns false if the input is malformed
+        [[nodiscard]] bool Decode(const Byte* data, size_t size, const ByteBuffer& baseline, ByteBuffer& stateOut);
+    } //namespace DeltaCodec
+
+    /// Sender side of a delta compressed stream: remembers recently sent states and encodes every new one against the latest one the receiver acknowledged
+    class DeltaEncoder
+    {
+    public:
+        static constexpr U32 INVALID_SEQUENCE = 0u;
+        /// How many sent states we remember. Acks older than this are useless and we fall back to sending a full state
+        static constexpr U32 HistorySize = 32u;
+        /// Send a full state every so often, even if we have a valid baseline, so that receivers that joined late can catch up.
+        /// Deltas are never encoded against a state older than the latest keyframe, so a receiver that decoded one stays in sync
+        static constexpr U32 KeyframeInterval = 120u;
+
+        /// Appends [U32 sequence][U8 sequence - baseline sequence, 0 = none][delta] to dataOut. Returns the sequence of this state
+        U32 encode(const ByteBuffer& state, ByteBuffer& dataOut);
+        /// The receiver has (directly or through the server) seen the state with this sequence
+        void onAck(U32 sequence) noexcept;
+        /// Forget all baselines. The next state goes out in full
+        void reset() noexcept;
+
+        [[nodiscard]] U32 lastSequence() const noexcept { return _nextSequence - 1u; }
+        [[nodiscard]] U32 ackedSequence() const noexcept { return _ackedSequence; }
+
+    private:
+        struct Entry
+        {
+            U32 _sequence{ INVALID_SEQUENCE };
+            ByteBuffer _state;
+        };
+
+        std::array<Entry, HistorySize> _history;
+        U32 _nextSequence{ 1u };
+        U32 _ackedSequence{ INVALID_SEQUENCE };
+        U32 _keyframeSequence{ INVALID_SEQUENCE };
+        U32 _sendsSinceKeyframe{ 0u };
+    };
+
+    /// Receiver side of a delta compressed stream
+    class DeltaDecoder
+    {
+    public:
+        /// Reads data written by DeltaEncoder::encode. Returns false for stale or malformed input or if we don't have the baseline (e.g. we joined late and haven't received a full state yet).
+        /// On success, stateOut holds the full state and sequenceOut the sequence to acknowledge
+        [[nodiscard]] bool decode(const Byte* data, size_t size, ByteBuffer& stateOut, U32& sequenceOut);
+        void reset() noexcept;
+
+    private:
+        struct Entry
+        {
+            U32 _sequence{ DeltaEncoder::INVALID_SEQUENCE };
+            ByteBuffer _state;
+        };
+
+        std::array<Entry, DeltaEncoder::HistorySize> _history;
+        U32 _lastSequence{ DeltaEncoder::INVALID_SEQUENCE };
+    };
+
+} //namespace Networking
+} //namespace Divide
+
+#endif //DVD_NETWORKING_DELTA_CODEC_H_
@@ -0,0 +1,143 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+
+#pragma once
+#ifndef DVD_NETWORKING_INTEREST_MANAGER_H_
+#define DVD_NETWORKING_INTEREST_MANAGER_H_
+
+#include "Core/Math/BoundingVolumes/Headers/DynamicAABBTree.h"
+
+namespace Divide
+{
+namespace Networking
+{
+    /// Server side replication filter. It tracks where every replicated entity is and what area each client cares about.
+    /// Every tick it decides which entity states a client gets: only entities inside the client's area of interest, most important first, until the client's byte budget runs out.
+    /// Entities waiting to be sent build up priority every tick (closer ones faster), so far away entities still get updated, just less often.
+    /// Not thread safe. The server drives it from its update thread
+    class InterestManager
+    {
+    public:
+        using EntityID = I64;
+        using ClientID = U32;
+
+        struct Settings
+        {
+            /// Bytes of entity state each client gets per tick. At least one update always goes out, so a big state can't stall a client forever
+            size_t _bytesPerClientPerTick{ 4096u };
+            /// Entities leave once they are further than radius * this, so they don't flicker in and out at the edge
+            F32 _leaveRadiusFactor{ 1.1f };
+            /// Priority an entity gets when it enters a client's area of interest. Its first (full) state should go out before any regular update
+            F32 _enterPriority{ 100.f };
+        };
+
+        /// The server does the actual sending. onSend returns the number of bytes it sent
+        struct Callbacks
+        {
+            DELEGATE<void, ClientID, EntityID> _onEnter;
+            DELEGATE<void, ClientID, EntityID> _onLeave;
+            DELEGATE<size_t, ClientID, EntityID> _onSend;
+        };
+
+        explicit InterestManager(const Settings& settings);
+
+        /// Clients get every entity until they tell us where they are. A negative radius means everything
+        void setInterest(ClientID client, const float3& position, F32 radius);
+        /// Forget the client. No leave notifications are sent
+        void removeClient(ClientID client);
+
+        /// The entity has a new state to send. Entities without a position are relevant to every client. Entities are never sent back to their owner
+        void updateEntity(EntityID entity, ClientID owner, const float3* position);
+        /// Clients that can see the entity get a leave notification on their next update
+        void removeEntity(EntityID entity);
+
+        /// Runs a tick for this client: enter and leave notifications first, then as many entity updates as the budget allows
+        void updateClient(ClientID client, const Callbacks& callbacks);
+
+        [[nodiscard]] size_t entityCount() const noexcept { return _entities.size(); }
+        /// Number of entities the client currently knows about
+        [[nodiscard]] size_t relevantCount(ClientID client) const;
+
+        PROPERTY_RW(Settings, settings);
+
+    private:
+        struct Entity
+        {
+            float3 _position;
+            U32 _proxy{ DynamicAABBTree<EntityID>::INVALID_PROXY };
+            U32 _version{ 0u };
+            ClientID _owner{ 0u };
+        };
+
+        struct Relevant
+        {
+            F32 _priority{ 0.f };
+            /// Entity version we last sent. 0 = nothing yet
+            U32 _sentVersion{ 0u };
+            U32 _seenTick{ 0u };
+        };
+
+        struct Client
+        {
+            hashMap<EntityID, Relevant> _relevant;
+            float3 _position;
+            F32 _radius{ -1.f };
+            U32 _tick{ 0u };
+        };
+
+        struct Candidate
+        {
+            EntityID _entity{ -1 };
+            F32 _priority{ 0.f };
+            U32 _version{ 0u };
+            Relevant* _relevant{ nullptr };
+        };
+
+        /// Marks the entity as relevant this tick, accumulating priority if it has something new to send
+        void touch(Client& client, ClientID clientID, EntityID entityID, const Entity& entity, F32 distanceFactor, const Callbacks& callbacks);
+
+    private:
+        hashMap<EntityID, Entity> _entities;
+        hashMap<ClientID, Client> _clients;
+        /// Only entities with a position go in here
+        DynamicAABBTree<EntityID> _spatialIndex;
+        /// The rest are relevant to everyone
+        vector<EntityID> _unpositioned;
+
+        vector<Candidate> _candidates;
+        vector<EntityID> _left;
+    };
+
+} //namespace Networking
+} //namespace Divide
+
+#endif //DVD_NETWORKING_INTEREST_MANAGER_H_
@@ -0,0 +1,97 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+
+#pragma once
+#ifndef DVD_NETWORKING_LOSSY_LOOPBACK_H_
+#define DVD_NETWORKING_LOSSY_LOOPBACK_H_
+
+#include <random>
+
+namespace Divide
+{
+namespace Networking
+{
+    /// Stands in for the network between two datagram endpoints (side 0 and side 1) so that the UDP channels can be tested locally:
+    /// datagrams are delayed, dropped and reordered according to the current settings. The same seed always produces the same network conditions
+    class LossyLoopback
+    {
+    public:
+        struct Settings
+        {
+            /// Chance [0, 1] of a datagram never arriving
+            F32 _dropChance{ 0.f };
+            /// Chance [0, 1] of a datagram being held back for an extra _reorderDelayUS, so that later ones overtake it
+            F32 _reorderChance{ 0.f };
+            U64 _reorderDelayUS{ 0u };
+            /// One way delay. Each datagram gets a random extra [0, _jitterUS] on top
+            U64 _latencyUS{ 0u };
+            U64 _jitterUS{ 0u };
+            U32 _seed{ 1u };
+        };
+
+        using DeliverCallback = DELEGATE<void, U8, const Byte*, size_t>;
+
+        explicit LossyLoopback(const Settings& settings);
+
+        /// Queues a datagram sent by 'source' (0 or 1) for the other side
+        void send(U8 source, const Byte* data, size_t size, U64 timeUS);
+        /// Calls 'callback' with the destination side of every datagram that arrived by 'timeUS', in arrival order.
+        /// The callback may send new datagrams
+        void deliver(U64 timeUS, const DeliverCallback& callback);
+
+        [[nodiscard]] size_t inFlightCount() const noexcept { return _inFlight.size(); }
+
+        /// Can be changed at any time. Only affects datagrams sent afterwards
+        PROPERTY_RW(Settings, settings);
+        PROPERTY_R(U64, droppedCount, 0u);
+        PROPERTY_R(U64, reorderedCount, 0u);
+
+    private:
+        struct Datagram
+        {
+            vector<Byte> _data;
+            U64 _deliveryTimeUS{ 0u };
+            /// Tie breaker, so that datagrams due at the same time arrive in the order they were sent
+            U64 _order{ 0u };
+            U8 _destination{ 0u };
+        };
+
+        vector<Datagram> _inFlight;
+        vector<Datagram> _arrived;
+        std::mt19937 _rng;
+        U64 _sendCount{ 0u };
+    };
+
+} //namespace Networking
+} //namespace Divide
+
+#endif //DVD_NETWORKING_LOSSY_LOOPBACK_H_
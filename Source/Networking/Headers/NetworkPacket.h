@@ -56,6 +56,16 @@ enum class OPCodes : U16
     SMSG_ENTITY_UPDATE,
     CMSG_REQUEST_FILE,
     SMSG_SEND_FILE,
+    SMSG_ENTITY_ACK,
+    SMSG_CONNECTION_ID,
+    CMSG_INTEREST,
+    SMSG_ENTITY_ENTER,
+    SMSG_ENTITY_LEAVE,
+    // [GUID][sequence] of an entity update the client decoded. The server encodes the next ones against it
+    CMSG_ENTITY_UPDATE_ACK,
+    // Connection internal. Sent over TCP before the first reliable ordered message goes out over UDP, and answered once every message sent over TCP before it was received
+    MSG_TRANSPORT_FENCE,
+    MSG_TRANSPORT_FENCE_ACK,
     COUNT
 };
 
@@ -90,6 +100,20 @@ struct NetworkPacket
         return msg;
     }
 
+    /// Clears the body (keeping its storage around) and sets a new opcode
+    void reset(const OPCodes opCode) noexcept
+    {
+        _header = { 0u, opCode };
+        _body.clear();
+    }
+
+    /// Appends 'count' raw bytes from 'src' to the body
+    void append(const Byte* src, const size_t count)
+    {
+        _body.append(src, count);
+        _header._byteLength = _body.bufferSize();
+    }
+
     friend std::ostream& operator << (std::ostream& os, const NetworkPacket& msg)
     {
         os << "ID:" << to_base(msg._header._opCode) << " Size:" << msg._header._byteLength;
@@ -102,19 +126,6 @@ struct NetworkPacket
 };
 
 
-struct OwnedNetworkPacket
-{
-    Connection_ptr _remote{ nullptr };
-    NetworkPacket  _msg;
-
-    friend std::ostream& operator<<(std::ostream& os, const OwnedNetworkPacket& msg)
-    {
-        os << msg._msg;
-        return os;
-    }
-};
-
-
 } // namespace Networking
 } // namespace Divide
 
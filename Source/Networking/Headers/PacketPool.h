@@ -0,0 +1,122 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+
+#pragma once
+#ifndef DVD_NETWORKING_PACKET_POOL_H_
+#define DVD_NETWORKING_PACKET_POOL_H_
+
+#include "NetworkPacket.h"
+
+namespace Divide
+{
+namespace Networking
+{
+    class PacketPool;
+
+    /// Refcounted handle to a pooled packet. Copies share the same packet (e.g. one broadcast queued on every connection)
+    /// and the last handle to go away hands it back to its pool, storage and all.
+    /// Shared packets must be treated as read only: only the (unique) receiver of an incoming packet should read from it with operator>>
+    class PacketRef
+    {
+    public:
+        PacketRef() noexcept = default;
+        ~PacketRef();
+
+        PacketRef(const PacketRef& other) noexcept;
+        PacketRef(PacketRef&& other) noexcept;
+        PacketRef& operator=(const PacketRef& other) noexcept;
+        PacketRef& operator=(PacketRef&& other) noexcept;
+
+        [[nodiscard]] NetworkPacket& operator*() const noexcept { return _node->_packet; }
+        [[nodiscard]] NetworkPacket* operator->() const noexcept { return &_node->_packet; }
+        [[nodiscard]] explicit operator bool() const noexcept { return _node != nullptr; }
+
+        [[nodiscard]] U32 useCount() const noexcept;
+        void reset() noexcept;
+
+    private:
+        friend class PacketPool;
+
+        struct Node
+        {
+            NetworkPacket _packet{ OPCodes::MSG_NOP };
+            std::atomic<U32> _refCount{ 0u };
+            PacketPool* _pool{ nullptr };
+        };
+
+        explicit PacketRef(Node* node) noexcept;
+
+    private:
+        Node* _node{ nullptr };
+    };
+
+    /// Recycles packets (and their body storage) so that sending and receiving doesn't allocate in the steady state.
+    /// Thread safe: packets are acquired and released on both the asio thread and the thread that processes them.
+    /// Must outlive every PacketRef it handed out
+    class PacketPool
+    {
+    public:
+        /// Released packets past this count are freed instead of pooled
+        static constexpr size_t MaxPooledPackets = 256u;
+        /// Packets that grew larger than this (e.g. file transfers) are freed instead of pooled, so they don't pin memory
+        static constexpr size_t MaxPooledBodySize = 64u * 1024u;
+
+        PacketPool() = default;
+        ~PacketPool();
+
+        PacketPool(const PacketPool&) = delete;
+        PacketPool& operator=(const PacketPool&) = delete;
+
+        /// Returns an empty packet with the specified opcode
+        [[nodiscard]] PacketRef acquire(OPCodes opCode);
+        /// Returns a pooled copy of 'source'
+        [[nodiscard]] PacketRef acquire(const NetworkPacket& source);
+
+        /// Number of packets created (and not yet freed) by this pool, whether they are in use or not
+        [[nodiscard]] size_t allocatedCount() const noexcept { return _allocatedCount.load(std::memory_order_relaxed); }
+        /// Number of packets waiting to be reused
+        [[nodiscard]] size_t pooledCount() const noexcept { return _pooledCount.load(std::memory_order_relaxed); }
+
+    private:
+        friend class PacketRef;
+        void release(PacketRef::Node* node);
+
+    private:
+        moodycamel::ConcurrentQueue<PacketRef::Node*> _freeNodes;
+        std::atomic_size_t _allocatedCount{ 0u };
+        std::atomic_size_t _pooledCount{ 0u };
+    };
+
+} //namespace Networking
+} //namespace Divide
+
+#endif //DVD_NETWORKING_PACKET_POOL_H_
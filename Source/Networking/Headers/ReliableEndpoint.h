@@ -0,0 +1,235 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+
+#pragma once
+#ifndef DVD_NETWORKING_RELIABLE_ENDPOINT_H_
+#define DVD_NETWORKING_RELIABLE_ENDPOINT_H_
+
+#include "PacketPool.h"
+
+#include <bitset>
+#include <deque>
+
+namespace Divide
+{
+namespace Networking
+{
+    /// How a message travels. Everything goes through the TCP connection by default. Message types that suffer from head-of-line blocking can be moved to a UDP channel.
+    /// UDP channels are independent of each other, so a lost datagram only ever stalls the (reliable ordered) channel it belongs to
+    enum class DeliveryMode : U8
+    {
+        TCP = 0,
+        /// Resent until acknowledged, delivered in the order it was sent
+        UDP_RELIABLE_ORDERED,
+        /// Resent until acknowledged, delivered as soon as it arrives
+        UDP_RELIABLE_UNORDERED,
+        /// Sent once. Lost messages and messages older than the newest one delivered are dropped
+        UDP_SEQUENCED_UNRELIABLE,
+        COUNT
+    };
+
+    /// UDP messages only use UDP once the UDP path to the remote side is up. Until then (or if UDP is blocked) they go through TCP
+    [[nodiscard]] DeliveryMode GetDeliveryMode(OPCodes opCode) noexcept;
+    /// Not thread safe. Change delivery modes before connecting
+    void SetDeliveryMode(OPCodes opCode, DeliveryMode mode) noexcept;
+
+    /// Reliability layer on top of an unreliable datagram transport (UDP or LossyLoopback). It doesn't own a socket or a clock:
+    /// datagrams go out through a callback and the caller passes in the current time, so it can be driven by anything (e.g. a unit test).
+    /// Every datagram starts with [U32 connection ID][U32 token][U16 sequence][U16 ack][U32 ack bits]. The token is a random number the server hands out with the ID,
+    /// so that nobody can inject datagrams into (or redirect) a connection just by guessing its ID. Ack is the newest datagram sequence received from the remote side
+    /// and which of the 32 before it also arrived. Messages larger than a datagram are split into fragments. Reliable fragments are resent until acked,
+    /// after a timeout derived from the measured round trip time.
+    class ReliableEndpoint
+    {
+    public:
+        /// Conservative datagram size that fits in a single ethernet frame, even with IPv6 and tunnel headers on top
+        static constexpr size_t MaxDatagramSize = 1200u;
+        static constexpr size_t DatagramHeaderSize = sizeof(U32) * 2u + sizeof(U16) * 2u + sizeof(U32);
+        /// [U8 delivery mode][U16 message ID][U16 opcode][U16 fragment index][U16 fragment count]
+        static constexpr size_t FragmentHeaderSize = sizeof(U8) + sizeof(U16) * 4u;
+        static constexpr size_t MaxFragmentSize = MaxDatagramSize - DatagramHeaderSize - FragmentHeaderSize;
+        /// Largest message we send or reassemble. Fragment counts above MaxFragmentCount are rejected before anything gets allocated for them
+        static constexpr size_t MaxMessageSize = 256u * 1024u;
+        static constexpr size_t MaxFragmentCount = (MaxMessageSize + MaxFragmentSize - 1u) / MaxFragmentSize;
+        /// Partially received multi-fragment messages we keep around. Fragments of other messages are dropped (and resent later if reliable) until one completes
+        static constexpr size_t MaxReassemblyCount = 64u;
+        /// Reliable messages this far or further ahead of the next one we expect are dropped without acknowledging them, so the sender resends them once we caught up.
+        /// Bounds how many out of order messages we buffer. We never send that far ahead of our own oldest unacknowledged message either, newer ones wait in a queue
+        static constexpr U16 ReceiveWindowSize = 1024u;
+        /// With nothing else to send, send an empty datagram this often so the remote side keeps getting acks and NAT mappings stay open
+        static constexpr U64 KeepAliveIntervalUS = 1'000'000u;
+        /// Resend timeout bounds
+        static constexpr U64 MinResendTimeoutUS = 20'000u;
+        static constexpr U64 MaxResendTimeoutUS = 1'000'000u;
+        /// Acks only cover the newest datagram and the 32 before it. If the remote side sends more than that between our updates, we have to answer sooner or the older ones are never acknowledged
+        static constexpr U32 MaxUnackedDatagrams = 16u;
+
+        using SendCallback = DELEGATE<void, const Byte*, size_t>;
+        using ReceiveCallback = DELEGATE<void, PacketRef>;
+
+        struct Stats
+        {
+            U64 _datagramsSent{ 0u };
+            U64 _datagramsReceived{ 0u };
+            U64 _fragmentsResent{ 0u };
+            U64 _messagesDelivered{ 0u };
+            /// Duplicates, stale sequenced messages and malformed datagrams
+            U64 _messagesDropped{ 0u };
+        };
+
+        ReliableEndpoint(U32 connectionID, U32 token, PacketPool& packetPool, SendCallback&& sendCallback, ReceiveCallback&& receiveCallback);
+
+        /// Sends 'packet' on the specified UDP channel. Reliable messages are queued if the remote side couldn't take them yet (see ReceiveWindowSize)
+        void send(const NetworkPacket& packet, DeliveryMode mode, U64 timeUS);
+        /// Processes a datagram sent by the remote endpoint. Complete messages go to the receive callback. Datagrams that fail accepts() are dropped
+        void onDatagram(const Byte* data, size_t size, U64 timeUS);
+        /// True if the datagram carries our connection ID and token
+        [[nodiscard]] bool accepts(const Byte* data, size_t size) const noexcept;
+        /// Resends timed out reliable fragments and sends pending acks and keep alives. Call this every few milliseconds
+        void update(U64 timeUS);
+
+        /// Reads the connection ID and token of a datagram without processing it. Returns false if it's too small to be one of ours
+        [[nodiscard]] static bool PeekConnectionID(const Byte* data, size_t size, U32& idOut, U32& tokenOut) noexcept;
+
+        [[nodiscard]] U32 connectionID() const noexcept { return _connectionID; }
+        /// True once we received anything from the remote side, i.e. the path works both ways
+        [[nodiscard]] bool connected() const noexcept { return _remoteSequenceValid; }
+        /// Smoothed round trip time. 0 until we get the first ack
+        [[nodiscard]] U64 rttUS() const noexcept { return _smoothedRTTUS; }
+        [[nodiscard]] U64 resendTimeoutUS() const noexcept { return _resendTimeoutUS; }
+        /// Reliable fragments the remote side didn't acknowledge yet
+        [[nodiscard]] size_t pendingFragmentCount() const noexcept { return _pendingFragments.size(); }
+        /// Multi-fragment messages we're still waiting on
+        [[nodiscard]] size_t reassemblyCount() const noexcept { return _reassemblies.size(); }
+        /// Reliable ordered messages waiting for an earlier one
+        [[nodiscard]] size_t bufferedMessageCount() const noexcept { return _orderedBuffer.size(); }
+        /// Reliable messages we haven't sent yet because they're too far ahead of the oldest unacknowledged one
+        [[nodiscard]] size_t queuedMessageCount() const noexcept;
+        [[nodiscard]] const Stats& stats() const noexcept { return _stats; }
+
+    private:
+        static constexpr U64 InvalidFragmentKey = U64_MAX;
+        static constexpr size_t SentHistorySize = 1024u;
+
+        struct SentDatagram
+        {
+            U64 _timeUS{ 0u };
+            U64 _fragmentKey{ InvalidFragmentKey };
+            U16 _sequence{ 0u };
+            bool _valid{ false };
+        };
+
+        struct PendingFragment
+        {
+            /// Fragment header and payload, ready to be resent
+            vector<Byte> _block;
+            U64 _lastSendUS{ 0u };
+            U8 _resendCount{ 0u };
+        };
+
+        struct Reassembly
+        {
+            vector<Byte> _data;
+            vector<bool> _received;
+            size_t _size{ 0u };
+            U16 _receivedCount{ 0u };
+            OPCodes _opCode{ OPCodes::MSG_NOP };
+        };
+
+        struct Channel
+        {
+            U16 _nextSendID{ 0u };
+            /// Reliable channels: everything before this was delivered
+            U16 _nextReceiveID{ 0u };
+            /// Sequenced channel: newest message delivered so far
+            U16 _lastDeliveredID{ 0u };
+            bool _delivered{ false };
+            /// Reliable channels: oldest message the remote side didn't acknowledge yet, as of the last update(). Only ever behind the real one
+            U16 _oldestUnackedID{ 0u };
+            std::deque<PacketRef> _queued;
+        };
+
+        void sendFragments(const NetworkPacket& packet, DeliveryMode mode, U64 timeUS);
+        void sendDatagram(const Byte* block, size_t blockSize, U64 fragmentKey, U64 timeUS);
+        void processAcks(U16 ack, U32 ackBits, U64 timeUS);
+        void onAcked(U16 sequence, U64 timeUS);
+        /// Records that we received this datagram sequence. Returns false if we already did
+        [[nodiscard]] bool trackReceived(U16 sequence) noexcept;
+        /// False if we can't take this fragment now (outside the receive window or no room to reassemble it) and a reliable sender should resend it later
+        [[nodiscard]] bool canAccept(DeliveryMode mode, U16 messageID, U16 fragmentCount) const;
+        void onFragment(DeliveryMode mode, U16 messageID, OPCodes opCode, U16 fragmentIndex, U16 fragmentCount, const Byte* payload, size_t payloadSize);
+        [[nodiscard]] bool alreadyDelivered(DeliveryMode mode, U16 messageID) const;
+        void onMessage(DeliveryMode mode, U16 messageID, OPCodes opCode, const Byte* data, size_t size);
+        void deliver(PacketRef packet);
+
+    private:
+        const U32 _connectionID;
+        const U32 _token;
+        PacketPool& _packetPool;
+        SendCallback _sendCallback;
+        ReceiveCallback _receiveCallback;
+
+        /// Indexed by DeliveryMode - 1
+        std::array<Channel, to_base(DeliveryMode::COUNT) - 1u> _channels;
+
+        U16 _nextSequence{ 0u };
+        std::array<SentDatagram, SentHistorySize> _sentDatagrams;
+        hashMap<U64, PendingFragment> _pendingFragments;
+
+        U16 _remoteSequence{ 0u };
+        U32 _remoteAckBits{ 0u };
+        bool _remoteSequenceValid{ false };
+        bool _ackPending{ false };
+        /// Datagrams received since we last sent one
+        U32 _unackedDatagrams{ 0u };
+        U64 _lastSendUS{ 0u };
+
+        U64 _smoothedRTTUS{ 0u };
+        U64 _rttVarianceUS{ 0u };
+        U64 _resendTimeoutUS{ 200'000u };
+
+        hashMap<U32, Reassembly> _reassemblies;
+        /// Reliable ordered messages that arrived ahead of the one we're waiting for
+        hashMap<U16, PacketRef> _orderedBuffer;
+        /// Reliable unordered messages received ahead of the channel's _nextReceiveID
+        std::bitset<U16_MAX + 1u> _unorderedReceived;
+
+        ByteBuffer _datagramScratch;
+        ByteBuffer _blockScratch;
+
+        Stats _stats;
+    };
+
+} //namespace Networking
+} //namespace Divide
+
+#endif //DVD_NETWORKING_RELIABLE_ENDPOINT_H_
@@ -35,6 +35,8 @@
 #define DVD_NETWORKING_SERVER_H_	
 
 #include "Connection.h"
+#include "DeltaCodec.h"
+#include "InterestManager.h"
 
 namespace Divide
 {
@@ -60,6 +62,9 @@ namespace Networking
 
         // Force server to respond to incoming messages
         void update(size_t nMaxMessages = -1, bool bWait = false);
+
+        // Send entity updates to every client, limited to what each of them is interested in. Call once per network tick
+        void replicate();
         
 
     protected:
@@ -75,9 +80,22 @@ namespace Networking
         // Called when a message arrives
         virtual void receiveMessage(Connection_ptr client, NetworkPacket& msg);
 
+        // Route a datagram to the connection whose ID it carries. Asio thread only
+        void onDatagram(const boost::asio::ip::udp::endpoint& remote, const Byte* data, size_t size);
+        // Resend/ack on every UDP enabled connection and schedule the next update. Asio thread only
+        void updateUDP();
+
+        // Decode an entity state sent by its owner and queue it up for replication
+        void onEntityUpdate(const Connection_ptr& client, I64 guid, U32 frameCount, const NetworkPacket& msg);
+        // Drop everything we replicate to or on behalf of this client
+        void forgetClient(const Connection_ptr& client);
+
 
     protected:
-        // Thread Safe Queue for incoming message packets
+        // Every packet we send or receive comes from here. Declared first so that it outlives everything holding on to its packets
+        PacketPool _packetPool;
+
+        // Lock free queue for incoming message packets
         OwnedPacketQueue _messagesIn;
 
         // Container of active validated connections
@@ -92,6 +110,38 @@ namespace Networking
 
         // Clients will be identified in the "wider system" via an ID
         U32 _IDCounter = 123000;
+
+        // Datagrams for every client go through this one socket
+        UDPTransport _udpTransport;
+        boost::asio::deadline_timer _udpTimer;
+        struct UDPConnection
+        {
+            std::weak_ptr<Connection> _connection;
+            /// Random. Datagrams without it are dropped, so knowing (or guessing) a connection ID isn't enough to talk on its behalf
+            U32 _token{ 0u };
+        };
+        // Connections by ID, so we know who a datagram is for. Only touched by the asio thread
+        hashMap<U32, UDPConnection> _udpConnections;
+        U16 _port{ 0u };
+
+        struct ReplicatedEntity
+        {
+            DeltaDecoder _decoder;
+            ByteBuffer _state;
+            U32 _owner{ 0u };
+            U32 _frameCount{ 0u };
+            /// When we got the latest state, in server time. Clients order and interpolate states by it
+            U64 _serverTimeUS{ 0u };
+        };
+
+        // Latest full state of every replicated entity, decoded from its owner's stream
+        hashMap<I64, ReplicatedEntity> _entities;
+        // Each client gets its own delta stream per entity, as it only gets the updates that are relevant to it.
+        // Deltas are encoded against states the client acknowledged (CMSG_ENTITY_UPDATE_ACK), with a full state every DeltaEncoder::KeyframeInterval updates,
+        // so a client that couldn't decode an update (or hasn't decoded anything yet) gets back in sync on its own
+        hashMap<U32, hashMap<I64, DeltaEncoder>> _clientStreams;
+        InterestManager _interestManager;
+        ByteBuffer _deltaScratch;
     };
 
 } //namespace Networking
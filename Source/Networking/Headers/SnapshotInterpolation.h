@@ -0,0 +1,163 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+
+#pragma once
+#ifndef DVD_NETWORKING_SNAPSHOT_INTERPOLATION_H_
+#define DVD_NETWORKING_SNAPSHOT_INTERPOLATION_H_
+
+#include "Core/Math/Headers/TransformInterface.h"
+
+namespace Divide
+{
+namespace Networking
+{
+    struct InterpolationSettings
+    {
+        /// Remote entities are rendered this far behind the (estimated) server time, so that we usually have a newer state to interpolate towards
+        U64 _delayUS{ 100'000u };
+        /// How far past the newest state we extrapolate before freezing the entity in place until new states arrive
+        U64 _maxExtrapolationUS{ 200'000u };
+        /// Locally owned entities blend in half of the remaining correction in this much time
+        U64 _correctionHalfLifeUS{ 50'000u };
+        /// Corrections bigger than this (in world units) are applied right away (teleports, respawns)
+        F32 _correctionSnapDistance{ 5.f };
+    };
+
+    /// Estimates the offset between the server's clock and ours from timestamped server messages.
+    /// Network (and server side queueing) delay only ever adds to the measured offset, so the smallest recent sample is the best estimate:
+    /// lower samples are adopted right away, while the estimate only goes up to the smallest sample of the last window, so that clock drift and route changes are eventually followed.
+    /// The remote clock we expose slews towards the estimate instead of jumping to it, so it never runs backwards unless it was very far off
+    class ClockSync
+    {
+    public:
+        /// The estimate can only go up once per window. Independent of how many samples we get
+        static constexpr U64 WindowUS = 2'000'000u;
+        /// The remote clock runs up to this much faster or slower than ours while catching up with the estimate
+        static constexpr F32 MaxSlewRate = 0.1f;
+        /// Jump straight to the estimate if we are further than this from it (server restart, long stall)
+        static constexpr U64 SnapThresholdUS = 500'000u;
+
+        /// A message the server stamped at remoteTimeUS arrived at localTimeUS
+        void addSample(U64 remoteTimeUS, U64 localTimeUS) noexcept;
+        /// Advances the remote clock to our current time. Call once per frame with non decreasing local times
+        void update(U64 localTimeUS) noexcept;
+        void reset() noexcept;
+
+        /// Server time as of the last update() call
+        [[nodiscard]] U64 remoteTimeUS() const noexcept { return _remoteTimeUS; }
+        /// Current estimate of (local time - server time)
+        [[nodiscard]] I64 offsetUS() const noexcept { return _targetOffsetUS; }
+        [[nodiscard]] bool synced() const noexcept { return _sampleCount > 0u; }
+
+    private:
+        I64 _targetOffsetUS{ 0 };
+        /// The offset the remote clock currently uses. Follows _targetOffsetUS at a limited rate
+        I64 _appliedOffsetUS{ 0 };
+        I64 _windowMinUS{ 0 };
+        U64 _windowStartUS{ 0u };
+        U64 _lastUpdateUS{ 0u };
+        U64 _remoteTimeUS{ 0u };
+        U32 _sampleCount{ 0u };
+        bool _appliedValid{ false };
+    };
+
+    /// Recent replicated transforms of a single entity, ordered by server time (not by arrival).
+    /// Sampling slightly in the past of the newest state means we usually interpolate between two real states, which hides network jitter
+    class SnapshotBuffer
+    {
+    public:
+        static constexpr size_t Capacity = 32u;
+
+        enum class SampleResult : U8
+        {
+            EMPTY = 0,
+            /// Render time is older than anything we have. Holding the oldest state
+            HELD,
+            INTERPOLATED,
+            /// Render time is past the newest state. Extrapolating from the last two
+            EXTRAPOLATED,
+            /// Starving: extrapolated as far as allowed (or we have a single state), holding there until new states arrive
+            CLAMPED,
+            COUNT
+        };
+
+        /// States can arrive in any order. Returns false if we already have a state for this time or if it is older than anything we remember
+        bool push(U64 serverTimeUS, const TransformValues& values);
+        [[nodiscard]] SampleResult sample(U64 renderTimeUS, const InterpolationSettings& settings, TransformValues& valuesOut) const;
+        void clear() noexcept;
+
+        [[nodiscard]] size_t size() const noexcept { return _count; }
+        [[nodiscard]] bool empty() const noexcept { return _count == 0u; }
+
+    private:
+        struct Snapshot
+        {
+            U64 _serverTimeUS{ 0u };
+            TransformValues _values;
+        };
+
+        /// 0 = oldest
+        [[nodiscard]] Snapshot& at(const size_t idx) noexcept { return _snapshots[(_first + idx) % Capacity]; }
+        [[nodiscard]] const Snapshot& at(const size_t idx) const noexcept { return _snapshots[(_first + idx) % Capacity]; }
+
+    private:
+        std::array<Snapshot, Capacity> _snapshots;
+        size_t _first{ 0u };
+        size_t _count{ 0u };
+    };
+
+    /// Hides corrections to locally predicted state. Instead of snapping to the corrected state, the difference is applied a bit at a time, decaying exponentially.
+    /// Whatever the local simulation does in the meantime is kept
+    class CorrectionBlender
+    {
+    public:
+        /// The server says we should be at 'corrected' while we are at 'predicted'. Replaces any error not blended in yet
+        void setCorrection(const TransformValues& predicted, const TransformValues& corrected);
+        /// Applies the part of the error that should be blended in over elapsedUS. Returns false if there was nothing to apply
+        bool apply(U64 elapsedUS, const InterpolationSettings& settings, TransformValues& valuesInOut);
+        void reset() noexcept;
+
+        [[nodiscard]] bool active() const noexcept { return _active; }
+        [[nodiscard]] F32 remainingDistance() const noexcept { return _positionError.length(); }
+
+    private:
+        float3 _positionError{ VECTOR3_ZERO };
+        float3 _scaleError{ VECTOR3_ZERO };
+        /// Rotation that takes the predicted orientation to the corrected one
+        quatf _orientationError{};
+        bool _active{ false };
+    };
+
+} //namespace Networking
+} //namespace Divide
+
+#endif //DVD_NETWORKING_SNAPSHOT_INTERPOLATION_H_
@@ -0,0 +1,75 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+
+#pragma once
+#ifndef DVD_NETWORKING_UDP_TRANSPORT_H_
+#define DVD_NETWORKING_UDP_TRANSPORT_H_
+
+#include "ReliableEndpoint.h"
+
+#include <boost/asio/ip/udp.hpp>
+
+namespace Divide
+{
+namespace Networking
+{
+    /// The UDP socket shared by every connection of a client or a server. Only used from the asio thread:
+    /// datagrams are sent synchronously (sending UDP doesn't wait on the remote side) and received asynchronously
+    class UDPTransport
+    {
+    public:
+        using ReceiveCallback = DELEGATE<void, const boost::asio::ip::udp::endpoint&, const Byte*, size_t>;
+
+        UDPTransport(boost::asio::io_context& asioContext, ReceiveCallback&& receiveCallback);
+
+        /// Binds the socket to the specified port (0 = any) and starts listening
+        [[nodiscard]] bool open(U16 port);
+        void close();
+        [[nodiscard]] bool isOpen() const;
+
+        void sendTo(const boost::asio::ip::udp::endpoint& remote, const Byte* data, size_t size);
+
+    private:
+        // ASYNC - Wait for the next datagram
+        void receive();
+
+    private:
+        boost::asio::ip::udp::socket _socket;
+        boost::asio::ip::udp::endpoint _sender;
+        std::array<Byte, ReliableEndpoint::MaxDatagramSize> _receiveBuffer{};
+        ReceiveCallback _receiveCallback;
+    };
+
+} //namespace Networking
+} //namespace Divide
+
+#endif //DVD_NETWORKING_UDP_TRANSPORT_H_
@@ -0,0 +1,203 @@
+
+
+#include "Headers/InterestManager.h"
+
+namespace Divide::Networking
+{
+    InterestManager::InterestManager(const Settings& settings)
+        : _settings(settings)
+    {
+    }
+
+    void InterestManager::setInterest(const ClientID client, const float3& position, const F32 radius)
+    {
+        Client& state = _clients[client];
+        state._position = position;
+        state._radius = radius;
+    }
+
+    void InterestManager::removeClient(const ClientID client)
+    {
+        _clients.erase(client);
+    }
+
+    void InterestManager::updateEntity(const EntityID entity, const ClientID owner, const float3* position)
+    {
+        Entity& state = _entities[entity];
+        state._owner = owner;
+
+        const bool isNew = state._version == 0u;
+        // 0 means "never sent" to clients
+        if (++state._version == 0u)
+        {
+            state._version = 1u;
+        }
+
+        if (position != nullptr)
+        {
+            state._position = *position;
+
+            const BoundingBox aabb{ *position, *position };
+            if (state._proxy == DynamicAABBTree<EntityID>::INVALID_PROXY)
+            {
+                state._proxy = _spatialIndex.createProxy(aabb, entity);
+                if (!isNew)
+                {
+                    _unpositioned.erase(eastl::remove(_unpositioned.begin(), _unpositioned.end(), entity), _unpositioned.end());
+                }
+            }
+            else
+            {
+                [[maybe_unused]] const bool moved = _spatialIndex.moveProxy(state._proxy, aabb);
+            }
+        }
+        else if (state._proxy != DynamicAABBTree<EntityID>::INVALID_PROXY)
+        {
+            _spatialIndex.destroyProxy(state._proxy);
+            state._proxy = DynamicAABBTree<EntityID>::INVALID_PROXY;
+            _unpositioned.push_back(entity);
+        }
+        else if (isNew)
+        {
+            _unpositioned.push_back(entity);
+        }
+    }
+
+    void InterestManager::removeEntity(const EntityID entity)
+    {
+        const auto it = _entities.find(entity);
+        if (it == std::end(_entities))
+        {
+            return;
+        }
+
+        if (it->second._proxy != DynamicAABBTree<EntityID>::INVALID_PROXY)
+        {
+            _spatialIndex.destroyProxy(it->second._proxy);
+        }
+        else
+        {
+            _unpositioned.erase(eastl::remove(_unpositioned.begin(), _unpositioned.end(), entity), _unpositioned.end());
+        }
+
+        _entities.erase(it);
+    }
+
+    void InterestManager::touch(Client& client, const ClientID clientID, const EntityID entityID, const Entity& entity, const F32 distanceFactor, const Callbacks& callbacks)
+    {
+        // Ticks start at 1, so anything that was never touched before is new to this client
+        Relevant& relevant = client._relevant[entityID];
+        if (relevant._seenTick == 0u)
+        {
+            relevant._priority = _settings._enterPriority;
+            callbacks._onEnter(clientID, entityID);
+        }
+        relevant._seenTick = client._tick;
+
+        if (relevant._sentVersion != entity._version)
+        {
+            // Closer entities get more important faster, but even the furthest ones get there eventually
+            relevant._priority += 1.f - 0.9f * CLAMPED_01(distanceFactor);
+        }
+    }
+
+    void InterestManager::updateClient(const ClientID clientID, const Callbacks& callbacks)
+    {
+        Client& client = _clients[clientID];
+        ++client._tick;
+
+        if (client._radius < 0.f)
+        {
+            for (const auto& [entityID, entity] : _entities)
+            {
+                if (entity._owner != clientID)
+                {
+                    touch(client, clientID, entityID, entity, 0.f, callbacks);
+                }
+            }
+        }
+        else
+        {
+            for (const EntityID entityID : _unpositioned)
+            {
+                const Entity& entity = _entities[entityID];
+                if (entity._owner != clientID)
+                {
+                    touch(client, clientID, entityID, entity, 0.f, callbacks);
+                }
+            }
+
+            const F32 leaveRadius = client._radius * _settings._leaveRadiusFactor;
+            const float3 extents{ leaveRadius, leaveRadius, leaveRadius };
+            _spatialIndex.query(BoundingBox{ client._position - extents, client._position + extents },
+                                [&](const U32 proxy)
+                                {
+                                    const EntityID entityID = _spatialIndex.userData(proxy);
+                                    const Entity& entity = _entities[entityID];
+                                    if (entity._owner != clientID)
+                                    {
+                                        // Entering takes getting within the radius. Leaving takes getting past the (larger) leave radius
+                                        const F32 distance = entity._position.distance(client._position);
+                                        if (distance <= client._radius ||
+                                            (distance <= leaveRadius && client._relevant.find(entityID) != std::end(client._relevant)))
+                                        {
+                                            touch(client, clientID, entityID, entity, leaveRadius > 0.f ? distance / leaveRadius : 0.f, callbacks);
+                                        }
+                                    }
+                                    return true;
+                                });
+        }
+
+        // Anything we didn't see this tick either moved away or was removed
+        _left.resize(0);
+        for (const auto& [entityID, relevant] : client._relevant)
+        {
+            if (relevant._seenTick != client._tick)
+            {
+                _left.push_back(entityID);
+            }
+        }
+        for (const EntityID entityID : _left)
+        {
+            client._relevant.erase(entityID);
+            callbacks._onLeave(clientID, entityID);
+        }
+
+        _candidates.resize(0);
+        for (auto& [entityID, relevant] : client._relevant)
+        {
+            const U32 version = _entities[entityID]._version;
+            if (relevant._sentVersion != version)
+            {
+                _candidates.push_back({ entityID, relevant._priority, version, &relevant });
+            }
+        }
+
+        eastl::sort(_candidates.begin(), _candidates.end(),
+                    [](const Candidate& lhs, const Candidate& rhs) noexcept
+                    {
+                        return lhs._priority > rhs._priority;
+                    });
+
+        // Whatever doesn't fit keeps its priority and has a better chance next tick
+        size_t bytesSent = 0u;
+        for (const Candidate& candidate : _candidates)
+        {
+            if (bytesSent >= _settings._bytesPerClientPerTick)
+            {
+                break;
+            }
+
+            bytesSent += callbacks._onSend(clientID, candidate._entity);
+            candidate._relevant->_priority = 0.f;
+            candidate._relevant->_sentVersion = candidate._version;
+        }
+    }
+
+    size_t InterestManager::relevantCount(const ClientID client) const
+    {
+        const auto it = _clients.find(client);
+        return it != std::cend(_clients) ? it->second._relevant.size() : 0u;
+    }
+
+} //namespace Divide::Networking
@@ -0,0 +1,72 @@
+
+
+#include "Headers/LossyLoopback.h"
+
+namespace Divide::Networking
+{
+    LossyLoopback::LossyLoopback(const Settings& settings)
+        : _settings(settings)
+        , _rng(settings._seed)
+    {
+    }
+
+    void LossyLoopback::send(const U8 source, const Byte* data, const size_t size, const U64 timeUS)
+    {
+        std::uniform_real_distribution<F32> chance(0.f, 1.f);
+
+        if (chance(_rng) < _settings._dropChance)
+        {
+            ++_droppedCount;
+            return;
+        }
+
+        U64 delayUS = _settings._latencyUS;
+        if (_settings._jitterUS > 0u)
+        {
+            delayUS += std::uniform_int_distribution<U64>(0u, _settings._jitterUS)(_rng);
+        }
+        if (chance(_rng) < _settings._reorderChance)
+        {
+            delayUS += _settings._reorderDelayUS;
+            ++_reorderedCount;
+        }
+
+        Datagram& datagram = _inFlight.emplace_back();
+        datagram._data.assign(data, data + size);
+        datagram._deliveryTimeUS = timeUS + delayUS;
+        datagram._order = _sendCount++;
+        datagram._destination = source == 0u ? 1u : 0u;
+    }
+
+    void LossyLoopback::deliver(const U64 timeUS, const DeliverCallback& callback)
+    {
+        // Move everything that arrived out of the way first, as the callback will most likely send something back
+        const auto arrived = [timeUS](const Datagram& datagram) noexcept
+        {
+            return datagram._deliveryTimeUS <= timeUS;
+        };
+
+        _arrived.clear();
+        for (Datagram& datagram : _inFlight)
+        {
+            if (arrived(datagram))
+            {
+                _arrived.push_back(MOV(datagram));
+            }
+        }
+        _inFlight.erase(eastl::remove_if(_inFlight.begin(), _inFlight.end(), arrived), _inFlight.end());
+
+        eastl::sort(_arrived.begin(),
+                    _arrived.end(),
+                    [](const Datagram& lhs, const Datagram& rhs)
+                    {
+                        return lhs._deliveryTimeUS != rhs._deliveryTimeUS ? lhs._deliveryTimeUS < rhs._deliveryTimeUS : lhs._order < rhs._order;
+                    });
+
+        for (const Datagram& datagram : _arrived)
+        {
+            callback(datagram._destination, datagram._data.data(), datagram._data.size());
+        }
+    }
+
+} //namespace Divide::Networking
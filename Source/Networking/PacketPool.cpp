@@ -0,0 +1,130 @@
+
+
+#include "Headers/PacketPool.h"
+
+namespace Divide::Networking
+{
+    PacketRef::PacketRef(Node* node) noexcept
+        : _node(node)
+    {
+        _node->_refCount.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    PacketRef::~PacketRef()
+    {
+        reset();
+    }
+
+    PacketRef::PacketRef(const PacketRef& other) noexcept
+        : _node(other._node)
+    {
+        if (_node != nullptr)
+        {
+            _node->_refCount.fetch_add(1u, std::memory_order_relaxed);
+        }
+    }
+
+    PacketRef::PacketRef(PacketRef&& other) noexcept
+        : _node(other._node)
+    {
+        other._node = nullptr;
+    }
+
+    PacketRef& PacketRef::operator=(const PacketRef& other) noexcept
+    {
+        if (_node != other._node)
+        {
+            reset();
+            _node = other._node;
+            if (_node != nullptr)
+            {
+                _node->_refCount.fetch_add(1u, std::memory_order_relaxed);
+            }
+        }
+
+        return *this;
+    }
+
+    PacketRef& PacketRef::operator=(PacketRef&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            _node = other._node;
+            other._node = nullptr;
+        }
+
+        return *this;
+    }
+
+    U32 PacketRef::useCount() const noexcept
+    {
+        return _node != nullptr ? _node->_refCount.load(std::memory_order_relaxed) : 0u;
+    }
+
+    void PacketRef::reset() noexcept
+    {
+        if (_node != nullptr)
+        {
+            // Whoever drops the last reference must see every write made through the other ones
+            if (_node->_refCount.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+            {
+                _node->_pool->release(_node);
+            }
+            _node = nullptr;
+        }
+    }
+
+    PacketPool::~PacketPool()
+    {
+        PacketRef::Node* node = nullptr;
+        while (_freeNodes.try_dequeue(node))
+        {
+            delete node;
+        }
+
+        DIVIDE_ASSERT(_pooledCount.load() == _allocatedCount.load(), "PacketPool::~PacketPool: packets still in use!");
+    }
+
+    PacketRef PacketPool::acquire(const OPCodes opCode)
+    {
+        PacketRef::Node* node = nullptr;
+        if (_freeNodes.try_dequeue(node))
+        {
+            _pooledCount.fetch_sub(1u, std::memory_order_relaxed);
+        }
+        else
+        {
+            node = new PacketRef::Node();
+            node->_pool = this;
+            _allocatedCount.fetch_add(1u, std::memory_order_relaxed);
+        }
+
+        node->_packet.reset(opCode);
+        return PacketRef(node);
+    }
+
+    PacketRef PacketPool::acquire(const NetworkPacket& source)
+    {
+        PacketRef ret = acquire(source.header()._opCode);
+        // Copy assignment reuses the storage we already have
+        *ret = source;
+        return ret;
+    }
+
+    void PacketPool::release(PacketRef::Node* node)
+    {
+        if (node->_packet.body().storageSize() > MaxPooledBodySize ||
+            _pooledCount.load(std::memory_order_relaxed) >= MaxPooledPackets)
+        {
+            delete node;
+            _allocatedCount.fetch_sub(1u, std::memory_order_relaxed);
+            return;
+        }
+
+        node->_packet.reset(OPCodes::MSG_NOP);
+        _pooledCount.fetch_add(1u, std::memory_order_relaxed);
+        _freeNodes.enqueue(node);
+    }
+
+} //namespace Divide::Networking
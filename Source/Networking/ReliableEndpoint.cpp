@@ -0,0 +1,547 @@
+
+
+#include "Headers/ReliableEndpoint.h"
+
+namespace Divide::Networking
+{
+    namespace
+    {
+        std::array<DeliveryMode, to_base(OPCodes::COUNT)> g_deliveryModes = []()
+        {
+            std::array<DeliveryMode, to_base(OPCodes::COUNT)> ret{};
+            ret.fill(DeliveryMode::TCP);
+
+            // Only the newest one matters
+            ret[to_base(OPCodes::CMSG_HEARTBEAT)] = DeliveryMode::UDP_SEQUENCED_UNRELIABLE;
+            ret[to_base(OPCodes::CMSG_PING)] = DeliveryMode::UDP_SEQUENCED_UNRELIABLE;
+            ret[to_base(OPCodes::SMSG_PONG)] = DeliveryMode::UDP_SEQUENCED_UNRELIABLE;
+            // Entity updates are delta compressed against states the receiver acknowledged, and stay in order with the enter/leave notifications around them.
+            // On their own channel they don't wait on anything else, and a lost datagram is resent after a round trip instead of stalling a TCP stream
+            ret[to_base(OPCodes::CMSG_ENTITY_UPDATE)] = DeliveryMode::UDP_RELIABLE_ORDERED;
+            ret[to_base(OPCodes::SMSG_ENTITY_UPDATE)] = DeliveryMode::UDP_RELIABLE_ORDERED;
+            // Enter resets the receiver's baselines, so it must not overtake (or fall behind) the updates around it
+            ret[to_base(OPCodes::SMSG_ENTITY_ENTER)] = DeliveryMode::UDP_RELIABLE_ORDERED;
+            ret[to_base(OPCodes::SMSG_ENTITY_LEAVE)] = DeliveryMode::UDP_RELIABLE_ORDERED;
+            ret[to_base(OPCodes::CMSG_INTEREST)] = DeliveryMode::UDP_RELIABLE_ORDERED;
+            // Only the newest ack matters, but it does have to arrive
+            ret[to_base(OPCodes::SMSG_ENTITY_ACK)] = DeliveryMode::UDP_RELIABLE_UNORDERED;
+            ret[to_base(OPCodes::CMSG_ENTITY_UPDATE_ACK)] = DeliveryMode::UDP_RELIABLE_UNORDERED;
+
+            return ret;
+        }();
+
+        template<typename T>
+        [[nodiscard]] FORCE_INLINE T ReadValue(const Byte* src) noexcept
+        {
+            T ret;
+            memcpy(&ret, src, sizeof(T));
+            return ret;
+        }
+
+        /// Sequence numbers wrap around. 'lhs' is newer than 'rhs' if it is ahead by less than half the range
+        [[nodiscard]] FORCE_INLINE bool SequenceGreaterThan(const U16 lhs, const U16 rhs) noexcept
+        {
+            return lhs != rhs && to_U16(lhs - rhs) < 0x8000u;
+        }
+
+        [[nodiscard]] FORCE_INLINE bool IsReliable(const DeliveryMode mode) noexcept
+        {
+            return mode == DeliveryMode::UDP_RELIABLE_ORDERED || mode == DeliveryMode::UDP_RELIABLE_UNORDERED;
+        }
+
+        [[nodiscard]] FORCE_INLINE U64 FragmentKey(const DeliveryMode mode, const U16 messageID, const U16 fragmentIndex) noexcept
+        {
+            return (to_U64(to_base(mode)) << 32u) | (to_U64(messageID) << 16u) | fragmentIndex;
+        }
+
+        [[nodiscard]] FORCE_INLINE U32 MessageKey(const DeliveryMode mode, const U16 messageID) noexcept
+        {
+            return (to_U32(to_base(mode)) << 16u) | messageID;
+        }
+    } //namespace
+
+    DeliveryMode GetDeliveryMode(const OPCodes opCode) noexcept
+    {
+        return g_deliveryModes[to_base(opCode)];
+    }
+
+    void SetDeliveryMode(const OPCodes opCode, const DeliveryMode mode) noexcept
+    {
+        g_deliveryModes[to_base(opCode)] = mode;
+    }
+
+    ReliableEndpoint::ReliableEndpoint(const U32 connectionID, const U32 token, PacketPool& packetPool, SendCallback&& sendCallback, ReceiveCallback&& receiveCallback)
+        : _connectionID(connectionID)
+        , _token(token)
+        , _packetPool(packetPool)
+        , _sendCallback(MOV(sendCallback))
+        , _receiveCallback(MOV(receiveCallback))
+    {
+    }
+
+    bool ReliableEndpoint::PeekConnectionID(const Byte* data, const size_t size, U32& idOut, U32& tokenOut) noexcept
+    {
+        if (size < DatagramHeaderSize)
+        {
+            return false;
+        }
+
+        idOut = ReadValue<U32>(data);
+        tokenOut = ReadValue<U32>(data + sizeof(U32));
+        return true;
+    }
+
+    bool ReliableEndpoint::accepts(const Byte* data, const size_t size) const noexcept
+    {
+        U32 connectionID = 0u, token = 0u;
+        return PeekConnectionID(data, size, connectionID, token) && connectionID == _connectionID && token == _token;
+    }
+
+    void ReliableEndpoint::send(const NetworkPacket& packet, const DeliveryMode mode, const U64 timeUS)
+    {
+        DIVIDE_ASSERT(mode != DeliveryMode::TCP && mode != DeliveryMode::COUNT, "ReliableEndpoint::send: invalid delivery mode!");
+
+        Channel& channel = _channels[to_base(mode) - 1u];
+        if (IsReliable(mode) && (!channel._queued.empty() || to_U16(channel._nextSendID - channel._oldestUnackedID) >= ReceiveWindowSize))
+        {
+            // The remote side would drop it. update() sends it once enough of what's in flight got acknowledged
+            const ByteBuffer& body = packet.body();
+            PacketRef queued = _packetPool.acquire(packet.header()._opCode);
+            queued->append(body.contents() + body.rpos(), body.bufferSize());
+            channel._queued.push_back(MOV(queued));
+            return;
+        }
+
+        sendFragments(packet, mode, timeUS);
+    }
+
+    size_t ReliableEndpoint::queuedMessageCount() const noexcept
+    {
+        size_t ret = 0u;
+        for (const Channel& channel : _channels)
+        {
+            ret += channel._queued.size();
+        }
+        return ret;
+    }
+
+    void ReliableEndpoint::sendFragments(const NetworkPacket& packet, const DeliveryMode mode, const U64 timeUS)
+    {
+        const ByteBuffer& body = packet.body();
+        const Byte* data = body.contents() + body.rpos();
+        const size_t size = body.bufferSize();
+        const size_t fragmentCount = std::max(size_t{ 1u }, (size + MaxFragmentSize - 1u) / MaxFragmentSize);
+        DIVIDE_ASSERT(size <= MaxMessageSize, "ReliableEndpoint::sendFragments: message too large!");
+
+        Channel& channel = _channels[to_base(mode) - 1u];
+        const U16 messageID = channel._nextSendID++;
+
+        for (size_t i = 0u; i < fragmentCount; ++i)
+        {
+            const size_t offset = i * MaxFragmentSize;
+            const size_t fragmentSize = std::min(MaxFragmentSize, size - offset);
+
+            _blockScratch.clear();
+            _blockScratch << to_base(mode);
+            _blockScratch << messageID;
+            _blockScratch << to_base(packet.header()._opCode);
+            _blockScratch << to_U16(i);
+            _blockScratch << to_U16(fragmentCount);
+            _blockScratch.append(data + offset, fragmentSize);
+
+            const Byte* block = _blockScratch.contents();
+            const size_t blockSize = _blockScratch.bufferSize();
+
+            U64 fragmentKey = InvalidFragmentKey;
+            if (IsReliable(mode))
+            {
+                fragmentKey = FragmentKey(mode, messageID, to_U16(i));
+
+                PendingFragment& pending = _pendingFragments[fragmentKey];
+                pending._block.assign(block, block + blockSize);
+                pending._lastSendUS = timeUS;
+            }
+
+            sendDatagram(block, blockSize, fragmentKey, timeUS);
+        }
+    }
+
+    void ReliableEndpoint::update(const U64 timeUS)
+    {
+        for (Channel& channel : _channels)
+        {
+            channel._oldestUnackedID = channel._nextSendID;
+        }
+
+        for (auto& [key, fragment] : _pendingFragments)
+        {
+            Channel& channel = _channels[(key >> 32u) - 1u];
+            const U16 messageID = to_U16((key >> 16u) & 0xFFFFu);
+            if (SequenceGreaterThan(channel._oldestUnackedID, messageID))
+            {
+                channel._oldestUnackedID = messageID;
+            }
+
+            // Back off exponentially if the remote side doesn't answer
+            const U64 timeoutUS = std::min(_resendTimeoutUS << std::min(fragment._resendCount, to_U8(5u)), MaxResendTimeoutUS);
+            if (timeUS - fragment._lastSendUS >= timeoutUS)
+            {
+                fragment._lastSendUS = timeUS;
+                ++fragment._resendCount;
+                ++_stats._fragmentsResent;
+                sendDatagram(fragment._block.data(), fragment._block.size(), key, timeUS);
+            }
+        }
+
+        for (U8 i = 0u; i < to_U8(_channels.size()); ++i)
+        {
+            Channel& channel = _channels[i];
+            const DeliveryMode mode = static_cast<DeliveryMode>(i + 1u);
+            while (!channel._queued.empty() && to_U16(channel._nextSendID - channel._oldestUnackedID) < ReceiveWindowSize)
+            {
+                const PacketRef packet = MOV(channel._queued.front());
+                channel._queued.pop_front();
+                sendFragments(*packet, mode, timeUS);
+            }
+        }
+
+        // Also say hello right away, so the other side learns our address and can start answering
+        if (_ackPending || _stats._datagramsSent == 0u || timeUS - _lastSendUS >= KeepAliveIntervalUS)
+        {
+            sendDatagram(nullptr, 0u, InvalidFragmentKey, timeUS);
+        }
+    }
+
+    void ReliableEndpoint::sendDatagram(const Byte* block, const size_t blockSize, const U64 fragmentKey, const U64 timeUS)
+    {
+        const U16 sequence = _nextSequence++;
+
+        // Acks and keep alives are only acknowledged whenever the remote side happens to send something, which would throw off our RTT estimate
+        SentDatagram& sent = _sentDatagrams[sequence % SentHistorySize];
+        sent._sequence = sequence;
+        sent._timeUS = timeUS;
+        sent._fragmentKey = fragmentKey;
+        sent._valid = blockSize > 0u;
+
+        _datagramScratch.clear();
+        _datagramScratch << _connectionID;
+        _datagramScratch << _token;
+        _datagramScratch << sequence;
+        _datagramScratch << _remoteSequence;
+        _datagramScratch << _remoteAckBits;
+        _datagramScratch.append(block, blockSize);
+
+        // Every datagram carries our acks
+        _ackPending = false;
+        _unackedDatagrams = 0u;
+        _lastSendUS = timeUS;
+        ++_stats._datagramsSent;
+
+        _sendCallback(_datagramScratch.contents(), _datagramScratch.bufferSize());
+    }
+
+    void ReliableEndpoint::onDatagram(const Byte* data, const size_t size, const U64 timeUS)
+    {
+        if (!accepts(data, size))
+        {
+            ++_stats._messagesDropped;
+            return;
+        }
+
+        ++_stats._datagramsReceived;
+
+        const U16 sequence = ReadValue<U16>(data + sizeof(U32) * 2u);
+        const U16 ack = ReadValue<U16>(data + sizeof(U32) * 2u + sizeof(U16));
+        const U32 ackBits = ReadValue<U32>(data + sizeof(U32) * 2u + sizeof(U16) * 2u);
+
+        processAcks(ack, ackBits, timeUS);
+
+        if (size == DatagramHeaderSize)
+        {
+            // Ack or keep alive. Nothing to acknowledge in return
+            (void)trackReceived(sequence);
+            return;
+        }
+
+        if (size < DatagramHeaderSize + FragmentHeaderSize)
+        {
+            ++_stats._messagesDropped;
+            return;
+        }
+
+        const Byte* block = data + DatagramHeaderSize;
+        const U8 mode = to_U8(block[0]);
+        const U16 messageID = ReadValue<U16>(block + sizeof(U8));
+        const U16 opCode = ReadValue<U16>(block + sizeof(U8) + sizeof(U16));
+        const U16 fragmentIndex = ReadValue<U16>(block + sizeof(U8) + sizeof(U16) * 2u);
+        const U16 fragmentCount = ReadValue<U16>(block + sizeof(U8) + sizeof(U16) * 3u);
+        const size_t payloadSize = size - DatagramHeaderSize - FragmentHeaderSize;
+
+        // Every fragment but the last one is full sized
+        if (mode == to_base(DeliveryMode::TCP) || mode >= to_base(DeliveryMode::COUNT) ||
+            opCode >= to_base(OPCodes::COUNT) ||
+            fragmentIndex >= fragmentCount ||
+            fragmentCount > MaxFragmentCount ||
+            payloadSize > MaxFragmentSize ||
+            (fragmentIndex + 1u < fragmentCount && payloadSize != MaxFragmentSize))
+        {
+            ++_stats._messagesDropped;
+            return;
+        }
+
+        // Not tracking the datagram means we don't ack it either, so it looks lost to the sender
+        if (!canAccept(static_cast<DeliveryMode>(mode), messageID, fragmentCount))
+        {
+            ++_stats._messagesDropped;
+            return;
+        }
+
+        const bool newDatagram = trackReceived(sequence);
+        _ackPending = true;
+        if (++_unackedDatagrams >= MaxUnackedDatagrams)
+        {
+            sendDatagram(nullptr, 0u, InvalidFragmentKey, timeUS);
+        }
+
+        if (!newDatagram)
+        {
+            ++_stats._messagesDropped;
+            return;
+        }
+
+        onFragment(static_cast<DeliveryMode>(mode), messageID, static_cast<OPCodes>(opCode), fragmentIndex, fragmentCount, block + FragmentHeaderSize, payloadSize);
+    }
+
+    void ReliableEndpoint::processAcks(const U16 ack, const U32 ackBits, const U64 timeUS)
+    {
+        onAcked(ack, timeUS);
+        for (U16 i = 0u; i < 32u; ++i)
+        {
+            if (ackBits & (1u << i))
+            {
+                onAcked(to_U16(ack - 1u - i), timeUS);
+            }
+        }
+    }
+
+    void ReliableEndpoint::onAcked(const U16 sequence, const U64 timeUS)
+    {
+        SentDatagram& sent = _sentDatagrams[sequence % SentHistorySize];
+        if (!sent._valid || sent._sequence != sequence)
+        {
+            return;
+        }
+        sent._valid = false;
+
+        // RFC 6298. Resent fragments go out with a new sequence, so every sample is unambiguous
+        const U64 sampleUS = timeUS - sent._timeUS;
+        if (_smoothedRTTUS == 0u)
+        {
+            _smoothedRTTUS = std::max(sampleUS, U64{ 1u });
+            _rttVarianceUS = sampleUS / 2u;
+        }
+        else
+        {
+            const U64 deviationUS = _smoothedRTTUS > sampleUS ? _smoothedRTTUS - sampleUS : sampleUS - _smoothedRTTUS;
+            _rttVarianceUS = (_rttVarianceUS * 3u + deviationUS) / 4u;
+            _smoothedRTTUS = std::max((_smoothedRTTUS * 7u + sampleUS) / 8u, U64{ 1u });
+        }
+        _resendTimeoutUS = CLAMPED(_smoothedRTTUS + 4u * _rttVarianceUS, MinResendTimeoutUS, MaxResendTimeoutUS);
+
+        if (sent._fragmentKey != InvalidFragmentKey)
+        {
+            _pendingFragments.erase(sent._fragmentKey);
+        }
+    }
+
+    bool ReliableEndpoint::trackReceived(const U16 sequence) noexcept
+    {
+        if (!_remoteSequenceValid)
+        {
+            _remoteSequenceValid = true;
+            _remoteSequence = sequence;
+            _remoteAckBits = 0u;
+            return true;
+        }
+
+        if (SequenceGreaterThan(sequence, _remoteSequence))
+        {
+            // Bit i stands for (_remoteSequence - 1 - i), so everything moves up and the previous newest sequence becomes one of the bits
+            const U16 shift = to_U16(sequence - _remoteSequence);
+            _remoteAckBits = shift < 32u ? _remoteAckBits << shift : 0u;
+            if (shift <= 32u)
+            {
+                _remoteAckBits |= 1u << (shift - 1u);
+            }
+            _remoteSequence = sequence;
+            return true;
+        }
+
+        const U16 age = to_U16(_remoteSequence - sequence);
+        if (age == 0u)
+        {
+            return false;
+        }
+
+        if (age <= 32u)
+        {
+            const U32 bit = 1u << (age - 1u);
+            if (_remoteAckBits & bit)
+            {
+                return false;
+            }
+            _remoteAckBits |= bit;
+        }
+
+        // Too old to tell. Message level checks will catch duplicates
+        return true;
+    }
+
+    bool ReliableEndpoint::alreadyDelivered(const DeliveryMode mode, const U16 messageID) const
+    {
+        const Channel& channel = _channels[to_base(mode) - 1u];
+        switch (mode)
+        {
+            case DeliveryMode::UDP_RELIABLE_ORDERED:
+                return SequenceGreaterThan(channel._nextReceiveID, messageID) || _orderedBuffer.find(messageID) != _orderedBuffer.cend();
+            case DeliveryMode::UDP_RELIABLE_UNORDERED:
+                return SequenceGreaterThan(channel._nextReceiveID, messageID) || _unorderedReceived[messageID];
+            case DeliveryMode::UDP_SEQUENCED_UNRELIABLE:
+                return channel._delivered && !SequenceGreaterThan(messageID, channel._lastDeliveredID);
+            default: break;
+        }
+
+        return true;
+    }
+
+    bool ReliableEndpoint::canAccept(const DeliveryMode mode, const U16 messageID, const U16 fragmentCount) const
+    {
+        if (IsReliable(mode))
+        {
+            const Channel& channel = _channels[to_base(mode) - 1u];
+            // Anything older than _nextReceiveID is a duplicate. Those we do ack, or the sender never stops resending them
+            if (SequenceGreaterThan(messageID, channel._nextReceiveID) && to_U16(messageID - channel._nextReceiveID) >= ReceiveWindowSize)
+            {
+                return false;
+            }
+        }
+
+        return fragmentCount == 1u ||
+               _reassemblies.size() < MaxReassemblyCount ||
+               _reassemblies.find(MessageKey(mode, messageID)) != _reassemblies.cend();
+    }
+
+    void ReliableEndpoint::onFragment(const DeliveryMode mode, const U16 messageID, const OPCodes opCode, const U16 fragmentIndex, const U16 fragmentCount, const Byte* payload, const size_t payloadSize)
+    {
+        if (alreadyDelivered(mode, messageID))
+        {
+            ++_stats._messagesDropped;
+            return;
+        }
+
+        if (fragmentCount == 1u)
+        {
+            onMessage(mode, messageID, opCode, payload, payloadSize);
+            return;
+        }
+
+        const U32 key = MessageKey(mode, messageID);
+        auto it = _reassemblies.find(key);
+        if (it == _reassemblies.end())
+        {
+            // canAccept() made sure we have room and MaxFragmentCount bounds the allocation
+            it = _reassemblies.emplace(key, Reassembly{}).first;
+            Reassembly& reassembly = it->second;
+            reassembly._data.resize(to_size(fragmentCount) * MaxFragmentSize);
+            reassembly._received.resize(fragmentCount, false);
+            reassembly._opCode = opCode;
+        }
+
+        Reassembly& reassembly = it->second;
+        if (reassembly._received.size() != fragmentCount || reassembly._received[fragmentIndex])
+        {
+            return;
+        }
+
+        reassembly._received[fragmentIndex] = true;
+        memcpy(reassembly._data.data() + to_size(fragmentIndex) * MaxFragmentSize, payload, payloadSize);
+        reassembly._size += payloadSize;
+
+        if (++reassembly._receivedCount == fragmentCount)
+        {
+            const Reassembly complete = MOV(reassembly);
+            _reassemblies.erase(it);
+            onMessage(mode, messageID, complete._opCode, complete._data.data(), complete._size);
+        }
+    }
+
+    void ReliableEndpoint::onMessage(const DeliveryMode mode, const U16 messageID, const OPCodes opCode, const Byte* data, const size_t size)
+    {
+        PacketRef packet = _packetPool.acquire(opCode);
+        packet->append(data, size);
+
+        Channel& channel = _channels[to_base(mode) - 1u];
+        switch (mode)
+        {
+            case DeliveryMode::UDP_SEQUENCED_UNRELIABLE:
+            {
+                channel._lastDeliveredID = messageID;
+                channel._delivered = true;
+
+                // Whatever is still being reassembled is out of date now
+                for (auto it = _reassemblies.begin(); it != _reassemblies.end();)
+                {
+                    if (it->first >> 16u == to_base(mode) && !SequenceGreaterThan(to_U16(it->first & 0xFFFFu), messageID))
+                    {
+                        it = _reassemblies.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+
+                deliver(MOV(packet));
+            } break;
+            case DeliveryMode::UDP_RELIABLE_UNORDERED:
+            {
+                _unorderedReceived[messageID] = true;
+                while (_unorderedReceived[channel._nextReceiveID])
+                {
+                    _unorderedReceived[channel._nextReceiveID] = false;
+                    ++channel._nextReceiveID;
+                }
+
+                deliver(MOV(packet));
+            } break;
+            case DeliveryMode::UDP_RELIABLE_ORDERED:
+            {
+                if (messageID != channel._nextReceiveID)
+                {
+                    _orderedBuffer.emplace(messageID, MOV(packet));
+                    break;
+                }
+
+                deliver(MOV(packet));
+                ++channel._nextReceiveID;
+
+                // Anything waiting on this message can go out now
+                for (auto it = _orderedBuffer.find(channel._nextReceiveID); it != _orderedBuffer.end(); it = _orderedBuffer.find(channel._nextReceiveID))
+                {
+                    PacketRef next = MOV(it->second);
+                    _orderedBuffer.erase(it);
+                    deliver(MOV(next));
+                    ++channel._nextReceiveID;
+                }
+            } break;
+            default: break;
+        }
+    }
+
+    void ReliableEndpoint::deliver(PacketRef packet)
+    {
+        ++_stats._messagesDelivered;
+        _receiveCallback(MOV(packet));
+    }
+
+} //namespace Divide::Networking
@@ -3,12 +3,21 @@
 #include "Utility/Headers/Localization.h"
 #include "Platform/File/Headers/FileManagement.h"
 #include "Core/Time/Headers/ApplicationTimer.h"
+#include "Core/Math/Headers/TransformInterface.h"
 
 namespace Divide::Networking
 {
     // Create a server, ready to listen on specified port
     Server::Server(const U16 port)
         : _asioAcceptor(_asioContext, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port))
+        , _udpTransport(_asioContext,
+                        [this](const boost::asio::ip::udp::endpoint& remote, const Byte* data, const size_t size)
+                        {
+                            onDatagram(remote, data, size);
+                        })
+        , _udpTimer(_asioContext)
+        , _port(port)
+        , _interestManager(InterestManager::Settings{})
     {
     }
 
@@ -30,6 +39,17 @@ namespace Divide::Networking
             // connect.
             waitForClientConnection();
 
+            // Clients that can't reach this port just keep using TCP for everything
+            if (_udpTransport.open(_port))
+            {
+                Console::printfn(LOCALE_STR("SERVER_UDP_STARTED"), _port);
+                boost::asio::post(_asioContext, [this]() { updateUDP(); });
+            }
+            else
+            {
+                Console::errorfn(LOCALE_STR("SERVER_UDP_FAILED"), _port);
+            }
+
             // Launch the asio context in its own thread
             _threadContext = std::thread
             (
@@ -64,6 +84,15 @@ namespace Divide::Networking
             _threadContext.join();
         }
 
+        // Unprocessed messages keep their connections (and sockets) alive. Drop them while the context those sockets belong to is still around
+        {
+            OwnedNetworkPacket msg{};
+            while (_messagesIn.try_dequeue(msg))
+            {
+            }
+        }
+        _udpConnections.clear();
+
         Console::printfn(LOCALE_STR("SERVER_STOPPED"));
     }
 
@@ -85,7 +114,7 @@ namespace Divide::Networking
                     os << socket.remote_endpoint();
                     Console::printfn(LOCALE_STR("SERVER_NEW_INCOMING_CONNECTION"), os.str());
                     // Create a new connection to handle this client 
-                    Connection_ptr newconn = std::make_shared<Connection>(Connection::Owner::SERVER, _asioContext, MOV(socket), _messagesIn);
+                    Connection_ptr newconn = std::make_shared<Connection>(Connection::Owner::SERVER, _asioContext, MOV(socket), _messagesIn, _packetPool);
 
                     // Give the user server a chance to deny connection
                     if (onClientConnect(newconn))
@@ -95,9 +124,19 @@ namespace Divide::Networking
 
                         // And very important! Issue a task to the connection's
                         // asio context to sit and wait for bytes to arrive!
-                        _deqConnections.back()->connectToClient(_IDCounter++);
-
-                        Console::printfn(LOCALE_STR("SERVER_NEW_CONNECTION_ACCEPTED"), _deqConnections.back()->id());
+                        const Connection_ptr& connection = _deqConnections.back();
+                        connection->connectToClient(_IDCounter++);
+                        UDPConnection& udpConnection = _udpConnections[connection->id()];
+                        udpConnection._connection = connection;
+                        udpConnection._token = Random(1u, U32_MAX);
+
+                        // The client tags its datagrams with this ID so we can tell it apart from everyone else on the UDP socket. Only the client (over TCP) gets to see the token
+                        NetworkPacket idMsg{ OPCodes::SMSG_CONNECTION_ID };
+                        idMsg << connection->id();
+                        idMsg << udpConnection._token;
+                        connection->send(idMsg);
+
+                        Console::printfn(LOCALE_STR("SERVER_NEW_CONNECTION_ACCEPTED"), connection->id());
                     }
                     else
                     {
@@ -118,6 +157,63 @@ namespace Divide::Networking
             });
     }
 
+    void Server::onDatagram(const boost::asio::ip::udp::endpoint& remote, const Byte* data, const size_t size)
+    {
+        U32 connectionID = 0u, token = 0u;
+        if (!ReliableEndpoint::PeekConnectionID(data, size, connectionID, token))
+        {
+            return;
+        }
+
+        const auto it = _udpConnections.find(connectionID);
+        if (it == std::end(_udpConnections) || it->second._token != token)
+        {
+            return;
+        }
+
+        const Connection_ptr connection = it->second._connection.lock();
+        if (connection == nullptr || !connection->isConnected())
+        {
+            _udpConnections.erase(it);
+            return;
+        }
+
+        // The first datagram from a client tells us where to reach it
+        if (!connection->udpEnabled())
+        {
+            connection->enableUDP(_udpTransport, remote, connectionID, token);
+        }
+        connection->onDatagram(remote, data, size);
+    }
+
+    void Server::updateUDP()
+    {
+        for (auto it = std::begin(_udpConnections); it != std::end(_udpConnections);)
+        {
+            const Connection_ptr connection = it->second._connection.lock();
+            if (connection == nullptr)
+            {
+                it = _udpConnections.erase(it);
+                continue;
+            }
+
+            connection->updateUDP();
+            ++it;
+        }
+
+        _udpTimer.expires_from_now(boost::posix_time::milliseconds(UDPUpdateIntervalMS));
+        _udpTimer.async_wait
+        (
+            [this](const boost::system::error_code ec)
+            {
+                if (!ec)
+                {
+                    updateUDP();
+                }
+            }
+        );
+    }
+
     // Send a message to a specific client
     void Server::messageClient(Connection_ptr client, const NetworkPacket& msg)
     {
@@ -134,6 +230,8 @@ namespace Divide::Networking
             // be tracking it somehow
             onClientDisconnect(client);
 
+            forgetClient(client);
+
             // Off you go now, bye bye!
             client.reset();
 
@@ -147,6 +245,9 @@ namespace Divide::Networking
     {
         bool invalidClientExists = false;
 
+        // Copy the message once and queue the same packet on every connection
+        const PacketRef packet = _packetPool.acquire(msg);
+
         // Iterate through all clients in container
         for (auto& client : _deqConnections)
         {
@@ -156,7 +257,7 @@ namespace Divide::Networking
                 // ..it is!
                 if (client != ignoreClient)
                 {
-                    client->send(msg);
+                    client->send(packet);
                 }
             }
             else
@@ -164,6 +265,7 @@ namespace Divide::Networking
                 // The client couldnt be contacted, so assume it has
                 // disconnected.
                 onClientDisconnect(client);
+                forgetClient(client);
                 client.reset();
 
                 // Set this flag to then remove dead clients from container
@@ -182,26 +284,157 @@ namespace Divide::Networking
     // Force server to respond to incoming messages
     void Server::update(const size_t nMaxMessages, const bool bWait)
     {
-        if (bWait)
+        OwnedNetworkPacket msg{};
+
+        size_t nMessageCount = 0;
+        if (bWait && nMaxMessages > 0u)
         {
-            _messagesIn.wait();
+            _messagesIn.wait_dequeue(msg);
+            receiveMessage(msg._remote, *msg._msg);
+            nMessageCount++;
         }
 
         // Process as many messages as you can up to the value
         // specified
-        size_t nMessageCount = 0;
-        while (nMessageCount < nMaxMessages && !_messagesIn.empty())
+        while (nMessageCount < nMaxMessages && _messagesIn.try_dequeue(msg))
         {
-            // Grab the front message
-            auto msg = _messagesIn.pop_front();
-
             // Pass to message handler
-            receiveMessage(msg._remote, msg._msg);
+            receiveMessage(msg._remote, *msg._msg);
 
             nMessageCount++;
         }
     }
 
+    void Server::replicate()
+    {
+        bool invalidClientExists = false;
+
+        for (auto& client : _deqConnections)
+        {
+            if (client && client->isConnected())
+            {
+                InterestManager::Callbacks callbacks{};
+                callbacks._onEnter = [this, &client](const U32 clientID, const I64 guid)
+                {
+                    // Start a new stream. The first update after this one is a full state
+                    _clientStreams[clientID][guid].reset();
+
+                    NetworkPacket msgOut{ OPCodes::SMSG_ENTITY_ENTER };
+                    msgOut << guid;
+                    client->send(msgOut);
+                };
+                callbacks._onLeave = [this, &client](const U32 clientID, const I64 guid)
+                {
+                    _clientStreams[clientID].erase(guid);
+
+                    NetworkPacket msgOut{ OPCodes::SMSG_ENTITY_LEAVE };
+                    msgOut << guid;
+                    client->send(msgOut);
+                };
+                callbacks._onSend = [this, &client](const U32 clientID, const I64 guid)
+                {
+                    const ReplicatedEntity& entity = _entities[guid];
+
+                    NetworkPacket msgOut{ OPCodes::SMSG_ENTITY_UPDATE };
+                    msgOut << entity._owner;
+                    msgOut << guid;
+                    msgOut << entity._frameCount;
+                    msgOut << entity._serverTimeUS;
+
+                    _deltaScratch.clear();
+                    _clientStreams[clientID][guid].encode(entity._state, _deltaScratch);
+                    msgOut.append(_deltaScratch.contents(), _deltaScratch.bufferSize());
+
+                    client->send(msgOut);
+                    return msgOut.body().bufferSize();
+                };
+
+                _interestManager.updateClient(client->id(), callbacks);
+            }
+            else
+            {
+                onClientDisconnect(client);
+                forgetClient(client);
+                client.reset();
+
+                invalidClientExists = true;
+            }
+        }
+
+        if (invalidClientExists)
+        {
+            _deqConnections.erase(std::remove(_deqConnections.begin(), _deqConnections.end(), nullptr), _deqConnections.end());
+        }
+    }
+
+    void Server::onEntityUpdate(const Connection_ptr& client, const I64 guid, const U32 frameCount, const NetworkPacket& msg)
+    {
+        ReplicatedEntity& entity = _entities[guid];
+
+        // The first client to send updates for an entity owns it until it disconnects. Everyone else's copy is ignored
+        if (entity._owner == 0u)
+        {
+            entity._owner = client->id();
+        }
+        else if (entity._owner != client->id())
+        {
+            return;
+        }
+
+        const ByteBuffer& body = msg.body();
+        U32 sequence = DeltaEncoder::INVALID_SEQUENCE;
+        if (!entity._decoder.decode(body.contents() + body.rpos(), body.bufferSize(), entity._state, sequence))
+        {
+            return;
+        }
+        entity._frameCount = frameCount;
+        entity._serverTimeUS = to_U64(Time::App::ElapsedMicroseconds());
+
+        // States start with the (optional) transform. See NetworkingComponent::writeState
+        bool hasTransform = false;
+        TransformValues transform{};
+        entity._state >> hasTransform;
+        if (hasTransform)
+        {
+            ReadTransform(entity._state, transform);
+        }
+        [[maybe_unused]] const size_t readPos = entity._state.rpos(0u);
+
+        _interestManager.updateEntity(guid, entity._owner, hasTransform ? &transform._translation : nullptr);
+
+        // We have the state now, so the owner can use it as a baseline. Clients get their own streams, encoded against what we sent them
+        NetworkPacket ackOut{ OPCodes::SMSG_ENTITY_ACK };
+        ackOut << guid;
+        ackOut << sequence;
+        client->send(ackOut);
+    }
+
+    void Server::forgetClient(const Connection_ptr& client)
+    {
+        if (client == nullptr)
+        {
+            return;
+        }
+
+        const U32 clientID = client->id();
+        _interestManager.removeClient(clientID);
+        _clientStreams.erase(clientID);
+
+        // Entities owned by the client go away with it. Everyone else gets a leave notification on the next tick
+        for (auto it = std::begin(_entities); it != std::end(_entities);)
+        {
+            if (it->second._owner == clientID)
+            {
+                _interestManager.removeEntity(it->first);
+                it = _entities.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
     bool Server::onClientConnect(Connection_ptr client)
     {
         NetworkPacket msg{ OPCodes::SMSG_ACCEPT };
@@ -252,11 +485,37 @@ namespace Divide::Networking
 
                 Console::printfn(LOCALE_STR("SERVER_ON_RECEIVE_ENTITY_UPDATE"), client->id(), guid);
 
-                NetworkPacket msgOut{ OPCodes::SMSG_ENTITY_UPDATE };
-                msgOut << client->id();
-                msgOut << guid;
-                msgOut << frameCount;
-                messageAllClients(msgOut, client);
+                // Nothing is relayed right away. replicate() sends it to whoever is interested
+                onEntityUpdate(client, guid, frameCount, msg);
+            } break;
+            case OPCodes::CMSG_ENTITY_UPDATE_ACK:
+            {
+                I64 guid{ -1 };
+                U32 sequence{ 0u };
+                msg >> guid;
+                msg >> sequence;
+
+                // Acks for entities that left in the meantime are of no use
+                const auto streams = _clientStreams.find(client->id());
+                if (streams != std::end(_clientStreams))
+                {
+                    const auto stream = streams->second.find(guid);
+                    if (stream != std::end(streams->second))
+                    {
+                        stream->second.onAck(sequence);
+                    }
+                }
+            } break;
+            case OPCodes::CMSG_INTEREST:
+            {
+                float3 position{};
+                F32 radius{-1.f};
+                msg >> position.x;
+                msg >> position.y;
+                msg >> position.z;
+                msg >> radius;
+
+                _interestManager.setInterest(client->id(), position, radius);
             } break;
             case OPCodes::MSG_NOP:
             {
@@ -0,0 +1,219 @@
+#include "Headers/SnapshotInterpolation.h"
+
+namespace Divide::Networking
+{
+    namespace
+    {
+        /// Corrections smaller than this are applied in one go, so the blender doesn't touch the transform forever
+        constexpr F32 MinCorrection = 1e-4f;
+    }
+
+    void ClockSync::addSample(const U64 remoteTimeUS, const U64 localTimeUS) noexcept
+    {
+        const I64 sampleUS = to_I64(localTimeUS) - to_I64(remoteTimeUS);
+
+        if (_sampleCount++ == 0u)
+        {
+            _targetOffsetUS = _windowMinUS = sampleUS;
+            _windowStartUS = localTimeUS;
+            return;
+        }
+
+        // A lower offset means a message got here faster than any before it. That's as close to the real offset as we've been, so use it right away
+        _targetOffsetUS = std::min(_targetOffsetUS, sampleUS);
+        _windowMinUS = std::min(_windowMinUS, sampleUS);
+
+        if (localTimeUS - _windowStartUS >= WindowUS)
+        {
+            // Latency or drift went up and nothing came in as fast as before for a whole window. Follow it
+            _targetOffsetUS = _windowMinUS;
+            _windowMinUS = sampleUS;
+            _windowStartUS = localTimeUS;
+        }
+    }
+
+    void ClockSync::update(const U64 localTimeUS) noexcept
+    {
+        if (!synced())
+        {
+            _lastUpdateUS = localTimeUS;
+            return;
+        }
+
+        const I64 gapUS = _targetOffsetUS - _appliedOffsetUS;
+        if (!_appliedValid || std::abs(gapUS) > to_I64(SnapThresholdUS))
+        {
+            _appliedOffsetUS = _targetOffsetUS;
+            _appliedValid = true;
+        }
+        else
+        {
+            // Speed up or slow down our copy of the server clock instead of jumping. Anything we render moves a bit faster or slower for a while instead of popping
+            const I64 maxStepUS = to_I64(to_D64(localTimeUS - _lastUpdateUS) * MaxSlewRate);
+            _appliedOffsetUS += std::clamp(gapUS, -maxStepUS, maxStepUS);
+        }
+
+        _lastUpdateUS = localTimeUS;
+
+        const I64 remoteTimeUS = to_I64(localTimeUS) - _appliedOffsetUS;
+        _remoteTimeUS = remoteTimeUS > 0 ? to_U64(remoteTimeUS) : 0u;
+    }
+
+    void ClockSync::reset() noexcept
+    {
+        *this = {};
+    }
+
+    bool SnapshotBuffer::push(const U64 serverTimeUS, const TransformValues& values)
+    {
+        // States mostly arrive in order, so look for the insert position starting from the newest one
+        size_t idx = _count;
+        while (idx > 0u && at(idx - 1u)._serverTimeUS > serverTimeUS)
+        {
+            --idx;
+        }
+
+        if (idx > 0u && at(idx - 1u)._serverTimeUS == serverTimeUS)
+        {
+            return false;
+        }
+
+        if (_count == Capacity)
+        {
+            if (idx == 0u)
+            {
+                return false;
+            }
+
+            // Make room by dropping the oldest state
+            _first = (_first + 1u) % Capacity;
+            --_count;
+            --idx;
+        }
+
+        for (size_t i = _count; i > idx; --i)
+        {
+            at(i) = at(i - 1u);
+        }
+
+        Snapshot& snapshot = at(idx);
+        snapshot._serverTimeUS = serverTimeUS;
+        snapshot._values = values;
+        ++_count;
+
+        return true;
+    }
+
+    SnapshotBuffer::SampleResult SnapshotBuffer::sample(const U64 renderTimeUS, const InterpolationSettings& settings, TransformValues& valuesOut) const
+    {
+        if (_count == 0u)
+        {
+            return SampleResult::EMPTY;
+        }
+
+        const Snapshot& oldest = at(0u);
+        const Snapshot& newest = at(_count - 1u);
+
+        if (renderTimeUS > newest._serverTimeUS)
+        {
+            if (_count == 1u)
+            {
+                valuesOut = newest._values;
+                return SampleResult::CLAMPED;
+            }
+
+            // Keep going the way we were going, but not for long: the further we guess, the bigger the error once the real state arrives
+            const Snapshot& previous = at(_count - 2u);
+            const U64 extrapolatedTimeUS = std::min(renderTimeUS, newest._serverTimeUS + settings._maxExtrapolationUS);
+            const D64 t = to_D64(extrapolatedTimeUS - previous._serverTimeUS) / to_D64(newest._serverTimeUS - previous._serverTimeUS);
+            valuesOut = Lerp(previous._values, newest._values, to_F32(t));
+
+            return extrapolatedTimeUS < renderTimeUS ? SampleResult::CLAMPED : SampleResult::EXTRAPOLATED;
+        }
+
+        if (renderTimeUS <= oldest._serverTimeUS)
+        {
+            valuesOut = oldest._values;
+            return renderTimeUS == oldest._serverTimeUS ? SampleResult::INTERPOLATED : SampleResult::HELD;
+        }
+
+        // Render time is between oldest and newest and usually close to the newest, so search from the back
+        size_t idx = _count - 1u;
+        while (at(idx - 1u)._serverTimeUS > renderTimeUS)
+        {
+            --idx;
+        }
+
+        const Snapshot& from = at(idx - 1u);
+        const Snapshot& to = at(idx);
+        const D64 t = to_D64(renderTimeUS - from._serverTimeUS) / to_D64(to._serverTimeUS - from._serverTimeUS);
+        valuesOut = Lerp(from._values, to._values, to_F32(t));
+
+        return SampleResult::INTERPOLATED;
+    }
+
+    void SnapshotBuffer::clear() noexcept
+    {
+        _first = _count = 0u;
+    }
+
+    void CorrectionBlender::setCorrection(const TransformValues& predicted, const TransformValues& corrected)
+    {
+        _positionError = corrected._translation - predicted._translation;
+        _scaleError = corrected._scale - predicted._scale;
+        _orientationError = corrected._orientation * predicted._orientation.inverse();
+        _active = true;
+    }
+
+    bool CorrectionBlender::apply(const U64 elapsedUS, const InterpolationSettings& settings, TransformValues& valuesInOut)
+    {
+        if (!_active)
+        {
+            return false;
+        }
+
+        const F32 positionErrorSQ = _positionError.lengthSquared();
+
+        F32 factor = 1.f;
+        if (positionErrorSQ <= SQUARED(settings._correctionSnapDistance) && settings._correctionHalfLifeUS > 0u)
+        {
+            // The vector part of the rotation error is sin(angle / 2) * axis. Avoids acos, which goes NaN for dot products that round past 1
+            const F32 orientationErrorSQ = SQUARED(_orientationError.X()) + SQUARED(_orientationError.Y()) + SQUARED(_orientationError.Z());
+            const bool done = positionErrorSQ < SQUARED(MinCorrection) &&
+                              _scaleError.lengthSquared() < SQUARED(MinCorrection) &&
+                              orientationErrorSQ < SQUARED(MinCorrection);
+
+            if (!done)
+            {
+                // Exponential decay: half of the remaining error is left after each half life, no matter how the frames are spaced
+                factor = 1.f - std::exp2(-to_F32(elapsedUS) / to_F32(settings._correctionHalfLifeUS));
+            }
+        }
+
+        const float3 positionStep = _positionError * factor;
+        const float3 scaleStep = _scaleError * factor;
+
+        valuesInOut._translation += positionStep;
+        valuesInOut._scale += scaleStep;
+        valuesInOut._orientation = Slerp(quatf{}, _orientationError, factor) * valuesInOut._orientation;
+
+        if (factor >= 1.f)
+        {
+            reset();
+        }
+        else
+        {
+            _positionError -= positionStep;
+            _scaleError -= scaleStep;
+            _orientationError = Slerp(quatf{}, _orientationError, 1.f - factor);
+        }
+
+        return true;
+    }
+
+    void CorrectionBlender::reset() noexcept
+    {
+        *this = {};
+    }
+
+} //namespace Divide::Networking
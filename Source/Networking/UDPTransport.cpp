@@ -0,0 +1,82 @@
+
+
+#include "Headers/UDPTransport.h"
+
+#include "Utility/Headers/Localization.h"
+
+namespace Divide::Networking
+{
+    UDPTransport::UDPTransport(boost::asio::io_context& asioContext, ReceiveCallback&& receiveCallback)
+        : _socket(asioContext)
+        , _receiveCallback(MOV(receiveCallback))
+    {
+    }
+
+    bool UDPTransport::open(const U16 port)
+    {
+        boost::system::error_code ec;
+        _socket.open(boost::asio::ip::udp::v4(), ec);
+        if (!ec)
+        {
+            _socket.bind(boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), port), ec);
+        }
+
+        if (ec)
+        {
+            Console::errorfn(LOCALE_STR("NETWORK_ERROR_CODE_ERROR"), ec.message());
+            close();
+            return false;
+        }
+
+        receive();
+        return true;
+    }
+
+    void UDPTransport::close()
+    {
+        boost::system::error_code ec;
+        _socket.close(ec);
+    }
+
+    bool UDPTransport::isOpen() const
+    {
+        return _socket.is_open();
+    }
+
+    void UDPTransport::sendTo(const boost::asio::ip::udp::endpoint& remote, const Byte* data, const size_t size)
+    {
+        boost::system::error_code ec;
+        _socket.send_to(boost::asio::buffer(data, size), remote, 0, ec);
+        // Dropping a datagram is fine. The reliability layer resends whatever needs to arrive
+        if (ec && ec != boost::asio::error::would_block)
+        {
+            Console::errorfn(LOCALE_STR("NETWORK_ERROR_CODE_ERROR"), ec.message());
+        }
+    }
+
+    void UDPTransport::receive()
+    {
+        _socket.async_receive_from
+        (
+            boost::asio::buffer(_receiveBuffer),
+            _sender,
+            [this](const boost::system::error_code ec, const std::size_t length)
+            {
+                if (ec == boost::asio::error::operation_aborted || !_socket.is_open())
+                {
+                    // Socket closed
+                    return;
+                }
+
+                // Errors here are about a single datagram (too large, ICMP port unreachable, etc.). Keep listening
+                if (!ec)
+                {
+                    _receiveCallback(_sender, _receiveBuffer.data(), length);
+                }
+
+                receive();
+            }
+        );
+    }
+
+} //namespace Divide::Networking
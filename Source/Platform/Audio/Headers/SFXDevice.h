@@ -44,6 +44,7 @@ public:
         FMOD,
         OpenAL,
         SDL,
+        None,
         COUNT
     };
 
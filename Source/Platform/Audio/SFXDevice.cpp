@@ -3,6 +3,7 @@
 #include "Headers/SFXDevice.h"
 
 #include "Platform/Audio/fmod/Headers/FmodWrapper.h"
+#include "Platform/Audio/none/Headers/NoneWrapper.h"
 #include "Platform/Audio/sdl_mixer/Headers/SDLWrapper.h"
 #include "Platform/Audio/openAl/Headers/ALWrapper.h"
 
@@ -37,6 +38,9 @@ ErrorCode SFXDevice::initAudioAPI() {
         case AudioAPI::SDL: {
             _api = std::make_unique<SDL_API>( _context );
         } break;
+        case AudioAPI::None: {
+            _api = std::make_unique<AudioNone>( _context );
+        } break;
         default:
         case AudioAPI::COUNT:
         {
@@ -64,6 +64,7 @@
 #endif
 
 #define strcasecmp _stricmp
+#define strncasecmp _strnicmp
 
 LRESULT DlgProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) noexcept;
 
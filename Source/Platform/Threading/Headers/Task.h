@@ -49,11 +49,17 @@ enum class TaskPriority : U8
 struct alignas(128) Task
 {
     static constexpr U32 INVALID_TASK_ID = Config::MAX_POOLED_TASKS;
+    static constexpr U32 INVALID_CALLBACK_HANDLE = U32_MAX;
 
     DELEGATE<void, Task&> _callback;
     Task* _parent{ nullptr };
     std::atomic_uint _unfinishedJobs{ 0u };
     U32 _globalId{ INVALID_TASK_ID };
+    /// Generation tagged slot in the owning pool's completion callback table
+    U32 _callbackHandle{ INVALID_CALLBACK_HANDLE };
+    /// Completion callback that didn't fit in the owning pool's callback table. Handed over to the pool's overflow queue when the task finishes
+    DELEGATE<void> _overflowCallback;
+    TaskPriority _priority{ TaskPriority::DONT_CARE };
 };
 
 constexpr auto TASK_NOP = [](Task&) { NOP(); };
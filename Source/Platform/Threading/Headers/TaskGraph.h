@@ -0,0 +1,99 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+
+#pragma once
+#ifndef DVD_TASK_GRAPH_H_
+#define DVD_TASK_GRAPH_H_
+
+#include "Platform/Threading/Headers/Task.h"
+
+namespace Divide {
+
+class TaskPool;
+
+/// A set of work items with explicit dependencies between them (a DAG). A node may have any number of predecessors and successors.
+/// When a node finishes it decrements the dependency counter of each successor and starts the ones that reach zero directly,
+/// so nothing ever polls or re-queues itself waiting for its inputs.
+/// Nodes started with TaskPriority::REALTIME are not threaded: they always run on the thread that called run(), which helps the pool with other work while waiting.
+class TaskGraph final : private NonCopyable
+{
+  public:
+    using NodeHandle = U16;
+    static constexpr NodeHandle INVALID_NODE = U16_MAX;
+
+    TaskGraph() = default;
+
+    /// Adds a new node that will run the specified work item. Nodes can only be added while the graph isn't running.
+    NodeHandle addNode(DELEGATE<void>&& work, TaskPriority priority = TaskPriority::DONT_CARE);
+    /// successor will not start before predecessor finishes
+    void addDependency(NodeHandle predecessor, NodeHandle successor);
+    /// Convenience wrapper that makes successor depend on every node in predecessors
+    void addDependencies(std::initializer_list<NodeHandle> predecessors, NodeHandle successor);
+
+    /// Starts all of the nodes with no dependencies and blocks until every node in the graph has finished.
+    void run(TaskPool& pool);
+
+    /// Removes all nodes and dependencies
+    void clear();
+
+    /// Returns false if the graph contains a cycle (and would never finish)
+    [[nodiscard]] bool validate() const;
+
+    [[nodiscard]] size_t nodeCount() const noexcept;
+
+  private:
+    struct Node
+    {
+        DELEGATE<void> _work;
+        eastl::fixed_vector<NodeHandle, 4, true> _successors;
+        U16 _dependencyCount{ 0u };
+        TaskPriority _priority{ TaskPriority::DONT_CARE };
+    };
+
+    void startNode(NodeHandle node);
+    void runNode(NodeHandle node);
+
+  private:
+    vector<Node> _nodes;
+    /// Per node count of predecessors that haven't finished yet. Only valid during run()
+    std::unique_ptr<std::atomic_uint[]> _remainingDependencies;
+    /// REALTIME nodes that became ready and are waiting for the calling thread to pick them up
+    moodycamel::ConcurrentQueue<NodeHandle> _callerQueue;
+    /// Every threaded node runs as a child of this task, so its counter tracks the nodes still in flight. It lives in the pool's task storage
+    /// instead of in the graph because workers touch it after a node is done, by which time run() may have returned and the graph may be gone
+    Task* _graphTask{ nullptr };
+    TaskPool* _pool{ nullptr };
+};
+
+} // namespace Divide
+
+#endif //DVD_TASK_GRAPH_H_
@@ -0,0 +1,194 @@
+
+
+#include "Headers/TaskGraph.h"
+
+namespace Divide
+{
+    TaskGraph::NodeHandle TaskGraph::addNode( DELEGATE<void>&& work, const TaskPriority priority )
+    {
+        DIVIDE_ASSERT( _pool == nullptr, "TaskGraph::addNode error: can't add nodes to a running graph!" );
+        DIVIDE_ASSERT( _nodes.size() < INVALID_NODE, "TaskGraph::addNode error: too many nodes!" );
+
+        Node& node = _nodes.emplace_back();
+        node._work = MOV( work );
+        node._priority = priority;
+
+        return to_U16( _nodes.size() - 1u );
+    }
+
+    void TaskGraph::addDependency( const NodeHandle predecessor, const NodeHandle successor )
+    {
+        DIVIDE_ASSERT( _pool == nullptr, "TaskGraph::addDependency error: can't add dependencies to a running graph!" );
+        DIVIDE_ASSERT( predecessor < _nodes.size() && successor < _nodes.size() && predecessor != successor, "TaskGraph::addDependency error: invalid node handles!" );
+
+        Node& pred = _nodes[predecessor];
+        if ( eastl::find( eastl::cbegin( pred._successors ), eastl::cend( pred._successors ), successor ) != eastl::cend( pred._successors ) )
+        {
+            return;
+        }
+
+        pred._successors.push_back( successor );
+        ++_nodes[successor]._dependencyCount;
+    }
+
+    void TaskGraph::addDependencies( const std::initializer_list<NodeHandle> predecessors, const NodeHandle successor )
+    {
+        for ( const NodeHandle predecessor : predecessors )
+        {
+            addDependency( predecessor, successor );
+        }
+    }
+
+    void TaskGraph::clear()
+    {
+        DIVIDE_ASSERT( _pool == nullptr, "TaskGraph::clear error: can't clear a running graph!" );
+
+        _nodes.clear();
+        _remainingDependencies.reset();
+    }
+
+    size_t TaskGraph::nodeCount() const noexcept
+    {
+        return _nodes.size();
+    }
+
+    bool TaskGraph::validate() const
+    {
+        // Kahn's algorithm: if we can't visit every node by repeatedly removing nodes with no remaining inputs, we have a cycle
+        const size_t count = _nodes.size();
+
+        vector<U16> inDegree( count );
+        vector<NodeHandle> ready;
+        ready.reserve( count );
+
+        for ( size_t i = 0u; i < count; ++i )
+        {
+            inDegree[i] = _nodes[i]._dependencyCount;
+            if ( inDegree[i] == 0u )
+            {
+                ready.push_back( to_U16( i ) );
+            }
+        }
+
+        size_t visited = 0u;
+        while ( !ready.empty() )
+        {
+            const NodeHandle crt = ready.back();
+            ready.pop_back();
+            ++visited;
+
+            for ( const NodeHandle successor : _nodes[crt]._successors )
+            {
+                if ( --inDegree[successor] == 0u )
+                {
+                    ready.push_back( successor );
+                }
+            }
+        }
+
+        return visited == count;
+    }
+
+    void TaskGraph::run( TaskPool& pool )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Threading );
+
+        const size_t count = _nodes.size();
+        if ( count == 0u )
+        {
+            return;
+        }
+
+        if constexpr ( Config::Build::IS_DEBUG_BUILD )
+        {
+            DIVIDE_ASSERT( validate(), "TaskGraph::run error: dependency cycle detected!" );
+        }
+
+        _pool = &pool;
+        _remainingDependencies = std::make_unique<std::atomic_uint[]>( count );
+        for ( size_t i = 0u; i < count; ++i )
+        {
+            _remainingDependencies[i].store( _nodes[i]._dependencyCount, std::memory_order_relaxed );
+        }
+        // Never started, so its counter stays at 1 (our own reference) plus one per threaded node that hasn't finished yet
+        _graphTask = TaskPool::AllocateTask( nullptr, TASK_NOP );
+
+        for ( size_t i = 0u; i < count; ++i )
+        {
+            if ( _nodes[i]._dependencyCount == 0u )
+            {
+                startNode( to_U16( i ) );
+            }
+        }
+
+        while ( true )
+        {
+            NodeHandle node = INVALID_NODE;
+            if ( _callerQueue.try_dequeue( node ) )
+            {
+                runNode( node );
+                continue;
+            }
+
+            const U32 unfinishedJobs = _graphTask->_unfinishedJobs.load();
+            if ( unfinishedJobs == 1u )
+            {
+                // Caller nodes are queued by the node that readies them before it finishes, so one last look at the queue settles it
+                if ( !_callerQueue.try_dequeue( node ) )
+                {
+                    break;
+                }
+
+                runNode( node );
+            }
+            else if ( !pool.threadWaiting() )
+            {
+                // Every node task decrements and notifies its parent's counter when it is done
+                _graphTask->_unfinishedJobs.wait( unfinishedJobs );
+            }
+        }
+
+        // Drop our own reference so the pool can reuse the task
+        _graphTask->_unfinishedJobs.fetch_sub( 1u );
+        _graphTask = nullptr;
+        _pool = nullptr;
+    }
+
+    void TaskGraph::startNode( const NodeHandle node )
+    {
+        if ( _nodes[node]._priority == TaskPriority::REALTIME )
+        {
+            DIVIDE_EXPECTED_CALL( _callerQueue.enqueue( node ) );
+            return;
+        }
+
+        Task* task = TaskPool::AllocateTask( _graphTask, [this, node]( [[maybe_unused]] Task& parentTask )
+        {
+            runNode( node );
+        });
+
+        Start( *task, *_pool, _nodes[node]._priority );
+    }
+
+    void TaskGraph::runNode( const NodeHandle node )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Threading );
+
+        const Node& crtNode = _nodes[node];
+        if ( crtNode._work )
+        {
+            crtNode._work();
+        }
+
+        // Successors are started (and counted against _graphTask) before the pool marks this node's task as finished,
+        // so run() can never see the count drop to its own reference while there is still work left to do
+        for ( const NodeHandle successor : crtNode._successors )
+        {
+            if ( _remainingDependencies[successor].fetch_sub( 1u ) == 1u )
+            {
+                startNode( successor );
+            }
+        }
+    }
+
+} //namespace Divide
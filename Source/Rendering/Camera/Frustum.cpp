@@ -5,9 +5,139 @@
 #include "Platform/Video/Headers/GFXDevice.h"
 #include "Core/Math/BoundingVolumes/Headers/BoundingBox.h"
 #include "Core/Math/BoundingVolumes/Headers/BoundingSphere.h"
+#include "Core/Math/Headers/SimdLanes.h"
 
 namespace Divide {
 
+namespace
+{
+    using FrustumPlanes = std::array<Plane<F32>, to_base(FrustumPlane::COUNT)>;
+
+    [[nodiscard]] FORCE_INLINE FrustumCollision ToCollision(const bool out, const bool intersect) noexcept
+    {
+        return out ? FrustumCollision::FRUSTUM_OUT : intersect ? FrustumCollision::FRUSTUM_INTERSECT : FrustumCollision::FRUSTUM_IN;
+    }
+
+    template<typename Lanes>
+    FORCE_INLINE void WriteResults(const U32 outMask, const U32 intersectMask, FrustumCollision* resultsOut) noexcept
+    {
+        for (size_t lane = 0u; lane < Lanes::Width; ++lane)
+        {
+            resultsOut[lane] = ToCollision(((outMask >> lane) & 1u) != 0u, ((intersectMask >> lane) & 1u) != 0u);
+        }
+    }
+
+    /// Plane distance: ((n.x * x + n.y * y) + n.z * z) + d. The scalar tail loops below use the exact same operation order
+    template<typename Lanes>
+    [[nodiscard]] FORCE_INLINE typename Lanes::Reg PlaneDistance(const Plane<F32>& plane, const typename Lanes::Reg& x, const typename Lanes::Reg& y, const typename Lanes::Reg& z) noexcept
+    {
+        return Lanes::Add(Lanes::Add(Lanes::Add(Lanes::Mul(Lanes::Set(plane._normal.x), x),
+                                                Lanes::Mul(Lanes::Set(plane._normal.y), y)),
+                                     Lanes::Mul(Lanes::Set(plane._normal.z), z)),
+                          Lanes::Set(plane._distance));
+    }
+
+    [[nodiscard]] FORCE_INLINE F32 PlaneDistance(const Plane<F32>& plane, const F32 x, const F32 y, const F32 z) noexcept
+    {
+        return ((plane._normal.x * x + plane._normal.y * y) + plane._normal.z * z) + plane._distance;
+    }
+
+    /// Processes as many full groups of Lanes::Width spheres as possible. Returns the number of spheres processed
+    template<typename Lanes>
+    size_t ContainsSpheresBatch(const FrustumPlanes& planes, const BoundingSpheresSoA& spheres, const float3& eyePos, FrustumCollision* resultsOut, F32* distanceSqOut) noexcept
+    {
+        constexpr U32 allLanes = (1u << Lanes::Width) - 1u;
+
+        const auto zero = Lanes::Set(0.f);
+        const auto eyeX = Lanes::Set(eyePos.x);
+        const auto eyeY = Lanes::Set(eyePos.y);
+        const auto eyeZ = Lanes::Set(eyePos.z);
+
+        size_t i = 0u;
+        for (; i + Lanes::Width <= spheres._count; i += Lanes::Width)
+        {
+            const auto centerX = Lanes::Load(spheres._centerX + i);
+            const auto centerY = Lanes::Load(spheres._centerY + i);
+            const auto centerZ = Lanes::Load(spheres._centerZ + i);
+            const auto radius = Lanes::Load(spheres._radius + i);
+            const auto negRadius = Lanes::Sub(zero, radius);
+
+            U32 outMask = 0u, intersectMask = 0u;
+            for (const Plane<F32>& plane : planes)
+            {
+                const auto distance = PlaneDistance<Lanes>(plane, centerX, centerY, centerZ);
+                outMask |= Lanes::LessThan(distance, negRadius);
+                intersectMask |= Lanes::LessThan(distance, radius);
+                if (outMask == allLanes)
+                {
+                    break;
+                }
+            }
+            WriteResults<Lanes>(outMask, intersectMask, resultsOut + i);
+
+            if (distanceSqOut != nullptr)
+            {
+                const auto dX = Lanes::Sub(centerX, eyeX);
+                const auto dY = Lanes::Sub(centerY, eyeY);
+                const auto dZ = Lanes::Sub(centerZ, eyeZ);
+                const auto distanceSq = Lanes::Add(Lanes::Add(Lanes::Mul(dX, dX), Lanes::Mul(dY, dY)), Lanes::Mul(dZ, dZ));
+                Lanes::Store(distanceSqOut + i, Lanes::Max(Lanes::Sub(distanceSq, Lanes::Mul(radius, radius)), zero));
+            }
+        }
+
+        return i;
+    }
+
+    /// Processes as many full groups of Lanes::Width boxes as possible. Returns the number of boxes processed
+    template<typename Lanes>
+    size_t ContainsBoundingBoxesBatch(const FrustumPlanes& planes, const BoundingBoxesSoA& boxes, const float3& eyePos, FrustumCollision* resultsOut, F32* distanceSqOut) noexcept
+    {
+        constexpr U32 allLanes = (1u << Lanes::Width) - 1u;
+
+        const auto zero = Lanes::Set(0.f);
+        const auto eyeX = Lanes::Set(eyePos.x);
+        const auto eyeY = Lanes::Set(eyePos.y);
+        const auto eyeZ = Lanes::Set(eyePos.z);
+
+        size_t i = 0u;
+        for (; i + Lanes::Width <= boxes._count; i += Lanes::Width)
+        {
+            const auto minX = Lanes::Load(boxes._minX + i);
+            const auto minY = Lanes::Load(boxes._minY + i);
+            const auto minZ = Lanes::Load(boxes._minZ + i);
+            const auto maxX = Lanes::Load(boxes._maxX + i);
+            const auto maxY = Lanes::Load(boxes._maxY + i);
+            const auto maxZ = Lanes::Load(boxes._maxZ + i);
+
+            U32 outMask = 0u, intersectMask = 0u;
+            for (const Plane<F32>& plane : planes)
+            {
+                // The plane's normal is the same for every lane, so picking the P and N vertices is just a register swap
+                const bool posX = plane._normal.x >= 0.f, posY = plane._normal.y >= 0.f, posZ = plane._normal.z >= 0.f;
+                const auto pDistance = PlaneDistance<Lanes>(plane, posX ? maxX : minX, posY ? maxY : minY, posZ ? maxZ : minZ);
+                const auto nDistance = PlaneDistance<Lanes>(plane, posX ? minX : maxX, posY ? minY : maxY, posZ ? minZ : maxZ);
+                outMask |= Lanes::LessThan(pDistance, zero);
+                intersectMask |= Lanes::LessThan(nDistance, zero);
+                if (outMask == allLanes)
+                {
+                    break;
+                }
+            }
+            WriteResults<Lanes>(outMask, intersectMask, resultsOut + i);
+
+            if (distanceSqOut != nullptr)
+            {
+                const auto dX = Lanes::Sub(Lanes::Min(Lanes::Max(eyeX, minX), maxX), eyeX);
+                const auto dY = Lanes::Sub(Lanes::Min(Lanes::Max(eyeY, minY), maxY), eyeY);
+                const auto dZ = Lanes::Sub(Lanes::Min(Lanes::Max(eyeZ, minZ), maxZ), eyeZ);
+                Lanes::Store(distanceSqOut + i, Lanes::Add(Lanes::Add(Lanes::Mul(dX, dX), Lanes::Mul(dY, dY)), Lanes::Mul(dZ, dZ)));
+            }
+        }
+
+        return i;
+    }
+} //namespace
+
 FrustumCollision PlanePointIntersect(const Plane<F32>& plane, const float3& point) noexcept
 {
     switch (plane.classifyPoint(point))
@@ -252,6 +382,100 @@ FrustumCollision Frustum::ContainsBoundingBox(const BoundingBox& bbox, I8& lastP
     return res;
 }
 
+FrustumCollision Frustum::ClassifyBoundingBox(const BoundingBox& bbox) const noexcept
+{
+    FrustumCollision res = FrustumCollision::FRUSTUM_IN;
+
+    for (const Plane<F32>& plane : _frustumPlanes)
+    {
+        switch (Divide::PlaneBoundingBoxIntersect(plane, bbox))
+        {
+            case FrustumCollision::FRUSTUM_OUT: return FrustumCollision::FRUSTUM_OUT;
+            case FrustumCollision::FRUSTUM_INTERSECT: res = FrustumCollision::FRUSTUM_INTERSECT; break;
+            default: break;
+        }
+    }
+
+    return res;
+}
+
+void Frustum::ContainsSpheres(const BoundingSpheresSoA& spheres, const float3& eyePos, FrustumCollision* resultsOut, F32* distanceSqOut) const noexcept
+{
+    size_t i = ContainsSpheresBatch<WideLanes>(_frustumPlanes, spheres, eyePos, resultsOut, distanceSqOut);
+    if constexpr (WideLanes::Width > SSELanes::Width)
+    {
+        i += ContainsSpheresBatch<SSELanes>(_frustumPlanes, BoundingSpheresSoA
+        {
+            ._centerX = spheres._centerX + i,
+            ._centerY = spheres._centerY + i,
+            ._centerZ = spheres._centerZ + i,
+            ._radius = spheres._radius + i,
+            ._count = spheres._count - i
+        }, eyePos, resultsOut + i, distanceSqOut != nullptr ? distanceSqOut + i : nullptr);
+    }
+
+    for (; i < spheres._count; ++i)
+    {
+        const F32 x = spheres._centerX[i], y = spheres._centerY[i], z = spheres._centerZ[i], radius = spheres._radius[i];
+
+        bool out = false, intersect = false;
+        for (const Plane<F32>& plane : _frustumPlanes)
+        {
+            const F32 distance = PlaneDistance(plane, x, y, z);
+            out = out || distance < -radius;
+            intersect = intersect || distance < radius;
+        }
+        resultsOut[i] = ToCollision(out, intersect);
+
+        if (distanceSqOut != nullptr)
+        {
+            const F32 dX = x - eyePos.x, dY = y - eyePos.y, dZ = z - eyePos.z;
+            distanceSqOut[i] = std::max((dX * dX + dY * dY) + dZ * dZ - radius * radius, 0.f);
+        }
+    }
+}
+
+void Frustum::ContainsBoundingBoxes(const BoundingBoxesSoA& boxes, const float3& eyePos, FrustumCollision* resultsOut, F32* distanceSqOut) const noexcept
+{
+    size_t i = ContainsBoundingBoxesBatch<WideLanes>(_frustumPlanes, boxes, eyePos, resultsOut, distanceSqOut);
+    if constexpr (WideLanes::Width > SSELanes::Width)
+    {
+        i += ContainsBoundingBoxesBatch<SSELanes>(_frustumPlanes, BoundingBoxesSoA
+        {
+            ._minX = boxes._minX + i,
+            ._minY = boxes._minY + i,
+            ._minZ = boxes._minZ + i,
+            ._maxX = boxes._maxX + i,
+            ._maxY = boxes._maxY + i,
+            ._maxZ = boxes._maxZ + i,
+            ._count = boxes._count - i
+        }, eyePos, resultsOut + i, distanceSqOut != nullptr ? distanceSqOut + i : nullptr);
+    }
+
+    for (; i < boxes._count; ++i)
+    {
+        const F32 minX = boxes._minX[i], minY = boxes._minY[i], minZ = boxes._minZ[i];
+        const F32 maxX = boxes._maxX[i], maxY = boxes._maxY[i], maxZ = boxes._maxZ[i];
+
+        bool out = false, intersect = false;
+        for (const Plane<F32>& plane : _frustumPlanes)
+        {
+            const bool posX = plane._normal.x >= 0.f, posY = plane._normal.y >= 0.f, posZ = plane._normal.z >= 0.f;
+            out = out || PlaneDistance(plane, posX ? maxX : minX, posY ? maxY : minY, posZ ? maxZ : minZ) < 0.f;
+            intersect = intersect || PlaneDistance(plane, posX ? minX : maxX, posY ? minY : maxY, posZ ? minZ : maxZ) < 0.f;
+        }
+        resultsOut[i] = ToCollision(out, intersect);
+
+        if (distanceSqOut != nullptr)
+        {
+            const F32 dX = std::min(std::max(eyePos.x, minX), maxX) - eyePos.x;
+            const F32 dY = std::min(std::max(eyePos.y, minY), maxY) - eyePos.y;
+            const F32 dZ = std::min(std::max(eyePos.z, minZ), maxZ) - eyePos.z;
+            distanceSqOut[i] = (dX * dX + dY * dY) + dZ * dZ;
+        }
+    }
+}
+
 void Frustum::set(const Frustum& other) noexcept
 {
     _frustumPlanes = other._frustumPlanes;
@@ -39,6 +39,26 @@ class Camera;
 class BoundingBox;
 class BoundingSphere;
 
+/// Structure of arrays view over a batch of bounding spheres. Every array must hold at least _count elements
+struct BoundingSpheresSoA {
+    const F32* _centerX = nullptr;
+    const F32* _centerY = nullptr;
+    const F32* _centerZ = nullptr;
+    const F32* _radius = nullptr;
+    size_t _count = 0u;
+};
+
+/// Structure of arrays view over a batch of axis aligned bounding boxes. Every array must hold at least _count elements
+struct BoundingBoxesSoA {
+    const F32* _minX = nullptr;
+    const F32* _minY = nullptr;
+    const F32* _minZ = nullptr;
+    const F32* _maxX = nullptr;
+    const F32* _maxY = nullptr;
+    const F32* _maxZ = nullptr;
+    size_t _count = 0u;
+};
+
 class Frustum {
    public:
 
@@ -59,6 +79,17 @@ class Frustum {
         return ContainsBoundingBox(bbox, lastPlaneCache);
     }
 
+    /// Unlike ContainsBoundingBox, keeps going after the first plane the box straddles so that INTERSECT is only returned if no plane rejects the box.
+    /// Use this when a false INTERSECT is expensive (e.g. it means visiting an entire branch of a bounding volume hierarchy)
+    [[nodiscard]] FrustumCollision ClassifyBoundingBox(const BoundingBox& bbox) const noexcept;
+
+    /// Batched versions of the tests above. Volumes are tested 8 (AVX) or 4 (SSE) at a time against all planes, so, like ClassifyBoundingBox,
+    /// INTERSECT is only returned if no plane rejects the volume. resultsOut gets one entry per volume (FRUSTUM_OUT means not visible).
+    /// If distanceSqOut is not null, it gets the squared distance from eyePos to each volume, computed the same way as
+    /// BoundingSphere::getDistanceSQFromPoint and BoundingBox::nearestPoint respectively
+    void ContainsSpheres(const BoundingSpheresSoA& spheres, const float3& eyePos, FrustumCollision* resultsOut, F32* distanceSqOut = nullptr) const noexcept;
+    void ContainsBoundingBoxes(const BoundingBoxesSoA& boxes, const float3& eyePos, FrustumCollision* resultsOut, F32* distanceSqOut = nullptr) const noexcept;
+
     [[nodiscard]] FrustumCollision ContainsSphere(const float3& center, const F32 radius) const noexcept {
         I8 lastPlaneCache = -1;
         return ContainsSphere(center, radius, lastPlaneCache);
@@ -0,0 +1,141 @@
+/*
+   Copyright (c) 2018 DIVIDE-Studio
+   Copyright (c) 2009 Ionut Cava
+
+   This file is part of DIVIDE Framework.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software
+   and associated documentation files (the "Software"), to deal in the Software
+   without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish,
+   distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED,
+   INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+   DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+   IN CONNECTION WITH THE SOFTWARE
+   OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#pragma once
+#ifndef DVD_MATERIAL_SLOT_CACHE_H_
+#define DVD_MATERIAL_SLOT_CACHE_H_
+
+namespace Divide
+{
+
+/// Maps material data hashes to slots in the node material buffer.
+/// Lookups only take a shared lock on one of several shards, so parallel parse ranges rarely contend.
+/// Slots that haven't been used for MAX_FRAME_LIFETIME frames get recycled, least recently used first.
+/// If every slot is still in use, the cache grows past its initial size and the caller has to resize the GPU buffer.
+class MaterialSlotCache
+{
+  public:
+    static constexpr U32 INVALID_SLOT = U32_MAX;
+    static constexpr size_t INVALID_HASH = SIZE_MAX;
+    // Remove materials that haven't been indexed in this amount of frames to make space for new ones
+    static constexpr U64 MAX_FRAME_LIFETIME = 6u;
+
+    /// Drops all entries and sets the number of available slots
+    void reset( U32 slotCount );
+    /// Call once per frame, after all lookups for that frame are done. Ages every entry by one frame
+    void onFrameEnd() noexcept;
+
+    /// Returns the slot holding the specified hash (and marks it as used this frame) or INVALID_SLOT if there isn't one
+    [[nodiscard]] U32 find( size_t hash );
+
+    /// Same as find, but on a miss a new slot gets assigned to the hash. That slot is either unused, expired or
+    /// (if neither is available) a new one past the current slot count.
+    /// onInsert( slot, grew ) is called for new slots only and is serialized with every other insertion,
+    /// so it may safely write the slot's data to storage shared between threads (and resize it if "grew" is true)
+    template<typename InsertFunc>
+    [[nodiscard]] U32 findOrInsert( size_t hash, InsertFunc&& onInsert );
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t slotCount() const;
+
+  private:
+    struct Entry
+    {
+        U32 _slot{ INVALID_SLOT };
+        /// Updated under a shared lock, so only ever accessed via std::atomic_ref
+        U64 _lastUsedFrame{ 0u };
+    };
+
+    struct Shard
+    {
+        mutable SharedMutex _lock;
+        hashMap<size_t, Entry> _entries;
+    };
+
+    static constexpr size_t SHARD_COUNT = 16u;
+
+    [[nodiscard]] Shard& shardFor( size_t hash ) noexcept;
+    [[nodiscard]] static U32 Find( Shard& shard, size_t hash, U64 frame );
+
+    /// Returns a free or expired slot, or a new one if none is available. Expects _slotLock to be held
+    [[nodiscard]] U32 acquireSlotLocked( U64 frame, bool& grewOut );
+
+  private:
+    std::array<Shard, SHARD_COUNT> _shards;
+    std::atomic<U64> _frame{ 0u };
+
+    /// Everything below is protected by _slotLock
+    mutable Mutex _slotLock;
+    /// Hash stored in each slot (INVALID_HASH if unused)
+    vector<size_t> _slotHashes;
+    vector<U32> _freeSlots;
+    /// Used slots in the order they were inserted (or last found to still be in use). The front is the next eviction candidate
+    std::deque<U32> _evictionQueue;
+    /// Set when a full pass over the eviction queue found nothing to evict. Nothing can expire until the frame changes
+    U64 _exhaustedFrame{ U64_MAX };
+};
+
+template<typename InsertFunc>
+U32 MaterialSlotCache::findOrInsert( const size_t hash, InsertFunc&& onInsert )
+{
+    const U64 frame = _frame.load( std::memory_order_acquire );
+
+    Shard& shard = shardFor( hash );
+    U32 slot = Find( shard, hash, frame );
+    if ( slot != INVALID_SLOT )
+    {
+        return slot;
+    }
+
+    LockGuard<Mutex> s_lock( _slotLock );
+    // Another thread may have inserted the same hash while we were waiting for the lock
+    slot = Find( shard, hash, frame );
+    if ( slot != INVALID_SLOT )
+    {
+        return slot;
+    }
+
+    bool grew = false;
+    slot = acquireSlotLocked( frame, grew );
+    _slotHashes[slot] = hash;
+    _evictionQueue.push_back( slot );
+    {
+        LockGuard<SharedMutex> w_lock( shard._lock );
+        shard._entries[hash] = Entry{ ._slot = slot, ._lastUsedFrame = frame };
+    }
+
+    onInsert( slot, grew );
+    return slot;
+}
+
+} //namespace Divide
+
+#endif //DVD_MATERIAL_SLOT_CACHE_H_
@@ -162,6 +162,8 @@ private:
 
     static void PostCullNodes(const NodeCullParams& params, U16 cullFlags, U32 filterMask, VisibleNodeList<>& nodesInOut);
     static void FrustumCullNode(SceneGraphNode* currentNode, const NodeCullParams& params, U16 cullFlags, U8 recursionLevel, VisibleNodeList<>& nodes);
+    /// Alternative to the recursive FrustumCullNode walk: tests the nodes returned by the scene graph's flat culling index instead
+    static void FrustumCullSpatialIndex(const NodeCullParams& params, U16 cullFlags, const SceneGraph& sceneGraph, PlatformContext& context, VisibleNodeList<>& nodesOut);
 };
 
 }  // namespace Divide
@@ -34,6 +34,7 @@
 #define DVD_RENDER_PASS_EXECUTOR_H_
 
 #include "NodeBufferedData.h"
+#include "MaterialSlotCache.h"
 #include "RenderPass.h"
 #include "RenderBin.h"
 #include "ECS/Components/Headers/RenderingComponent.h"
@@ -75,15 +76,6 @@ public:
         bool operator==(const BufferUpdateRange&) const = default;
     };
 
-    struct MaterialLookupInfo
-    {
-        // Remove materials that haven't been indexed in this amount of frames to make space for new ones
-        static constexpr size_t MAX_FRAME_LIFETIME = 6u;
-
-        size_t _hash{ INVALID_MAT_HASH };
-        size_t _framesSinceLastUsed{ MAX_FRAME_LIFETIME };
-    };
-
     template<typename T, size_t COUNT, typename FREE_LIST_TYPE>
     struct PerNodeData
     {
@@ -96,7 +88,14 @@ public:
 
     using BufferTransformData = PerNodeData<NodeTransformData, Config::MAX_VISIBLE_NODES, bool>;
     using BufferIndirectionData = PerNodeData<NodeIndirectionData, Config::MAX_VISIBLE_NODES, bool>;
-    using BufferMaterialData = PerNodeData<NodeMaterialData, Config::MAX_CONCURRENT_MATERIALS, MaterialLookupInfo>;
+
+    struct BufferMaterialData
+    {
+        using DataContainer = eastl::fixed_vector<NodeMaterialData, Config::MAX_CONCURRENT_MATERIALS, true>;
+        DataContainer _gpuData{};
+
+        MaterialSlotCache _slotCache;
+    };
 
     template<typename DataContainer>
     struct ExecutorBuffer
@@ -0,0 +1,116 @@
+
+
+#include "Headers/MaterialSlotCache.h"
+
+namespace Divide
+{
+
+void MaterialSlotCache::reset( const U32 slotCount )
+{
+    LockGuard<Mutex> s_lock( _slotLock );
+    for ( Shard& shard : _shards )
+    {
+        LockGuard<SharedMutex> w_lock( shard._lock );
+        shard._entries.clear();
+    }
+
+    _slotHashes.clear();
+    _slotHashes.resize( slotCount, INVALID_HASH );
+    _freeSlots.resize( slotCount );
+    // Hand out low slots first to keep the GPU update ranges tight
+    for ( U32 i = 0u; i < slotCount; ++i )
+    {
+        _freeSlots[i] = slotCount - i - 1u;
+    }
+    _evictionQueue.clear();
+    _exhaustedFrame = U64_MAX;
+}
+
+void MaterialSlotCache::onFrameEnd() noexcept
+{
+    _frame.fetch_add( 1u, std::memory_order_acq_rel );
+}
+
+U32 MaterialSlotCache::find( const size_t hash )
+{
+    return Find( shardFor( hash ), hash, _frame.load( std::memory_order_acquire ) );
+}
+
+size_t MaterialSlotCache::size() const
+{
+    LockGuard<Mutex> s_lock( _slotLock );
+    return _evictionQueue.size();
+}
+
+size_t MaterialSlotCache::slotCount() const
+{
+    LockGuard<Mutex> s_lock( _slotLock );
+    return _slotHashes.size();
+}
+
+MaterialSlotCache::Shard& MaterialSlotCache::shardFor( const size_t hash ) noexcept
+{
+    // Material hashes are well distributed, but fold in the high bits anyway in case a weaker hash is ever used
+    return _shards[(hash ^ (hash >> 32u)) % SHARD_COUNT];
+}
+
+U32 MaterialSlotCache::Find( Shard& shard, const size_t hash, const U64 frame )
+{
+    SharedLock<SharedMutex> r_lock( shard._lock );
+    const auto it = shard._entries.find( hash );
+    if ( it == shard._entries.end() )
+    {
+        return INVALID_SLOT;
+    }
+
+    std::atomic_ref<U64>( it->second._lastUsedFrame ).store( frame, std::memory_order_relaxed );
+    return it->second._slot;
+}
+
+U32 MaterialSlotCache::acquireSlotLocked( const U64 frame, bool& grewOut )
+{
+    grewOut = false;
+
+    if ( !_freeSlots.empty() )
+    {
+        const U32 slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        return slot;
+    }
+
+    if ( _exhaustedFrame != frame )
+    {
+        // Second chance eviction: entries that were used recently go to the back of the queue.
+        // After a full pass without finding anything, stop looking until the next frame.
+        for ( size_t checked = 0u, count = _evictionQueue.size(); checked < count; ++checked )
+        {
+            const U32 slot = _evictionQueue.front();
+            _evictionQueue.pop_front();
+
+            const size_t hash = _slotHashes[slot];
+            Shard& shard = shardFor( hash );
+
+            LockGuard<SharedMutex> w_lock( shard._lock );
+            const auto it = shard._entries.find( hash );
+            DIVIDE_ASSERT( it != shard._entries.end() && it->second._slot == slot );
+
+            if ( std::atomic_ref<U64>( it->second._lastUsedFrame ).load( std::memory_order_relaxed ) + MAX_FRAME_LIFETIME <= frame )
+            {
+                shard._entries.erase( it );
+                _slotHashes[slot] = INVALID_HASH;
+                return slot;
+            }
+
+            _evictionQueue.push_back( slot );
+        }
+
+        _exhaustedFrame = frame;
+    }
+
+    // Every slot is in use, so grow
+    grewOut = true;
+    _slotHashes.push_back( INVALID_HASH );
+    return to_U32( _slotHashes.size() - 1u );
+}
+
+} //namespace Divide
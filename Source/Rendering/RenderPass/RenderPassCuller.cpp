@@ -18,6 +18,26 @@ namespace Divide
     namespace
     {
         constexpr U32 g_nodesPerCullingPartition = 8u;
+        // No recursion when culling via the spatial index, so partitions can be a lot bigger
+        constexpr U32 g_candidatesPerCullingPartition = 64u;
+
+        [[nodiscard]] bool IsIgnored( const SceneGraphNode* node, const NodeCullParams& params ) noexcept
+        {
+            // The hierarchy walk skips the children of ignored nodes as well, so check every ancestor
+            for ( const SceneGraphNode* crtNode = node; crtNode != nullptr; crtNode = crtNode->parent() )
+            {
+                const I64 nodeGUID = crtNode->getGUID();
+                for ( size_t i = 0u; i < params._ignoredGUIDS._count; ++i )
+                {
+                    if ( nodeGUID == params._ignoredGUIDS._guids[i] )
+                    {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
     }
 
     [[nodiscard]] inline U32 RenderPassCuller::FilterMask(const PlatformContext& context) noexcept
@@ -83,27 +103,34 @@ namespace Divide
                 }
             }
 
-            const SceneGraphNode::ChildContainer& rootChildren = sceneGraph.getRoot()->getChildren();
+            if ( context.config().rendering.spatialIndexCulling )
+            {
+                FrustumCullSpatialIndex( params, cullFlags, sceneGraph, context, nodesOut );
+            }
+            else
+            {
+                const SceneGraphNode::ChildContainer& rootChildren = sceneGraph.getRoot()->getChildren();
 
-            SharedLock<SharedMutex> r_lock( rootChildren._lock );
-            Parallel_For
-            (
-                context.taskPool( TaskPoolType::RENDERER ),
-                ParallelForDescriptor
-                {
-                    ._iterCount = rootChildren._count,
-                    ._partitionSize = g_nodesPerCullingPartition,
-                    ._priority = TaskPriority::DONT_CARE,
-                    ._useCurrentThread = true
-                },
-                [&]( const Task*, const U32 start, const U32 end )
-                {
-                    for ( U32 i = start; i < end; ++i )
+                SharedLock<SharedMutex> r_lock( rootChildren._lock );
+                Parallel_For
+                (
+                    context.taskPool( TaskPoolType::RENDERER ),
+                    ParallelForDescriptor
                     {
-                        FrustumCullNode( rootChildren._data[i], params, cullFlags, 0u, nodesOut );
+                        ._iterCount = rootChildren._count,
+                        ._partitionSize = g_nodesPerCullingPartition,
+                        ._priority = TaskPriority::DONT_CARE,
+                        ._useCurrentThread = true
+                    },
+                    [&]( const Task*, const U32 start, const U32 end )
+                    {
+                        for ( U32 i = start; i < end; ++i )
+                        {
+                            FrustumCullNode( rootChildren._data[i], params, cullFlags, 0u, nodesOut );
+                        }
                     }
-                }
-            );
+                );
+            }
         }
 
         PostCullNodes( params, cullFlags, FilterMask( context ), nodesOut );
@@ -171,6 +198,47 @@ namespace Divide
         }
     }
 
+    void RenderPassCuller::FrustumCullSpatialIndex( const NodeCullParams& params, const U16 cullFlags, const SceneGraph& sceneGraph, PlatformContext& context, VisibleNodeList<>& nodesOut )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+        NO_DESTROY thread_local vector<SceneGraphNode*> candidates;
+        candidates.resize( 0 );
+
+        const bool frustumCull = cullFlags & to_base( CullOptions::CULL_AGAINST_FRUSTUM );
+        sceneGraph.cullingIndex().gatherCandidates( frustumCull ? params._frustum : nullptr, candidates );
+
+        Parallel_For
+        (
+            context.taskPool( TaskPoolType::RENDERER ),
+            ParallelForDescriptor
+            {
+                ._iterCount = to_U32( candidates.size() ),
+                ._partitionSize = g_candidatesPerCullingPartition,
+                ._priority = TaskPriority::DONT_CARE,
+                ._useCurrentThread = true
+            },
+            [&]( const Task*, const U32 start, const U32 end )
+            {
+                for ( U32 i = start; i < end; ++i )
+                {
+                    SceneGraphNode* node = candidates[i];
+                    if ( params._ignoredGUIDS._count > 0u && IsIgnored( node, params ) )
+                    {
+                        continue;
+                    }
+
+                    // The index only narrows things down. Every candidate still goes through the same test the hierarchy walk uses
+                    F32 distanceSqToCamera = 0.0f;
+                    if ( Attorney::SceneGraphNodeRenderPassCuller::frustumCullNode( node, params, cullFlags, distanceSqToCamera ) != FrustumCollision::FRUSTUM_OUT )
+                    {
+                        nodesOut.append( { node, distanceSqToCamera } );
+                    }
+                }
+            }
+        );
+    }
+
     void RenderPassCuller::FrustumCull( const PlatformContext& context, const NodeCullParams& params, const U16 cullFlags, const vector<SceneGraphNode*>& nodes, VisibleNodeList<>& nodesOut )
     {
         PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
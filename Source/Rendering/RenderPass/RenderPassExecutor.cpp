@@ -122,15 +122,25 @@ namespace Divide
             return executorBuffer._nodeProcessedThisFrame.insert(indirectionIDX).second;
         }
 
+        template<typename T, size_t COUNT, typename FREE_LIST_TYPE>
+        void ResetData( RenderPassExecutor::PerNodeData<T, COUNT, FREE_LIST_TYPE>& data )
+        {
+            LockGuard<SharedMutex> w_lock(data._freeListLock);
+            data._freeList.clear();
+            data._gpuData.clear();
+        }
+
+        void ResetData( RenderPassExecutor::BufferMaterialData& data )
+        {
+            data._slotCache.reset(0u);
+            data._gpuData.clear();
+        }
+
         template<typename DataContainer>
         void Reset(ExecutorBuffer<DataContainer>& executorBuffer)
         {
             executorBuffer._gpuBuffer.reset();
-            {
-                LockGuard<SharedMutex> w_lock(executorBuffer._data._freeListLock);
-                executorBuffer._data._freeList.clear();
-                executorBuffer._data._gpuData.clear();
-            }
+            ResetData(executorBuffer._data);
             {
                 LockGuard<SharedMutex> w_lock(executorBuffer._rangeLock);
                 executorBuffer._updateRange.reset();
@@ -191,7 +201,7 @@ namespace Divide
         s_transformBuffer._data._gpuData.resize(Config::MAX_VISIBLE_NODES);
         s_transformBuffer._data._freeList.resize(Config::MAX_VISIBLE_NODES, true);
         s_materialBuffer._data._gpuData.resize(Config::MAX_CONCURRENT_MATERIALS);
-        s_materialBuffer._data._freeList.resize(Config::MAX_CONCURRENT_MATERIALS);
+        s_materialBuffer._data._slotCache.reset(Config::MAX_CONCURRENT_MATERIALS);
         ResizeGPUBuffers(gfx, Config::MAX_VISIBLE_NODES, Config::MAX_VISIBLE_NODES, Config::MAX_CONCURRENT_MATERIALS);
     }
 
@@ -241,10 +251,7 @@ namespace Divide
         }
         {
             PROFILE_SCOPE("Increment Lifetime", Profiler::Category::Scene);
-            for (auto& it : s_materialBuffer._data._freeList)
-            {
-                it._framesSinceLastUsed += (it._hash != INVALID_MAT_HASH) ? 1u : 0u;
-            }
+            s_materialBuffer._data._slotCache.onFrameEnd();
         }
     }
 
@@ -382,7 +389,8 @@ namespace Divide
             AnimEvaluator::FrameIndex frameIndex{};
             const AnimationComponent* animComp = node->get<AnimationComponent>();
             const U8 boneCount = animComp->boneCount();
-            if ( animComp->playAnimations() )
+            // Sampled poses are uploaded per instance, so their bone buffer only ever holds a single frame
+            if ( animComp->playAnimations() && !animComp->samplesPose() )
             {
                 frameIndex = animComp->frameIndex();
             }
@@ -451,96 +459,34 @@ namespace Divide
         // Match materials
         const size_t materialHash = HashMaterialData( tempData );
 
-        {// Try and match an existing material
-            SharedLock<SharedMutex> r_lock( s_materialBuffer._data._freeListLock);
-            PROFILE_SCOPE( "processVisibleNode - try match material", Profiler::Category::Scene );
-
-            // Usually, the material doesn't change, so check that first
-            if (materialIDX != NodeIndirectionData::INVALID_IDX &&
-                s_materialBuffer._data._freeList[materialIDX]._hash == materialHash)
-            {
-                materialIDXOut = materialIDX;
-                return ret;
-            }
-
-            auto& infoContainer = s_materialBuffer._data._freeList;
-            // Otherwise, we have an updated material, so try to match against a different one first
-            for ( size_t idx = 0u; idx < infoContainer.size(); ++idx )
-            {
-                auto& [hash, framesSinceLastUsed ] = infoContainer[idx];
-                if ( hash == materialHash )
-                {
-                    framesSinceLastUsed = 0u;
-                    Attorney::RenderingCompRenderPassExecutor::setMaterialIDX(rComp, to_U32(idx));
-                    materialIDXOut = materialIDX;
-
-                    ret._updateIndirection = true;
-                    s_indirectionBuffer._data._gpuData[indirectionIDXOut]._materialIDX = materialIDX;
-                    return ret;
-                }
-            }
-        }
-
-        // If we fail, try and find an empty slot and update it
-        PROFILE_SCOPE( "processVisibleNode - process unmatched material", Profiler::Category::Scene );
-
-        LockGuard<SharedMutex> w_lock(s_materialBuffer._data._freeListLock);
-        materialIDX = NodeIndirectionData::INVALID_IDX;
-
-        auto& infoContainer = s_materialBuffer._data._freeList;
-        // No match found (cache miss) so try again and add a new entry if we still fail
-        for ( size_t idx = 0u; idx < infoContainer.size(); ++idx )
-        {
-            auto& entry = infoContainer[idx];
-            if (entry._hash == materialHash)
-            {
-                entry._framesSinceLastUsed = 0u;
-                materialIDX = to_U32(idx);
-                break;
-            }
-        }
+        PROFILE_SCOPE( "processVisibleNode - match material", Profiler::Category::Scene );
 
-        // Cache miss
-        if (materialIDX == NodeIndirectionData::INVALID_IDX)
+        BufferMaterialData& materialData = s_materialBuffer._data;
+        const U32 matchedIDX = materialData._slotCache.findOrInsert( materialHash, [&materialData, &tempData, &ret]( const U32 slot, const bool grew )
         {
-            for (size_t idx = 0u; idx < infoContainer.size(); ++idx )
-            {
-                auto& entry = infoContainer[idx];
-                if (entry._hash == INVALID_MAT_HASH ||
-                    entry._framesSinceLastUsed >= MaterialLookupInfo::MAX_FRAME_LIFETIME)
-                {
-                    // ... in which case our current idx is what we are looking for ...
-                    entry._hash = materialHash;
-                    entry._framesSinceLastUsed = 0u;
-                    materialIDX = to_U32(idx);
-                    break;
-                }
-            }
-
-            // Cache miss + resize required
-            if (materialIDX == NodeIndirectionData::INVALID_IDX)
+            // Cache miss. Runs under the cache's insertion lock, so resizing the data container here is safe
+            if ( grew )
             {
-                materialIDX = to_U32(s_materialBuffer._data._freeList.size());
-                s_materialBuffer._data._freeList.emplace_back(MaterialLookupInfo
-                {
-                    ._hash = materialHash,
-                    ._framesSinceLastUsed = 0u
-                });
+                materialData._gpuData.resize( slot + 1u );
                 s_resizeBufferQueued = true;
             }
 
-            DIVIDE_ASSERT( materialIDX != NodeIndirectionData::INVALID_IDX );
-
+            materialData._gpuData[slot] = tempData;
             ret._updateBuffer = true;
-            s_materialBuffer._data._gpuData[materialIDX] = tempData;
-        }
+        });
 
-        Attorney::RenderingCompRenderPassExecutor::setMaterialIDX(rComp, materialIDX);
+        DIVIDE_ASSERT( matchedIDX != MaterialSlotCache::INVALID_SLOT );
 
-        ret._updateIndirection = true;
-        s_indirectionBuffer._data._gpuData[indirectionIDXOut]._materialIDX = materialIDX;
+        materialIDXOut = matchedIDX;
 
-        materialIDXOut = materialIDX;
+        // Usually, the material doesn't change, so the node already points to the right slot
+        if ( matchedIDX != materialIDX )
+        {
+            Attorney::RenderingCompRenderPassExecutor::setMaterialIDX(rComp, matchedIDX);
+
+            ret._updateIndirection = true;
+            s_indirectionBuffer._data._gpuData[indirectionIDXOut]._materialIDX = matchedIDX;
+        }
 
         return ret;
     }
@@ -12,6 +12,7 @@
 #include "Editor/Headers/Editor.h"
 
 #include "Managers/Headers/ProjectManager.h"
+#include "Networking/Headers/Client.h"
 #include "Rendering/Camera/Headers/Camera.h"
 #include "Rendering/Headers/Renderer.h"
 #include "Rendering/PostFX/Headers/PostFX.h"
@@ -1571,6 +1572,14 @@ namespace Divide
         sceneRuntimeUS( sceneRuntimeUS() + deltaTimeUS );
 
         updateSceneStateInternal( deltaTimeUS );
+
+        // The server only replicates entities around us. Anything past the far plane can't be seen anyway
+        if ( const Camera* camera = playerCamera( 0u ); camera != nullptr )
+        {
+            const CameraSnapshot& snapshot = camera->snapshot();
+            _context.networking().client().updateInterest( snapshot._eye, snapshot._zPlanes.max );
+        }
+
         _state->waterBodies().resize(0);
         _sceneGraph->sceneUpdate( deltaTimeUS, *_state );
         _aiManager->update( deltaTimeUS );
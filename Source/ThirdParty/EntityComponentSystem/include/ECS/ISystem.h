@@ -13,6 +13,7 @@
 #define ECS__I_SYSTEM_H__
 
 #include "API.h"
+#include "IComponent.h"
 
 namespace ECS
 {
@@ -23,6 +24,9 @@ namespace ECS
 
 	using SystemPriority = u16;
 
+	// List of component types a system touches during its update stages. Used to decide which systems may run concurrently.
+	using ComponentAccessList = eastl::vector<ComponentTypeId>;
+
 
 	static const SystemTypeId INVALID_SYSTEMID				= INVALID_TYPE_ID;
 
@@ -65,12 +69,21 @@ namespace ECS
 
 		u8						m_Enabled		: 1;
 		u8						m_NeedsUpdate	: 1;
-		u8						m_Reserved		: 6;
+		/// Summary:	Set once the system declared which component types it reads (possibly none).
+		u8						m_AccessDeclared	: 1;
+		u8						m_Reserved		: 5;
+
+		ComponentAccessList		m_ReadComponents;
+		ComponentAccessList		m_WriteComponents;
 
 	protected:
 
 		ISystem(SystemPriority priority = NORMAL_SYSTEM_PRIORITY, f32 updateInterval_ms = -1.0f);
 
+		void DeclareComponentAccess();
+		void DeclareComponentRead(ComponentTypeId componentTypeId);
+		void DeclareComponentWrite(ComponentTypeId componentTypeId);
+
 	public:
 
 		virtual ~ISystem();
@@ -86,6 +99,22 @@ namespace ECS
 
 		virtual ISystemSerializer& GetSerializer() = 0;
 		virtual const ISystemSerializer& GetSerializer() const = 0;
+
+		inline const ComponentAccessList& GetReadComponents() const { return m_ReadComponents; }
+		inline const ComponentAccessList& GetWriteComponents() const { return m_WriteComponents; }
+
+		/// Summary:	False if the system never declared its component reads. Such a system may touch anything,
+		/// so schedulers must not update it concurrently with any other system.
+		inline bool HasDeclaredComponentAccess() const { return m_AccessDeclared; }
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	bool ISystem::ConflictsWith(const ISystem& other) const;
+		///
+		/// Summary:	Returns true if this system and other can't safely update at the same time, i.e. one of them
+		/// writes a component type that the other one reads or writes.
+		///-------------------------------------------------------------------------------------------------
+
+		bool ConflictsWith(const ISystem& other) const;
 	};
 }
 
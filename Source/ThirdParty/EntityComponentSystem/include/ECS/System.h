@@ -84,6 +84,22 @@ namespace ECS
 			this->m_SystemManagerInstance->AddSystemDependency(this, std::forward<Dependencies>(dependencies)...);
 		}
 
+		// Declares the component types this system only reads during its update stages. ReadsComponents<>() declares that it reads
+		// nothing besides what it writes. Systems that never call this are updated exclusively by parallel schedulers
+		template<class... Components>
+		void ReadsComponents()
+		{
+			this->DeclareComponentAccess();
+			(this->DeclareComponentRead(Components::STATIC_COMPONENT_TYPE_ID), ...);
+		}
+
+		// Declares the component types this system modifies during its update stages
+		template<class... Components>
+		void WritesComponents()
+		{
+			(this->DeclareComponentWrite(Components::STATIC_COMPONENT_TYPE_ID), ...);
+		}
+
 		virtual void PreUpdate( [[maybe_unused]] f32 dt ) override
 		{}
 
@@ -26,6 +26,34 @@ namespace ECS
 {
 	using SystemWorkStateMask	= eastl::vector<bool>;
 
+	enum class SystemStage : u8
+	{
+		PRE_UPDATE = 0,
+		UPDATE,
+		POST_UPDATE,
+		COUNT
+	};
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	ISystemScheduler
+	///
+	/// Summary:	Optional replacement for the serial system loop. Once set on the system manager, every update
+	/// stage is handed to the scheduler, which must call SystemManager::UpdateSystem once per system in an order
+	/// that respects the dependency matrix. Systems without a dependency between them may be updated concurrently.
+	///-------------------------------------------------------------------------------------------------
+
+	class ECS_API ISystemScheduler
+	{
+	public:
+
+		virtual ~ISystemScheduler() = default;
+
+		virtual void RunStage(SystemStage stage, f32 dt_ms) = 0;
+
+		// Called when the scheduler is set and every time the system work order gets rebuilt
+		virtual void OnSystemWorkOrderChanged() = 0;
+	};
+
 
 	class ECS_API SystemManager : Memory::GlobalMemoryUser
 	{
@@ -33,6 +61,10 @@ namespace ECS
 
 		DECLARE_LOGGER
 
+	public:
+
+		using SystemWorkOrder	= eastl::vector<ISystem*>;
+
 	private:
 
 		using SystemDependencyMatrix = eastl::vector<eastl::vector<bool>>;
@@ -40,8 +72,6 @@ namespace ECS
 		using SystemRegistry	= eastl::unordered_map<u64, ISystem*>;
 		using SystemAllocator	= Memory::Allocator::LinearAllocator;
 
-		using SystemWorkOrder	= eastl::vector<ISystem*>;
-
 		SystemAllocator*		m_SystemAllocator;
 
 		SystemRegistry			m_Systems;
@@ -50,6 +80,8 @@ namespace ECS
 
 		SystemWorkOrder			m_SystemWorkOrder;
 
+		ISystemScheduler*		m_SystemScheduler;
+
 		// This class is not inteeded to be initialized
 		SystemManager(const SystemManager&) = delete;
 		SystemManager& operator=(SystemManager&) = delete;	
@@ -211,6 +243,34 @@ namespace ECS
 
 		void UpdateSystemWorkOrder();
 
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void SystemManager::SetSystemScheduler(ISystemScheduler* scheduler);
+		///
+		/// Summary:	Hands all future update stages to the specified scheduler. Pass nullptr to go back to
+		/// updating every system serially, in work order. The scheduler must outlive its registration.
+		///-------------------------------------------------------------------------------------------------
+
+		void SetSystemScheduler(ISystemScheduler* scheduler);
+
+		inline const SystemWorkOrder& GetSystemWorkOrder() const { return this->m_SystemWorkOrder; }
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	bool SystemManager::HasSystemDependency(const ISystem* target, const ISystem* dependency) const;
+		///
+		/// Summary:	Returns true if target was registered as depending directly on dependency.
+		///-------------------------------------------------------------------------------------------------
+
+		bool HasSystemDependency(const ISystem* target, const ISystem* dependency) const;
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void SystemManager::UpdateSystem(ISystem* system, SystemStage stage, f32 dt_ms);
+		///
+		/// Summary:	Runs a single stage for a single system, including the update interval bookkeeping.
+		/// Only touches the specified system's state, so different systems can be updated from different threads.
+		///-------------------------------------------------------------------------------------------------
+
+		void UpdateSystem(ISystem* system, SystemStage stage, f32 dt_ms);
+
 		///-------------------------------------------------------------------------------------------------
 		/// Fn:	template<class T> inline T* SystemManager::GetSystem() const
 		///
@@ -13,10 +13,50 @@ namespace ECS
 	ISystem::ISystem(SystemPriority priority, f32 updateInterval_ms) :
 		m_Priority(priority),
 		m_UpdateInterval(updateInterval_ms),
-		m_Enabled(true)
+		m_Enabled(true),
+		m_AccessDeclared(false)
 	{}
 
 	ISystem::~ISystem()
 	{}
 
+	void ISystem::DeclareComponentAccess()
+	{
+		this->m_AccessDeclared = true;
+	}
+
+	void ISystem::DeclareComponentRead(ComponentTypeId componentTypeId)
+	{
+		if (eastl::find(this->m_ReadComponents.begin(), this->m_ReadComponents.end(), componentTypeId) == this->m_ReadComponents.end())
+			this->m_ReadComponents.push_back(componentTypeId);
+	}
+
+	void ISystem::DeclareComponentWrite(ComponentTypeId componentTypeId)
+	{
+		if (eastl::find(this->m_WriteComponents.begin(), this->m_WriteComponents.end(), componentTypeId) == this->m_WriteComponents.end())
+			this->m_WriteComponents.push_back(componentTypeId);
+	}
+
+	bool ISystem::ConflictsWith(const ISystem& other) const
+	{
+		const auto contains = [](const ComponentAccessList& list, ComponentTypeId componentTypeId)
+		{
+			return eastl::find(list.begin(), list.end(), componentTypeId) != list.end();
+		};
+
+		for (ComponentTypeId componentTypeId : this->m_WriteComponents)
+		{
+			if (contains(other.m_WriteComponents, componentTypeId) || contains(other.m_ReadComponents, componentTypeId))
+				return true;
+		}
+
+		for (ComponentTypeId componentTypeId : this->m_ReadComponents)
+		{
+			if (contains(other.m_WriteComponents, componentTypeId))
+				return true;
+		}
+
+		return false;
+	}
+
 } // namespace ECS
@@ -15,6 +15,7 @@
 namespace ECS
 {
 	SystemManager::SystemManager()
+		: m_SystemScheduler(nullptr)
 	{
 		DEFINE_LOGGER("SystemManager");
 
@@ -47,18 +48,15 @@ namespace ECS
     {
 		PROFILE_SCOPE_AUTO( Divide::Profiler::Category::GameLogic );
 
+		if (this->m_SystemScheduler != nullptr)
+		{
+			this->m_SystemScheduler->RunStage(SystemStage::PRE_UPDATE, dt_ms);
+			return;
+		}
+
         for (ISystem* system : this->m_SystemWorkOrder)
         {
-            // increase interval since last update
-            system->m_TimeSinceLastUpdate += dt_ms;
-
-            // check systems update state
-            system->m_NeedsUpdate = (system->m_UpdateInterval < 0.0f) || ((system->m_UpdateInterval > 0.0f) && (system->m_TimeSinceLastUpdate > system->m_UpdateInterval));
-
-            if (system->m_Enabled == true && system->m_NeedsUpdate == true)
-            {
-                system->PreUpdate(dt_ms);
-            }
+            this->UpdateSystem(system, SystemStage::PRE_UPDATE, dt_ms);
         }
     }
 
@@ -66,15 +64,15 @@ namespace ECS
     {
 		PROFILE_SCOPE_AUTO( Divide::Profiler::Category::GameLogic );
 
+		if (this->m_SystemScheduler != nullptr)
+		{
+			this->m_SystemScheduler->RunStage(SystemStage::UPDATE, dt_ms);
+			return;
+		}
+
         for (ISystem* system : this->m_SystemWorkOrder)
         {
-            if (system->m_Enabled == true && system->m_NeedsUpdate == true)
-            {
-                system->Update(dt_ms);
-
-                // reset interval
-                system->m_TimeSinceLastUpdate = 0.0f;
-            }
+            this->UpdateSystem(system, SystemStage::UPDATE, dt_ms);
         }
     }
 
@@ -82,14 +80,79 @@ namespace ECS
     {
 		PROFILE_SCOPE_AUTO( Divide::Profiler::Category::GameLogic );
 
+		if (this->m_SystemScheduler != nullptr)
+		{
+			this->m_SystemScheduler->RunStage(SystemStage::POST_UPDATE, dt_ms);
+			return;
+		}
+
 		for (ISystem* system : this->m_SystemWorkOrder)
 		{
-			if (system->m_Enabled == true && system->m_NeedsUpdate == true)
+			this->UpdateSystem(system, SystemStage::POST_UPDATE, dt_ms);
+		}
+	}
+
+	void SystemManager::UpdateSystem(ISystem* system, SystemStage stage, f32 dt_ms)
+	{
+		switch (stage)
+		{
+			case SystemStage::PRE_UPDATE:
 			{
-				system->PostUpdate(dt_ms);
-			}
+				// increase interval since last update
+				system->m_TimeSinceLastUpdate += dt_ms;
+
+				// check systems update state
+				system->m_NeedsUpdate = (system->m_UpdateInterval < 0.0f) || ((system->m_UpdateInterval > 0.0f) && (system->m_TimeSinceLastUpdate > system->m_UpdateInterval));
+
+				if (system->m_Enabled == true && system->m_NeedsUpdate == true)
+				{
+					system->PreUpdate(dt_ms);
+				}
+			} break;
+
+			case SystemStage::UPDATE:
+			{
+				if (system->m_Enabled == true && system->m_NeedsUpdate == true)
+				{
+					system->Update(dt_ms);
+
+					// reset interval
+					system->m_TimeSinceLastUpdate = 0.0f;
+				}
+			} break;
+
+			case SystemStage::POST_UPDATE:
+			{
+				if (system->m_Enabled == true && system->m_NeedsUpdate == true)
+				{
+					system->PostUpdate(dt_ms);
+				}
+			} break;
+
+			default:
+			case SystemStage::COUNT: break;
+		}
+	}
+
+	void SystemManager::SetSystemScheduler(ISystemScheduler* scheduler)
+	{
+		this->m_SystemScheduler = scheduler;
+
+		if (this->m_SystemScheduler != nullptr)
+		{
+			this->m_SystemScheduler->OnSystemWorkOrderChanged();
 		}
 	}
+
+	bool SystemManager::HasSystemDependency(const ISystem* target, const ISystem* dependency) const
+	{
+		const SystemTypeId TARGET_ID = target->GetStaticSystemTypeID();
+		const SystemTypeId DEPEND_ID = dependency->GetStaticSystemTypeID();
+
+		return TARGET_ID < this->m_SystemDependencyMatrix.size() &&
+			   DEPEND_ID < this->m_SystemDependencyMatrix[TARGET_ID].size() &&
+			   this->m_SystemDependencyMatrix[TARGET_ID][DEPEND_ID];
+	}
 	void SystemManager::OnFrameStart()
 	{
 		PROFILE_SCOPE_AUTO( Divide::Profiler::Category::GameLogic );
@@ -226,6 +289,11 @@ namespace ECS
 				}
 			}
 		}
+
+		if (this->m_SystemScheduler != nullptr)
+		{
+			this->m_SystemScheduler->OnSystemWorkOrderChanged();
+		}
 	}
 
 	SystemWorkStateMask SystemManager::GetSystemWorkState() const
@@ -0,0 +1,303 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Geometry/Animations/Headers/AnimationBlendGraph.h"
+#include "Geometry/Animations/Headers/AnimationEvaluator.h"
+#include "Geometry/Animations/Headers/AnimationUtils.h"
+
+#include <iostream>
+
+namespace Divide
+{
+
+namespace
+{
+    constexpr U8 g_limbCount = 4u;
+    constexpr U8 g_bonesPerLimb = 8u;
+    constexpr D64 g_ticksPerSecond = 30.0;
+    constexpr D64 g_duration = 60.0;
+
+    /// Root plus 4 chains. Bind poses are rotated and scaled so that decomposing them actually gets tested
+    Bone_uptr BuildSkeleton()
+    {
+        Bone_uptr root = std::make_unique<Bone>( "root", nullptr );
+
+        U8 boneID = 0u;
+        for ( U8 limb = 0u; limb < g_limbCount; ++limb )
+        {
+            Bone* parent = root.get();
+            for ( U8 i = 0u; i < g_bonesPerLimb; ++i )
+            {
+                Bone* bone = new Bone( Util::StringFormat( "limb_{}_{}", limb, i ), parent );
+                bone->_boneID = boneID++;
+
+                const aiMatrix4x4 bind( aiVector3D( 1.f + 0.1f * limb ),
+                                        aiQuaternion( aiVector3D( 0.f, 1.f, 0.f ), 0.3f * (limb + 1) + 0.1f * i ),
+                                        aiVector3D( 0.f, 0.5f, 0.1f * limb ) );
+                AnimUtils::TransformMatrix( bind, bone->_localTransform );
+                bone->_offsetMatrix.setTranslation( 0.f, -0.5f * (i + 1), 0.f );
+                parent = bone;
+            }
+        }
+
+        return root;
+    }
+
+    /// Every bone except the root rotates around the given axis and bobs up and down
+    vector<AnimationChannel> BuildClip( const aiVector3D& axis, const F32 amplitude )
+    {
+        vector<AnimationChannel> channels;
+        for ( U8 limb = 0u; limb < g_limbCount; ++limb )
+        {
+            for ( U8 i = 0u; i < g_bonesPerLimb; ++i )
+            {
+                AnimationChannel& channel = channels.emplace_back();
+                channel._name = Util::StringFormat( "limb_{}_{}", limb, i );
+                channel._nameKey = _ID( channel._name.c_str() );
+
+                for ( U32 k = 0u; k <= to_U32( g_duration ); k += 5u )
+                {
+                    const F32 phase = to_F32( M_PI_MUL_2 * k / g_duration ) + limb;
+                    channel._positionKeys.push_back( aiVectorKey( to_D64( k ), aiVector3D( 0.f, 0.5f + 0.05f * std::sin( phase ), 0.f ) ) );
+                    channel._rotationKeys.push_back( aiQuatKey( to_D64( k ), aiQuaternion( axis, amplitude * std::sin( phase ) ) ) );
+                }
+            }
+        }
+        return channels;
+    }
+
+    struct TestRig
+    {
+        Bone_uptr _root;
+        AnimationSkeleton _skeleton;
+        vector<CompressedAnimation> _clips;
+
+        TestRig()
+            : _root( BuildSkeleton() )
+        {
+            _skeleton.build( *_root );
+
+            const vector<AnimationChannel> channels[] =
+            {
+                BuildClip( aiVector3D( 1.f, 0.f, 0.f ), 0.8f ),
+                BuildClip( aiVector3D( 0.f, 0.f, 1.f ), 0.5f ),
+                BuildClip( aiVector3D( 0.f, 1.f, 0.f ), 0.2f )
+            };
+
+            for ( const vector<AnimationChannel>& clipChannels : channels )
+            {
+                _clips.emplace_back().build( clipChannels, g_duration, _skeleton, {} );
+            }
+        }
+
+        /// What SceneAnimator::sampleLocalPose does
+        [[nodiscard]] AnimationBlendGraph::ClipSampler sampler() const
+        {
+            return [this]( const U32 animationIndex, const D64 timeS, AnimationPose& pose )
+            {
+                _skeleton.resetPose( pose );
+                _clips[animationIndex].sample( std::fmod( timeS * g_ticksPerSecond, g_duration ), pose );
+            };
+        }
+
+        [[nodiscard]] AnimationPose newPose() const
+        {
+            AnimationPose pose;
+            pose.resize( _skeleton.boneCount(), _skeleton.skinnedBoneCount() );
+            return pose;
+        }
+    };
+
+    F32 MaxDifference( const vector<mat4<F32>>& lhs, const vector<mat4<F32>>& rhs )
+    {
+        F32 ret = 0.f;
+        for ( size_t i = 0u; i < lhs.size(); ++i )
+        {
+            for ( U8 e = 0u; e < 16u; ++e )
+            {
+                ret = std::max( ret, std::abs( lhs[i].mat[e] - rhs[i].mat[e] ) );
+            }
+        }
+        return ret;
+    }
+
+    /// Evaluates a single clip through a graph, for reference
+    void EvaluateClip( const TestRig& rig, const U32 animationIndex, const D64 timeS, AnimationPose& poseOut )
+    {
+        AnimationBlendGraph graph;
+        [[maybe_unused]] const U16 clip = graph.addClip( animationIndex );
+
+        vector<AnimationPose> scratch;
+        graph.evaluate( rig._skeleton, timeS, rig.sampler(), scratch, poseOut );
+        rig._skeleton.computeSkinning( poseOut );
+    }
+}
+
+TEST_CASE( "Animation Blend Graph Test", "[animation]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    const TestRig rig;
+    constexpr D64 timeS = 0.77;
+
+    // The decomposed bind pose must rebuild the exact same matrices as the original bind transforms
+    AnimationPose bindPose = rig.newPose();
+    rig._skeleton.resetPose( bindPose );
+    rig._skeleton.computeSkinning( bindPose );
+    const vector<mat4<F32>> bindSkinning = bindPose._skinning;
+    eastl::fill( bindPose._animated.begin(), bindPose._animated.end(), to_U8( 1u ) );
+    rig._skeleton.computeSkinning( bindPose );
+    CHECK_TRUE( MaxDifference( bindSkinning, bindPose._skinning ) < 1e-4f );
+
+    AnimationPose clipA = rig.newPose(), clipB = rig.newPose(), result = rig.newPose();
+    EvaluateClip( rig, 0u, timeS, clipA );
+    EvaluateClip( rig, 1u, timeS, clipB );
+    CHECK_TRUE( MaxDifference( clipA._skinning, clipB._skinning ) > 0.1f );
+
+    vector<AnimationPose> scratch;
+
+    // Blend: the end points match the inputs
+    AnimationBlendGraph graph;
+    const U16 from = graph.addClip( 0u );
+    const U16 to = graph.addClip( 1u );
+    const U16 blend = graph.addBlend( from, to, 0.f );
+
+    graph.evaluate( rig._skeleton, timeS, rig.sampler(), scratch, result );
+    rig._skeleton.computeSkinning( result );
+    CHECK_TRUE( MaxDifference( result._skinning, clipA._skinning ) < 1e-5f );
+
+    graph.node( blend )._weight = 1.f;
+    graph.evaluate( rig._skeleton, timeS, rig.sampler(), scratch, result );
+    rig._skeleton.computeSkinning( result );
+    CHECK_TRUE( MaxDifference( result._skinning, clipB._skinning ) < 1e-5f );
+
+    // Half way: every rotation sits in between the two inputs
+    graph.node( blend )._weight = 0.5f;
+    graph.evaluate( rig._skeleton, timeS, rig.sampler(), scratch, result );
+    bool halfWay = true;
+    for ( size_t i = 0u; i < rig._skeleton.boneCount(); ++i )
+    {
+        const F32 dotA = result._rotX[i] * scratch[from]._rotX[i] + result._rotY[i] * scratch[from]._rotY[i] + result._rotZ[i] * scratch[from]._rotZ[i] + result._rotW[i] * scratch[from]._rotW[i];
+        const F32 dotB = result._rotX[i] * scratch[to]._rotX[i] + result._rotY[i] * scratch[to]._rotY[i] + result._rotZ[i] * scratch[to]._rotZ[i] + result._rotW[i] * scratch[to]._rotW[i];
+        halfWay = halfWay && COMPARE_TOLERANCE( std::abs( dotA ), std::abs( dotB ), 1e-4f );
+    }
+    CHECK_TRUE( halfWay );
+
+    // Mask: limb 1 plays the second clip, everything else the first one
+    graph.clear();
+    AnimationBoneMask upperBody;
+    upperBody.set( rig._skeleton, _ID( "limb_1_0" ), 1.f );
+    const U16 mask = graph.addBoneMask( MOV( upperBody ) );
+    [[maybe_unused]] const U16 masked = graph.addMask( graph.addClip( 0u ), graph.addClip( 1u ), mask );
+
+    graph.evaluate( rig._skeleton, timeS, rig.sampler(), scratch, result );
+    rig._skeleton.computeSkinning( result );
+
+    bool maskRespected = true;
+    for ( U8 limb = 0u; limb < g_limbCount; ++limb )
+    {
+        const AnimationPose& expected = limb == 1u ? clipB : clipA;
+        for ( U8 i = 0u; i < g_bonesPerLimb; ++i )
+        {
+            const U8 boneID = limb * g_bonesPerLimb + i;
+            maskRespected = maskRespected && MaxDifference( { result._skinning[boneID] }, { expected._skinning[boneID] } ) < 1e-5f;
+        }
+    }
+    CHECK_TRUE( maskRespected );
+
+    // Additive: adding a layer on top of itself (as the reference) changes nothing
+    graph.clear();
+    const U16 base = graph.addClip( 0u );
+    const U16 layer = graph.addClip( 2u );
+    [[maybe_unused]] const U16 additive = graph.addAdditive( base, layer, layer );
+    graph.evaluate( rig._skeleton, timeS, rig.sampler(), scratch, result );
+    rig._skeleton.computeSkinning( result );
+    CHECK_TRUE( MaxDifference( result._skinning, clipA._skinning ) < 1e-4f );
+
+    // Additive on top of its own reference pose gives back the layer
+    graph.clear();
+    const U16 layerAtTime = graph.addClip( 2u );
+    const U16 reference = graph.addClip( 2u, 0.f );
+    [[maybe_unused]] const U16 restored = graph.addAdditive( reference, layerAtTime, reference );
+    graph.evaluate( rig._skeleton, timeS, rig.sampler(), scratch, result );
+    rig._skeleton.computeSkinning( result );
+
+    AnimationPose clipC = rig.newPose();
+    EvaluateClip( rig, 2u, timeS, clipC );
+    CHECK_TRUE( MaxDifference( result._skinning, clipC._skinning ) < 1e-4f );
+}
+
+TEST_CASE( "Animation Blend Graph Speed Test", "[animation]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool pool( "BLEND_GRAPH_TEST" );
+    const bool init = pool.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    constexpr size_t instanceCount = 1'024u;
+
+    const TestRig rig;
+    const AnimationBlendGraph::ClipSampler sampler = rig.sampler();
+
+    // Cross-fade between two clips with an additive layer on top of the upper body: what a crowd agent would typically run
+    AnimationBlendGraph graph;
+    AnimationBoneMask upperBody;
+    upperBody.set( rig._skeleton, _ID( "limb_0_0" ), 1.f );
+    upperBody.set( rig._skeleton, _ID( "limb_1_0" ), 1.f );
+    const U16 mask = graph.addBoneMask( MOV( upperBody ) );
+    const U16 fade = graph.addBlend( graph.addClip( 0u ), graph.addClip( 1u, 1.2f ), 0.3f );
+    const U16 layered = graph.addAdditive( fade, graph.addClip( 2u ), graph.addClip( 2u, 0.f ), 0.5f );
+    [[maybe_unused]] const U16 output = graph.addMask( fade, layered, mask );
+
+    vector<AnimationPose> poses( instanceCount );
+    vector<vector<AnimationPose>> scratch( instanceCount );
+    for ( AnimationPose& pose : poses )
+    {
+        pose = rig.newPose();
+    }
+
+    const auto evaluateInstances = [&]( const U32 start, const U32 end )
+    {
+        for ( U32 i = start; i < end; ++i )
+        {
+            graph.evaluate( rig._skeleton, i * 0.01, sampler, scratch[i], poses[i] );
+            rig._skeleton.computeSkinning( poses[i] );
+        }
+    };
+
+    // Warm up: allocates the scratch poses
+    evaluateInstances( 0u, to_U32( instanceCount ) );
+    const vector<mat4<F32>> serialResult = poses.back()._skinning;
+
+    const D64 serialStart = Time::App::ElapsedMicroseconds();
+    evaluateInstances( 0u, to_U32( instanceCount ) );
+    const D64 serialDurationUS = Time::App::ElapsedMicroseconds() - serialStart;
+
+    const D64 parallelStart = Time::App::ElapsedMicroseconds();
+    Parallel_For( pool,
+                  ParallelForDescriptor
+                  {
+                      ._iterCount = to_U32( instanceCount ),
+                      ._partitionSize = 16u
+                  },
+                  [&evaluateInstances]( const Task*, const U32 start, const U32 end )
+                  {
+                      evaluateInstances( start, end );
+                  } );
+    const D64 parallelDurationUS = Time::App::ElapsedMicroseconds() - parallelStart;
+
+    CHECK_TRUE( MaxDifference( serialResult, poses.back()._skinning ) < 1e-6f );
+
+    std::cout << Util::StringFormat( "Blend graph speed test [ {} instances, {} bones, {} nodes ]: serial {:.2f} us/instance, task pool {:.2f} us/instance",
+                                     instanceCount,
+                                     rig._skeleton.boneCount(),
+                                     graph.nodeCount(),
+                                     serialDurationUS / instanceCount,
+                                     parallelDurationUS / instanceCount ) << std::endl;
+
+    pool.shutdown();
+}
+
+} //namespace Divide
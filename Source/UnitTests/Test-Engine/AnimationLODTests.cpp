@@ -0,0 +1,239 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "ECS/Systems/Headers/AnimationSystem.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+TEST_CASE( "Animation LoD Policy Test", "[animation]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    AnimationLODPolicy policy{};
+    policy._enabled = true;
+    policy._distanceThresholds = { 10u, 50u };
+    policy._reducedBoneDepth = 3u;
+
+    CHECK_EQUAL( policy.tier( true, 0.f ), AnimationLODTier::FULL );
+    CHECK_EQUAL( policy.tier( true, SQUARED( 10.f ) ), AnimationLODTier::FULL );
+    CHECK_EQUAL( policy.tier( true, SQUARED( 11.f ) ), AnimationLODTier::HALF_RATE );
+    CHECK_EQUAL( policy.tier( true, SQUARED( 51.f ) ), AnimationLODTier::QUARTER_RATE );
+    CHECK_EQUAL( policy.tier( false, 0.f ), AnimationLODTier::INVISIBLE );
+
+    CHECK_EQUAL( policy.maxBoneDepth( AnimationLODTier::FULL ), U8_MAX );
+    CHECK_EQUAL( policy.maxBoneDepth( AnimationLODTier::QUARTER_RATE ), 3u );
+    CHECK_EQUAL( policy.maxBoneDepth( AnimationLODTier::INVISIBLE ), U8_MAX );
+
+    policy._enabled = false;
+    CHECK_EQUAL( policy.tier( false, SQUARED( 100.f ) ), AnimationLODTier::FULL );
+
+    // Over one full interval, every instance of a tier updates exactly once and the updates are spread evenly across frames
+    for ( U8 t = 0u; t < to_base( AnimationLODTier::COUNT ); ++t )
+    {
+        const AnimationLODTier tier = static_cast<AnimationLODTier>(t);
+        const U32 interval = AnimationLODPolicy::UpdateInterval( tier );
+        constexpr U64 instanceCount = 64u;
+
+        bool updatedOnce = true, evenlySpread = true;
+        vector<U32> updatesPerInstance( instanceCount, 0u );
+        for ( U64 update = 0u; update < interval; ++update )
+        {
+            U64 updatedThisFrame = 0u;
+            for ( U64 phase = 0u; phase < instanceCount; ++phase )
+            {
+                if ( AnimationLODPolicy::ShouldUpdate( tier, update, phase ) )
+                {
+                    ++updatesPerInstance[phase];
+                    ++updatedThisFrame;
+                }
+            }
+            evenlySpread = evenlySpread && updatedThisFrame == instanceCount / interval;
+        }
+
+        for ( const U32 count : updatesPerInstance )
+        {
+            updatedOnce = updatedOnce && count == 1u;
+        }
+
+        CHECK_TRUE( updatedOnce );
+        CHECK_TRUE( evenlySpread );
+    }
+}
+
+TEST_CASE( "Animation LoD Default Config Test", "[animation]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    // Off by default: every instance updates every frame with every bone, on screen or not
+    const Configuration::Rendering config{};
+    const AnimationLODPolicy policy( config );
+    CHECK_FALSE( policy._enabled );
+
+    bool fullUpdates = true;
+    AnimationLODTier previousTier = AnimationLODTier::FULL;
+    for ( U64 update = 0u; update < 16u; ++update )
+    {
+        const AnimationLODUpdate lod = policy.update( previousTier, update % 3u != 0u, SQUARED( 10.f * update ), false, update, 7u );
+        fullUpdates = fullUpdates && lod._update && lod._tier == AnimationLODTier::FULL && lod._maxBoneDepth == U8_MAX;
+        previousTier = lod._tier;
+    }
+    CHECK_TRUE( fullUpdates );
+}
+
+TEST_CASE( "Animation LoD Visibility Test", "[animation]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    AnimationLODPolicy policy{};
+    policy._enabled = true;
+    policy._distanceThresholds = { 10u, 50u };
+    policy._reducedBoneDepth = 3u;
+
+    // Same bookkeeping as AnimationSystem::Update for a single instance
+    struct Instance
+    {
+        AnimationLODTier _tier = AnimationLODTier::FULL;
+        U64 _phase = 0u;
+        U32 _updates = 0u;
+        U8 _lastBoneDepth = U8_MAX;
+    };
+    const auto step = [&policy]( Instance& instance, const U64 update, const bool visible, const F32 distanceSq )
+    {
+        const AnimationLODUpdate lod = policy.update( instance._tier, visible, distanceSq, false, update, instance._phase );
+        instance._tier = lod._tier;
+        if ( lod._update )
+        {
+            ++instance._updates;
+            instance._lastBoneDepth = lod._maxBoneDepth;
+        }
+        return lod._update;
+    };
+
+    // Never in the DISPLAY pass (e.g. only casting a shadow): keeps animating every 4th update, with every bone
+    for ( U64 phase = 0u; phase < 4u; ++phase )
+    {
+        Instance offScreen{ ._phase = phase };
+        U32 longestGap = 0u, gap = 0u;
+        for ( U64 update = 0u; update < 64u; ++update )
+        {
+            gap = step( offScreen, update, false, F32_MAX ) ? 0u : gap + 1u;
+            longestGap = std::max( longestGap, gap );
+        }
+        CHECK_EQUAL( offScreen._tier, AnimationLODTier::INVISIBLE );
+        CHECK_EQUAL( offScreen._updates, 16u );
+        CHECK_EQUAL( longestGap, 3u );
+        CHECK_EQUAL( offScreen._lastBoneDepth, U8_MAX );
+    }
+
+    // Comes on screen close to the camera: updates during the very first frame it is visible, whatever its phase
+    for ( U64 phase = 0u; phase < 4u; ++phase )
+    {
+        Instance instance{ ._phase = phase };
+        for ( U64 update = 0u; update < 8u; ++update )
+        {
+            step( instance, update, false, F32_MAX );
+        }
+        bool updatedEveryFrame = true;
+        for ( U64 update = 8u; update < 16u; ++update )
+        {
+            updatedEveryFrame = step( instance, update, true, SQUARED( 5.f ) ) && updatedEveryFrame;
+        }
+        CHECK_TRUE( updatedEveryFrame );
+        CHECK_EQUAL( instance._tier, AnimationLODTier::FULL );
+    }
+
+    // Comes on screen far away: the catch-up update samples every bone, the following ones use the reduced set
+    {
+        Instance instance{ ._phase = 1u };
+        for ( U64 update = 0u; update < 8u; ++update )
+        {
+            step( instance, update, false, F32_MAX );
+        }
+        CHECK_TRUE( step( instance, 8u, true, SQUARED( 100.f ) ) );
+        CHECK_EQUAL( instance._lastBoneDepth, U8_MAX );
+
+        U32 reducedUpdates = 0u;
+        for ( U64 update = 9u; update < 25u; ++update )
+        {
+            if ( step( instance, update, true, SQUARED( 100.f ) ) )
+            {
+                reducedUpdates += instance._lastBoneDepth == 3u ? 1u : 0u;
+            }
+        }
+        CHECK_EQUAL( instance._tier, AnimationLODTier::QUARTER_RATE );
+        CHECK_EQUAL( reducedUpdates, 4u );
+    }
+
+    // Animation changes never wait for their turn or skip bones
+    bool forcedFull = true;
+    for ( U64 update = 0u; update < 8u; ++update )
+    {
+        const AnimationLODUpdate lod = policy.update( AnimationLODTier::QUARTER_RATE, true, SQUARED( 100.f ), true, update, 0u );
+        forcedFull = forcedFull && lod._update && lod._maxBoneDepth == U8_MAX;
+    }
+    CHECK_TRUE( forcedFull );
+}
+
+TEST_CASE( "Animation LoD Crowd Test", "[animation]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr size_t instanceCount = 2'000u;
+    constexpr U64 updateCount = 120u;
+
+    // A crowd spread around the camera. Roughly a third of it is in view
+    std::mt19937 rng( 9u );
+    std::uniform_real_distribution<F32> distance( 1.f, 150.f );
+    std::uniform_real_distribution<F32> chance( 0.f, 1.f );
+
+    vector<F32> distancesSq( instanceCount );
+    vector<bool> visible( instanceCount );
+    for ( size_t i = 0u; i < instanceCount; ++i )
+    {
+        distancesSq[i] = SQUARED( distance( rng ) );
+        visible[i] = chance( rng ) < 0.33f;
+    }
+
+    AnimationLODPolicy policy{};
+    policy._enabled = true;
+    policy._reducedBoneDepth = 4u;
+    std::array<size_t, to_base( AnimationLODTier::COUNT )> updated{};
+    size_t worstFrame = 0u;
+
+    for ( U64 update = 0u; update < updateCount; ++update )
+    {
+        size_t updatedThisFrame = 0u;
+        for ( size_t i = 0u; i < instanceCount; ++i )
+        {
+            const AnimationLODTier tier = policy.tier( visible[i], distancesSq[i] );
+            if ( AnimationLODPolicy::ShouldUpdate( tier, update, i ) )
+            {
+                ++updated[to_base( tier )];
+                ++updatedThisFrame;
+            }
+        }
+        worstFrame = std::max( worstFrame, updatedThisFrame );
+    }
+
+    const size_t total = updated[0] + updated[1] + updated[2] + updated[3];
+    // Staggering keeps every frame close to the average instead of spiking every 4th frame
+    CHECK_TRUE( worstFrame * updateCount < total * 2u );
+    // Off-screen instances still update every 4th frame, as they may be in a shadow or reflection pass
+    CHECK_TRUE( total < instanceCount * updateCount / 2u );
+
+    std::cout << Util::StringFormat( "Animation LoD [ {} instances, {} updates ]: {:.1f} updates/frame (full: {:.1f}, half: {:.1f}, quarter: {:.1f}, invisible: {:.1f}), worst frame {}, vs {} without LoD",
+                                     instanceCount,
+                                     updateCount,
+                                     to_D64( total ) / updateCount,
+                                     to_D64( updated[0] ) / updateCount,
+                                     to_D64( updated[1] ) / updateCount,
+                                     to_D64( updated[2] ) / updateCount,
+                                     to_D64( updated[3] ) / updateCount,
+                                     worstFrame,
+                                     instanceCount ) << std::endl;
+}
+
+} //namespace Divide
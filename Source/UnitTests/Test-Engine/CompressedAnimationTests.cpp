@@ -0,0 +1,422 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Headers/ByteBuffer.h"
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Geometry/Animations/Headers/AnimationEvaluator.h"
+#include "Geometry/Animations/Headers/AnimationUtils.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    constexpr U8 g_limbCount = 4u;
+    constexpr U8 g_bonesPerLimb = 15u;
+    constexpr F32 g_boneLength = 0.5f;
+    constexpr D64 g_ticksPerSecond = 30.0;
+    constexpr U32 g_keyCount = 121u;
+    constexpr D64 g_duration = g_keyCount - 1u;
+
+    /// Root plus 4 chains of 15 bones. Every bone except the root is skinned
+    Bone_uptr BuildSkeleton()
+    {
+        Bone_uptr root = std::make_unique<Bone>( "root", nullptr );
+
+        U8 boneID = 0u;
+        for ( U8 limb = 0u; limb < g_limbCount; ++limb )
+        {
+            Bone* parent = root.get();
+            for ( U8 i = 0u; i < g_bonesPerLimb; ++i )
+            {
+                Bone* bone = new Bone( Util::StringFormat( "limb_{}_{}", limb, i ), parent );
+                bone->_boneID = boneID++;
+                bone->_localTransform.setTranslation( i == 0u ? to_F32( limb ) - 1.5f : 0.f, g_boneLength, 0.f );
+                bone->_offsetMatrix.setTranslation( 0.f, -g_boneLength * (i + 1), 0.f );
+                parent = bone;
+            }
+        }
+
+        return root;
+    }
+
+    /// Smooth curves on most bones, constant tracks on some (those should be reduced to a single key),
+    /// stepped scaling on a few and no channel at all for the tip of the first two limbs (those stay in their bind pose)
+    aiAnimation* BuildAnimation()
+    {
+        aiAnimation* animation = new aiAnimation();
+        animation->mName.Set( "CompressedAnimationTest" );
+        animation->mTicksPerSecond = g_ticksPerSecond;
+        animation->mDuration = g_duration;
+
+        vector<aiNodeAnim*> channels;
+        const auto addChannel = [&channels]( const string& name, const U32 seed )
+        {
+            const bool animatedPosition = seed % 2u == 0u;
+            const bool animatedRotation = seed % 5u != 0u;
+            const bool steppedScale = seed % 7u == 0u;
+            const aiVector3D axis = aiVector3D( 1.f + seed % 3u, 1.f + seed % 2u, 0.5f ).Normalize();
+
+            aiNodeAnim* channel = channels.emplace_back( new aiNodeAnim() );
+            channel->mNodeName.Set( name.c_str() );
+            channel->mNumPositionKeys = channel->mNumRotationKeys = channel->mNumScalingKeys = g_keyCount;
+            channel->mPositionKeys = new aiVectorKey[g_keyCount];
+            channel->mRotationKeys = new aiQuatKey[g_keyCount];
+            channel->mScalingKeys = new aiVectorKey[g_keyCount];
+
+            for ( U32 k = 0u; k < g_keyCount; ++k )
+            {
+                const D64 time = to_D64( k );
+                const F32 phase = to_F32( M_PI_MUL_2 * time / g_duration ) * (1.f + seed % 3u) + seed;
+                const F32 wave = animatedPosition ? 0.1f * std::sin( phase ) : 0.f;
+
+                channel->mPositionKeys[k] = aiVectorKey( time, aiVector3D( wave, g_boneLength + wave, 0.f ) );
+                channel->mRotationKeys[k] = aiQuatKey( time, aiQuaternion( axis, animatedRotation ? 0.6f * std::sin( phase ) : 0.25f ) );
+                channel->mScalingKeys[k] = aiVectorKey( time, steppedScale ? aiVector3D( (k / 30u) % 2u == 0u ? 1.25f : 1.5f ) : aiVector3D( 1.f ) );
+            }
+        };
+
+        addChannel( "root", 1u );
+        for ( U8 limb = 0u; limb < g_limbCount; ++limb )
+        {
+            for ( U8 i = 0u; i < g_bonesPerLimb; ++i )
+            {
+                if ( limb < 2u && i == g_bonesPerLimb - 1u )
+                {
+                    continue;
+                }
+                addChannel( Util::StringFormat( "limb_{}_{}", limb, i ), limb * g_bonesPerLimb + i );
+            }
+        }
+        // Channels that don't match a bone must be ignored
+        addChannel( "missing_bone", 3u );
+
+        animation->mNumChannels = to_U32( channels.size() );
+        animation->mChannels = new aiNodeAnim*[channels.size()];
+        std::copy( channels.begin(), channels.end(), animation->mChannels );
+
+        return animation;
+    }
+
+    mat4<F32> GlobalTransform( const Bone& bone )
+    {
+        return bone.parent() != nullptr ? bone._localTransform * GlobalTransform( *bone.parent() ) : bone._localTransform;
+    }
+
+    /// Same as SceneAnimator::init does for every baked frame
+    void BakeFrame( const Bone& bone, BoneMatrices& matricesOut )
+    {
+        if ( bone._boneID != Bone::INVALID_BONE_IDX )
+        {
+            matricesOut[bone._boneID] = bone._offsetMatrix * GlobalTransform( bone );
+        }
+
+        for ( const Bone_uptr& child : bone.children() )
+        {
+            BakeFrame( *child, matricesOut );
+        }
+    }
+
+    F32 MaxDifference( const BoneMatrices& lhs, const BoneMatrices& rhs )
+    {
+        F32 ret = 0.f;
+        for ( size_t i = 0u; i < lhs.size(); ++i )
+        {
+            for ( U8 e = 0u; e < 16u; ++e )
+            {
+                ret = std::max( ret, std::abs( lhs[i].mat[e] - rhs[i].mat[e] ) );
+            }
+        }
+        return ret;
+    }
+
+    F32 MaxSampleError( AnimEvaluator& evaluator, Bone& root, const AnimationSkeleton& skeleton, const CompressedAnimation& animation, const vector<D64>& timesS )
+    {
+        AnimationPose pose;
+        pose.resize( skeleton.boneCount(), skeleton.skinnedBoneCount() );
+        BoneMatrices reference( skeleton.skinnedBoneCount(), MAT4_IDENTITY );
+
+        F32 ret = 0.f;
+        for ( const D64 timeS : timesS )
+        {
+            evaluator.evaluate( timeS, root );
+            BakeFrame( root, reference );
+
+            animation.sample( std::fmod( timeS * evaluator.ticksPerSecond(), evaluator.duration() ), pose );
+            skeleton.computeSkinning( pose );
+
+            ret = std::max( ret, MaxDifference( reference, pose._skinning ) );
+        }
+
+        return ret;
+    }
+}
+
+TEST_CASE( "Compressed Animation Test", "[animation]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    const Bone_uptr root = BuildSkeleton();
+    const std::unique_ptr<aiAnimation> source( BuildAnimation() );
+    AnimEvaluator evaluator( source.get(), 0u );
+
+    // Flatten before evaluating anything so that the layout captures the bind pose
+    AnimationSkeleton skeleton;
+    skeleton.build( *root );
+    CHECK_EQUAL( skeleton.boneCount(), g_limbCount * g_bonesPerLimb + 1u );
+    CHECK_EQUAL( skeleton.skinnedBoneCount(), g_limbCount * g_bonesPerLimb );
+    CHECK_EQUAL( skeleton.parentIndex( 0u ), AnimationSkeleton::INVALID_INDEX );
+    CHECK_EQUAL( skeleton.boneIndex( _ID( "missing_bone" ) ), AnimationSkeleton::INVALID_INDEX );
+
+    bool parentsFirst = true;
+    for ( U16 bone = 1u; bone < skeleton.boneCount(); ++bone )
+    {
+        parentsFirst = parentsFirst && skeleton.parentIndex( bone ) < bone;
+    }
+    CHECK_TRUE( parentsFirst );
+    CHECK_EQUAL( skeleton.depth( 0u ), 0u );
+    CHECK_EQUAL( skeleton.depth( to_U16( skeleton.boneCount() - 1u ) ), g_bonesPerLimb );
+
+    std::mt19937 rng( 3u );
+    std::uniform_real_distribution<D64> time( 0.0, 2.0 * g_duration / g_ticksPerSecond );
+    vector<D64> timesS( 64u );
+    for ( D64& timeS : timesS )
+    {
+        timeS = time( rng );
+    }
+    // Exactly on a key and right before the loop restarts
+    timesS.push_back( 0.0 );
+    timesS.push_back( 10.0 / g_ticksPerSecond );
+    timesS.push_back( g_duration / g_ticksPerSecond - 1e-4 );
+
+    // Tight tolerances: no key can be dropped unless it is redundant, so the only error left comes from quantization (mostly of the key times)
+    AnimationCompressionSettings tight{};
+    tight._positionTolerance = tight._rotationTolerance = tight._scaleTolerance = 1e-6f;
+
+    CompressedAnimation animation;
+    animation.build( evaluator.channels(), evaluator.duration(), skeleton, tight );
+    CHECK_FALSE( animation.empty() );
+    CHECK_TRUE( animation.keyCount() < animation.sourceKeyCount() );
+
+    const F32 tightError = MaxSampleError( evaluator, *root, skeleton, animation, timesS );
+    CHECK_TRUE( tightError < 2e-2f );
+
+    // Default tolerances: error accumulates down the 15 bone chains but has to stay well below the size of a bone
+    animation.build( evaluator.channels(), evaluator.duration(), skeleton, {} );
+    const size_t reducedKeyCount = animation.keyCount();
+
+    const F32 reducedError = MaxSampleError( evaluator, *root, skeleton, animation, timesS );
+    CHECK_TRUE( reducedError < g_boneLength * 0.1f );
+
+    // Reduced bone set: only the bones close to the root get sampled. The rest keep their bind pose on a fresh pose ...
+    {
+        constexpr U8 maxBoneDepth = 3u;
+
+        AnimationPose pose;
+        pose.resize( skeleton.boneCount(), skeleton.skinnedBoneCount() );
+        animation.sample( 0.0, pose, maxBoneDepth );
+
+        bool depthRespected = true;
+        for ( U16 bone = 0u; bone < skeleton.boneCount(); ++bone )
+        {
+            // Every bone up to that depth has a channel
+            depthRespected = depthRespected && (pose._animated[bone] == 1u) == (skeleton.depth( bone ) <= maxBoneDepth);
+        }
+        CHECK_TRUE( depthRespected );
+
+        // ... and their previously sampled values otherwise, instead of snapping back to the bind pose
+        animation.sample( animation.duration() * 0.5, pose );
+        const AnimationPose previous = pose;
+        animation.sample( animation.duration() * 0.75, pose, maxBoneDepth );
+
+        bool deepBonesKept = true, shallowBonesSampled = true;
+        for ( U16 bone = 0u; bone < skeleton.boneCount(); ++bone )
+        {
+            const bool kept = pose._animated[bone] == 1u &&
+                              pose._posX[bone] == previous._posX[bone] && pose._posY[bone] == previous._posY[bone] && pose._posZ[bone] == previous._posZ[bone] &&
+                              pose._rotX[bone] == previous._rotX[bone] && pose._rotY[bone] == previous._rotY[bone] &&
+                              pose._rotZ[bone] == previous._rotZ[bone] && pose._rotW[bone] == previous._rotW[bone];
+            if ( skeleton.depth( bone ) > maxBoneDepth )
+            {
+                deepBonesKept = deepBonesKept && kept;
+            }
+            else
+            {
+                shallowBonesSampled = shallowBonesSampled && pose._animated[bone] == 1u;
+            }
+        }
+        CHECK_TRUE( deepBonesKept );
+        CHECK_TRUE( shallowBonesSampled );
+    }
+
+    // Every bake step stores a full set of matrices
+    const size_t bakedFrameCount = to_size( std::ceil( g_duration / (g_ticksPerSecond / ANIMATION_TICKS_PER_SECOND) ) );
+    const size_t bakedSize = bakedFrameCount * skeleton.skinnedBoneCount() * sizeof( mat4<F32> );
+    CHECK_TRUE( animation.memoryUsage() * 4u < bakedSize );
+
+    std::cout << Util::StringFormat( "Animation compression [ {} bones, {} source keys ]: {} keys kept, {:.1f} KB compressed vs {:.1f} KB baked. Max error: {:.5f} (tight tolerances), {:.5f} (default tolerances)",
+                                     skeleton.boneCount(),
+                                     animation.sourceKeyCount(),
+                                     reducedKeyCount,
+                                     animation.memoryUsage() / 1024.f,
+                                     bakedSize / 1024.f,
+                                     tightError,
+                                     reducedError ) << std::endl;
+
+    animation.clear();
+    CHECK_TRUE( animation.empty() );
+    CHECK_EQUAL( animation.memoryUsage(), 0u );
+}
+
+TEST_CASE( "Animation Skeleton Test", "[animation]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    const Bone_uptr root = BuildSkeleton();
+    const std::unique_ptr<aiAnimation> source( BuildAnimation() );
+    AnimEvaluator evaluator( source.get(), 0u );
+
+    AnimationSkeleton skeleton;
+    skeleton.build( *root );
+
+    // Serialization round trip
+    ByteBuffer buffer;
+    skeleton.save( buffer );
+
+    AnimationSkeleton loaded;
+    CHECK_TRUE( loaded.load( buffer ) );
+    CHECK_EQUAL( loaded.boneCount(), skeleton.boneCount() );
+    CHECK_EQUAL( loaded.skinnedBoneCount(), skeleton.skinnedBoneCount() );
+
+    bool layoutMatches = true;
+    for ( U16 bone = 0u; bone < skeleton.boneCount(); ++bone )
+    {
+        layoutMatches = layoutMatches &&
+                        loaded.parentIndex( bone ) == skeleton.parentIndex( bone ) &&
+                        loaded.depth( bone ) == skeleton.depth( bone ) &&
+                        loaded.boneID( bone ) == skeleton.boneID( bone ) &&
+                        loaded.offset( bone ) == skeleton.offset( bone ) &&
+                        loaded.bindLocal()[bone] == skeleton.bindLocal()[bone];
+    }
+    CHECK_TRUE( layoutMatches );
+
+    // Name lookups match the bone tree
+    bool lookupsMatch = loaded.boneIndex( _ID( "missing_bone" ) ) == AnimationSkeleton::INVALID_INDEX;
+    for ( U8 limb = 0u; limb < g_limbCount; ++limb )
+    {
+        for ( U8 i = 0u; i < g_bonesPerLimb; ++i )
+        {
+            const U64 nameHash = _ID( Util::StringFormat( "limb_{}_{}", limb, i ).c_str() );
+            const U16 bone = loaded.boneIndex( nameHash );
+            lookupsMatch = lookupsMatch && bone != AnimationSkeleton::INVALID_INDEX && loaded.boneID( bone ) == root->find( nameHash )->_boneID;
+        }
+    }
+    CHECK_TRUE( lookupsMatch );
+
+    // Data from another version of the format is rejected up front instead of being parsed with the current layout
+    {
+        ByteBuffer outdated;
+        outdated << to_U16( 0u );
+        outdated << to_U32( skeleton.boneCount() );
+        outdated << to_U32( skeleton.skinnedBoneCount() );
+
+        AnimationSkeleton stale;
+        CHECK_FALSE( stale.load( outdated ) );
+        CHECK_EQUAL( stale.boneCount(), 0u );
+    }
+
+    // Flat evaluation (single forward pass) vs. the bone tree (recursive parent walk for every bone)
+    constexpr size_t frameCount = 240u;
+    BoneMatrices reference( skeleton.skinnedBoneCount(), MAT4_IDENTITY );
+    BoneMatrices skinning( skeleton.skinnedBoneCount(), MAT4_IDENTITY );
+    vector<mat4<F32>> local( skeleton.boneCount() ), model( skeleton.boneCount() );
+
+    F32 maxError = 0.f;
+    D64 treeDurationUS = 0.0, flatDurationUS = 0.0;
+    for ( size_t frame = 0u; frame < frameCount; ++frame )
+    {
+        const D64 timeS = frame / to_D64( ANIMATION_TICKS_PER_SECOND );
+
+        const D64 treeStart = Time::App::ElapsedMicroseconds();
+        evaluator.evaluate( timeS, *root );
+        BakeFrame( *root, reference );
+        treeDurationUS += Time::App::ElapsedMicroseconds() - treeStart;
+
+        const D64 flatStart = Time::App::ElapsedMicroseconds();
+        local = loaded.bindLocal();
+        evaluator.evaluate( timeS, loaded, local );
+        loaded.computeSkinning( local, model, skinning );
+        flatDurationUS += Time::App::ElapsedMicroseconds() - flatStart;
+
+        maxError = std::max( maxError, MaxDifference( reference, skinning ) );
+    }
+
+    // Same math, different concatenation order
+    CHECK_TRUE( maxError < 1e-4f );
+
+    std::cout << Util::StringFormat( "Skeleton evaluation speed test [ {} bones ]: bone tree {:.2f} us/frame, flattened {:.2f} us/frame",
+                                     skeleton.boneCount(),
+                                     treeDurationUS / frameCount,
+                                     flatDurationUS / frameCount ) << std::endl;
+}
+
+TEST_CASE( "Compressed Animation Speed Test", "[animation]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr size_t instanceCount = 256u;
+
+    const Bone_uptr root = BuildSkeleton();
+    const std::unique_ptr<aiAnimation> source( BuildAnimation() );
+    AnimEvaluator evaluator( source.get(), 0u );
+
+    AnimationSkeleton skeleton;
+    skeleton.build( *root );
+
+    CompressedAnimation animation;
+    animation.build( evaluator.channels(), evaluator.duration(), skeleton, {} );
+
+    // Every instance plays the animation at a different point in time
+    vector<D64> timesS( instanceCount );
+    for ( size_t i = 0u; i < instanceCount; ++i )
+    {
+        timesS[i] = (i * 7u % instanceCount) * evaluator.duration() / evaluator.ticksPerSecond() / instanceCount;
+    }
+
+    BoneMatrices reference( skeleton.skinnedBoneCount(), MAT4_IDENTITY );
+    vector<AnimationPose> poses( instanceCount );
+    for ( AnimationPose& pose : poses )
+    {
+        pose.resize( skeleton.boneCount(), skeleton.skinnedBoneCount() );
+    }
+
+    // What baking costs for every single frame: evaluate the channels on the bone tree, then walk it for the global transforms
+    const D64 evaluateStart = Time::App::ElapsedMicroseconds();
+    for ( const D64 timeS : timesS )
+    {
+        evaluator.evaluate( timeS, *root );
+        BakeFrame( *root, reference );
+    }
+    const D64 evaluateDurationUS = Time::App::ElapsedMicroseconds() - evaluateStart;
+
+    const D64 sampleStart = Time::App::ElapsedMicroseconds();
+    for ( size_t i = 0u; i < instanceCount; ++i )
+    {
+        animation.sample( std::fmod( timesS[i] * evaluator.ticksPerSecond(), evaluator.duration() ), poses[i] );
+        skeleton.computeSkinning( poses[i] );
+    }
+    const D64 sampleDurationUS = Time::App::ElapsedMicroseconds() - sampleStart;
+
+    // Last instance evaluated both ways: results must match
+    CHECK_TRUE( MaxDifference( reference, poses.back()._skinning ) < g_boneLength * 0.1f );
+
+    std::cout << Util::StringFormat( "Animation sampling speed test [ {} instances, {} bones ]: bone tree evaluation {:.2f} us/instance, compressed sampling {:.2f} us/instance",
+                                     instanceCount,
+                                     skeleton.boneCount(),
+                                     evaluateDurationUS / instanceCount,
+                                     sampleDurationUS / instanceCount ) << std::endl;
+}
+
+} //namespace Divide
@@ -0,0 +1,336 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Core/Math/BoundingVolumes/Headers/BoundingBox.h"
+#include "ECS/Systems/Headers/DirtyLevelQueue.h"
+
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    /// Stand-in for BoundsComponent: own bounds plus cached bounds enclosing the whole subtree
+    struct TestNode
+    {
+        BoundingBox _local;
+        BoundingBox _bounds;
+        TestNode* _parent{ nullptr };
+        vector<TestNode*> _children;
+        U32 _dirtyDepth{ DirtyLevelQueue<TestNode>::INVALID_DEPTH };
+        /// Order in which the node was last updated
+        U32 _updateIndex{ U32_MAX };
+        bool _dirty{ false };
+    };
+
+    TestNode* ParentOf( const TestNode* node ) noexcept
+    {
+        return node->_parent;
+    }
+
+    U32& DepthOf( TestNode* node ) noexcept
+    {
+        return node->_dirtyDepth;
+    }
+
+    /// Same as BoundsComponent::updateBounds: our own bounds plus the cached bounds of every child
+    void UpdateBounds( TestNode* node )
+    {
+        node->_bounds = node->_local;
+        for ( const TestNode* child : node->_children )
+        {
+            node->_bounds.add( child->_bounds );
+        }
+        node->_dirty = false;
+    }
+
+    BoundingBox ReferenceBounds( const TestNode* node )
+    {
+        BoundingBox ret = node->_local;
+        for ( const TestNode* child : node->_children )
+        {
+            ret.add( ReferenceBounds( child ) );
+        }
+        return ret;
+    }
+
+    BoundingBox RandomBox( std::mt19937& rng )
+    {
+        std::uniform_real_distribution<F32> position( -100.f, 100.f );
+        std::uniform_real_distribution<F32> size( 0.1f, 5.f );
+
+        const float3 min{ position( rng ), position( rng ), position( rng ) };
+        return BoundingBox{ min, min + float3{ size( rng ), size( rng ), size( rng ) } };
+    }
+
+    /// Node 0 is the root. Every other node picks a random earlier node as its parent, with a few long chains mixed in
+    void BuildHierarchy( vector<TestNode>& nodes, std::mt19937& rng )
+    {
+        for ( size_t i = 0u; i < nodes.size(); ++i )
+        {
+            nodes[i]._local = RandomBox( rng );
+            if ( i == 0u )
+            {
+                continue;
+            }
+
+            const U32 roll = std::uniform_int_distribution<U32>( 0u, 99u )( rng );
+            TestNode* parent = &nodes[roll < 10u ? i - 1u : std::uniform_int_distribution<size_t>( 0u, i - 1u )( rng )];
+            nodes[i]._parent = parent;
+            parent->_children.push_back( &nodes[i] );
+        }
+    }
+
+    bool MatchesReference( const vector<TestNode>& nodes )
+    {
+        for ( const TestNode& node : nodes )
+        {
+            if ( !(node._bounds == ReferenceBounds( &node )) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE( "Dirty Level Queue Aggregation Test", "[dirty_level_queue]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool pool( "DIRTY_LEVEL_QUEUE_TEST" );
+    const bool init = pool.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    std::mt19937 rng( 11u );
+    vector<TestNode> nodes( 5000u );
+    BuildHierarchy( nodes, rng );
+
+    DirtyLevelQueue<TestNode> queue;
+
+    // Same loop as BoundsSystem::PostUpdate, with every level split across the pool
+    const auto runPass = [&]()
+    {
+        for ( TestNode& node : nodes )
+        {
+            if ( node._dirty )
+            {
+                queue.push( &node, ParentOf, DepthOf );
+            }
+        }
+
+        queue.forEachLevelBottomUp( [&pool]( vector<TestNode*>& level )
+        {
+            Parallel_For( pool,
+                          ParallelForDescriptor
+                          {
+                              ._iterCount = to_U32( level.size() ),
+                              ._partitionSize = 16u
+                          },
+                          [&level]( const Task*, const U32 start, const U32 end )
+                          {
+                              for ( U32 i = start; i < end; ++i )
+                              {
+                                  UpdateBounds( level[i] );
+                              }
+                          } );
+        } );
+
+        queue.flush( DepthOf, []( [[maybe_unused]] TestNode* node ) noexcept {} );
+    };
+
+    // Everything dirty: every child's bounds must end up in its parent's, all the way to the root
+    for ( TestNode& node : nodes )
+    {
+        node._dirty = true;
+    }
+    runPass();
+    CHECK_TRUE( MatchesReference( nodes ) );
+    CHECK_EQUAL( queue.size(), 0u );
+
+    // Move a few nodes. Only they and their ancestors get updated, the rest keep their cached bounds
+    for ( U8 pass = 0u; pass < 8u; ++pass )
+    {
+        for ( U8 i = 0u; i < 16u; ++i )
+        {
+            TestNode& node = nodes[std::uniform_int_distribution<size_t>( 0u, nodes.size() - 1u )( rng )];
+            node._local = RandomBox( rng );
+            node._dirty = true;
+        }
+        runPass();
+        CHECK_TRUE( MatchesReference( nodes ) );
+    }
+
+    pool.shutdown();
+}
+
+TEST_CASE( "Dirty Level Queue Order Test", "[dirty_level_queue]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    std::mt19937 rng( 5u );
+    vector<TestNode> nodes( 2000u );
+    BuildHierarchy( nodes, rng );
+
+    DirtyLevelQueue<TestNode> queue;
+
+    // Dirty a handful of nodes, each of them multiple times and in no particular order
+    vector<TestNode*> dirtyNodes;
+    for ( U8 i = 0u; i < 32u; ++i )
+    {
+        dirtyNodes.push_back( &nodes[std::uniform_int_distribution<size_t>( 0u, nodes.size() - 1u )( rng )] );
+    }
+    for ( U8 repeat = 0u; repeat < 2u; ++repeat )
+    {
+        for ( TestNode* node : dirtyNodes )
+        {
+            queue.push( node, ParentOf, DepthOf );
+        }
+    }
+
+    // Expected set: every dirty node and all of its ancestors, once
+    vector<TestNode*> expected;
+    for ( TestNode* node : dirtyNodes )
+    {
+        for ( TestNode* it = node; it != nullptr; it = it->_parent )
+        {
+            expected.push_back( it );
+        }
+    }
+    eastl::sort( expected.begin(), expected.end() );
+    expected.erase( eastl::unique( expected.begin(), expected.end() ), expected.end() );
+    CHECK_EQUAL( queue.size(), expected.size() );
+
+    // Every queued node's depth is its distance from the root
+    bool depthsMatch = true;
+    for ( TestNode* node : expected )
+    {
+        U32 depth = 0u;
+        for ( const TestNode* it = node->_parent; it != nullptr; it = it->_parent )
+        {
+            ++depth;
+        }
+        depthsMatch = depthsMatch && node->_dirtyDepth == depth;
+    }
+    CHECK_TRUE( depthsMatch );
+
+    U32 updateIndex = 0u;
+    vector<TestNode*> visited;
+    queue.forEachLevelBottomUp( [&]( vector<TestNode*>& level )
+    {
+        for ( TestNode* node : level )
+        {
+            node->_updateIndex = updateIndex++;
+            visited.push_back( node );
+        }
+    } );
+
+    eastl::sort( visited.begin(), visited.end() );
+    CHECK_TRUE( visited == expected );
+
+    // Deepest first: a queued node is always updated after every one of its queued children
+    bool childrenFirst = true;
+    for ( const TestNode* node : expected )
+    {
+        if ( node->_parent != nullptr )
+        {
+            childrenFirst = childrenFirst && node->_parent->_updateIndex > node->_updateIndex;
+        }
+    }
+    CHECK_TRUE( childrenFirst );
+
+    size_t flushed = 0u;
+    queue.flush( DepthOf, [&flushed]( const TestNode* node ) noexcept
+    {
+        flushed += node->_dirtyDepth == DirtyLevelQueue<TestNode>::INVALID_DEPTH ? 1u : 0u;
+    } );
+    CHECK_EQUAL( flushed, expected.size() );
+    CHECK_EQUAL( queue.size(), 0u );
+}
+
+TEST_CASE( "Dirty Level Queue Re-Dirty Test", "[dirty_level_queue]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    // root -> a -> b -> c, root -> d
+    std::mt19937 rng( 3u );
+    vector<TestNode> nodes( 5u );
+    for ( TestNode& node : nodes )
+    {
+        node._local = RandomBox( rng );
+    }
+    TestNode& root = nodes[0];
+    TestNode& a = nodes[1];
+    TestNode& b = nodes[2];
+    TestNode& c = nodes[3];
+    TestNode& d = nodes[4];
+    const auto link = []( TestNode& parent, TestNode& child )
+    {
+        child._parent = &parent;
+        parent._children.push_back( &child );
+    };
+    link( root, a );
+    link( a, b );
+    link( b, c );
+    link( root, d );
+
+    DirtyLevelQueue<TestNode> queue;
+    const auto update = [&queue]()
+    {
+        queue.forEachLevelBottomUp( []( vector<TestNode*>& level )
+        {
+            for ( TestNode* node : level )
+            {
+                UpdateBounds( node );
+            }
+        } );
+    };
+
+    for ( TestNode& node : nodes )
+    {
+        queue.push( &node, ParentOf, DepthOf );
+    }
+    update();
+    queue.flush( DepthOf, []( [[maybe_unused]] TestNode* node ) noexcept {} );
+    CHECK_TRUE( MatchesReference( nodes ) );
+
+    // A node queued after one of its ancestors continues from the ancestor's depth instead of walking up again
+    queue.push( &a, ParentOf, DepthOf );
+    CHECK_EQUAL( a._dirtyDepth, 1u );
+    CHECK_EQUAL( root._dirtyDepth, 0u );
+    queue.push( &c, ParentOf, DepthOf );
+    CHECK_EQUAL( c._dirtyDepth, 3u );
+    CHECK_EQUAL( b._dirtyDepth, 2u );
+    // root, a, b, c. d was never dirtied
+    CHECK_EQUAL( queue.size(), 4u );
+    CHECK_EQUAL( d._dirtyDepth, DirtyLevelQueue<TestNode>::INVALID_DEPTH );
+
+    c._local = RandomBox( rng );
+    update();
+    CHECK_TRUE( MatchesReference( nodes ) );
+
+    // c moves again while the pass is being flushed (e.g. from a BoundsUpdated handler). It must not be lost, just deferred to the next pass
+    bool redirtied = false;
+    queue.flush( DepthOf, [&]( TestNode* node )
+    {
+        if ( node == &b && !redirtied )
+        {
+            c._local = RandomBox( rng );
+            c._dirty = true;
+            redirtied = true;
+        }
+    } );
+    CHECK_TRUE( redirtied );
+    CHECK_FALSE( MatchesReference( nodes ) );
+
+    CHECK_EQUAL( c._dirtyDepth, DirtyLevelQueue<TestNode>::INVALID_DEPTH );
+    queue.push( &c, ParentOf, DepthOf );
+    CHECK_EQUAL( queue.size(), 4u );
+    update();
+    queue.flush( DepthOf, []( [[maybe_unused]] TestNode* node ) noexcept {} );
+    CHECK_TRUE( MatchesReference( nodes ) );
+    CHECK_FALSE( c._dirty );
+}
+
+} //namespace Divide
@@ -0,0 +1,191 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Core/Math/BoundingVolumes/Headers/DynamicAABBTree.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    BoundingBox RandomBox( std::mt19937& rng, const F32 worldSize, const F32 maxBoxSize )
+    {
+        std::uniform_real_distribution<F32> position( -worldSize, worldSize );
+        std::uniform_real_distribution<F32> size( 0.1f, maxBoxSize );
+
+        const float3 min{ position( rng ), position( rng ), position( rng ) };
+        return BoundingBox{ min, min + float3{ size( rng ), size( rng ), size( rng ) } };
+    }
+
+    template<typename T>
+    vector<U32> QueryTree( const DynamicAABBTree<T>& tree, const BoundingBox& aabb )
+    {
+        vector<U32> ret;
+        tree.query( aabb, [&ret]( const U32 proxy )
+        {
+            ret.push_back( proxy );
+            return true;
+        } );
+        eastl::sort( ret.begin(), ret.end() );
+        return ret;
+    }
+}
+
+TEST_CASE( "Dynamic AABB Tree Test", "[bounding_volumes]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr size_t proxyCount = 512u;
+    constexpr size_t queryCount = 128u;
+
+    std::mt19937 rng( 42u );
+
+    DynamicAABBTree<size_t> tree;
+    CHECK_EQUAL( tree.height(), -1 );
+    CHECK_TRUE( tree.validate() );
+
+    vector<U32> proxies( proxyCount );
+    vector<BoundingBox> boxes( proxyCount );
+    for ( size_t i = 0u; i < proxyCount; ++i )
+    {
+        boxes[i] = RandomBox( rng, 100.f, 10.f );
+        proxies[i] = tree.createProxy( boxes[i], i );
+        CHECK_EQUAL( tree.userData( proxies[i] ), i );
+    }
+
+    CHECK_EQUAL( tree.proxyCount(), proxyCount );
+    CHECK_TRUE( tree.validate() );
+    // Rotations keep the tree close to balanced (log2(512) = 9). A degenerate tree would be hundreds of levels deep
+    CHECK_TRUE( tree.height() <= 18 );
+
+    // Moving within the fat margin must not touch the tree
+    BoundingBox nudged = boxes[0];
+    nudged.translate( float3{ 0.1f, 0.f, 0.f } );
+    CHECK_FALSE( tree.moveProxy( proxies[0], nudged ) );
+    boxes[0] = nudged;
+
+    // Move half of the proxies far enough to force a re-insert and destroy a quarter of them
+    for ( size_t i = 0u; i < proxyCount; i += 2u )
+    {
+        boxes[i] = RandomBox( rng, 100.f, 10.f );
+        tree.moveProxy( proxies[i], boxes[i] );
+    }
+    vector<bool> alive( proxyCount, true );
+    for ( size_t i = 1u; i < proxyCount; i += 4u )
+    {
+        tree.destroyProxy( proxies[i] );
+        alive[i] = false;
+    }
+
+    CHECK_EQUAL( tree.proxyCount(), proxyCount - proxyCount / 4u );
+    CHECK_TRUE( tree.validate() );
+
+    bool queriesMatch = true, missedOverlap = false;
+    for ( size_t q = 0u; q < queryCount; ++q )
+    {
+        const BoundingBox queryBox = RandomBox( rng, 100.f, 25.f );
+
+        vector<U32> expected;
+        for ( size_t i = 0u; i < proxyCount; ++i )
+        {
+            if ( !alive[i] )
+            {
+                continue;
+            }
+
+            if ( tree.fatAABB( proxies[i] ).collision( queryBox ) )
+            {
+                expected.push_back( proxies[i] );
+            }
+            else if ( boxes[i].collision( queryBox ) )
+            {
+                // Fat bounds must always enclose the real bounds
+                missedOverlap = true;
+            }
+        }
+        eastl::sort( expected.begin(), expected.end() );
+
+        if ( QueryTree( tree, queryBox ) != expected )
+        {
+            queriesMatch = false;
+        }
+    }
+
+    CHECK_TRUE( queriesMatch );
+    CHECK_FALSE( missedOverlap );
+
+    // Early out
+    size_t visited = 0u;
+    tree.query( BoundingBox{ float3{ -1000.f }, float3{ 1000.f } }, [&visited]( [[maybe_unused]] const U32 proxy )
+    {
+        return ++visited < 3u;
+    } );
+    CHECK_EQUAL( visited, 3u );
+
+    tree.clear();
+    CHECK_EQUAL( tree.proxyCount(), 0u );
+    CHECK_TRUE( tree.validate() );
+}
+
+TEST_CASE( "Dynamic AABB Tree Speed Test", "[bounding_volumes]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr size_t proxyCounts[] = { 1'000u, 10'000u };
+    constexpr size_t queryCount = 512u;
+
+    for ( const size_t proxyCount : proxyCounts )
+    {
+        std::mt19937 rng( 1337u );
+
+        DynamicAABBTree<size_t> tree;
+        vector<BoundingBox> boxes( proxyCount );
+        for ( size_t i = 0u; i < proxyCount; ++i )
+        {
+            boxes[i] = RandomBox( rng, 500.f, 5.f );
+            [[maybe_unused]] const U32 proxy = tree.createProxy( boxes[i], i );
+        }
+
+        vector<BoundingBox> queries( queryCount );
+        for ( BoundingBox& query : queries )
+        {
+            query = RandomBox( rng, 500.f, 5.f );
+        }
+
+        size_t bruteForceHits = 0u, treeHits = 0u;
+
+        const D64 bruteForceStart = Time::App::ElapsedMicroseconds();
+        for ( const BoundingBox& query : queries )
+        {
+            for ( size_t i = 0u; i < proxyCount; ++i )
+            {
+                bruteForceHits += boxes[i].collision( query ) ? 1u : 0u;
+            }
+        }
+        const D64 bruteForceDurationUS = Time::App::ElapsedMicroseconds() - bruteForceStart;
+
+        const D64 treeStart = Time::App::ElapsedMicroseconds();
+        for ( const BoundingBox& query : queries )
+        {
+            tree.query( query, [&]( const U32 proxy )
+            {
+                treeHits += boxes[tree.userData( proxy )].collision( query ) ? 1u : 0u;
+                return true;
+            } );
+        }
+        const D64 treeDurationUS = Time::App::ElapsedMicroseconds() - treeStart;
+
+        CHECK_EQUAL( treeHits, bruteForceHits );
+
+        std::cout << Util::StringFormat( "AABB overlap speed test [ {} boxes, {} queries ]: brute force {:.2f} us/query, tree {:.2f} us/query",
+                                         proxyCount,
+                                         queryCount,
+                                         bruteForceDurationUS / queryCount,
+                                         treeDurationUS / queryCount ) << std::endl;
+    }
+}
+
+} //namespace Divide
@@ -0,0 +1,219 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "ECS/Systems/Headers/ECSSystemScheduler.h"
+
+#include <ECS/Component.h>
+#include <ECS/System.h>
+#include <iostream>
+
+namespace Divide
+{
+
+namespace
+{
+    constexpr size_t g_testSystemCount = 5u;
+    constexpr size_t g_none = g_testSystemCount;
+
+    std::array<std::atomic_bool, g_testSystemCount> g_systemDone;
+    std::array<std::atomic_uint, g_testSystemCount> g_resourceUsers;
+    std::atomic_bool g_orderViolated{ false };
+    std::atomic_bool g_resourceOverlap{ false };
+
+    void ResetTestState()
+    {
+        for ( size_t i = 0u; i < g_testSystemCount; ++i )
+        {
+            g_systemDone[i].store( false );
+            g_resourceUsers[i].store( 0u );
+        }
+        g_orderViolated.store( false );
+        g_resourceOverlap.store( false );
+    }
+
+    void BusyWait( const D64 milliseconds )
+    {
+        const D64 start = Time::App::ElapsedMilliseconds();
+        while ( Time::App::ElapsedMilliseconds() - start < milliseconds )
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    template<size_t Index>
+    struct SchedulerTestComponent final : ECS::Component<SchedulerTestComponent<Index>>
+    {
+    };
+
+    /// Spins for a while during Update. Flags an error if it starts before its predecessor finished or
+    /// if another system uses the same resource at the same time.
+    template<size_t Index>
+    class SchedulerTestSystem final : public ECS::System<SchedulerTestSystem<Index>>
+    {
+      public:
+        SchedulerTestSystem( [[maybe_unused]] ECS::ECSEngine& engine, const D64 workMS, const size_t predecessor, const size_t resource, const bool declareAccess = true )
+            : _workMS( workMS )
+            , _predecessor( predecessor )
+            , _resource( resource )
+        {
+            this->template WritesComponents<SchedulerTestComponent<Index>>();
+            if ( declareAccess )
+            {
+                this->template ReadsComponents<>();
+            }
+        }
+
+        void Update( [[maybe_unused]] const F32 dt ) override
+        {
+            if ( _predecessor != g_none && !g_systemDone[_predecessor].load() )
+            {
+                g_orderViolated.store( true );
+            }
+
+            if ( g_resourceUsers[_resource].fetch_add( 1u ) != 0u )
+            {
+                g_resourceOverlap.store( true );
+            }
+
+            BusyWait( _workMS );
+
+            g_resourceUsers[_resource].fetch_sub( 1u );
+            g_systemDone[Index].store( true );
+        }
+
+        ECS::ISystemSerializer& GetSerializer() noexcept override { return _serializer; }
+        const ECS::ISystemSerializer& GetSerializer() const noexcept override { return _serializer; }
+
+      private:
+        ECS::ISystemSerializer _serializer;
+        D64 _workMS{ 0.0 };
+        size_t _predecessor{ g_none };
+        size_t _resource{ g_none };
+    };
+}
+
+TEST_CASE( "ECS System Scheduler Test", "[ecs_scheduler]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool pool( "ECS_SCHEDULER_TEST" );
+    const bool init = pool.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    {
+        ECS::ECSEngine engine;
+        ECS::SystemManager* systemManager = engine.GetSystemManager();
+
+        constexpr D64 workMS = 4.0;
+        auto* sys0 = systemManager->AddSystem<SchedulerTestSystem<0>>( engine, workMS, g_none, 0u );
+        auto* sys1 = systemManager->AddSystem<SchedulerTestSystem<1>>( engine, workMS, g_none, 1u );
+        [[maybe_unused]] auto* sys2 = systemManager->AddSystem<SchedulerTestSystem<2>>( engine, workMS, g_none, 2u );
+        // Explicit dependency: must update after sys0
+        auto* sys3 = systemManager->AddSystem<SchedulerTestSystem<3>>( engine, workMS, 0u, 3u );
+        // Reads the component sys1 writes: no dependency, but the two must never update at the same time
+        auto* sys4 = systemManager->AddSystem<SchedulerTestSystem<4>>( engine, workMS, g_none, 1u );
+
+        sys3->AddDependencies( sys0 );
+        sys4->ReadsComponents<SchedulerTestComponent<1>>();
+        systemManager->UpdateSystemWorkOrder();
+
+        CHECK_TRUE( sys4->ConflictsWith( *sys1 ) );
+        CHECK_FALSE( sys4->ConflictsWith( *sys0 ) );
+
+        ECSSystemScheduler scheduler( *systemManager, pool );
+        systemManager->SetSystemScheduler( &scheduler );
+        CHECK_EQUAL( scheduler.systemTimings().size(), g_testSystemCount );
+        // Parallel updates are opt-in
+        CHECK_FALSE( scheduler.parallelUpdate() );
+
+        U64 parallelWallUS = 0u, serialWallUS = 0u;
+        for ( U8 run = 0u; run < 2u; ++run )
+        {
+            const bool parallel = run == 0u;
+            scheduler.parallelUpdate( parallel );
+
+            ResetTestState();
+            engine.PreUpdate( 16.f );
+            engine.Update( 16.f );
+            engine.PostUpdate( 16.f );
+
+            CHECK_FALSE( g_orderViolated.load() );
+            CHECK_FALSE( g_resourceOverlap.load() );
+            for ( size_t i = 0u; i < g_testSystemCount; ++i )
+            {
+                CHECK_TRUE( g_systemDone[i].load() );
+            }
+
+            const ECSSystemScheduler::StageTimings& timings = scheduler.stageTimings( ECS::SystemStage::UPDATE );
+            CHECK_EQUAL( timings._runCount, run + 1u );
+            CHECK_TRUE( timings._lastSystemUS > 0u );
+            for ( const ECSSystemScheduler::SystemTimings& systemTimings : scheduler.systemTimings() )
+            {
+                CHECK_TRUE( systemTimings._lastUS[to_base( ECS::SystemStage::UPDATE )] > 0u );
+            }
+
+            if ( parallel )
+            {
+                parallelWallUS = timings._lastWallUS;
+            }
+            else
+            {
+                serialWallUS = timings._lastWallUS;
+            }
+        }
+
+        std::cout << Util::StringFormat( "ECS system scheduler: serial update {} us, parallel update {} us", serialWallUS, parallelWallUS ) << std::endl;
+
+        if ( std::thread::hardware_concurrency() >= 4u )
+        {
+            // Critical path is two systems long, the serial path is five
+            CHECK_TRUE( parallelWallUS < serialWallUS );
+        }
+
+        systemManager->SetSystemScheduler( nullptr );
+    }
+
+    pool.shutdown();
+}
+
+TEST_CASE( "ECS System Scheduler Undeclared Access Test", "[ecs_scheduler]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool pool( "ECS_SCHEDULER_UNDECLARED_TEST" );
+    const bool init = pool.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    {
+        ECS::ECSEngine engine;
+        ECS::SystemManager* systemManager = engine.GetSystemManager();
+
+        // No component overlap, but sys1 never declared what it reads, so it may touch the same things sys0 does
+        constexpr D64 workMS = 4.0;
+        auto* sys0 = systemManager->AddSystem<SchedulerTestSystem<0>>( engine, workMS, g_none, 0u );
+        auto* sys1 = systemManager->AddSystem<SchedulerTestSystem<1>>( engine, workMS, g_none, 0u, false );
+        systemManager->UpdateSystemWorkOrder();
+
+        CHECK_TRUE( sys0->HasDeclaredComponentAccess() );
+        CHECK_FALSE( sys1->HasDeclaredComponentAccess() );
+        CHECK_FALSE( sys1->ConflictsWith( *sys0 ) );
+
+        ECSSystemScheduler scheduler( *systemManager, pool );
+        systemManager->SetSystemScheduler( &scheduler );
+        scheduler.parallelUpdate( true );
+
+        ResetTestState();
+        engine.Update( 16.f );
+
+        CHECK_FALSE( g_resourceOverlap.load() );
+        CHECK_TRUE( g_systemDone[0].load() );
+        CHECK_TRUE( g_systemDone[1].load() );
+
+        systemManager->SetSystemScheduler( nullptr );
+    }
+
+    pool.shutdown();
+}
+
+} //namespace Divide
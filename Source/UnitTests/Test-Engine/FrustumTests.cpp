@@ -0,0 +1,182 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Core/Math/BoundingVolumes/Headers/BoundingBox.h"
+#include "Core/Math/BoundingVolumes/Headers/BoundingSphere.h"
+#include "Rendering/Camera/Headers/Camera.h"
+#include "Rendering/Camera/Headers/Frustum.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    struct TestVolumes
+    {
+        vector<F32> _centerX, _centerY, _centerZ, _radius;
+        vector<F32> _minX, _minY, _minZ, _maxX, _maxY, _maxZ;
+        vector<BoundingSphere> _spheres;
+        vector<BoundingBox> _boxes;
+
+        [[nodiscard]] BoundingSpheresSoA spheres() const noexcept
+        {
+            return { _centerX.data(), _centerY.data(), _centerZ.data(), _radius.data(), _spheres.size() };
+        }
+
+        [[nodiscard]] BoundingBoxesSoA boxes() const noexcept
+        {
+            return { _minX.data(), _minY.data(), _minZ.data(), _maxX.data(), _maxY.data(), _maxZ.data(), _boxes.size() };
+        }
+    };
+
+    TestVolumes MakeVolumes( const size_t count, std::mt19937& rng )
+    {
+        std::uniform_real_distribution<F32> position( -500.f, 500.f );
+        std::uniform_real_distribution<F32> size( 0.5f, 20.f );
+
+        TestVolumes ret;
+        for ( size_t i = 0u; i < count; ++i )
+        {
+            const float3 min{ position( rng ), position( rng ), position( rng ) };
+            const BoundingBox& box = ret._boxes.emplace_back( min, min + float3{ size( rng ), size( rng ), size( rng ) } );
+            const BoundingSphere& sphere = ret._spheres.emplace_back( box.getCenter(), size( rng ) );
+
+            ret._minX.push_back( box._min.x ); ret._minY.push_back( box._min.y ); ret._minZ.push_back( box._min.z );
+            ret._maxX.push_back( box._max.x ); ret._maxY.push_back( box._max.y ); ret._maxZ.push_back( box._max.z );
+            ret._centerX.push_back( sphere._sphere.center.x );
+            ret._centerY.push_back( sphere._sphere.center.y );
+            ret._centerZ.push_back( sphere._sphere.center.z );
+            ret._radius.push_back( sphere._sphere.radius );
+        }
+
+        return ret;
+    }
+
+    Frustum MakeFrustum( const float3& eye, const float3& target )
+    {
+        mat4<F32> viewProjection;
+        mat4<F32>::Multiply( Camera::Perspective( Angle::DEGREES_F( 60.f ), 16.f / 9.f, 0.1f, 600.f ),
+                             Camera::LookAt( eye, target, WORLD_Y_AXIS ),
+                             viewProjection );
+
+        Frustum frustum;
+        frustum.computePlanes( viewProjection );
+        return frustum;
+    }
+
+    /// Reference result: check every plane, one volume at a time
+    FrustumCollision ClassifySphere( const Frustum& frustum, const BoundingSphere& sphere )
+    {
+        FrustumCollision ret = FrustumCollision::FRUSTUM_IN;
+        for ( const Plane<F32>& plane : frustum.planes() )
+        {
+            switch ( PlaneBoundingSphereIntersect( plane, sphere ) )
+            {
+                case FrustumCollision::FRUSTUM_OUT: return FrustumCollision::FRUSTUM_OUT;
+                case FrustumCollision::FRUSTUM_INTERSECT: ret = FrustumCollision::FRUSTUM_INTERSECT; break;
+                default: break;
+            }
+        }
+        return ret;
+    }
+}
+
+TEST_CASE( "Frustum Batched Test", "[frustum]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    std::mt19937 rng( 5u );
+
+    // Odd count so the SIMD loops leave a scalar tail to process
+    constexpr size_t volumeCount = 1'003u;
+    const TestVolumes volumes = MakeVolumes( volumeCount, rng );
+
+    const float3 eye{ 10.f, 20.f, -30.f };
+    const Frustum frustum = MakeFrustum( eye, float3{ 100.f, 0.f, 100.f } );
+
+    vector<FrustumCollision> sphereResults( volumeCount ), boxResults( volumeCount );
+    vector<F32> sphereDistances( volumeCount ), boxDistances( volumeCount );
+    frustum.ContainsSpheres( volumes.spheres(), eye, sphereResults.data(), sphereDistances.data() );
+    frustum.ContainsBoundingBoxes( volumes.boxes(), eye, boxResults.data(), boxDistances.data() );
+
+    size_t sphereMismatches = 0u, boxMismatches = 0u, distanceMismatches = 0u, visibleBoxes = 0u;
+    for ( size_t i = 0u; i < volumeCount; ++i )
+    {
+        sphereMismatches += sphereResults[i] != ClassifySphere( frustum, volumes._spheres[i] ) ? 1u : 0u;
+        boxMismatches += boxResults[i] != frustum.ClassifyBoundingBox( volumes._boxes[i] ) ? 1u : 0u;
+        visibleBoxes += boxResults[i] != FrustumCollision::FRUSTUM_OUT ? 1u : 0u;
+
+        const F32 sphereDistance = volumes._spheres[i].getDistanceSQFromPoint( eye );
+        const F32 boxDistance = volumes._boxes[i].nearestPoint( eye ).distanceSquared( eye );
+        // Operation order may differ slightly from the single volume versions, so allow for some rounding error
+        distanceMismatches += !COMPARE_TOLERANCE( sphereDistances[i], sphereDistance, std::max( sphereDistance * 1e-5f, 1e-3f ) ) ? 1u : 0u;
+        distanceMismatches += !COMPARE_TOLERANCE( boxDistances[i], boxDistance, std::max( boxDistance * 1e-5f, 1e-3f ) ) ? 1u : 0u;
+    }
+
+    CHECK_EQUAL( sphereMismatches, 0u );
+    CHECK_EQUAL( boxMismatches, 0u );
+    CHECK_EQUAL( distanceMismatches, 0u );
+    // Make sure the test actually covers visible volumes
+    CHECK_TRUE( visibleBoxes > 0u );
+
+    // Distances are optional
+    frustum.ContainsBoundingBoxes( volumes.boxes(), eye, boxResults.data() );
+    CHECK_EQUAL( boxResults[0], frustum.ClassifyBoundingBox( volumes._boxes[0] ) );
+}
+
+TEST_CASE( "Frustum Batched Speed Test", "[frustum]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    std::mt19937 rng( 11u );
+
+    constexpr size_t volumeCount = 100'000u;
+    constexpr size_t runCount = 16u;
+    const TestVolumes volumes = MakeVolumes( volumeCount, rng );
+
+    const float3 eye{ 0.f, 0.f, 0.f };
+    const Frustum frustum = MakeFrustum( eye, float3{ 1.f, 0.f, 1.f } );
+
+    vector<FrustumCollision> results( volumeCount );
+    vector<F32> distances( volumeCount );
+
+    size_t scalarVisible = 0u, batchedVisible = 0u;
+
+    const D64 scalarStart = Time::App::ElapsedMicroseconds();
+    for ( size_t run = 0u; run < runCount; ++run )
+    {
+        for ( size_t i = 0u; i < volumeCount; ++i )
+        {
+            distances[i] = volumes._boxes[i].nearestPoint( eye ).distanceSquared( eye );
+            results[i] = frustum.ClassifyBoundingBox( volumes._boxes[i] );
+        }
+    }
+    const D64 scalarDurationUS = Time::App::ElapsedMicroseconds() - scalarStart;
+    for ( const FrustumCollision result : results )
+    {
+        scalarVisible += result != FrustumCollision::FRUSTUM_OUT ? 1u : 0u;
+    }
+
+    const D64 batchedStart = Time::App::ElapsedMicroseconds();
+    for ( size_t run = 0u; run < runCount; ++run )
+    {
+        frustum.ContainsBoundingBoxes( volumes.boxes(), eye, results.data(), distances.data() );
+    }
+    const D64 batchedDurationUS = Time::App::ElapsedMicroseconds() - batchedStart;
+    for ( const FrustumCollision result : results )
+    {
+        batchedVisible += result != FrustumCollision::FRUSTUM_OUT ? 1u : 0u;
+    }
+
+    CHECK_EQUAL( scalarVisible, batchedVisible );
+
+    std::cout << Util::StringFormat( "Frustum AABB test speed [ {} boxes ]: scalar {:.2f} us/run, batched {:.2f} us/run",
+                                     volumeCount,
+                                     scalarDurationUS / runCount,
+                                     batchedDurationUS / runCount ) << std::endl;
+}
+
+} //namespace Divide
@@ -0,0 +1,91 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Headers/LoopTimingData.h"
+
+namespace Divide
+{
+
+namespace
+{
+    constexpr U8 MAX_FRAME_SKIP = 4u;
+
+    /// Same stepping as Kernel::mainLoopScene. Returns the number of simulation steps taken this frame
+    U8 RunFrame( LoopTimingData& timingData, const U64 elapsedTimeUS, const U64 fixedStepUS )
+    {
+        timingData.update( elapsedTimeUS, fixedStepUS );
+
+        U8 loopCount = 0u;
+        while ( timingData.accumulator() >= fixedStepUS )
+        {
+            timingData.accumulator( timingData.accumulator() - fixedStepUS );
+            if ( ++loopCount == MAX_FRAME_SKIP )
+            {
+                timingData.accumulator( fixedStepUS );
+                break;
+            }
+        }
+
+        return loopCount;
+    }
+}
+
+TEST_CASE( "Loop Timing Tick Rate Test", "[loop_timing]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    // A dedicated server sleeps one tick interval per frame and uses that interval as its simulation step (--tickRate).
+    // Every frame must then run exactly one step, including rates slow enough for a tick to exceed MAX_FRAME_TIME_US
+    constexpr U32 tickRates[] = { 1u, 2u, 5u, 7u, TICKS_PER_SECOND, 128u, 1000u };
+    constexpr U32 frameCount = 200u;
+
+    for ( const U32 tickRate : tickRates )
+    {
+        const U64 fixedStepUS = Time::SecondsToMicroseconds<U64>( 1 ) / tickRate;
+
+        LoopTimingData timingData;
+        timingData.freezeGameTime( false );
+
+        bool oneStepPerFrame = true;
+        bool alphaInRange = true;
+        U64 elapsedTimeUS = 0u;
+        for ( U32 frame = 0u; frame < frameCount; ++frame )
+        {
+            elapsedTimeUS += fixedStepUS;
+            oneStepPerFrame = RunFrame( timingData, elapsedTimeUS, fixedStepUS ) == 1u && oneStepPerFrame;
+
+            const F32 alpha = timingData.alpha();
+            alphaInRange = alpha >= 0.f && alpha <= 1.f && alphaInRange;
+        }
+
+        CHECK_TRUE( oneStepPerFrame );
+        CHECK_TRUE( alphaInRange );
+        CHECK_EQUAL( timingData.fixedStepUS(), fixedStepUS );
+        // Game time advances by one step per frame, so it follows the tick rate instead of the default update rate
+        CHECK_EQUAL( timingData.gameCurrentTimeUS(), fixedStepUS * frameCount );
+    }
+}
+
+TEST_CASE( "Loop Timing Catch Up Test", "[loop_timing]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr U64 fixedStepUS = FIXED_UPDATE_RATE_US;
+
+    LoopTimingData timingData;
+    timingData.freezeGameTime( false );
+
+    U64 elapsedTimeUS = fixedStepUS;
+    CHECK_EQUAL( RunFrame( timingData, elapsedTimeUS, fixedStepUS ), 1u );
+
+    // A frame that took 2.5 steps runs 2 steps and carries the rest over
+    elapsedTimeUS += fixedStepUS * 5u / 2u;
+    CHECK_EQUAL( RunFrame( timingData, elapsedTimeUS, fixedStepUS ), 2u );
+    CHECK_EQUAL( timingData.accumulator(), fixedStepUS / 2u );
+
+    // A long stall is clamped to MAX_FRAME_TIME_US and stops at MAX_FRAME_SKIP instead of running every missed step
+    elapsedTimeUS += Time::SecondsToMicroseconds<U64>( 5 );
+    CHECK_EQUAL( RunFrame( timingData, elapsedTimeUS, fixedStepUS ), MAX_FRAME_SKIP );
+    CHECK_EQUAL( timingData.accumulator(), fixedStepUS );
+}
+
+} //namespace Divide
@@ -0,0 +1,242 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Rendering/RenderPass/Headers/MaterialSlotCache.h"
+
+#include <iostream>
+#include <thread>
+
+namespace Divide
+{
+
+namespace
+{
+    U32 Insert( MaterialSlotCache& cache, const size_t hash, bool& insertedOut, bool& grewOut )
+    {
+        insertedOut = grewOut = false;
+        return cache.findOrInsert( hash, [&insertedOut, &grewOut]( [[maybe_unused]] const U32 slot, const bool grew )
+        {
+            insertedOut = true;
+            grewOut = grew;
+        } );
+    }
+
+    /// Same matching logic RenderPassExecutor used before the slot cache: scan all slots for the hash, then for a free or expired one
+    struct LinearSlotCache
+    {
+        struct Info
+        {
+            size_t _hash{ MaterialSlotCache::INVALID_HASH };
+            U64 _framesSinceLastUsed{ MaterialSlotCache::MAX_FRAME_LIFETIME };
+        };
+
+        vector<Info> _slots;
+
+        U32 findOrInsert( const size_t hash )
+        {
+            for ( size_t idx = 0u; idx < _slots.size(); ++idx )
+            {
+                if ( _slots[idx]._hash == hash )
+                {
+                    _slots[idx]._framesSinceLastUsed = 0u;
+                    return to_U32( idx );
+                }
+            }
+            for ( size_t idx = 0u; idx < _slots.size(); ++idx )
+            {
+                Info& info = _slots[idx];
+                if ( info._hash == MaterialSlotCache::INVALID_HASH || info._framesSinceLastUsed >= MaterialSlotCache::MAX_FRAME_LIFETIME )
+                {
+                    info = { hash, 0u };
+                    return to_U32( idx );
+                }
+            }
+            _slots.push_back( { hash, 0u } );
+            return to_U32( _slots.size() - 1u );
+        }
+
+        void onFrameEnd()
+        {
+            for ( Info& info : _slots )
+            {
+                info._framesSinceLastUsed += info._hash != MaterialSlotCache::INVALID_HASH ? 1u : 0u;
+            }
+        }
+    };
+}
+
+TEST_CASE( "Material Slot Cache Test", "[material_cache]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    MaterialSlotCache cache;
+    cache.reset( 4u );
+    CHECK_EQUAL( cache.slotCount(), 4u );
+
+    bool inserted = false, grew = false;
+    const U32 slotA = Insert( cache, 100u, inserted, grew );
+    CHECK_TRUE( inserted );
+    CHECK_FALSE( grew );
+    CHECK_EQUAL( slotA, 0u );
+
+    // Hits don't insert
+    CHECK_EQUAL( Insert( cache, 100u, inserted, grew ), slotA );
+    CHECK_FALSE( inserted );
+    CHECK_EQUAL( cache.find( 100u ), slotA );
+    CHECK_EQUAL( cache.find( 200u ), MaterialSlotCache::INVALID_SLOT );
+
+    for ( size_t hash = 101u; hash < 104u; ++hash )
+    {
+        [[maybe_unused]] const U32 slot = Insert( cache, hash, inserted, grew );
+    }
+    CHECK_EQUAL( cache.size(), 4u );
+
+    // Every slot was used this frame, so there is nothing to evict
+    const U32 slotE = Insert( cache, 104u, inserted, grew );
+    CHECK_TRUE( grew );
+    CHECK_EQUAL( slotE, 4u );
+    CHECK_EQUAL( cache.slotCount(), 5u );
+
+    // Keep "100" alive while everything else expires
+    for ( U64 frame = 0u; frame < MaterialSlotCache::MAX_FRAME_LIFETIME; ++frame )
+    {
+        cache.onFrameEnd();
+        CHECK_EQUAL( cache.find( 100u ), slotA );
+    }
+
+    // Expired entries get recycled, oldest first, without growing. The live entry is untouched
+    const U32 slotF = Insert( cache, 105u, inserted, grew );
+    CHECK_TRUE( inserted );
+    CHECK_FALSE( grew );
+    CHECK_NOT_EQUAL( slotF, slotA );
+    CHECK_EQUAL( cache.find( 101u ), MaterialSlotCache::INVALID_SLOT );
+    CHECK_EQUAL( cache.find( 100u ), slotA );
+    CHECK_EQUAL( cache.slotCount(), 5u );
+
+    cache.reset( 2u );
+    CHECK_EQUAL( cache.size(), 0u );
+    CHECK_EQUAL( cache.find( 100u ), MaterialSlotCache::INVALID_SLOT );
+}
+
+TEST_CASE( "Material Slot Cache Concurrency Test", "[material_cache]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr size_t materialCount = 2'048u;
+    const U32 threadCount = std::max( 2u, std::thread::hardware_concurrency() );
+
+    MaterialSlotCache cache;
+    cache.reset( to_U32( materialCount ) );
+
+    // Every thread requests the same materials, so most lookups race against another thread's insertion
+    vector<vector<U32>> slots( threadCount, vector<U32>( materialCount ) );
+    std::atomic_uint insertions{ 0u };
+    {
+        vector<std::thread> threads;
+        for ( U32 t = 0u; t < threadCount; ++t )
+        {
+            threads.emplace_back( [&, t]()
+            {
+                for ( size_t i = 0u; i < materialCount; ++i )
+                {
+                    const size_t hash = (i * 7919u + t * 13u) % materialCount + 1u;
+                    slots[t][hash - 1u] = cache.findOrInsert( hash, [&insertions]( [[maybe_unused]] const U32 slot, [[maybe_unused]] const bool grew )
+                    {
+                        insertions.fetch_add( 1u );
+                    } );
+                }
+            } );
+        }
+        for ( std::thread& thread : threads )
+        {
+            thread.join();
+        }
+    }
+
+    CHECK_EQUAL( insertions.load(), materialCount );
+    CHECK_EQUAL( cache.slotCount(), materialCount );
+
+    bool slotsMatch = true;
+    vector<bool> slotUsed( materialCount, false );
+    bool slotsUnique = true;
+    for ( size_t i = 0u; i < materialCount; ++i )
+    {
+        for ( U32 t = 1u; t < threadCount; ++t )
+        {
+            slotsMatch = slotsMatch && slots[t][i] == slots[0][i];
+        }
+        slotsUnique = slotsUnique && !slotUsed[slots[0][i]];
+        slotUsed[slots[0][i]] = true;
+    }
+    CHECK_TRUE( slotsMatch );
+    CHECK_TRUE( slotsUnique );
+}
+
+TEST_CASE( "Material Slot Cache Speed Test", "[material_cache]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr size_t materialCounts[] = { 1'000u, 4'000u };
+    constexpr size_t frameCount = 8u;
+
+    for ( const size_t materialCount : materialCounts )
+    {
+        // Half of the materials change every frame, so each frame has both hits and misses that need an expired slot
+        const auto hashForFrame = [materialCount]( const size_t frame, const size_t i )
+        {
+            return i % 2u == 0u ? i + 1u : (frame * materialCount + i) + 1u;
+        };
+
+        // Start with exactly one frame's worth of slots, so later frames have to grow and then recycle expired slots.
+        // Both implementations then hand out the same slots in the same order, which lets us compare them request by request
+        MaterialSlotCache cache;
+        cache.reset( to_U32( materialCount ) );
+        LinearSlotCache linear;
+        linear._slots.resize( materialCount );
+
+        vector<U32> linearSlots( frameCount * materialCount ), cacheSlots( frameCount * materialCount );
+        size_t cacheInserts = 0u;
+
+        const D64 linearStart = Time::App::ElapsedMicroseconds();
+        for ( size_t frame = 0u; frame < frameCount; ++frame )
+        {
+            for ( size_t i = 0u; i < materialCount; ++i )
+            {
+                linearSlots[frame * materialCount + i] = linear.findOrInsert( hashForFrame( frame, i ) );
+            }
+            linear.onFrameEnd();
+        }
+        const D64 linearDurationUS = Time::App::ElapsedMicroseconds() - linearStart;
+
+        const D64 cacheStart = Time::App::ElapsedMicroseconds();
+        for ( size_t frame = 0u; frame < frameCount; ++frame )
+        {
+            for ( size_t i = 0u; i < materialCount; ++i )
+            {
+                cacheSlots[frame * materialCount + i] = cache.findOrInsert( hashForFrame( frame, i ), [&cacheInserts]( [[maybe_unused]] const U32 slot, [[maybe_unused]] const bool grew )
+                {
+                    ++cacheInserts;
+                } );
+            }
+            cache.onFrameEnd();
+        }
+        const D64 cacheDurationUS = Time::App::ElapsedMicroseconds() - cacheStart;
+
+        size_t slotMismatches = 0u;
+        for ( size_t request = 0u; request < cacheSlots.size(); ++request )
+        {
+            slotMismatches += cacheSlots[request] == linearSlots[request] ? 0u : 1u;
+        }
+
+        CHECK_EQUAL( slotMismatches, 0u );
+        CHECK_EQUAL( cacheInserts, materialCount + (frameCount - 1u) * (materialCount / 2u) );
+
+        std::cout << Util::StringFormat( "Material slot matching speed test [ {} materials, {} frames ]: linear scan {:.2f} us/frame, slot cache {:.2f} us/frame",
+                                         materialCount,
+                                         frameCount,
+                                         linearDurationUS / frameCount,
+                                         cacheDurationUS / frameCount ) << std::endl;
+    }
+}
+
+} //namespace Divide
@@ -0,0 +1,427 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Math/Headers/TransformInterface.h"
+#include "Networking/Headers/Client.h"
+#include "Networking/Headers/Server.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    quatf RandomOrientation( std::mt19937& rng )
+    {
+        std::normal_distribution<F32> component( 0.f, 1.f );
+        quatf ret( component( rng ), component( rng ), component( rng ), component( rng ) );
+        ret.normalize();
+        return ret;
+    }
+
+    [[nodiscard]] bool SameBytes( const ByteBuffer& lhs, const ByteBuffer& rhs )
+    {
+        return lhs.bufferSize() == rhs.bufferSize() &&
+               (lhs.bufferSize() == 0u || memcmp( lhs.contents() + lhs.rpos(), rhs.contents() + rhs.rpos(), lhs.bufferSize() ) == 0);
+    }
+
+    /// An entity as NetworkingComponent would replicate it: transform, followed by some node specific data
+    struct TestEntity
+    {
+        TransformValues _transform;
+        float3 _velocity;
+        F32 _angularSpeed{ 0.f };
+        U32 _health{ 100u };
+
+        void update( const F32 dt )
+        {
+            _transform._translation += _velocity * dt;
+            _transform._orientation = _transform._orientation * quatf( WORLD_Y_AXIS, Angle::RADIANS_F( _angularSpeed * dt ) );
+        }
+
+        void writeState( ByteBuffer& stateOut ) const
+        {
+            stateOut << true;
+            Networking::WriteTransform( stateOut, _transform );
+            stateOut << _health;
+        }
+    };
+
+    /// Owns the replicated entities and streams their states to the server, delta compressed against what the server acknowledged. Same as NetworkingComponent does
+    class OwnerClient final : public Networking::Client
+    {
+    public:
+        explicit OwnerClient( const size_t entityCount )
+            : _encoders( entityCount )
+        {
+        }
+
+        void sendState( const I64 guid, const U32 frameCount, const ByteBuffer& state )
+        {
+            Networking::NetworkPacket msg{ Networking::OPCodes::CMSG_ENTITY_UPDATE };
+            msg << guid;
+            msg << frameCount;
+
+            _scratch.clear();
+            _encoders[guid - FirstGUID].encode( state, _scratch );
+            msg.append( _scratch.contents(), _scratch.bufferSize() );
+            send( msg );
+        }
+
+        static constexpr I64 FirstGUID = 1000;
+
+    protected:
+        void receiveMessage( Networking::NetworkPacket& msg ) override
+        {
+            if ( msg.header()._opCode != Networking::OPCodes::SMSG_ENTITY_ACK )
+            {
+                Client::receiveMessage( msg );
+                return;
+            }
+
+            I64 guid{ -1 };
+            U32 sequence{ 0u };
+            msg >> guid;
+            msg >> sequence;
+            _encoders[guid - FirstGUID].onAck( sequence );
+        }
+
+    private:
+        vector<Networking::DeltaEncoder> _encoders;
+        ByteBuffer _scratch;
+    };
+
+    /// Receives the entities the server replicates and checks every decoded state against what the owner sent for that frame
+    class ObserverClient final : public Networking::Client
+    {
+    public:
+        /// droppedUpdates: updates to throw away per entity once we are in sync, as if they were lost on the way
+        explicit ObserverClient( const vector<vector<ByteBuffer>>& sentStates, const U32 droppedUpdates = 0u )
+            : _sentStates( sentStates )
+            , _decoders( sentStates.size() )
+            , _synced( sentStates.size(), false )
+            , _dropped( sentStates.size(), 0u )
+            , _droppedUpdates( droppedUpdates )
+        {
+        }
+
+        [[nodiscard]] U64 bytesReceived() const noexcept { return _connection != nullptr ? _connection->bytesReceived() : 0u; }
+
+        size_t _updates{ 0u };
+        /// Delta compressed entity states, as sent by the server ([sequence][baseline][delta])
+        size_t _deltaBytes{ 0u };
+        /// What the same states would have cost without a baseline
+        size_t _fullStateBytes{ 0u };
+        size_t _mismatches{ 0u };
+        /// Updates we couldn't decode after we decoded a full state for the entity
+        size_t _failuresAfterSync{ 0u };
+
+        [[nodiscard]] size_t syncedCount() const { return to_size( eastl::count( _synced.begin(), _synced.end(), true ) ); }
+
+    protected:
+        void receiveMessage( Networking::NetworkPacket& msg ) override
+        {
+            switch ( msg.header()._opCode )
+            {
+                case Networking::OPCodes::SMSG_ENTITY_ENTER:
+                {
+                    I64 guid{ -1 };
+                    msg >> guid;
+                    _decoders[guid - OwnerClient::FirstGUID].reset();
+                } break;
+                case Networking::OPCodes::SMSG_ENTITY_UPDATE:
+                {
+                    U32 srcID{ 0u };
+                    I64 guid{ -1 };
+                    U32 frameCount{ 0u };
+                    U64 serverTimeUS{ 0u };
+                    msg >> srcID;
+                    msg >> guid;
+                    msg >> frameCount;
+                    msg >> serverTimeUS;
+
+                    const size_t entity = to_size( guid - OwnerClient::FirstGUID );
+                    const ByteBuffer& expected = _sentStates[entity][frameCount];
+
+                    const ByteBuffer& body = msg.body();
+
+                    // [sequence][no baseline][full state]
+                    _fullState.clear();
+                    Networking::DeltaCodec::Encode( expected, ByteBuffer{}, _fullState );
+
+                    ++_updates;
+                    _deltaBytes += body.bufferSize();
+                    _fullStateBytes += sizeof( U32 ) + sizeof( U8 ) + _fullState.bufferSize();
+
+                    if ( _synced[entity] && _dropped[entity] < _droppedUpdates )
+                    {
+                        // No decode and no ack. The server keeps encoding against the last state we acked, until that falls out of its history and it sends a full state
+                        ++_dropped[entity];
+                        break;
+                    }
+
+                    U32 sequence = Networking::DeltaEncoder::INVALID_SEQUENCE;
+                    if ( _decoders[entity].decode( body.contents() + body.rpos(), body.bufferSize(), _state, sequence ) )
+                    {
+                        _synced[entity] = true;
+                        _mismatches += SameBytes( _state, expected ) ? 0u : 1u;
+
+                        Networking::NetworkPacket ackOut{ Networking::OPCodes::CMSG_ENTITY_UPDATE_ACK };
+                        ackOut << guid;
+                        ackOut << sequence;
+                        send( ackOut );
+                    }
+                    else if ( _synced[entity] )
+                    {
+                        ++_failuresAfterSync;
+                    }
+                } break;
+                default:
+                {
+                    Client::receiveMessage( msg );
+                } break;
+            }
+        }
+
+    private:
+        const vector<vector<ByteBuffer>>& _sentStates;
+        vector<Networking::DeltaDecoder> _decoders;
+        vector<bool> _synced;
+        vector<U32> _dropped;
+        const U32 _droppedUpdates{ 0u };
+        ByteBuffer _state;
+        ByteBuffer _fullState;
+    };
+}
+
+TEST_CASE( "Network Transform Quantization Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    // appendPackXYZ / readPackXYZ must handle negative values
+    {
+        ByteBuffer buffer;
+        buffer.appendPackXYZ( -1.25f, 200.5f, -100.75f );
+        F32 x = 0.f, y = 0.f, z = 0.f;
+        buffer.readPackXYZ( x, y, z );
+        CHECK_EQUAL( x, -1.25f );
+        CHECK_EQUAL( y, 200.5f );
+        CHECK_EQUAL( z, -100.75f );
+    }
+
+    std::mt19937 rng( 31u );
+    std::uniform_real_distribution<F32> position( -5000.f, 5000.f );
+    std::uniform_real_distribution<F32> scale( 0.1f, 10.f );
+
+    F32 maxPositionError = 0.f, maxOrientationError = 0.f;
+    bool scaleMatches = true, deterministic = true;
+    for ( size_t i = 0u; i < 10'000u; ++i )
+    {
+        TransformValues values{};
+        values._translation.set( position( rng ), position( rng ), position( rng ) );
+        values._orientation = RandomOrientation( rng );
+        values._scale.set( scale( rng ), scale( rng ), scale( rng ) );
+
+        ByteBuffer buffer, bufferAgain;
+        Networking::WriteTransform( buffer, values );
+        Networking::WriteTransform( bufferAgain, values );
+        deterministic = deterministic && SameBytes( buffer, bufferAgain );
+
+        TransformValues result{};
+        Networking::ReadTransform( buffer, result );
+        CHECK_TRUE( buffer.bufferEmpty() );
+
+        for ( U8 c = 0u; c < 3u; ++c )
+        {
+            maxPositionError = std::max( maxPositionError, std::abs( result._translation[c] - values._translation[c] ) );
+        }
+        // q and -q are the same rotation
+        maxOrientationError = std::max( maxOrientationError, 1.f - std::abs( result._orientation.dot( values._orientation ) ) );
+        scaleMatches = scaleMatches && result._scale == values._scale;
+    }
+
+    CHECK_TRUE( deterministic );
+    CHECK_TRUE( scaleMatches );
+    CHECK_TRUE( maxPositionError <= 1.f / 1024.f );
+    // 1 - cos(angle / 2) for an error of about 0.25 degrees
+    CHECK_TRUE( maxOrientationError < 3e-6f );
+}
+
+TEST_CASE( "Network Delta Codec Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    std::mt19937 rng( 5u );
+    std::uniform_int_distribution<U32> byteValue( 0u, 255u );
+    std::uniform_int_distribution<size_t> size( 0u, 600u );
+    std::uniform_real_distribution<F32> chance( 0.f, 1.f );
+
+    bool allMatch = true;
+    size_t encodedBytes = 0u, stateBytes = 0u;
+    for ( size_t i = 0u; i < 500u; ++i )
+    {
+        ByteBuffer baseline, state;
+        const size_t baselineSize = size( rng );
+        for ( size_t b = 0u; b < baselineSize; ++b )
+        {
+            baseline << to_U8( byteValue( rng ) );
+        }
+
+        // Mostly the baseline with a few changes, but also shorter, longer or completely different states
+        const size_t stateSize = i % 4u == 0u ? size( rng ) : baselineSize;
+        const F32 changeChance = i % 8u == 1u ? 1.f : 0.05f;
+        for ( size_t b = 0u; b < stateSize; ++b )
+        {
+            const U8 value = b < baselineSize ? to_U8( baseline.contents()[b] ) : U8_ZERO;
+            state << (chance( rng ) < changeChance ? to_U8( byteValue( rng ) ) : value);
+        }
+
+        ByteBuffer encoded, decoded;
+        Networking::DeltaCodec::Encode( state, baseline, encoded );
+        allMatch = Networking::DeltaCodec::Decode( encoded.contents(), encoded.bufferSize(), baseline, decoded ) && SameBytes( state, decoded ) && allMatch;
+
+        if ( stateSize == baselineSize && changeChance < 1.f )
+        {
+            encodedBytes += encoded.bufferSize();
+            stateBytes += stateSize;
+        }
+    }
+
+    CHECK_TRUE( allMatch );
+    // 5% of the bytes changed, so the deltas have to be a lot smaller than the states
+    CHECK_TRUE( encodedBytes * 3u < stateBytes );
+
+    // Unchanged state: just the size
+    ByteBuffer state, encoded, decoded;
+    state << 1234u << 5.f;
+    Networking::DeltaCodec::Encode( state, state, encoded );
+    CHECK_EQUAL( encoded.bufferSize(), sizeof( U16 ) );
+
+    // Malformed input: literals past the end of the state
+    const Byte malformed[] = { Byte{ 2u }, Byte{ 0u }, Byte{ 0x85u }, Byte{ 1u }, Byte{ 2u }, Byte{ 3u }, Byte{ 4u }, Byte{ 5u }, Byte{ 6u } };
+    CHECK_FALSE( Networking::DeltaCodec::Decode( malformed, std::size( malformed ), state, decoded ) );
+    CHECK_FALSE( Networking::DeltaCodec::Decode( malformed, 1u, state, decoded ) );
+}
+
+TEST_CASE( "Network Delta Loopback Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    using namespace Networking;
+
+    constexpr size_t entityCount = 64u;
+    constexpr size_t tickCount = 300u;
+    constexpr F32 dt = 1.f / 30.f;
+    constexpr size_t lateJoinTick = 100u;
+    constexpr U16 port = NetworkingPort + 100u;
+
+    std::mt19937 rng( 77u );
+    std::uniform_real_distribution<F32> position( -500.f, 500.f );
+    std::uniform_real_distribution<F32> speed( -5.f, 5.f );
+
+    vector<TestEntity> entities( entityCount );
+    for ( size_t i = 0u; i < entityCount; ++i )
+    {
+        TestEntity& entity = entities[i];
+        entity._transform._translation.set( position( rng ), position( rng ), position( rng ) );
+        entity._transform._orientation = RandomOrientation( rng );
+        // A quarter of the entities never move, a quarter only rotates
+        if ( i % 4u >= 2u )
+        {
+            entity._velocity.set( speed( rng ), 0.f, speed( rng ) );
+        }
+        if ( i % 4u != 0u )
+        {
+            entity._angularSpeed = speed( rng );
+        }
+    }
+
+    // Every state the owner sent, per entity and frame, so observers can check what they decoded
+    vector<vector<ByteBuffer>> sentStates( entityCount, vector<ByteBuffer>( tickCount ) );
+
+    Server server( port );
+    CHECK_TRUE( server.start() );
+
+    OwnerClient owner( entityCount );
+    // The late observer connects once the streams are running and starts with no baselines, so the server has to send it full states first.
+    // It then loses more updates per entity than the server remembers and must still get back in sync without any decode failures
+    ObserverClient observer( sentStates ), lateObserver( sentStates, DeltaEncoder::HistorySize + 8u );
+
+    const auto pump = [&]( const size_t iterations )
+    {
+        for ( size_t i = 0u; i < iterations; ++i )
+        {
+            server.update();
+            server.replicate();
+            owner.update();
+            observer.update();
+            lateObserver.update();
+            std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+        }
+    };
+
+    const auto connect = [&]( Client& client )
+    {
+        const bool connected = client.connect( LocalHostAddress, port );
+        CHECK_TRUE( connected );
+        // Give the TCP handshake and the UDP channel a moment to come up
+        pump( 50u );
+    };
+
+    connect( owner );
+    connect( observer );
+    CHECK_TRUE( owner.isConnected() );
+    CHECK_TRUE( observer.isConnected() );
+
+    const U64 startBytes = observer.bytesReceived();
+    for ( size_t tick = 0u; tick < tickCount; ++tick )
+    {
+        if ( tick == lateJoinTick )
+        {
+            connect( lateObserver );
+        }
+
+        for ( size_t i = 0u; i < entityCount; ++i )
+        {
+            entities[i].update( dt );
+
+            ByteBuffer& state = sentStates[i][tick];
+            entities[i].writeState( state );
+            owner.sendState( OwnerClient::FirstGUID + to_I64( i ), to_U32( tick ), state );
+        }
+
+        pump( 1u );
+    }
+    // Let the last updates arrive
+    pump( 50u );
+    const U64 observedBytes = observer.bytesReceived() - startBytes;
+
+    CHECK_EQUAL( observer.syncedCount(), entityCount );
+    CHECK_EQUAL( observer._mismatches, 0u );
+    CHECK_EQUAL( observer._failuresAfterSync, 0u );
+    CHECK_EQUAL( lateObserver.syncedCount(), entityCount );
+    CHECK_EQUAL( lateObserver._mismatches, 0u );
+    CHECK_EQUAL( lateObserver._failuresAfterSync, 0u );
+    // The server only forwards the latest state it has when it replicates, so some frames get skipped. Most should make it though
+    CHECK_TRUE( observer._updates * 4u > entityCount * tickCount );
+    // Static entities and unchanged fields should cost next to nothing
+    CHECK_TRUE( observer._deltaBytes * 2u < observer._fullStateBytes );
+
+    const D64 perEntityTick = to_D64( entityCount * tickCount );
+    std::cout << Util::StringFormat( "Entity replication over loopback [ {} entities, {} ticks ]: {:.2f} bytes/entity/tick received ({:.2f} of them delta compressed state, {:.2f} with full states), {} of {} updates delivered",
+                                     entityCount,
+                                     tickCount,
+                                     observedBytes / perEntityTick,
+                                     observer._deltaBytes / perEntityTick,
+                                     observer._fullStateBytes / perEntityTick,
+                                     observer._updates,
+                                     entityCount * tickCount ) << std::endl;
+
+    lateObserver.disconnect();
+    observer.disconnect();
+    owner.disconnect();
+    server.stop();
+}
+
+} //namespace Divide
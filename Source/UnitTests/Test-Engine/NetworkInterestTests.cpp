@@ -0,0 +1,256 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Networking/Headers/DeltaCodec.h"
+#include "Networking/Headers/InterestManager.h"
+#include "Networking/Headers/NetworkPacket.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    using namespace Networking;
+
+    constexpr F32 WorldSize = 2'000.f;
+    constexpr size_t StatePayloadSize = 24u;
+
+    struct SimEntity
+    {
+        float3 _position;
+        float3 _velocity;
+        InterestManager::ClientID _owner{ 0u };
+        bool _hasPosition{ true };
+        ByteBuffer _state;
+    };
+
+    struct SimClient
+    {
+        float3 _position;
+        hashMap<I64, DeltaDecoder> _decoders;
+        /// Entity -> tick it was last updated on
+        hashMap<I64, U32> _lastUpdate;
+        size_t _bytesReceived{ 0u };
+        size_t _maxBytesPerTick{ 0u };
+    };
+
+    /// Position followed by a payload that changes a few bytes every tick, roughly what NetworkingComponent::writeState produces for a moving entity
+    void WriteState(const SimEntity& entity, const U32 tick, ByteBuffer& stateOut)
+    {
+        stateOut.clear();
+        stateOut << entity._position.x << entity._position.y << entity._position.z;
+        for (size_t i = 0u; i < StatePayloadSize; ++i)
+        {
+            stateOut << to_U8(i < 4u ? tick + i : i);
+        }
+    }
+
+    /// What SMSG_ENTITY_UPDATE costs on top of the delta: packet header, owner ID, GUID, frame count and server time
+    constexpr size_t UpdateOverhead = NetworkPacket::HEADER_SIZE + sizeof(U32) + sizeof(I64) + sizeof(U32) + sizeof(U64);
+
+    bool SameState(const ByteBuffer& lhs, const ByteBuffer& rhs)
+    {
+        return lhs.bufferSize() == rhs.bufferSize() && memcmp(lhs.contents() + lhs.rpos(), rhs.contents() + rhs.rpos(), lhs.bufferSize()) == 0;
+    }
+}
+
+TEST_CASE( "Network Interest Management Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr size_t clientCount = 64u;
+    constexpr size_t entityCount = 2'000u;
+    constexpr size_t globalEntityCount = 4u;
+    constexpr U32 tickCount = 120u;
+    constexpr F32 interestRadius = 250.f;
+
+    std::mt19937 rng( 17u );
+    std::uniform_real_distribution<F32> position( 0.f, WorldSize );
+    std::uniform_real_distribution<F32> velocity( -10.f, 10.f );
+
+    InterestManager::Settings settings{};
+    settings._bytesPerClientPerTick = 2'048u;
+    InterestManager interest( settings );
+
+    // Client IDs start at 1. 0 means "no owner"
+    vector<SimClient> clients( clientCount );
+    for ( size_t i = 0u; i < clientCount; ++i )
+    {
+        clients[i]._position = { position( rng ), 0.f, position( rng ) };
+        interest.setInterest( to_U32( i + 1u ), clients[i]._position, interestRadius );
+    }
+
+    vector<SimEntity> entities( entityCount );
+    for ( size_t i = 0u; i < entityCount; ++i )
+    {
+        SimEntity& entity = entities[i];
+        entity._position = { position( rng ), 0.f, position( rng ) };
+        entity._velocity = { velocity( rng ), 0.f, velocity( rng ) };
+        entity._owner = to_U32( i % clientCount + 1u );
+        entity._hasPosition = i >= globalEntityCount;
+    }
+
+    // Server side: one delta stream per client per entity
+    hashMap<InterestManager::ClientID, hashMap<I64, DeltaEncoder>> streams;
+    ByteBuffer deltaScratch, decodedScratch;
+
+    size_t decodeFailures = 0u, stateMismatches = 0u, ownEntitiesReceived = 0u, overBudgetTicks = 0u;
+    size_t enterCount = 0u, leaveCount = 0u, broadcastBytes = 0u;
+    U32 tick = 0u;
+
+    InterestManager::Callbacks callbacks{};
+    callbacks._onEnter = [&]( const InterestManager::ClientID clientID, const I64 guid )
+    {
+        ++enterCount;
+        streams[clientID][guid].reset();
+        clients[clientID - 1u]._decoders[guid].reset();
+        clients[clientID - 1u]._lastUpdate[guid] = tick;
+    };
+    callbacks._onLeave = [&]( const InterestManager::ClientID clientID, const I64 guid )
+    {
+        ++leaveCount;
+        streams[clientID].erase( guid );
+        clients[clientID - 1u]._lastUpdate.erase( guid );
+    };
+    callbacks._onSend = [&]( const InterestManager::ClientID clientID, const I64 guid )
+    {
+        const SimEntity& entity = entities[guid];
+        SimClient& client = clients[clientID - 1u];
+        ownEntitiesReceived += entity._owner == clientID ? 1u : 0u;
+
+        DeltaEncoder& stream = streams[clientID][guid];
+        deltaScratch.clear();
+        stream.encode( entity._state, deltaScratch );
+
+        U32 sequence = 0u;
+        if ( !client._decoders[guid].decode( deltaScratch.contents(), deltaScratch.bufferSize(), decodedScratch, sequence ) )
+        {
+            ++decodeFailures;
+        }
+        else
+        {
+            // Same as the client's CMSG_ENTITY_UPDATE_ACK, minus the round trip
+            stream.onAck( sequence );
+            stateMismatches += SameState( decodedScratch, entity._state ) ? 0u : 1u;
+        }
+
+        client._lastUpdate[guid] = tick;
+        const size_t bytes = deltaScratch.bufferSize() + UpdateOverhead;
+        client._bytesReceived += bytes;
+        return bytes;
+    };
+
+    size_t totalRelevant = 0u, maxStaleTicks = 0u, outOfRange = 0u, missing = 0u;
+    for ( tick = 1u; tick <= tickCount; ++tick )
+    {
+        // Everything moves, every tick. Worst case for the send budget
+        for ( size_t i = 0u; i < entityCount; ++i )
+        {
+            SimEntity& entity = entities[i];
+            entity._position += entity._velocity;
+            entity._position.x = std::fmod( entity._position.x + WorldSize, WorldSize );
+            entity._position.z = std::fmod( entity._position.z + WorldSize, WorldSize );
+            WriteState( entity, tick, entity._state );
+
+            interest.updateEntity( to_I64( i ), entity._owner, entity._hasPosition ? &entity._position : nullptr );
+        }
+
+        for ( size_t i = 0u; i < clientCount; ++i )
+        {
+            SimClient& client = clients[i];
+            const size_t bytesBefore = client._bytesReceived;
+            interest.updateClient( to_U32( i + 1u ), callbacks );
+
+            const size_t bytesThisTick = client._bytesReceived - bytesBefore;
+            client._maxBytesPerTick = std::max( client._maxBytesPerTick, bytesThisTick );
+            // One message may go over, as we always send at least one
+            overBudgetTicks += bytesThisTick > settings._bytesPerClientPerTick + 128u ? 1u : 0u;
+            totalRelevant += interest.relevantCount( to_U32( i + 1u ) );
+
+            // Compare against a brute force check. Leaving is allowed to lag behind a bit (hysteresis), entering isn't
+            for ( size_t e = 0u; e < entityCount; ++e )
+            {
+                const SimEntity& entity = entities[e];
+                if ( entity._owner == i + 1u )
+                {
+                    continue;
+                }
+
+                const bool known = client._lastUpdate.find( to_I64( e ) ) != std::end( client._lastUpdate );
+                const F32 distance = entity._position.distance( client._position );
+                if ( !entity._hasPosition || distance <= interestRadius )
+                {
+                    missing += known ? 0u : 1u;
+                }
+                else if ( distance > interestRadius * settings._leaveRadiusFactor )
+                {
+                    outOfRange += known ? 1u : 0u;
+                }
+            }
+
+            for ( const auto& [guid, lastTick] : client._lastUpdate )
+            {
+                maxStaleTicks = std::max( maxStaleTicks, to_size( tick - lastTick ) );
+            }
+        }
+
+        // What relaying every update to every other client would cost
+        for ( const SimEntity& entity : entities )
+        {
+            deltaScratch.clear();
+            DeltaCodec::Encode( entity._state, ByteBuffer{}, deltaScratch );
+            broadcastBytes += (clientCount - 1u) * (deltaScratch.bufferSize() + UpdateOverhead);
+        }
+    }
+
+    CHECK_EQUAL( decodeFailures, 0u );
+    CHECK_EQUAL( stateMismatches, 0u );
+    CHECK_EQUAL( ownEntitiesReceived, 0u );
+    CHECK_EQUAL( overBudgetTicks, 0u );
+    CHECK_EQUAL( missing, 0u );
+    CHECK_EQUAL( outOfRange, 0u );
+    CHECK_TRUE( enterCount > 0u );
+    CHECK_TRUE( leaveCount > 0u );
+    // Far away entities get less bandwidth, but they don't starve
+    CHECK_TRUE( maxStaleTicks < 30u );
+
+    size_t totalBytes = 0u, maxBytesPerTick = 0u;
+    for ( const SimClient& client : clients )
+    {
+        totalBytes += client._bytesReceived;
+        maxBytesPerTick = std::max( maxBytesPerTick, client._maxBytesPerTick );
+    }
+    const D64 bytesPerClientPerTick = to_D64( totalBytes ) / (clientCount * tickCount);
+    const D64 broadcastBytesPerClientPerTick = to_D64( broadcastBytes ) / (clientCount * tickCount);
+    CHECK_TRUE( bytesPerClientPerTick * 4.0 < broadcastBytesPerClientPerTick );
+
+    // Removing entities (e.g. their owner disconnected) makes them leave everywhere
+    const size_t leavesBefore = leaveCount;
+    for ( size_t i = 0u; i < entityCount; ++i )
+    {
+        interest.removeEntity( to_I64( i ) );
+    }
+    size_t stillRelevant = 0u;
+    for ( size_t i = 0u; i < clientCount; ++i )
+    {
+        interest.updateClient( to_U32( i + 1u ), callbacks );
+        stillRelevant += interest.relevantCount( to_U32( i + 1u ) );
+    }
+    CHECK_EQUAL( stillRelevant, 0u );
+    CHECK_EQUAL( interest.entityCount(), 0u );
+    CHECK_TRUE( leaveCount - leavesBefore > 0u );
+
+    std::cout << Util::StringFormat( "Interest management [ {} clients, {} entities, {} ticks ]: {:.1f} relevant entities per client, {:.0f} bytes per client per tick (max {}), {:.0f} without filtering, oldest update {} ticks",
+                                     clientCount,
+                                     entityCount,
+                                     tickCount,
+                                     to_D64( totalRelevant ) / (clientCount * tickCount),
+                                     bytesPerClientPerTick,
+                                     maxBytesPerTick,
+                                     broadcastBytesPerClientPerTick,
+                                     maxStaleTicks ) << std::endl;
+}
+
+} //namespace Divide
@@ -0,0 +1,323 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Networking/Headers/SnapshotInterpolation.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    using namespace Networking;
+
+    constexpr F32 Speed = 10.f;
+    constexpr F32 AngularSpeed = 0.5f;
+    /// The server's clock started this long before ours
+    constexpr U64 ServerClockAheadUS = 3'000'000u;
+    constexpr U64 SendIntervalUS = 50'000u;
+    constexpr U64 FrameIntervalUS = 16'667u;
+    constexpr U64 BaseLatencyUS = 40'000u;
+    constexpr U64 MaxJitterUS = 30'000u;
+
+    /// Where the entity really is at this server time: moving along X and spinning around Y at a constant rate
+    TransformValues Truth(const U64 serverTimeUS)
+    {
+        const F32 seconds = to_F32(to_D64(serverTimeUS) / 1e6);
+
+        TransformValues ret{};
+        ret._translation.set(Speed * seconds, 0.f, 0.f);
+        ret._orientation = quatf(WORLD_Y_AXIS, Angle::RADIANS_F(AngularSpeed * seconds));
+        return ret;
+    }
+
+    /// TransformValues::operator== goes through acos, which is too picky for values that went through a few lerps
+    bool Near(const TransformValues& lhs, const TransformValues& rhs, const F32 tolerance = 1e-3f)
+    {
+        return lhs._translation.distance( rhs._translation ) <= tolerance &&
+               lhs._scale.distance( rhs._scale ) <= tolerance &&
+               std::abs( lhs._orientation.dot( rhs._orientation ) ) >= 1.f - 1e-6f;
+    }
+
+    struct SyntheticPacket
+    {
+        U64 _arrivalUS{ 0u };
+        U64 _serverTimeUS{ 0u };
+    };
+
+    /// One state every SendIntervalUS (local time) with jittery latency, some loss, occasional late packets that arrive out of order
+    /// and a stretch where nothing gets through at all. Same seed, same timeline
+    vector<SyntheticPacket> MakeTimeline(const U64 durationUS, const U64 starveStartUS, const U64 starveEndUS)
+    {
+        std::mt19937 rng( 13u );
+        std::uniform_int_distribution<U64> jitter( 0u, MaxJitterUS );
+        std::uniform_real_distribution<F32> loss( 0.f, 1.f );
+
+        vector<SyntheticPacket> ret;
+        U32 packetIdx = 0u;
+        for ( U64 sendUS = 0u; sendUS < durationUS; sendUS += SendIntervalUS, ++packetIdx )
+        {
+            const U64 latencyUS = BaseLatencyUS + jitter( rng ) + (packetIdx % 23u == 0u ? 90'000u : 0u);
+            const bool lost = loss( rng ) < 0.05f;
+            if ( lost || (sendUS >= starveStartUS && sendUS < starveEndUS) )
+            {
+                continue;
+            }
+
+            ret.push_back( { sendUS + latencyUS, sendUS + ServerClockAheadUS } );
+        }
+
+        eastl::sort( ret.begin(), ret.end(), []( const SyntheticPacket& lhs, const SyntheticPacket& rhs ) { return lhs._arrivalUS < rhs._arrivalUS; } );
+        return ret;
+    }
+}
+
+TEST_CASE( "Network Snapshot Buffer Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    const InterpolationSettings settings{};
+    SnapshotBuffer buffer;
+    TransformValues values{};
+
+    CHECK_TRUE( buffer.sample( 0u, settings, values ) == SnapshotBuffer::SampleResult::EMPTY );
+
+    // A single state is all we can show, no matter when
+    CHECK_TRUE( buffer.push( 100'000u, Truth( 100'000u ) ) );
+    CHECK_TRUE( buffer.sample( 150'000u, settings, values ) == SnapshotBuffer::SampleResult::CLAMPED );
+    CHECK_TRUE( Near( values, Truth( 100'000u ) ) );
+
+    // Out of order states are sorted by server time, duplicates are dropped
+    CHECK_TRUE( buffer.push( 300'000u, Truth( 300'000u ) ) );
+    CHECK_TRUE( buffer.push( 200'000u, Truth( 200'000u ) ) );
+    CHECK_FALSE( buffer.push( 200'000u, Truth( 200'000u ) ) );
+    CHECK_EQUAL( buffer.size(), 3u );
+
+    CHECK_TRUE( buffer.sample( 250'000u, settings, values ) == SnapshotBuffer::SampleResult::INTERPOLATED );
+    CHECK_TRUE( Near( values, Truth( 250'000u ) ) );
+    CHECK_TRUE( buffer.sample( 50'000u, settings, values ) == SnapshotBuffer::SampleResult::HELD );
+    CHECK_TRUE( Near( values, Truth( 100'000u ) ) );
+
+    // Past the newest state we extrapolate, but only so far
+    CHECK_TRUE( buffer.sample( 350'000u, settings, values ) == SnapshotBuffer::SampleResult::EXTRAPOLATED );
+    CHECK_TRUE( Near( values, Truth( 350'000u ) ) );
+    CHECK_TRUE( buffer.sample( 300'000u + settings._maxExtrapolationUS * 4u, settings, values ) == SnapshotBuffer::SampleResult::CLAMPED );
+    CHECK_TRUE( Near( values, Truth( 300'000u + settings._maxExtrapolationUS ) ) );
+
+    // Once full, the oldest states make room for newer ones and anything older than what we have is useless
+    for ( U64 i = 4u; i <= SnapshotBuffer::Capacity + 8u; ++i )
+    {
+        CHECK_TRUE( buffer.push( i * 100'000u, Truth( i * 100'000u ) ) );
+    }
+    CHECK_EQUAL( buffer.size(), SnapshotBuffer::Capacity );
+    CHECK_FALSE( buffer.push( 100'000u, Truth( 100'000u ) ) );
+    CHECK_TRUE( buffer.push( 3'050'000u, Truth( 3'050'000u ) ) );
+    CHECK_TRUE( buffer.sample( 3'025'000u, settings, values ) == SnapshotBuffer::SampleResult::INTERPOLATED );
+    CHECK_TRUE( Near( values, Truth( 3'025'000u ) ) );
+}
+
+TEST_CASE( "Network Interpolation Timeline Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr U64 DurationUS = 8'000'000u;
+    constexpr U64 WarmUpUS = 1'000'000u;
+    constexpr U64 StarveStartUS = 4'000'000u;
+    constexpr U64 StarveEndUS = 4'600'000u;
+
+    const vector<SyntheticPacket> timeline = MakeTimeline( DurationUS, StarveStartUS, StarveEndUS );
+
+    const InterpolationSettings settings{};
+    ClockSync clock;
+    SnapshotBuffer buffer;
+
+    // What we used to do: apply whatever arrived last
+    TransformValues naive = Truth( 0u );
+    F32 naivePrevX = 0.f, interpolatedPrevX = 0.f;
+    U64 previousRenderTimeUS = 0u;
+    D64 naiveStepErrorSQ = 0.0, interpolatedStepErrorSQ = 0.0;
+    F32 maxPositionError = 0.f, maxClampedX = 0.f;
+    size_t packetIdx = 0u, frameCount = 0u, steadyFrames = 0u, interpolatedFrames = 0u, clampedFrames = 0u;
+    bool renderTimeMonotonic = true, positionMonotonic = true, orientationMatches = true;
+
+    for ( U64 nowUS = 0u; nowUS < DurationUS; nowUS += FrameIntervalUS )
+    {
+        for ( ; packetIdx < timeline.size() && timeline[packetIdx]._arrivalUS <= nowUS; ++packetIdx )
+        {
+            const SyntheticPacket& packet = timeline[packetIdx];
+            clock.addSample( packet._serverTimeUS, packet._arrivalUS );
+            [[maybe_unused]] const bool buffered = buffer.push( packet._serverTimeUS, Truth( packet._serverTimeUS ) );
+            naive = Truth( packet._serverTimeUS );
+        }
+
+        clock.update( nowUS );
+        if ( !clock.synced() )
+        {
+            continue;
+        }
+
+        const U64 renderTimeUS = clock.remoteTimeUS() - settings._delayUS;
+        TransformValues values{};
+        const SnapshotBuffer::SampleResult result = buffer.sample( renderTimeUS, settings, values );
+
+        if ( nowUS >= WarmUpUS )
+        {
+            ++frameCount;
+            renderTimeMonotonic = renderTimeMonotonic && renderTimeUS >= previousRenderTimeUS;
+            positionMonotonic = positionMonotonic && values._translation.x >= interpolatedPrevX;
+
+            const F32 expectedStep = Speed * to_F32( to_D64( FrameIntervalUS ) / 1e6 );
+            if ( result == SnapshotBuffer::SampleResult::CLAMPED )
+            {
+                ++clampedFrames;
+                maxClampedX = std::max( maxClampedX, values._translation.x );
+            }
+            else
+            {
+                interpolatedFrames += result == SnapshotBuffer::SampleResult::INTERPOLATED ? 1u : 0u;
+                maxPositionError = std::max( maxPositionError, values._translation.distance( Truth( renderTimeUS )._translation ) );
+                orientationMatches = orientationMatches && std::abs( values._orientation.dot( Truth( renderTimeUS )._orientation ) ) >= 1.f - 1e-6f;
+            }
+
+            // Smoothness: how far each frame's movement is from what the entity really moved. Skip the starving period, nothing is smooth there
+            if ( nowUS < StarveStartUS || nowUS > StarveEndUS + WarmUpUS )
+            {
+                ++steadyFrames;
+                interpolatedStepErrorSQ += SQUARED( to_D64( values._translation.x - interpolatedPrevX - expectedStep ) );
+                naiveStepErrorSQ += SQUARED( to_D64( naive._translation.x - naivePrevX - expectedStep ) );
+            }
+        }
+
+        previousRenderTimeUS = renderTimeUS;
+        interpolatedPrevX = values._translation.x;
+        naivePrevX = naive._translation.x;
+    }
+
+    // The fastest packet took BaseLatencyUS plus a bit of jitter, so that's what we should measure on top of the real clock offset
+    const I64 realOffsetUS = -to_I64( ServerClockAheadUS );
+    CHECK_TRUE( clock.offsetUS() >= realOffsetUS + to_I64( BaseLatencyUS ) );
+    CHECK_TRUE( clock.offsetUS() <= realOffsetUS + to_I64( BaseLatencyUS + MaxJitterUS / 4u ) );
+
+    CHECK_TRUE( renderTimeMonotonic );
+    CHECK_TRUE( positionMonotonic );
+    CHECK_TRUE( orientationMatches );
+    // The path is linear, so interpolating (or briefly extrapolating) real states lands right on it
+    CHECK_TRUE( maxPositionError < 1e-2f );
+    // Delay covers the jitter: nearly every frame has a state on both sides
+    CHECK_TRUE( interpolatedFrames > frameCount * 8u / 10u );
+
+    // Starving: we stop at the furthest extrapolation allowed past the last state we got
+    const U64 lastStateBeforeStarvingUS = StarveStartUS - SendIntervalUS + ServerClockAheadUS;
+    CHECK_TRUE( clampedFrames > 0u );
+    CHECK_TRUE( maxClampedX <= Truth( lastStateBeforeStarvingUS + settings._maxExtrapolationUS )._translation.x + 1e-2f );
+
+    const D64 naiveRMS = std::sqrt( naiveStepErrorSQ / steadyFrames );
+    const D64 interpolatedRMS = std::sqrt( interpolatedStepErrorSQ / steadyFrames );
+    CHECK_TRUE( interpolatedRMS * 10.0 < naiveRMS );
+
+    std::cout << Util::StringFormat( "Snapshot interpolation [ {} frames, {} packets ]: {:.1f}% interpolated, {} clamped. Per frame movement error: apply on arrival {:.4f}, interpolated {:.4f}",
+                                     frameCount,
+                                     timeline.size(),
+                                     100.0 * to_D64( interpolatedFrames ) / frameCount,
+                                     clampedFrames,
+                                     naiveRMS,
+                                     interpolatedRMS ) << std::endl;
+}
+
+TEST_CASE( "Network Clock Sync Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr I64 RealOffsetUS = -to_I64( ServerClockAheadUS );
+
+    ClockSync clock;
+    U64 previousRemoteUS = 0u, lastFrameUS = 0u;
+    I64 offsetBeforeUS = 0;
+    bool slewWithinBounds = true;
+
+    // Latency goes from 40ms to 140ms halfway through. The estimate has to follow it up, but smoothly
+    for ( U64 nowUS = 0u; nowUS < 12'000'000u; nowUS += FrameIntervalUS )
+    {
+        lastFrameUS = nowUS;
+        const U64 latencyUS = nowUS < 6'000'000u ? BaseLatencyUS : BaseLatencyUS + 100'000u;
+        if ( nowUS >= latencyUS )
+        {
+            clock.addSample( nowUS - latencyUS + ServerClockAheadUS, nowUS );
+        }
+        clock.update( nowUS );
+
+        if ( previousRemoteUS > 0u )
+        {
+            const U64 stepUS = clock.remoteTimeUS() - previousRemoteUS;
+            const D64 rate = to_D64( stepUS ) / FrameIntervalUS;
+            slewWithinBounds = slewWithinBounds && rate >= 1.0 - ClockSync::MaxSlewRate - 1e-3 && rate <= 1.0 + ClockSync::MaxSlewRate + 1e-3;
+        }
+        previousRemoteUS = clock.remoteTimeUS();
+
+        if ( nowUS < 6'000'000u )
+        {
+            offsetBeforeUS = clock.offsetUS();
+        }
+    }
+
+    CHECK_TRUE( slewWithinBounds );
+    CHECK_EQUAL( offsetBeforeUS, RealOffsetUS + to_I64( BaseLatencyUS ) );
+    CHECK_EQUAL( clock.offsetUS(), RealOffsetUS + to_I64( BaseLatencyUS + 100'000u ) );
+    // Caught up with the new estimate, so the remote clock runs at our pace again
+    CHECK_EQUAL( to_I64( lastFrameUS ) - to_I64( clock.remoteTimeUS() ), clock.offsetUS() );
+}
+
+TEST_CASE( "Network Correction Blend Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    InterpolationSettings settings{};
+    settings._correctionHalfLifeUS = 50'000u;
+
+    TransformValues corrected{};
+    corrected._translation.set( 1.f, 0.f, 0.f );
+    corrected._orientation = quatf( WORLD_Y_AXIS, Angle::RADIANS_F( M_PI_2_f ) );
+
+    // Half of the error is blended in after one half life, no matter how the frames are spaced
+    TransformValues oneStep{}, manySteps{};
+    CorrectionBlender blenderA, blenderB;
+    blenderA.setCorrection( oneStep, corrected );
+    blenderB.setCorrection( manySteps, corrected );
+    CHECK_TRUE( blenderA.apply( 50'000u, settings, oneStep ) );
+    for ( U8 i = 0u; i < 10u; ++i )
+    {
+        CHECK_TRUE( blenderB.apply( 5'000u, settings, manySteps ) );
+    }
+    CHECK_COMPARE_TOLERANCE( oneStep._translation.x, 0.5f, 1e-4f );
+    CHECK_COMPARE_TOLERANCE( manySteps._translation.x, 0.5f, 1e-4f );
+    CHECK_COMPARE_TOLERANCE( blenderB.remainingDistance(), 0.5f, 1e-4f );
+    CHECK_TRUE( Near( oneStep, manySteps ) );
+
+    // Local simulation keeps going while the correction blends in and both end up applied
+    TransformValues values{};
+    CorrectionBlender blender;
+    blender.setCorrection( values, corrected );
+    U32 frames = 0u;
+    for ( ; blender.active() && frames < 1000u; ++frames )
+    {
+        values._translation.z += 0.01f;
+        CHECK_TRUE( blender.apply( FrameIntervalUS, settings, values ) );
+    }
+    CHECK_TRUE( frames < 1000u );
+    CHECK_FALSE( blender.apply( FrameIntervalUS, settings, values ) );
+    CHECK_COMPARE_TOLERANCE( values._translation.x, 1.f, 1e-3f );
+    CHECK_COMPARE_TOLERANCE( values._translation.z, 0.01f * frames, 1e-3f );
+    CHECK_TRUE( std::abs( values._orientation.dot( corrected._orientation ) ) >= 1.f - 1e-6f );
+
+    // Big errors (teleports) are applied right away
+    TransformValues teleported{};
+    teleported._translation.set( settings._correctionSnapDistance * 2.f, 0.f, 0.f );
+    values = {};
+    blender.setCorrection( values, teleported );
+    CHECK_TRUE( blender.apply( 0u, settings, values ) );
+    CHECK_FALSE( blender.active() );
+    CHECK_TRUE( Near( values, teleported ) );
+}
+
+} //namespace Divide
@@ -0,0 +1,171 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Networking/Headers/Connection.h"
+
+#include <iostream>
+
+namespace Divide
+{
+
+TEST_CASE( "Network Packet Pool Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    using namespace Networking;
+
+    PacketPool pool;
+
+    NetworkPacket source{ OPCodes::SMSG_MSG };
+    source << 42u << 1.5f;
+
+    {
+        const PacketRef copy = pool.acquire( source );
+        CHECK_EQUAL( copy.useCount(), 1u );
+        CHECK_TRUE( copy->header()._opCode == OPCodes::SMSG_MSG );
+        CHECK_EQUAL( copy->header()._byteLength, source.body().bufferSize() );
+
+        // Copies share the packet
+        PacketRef shared = copy;
+        CHECK_EQUAL( copy.useCount(), 2u );
+        CHECK_TRUE( &*shared == &*copy );
+
+        U32 intValue = 0u;
+        F32 floatValue = 0.f;
+        *shared >> intValue >> floatValue;
+        CHECK_EQUAL( intValue, 42u );
+        CHECK_EQUAL( floatValue, 1.5f );
+
+        const PacketRef moved = MOV( shared );
+        CHECK_EQUAL( shared.useCount(), 0u );
+        CHECK_EQUAL( moved.useCount(), 2u );
+    }
+
+    CHECK_EQUAL( pool.allocatedCount(), 1u );
+    CHECK_EQUAL( pool.pooledCount(), 1u );
+
+    // Released packets are reused and come back empty
+    {
+        const PacketRef packet = pool.acquire( OPCodes::CMSG_PING );
+        CHECK_EQUAL( pool.allocatedCount(), 1u );
+        CHECK_EQUAL( pool.pooledCount(), 0u );
+        CHECK_TRUE( packet->header()._opCode == OPCodes::CMSG_PING );
+        CHECK_EQUAL( packet->header()._byteLength, 0u );
+        CHECK_TRUE( packet->body().bufferEmpty() );
+    }
+
+    // Large packets are not worth keeping around
+    {
+        const PacketRef packet = pool.acquire( OPCodes::SMSG_SEND_FILE );
+        const vector<Byte> fileData( PacketPool::MaxPooledBodySize + 1u, Byte{ 7u } );
+        packet->append( fileData.data(), fileData.size() );
+    }
+    CHECK_EQUAL( pool.allocatedCount(), 0u );
+    CHECK_EQUAL( pool.pooledCount(), 0u );
+
+    // Acquire on one thread, release on another, just like the asio thread and the game thread do
+    constexpr size_t packetCount = 100'000u;
+    OwnedPacketQueue queue;
+    std::thread producer( [&]()
+    {
+        for ( size_t i = 0u; i < packetCount; ++i )
+        {
+            PacketRef packet = pool.acquire( OPCodes::SMSG_MSG );
+            *packet << to_U32( i );
+            queue.enqueue( { nullptr, MOV( packet ) } );
+        }
+    } );
+
+    bool inOrder = true;
+    OwnedNetworkPacket msg{};
+    for ( size_t i = 0u; i < packetCount; ++i )
+    {
+        queue.wait_dequeue( msg );
+        U32 index = 0u;
+        *msg._msg >> index;
+        inOrder = inOrder && index == i;
+    }
+    msg = {};
+    producer.join();
+
+    CHECK_TRUE( inOrder );
+    CHECK_EQUAL( pool.pooledCount(), pool.allocatedCount() );
+    CHECK_TRUE( pool.allocatedCount() <= PacketPool::MaxPooledPackets + 1u );
+}
+
+TEST_CASE( "Network Loopback Throughput Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    using namespace Networking;
+    using boost::asio::ip::tcp;
+
+    constexpr size_t messageCount = 200'000u;
+    constexpr U32 payloadSize = 32u;
+
+    // The pool has to outlive the context, as handlers that never ran still hold on to packets
+    PacketPool pool;
+    OwnedPacketQueue senderQueue, receiverQueue;
+
+    boost::asio::io_context context;
+    tcp::acceptor acceptor( context, tcp::endpoint( boost::asio::ip::make_address( LocalHostAddress ), 0u ) );
+    tcp::socket senderSocket( context ), receiverSocket( context );
+    senderSocket.connect( acceptor.local_endpoint() );
+    acceptor.accept( receiverSocket );
+
+    {
+        const Connection_ptr sender = std::make_shared<Connection>( Connection::Owner::SERVER, context, MOV( senderSocket ), senderQueue, pool );
+        const Connection_ptr receiver = std::make_shared<Connection>( Connection::Owner::SERVER, context, MOV( receiverSocket ), receiverQueue, pool );
+        sender->connectToClient( 1u );
+        receiver->connectToClient( 2u );
+
+        std::thread contextThread( [&context]() { context.run(); } );
+
+        const vector<Byte> payload( payloadSize, Byte{ 0xABu } );
+
+        const D64 startTime = Time::App::ElapsedMicroseconds();
+
+        std::thread senderThread( [&]()
+        {
+            NetworkPacket msg{ OPCodes::CMSG_ENTITY_UPDATE };
+            for ( size_t i = 0u; i < messageCount; ++i )
+            {
+                msg.reset( OPCodes::CMSG_ENTITY_UPDATE );
+                msg << to_U32( i );
+                msg.append( payload.data(), payload.size() );
+                sender->send( msg );
+            }
+        } );
+
+        bool inOrder = true, validSize = true;
+        size_t received = 0u;
+        OwnedNetworkPacket msg{};
+        while ( received < messageCount && receiverQueue.wait_dequeue_timed( msg, std::chrono::seconds( 10 ) ) )
+        {
+            U32 index = 0u;
+            *msg._msg >> index;
+            inOrder = inOrder && index == received;
+            validSize = validSize && msg._msg->body().bufferSize() == payloadSize;
+            ++received;
+        }
+        msg = {};
+
+        const D64 durationUS = Time::App::ElapsedMicroseconds() - startTime;
+
+        senderThread.join();
+        context.stop();
+        contextThread.join();
+
+        CHECK_EQUAL( received, messageCount );
+        CHECK_TRUE( inOrder );
+        CHECK_TRUE( validSize );
+
+        std::cout << Util::StringFormat( "Loopback throughput [ {} messages, {} byte payload ]: {:.0f} messages/sec, {} pooled packets allocated",
+                                         messageCount,
+                                         payloadSize + sizeof( U32 ),
+                                         messageCount / (durationUS * 1e-6),
+                                         pool.allocatedCount() ) << std::endl;
+    }
+}
+
+} //namespace Divide
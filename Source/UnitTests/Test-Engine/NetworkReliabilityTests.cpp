@@ -0,0 +1,513 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Networking/Headers/ReliableEndpoint.h"
+#include "Networking/Headers/LossyLoopback.h"
+#include "Networking/Headers/Client.h"
+#include "Networking/Headers/Server.h"
+
+#include <iostream>
+#include <thread>
+
+namespace Divide
+{
+
+namespace
+{
+    using namespace Networking;
+
+    constexpr U32 InvalidMessage = U32_MAX;
+    constexpr U32 LinkToken = 0x5EEDu;
+
+    /// Two endpoints talking through a lossy loopback, driven by a simulated clock
+    struct TestLink
+    {
+        TestLink( PacketPool& pool, const LossyLoopback::Settings& settings )
+            : _network( settings )
+        {
+            for ( U8 side = 0u; side < 2u; ++side )
+            {
+                _endpoints[side] = std::make_unique<ReliableEndpoint>
+                (
+                    1u,
+                    LinkToken,
+                    pool,
+                    [this, side]( const Byte* data, const size_t size )
+                    {
+                        _network.send( side, data, size, _timeUS );
+                    },
+                    [this, side]( PacketRef packet )
+                    {
+                        _received[side].push_back( ReadMessage( *packet ) );
+                    }
+                );
+            }
+        }
+
+        /// Message format: [U32 index][U32 count][count x U32: index + i]
+        static void SendMessage( ReliableEndpoint& endpoint, const U32 index, const U32 payloadCount, const DeliveryMode mode, const U64 timeUS )
+        {
+            NetworkPacket msg{ OPCodes::SMSG_MSG };
+            msg << index << payloadCount;
+            for ( U32 i = 0u; i < payloadCount; ++i )
+            {
+                msg << index + i;
+            }
+            endpoint.send( msg, mode, timeUS );
+        }
+
+        /// Returns the message index or InvalidMessage if the payload got corrupted on the way
+        static U32 ReadMessage( NetworkPacket& msg )
+        {
+            U32 index = 0u, payloadCount = 0u;
+            msg >> index >> payloadCount;
+            for ( U32 i = 0u; i < payloadCount; ++i )
+            {
+                U32 value = 0u;
+                msg >> value;
+                if ( value != index + i )
+                {
+                    return InvalidMessage;
+                }
+            }
+            return msg.header()._opCode == OPCodes::SMSG_MSG ? index : InvalidMessage;
+        }
+
+        void send( const U8 side, const U32 index, const U32 payloadCount, const DeliveryMode mode )
+        {
+            SendMessage( *_endpoints[side], index, payloadCount, mode, _timeUS );
+        }
+
+        void step( const U64 deltaUS )
+        {
+            _timeUS += deltaUS;
+            _network.deliver( _timeUS,
+                              [this]( const U8 destination, const Byte* data, const size_t size )
+                              {
+                                  _endpoints[destination]->onDatagram( data, size, _timeUS );
+                              });
+            for ( const auto& endpoint : _endpoints )
+            {
+                endpoint->update( _timeUS );
+            }
+        }
+
+        /// Keep going until everything reliable was sent and acknowledged (or we give up)
+        void drain( const U64 maxDurationUS )
+        {
+            const auto busy = []( const ReliableEndpoint& endpoint )
+            {
+                return endpoint.pendingFragmentCount() > 0u || endpoint.queuedMessageCount() > 0u;
+            };
+
+            const U64 endUS = _timeUS + maxDurationUS;
+            while ( _timeUS < endUS && (busy( *_endpoints[0] ) || busy( *_endpoints[1] )) )
+            {
+                step( 1'000u );
+            }
+            // Let the last acks and stragglers arrive
+            for ( U8 i = 0u; i < 200u; ++i )
+            {
+                step( 1'000u );
+            }
+        }
+
+        void printStats( const char* name ) const
+        {
+            const ReliableEndpoint::Stats& stats = _endpoints[0]->stats();
+            std::cout << Util::StringFormat( "UDP channel test [ {} ]: sent {} datagrams, resent {} fragments, network dropped {} and reordered {}, delivered {} messages, RTT {:.1f} ms",
+                                             name,
+                                             stats._datagramsSent + _endpoints[1]->stats()._datagramsSent,
+                                             stats._fragmentsResent + _endpoints[1]->stats()._fragmentsResent,
+                                             _network.droppedCount(),
+                                             _network.reorderedCount(),
+                                             stats._messagesDelivered + _endpoints[1]->stats()._messagesDelivered,
+                                             _endpoints[0]->rttUS() / 1000.0 ) << std::endl;
+        }
+
+        LossyLoopback _network;
+        std::array<std::unique_ptr<ReliableEndpoint>, 2> _endpoints;
+        std::array<vector<U32>, 2> _received;
+        U64 _timeUS{ 0u };
+    };
+
+    LossyLoopback::Settings BadNetwork( const U32 seed )
+    {
+        LossyLoopback::Settings settings{};
+        settings._dropChance = 0.2f;
+        settings._reorderChance = 0.1f;
+        settings._reorderDelayUS = 30'000u;
+        settings._latencyUS = 40'000u;
+        settings._jitterUS = 10'000u;
+        settings._seed = seed;
+        return settings;
+    }
+
+    /// Records the index carried by every entity update, in the order the server processes them
+    class OrderServer final : public Server
+    {
+    public:
+        using Server::Server;
+
+        vector<U32> _received;
+
+    protected:
+        void receiveMessage( Connection_ptr client, NetworkPacket& msg ) override
+        {
+            if ( msg.header()._opCode != OPCodes::CMSG_ENTITY_UPDATE )
+            {
+                Server::receiveMessage( client, msg );
+                return;
+            }
+
+            U32 index = 0u;
+            msg >> index;
+            _received.push_back( index );
+        }
+    };
+
+    bool IsSequence( const vector<U32>& values, const U32 count )
+    {
+        if ( values.size() != count )
+        {
+            return false;
+        }
+        for ( U32 i = 0u; i < count; ++i )
+        {
+            if ( values[i] != i )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE( "UDP Reliable Ordered Channel Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr U32 messageCount = 500u;
+
+    PacketPool pool;
+    {
+        TestLink link( pool, BadNetwork( 3u ) );
+
+        // Both ways at once, so acks also travel on top of regular traffic
+        for ( U32 i = 0u; i < messageCount; ++i )
+        {
+            link.send( 0u, i, i % 8u, DeliveryMode::UDP_RELIABLE_ORDERED );
+            link.send( 1u, i, i % 5u, DeliveryMode::UDP_RELIABLE_ORDERED );
+            link.step( 5'000u );
+        }
+        link.drain( 30'000'000u );
+
+        CHECK_TRUE( IsSequence( link._received[1], messageCount ) );
+        CHECK_TRUE( IsSequence( link._received[0], messageCount ) );
+        CHECK_EQUAL( link._endpoints[0]->pendingFragmentCount(), 0u );
+        CHECK_EQUAL( link._endpoints[1]->pendingFragmentCount(), 0u );
+        // Make sure the network actually got in the way
+        CHECK_TRUE( link._network.droppedCount() > 0u );
+        CHECK_TRUE( link._network.reorderedCount() > 0u );
+
+        link.printStats( "reliable ordered" );
+    }
+    CHECK_EQUAL( pool.allocatedCount(), pool.pooledCount() );
+}
+
+TEST_CASE( "UDP Reliable Unordered Channel Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr U32 messageCount = 500u;
+
+    PacketPool pool;
+    {
+        TestLink link( pool, BadNetwork( 5u ) );
+
+        for ( U32 i = 0u; i < messageCount; ++i )
+        {
+            link.send( 0u, i, 4u, DeliveryMode::UDP_RELIABLE_UNORDERED );
+            link.step( 5'000u );
+        }
+        link.drain( 30'000'000u );
+
+        // Everything arrives exactly once, in whatever order
+        vector<U32> received = link._received[1];
+        eastl::sort( received.begin(), received.end() );
+        CHECK_TRUE( IsSequence( received, messageCount ) );
+        CHECK_FALSE( link._received[1] == received );
+
+        link.printStats( "reliable unordered" );
+    }
+    CHECK_EQUAL( pool.allocatedCount(), pool.pooledCount() );
+}
+
+TEST_CASE( "UDP Sequenced Channel Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr U32 messageCount = 500u;
+
+    PacketPool pool;
+    TestLink link( pool, BadNetwork( 7u ) );
+
+    for ( U32 i = 0u; i < messageCount; ++i )
+    {
+        link.send( 0u, i, 4u, DeliveryMode::UDP_SEQUENCED_UNRELIABLE );
+        link.step( 5'000u );
+    }
+    link.drain( 1'000'000u );
+
+    // Nothing is resent and nothing older than the newest message shows up
+    const vector<U32>& received = link._received[1];
+    bool increasing = true;
+    for ( size_t i = 1u; i < received.size(); ++i )
+    {
+        increasing = increasing && received[i] > received[i - 1u];
+    }
+    CHECK_TRUE( increasing );
+    CHECK_TRUE( received.size() < messageCount );
+    CHECK_TRUE( received.size() > messageCount / 2u );
+    CHECK_EQUAL( link._endpoints[0]->stats()._fragmentsResent, 0u );
+
+    link.printStats( "sequenced" );
+}
+
+TEST_CASE( "UDP Fragmentation Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    // ~8KB each, so every message is split into several datagrams
+    constexpr U32 messageCount = 50u;
+    constexpr U32 payloadCount = 2'000u;
+
+    PacketPool pool;
+    LossyLoopback::Settings settings = BadNetwork( 11u );
+    settings._dropChance = 0.1f;
+    TestLink link( pool, settings );
+
+    for ( U32 i = 0u; i < messageCount; ++i )
+    {
+        link.send( 0u, i, payloadCount, DeliveryMode::UDP_RELIABLE_ORDERED );
+        link.step( 20'000u );
+    }
+    link.drain( 30'000'000u );
+
+    CHECK_TRUE( IsSequence( link._received[1], messageCount ) );
+    CHECK_TRUE( link._endpoints[0]->stats()._datagramsSent >= messageCount * (payloadCount * sizeof( U32 ) / ReliableEndpoint::MaxFragmentSize) );
+
+    link.printStats( "fragmented" );
+}
+
+TEST_CASE( "UDP Round Trip Time Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    LossyLoopback::Settings settings{};
+    settings._latencyUS = 25'000u;
+
+    PacketPool pool;
+    TestLink link( pool, settings );
+
+    for ( U32 i = 0u; i < 100u; ++i )
+    {
+        link.send( 0u, i, 1u, DeliveryMode::UDP_RELIABLE_ORDERED );
+        link.step( 10'000u );
+    }
+    link.drain( 1'000'000u );
+
+    // 25ms each way, plus up to 10ms waiting for the next update to send the ack
+    const U64 rttUS = link._endpoints[0]->rttUS();
+    CHECK_TRUE( rttUS >= 50'000u );
+    CHECK_TRUE( rttUS <= 60'000u );
+    // No losses, so nothing should have been resent
+    CHECK_EQUAL( link._endpoints[0]->stats()._fragmentsResent, 0u );
+    CHECK_TRUE( link._endpoints[0]->resendTimeoutUS() >= rttUS );
+}
+
+TEST_CASE( "UDP Burst Ack Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    LossyLoopback::Settings settings{};
+    settings._latencyUS = 5'000u;
+
+    constexpr U32 burstCount = 10u;
+    // Much more than the 33 datagrams a single ack covers, all of them arriving between two updates of the receiver
+    constexpr U32 burstSize = 200u;
+
+    PacketPool pool;
+    TestLink link( pool, settings );
+
+    for ( U32 burst = 0u; burst < burstCount; ++burst )
+    {
+        for ( U32 i = 0u; i < burstSize; ++i )
+        {
+            link.send( 0u, burst * burstSize + i, 2u, DeliveryMode::UDP_RELIABLE_ORDERED );
+        }
+        link.step( 30'000u );
+    }
+    link.drain( 1'000'000u );
+
+    CHECK_TRUE( IsSequence( link._received[1], burstCount * burstSize ) );
+    CHECK_EQUAL( link._endpoints[0]->pendingFragmentCount(), 0u );
+    // Nothing got lost, so every datagram should have been acknowledged the first time around
+    CHECK_EQUAL( link._endpoints[0]->stats()._fragmentsResent, 0u );
+
+    link.printStats( "bursts" );
+}
+
+TEST_CASE( "UDP Connection Token Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    PacketPool pool;
+    TestLink link( pool, LossyLoopback::Settings{} );
+
+    link.send( 0u, 0u, 4u, DeliveryMode::UDP_RELIABLE_UNORDERED );
+    link.drain( 1'000'000u );
+    CHECK_TRUE( IsSequence( link._received[1], 1u ) );
+
+    // Same connection ID, wrong token: someone who only knows (or guessed) the ID
+    vector<Byte> forged;
+    ReliableEndpoint forger( 1u, LinkToken + 1u, pool,
+                             [&forged]( const Byte* data, const size_t size )
+                             {
+                                 forged.assign( data, data + size );
+                             },
+                             []( [[maybe_unused]] PacketRef packet ) {} );
+    TestLink::SendMessage( forger, 1u, 4u, DeliveryMode::UDP_RELIABLE_UNORDERED, link._timeUS );
+    CHECK_FALSE( forged.empty() );
+    CHECK_FALSE( link._endpoints[1]->accepts( forged.data(), forged.size() ) );
+
+    const U64 dropped = link._endpoints[1]->stats()._messagesDropped;
+    link._endpoints[1]->onDatagram( forged.data(), forged.size(), link._timeUS );
+    CHECK_EQUAL( link._endpoints[1]->stats()._messagesDropped, dropped + 1u );
+
+    // The real connection keeps working and the forged message never shows up
+    link.send( 0u, 1u, 4u, DeliveryMode::UDP_RELIABLE_UNORDERED );
+    link.drain( 1'000'000u );
+    CHECK_TRUE( IsSequence( link._received[1], 2u ) );
+}
+
+TEST_CASE( "UDP Receive Limits Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    PacketPool pool;
+    TestLink link( pool, LossyLoopback::Settings{} );
+    ReliableEndpoint& receiver = *link._endpoints[1];
+
+    // A peer that knows the connection token (i.e. any connected client) writing raw fragments
+    U16 sequence = 0u;
+    vector<Byte> datagram;
+    const auto forge = [&]( const DeliveryMode mode, const U16 messageID, const U16 fragmentIndex, const U16 fragmentCount )
+    {
+        datagram.assign( ReliableEndpoint::DatagramHeaderSize + ReliableEndpoint::FragmentHeaderSize + ReliableEndpoint::MaxFragmentSize, Byte{ 0u } );
+        Byte* dst = datagram.data();
+        const auto write = [&dst]( const auto value )
+        {
+            memcpy( dst, &value, sizeof( value ) );
+            dst += sizeof( value );
+        };
+        write( U32{ 1u } );
+        write( LinkToken );
+        write( sequence++ );
+        write( U16{ 0u } );
+        write( U32{ 0u } );
+        write( to_base( mode ) );
+        write( messageID );
+        write( to_base( OPCodes::SMSG_MSG ) );
+        write( fragmentIndex );
+        write( fragmentCount );
+        receiver.onDatagram( datagram.data(), datagram.size(), link._timeUS );
+    };
+
+    // Claims a huge message. Rejected before anything gets allocated for it
+    U64 dropped = receiver.stats()._messagesDropped;
+    forge( DeliveryMode::UDP_RELIABLE_UNORDERED, 0u, 0u, U16_MAX );
+    forge( DeliveryMode::UDP_RELIABLE_UNORDERED, 1u, 0u, to_U16( ReliableEndpoint::MaxFragmentCount + 1u ) );
+    CHECK_EQUAL( receiver.stats()._messagesDropped, dropped + 2u );
+    CHECK_EQUAL( receiver.reassemblyCount(), 0u );
+
+    // Within limits and within the window, so it gets reassembled
+    forge( DeliveryMode::UDP_RELIABLE_UNORDERED, 2u, 0u, to_U16( ReliableEndpoint::MaxFragmentCount ) );
+    CHECK_EQUAL( receiver.reassemblyCount(), 1u );
+
+    // Ordered messages past the one we're waiting for (0) are only buffered inside the receive window
+    dropped = receiver.stats()._messagesDropped;
+    constexpr U16 extra = 100u;
+    for ( U16 messageID = 1u; messageID < ReliableEndpoint::ReceiveWindowSize + extra; ++messageID )
+    {
+        forge( DeliveryMode::UDP_RELIABLE_ORDERED, messageID, 0u, 1u );
+    }
+    CHECK_EQUAL( receiver.bufferedMessageCount(), ReliableEndpoint::ReceiveWindowSize - 1u );
+    CHECK_EQUAL( receiver.stats()._messagesDropped, dropped + extra );
+
+    // A real sender with far more messages in flight than the window holds them back until the receiver caught up, so nothing it sends is dropped for being too far ahead
+    PacketPool burstPool;
+    LossyLoopback::Settings settings{};
+    settings._dropChance = 0.2f;
+    settings._latencyUS = 40'000u;
+    settings._seed = 23u;
+    TestLink burstLink( burstPool, settings );
+
+    constexpr U32 messageCount = ReliableEndpoint::ReceiveWindowSize * 3u;
+    for ( U32 i = 0u; i < messageCount; ++i )
+    {
+        burstLink.send( 0u, i, 2u, DeliveryMode::UDP_RELIABLE_ORDERED );
+    }
+    CHECK_EQUAL( burstLink._endpoints[0]->queuedMessageCount(), messageCount - ReliableEndpoint::ReceiveWindowSize );
+    burstLink.drain( 30'000'000u );
+
+    CHECK_TRUE( IsSequence( burstLink._received[1], messageCount ) );
+    CHECK_EQUAL( burstLink._endpoints[0]->pendingFragmentCount(), 0u );
+    CHECK_EQUAL( burstLink._endpoints[0]->queuedMessageCount(), 0u );
+
+    burstLink.printStats( "window" );
+}
+
+TEST_CASE( "UDP Transport Switch Order Test", "[networking]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr U16 port = NetworkingPort + 102u;
+    constexpr U32 messageCount = 6000u;
+    constexpr U32 burstSize = 200u;
+
+    OrderServer server( port );
+    CHECK_TRUE( server.start() );
+
+    Client client;
+    const bool connected = client.connect( LocalHostAddress, port );
+    CHECK_TRUE( connected );
+
+    // Start streaming right away. The first messages go over TCP, the rest over UDP once it comes up, with plenty of TCP messages still in flight at that point
+    for ( U32 i = 0u; i < messageCount; i += burstSize )
+    {
+        for ( U32 j = i; j < i + burstSize; ++j )
+        {
+            NetworkPacket msg{ OPCodes::CMSG_ENTITY_UPDATE };
+            msg << j;
+            client.send( msg );
+        }
+
+        server.update();
+        client.update();
+        std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+    }
+
+    for ( U16 i = 0u; i < 500u && server._received.size() < messageCount; ++i )
+    {
+        server.update();
+        client.update();
+        std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+    }
+
+    CHECK_TRUE( IsSequence( server._received, messageCount ) );
+
+    client.disconnect();
+    server.stop();
+}
+
+} //namespace Divide
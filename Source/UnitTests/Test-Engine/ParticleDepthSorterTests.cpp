@@ -0,0 +1,270 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Dynamics/Entities/Particles/Headers/ParticleData.h"
+#include "Dynamics/Entities/Particles/Headers/ParticleKernels.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    struct TestParticles
+    {
+        ParticleAttribute _position, _colour;
+        ParticleStream _distanceSq, _life;
+        vector<float4> _renderingPositions;
+        vector<UColour4> _renderingColours;
+
+        [[nodiscard]] ParticleDepthSorter::GatherDescriptor gather()
+        {
+            return { &_position, _renderingPositions.data(), &_colour, _renderingColours.data() };
+        }
+    };
+
+    void Generate( TestParticles& particles, const U32 count, const float3& eyePos, std::mt19937& rng )
+    {
+        std::uniform_real_distribution<F32> position( -100.f, 100.f );
+        std::uniform_real_distribution<F32> colour( 0.f, 1.f );
+
+        particles._position.resize( count, 0.f );
+        particles._colour.resize( count, 0.f );
+        particles._distanceSq.resize( count, 0.f );
+        particles._life.resize( count, 1.f );
+        particles._renderingPositions.resize( count );
+        particles._renderingColours.resize( count );
+
+        for ( U32 i = 0u; i < count; ++i )
+        {
+            particles._position.set( i, float4{ position( rng ), position( rng ), position( rng ), 1.f } );
+            particles._colour.set( i, float4{ colour( rng ), colour( rng ), colour( rng ), colour( rng ) } );
+        }
+        ParticleKernels::DistanceSq( particles._position, eyePos, particles._distanceSq, 0u, count );
+    }
+
+    /// Moves every particle by at most maxOffset along each axis
+    void Jitter( TestParticles& particles, const U32 count, const float3& eyePos, const F32 maxOffset, std::mt19937& rng )
+    {
+        std::uniform_real_distribution<F32> offset( -maxOffset, maxOffset );
+        for ( U32 i = 0u; i < count; ++i )
+        {
+            particles._position._x[i] += offset( rng );
+            particles._position._y[i] += offset( rng );
+            particles._position._z[i] += offset( rng );
+        }
+        ParticleKernels::DistanceSq( particles._position, eyePos, particles._distanceSq, 0u, count );
+    }
+
+    [[nodiscard]] bool IsPermutation( const vector<U32>& order, const U32 count )
+    {
+        if ( order.size() != count )
+        {
+            return false;
+        }
+
+        vector<bool> seen( count, false );
+        for ( const U32 index : order )
+        {
+            if ( index >= count || seen[index] )
+            {
+                return false;
+            }
+            seen[index] = true;
+        }
+        return true;
+    }
+
+    /// Number of neighbours that are out of order by more than tolerance
+    [[nodiscard]] size_t CountInversions( const vector<U32>& order, const ParticleStream& distanceSq, const F32 tolerance )
+    {
+        size_t ret = 0u;
+        for ( size_t i = 1u; i < order.size(); ++i )
+        {
+            ret += distanceSq[order[i - 1u]] + tolerance < distanceSq[order[i]] ? 1u : 0u;
+        }
+        return ret;
+    }
+
+    /// Largest error the 16 bit keys of a full sort can introduce
+    [[nodiscard]] F32 QuantizationStep( const ParticleStream& distanceSq, const U32 count )
+    {
+        const auto [min, max] = std::minmax_element( distanceSq.data(), distanceSq.data() + count );
+        return (*max - *min) / to_F32( U16_MAX ) * 1.01f;
+    }
+
+    [[nodiscard]] size_t CountGatherMismatches( const TestParticles& particles, const vector<U32>& order )
+    {
+        size_t ret = 0u;
+        for ( size_t i = 0u; i < order.size(); ++i )
+        {
+            const float4 position = particles._position.get( order[i] );
+            const float4& gathered = particles._renderingPositions[i];
+            UColour4 colour;
+            Util::ToByteColour( particles._colour.get( order[i] ), colour );
+
+            ret += position.x != gathered.x || position.y != gathered.y || position.z != gathered.z || position.w != gathered.w ? 1u : 0u;
+            ret += colour != particles._renderingColours[i] ? 1u : 0u;
+        }
+        return ret;
+    }
+}
+
+TEST_CASE( "Particle Depth Sort Test", "[particles]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool pool( "PARTICLE_DEPTH_SORT_TEST" );
+    const bool init = pool.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    // More than one radix block, with a partial block at the end
+    constexpr U32 particleCount = 3u * ParticleDepthSorter::BlockSize + 17u;
+    const float3 eyePos{ 5.f, 10.f, -20.f };
+
+    for ( TaskPool* sortPool : { static_cast<TaskPool*>(nullptr), &pool } )
+    {
+        std::mt19937 rng( 23u );
+
+        TestParticles particles;
+        Generate( particles, particleCount, eyePos, rng );
+
+        ParticleDepthSorter sorter;
+
+        // Nothing to reuse yet
+        CHECK_FALSE( sorter.sort( sortPool, particles._distanceSq, particleCount, true, particles.gather() ) );
+        CHECK_TRUE( IsPermutation( sorter.order(), particleCount ) );
+        CHECK_EQUAL( CountInversions( sorter.order(), particles._distanceSq, QuantizationStep( particles._distanceSq, particleCount ) ), 0u );
+        CHECK_EQUAL( CountGatherMismatches( particles, sorter.order() ), 0u );
+
+        // Small movement: the previous order gets fixed up and the fix-up sorts exactly
+        Jitter( particles, particleCount, eyePos, 0.01f, rng );
+        CHECK_TRUE( sorter.sort( sortPool, particles._distanceSq, particleCount, true, particles.gather() ) );
+        CHECK_TRUE( IsPermutation( sorter.order(), particleCount ) );
+        CHECK_EQUAL( CountInversions( sorter.order(), particles._distanceSq, 0.f ), 0u );
+        CHECK_EQUAL( CountGatherMismatches( particles, sorter.order() ), 0u );
+
+        // Kill every 7th particle, then spawn a few new ones at the end (the way ParticleData compacts and wakes particles)
+        for ( U32 i = 0u; i < particleCount; i += 7u )
+        {
+            particles._life[i] = 0.f;
+        }
+        sorter.onCompact( particles._life );
+        ParticleStream* streams[] = { &particles._position._x, &particles._position._y, &particles._position._z, &particles._position._w,
+                                      &particles._colour._x, &particles._colour._y, &particles._colour._z, &particles._colour._w,
+                                      &particles._distanceSq };
+        const U32 aliveCount = ParticleKernels::Compact( particles._life, particleCount, streams, std::size( streams ) );
+        CHECK_EQUAL( sorter.order().size(), aliveCount );
+
+        std::uniform_real_distribution<F32> position( -100.f, 100.f );
+        const U32 spawnedCount = aliveCount + 500u;
+        for ( U32 i = aliveCount; i < spawnedCount; ++i )
+        {
+            particles._position.set( i, float4{ position( rng ), position( rng ), position( rng ), 2.f } );
+        }
+        ParticleKernels::DistanceSq( particles._position, eyePos, particles._distanceSq, aliveCount, spawnedCount );
+
+        CHECK_TRUE( sorter.sort( sortPool, particles._distanceSq, spawnedCount, true, particles.gather() ) );
+        CHECK_TRUE( IsPermutation( sorter.order(), spawnedCount ) );
+        CHECK_EQUAL( CountInversions( sorter.order(), particles._distanceSq, 0.f ), 0u );
+        CHECK_EQUAL( CountGatherMismatches( particles, sorter.order() ), 0u );
+
+        // Large movement: too far from sorted, so we fall back to a full sort
+        Jitter( particles, spawnedCount, eyePos, 50.f, rng );
+        CHECK_FALSE( sorter.sort( sortPool, particles._distanceSq, spawnedCount, true, particles.gather() ) );
+        CHECK_TRUE( IsPermutation( sorter.order(), spawnedCount ) );
+        CHECK_EQUAL( CountInversions( sorter.order(), particles._distanceSq, QuantizationStep( particles._distanceSq, spawnedCount ) ), 0u );
+        CHECK_EQUAL( CountGatherMismatches( particles, sorter.order() ), 0u );
+
+        sorter.invalidate();
+        CHECK_FALSE( sorter.sort( sortPool, particles._distanceSq, spawnedCount, true, particles.gather() ) );
+    }
+
+    // All particles at the same distance
+    ParticleStream distanceSq;
+    distanceSq.resize( 100u, 4.f );
+    ParticleDepthSorter sorter;
+    CHECK_FALSE( sorter.sort( &pool, distanceSq, 100u, false, {} ) );
+    CHECK_TRUE( IsPermutation( sorter.order(), 100u ) );
+}
+
+TEST_CASE( "Particle Depth Sort Speed Test", "[particles]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool pool( "PARTICLE_DEPTH_SORT_SPEED_TEST" );
+    const bool init = pool.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    constexpr U32 particleCounts[] = { 100'000u, 1'000'000u };
+    constexpr size_t runCount = 8u;
+    const float3 eyePos{ 0.f, 0.f, 0.f };
+
+    for ( const U32 particleCount : particleCounts )
+    {
+        std::mt19937 rng( 3u );
+
+        TestParticles particles;
+        Generate( particles, particleCount, eyePos, rng );
+
+        // Reference: what ParticleData::sort() used to do
+        vector<std::pair<U32, F32>> indices( particleCount );
+        const D64 comparisonStart = Time::App::ElapsedMicroseconds();
+        for ( size_t run = 0u; run < runCount; ++run )
+        {
+            for ( U32 i = 0u; i < particleCount; ++i )
+            {
+                indices[i] = { i, particles._distanceSq[i] };
+            }
+            eastl::sort( indices.begin(), indices.end(), []( const std::pair<U32, F32>& lhs, const std::pair<U32, F32>& rhs )
+            {
+                return lhs.second > rhs.second;
+            } );
+            for ( U32 i = 0u; i < particleCount; ++i )
+            {
+                particles._renderingPositions[i].set( particles._position.get( indices[i].first ) );
+                Util::ToByteColour( particles._colour.get( indices[i].first ), particles._renderingColours[i] );
+            }
+        }
+        const D64 comparisonDurationUS = (Time::App::ElapsedMicroseconds() - comparisonStart) / runCount;
+
+        // Particles move a tiny bit between sorts (not timed), for some frame to frame coherence
+        const auto timeSorts = [&]( TaskPool* sortPool, const bool reuse, ParticleDepthSorter& sorter )
+        {
+            bool allReused = true;
+            D64 durationUS = 0.0;
+            for ( size_t run = 0u; run < runCount; ++run )
+            {
+                Jitter( particles, particleCount, eyePos, 0.0001f, rng );
+
+                const D64 start = Time::App::ElapsedMicroseconds();
+                allReused = sorter.sort( sortPool, particles._distanceSq, particleCount, reuse, particles.gather() ) && allReused;
+                durationUS += Time::App::ElapsedMicroseconds() - start;
+            }
+            return std::make_pair( durationUS / runCount, allReused );
+        };
+
+        ParticleDepthSorter sorter;
+        const D64 radixSerialDurationUS = timeSorts( nullptr, false, sorter ).first;
+        const D64 radixParallelDurationUS = timeSorts( &pool, false, sorter ).first;
+        CHECK_EQUAL( CountInversions( sorter.order(), particles._distanceSq, QuantizationStep( particles._distanceSq, particleCount ) ), 0u );
+
+        // The first fix-up after a full sort also has to order the particles that ended up sharing a quantized key
+        CHECK_TRUE( sorter.sort( &pool, particles._distanceSq, particleCount, true, particles.gather() ) );
+        const auto [reuseDurationUS, reused] = timeSorts( &pool, true, sorter );
+        CHECK_TRUE( reused );
+        CHECK_EQUAL( CountInversions( sorter.order(), particles._distanceSq, 0.f ), 0u );
+
+        std::cout << Util::StringFormat( "Particle depth sort speed test [ {} particles ]: comparison sort {:.2f} us, radix {:.2f} us, parallel radix {:.2f} us, reused order {:.2f} us",
+                                         particleCount,
+                                         comparisonDurationUS,
+                                         radixSerialDurationUS,
+                                         radixParallelDurationUS,
+                                         reuseDurationUS ) << std::endl;
+    }
+}
+
+} //namespace Divide
@@ -0,0 +1,294 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Dynamics/Entities/Particles/Headers/ParticleKernels.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    constexpr F32 g_dt = 1.f / 60.f;
+    constexpr F32 g_floorY = 0.f;
+    constexpr F32 g_bounceFactor = 0.5f;
+    const float3 g_accelerationDelta{ 0.f, -9.81f * g_dt, 0.f };
+
+    /// Same layout ParticleData used before it was split into streams
+    struct AoSParticles
+    {
+        vector<float4> _position, _velocity, _acceleration, _misc, _colour, _startColour, _endColour;
+    };
+
+    struct SoAParticles
+    {
+        ParticleAttribute _position, _velocity, _acceleration, _misc, _colour, _startColour, _endColour;
+    };
+
+    float4 RandomFloat4( std::mt19937& rng, const F32 min, const F32 max )
+    {
+        std::uniform_real_distribution<F32> value( min, max );
+        return { value( rng ), value( rng ), value( rng ), value( rng ) };
+    }
+
+    /// Life time (misc.x) is in [-0.5, 2] so some particles die on the first update
+    void Generate( const U32 count, const U32 seed, AoSParticles* aos, SoAParticles* soa )
+    {
+        std::mt19937 rng( seed );
+        std::uniform_real_distribution<F32> life( -0.5f, 2.f );
+
+        if ( aos != nullptr )
+        {
+            for ( vector<float4>* attribute : { &aos->_position, &aos->_velocity, &aos->_acceleration, &aos->_misc, &aos->_colour, &aos->_startColour, &aos->_endColour } )
+            {
+                attribute->resize( count );
+            }
+        }
+        if ( soa != nullptr )
+        {
+            for ( ParticleAttribute* attribute : { &soa->_position, &soa->_velocity, &soa->_acceleration, &soa->_misc, &soa->_colour, &soa->_startColour, &soa->_endColour } )
+            {
+                attribute->resize( count, 0.f );
+            }
+        }
+
+        for ( U32 i = 0u; i < count; ++i )
+        {
+            const float4 position = RandomFloat4( rng, -10.f, 10.f );
+            const float4 velocity = RandomFloat4( rng, -5.f, 5.f );
+            const float4 acceleration = RandomFloat4( rng, -1.f, 1.f );
+            const float4 startColour = RandomFloat4( rng, 0.f, 1.f );
+            const float4 endColour = RandomFloat4( rng, 0.f, 1.f );
+            const F32 time = life( rng );
+            const float4 misc{ time, 0.f, 1.f / 2.f, 0.f };
+
+            if ( aos != nullptr )
+            {
+                aos->_position[i] = position; aos->_velocity[i] = velocity; aos->_acceleration[i] = acceleration;
+                aos->_misc[i] = misc; aos->_colour[i] = startColour; aos->_startColour[i] = startColour; aos->_endColour[i] = endColour;
+            }
+            if ( soa != nullptr )
+            {
+                soa->_position.set( i, position ); soa->_velocity.set( i, velocity ); soa->_acceleration.set( i, acceleration );
+                soa->_misc.set( i, misc ); soa->_colour.set( i, startColour ); soa->_startColour.set( i, startColour ); soa->_endColour.set( i, endColour );
+            }
+        }
+    }
+
+    /// Reference: one particle at a time, the way the updaters worked before the SIMD kernels
+    void SimulateAoS( AoSParticles& p, const vector<float4>& attractors, const U32 start, const U32 end )
+    {
+        for ( U32 i = start; i < end; ++i )
+        {
+            float4& pos = p._position[i];
+            float4& vel = p._velocity[i];
+            float4& acc = p._acceleration[i];
+            float4& misc = p._misc[i];
+
+            for ( const float4& attractor : attractors )
+            {
+                const F32 oX = attractor.x - pos.x, oY = attractor.y - pos.y, oZ = attractor.z - pos.z;
+                const F32 force = attractor.w / ((oX * oX + oY * oY) + oZ * oZ);
+                acc.x += oX * force; acc.y += oY * force; acc.z += oZ * force;
+            }
+
+            acc.x += g_accelerationDelta.x; acc.y += g_accelerationDelta.y; acc.z += g_accelerationDelta.z;
+            vel.x += g_dt * acc.x; vel.y += g_dt * acc.y; vel.z += g_dt * acc.z;
+            pos.x += g_dt * vel.x; pos.y += g_dt * vel.y; pos.z += g_dt * vel.z;
+
+            if ( pos.y - pos.w / 2 < g_floorY )
+            {
+                if ( acc.y < 0.f )
+                {
+                    acc.y -= acc.y;
+                }
+                vel.y -= (1.f + g_bounceFactor) * vel.y;
+            }
+
+            const F32 t = misc.y;
+            p._colour[i] = { p._startColour[i].x * (1.f - t) + p._endColour[i].x * t,
+                             p._startColour[i].y * (1.f - t) + p._endColour[i].y * t,
+                             p._startColour[i].z * (1.f - t) + p._endColour[i].z * t,
+                             p._startColour[i].w * (1.f - t) + p._endColour[i].w * t };
+
+            misc.x -= g_dt;
+            misc.y = 1.f - misc.x * misc.z;
+        }
+    }
+
+    void SimulateSoA( SoAParticles& p, const vector<float4>& attractors, const U32 start, const U32 end )
+    {
+        ParticleKernels::Attract( p._position, p._acceleration, attractors, start, end );
+        ParticleKernels::Euler( p._acceleration, p._velocity, p._position, g_accelerationDelta, g_dt, start, end );
+        ParticleKernels::Floor( p._position, p._velocity, p._acceleration, g_floorY, g_bounceFactor, start, end );
+        ParticleKernels::LerpColour( p._startColour, p._endColour, p._misc._y, p._colour, start, end );
+        ParticleKernels::Age( p._misc, g_dt, start, end );
+    }
+
+    F32 MaxDifference( const vector<float4>& aos, const ParticleAttribute& soa, const U32 count )
+    {
+        F32 ret = 0.f;
+        for ( U32 i = 0u; i < count; ++i )
+        {
+            const float4 value = soa.get( i );
+            ret = std::max( ret, std::abs( aos[i].x - value.x ) );
+            ret = std::max( ret, std::abs( aos[i].y - value.y ) );
+            ret = std::max( ret, std::abs( aos[i].z - value.z ) );
+            ret = std::max( ret, std::abs( aos[i].w - value.w ) );
+        }
+        return ret;
+    }
+
+    vector<float4> MakeAttractors()
+    {
+        return { float4{ 20.f, 5.f, 0.f, 2.f }, float4{ -15.f, 10.f, 30.f, 0.5f } };
+    }
+}
+
+TEST_CASE( "Particle Kernels Test", "[particles]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    // Odd count and an odd split point so every kernel has to deal with unaligned starts and scalar tails
+    constexpr U32 particleCount = 1'003u;
+    constexpr U32 split = 517u;
+    constexpr size_t stepCount = 10u;
+
+    AoSParticles aos;
+    SoAParticles soa;
+    Generate( particleCount, 21u, &aos, &soa );
+
+    CHECK_EQUAL( reinterpret_cast<uintptr_t>(soa._position._x.data()) % ParticleStream::Alignment, 0u );
+    CHECK_EQUAL( reinterpret_cast<uintptr_t>(soa._misc._w.data()) % ParticleStream::Alignment, 0u );
+
+    const vector<float4> attractors = MakeAttractors();
+    for ( size_t step = 0u; step < stepCount; ++step )
+    {
+        SimulateAoS( aos, attractors, 0u, particleCount );
+        SimulateSoA( soa, attractors, 0u, split );
+        SimulateSoA( soa, attractors, split, particleCount );
+    }
+
+    // Same operations in the same order, but the compiler is free to contract the scalar reference into FMAs
+    CHECK_TRUE( MaxDifference( aos._position, soa._position, particleCount ) < 1e-3f );
+    CHECK_TRUE( MaxDifference( aos._velocity, soa._velocity, particleCount ) < 1e-3f );
+    CHECK_TRUE( MaxDifference( aos._acceleration, soa._acceleration, particleCount ) < 1e-3f );
+    CHECK_TRUE( MaxDifference( aos._misc, soa._misc, particleCount ) < 1e-4f );
+    CHECK_TRUE( MaxDifference( aos._colour, soa._colour, particleCount ) < 1e-4f );
+
+    const float3 eyePos{ 1.f, 2.f, 3.f };
+    ParticleStream distances;
+    distances.resize( particleCount, -1.f );
+    ParticleKernels::DistanceSq( soa._position, eyePos, distances, 0u, particleCount );
+
+    bool distancesMatch = true;
+    for ( U32 i = 0u; i < particleCount; ++i )
+    {
+        const F32 expected = soa._position.xyz( i ).distanceSquared( eyePos );
+        distancesMatch = distancesMatch && COMPARE_TOLERANCE( distances[i], expected, std::max( expected * 1e-5f, 1e-4f ) );
+    }
+    CHECK_TRUE( distancesMatch );
+}
+
+TEST_CASE( "Particle Compaction Test", "[particles]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr U32 particleCount = 1'003u;
+
+    std::mt19937 rng( 3u );
+    std::uniform_real_distribution<F32> life( -1.f, 1.f );
+
+    // Tag every particle with its original index so we can check what survived and in which order
+    ParticleStream time, tag;
+    time.resize( particleCount, 0.f );
+    tag.resize( particleCount, 0.f );
+
+    vector<F32> expected;
+    for ( U32 i = 0u; i < particleCount; ++i )
+    {
+        time[i] = life( rng );
+        tag[i] = to_F32( i );
+        if ( time[i] > 0.f )
+        {
+            expected.push_back( to_F32( i ) );
+        }
+    }
+
+    ParticleStream* streams[] = { &tag, &time };
+    const U32 aliveCount = ParticleKernels::Compact( time, particleCount, streams, 2u );
+    CHECK_EQUAL( aliveCount, to_U32( expected.size() ) );
+
+    bool orderMatches = true, allAlive = true;
+    for ( U32 i = 0u; i < aliveCount; ++i )
+    {
+        orderMatches = orderMatches && tag[i] == expected[i];
+        allAlive = allAlive && time[i] > 0.f;
+    }
+    CHECK_TRUE( orderMatches );
+    CHECK_TRUE( allAlive );
+
+    // Nothing left to remove
+    CHECK_EQUAL( ParticleKernels::Compact( time, aliveCount, streams, 2u ), aliveCount );
+}
+
+TEST_CASE( "Particle Kernels Speed Test", "[particles]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr U32 particleCounts[] = { 100'000u, 1'000'000u };
+    constexpr size_t stepCount = 8u;
+
+    const vector<float4> attractors = MakeAttractors();
+
+    for ( const U32 particleCount : particleCounts )
+    {
+        // One layout at a time to keep peak memory down
+        F32 scalarChecksum = 0.f, simdChecksum = 0.f;
+        D64 scalarDurationUS = 0.0, simdDurationUS = 0.0;
+        {
+            AoSParticles aos;
+            Generate( particleCount, 7u, &aos, nullptr );
+
+            const D64 start = Time::App::ElapsedMicroseconds();
+            for ( size_t step = 0u; step < stepCount; ++step )
+            {
+                SimulateAoS( aos, attractors, 0u, particleCount );
+            }
+            scalarDurationUS = Time::App::ElapsedMicroseconds() - start;
+
+            for ( U32 i = 0u; i < particleCount; i += 1024u )
+            {
+                scalarChecksum += aos._position[i].y;
+            }
+        }
+        {
+            SoAParticles soa;
+            Generate( particleCount, 7u, nullptr, &soa );
+
+            const D64 start = Time::App::ElapsedMicroseconds();
+            for ( size_t step = 0u; step < stepCount; ++step )
+            {
+                SimulateSoA( soa, attractors, 0u, particleCount );
+            }
+            simdDurationUS = Time::App::ElapsedMicroseconds() - start;
+
+            for ( U32 i = 0u; i < particleCount; i += 1024u )
+            {
+                simdChecksum += soa._position._y[i];
+            }
+        }
+
+        CHECK_TRUE( COMPARE_TOLERANCE( scalarChecksum, simdChecksum, std::max( std::abs( scalarChecksum ) * 1e-4f, 1e-2f ) ) );
+
+        const D64 particleSteps = to_D64( particleCount ) * stepCount;
+        std::cout << Util::StringFormat( "Particle update speed test [ {} particles ]: scalar AoS {:.0f} particles/ms, SIMD SoA {:.0f} particles/ms",
+                                         particleCount,
+                                         particleSteps / (scalarDurationUS / 1000.0),
+                                         particleSteps / (simdDurationUS / 1000.0) ) << std::endl;
+    }
+}
+
+} //namespace Divide
@@ -0,0 +1,255 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Graphs/Headers/SGNRelationshipIndex.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    using RelationshipType = SGNRelationshipIndex::RelationshipType;
+    using NodeID = SGNRelationshipIndex::NodeID;
+
+    /// Reference result: walk the parent pointers. Tree roots never count as parents, same as the index
+    RelationshipType Classify( const vector<NodeID>& parents, const NodeID node, const NodeID target )
+    {
+        if ( node == target )
+        {
+            return RelationshipType::COUNT;
+        }
+
+        const auto isDescendant = [&parents]( NodeID it, const NodeID ancestor )
+        {
+            for ( it = parents[it]; it != SGNRelationshipIndex::INVALID_NODE; it = parents[it] )
+            {
+                if ( it == ancestor )
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        if ( parents[target] == node )
+        {
+            return RelationshipType::CHILD;
+        }
+        if ( isDescendant( target, node ) )
+        {
+            return RelationshipType::GRANDCHILD;
+        }
+        if ( parents[target] != SGNRelationshipIndex::INVALID_NODE )
+        {
+            if ( parents[node] == target )
+            {
+                return RelationshipType::PARENT;
+            }
+            if ( isDescendant( node, target ) )
+            {
+                return RelationshipType::GRANDPARENT;
+            }
+        }
+        if ( parents[node] == parents[target] && parents[node] != SGNRelationshipIndex::INVALID_NODE )
+        {
+            return RelationshipType::SIBLING;
+        }
+
+        return RelationshipType::COUNT;
+    }
+
+    /// Same layout as the old per node relationship cache: every descendant of a node, tagged with its depth
+    struct CacheEntry
+    {
+        NodeID _node{ SGNRelationshipIndex::INVALID_NODE };
+        U16 _level{ 0u };
+    };
+
+    void GatherChildren( const vector<vector<NodeID>>& children, const NodeID node, const U16 level, vector<CacheEntry>& cacheOut )
+    {
+        for ( const NodeID child : children[node] )
+        {
+            cacheOut.push_back( { child, level } );
+            GatherChildren( children, child, level + 1u, cacheOut );
+        }
+    }
+}
+
+TEST_CASE( "SGN Relationship Index Test", "[scene_graph]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    SGNRelationshipIndex index;
+
+    const NodeID root = index.add( SGNRelationshipIndex::INVALID_NODE );
+    const NodeID a = index.add( root );
+    const NodeID b = index.add( root );
+    const NodeID a1 = index.add( a );
+    const NodeID a11 = index.add( a1 );
+
+    CHECK_EQUAL( index.size(), 5u );
+    CHECK_TRUE( index.validate() );
+    CHECK_TRUE( index.isRelated( root, a, RelationshipType::CHILD ) );
+    CHECK_TRUE( index.isRelated( root, a11, RelationshipType::GRANDCHILD ) );
+    CHECK_TRUE( index.isRelated( a11, a, RelationshipType::GRANDPARENT ) );
+    CHECK_TRUE( index.isRelated( a1, a, RelationshipType::PARENT ) );
+    CHECK_TRUE( index.isRelated( a, b, RelationshipType::SIBLING ) );
+    // The root node is ignored when considering parent/grandparent status
+    CHECK_EQUAL( index.classify( a, root ), RelationshipType::COUNT );
+    CHECK_EQUAL( index.classify( a11, root ), RelationshipType::COUNT );
+    CHECK_EQUAL( index.classify( b, a1 ), RelationshipType::COUNT );
+
+    // Moving a node takes its subtree along
+    index.changeParent( a1, b );
+    CHECK_TRUE( index.validate() );
+    CHECK_EQUAL( index.classify( b, a11 ), RelationshipType::GRANDCHILD );
+    CHECK_EQUAL( index.classify( a, a11 ), RelationshipType::COUNT );
+
+    // Orphaned children become roots
+    index.remove( b );
+    CHECK_EQUAL( index.size(), 4u );
+    CHECK_TRUE( index.validate() );
+    CHECK_EQUAL( index.classify( root, a1 ), RelationshipType::COUNT );
+    CHECK_EQUAL( index.classify( a1, a11 ), RelationshipType::CHILD );
+    CHECK_EQUAL( index.classify( b, a1 ), RelationshipType::COUNT );
+
+    // Random operations against a plain parent pointer reference. Always appending to the same parent eats up the label gaps quickly, so this also covers relabeling
+    std::mt19937 rng( 3u );
+    index.clear();
+    vector<NodeID> parents, alive;
+    const auto setParent = [&parents]( const NodeID node, const NodeID parent )
+    {
+        if ( parents.size() <= node )
+        {
+            parents.resize( node + 1u, SGNRelationshipIndex::INVALID_NODE );
+        }
+        parents[node] = parent;
+    };
+
+    bool resultsMatch = true;
+    for ( size_t op = 0u; op < 4'000u; ++op )
+    {
+        const U32 action = std::uniform_int_distribution<U32>( 0u, 9u )( rng );
+        const NodeID randomNode = alive.empty() ? SGNRelationshipIndex::INVALID_NODE : alive[std::uniform_int_distribution<size_t>( 0u, alive.size() - 1u )( rng )];
+
+        if ( action < 6u || alive.size() < 2u )
+        {
+            const NodeID parent = action == 0u ? SGNRelationshipIndex::INVALID_NODE : randomNode;
+            const NodeID node = index.add( parent );
+            setParent( node, parent );
+            alive.push_back( node );
+        }
+        else if ( action < 8u )
+        {
+            const NodeID newParent = alive[std::uniform_int_distribution<size_t>( 0u, alive.size() - 1u )( rng )];
+            if ( newParent != randomNode && Classify( parents, randomNode, newParent ) != RelationshipType::GRANDCHILD && Classify( parents, randomNode, newParent ) != RelationshipType::CHILD )
+            {
+                index.changeParent( randomNode, newParent );
+                setParent( randomNode, newParent );
+            }
+        }
+        else
+        {
+            index.remove( randomNode );
+            for ( NodeID& parent : parents )
+            {
+                if ( parent == randomNode )
+                {
+                    parent = SGNRelationshipIndex::INVALID_NODE;
+                }
+            }
+            erase_if( alive, [randomNode]( const NodeID node ) { return node == randomNode; } );
+        }
+
+        if ( op % 100u == 0u )
+        {
+            resultsMatch = resultsMatch && index.validate();
+            for ( const NodeID node : alive )
+            {
+                for ( const NodeID target : alive )
+                {
+                    resultsMatch = resultsMatch && index.classify( node, target ) == Classify( parents, node, target );
+                }
+            }
+        }
+    }
+
+    CHECK_TRUE( resultsMatch );
+    CHECK_EQUAL( index.size(), alive.size() );
+
+    index.clear();
+    CHECK_EQUAL( index.size(), 0u );
+    CHECK_TRUE( index.validate() );
+}
+
+TEST_CASE( "SGN Relationship Index Speed Test", "[scene_graph]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr size_t nodeCounts[] = { 1'000u, 10'000u };
+    constexpr size_t childrenPerNode = 4u;
+    constexpr size_t queryCount = 4'096u;
+
+    for ( const size_t nodeCount : nodeCounts )
+    {
+        SGNRelationshipIndex index;
+        vector<NodeID> nodes( nodeCount );
+        vector<vector<NodeID>> children( nodeCount );
+
+        // Breadth first layout: node i is the parent of nodes [i * N + 1, i * N + N]
+        nodes[0] = index.add( SGNRelationshipIndex::INVALID_NODE );
+        for ( size_t i = 1u; i < nodeCount; ++i )
+        {
+            const size_t parent = (i - 1u) / childrenPerNode;
+            nodes[i] = index.add( nodes[parent] );
+            children[parent].push_back( to_U32( i ) );
+        }
+
+        // The old cache only kept a flat list per node. Querying the root's list is the worst case and the common one (e.g. "is this node in the scene")
+        vector<CacheEntry> rootCache;
+        GatherChildren( children, 0u, 0u, rootCache );
+
+        vector<NodeID> targets( queryCount );
+        for ( size_t i = 0u; i < queryCount; ++i )
+        {
+            targets[i] = to_U32( (i * 7919u) % nodeCount );
+        }
+
+        size_t cacheHits = 0u, indexHits = 0u;
+
+        const D64 cacheStart = Time::App::ElapsedMicroseconds();
+        for ( const NodeID target : targets )
+        {
+            for ( const CacheEntry& entry : rootCache )
+            {
+                if ( entry._node == target )
+                {
+                    ++cacheHits;
+                    break;
+                }
+            }
+        }
+        const D64 cacheDurationUS = Time::App::ElapsedMicroseconds() - cacheStart;
+
+        const D64 indexStart = Time::App::ElapsedMicroseconds();
+        for ( const NodeID target : targets )
+        {
+            const RelationshipType type = index.classify( nodes[0], nodes[target] );
+            indexHits += type == RelationshipType::CHILD || type == RelationshipType::GRANDCHILD ? 1u : 0u;
+        }
+        const D64 indexDurationUS = Time::App::ElapsedMicroseconds() - indexStart;
+
+        CHECK_EQUAL( cacheHits, indexHits );
+
+        std::cout << Util::StringFormat( "Relationship query speed test [ {} nodes, {} queries ]: cached list {:.3f} us/query, interval index {:.3f} us/query",
+                                         nodeCount,
+                                         queryCount,
+                                         cacheDurationUS / queryCount,
+                                         indexDurationUS / queryCount ) << std::endl;
+    }
+}
+
+} //namespace Divide
@@ -0,0 +1,138 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Graphs/Headers/SceneGraphNodeIndex.h"
+
+#include <iostream>
+
+namespace Divide
+{
+
+namespace
+{
+    /// Mirrors the bits of SceneGraphNode that the recursive child search relies on
+    struct TestNode
+    {
+        I64 _guid{ -1 };
+        U64 _nameHash{ 0u };
+        U64 _sceneNodeNameHash{ 0u };
+        mutable SharedMutex _lock;
+        vector<TestNode*> _children;
+
+        [[nodiscard]] TestNode* findChildByGUID( const I64 guid ) const
+        {
+            SharedLock<SharedMutex> r_lock( _lock );
+            for ( TestNode* child : _children )
+            {
+                if ( child->_guid == guid )
+                {
+                    return child;
+                }
+
+                TestNode* recChild = child->findChildByGUID( guid );
+                if ( recChild != nullptr )
+                {
+                    return recChild;
+                }
+            }
+
+            return nullptr;
+        }
+    };
+}
+
+TEST_CASE( "SceneGraph Node Index Test", "[scene_graph]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    SceneGraphNodeIndex<TestNode> index;
+
+    TestNode nodeA{ ._guid = 1, ._nameHash = _ID( "A" ), ._sceneNodeNameHash = _ID( "Mesh" ) };
+    TestNode nodeB{ ._guid = 2, ._nameHash = _ID( "B" ), ._sceneNodeNameHash = _ID( "Mesh" ) };
+
+    index.add( nodeA._guid, nodeA._nameHash, nodeA._sceneNodeNameHash, &nodeA );
+    index.add( nodeB._guid, nodeB._nameHash, nodeB._sceneNodeNameHash, &nodeB );
+    // Re-adding (e.g. after a parent change) must not create duplicate entries
+    index.add( nodeA._guid, nodeA._nameHash, nodeA._sceneNodeNameHash, &nodeA );
+
+    CHECK_EQUAL( index.size(), 2u );
+    CHECK_EQUAL( index.find( 1 ), &nodeA );
+    CHECK_EQUAL( index.find( 2 ), &nodeB );
+    CHECK_EQUAL( index.find( 3 ), nullptr );
+    CHECK_EQUAL( index.findByName( _ID( "B" ) ), &nodeB );
+    CHECK_EQUAL( index.findBySceneNodeName( _ID( "Mesh" ) ), &nodeA );
+
+    index.remove( nodeA._guid, nodeA._nameHash, nodeA._sceneNodeNameHash );
+    CHECK_EQUAL( index.find( 1 ), nullptr );
+    CHECK_EQUAL( index.findByName( _ID( "A" ) ), nullptr );
+    // Shared scene node names fall back to the remaining node
+    CHECK_EQUAL( index.findBySceneNodeName( _ID( "Mesh" ) ), &nodeB );
+
+    index.clear();
+    CHECK_EQUAL( index.size(), 0u );
+    CHECK_EQUAL( index.find( 2 ), nullptr );
+}
+
+TEST_CASE( "SceneGraph Node Index Speed Test", "[scene_graph]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr size_t nodeCounts[] = { 10'000u, 100'000u };
+    constexpr size_t childrenPerNode = 4u;
+    constexpr size_t lookupCount = 256u;
+
+    for ( const size_t nodeCount : nodeCounts )
+    {
+        const std::unique_ptr<TestNode[]> nodes = std::make_unique<TestNode[]>( nodeCount );
+        SceneGraphNodeIndex<TestNode> index;
+
+        // Breadth first layout: node i is the parent of nodes [i * N + 1, i * N + N]
+        for ( size_t i = 0u; i < nodeCount; ++i )
+        {
+            TestNode& node = nodes[i];
+            node._guid = to_I64( i ) + 1;
+            node._nameHash = _ID( Util::StringFormat( "Node_{}", i ).c_str() );
+            if ( i > 0u )
+            {
+                nodes[(i - 1u) / childrenPerNode]._children.push_back( &node );
+            }
+            index.add( node._guid, node._nameHash, node._sceneNodeNameHash, &node );
+        }
+
+        vector<I64> targets( lookupCount );
+        for ( size_t i = 0u; i < lookupCount; ++i )
+        {
+            // Spread the lookups over the whole tree, deterministically
+            targets[i] = nodes[(i * 7919u) % nodeCount]._guid;
+        }
+
+        size_t treeHits = 0u, indexHits = 0u;
+
+        const D64 treeStart = Time::App::ElapsedMicroseconds();
+        for ( const I64 guid : targets )
+        {
+            const TestNode* node = guid == nodes[0]._guid ? &nodes[0] : nodes[0].findChildByGUID( guid );
+            treeHits += node != nullptr && node->_guid == guid ? 1u : 0u;
+        }
+        const D64 treeDurationUS = Time::App::ElapsedMicroseconds() - treeStart;
+
+        const D64 indexStart = Time::App::ElapsedMicroseconds();
+        for ( const I64 guid : targets )
+        {
+            const TestNode* node = index.find( guid );
+            indexHits += node != nullptr && node->_guid == guid ? 1u : 0u;
+        }
+        const D64 indexDurationUS = Time::App::ElapsedMicroseconds() - indexStart;
+
+        CHECK_EQUAL( treeHits, lookupCount );
+        CHECK_EQUAL( indexHits, lookupCount );
+
+        std::cout << Util::StringFormat( "Node lookup speed test [ {} nodes, {} lookups ]: tree walk {:.2f} us/lookup, index {:.3f} us/lookup",
+                                         nodeCount,
+                                         lookupCount,
+                                         treeDurationUS / lookupCount,
+                                         indexDurationUS / lookupCount ) << std::endl;
+    }
+}
+
+} //namespace Divide
@@ -0,0 +1,237 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "Core/Math/BoundingVolumes/Headers/DynamicAABBTree.h"
+#include "Rendering/Camera/Headers/Camera.h"
+#include "Rendering/Camera/Headers/Frustum.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    /// Bare bones scene graph: bounds of every node enclose the bounds of all of its children
+    struct TestScene
+    {
+        struct Node
+        {
+            BoundingBox _bounds;
+            vector<U32> _children;
+        };
+
+        vector<Node> _nodes;
+        vector<U32> _leaves;
+    };
+
+    /// Leaves are scattered randomly, so (just like in a real scene) the hierarchy doesn't follow any spatial grouping
+    TestScene BuildScene( const size_t leafCount, const size_t childrenPerNode, std::mt19937& rng )
+    {
+        std::uniform_real_distribution<F32> position( -1000.f, 1000.f );
+        std::uniform_real_distribution<F32> size( 0.5f, 5.f );
+
+        TestScene scene;
+        scene._nodes.resize( 1u );
+
+        // Breadth first: grow the tree level by level until we have enough leaves
+        vector<U32> level = { 0u };
+        while ( level.size() * childrenPerNode < leafCount )
+        {
+            vector<U32> nextLevel;
+            for ( const U32 parent : level )
+            {
+                for ( size_t i = 0u; i < childrenPerNode; ++i )
+                {
+                    nextLevel.push_back( to_U32( scene._nodes.size() ) );
+                    scene._nodes[parent]._children.push_back( nextLevel.back() );
+                    scene._nodes.emplace_back();
+                }
+            }
+            level = MOV( nextLevel );
+        }
+
+        for ( size_t i = 0u; i < leafCount; ++i )
+        {
+            const U32 parent = level[i % level.size()];
+            const U32 leaf = to_U32( scene._nodes.size() );
+            scene._nodes[parent]._children.push_back( leaf );
+
+            const float3 min{ position( rng ), position( rng ), position( rng ) };
+            scene._nodes.emplace_back()._bounds.set( min, min + float3{ size( rng ), size( rng ), size( rng ) } );
+            scene._leaves.push_back( leaf );
+        }
+
+        // Children always have a higher index than their parent, so a reverse pass computes all of the enclosing bounds
+        for ( I64 i = to_I64( scene._nodes.size() ) - 1; i >= 0; --i )
+        {
+            TestScene::Node& node = scene._nodes[i];
+            if ( !node._children.empty() )
+            {
+                node._bounds = scene._nodes[node._children.front()]._bounds;
+                for ( const U32 child : node._children )
+                {
+                    node._bounds.add( scene._nodes[child]._bounds );
+                }
+            }
+        }
+
+        return scene;
+    }
+
+    void AddAllLeaves( const TestScene& scene, const U32 nodeIdx, vector<U32>& visibleOut )
+    {
+        const TestScene::Node& node = scene._nodes[nodeIdx];
+        if ( node._children.empty() )
+        {
+            visibleOut.push_back( nodeIdx );
+        }
+        for ( const U32 child : node._children )
+        {
+            AddAllLeaves( scene, child, visibleOut );
+        }
+    }
+
+    /// Same logic as RenderPassCuller::FrustumCullNode: skip OUT branches and stop testing once a parent is fully IN
+    void HierarchyCull( const TestScene& scene, const Frustum& frustum, const U32 nodeIdx, vector<U32>& visibleOut )
+    {
+        const TestScene::Node& node = scene._nodes[nodeIdx];
+        switch ( frustum.ClassifyBoundingBox( node._bounds ) )
+        {
+            case FrustumCollision::FRUSTUM_OUT: return;
+            case FrustumCollision::FRUSTUM_IN: AddAllLeaves( scene, nodeIdx, visibleOut ); return;
+            default: break;
+        }
+
+        if ( node._children.empty() )
+        {
+            visibleOut.push_back( nodeIdx );
+        }
+        for ( const U32 child : node._children )
+        {
+            HierarchyCull( scene, frustum, child, visibleOut );
+        }
+    }
+
+    /// Same logic as RenderPassCuller::FrustumCullSpatialIndex: SceneGraphCullingIndex runs the batched frustum test on every level of the tree
+    void IndexCull( const TestScene& scene, const DynamicAABBTree<U32>& index, const Frustum& frustum, vector<U32>& visibleOut )
+    {
+        vector<F32> scratch;
+        index.cullBatched( [&frustum, &scratch]( const BoundingBox* const* aabbs, const size_t count, FrustumCollision* resultsOut )
+                    {
+                        scratch.resize( count * 6u );
+                        for ( size_t i = 0u; i < count; ++i )
+                        {
+                            scratch[i + count * 0u] = aabbs[i]->_min.x;
+                            scratch[i + count * 1u] = aabbs[i]->_min.y;
+                            scratch[i + count * 2u] = aabbs[i]->_min.z;
+                            scratch[i + count * 3u] = aabbs[i]->_max.x;
+                            scratch[i + count * 4u] = aabbs[i]->_max.y;
+                            scratch[i + count * 5u] = aabbs[i]->_max.z;
+                        }
+
+                        frustum.ContainsBoundingBoxes( BoundingBoxesSoA
+                        {
+                            ._minX = scratch.data() + count * 0u,
+                            ._minY = scratch.data() + count * 1u,
+                            ._minZ = scratch.data() + count * 2u,
+                            ._maxX = scratch.data() + count * 3u,
+                            ._maxY = scratch.data() + count * 4u,
+                            ._maxZ = scratch.data() + count * 5u,
+                            ._count = count
+                        }, VECTOR3_ZERO, resultsOut );
+                    },
+                    [&]( const U32 proxy, const bool fullyInside )
+                    {
+                        const U32 nodeIdx = index.userData( proxy );
+                        if ( fullyInside || frustum.ClassifyBoundingBox( scene._nodes[nodeIdx]._bounds ) != FrustumCollision::FRUSTUM_OUT )
+                        {
+                            visibleOut.push_back( nodeIdx );
+                        }
+                    } );
+    }
+
+    Frustum MakeFrustum( const float3& eye, const float3& target )
+    {
+        mat4<F32> viewProjection;
+        mat4<F32>::Multiply( Camera::Perspective( Angle::DEGREES_F( 60.f ), 16.f / 9.f, 0.1f, 800.f ),
+                             Camera::LookAt( eye, target, WORLD_Y_AXIS ),
+                             viewProjection );
+
+        Frustum frustum;
+        frustum.computePlanes( viewProjection );
+        return frustum;
+    }
+}
+
+TEST_CASE( "Spatial Index Culling Test", "[culling]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    struct SceneLayout
+    {
+        const char* _name;
+        size_t _childrenPerNode;
+    };
+
+    // Flat: thousands of root children. Deep: small branching factor, tiny leaves many levels down
+    constexpr SceneLayout layouts[] = { { "flat", 20'000u }, { "deep", 4u } };
+    constexpr size_t leafCount = 20'000u;
+    constexpr size_t viewCount = 32u;
+
+    for ( const SceneLayout& layout : layouts )
+    {
+        std::mt19937 rng( 7u );
+        const TestScene scene = BuildScene( leafCount, layout._childrenPerNode, rng );
+
+        DynamicAABBTree<U32> index;
+        for ( const U32 leaf : scene._leaves )
+        {
+            [[maybe_unused]] const U32 proxy = index.createProxy( scene._nodes[leaf]._bounds, leaf );
+        }
+        CHECK_TRUE( index.validate() );
+
+        std::uniform_real_distribution<F32> position( -1000.f, 1000.f );
+        vector<Frustum> views( viewCount );
+        for ( Frustum& view : views )
+        {
+            view = MakeFrustum( float3{ position( rng ), position( rng ), position( rng ) }, float3{ position( rng ), position( rng ), position( rng ) } );
+        }
+
+        vector<U32> hierarchyVisible, indexVisible;
+        bool resultsMatch = true;
+        size_t totalVisible = 0u;
+
+        D64 hierarchyDurationUS = 0.0, indexDurationUS = 0.0;
+        for ( const Frustum& view : views )
+        {
+            hierarchyVisible.resize( 0 );
+            indexVisible.resize( 0 );
+
+            const D64 hierarchyStart = Time::App::ElapsedMicroseconds();
+            HierarchyCull( scene, view, 0u, hierarchyVisible );
+            hierarchyDurationUS += Time::App::ElapsedMicroseconds() - hierarchyStart;
+
+            const D64 indexStart = Time::App::ElapsedMicroseconds();
+            IndexCull( scene, index, view, indexVisible );
+            indexDurationUS += Time::App::ElapsedMicroseconds() - indexStart;
+
+            eastl::sort( hierarchyVisible.begin(), hierarchyVisible.end() );
+            eastl::sort( indexVisible.begin(), indexVisible.end() );
+            resultsMatch = resultsMatch && hierarchyVisible == indexVisible;
+            totalVisible += indexVisible.size();
+        }
+
+        CHECK_TRUE( resultsMatch );
+
+        std::cout << Util::StringFormat( "Culling speed test [ {} scene, {} leaves, {:.1f} visible on average ]: hierarchy walk {:.2f} us/view, spatial index {:.2f} us/view",
+                                         layout._name,
+                                         leafCount,
+                                         to_D64( totalVisible ) / viewCount,
+                                         hierarchyDurationUS / viewCount,
+                                         indexDurationUS / viewCount ) << std::endl;
+    }
+}
+
+} //namespace Divide
@@ -0,0 +1,307 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Core/Time/Headers/ApplicationTimer.h"
+#include "ECS/Systems/Headers/TransformHierarchy.h"
+
+#include <iostream>
+#include <random>
+
+namespace Divide
+{
+
+namespace
+{
+    /// Same data and logic TransformSystem used before the hierarchy: recurse up through parent pointers
+    struct TestNode
+    {
+        TransformValues _local;
+        TransformValues _world;
+        mat4<F32> _worldMatrix;
+        TestNode* _parent{ nullptr };
+        bool _localRotations{ false };
+        bool _computed{ false };
+    };
+
+    void ComputeWorld( TestNode* node )
+    {
+        if ( node->_computed )
+        {
+            return;
+        }
+
+        node->_world = node->_local;
+        if ( node->_parent != nullptr )
+        {
+            ComputeWorld( node->_parent );
+
+            const TransformValues& parentWorld = node->_parent->_world;
+            node->_world._orientation = parentWorld._orientation * node->_world._orientation;
+            node->_world._scale = parentWorld._scale * node->_world._scale;
+
+            const float3 worldPosition = node->_localRotations ? node->_world._translation
+                                                               : parentWorld._orientation * (parentWorld._scale * node->_world._translation);
+            node->_world._translation = parentWorld._translation + worldPosition;
+        }
+
+        node->_worldMatrix = mat4<F32>{ node->_world._translation, node->_world._scale, node->_world._orientation.getConjugate() };
+        node->_computed = true;
+    }
+
+    TransformValues RandomTransform( std::mt19937& rng )
+    {
+        std::uniform_real_distribution<F32> position( -10.f, 10.f );
+        std::uniform_real_distribution<F32> scale( 0.5f, 1.5f );
+        std::uniform_real_distribution<F32> angle( -M_PI_f, M_PI_f );
+
+        TransformValues ret;
+        ret._translation = { position( rng ), position( rng ), position( rng ) };
+        ret._scale = { scale( rng ), scale( rng ), scale( rng ) };
+        ret._orientation.fromEuler( Angle::RADIANS_F( angle( rng ) ), Angle::RADIANS_F( angle( rng ) ), Angle::RADIANS_F( angle( rng ) ) );
+        return ret;
+    }
+
+    /// Mostly bushy (random earlier node as parent, so depth grows slowly) with a few long chains mixed in
+    vector<U32> RandomParents( const size_t count, std::mt19937& rng )
+    {
+        vector<U32> parents( count, TransformHierarchy::INVALID_INDEX );
+        for ( size_t i = 1u; i < count; ++i )
+        {
+            const U32 roll = std::uniform_int_distribution<U32>( 0u, 99u )( rng );
+            if ( roll < 2u )
+            {
+                continue;
+            }
+
+            parents[i] = roll < 10u ? to_U32( i - 1u ) : std::uniform_int_distribution<U32>( 0u, to_U32( i - 1u ) )( rng );
+        }
+        return parents;
+    }
+
+    bool Matches( const TransformValues& lhs, const TransformValues& rhs )
+    {
+        constexpr F32 tolerance = 1e-3f;
+        for ( U8 i = 0u; i < 3u; ++i )
+        {
+            if ( !COMPARE_TOLERANCE( lhs._translation[i], rhs._translation[i], tolerance ) ||
+                 !COMPARE_TOLERANCE( lhs._scale[i], rhs._scale[i], tolerance ) )
+            {
+                return false;
+            }
+        }
+
+        return COMPARE_TOLERANCE( lhs._orientation.X(), rhs._orientation.X(), tolerance ) &&
+               COMPARE_TOLERANCE( lhs._orientation.Y(), rhs._orientation.Y(), tolerance ) &&
+               COMPARE_TOLERANCE( lhs._orientation.Z(), rhs._orientation.Z(), tolerance ) &&
+               COMPARE_TOLERANCE( lhs._orientation.W(), rhs._orientation.W(), tolerance );
+    }
+
+    void SetupNodes( const vector<U32>& parents, vector<TestNode>& nodes, TransformHierarchy& hierarchy, std::mt19937& rng )
+    {
+        nodes.resize( parents.size() );
+        hierarchy.build( parents );
+
+        for ( size_t i = 0u; i < parents.size(); ++i )
+        {
+            TestNode& node = nodes[i];
+            node._parent = parents[i] == TransformHierarchy::INVALID_INDEX ? nullptr : &nodes[parents[i]];
+            node._local = RandomTransform( rng );
+            node._localRotations = std::uniform_int_distribution<U32>( 0u, 4u )( rng ) == 0u;
+            hierarchy.setLocal( hierarchy.slot( to_U32( i ) ), node._local, node._localRotations );
+        }
+    }
+}
+
+TEST_CASE( "Transform Hierarchy Test", "[transform]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool pool( "TRANSFORM_HIERARCHY_TEST" );
+    const bool init = pool.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    std::mt19937 rng( 17u );
+
+    // Odd count so that some levels leave a partial SIMD group
+    constexpr size_t nodeCount = 2'003u;
+    const vector<U32> parents = RandomParents( nodeCount, rng );
+
+    vector<TestNode> nodes;
+    TransformHierarchy hierarchy;
+    SetupNodes( parents, nodes, hierarchy, rng );
+
+    CHECK_EQUAL( hierarchy.size(), nodeCount );
+    CHECK_TRUE( hierarchy.levelCount() > 1u );
+
+    // Parents must always be processed before their children
+    bool layoutValid = true;
+    for ( U32 i = 0u; i < nodeCount; ++i )
+    {
+        const U32 slot = hierarchy.slot( i );
+        const U32 parentSlot = hierarchy.parentSlot( slot );
+        layoutValid = layoutValid && (parents[i] == TransformHierarchy::INVALID_INDEX ? parentSlot == TransformHierarchy::INVALID_INDEX
+                                                                                      : parentSlot == hierarchy.slot( parents[i] ) && parentSlot < slot);
+    }
+    CHECK_TRUE( layoutValid );
+
+    // Serial and parallel paths must agree with the reference
+    for ( TaskPool* updatePool : { static_cast<TaskPool*>(nullptr), &pool } )
+    {
+        for ( TestNode& node : nodes )
+        {
+            node._computed = false;
+            hierarchy.setLocal( hierarchy.slot( to_U32( &node - nodes.data() ) ), node._local, node._localRotations );
+        }
+        hierarchy.update( updatePool, 64u );
+
+        size_t mismatches = 0u, unchanged = 0u;
+        for ( size_t i = 0u; i < nodeCount; ++i )
+        {
+            ComputeWorld( &nodes[i] );
+
+            const U32 slot = hierarchy.slot( to_U32( i ) );
+            mismatches += Matches( hierarchy.worldValues( slot ), nodes[i]._world ) ? 0u : 1u;
+            mismatches += hierarchy.worldMatrix( slot ).compare( nodes[i]._worldMatrix, 1e-3f ) ? 0u : 1u;
+            unchanged += hierarchy.worldChanged( slot ) ? 0u : 1u;
+        }
+
+        CHECK_EQUAL( mismatches, 0u );
+        CHECK_EQUAL( unchanged, 0u );
+    }
+
+    // Partial update: only the edited nodes and their descendants may change
+    vector<bool> expectChanged( nodeCount, false );
+    for ( size_t i = 0u; i < nodeCount; i += 97u )
+    {
+        nodes[i]._local = RandomTransform( rng );
+        hierarchy.setLocal( hierarchy.slot( to_U32( i ) ), nodes[i]._local, nodes[i]._localRotations );
+        expectChanged[i] = true;
+    }
+    // Parents always have a lower index than their children
+    for ( size_t i = 0u; i < nodeCount; ++i )
+    {
+        expectChanged[i] = expectChanged[i] || (parents[i] != TransformHierarchy::INVALID_INDEX && expectChanged[parents[i]]);
+        nodes[i]._computed = !expectChanged[i];
+    }
+
+    hierarchy.update( &pool, 64u );
+
+    size_t mismatches = 0u, wrongFlags = 0u;
+    for ( size_t i = 0u; i < nodeCount; ++i )
+    {
+        ComputeWorld( &nodes[i] );
+
+        const U32 slot = hierarchy.slot( to_U32( i ) );
+        mismatches += Matches( hierarchy.worldValues( slot ), nodes[i]._world ) ? 0u : 1u;
+        wrongFlags += hierarchy.worldChanged( slot ) != expectChanged[i] ? 1u : 0u;
+    }
+    CHECK_EQUAL( mismatches, 0u );
+    CHECK_EQUAL( wrongFlags, 0u );
+
+    // Nothing dirty: nothing changes
+    hierarchy.update( &pool, 64u );
+    size_t changed = 0u;
+    for ( U32 slot = 0u; slot < nodeCount; ++slot )
+    {
+        changed += hierarchy.worldChanged( slot ) ? 1u : 0u;
+    }
+    CHECK_EQUAL( changed, 0u );
+
+    hierarchy.clear();
+    CHECK_EQUAL( hierarchy.size(), 0u );
+    CHECK_EQUAL( hierarchy.levelCount(), 0u );
+
+    pool.shutdown();
+}
+
+TEST_CASE( "Transform Hierarchy Speed Test", "[transform]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool pool( "TRANSFORM_HIERARCHY_SPEED_TEST" );
+    const bool init = pool.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    constexpr size_t nodeCount = 100'000u;
+    constexpr size_t runCount = 8u;
+    constexpr U32 partitionSize = 256u;
+
+    std::mt19937 rng( 23u );
+    const vector<U32> parents = RandomParents( nodeCount, rng );
+
+    vector<TestNode> nodes;
+    TransformHierarchy hierarchy;
+    SetupNodes( parents, nodes, hierarchy, rng );
+
+    // Components don't live in hierarchy order, so visit them in a random order, like the old code did
+    vector<TestNode*> componentOrder( nodeCount );
+    for ( size_t i = 0u; i < nodeCount; ++i )
+    {
+        componentOrder[i] = &nodes[i];
+    }
+    std::shuffle( componentOrder.begin(), componentOrder.end(), rng );
+
+    const D64 referenceStart = Time::App::ElapsedMicroseconds();
+    for ( size_t run = 0u; run < runCount; ++run )
+    {
+        for ( TestNode& node : nodes )
+        {
+            node._computed = false;
+        }
+        for ( TestNode* node : componentOrder )
+        {
+            ComputeWorld( node );
+        }
+    }
+    const D64 referenceDurationUS = Time::App::ElapsedMicroseconds() - referenceStart;
+
+    const auto markAllDirty = [&]()
+    {
+        for ( size_t i = 0u; i < nodeCount; ++i )
+        {
+            hierarchy.setLocal( hierarchy.slot( to_U32( i ) ), nodes[i]._local, nodes[i]._localRotations );
+        }
+    };
+
+    D64 serialDurationUS = 0.0, parallelDurationUS = 0.0, partialDurationUS = 0.0;
+    for ( size_t run = 0u; run < runCount; ++run )
+    {
+        markAllDirty();
+        const D64 serialStart = Time::App::ElapsedMicroseconds();
+        hierarchy.update( nullptr, partitionSize );
+        serialDurationUS += Time::App::ElapsedMicroseconds() - serialStart;
+
+        markAllDirty();
+        const D64 parallelStart = Time::App::ElapsedMicroseconds();
+        hierarchy.update( &pool, partitionSize );
+        parallelDurationUS += Time::App::ElapsedMicroseconds() - parallelStart;
+
+        // Roughly 1% of the nodes move each frame
+        for ( size_t i = run; i < nodeCount; i += 100u )
+        {
+            hierarchy.setLocal( hierarchy.slot( to_U32( i ) ), nodes[i]._local, nodes[i]._localRotations );
+        }
+        const D64 partialStart = Time::App::ElapsedMicroseconds();
+        hierarchy.update( &pool, partitionSize );
+        partialDurationUS += Time::App::ElapsedMicroseconds() - partialStart;
+    }
+
+    size_t mismatches = 0u;
+    for ( size_t i = 0u; i < nodeCount; ++i )
+    {
+        mismatches += Matches( hierarchy.worldValues( hierarchy.slot( to_U32( i ) ) ), nodes[i]._world ) ? 0u : 1u;
+    }
+    CHECK_EQUAL( mismatches, 0u );
+
+    std::cout << Util::StringFormat( "Transform update speed test [ {} nodes, {} levels ]: pointer recursion {:.2f} us, hierarchy serial {:.2f} us, hierarchy parallel {:.2f} us, 1% dirty {:.2f} us",
+                                     nodeCount,
+                                     hierarchy.levelCount(),
+                                     referenceDurationUS / runCount,
+                                     serialDurationUS / runCount,
+                                     parallelDurationUS / runCount,
+                                     partialDurationUS / runCount ) << std::endl;
+
+    pool.shutdown();
+}
+
+} //namespace Divide
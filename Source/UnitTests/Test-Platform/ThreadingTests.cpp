@@ -2,6 +2,7 @@
 
 #include "Core/Time/Headers/ProfileTimer.h"
 #include "Core/Time/Headers/ApplicationTimer.h"
+#include "Platform/Threading/Headers/TaskGraph.h"
 #include <atomic>
 #include <iostream>
 
@@ -97,6 +98,138 @@ TEST_CASE( "Parallel For Test", "[threading_tests]" )
     test.shutdown();
 }
 
+TEST_CASE( "Parallel For Adaptive Test", "[threading_tests]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool test( "PARALLEL_FOR_ADAPTIVE_TEST" );
+
+    const bool init = test.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    for ( const U32 loopCount : { 1u, 7u, 1000u, 100003u } )
+    {
+        for ( const bool useCurrentThread : { true, false } )
+        {
+            for ( const bool waitForFinish : { true, false } )
+            {
+                vector<U8> visited( loopCount, 0u );
+                std::atomic_uint totalCounter = 0;
+
+                ParallelForDescriptor descriptor = {};
+                descriptor._iterCount = loopCount;
+                descriptor._partitionSize = 0u;
+                descriptor._useCurrentThread = useCurrentThread;
+                descriptor._waitForFinish = waitForFinish;
+                // The callback is a temporary: loops that don't wait must not hold on to it (or to anything else of Parallel_For's) after returning
+                Parallel_For( test, descriptor, [&totalCounter, &visited]( [[maybe_unused]] const Task* parentTask, const U32 start, const U32 end ) noexcept
+                {
+                    for ( U32 i = start; i < end; ++i )
+                    {
+                        ++visited[i];
+                        ++totalCounter;
+                    }
+                });
+                if ( !waitForFinish )
+                {
+                    // waitForAllTasks only sees tasks that already started
+                    WAIT_FOR_CONDITION( totalCounter.load() == loopCount );
+                }
+
+                CHECK_EQUAL( totalCounter, loopCount );
+                CHECK_TRUE( std::all_of( std::cbegin( visited ), std::cend( visited ), []( const U8 v ) noexcept { return v == 1u; } ) );
+            }
+        }
+    }
+
+    test.shutdown();
+}
+
+TEST_CASE( "Parallel For Partitioning Speed Test", "[threading_tests]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool test( "PARALLEL_FOR_PARTITION_SPEED_TEST" );
+
+    const bool init = test.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    const U64 timerOverhead = Time::ProfileTimer::overhead();
+
+    // Burns a deterministic amount of CPU time per item
+    const auto work = []( const U32 cost ) noexcept
+    {
+        U32 value = cost;
+        for ( U32 i = 0u; i < cost; ++i )
+        {
+            value = value * 1664525u + 1013904223u;
+        }
+        return value;
+    };
+
+    enum class CostProfile : U8
+    {
+        CHEAP = 0,
+        EXPENSIVE,
+        SKEWED, ///< Cost grows with the item index, similar to deep scene-graph subtrees at the end of a node list
+        COUNT
+    };
+
+    constexpr const char* costNames[] = { "cheap", "expensive", "skewed" };
+    static_assert(std::size( costNames ) == to_base( CostProfile::COUNT ));
+
+    for ( const U32 loopCount : { 1u << 10, 1u << 14, 1u << 18 } )
+    {
+        for ( U8 c = 0u; c < to_U8( CostProfile::COUNT ); ++c )
+        {
+            const CostProfile profile = static_cast<CostProfile>(c);
+
+            const auto itemCost = [profile, loopCount]( const U32 idx ) noexcept -> U32
+            {
+                switch ( profile )
+                {
+                    case CostProfile::CHEAP:     return 1u;
+                    case CostProfile::EXPENSIVE: return 64u;
+                    case CostProfile::SKEWED:    return 1u + (256u * idx) / loopCount;
+                    default: break;
+                }
+                return 1u;
+            };
+
+            for ( const U32 partitionSize : { 256u, 0u } )
+            {
+                std::atomic_uint sink = 0u;
+
+                ParallelForDescriptor descriptor = {};
+                descriptor._iterCount = loopCount;
+                descriptor._partitionSize = partitionSize;
+
+                Time::ProfileTimer timer;
+                timer.start();
+                Parallel_For( test, descriptor, [&]( [[maybe_unused]] const Task* parentTask, const U32 start, const U32 end ) noexcept
+                {
+                    U32 localSink = 0u;
+                    for ( U32 i = start; i < end; ++i )
+                    {
+                        localSink ^= work( itemCost( i ) );
+                    }
+                    sink.fetch_xor( localSink, std::memory_order_relaxed );
+                });
+                timer.stop();
+
+                const F32 durationMS = Time::MicrosecondsToMilliseconds<F32>( timer.get() - timerOverhead );
+                PrintLine( Util::StringFormat( "Parallel_For partitioning speed test [ {} items, {} cost, {} ]: {} ms. ({})",
+                                               loopCount,
+                                               costNames[c],
+                                               partitionSize == 0u ? "adaptive" : Util::StringFormat( "fixed {}", partitionSize ),
+                                               durationMS,
+                                               sink.load() ) );
+            }
+        }
+    }
+
+    test.shutdown();
+}
 
 TEST_CASE( "Task Callback Test", "[threading_tests]" )
 {
@@ -350,4 +483,306 @@ TEST_CASE( "Task Priority Test", "[threading_tests]" )
     test.shutdown();
 }
 
+TEST_CASE( "Task Callback Registry Test", "[threading_tests]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool test( "CALLBACK_REGISTRY_TEST" );
+    const bool init = test.init( std::thread::hardware_concurrency() );
+    CHECK_TRUE( init );
+
+    // More callbacks than the table can hold at once: registration on the main thread has to recycle slots by flushing
+    constexpr U32 taskCount = TaskPool::MaxPendingCallbacks * 3u + 7u;
+
+    U32 callbackCounter = 0u;
+    size_t flushedCount = 0u;
+
+    const U64 timerOverhead = Time::ProfileTimer::overhead();
+    Time::ProfileTimer timer;
+    timer.start();
+
+    Task* parent = CreateTask( TASK_NOP );
+    for ( U32 i = 0u; i < taskCount; ++i )
+    {
+        Start( *CreateTask( parent, TASK_NOP ), test, TaskPriority::DONT_CARE, [&callbackCounter]() noexcept
+        {
+            ++callbackCounter;
+        });
+    }
+    StartAndWait( *parent, test, TaskPriority::DONT_CARE );
+    test.waitForAllTasks( false );
+    flushedCount = test.flushCallbackQueue();
+
+    timer.stop();
+    const F32 durationMS = Time::MicrosecondsToMilliseconds<F32>( timer.get() - timerOverhead );
+    PrintLine( "Callback registry test: " + std::to_string( taskCount ) + " tasks with callbacks completed in: " + std::to_string( durationMS ) + " ms." );
+
+    CHECK_TRUE( flushedCount <= taskCount );
+    CHECK_EQUAL( callbackCounter, taskCount );
+    CHECK_EQUAL( test.flushCallbackQueue(), 0u );
+
+    // Same again, but registered from a worker while the main thread is blocked waiting for it. Nobody can flush, so the extra callbacks have to overflow
+    callbackCounter = 0u;
+    Task* spawner = CreateTask( [&test, &callbackCounter]( Task& parentTask )
+    {
+        for ( U32 i = 0u; i < taskCount; ++i )
+        {
+            Start( *CreateTask( &parentTask, TASK_NOP ), test, TaskPriority::DONT_CARE, [&callbackCounter]() noexcept
+            {
+                ++callbackCounter;
+            });
+        }
+    });
+    // Not StartAndWait: that may run the spawner right here on the main thread, where registration flushes instead of overflowing.
+    // waitForAllTasks only blocks, so every registration happens on a worker
+    Start( *spawner, test, TaskPriority::DONT_CARE );
+    test.waitForAllTasks( false );
+
+    CHECK_EQUAL( callbackCounter, 0u );
+    CHECK_EQUAL( test.flushCallbackQueue(), taskCount );
+    CHECK_EQUAL( callbackCounter, taskCount );
+
+    test.shutdown();
+}
+
+TEST_CASE( "Task Graph Test", "[threading_tests]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    for ( U8 s = 0u; s < to_U8( TaskPoolScheduler::COUNT ); ++s )
+    {
+        TaskPool test( "TASK_GRAPH_TEST" );
+        const bool init = test.init( std::thread::hardware_concurrency(), {}, static_cast<TaskPoolScheduler>(s) );
+        CHECK_TRUE( init );
+
+        const std::thread::id callerThread = std::this_thread::get_id();
+
+        // Diamond: A -> (B, C) -> D, plus a caller-thread node E that depends on D and an independent root F
+        std::atomic_uint sequence = 0u;
+        std::array<U32, 6> order{};
+        std::atomic_bool ranOnCaller = false;
+
+        TaskGraph graph;
+        const auto makeNode = [&]( const U32 idx )
+        {
+            return [&order, &sequence, idx]()
+            {
+                order[idx] = sequence.fetch_add( 1u );
+            };
+        };
+
+        const TaskGraph::NodeHandle a = graph.addNode( makeNode( 0u ) );
+        const TaskGraph::NodeHandle b = graph.addNode( makeNode( 1u ) );
+        const TaskGraph::NodeHandle c = graph.addNode( makeNode( 2u ), TaskPriority::HIGH );
+        const TaskGraph::NodeHandle d = graph.addNode( makeNode( 3u ) );
+        const TaskGraph::NodeHandle e = graph.addNode( [&, node = makeNode( 4u )]()
+        {
+            node();
+            ranOnCaller = std::this_thread::get_id() == callerThread;
+        }, TaskPriority::REALTIME );
+        const TaskGraph::NodeHandle f = graph.addNode( makeNode( 5u ) );
+
+        graph.addDependency( a, b );
+        graph.addDependency( a, c );
+        graph.addDependencies( { b, c }, d );
+        graph.addDependency( d, e );
+
+        CHECK_EQUAL( graph.nodeCount(), 6u );
+        CHECK_TRUE( graph.validate() );
+
+        for ( U8 run = 0u; run < 3u; ++run )
+        {
+            sequence = 0u;
+            ranOnCaller = false;
+
+            graph.run( test );
+
+            CHECK_EQUAL( sequence.load(), 6u );
+            CHECK_TRUE( order[a] < order[b] );
+            CHECK_TRUE( order[a] < order[c] );
+            CHECK_TRUE( order[b] < order[d] );
+            CHECK_TRUE( order[c] < order[d] );
+            CHECK_TRUE( order[d] < order[e] );
+            CHECK_TRUE( order[f] < 6u );
+            CHECK_TRUE( ranOnCaller.load() );
+        }
+
+        // Introduce a cycle
+        graph.addDependency( e, a );
+        CHECK_FALSE( graph.validate() );
+
+        graph.clear();
+        CHECK_EQUAL( graph.nodeCount(), 0u );
+
+        test.shutdown();
+    }
+}
+
+TEST_CASE( "Work Stealing Scheduler Test", "[threading_tests]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool test( "WORK_STEALING_TEST" );
+    const bool init = test.init( std::thread::hardware_concurrency(), {}, TaskPoolScheduler::WORK_STEALING );
+    CHECK_TRUE( init );
+    CHECK_TRUE( test.scheduler() == TaskPoolScheduler::WORK_STEALING );
+
+    constexpr U32 outerCount = 32u;
+    constexpr U32 innerCount = 64u;
+
+    std::atomic_uint innerCounter = 0u;
+    std::atomic_uint outerCounter = 0u;
+
+    // Children spawned from within a running task end up in the worker's local deque
+    Task* parent = CreateTask( TASK_NOP );
+    for ( U32 i = 0u; i < outerCount; ++i )
+    {
+        Start( *CreateTask( parent, [&test, &innerCounter, &outerCounter]( [[maybe_unused]] const Task& parentTask )
+        {
+            Task* innerParent = CreateTask( TASK_NOP );
+            for ( U32 j = 0u; j < innerCount; ++j )
+            {
+                Start( *CreateTask( innerParent, [&innerCounter]( [[maybe_unused]] const Task& innerTask ) noexcept
+                {
+                    innerCounter.fetch_add( 1u );
+                }), test );
+            }
+            StartAndWait( *innerParent, test, TaskPriority::DONT_CARE );
+            outerCounter.fetch_add( 1u );
+        }), test );
+    }
+
+    bool callbackCalled = false;
+    StartAndWait( *parent, test, TaskPriority::DONT_CARE, [&callbackCalled]() noexcept
+    {
+        callbackCalled = true;
+    });
+
+    CHECK_TRUE( Finished( *parent ) );
+    CHECK_EQUAL( outerCounter.load(), outerCount );
+    CHECK_EQUAL( innerCounter.load(), outerCount * innerCount );
+
+    CHECK_FALSE( callbackCalled );
+    CHECK_EQUAL( test.flushCallbackQueue(), 1u );
+    CHECK_TRUE( callbackCalled );
+
+    std::atomic_uint loopCounter = 0u;
+    std::atomic_uint totalCounter = 0u;
+
+    ParallelForDescriptor descriptor = {};
+    descriptor._iterCount = 18u;
+    descriptor._partitionSize = 4u;
+    Parallel_For( test, descriptor, [&totalCounter, &loopCounter]( [[maybe_unused]] const Task* parentTask, const U32 start, const U32 end ) noexcept
+    {
+        ++loopCounter;
+        for ( U32 i = start; i < end; ++i )
+        {
+            ++totalCounter;
+        }
+    });
+
+    CHECK_EQUAL( loopCounter, 5u );
+    CHECK_EQUAL( totalCounter, 18u );
+
+    test.waitForAllTasks( true );
+    test.shutdown();
+}
+
+TEST_CASE( "Task Scheduler Speed Test", "[threading_tests]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    constexpr U32 fanOutCount = 60u * 1000u;
+    constexpr U32 nestedOuterCount = 256u;
+    constexpr U32 nestedInnerCount = 256u;
+    constexpr U32 partitionSize = 64u;
+    constexpr U32 loopCount = partitionSize * 4096u;
+
+    const U64 timerOverhead = Time::ProfileTimer::overhead();
+
+    const auto printDuration = [timerOverhead]( const char* scheduler, const char* workload, const Time::ProfileTimer& timer )
+    {
+        const F32 durationMS = Time::MicrosecondsToMilliseconds<F32>( timer.get() - timerOverhead );
+        PrintLine( Util::StringFormat( "Scheduler speed test [ {} ] {}: {} ms.", scheduler, workload, durationMS ) );
+    };
+
+    for ( U8 s = 0u; s < to_U8( TaskPoolScheduler::COUNT ); ++s )
+    {
+        const TaskPoolScheduler scheduler = static_cast<TaskPoolScheduler>(s);
+        const char* schedulerName = scheduler == TaskPoolScheduler::WORK_STEALING ? "WORK_STEALING" : "SHARED_QUEUES";
+
+        TaskPool test( "SCHEDULER_SPEED_TEST" );
+        const bool init = test.init( std::thread::hardware_concurrency(), {}, scheduler );
+        CHECK_TRUE( init );
+
+        Time::ProfileTimer timer;
+
+        // Fan-out/fan-in from an external thread: lots of tiny tasks under one parent
+        {
+            std::atomic_uint counter = 0u;
+
+            timer.start();
+            Task* parent = CreateTask( TASK_NOP );
+            for ( U32 i = 0u; i < fanOutCount; ++i )
+            {
+                Start( *CreateTask( parent, [&counter]( [[maybe_unused]] const Task& parentTask ) noexcept
+                {
+                    counter.fetch_add( 1u, std::memory_order_relaxed );
+                }), test );
+            }
+            StartAndWait( *parent, test, TaskPriority::DONT_CARE );
+            timer.stop();
+
+            CHECK_EQUAL( counter.load(), fanOutCount );
+            printDuration( schedulerName, Util::StringFormat( "fan-out/fan-in ({} tasks)", fanOutCount ).c_str(), timer );
+        }
+
+        // Nested fan-out/fan-in: every task spawns and waits on its own children from within the pool
+        {
+            std::atomic_uint counter = 0u;
+
+            timer.start();
+            Task* parent = CreateTask( TASK_NOP );
+            for ( U32 i = 0u; i < nestedOuterCount; ++i )
+            {
+                Start( *CreateTask( parent, [&test, &counter]( [[maybe_unused]] const Task& parentTask )
+                {
+                    Task* innerParent = CreateTask( TASK_NOP );
+                    for ( U32 j = 0u; j < nestedInnerCount; ++j )
+                    {
+                        Start( *CreateTask( innerParent, [&counter]( [[maybe_unused]] const Task& innerTask ) noexcept
+                        {
+                            counter.fetch_add( 1u, std::memory_order_relaxed );
+                        }), test );
+                    }
+                    StartAndWait( *innerParent, test, TaskPriority::DONT_CARE );
+                }), test );
+            }
+            StartAndWait( *parent, test, TaskPriority::DONT_CARE );
+            timer.stop();
+
+            CHECK_EQUAL( counter.load(), nestedOuterCount * nestedInnerCount );
+            printDuration( schedulerName, Util::StringFormat( "nested fan-out/fan-in ({}x{} tasks)", nestedOuterCount, nestedInnerCount ).c_str(), timer );
+        }
+
+        // Parallel_For with small partitions
+        {
+            ParallelForDescriptor descriptor = {};
+            descriptor._iterCount = loopCount;
+            descriptor._partitionSize = partitionSize;
+
+            timer.start();
+            Parallel_For( test, descriptor, []( [[maybe_unused]] const Task* parentTask, [[maybe_unused]] const U32 start, [[maybe_unused]] const U32 end ) noexcept
+            {
+                NOP();
+            });
+            timer.stop();
+
+            printDuration( schedulerName, Util::StringFormat( "Parallel_For ({} partitions)", loopCount / partitionSize ).c_str(), timer );
+        }
+
+        test.shutdown();
+    }
+}
+
 } //namespace Divide